@@ -10,6 +10,13 @@ using namespace CalcEngine;
 constexpr int C_NUM_MAX_DIGITS = MAX_STRLEN;
 constexpr int C_EXP_MAX_DIGITS = 4;
 
+// Maps the characters TryAddDigit generates ('0'-'9', then 'A'-'Z' for
+// radixes above 10) back to their digit values.
+static unsigned int DigitFromChar(wchar_t c)
+{
+    return (c <= L'9') ? (c - L'0') : (c - L'A' + 10);
+}
+
 void CalcNumSec::Clear()
 {
     value.clear();
@@ -23,6 +30,16 @@ void CalcInput::Clear()
     m_hasExponent = false;
     m_hasDecimal = false;
     m_decPtIndex = 0;
+    m_mantissaValid = true;
+    m_mantissaRadix = 0;
+    m_cachedMantissa = {};
+}
+
+// True when nothing has been typed yet: no digits, sign, decimal point or
+// exponent. An empty input renders and commits as 0.
+bool CalcInput::IsEmpty()
+{
+    return m_base.IsEmpty() && !m_base.IsNegative() && !m_hasExponent && !m_hasDecimal;
 }
 
 bool CalcInput::TryToggleSign(bool isIntegerMode, wstring_view maxNumStr)
@@ -97,6 +114,10 @@ bool CalcInput::TryAddDigit(unsigned int value, uint32_t radix, bool isIntegerMo
     if (pNumSec->value.size() < maxCount)
     {
         pNumSec->value += chDigit;
+        if (pNumSec == &m_base)
+        {
+            AppendCachedDigit(value, radix);
+        }
         return true;
     }
 
@@ -162,6 +183,7 @@ bool CalcInput::TryAddDigit(unsigned int value, uint32_t radix, bool isIntegerMo
         if (allowExtraDigit)
         {
             pNumSec->value += chDigit;
+            AppendCachedDigit(value, radix);
             return true;
         }
     }
@@ -210,39 +232,54 @@ bool CalcInput::TryBeginExponent()
 
 void CalcInput::Backspace()
 {
-    if (m_hasExponent)
+    Backspace(1);
+}
+
+// Deletes up to count trailing characters as one structural edit. A held
+// Backspace key delivers repeats faster than a display refresh per
+// keystroke can keep up with, so CCalcEngine::ProcessCommandRun collapses
+// the run into one call here followed by a single display update.
+void CalcInput::Backspace(uint32_t count)
+{
+    while (count-- > 0)
     {
-        if (!m_exponent.IsEmpty())
+        if (m_hasExponent)
         {
-            m_exponent.value.pop_back();
+            if (!m_exponent.IsEmpty())
+            {
+                m_exponent.value.pop_back();
 
-            if (m_exponent.IsEmpty())
+                if (m_exponent.IsEmpty())
+                {
+                    m_exponent.Clear();
+                }
+            }
+            else
             {
-                m_exponent.Clear();
+                m_hasExponent = false;
             }
         }
         else
         {
-            m_hasExponent = false;
-        }
-    }
-    else
-    {
-        if (!m_base.IsEmpty())
-        {
-            m_base.value.pop_back();
-        }
+            if (!m_base.IsEmpty())
+            {
+                m_base.value.pop_back();
+                m_mantissaValid = false;
+            }
 
-        if (m_base.value.size() <= m_decPtIndex)
-        {
-            // Backed up over decimal point
-            m_hasDecimal = false;
-            m_decPtIndex = 0;
-        }
+            if (m_base.value.size() <= m_decPtIndex)
+            {
+                // Backed up over decimal point
+                m_hasDecimal = false;
+                m_decPtIndex = 0;
+            }
 
-        if (m_base.IsEmpty())
-        {
-            m_base.Clear();
+            if (m_base.IsEmpty())
+            {
+                m_base.Clear();
+                // Nothing left to delete; the rest of the run is a no-op.
+                break;
+            }
         }
     }
 }
@@ -302,16 +339,109 @@ wstring CalcInput::ToString(uint32_t radix)
     return result;
 }
 
+void CalcInput::AppendCachedDigit(unsigned int value, uint32_t radix)
+{
+    if (m_mantissaValid && (m_mantissaRadix == 0 || m_mantissaRadix == radix))
+    {
+        m_mantissaRadix = radix;
+        m_cachedMantissa = RationalMath::MulAdd(m_cachedMantissa, radix, value);
+    }
+    else
+    {
+        // Radix changed under a live operand; fall back to a reparse.
+        m_mantissaValid = false;
+    }
+}
+
+void CalcInput::RecomputeMantissa(uint32_t radix)
+{
+    m_cachedMantissa = {};
+    m_mantissaRadix = radix;
+
+    for (auto const& c : m_base.value)
+    {
+        if (c != m_decSymbol)
+        {
+            m_cachedMantissa = RationalMath::MulAdd(m_cachedMantissa, radix, DigitFromChar(c));
+        }
+    }
+
+    m_mantissaValid = true;
+}
+
 Rational CalcInput::ToRational(uint32_t radix, int32_t precision)
 {
-    PRAT rat = StringToRat(m_base.IsNegative(), m_base.value, m_exponent.IsNegative(), m_exponent.value, radix, precision);
-    if (rat == nullptr)
+    if (!m_mantissaValid || (m_mantissaRadix != 0 && m_mantissaRadix != radix))
+    {
+        RecomputeMantissa(radix);
+    }
+
+    PRAT resultRat = nullptr;
+
+    if (m_base.IsEmpty())
+    {
+        // Mirror StringToRat's presets: zero, or one when only an exponent
+        // was typed.
+        DUPRAT(resultRat, m_exponent.IsEmpty() ? rat_zero : rat_one);
+    }
+    else
+    {
+        resultRat = m_cachedMantissa.ToPRAT();
+
+        // Digits after the decimal point scale the denominator.
+        if (m_hasDecimal && m_base.value.size() > m_decPtIndex + 1)
+        {
+            PNUMBER fracScale = radixpowi32x(radix, static_cast<int32_t>(m_base.value.size() - m_decPtIndex - 1));
+            mulnumx(&(resultRat->pq), fracScale);
+            destroynum(fracScale);
+        }
+    }
+
+    // The exponent digits were typed in this radix too.
+    int32_t expt = 0;
+    for (auto const& c : m_exponent.value)
+    {
+        expt = expt * static_cast<int32_t>(radix) + static_cast<int32_t>(DigitFromChar(c));
+    }
+
+    if (expt != 0)
+    {
+        PNUMBER pnumexp = radixpowi32x(radix, expt);
+
+        PRAT pratexp = nullptr;
+        createrat(pratexp);
+        DUPNUM(pratexp->pp, pnumexp);
+        pratexp->pq = i32tonum(1, BASEX);
+        destroynum(pnumexp);
+
+        try
+        {
+            if (m_exponent.IsNegative())
+            {
+                divrat(&resultRat, pratexp, precision);
+            }
+            else
+            {
+                mulrat(&resultRat, pratexp, precision);
+            }
+        }
+        catch (uint32_t error)
+        {
+            destroyrat(pratexp);
+            destroyrat(resultRat);
+            throw(error);
+        }
+
+        destroyrat(pratexp);
+    }
+
+    if (m_base.IsNegative())
     {
-        return 0;
+        resultRat->pp->sign *= -1;
     }
 
-    Rational result{ rat };
-    destroyrat(rat);
+    Rational result{ resultRat };
+    destroyrat(resultRat);
 
     return result;
 }
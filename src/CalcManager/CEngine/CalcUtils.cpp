@@ -5,6 +5,92 @@
 #include "Header Files/CalcEngine.h"
 #include "Header Files/CalcUtils.h"
 
+namespace
+{
+    // Attribute bits for the command codes, baked into lookup tables at
+    // compile time so the per-keystroke classification predicates are a
+    // single indexed load instead of chained range compares.
+    constexpr uint8_t OP_BINARY = 0x01;
+    constexpr uint8_t OP_UNARY = 0x02;
+    constexpr uint8_t OP_DIGIT = 0x04;
+    constexpr uint8_t OP_GUISETTING = 0x08;
+    constexpr uint8_t OP_COMMITSINPUT = 0x10;
+
+    constexpr uint8_t AttributesForOp(uint32_t op)
+    {
+        uint8_t attrs = 0;
+
+        if (op >= IDC_AND && op <= IDC_PWR)
+        {
+            attrs |= OP_BINARY;
+        }
+
+        if (op >= IDC_UNARYFIRST && op <= IDC_UNARYLAST)
+        {
+            attrs |= OP_UNARY;
+        }
+
+        if (op >= IDC_0 && op <= IDC_F)
+        {
+            attrs |= OP_DIGIT;
+        }
+
+        if ((op >= IDM_HEX && op <= IDM_BIN) ||
+            (op >= IDM_QWORD && op <= IDM_BYTE) ||
+            (op >= IDM_DEG && op <= IDM_GRAD) ||
+            op == IDC_INV || op == IDC_FE || op == IDC_MCLEAR || op == IDC_BACK ||
+            op == IDC_EXP || op == IDC_STORE || op == IDC_MPLUS || op == IDC_MMINUS)
+        {
+            attrs |= OP_GUISETTING;
+        }
+
+        if ((op >= IDC_AND && op <= IDC_MMINUS) ||
+            (op >= IDC_OPENP && op <= IDC_CLOSEP) ||
+            (op >= IDM_HEX && op <= IDM_BIN) ||
+            (op >= IDM_QWORD && op <= IDM_BYTE) ||
+            (op >= IDM_DEG && op <= IDM_GRAD) ||
+            op == IDC_INV)
+        {
+            attrs |= OP_COMMITSINPUT;
+        }
+
+        return attrs;
+    }
+
+    template <uint32_t First, uint32_t Last>
+    constexpr std::array<uint8_t, Last - First + 1> MakeOpAttributeTable()
+    {
+        std::array<uint8_t, Last - First + 1> table{};
+        for (uint32_t op = First; op <= Last; op++)
+        {
+            table[op - First] = AttributesForOp(op);
+        }
+
+        return table;
+    }
+
+    // The control commands (IDC_SIGN..IDC_SET_RESULT) and the mode commands
+    // (IDM_HEX..IDM_GRAD) are two dense ranges; everything else carries no
+    // attributes.
+    constexpr auto s_controlOpAttributes = MakeOpAttributeTable<IDC_FIRSTCONTROL, IDC_LASTCONTROL>();
+    constexpr auto s_modeOpAttributes = MakeOpAttributeTable<IDM_HEX, IDM_GRAD>();
+
+    bool HasOpAttribute(OpCode op, uint8_t attr)
+    {
+        if (op >= IDC_FIRSTCONTROL && op <= IDC_LASTCONTROL)
+        {
+            return (s_controlOpAttributes[op - IDC_FIRSTCONTROL] & attr) != 0;
+        }
+
+        if (op >= IDM_HEX && op <= IDM_GRAD)
+        {
+            return (s_modeOpAttributes[op - IDM_HEX] & attr) != 0;
+        }
+
+        return false;
+    }
+}
+
 bool IsOpInRange(OpCode op, uint32_t x, uint32_t y)
 {
     return ((op >= x) && (op <= y));
@@ -12,19 +98,19 @@ bool IsOpInRange(OpCode op, uint32_t x, uint32_t y)
 
 bool IsBinOpCode(OpCode opCode)
 {
-    return IsOpInRange(opCode, IDC_AND, IDC_PWR);
+    return HasOpAttribute(opCode, OP_BINARY);
 }
 
 // WARNING: IDC_SIGN is a special unary op but still this doesn't catch this. Caller has to be aware
 // of it and catch it themselves or not needing this
 bool IsUnaryOpCode(OpCode opCode)
 {
-    return IsOpInRange(opCode, IDC_UNARYFIRST, IDC_UNARYLAST);
+    return HasOpAttribute(opCode, OP_UNARY);
 }
 
 bool IsDigitOpCode(OpCode opCode)
 {
-    return IsOpInRange(opCode, IDC_0, IDC_F);
+    return HasOpAttribute(opCode, OP_DIGIT);
 }
 
 // Some commands are not affecting the state machine state of the calc flow. But these are more of
@@ -34,26 +120,13 @@ bool IsDigitOpCode(OpCode opCode)
 // was never inout, we need to revert the state changes made as a result of this test
 bool IsGuiSettingOpCode(OpCode opCode)
 {
-    if (IsOpInRange(opCode, IDM_HEX, IDM_BIN) ||
-        IsOpInRange(opCode, IDM_QWORD, IDM_BYTE) ||
-        IsOpInRange(opCode, IDM_DEG, IDM_GRAD))
-    {
-        return true;
-    }
-
-    switch (opCode)
-    {
-    case IDC_INV:
-    case IDC_FE:
-    case IDC_MCLEAR:
-    case IDC_BACK:
-    case IDC_EXP:
-    case IDC_STORE:
-    case IDC_MPLUS:
-    case IDC_MMINUS:
-        return true;
-    }
+    return HasOpAttribute(opCode, OP_GUISETTING);
+}
 
-    // most of the commands
-    return false;
+// Commands that commit the number being recorded (operators, memory and
+// parenthesis commands, mode switches). IDC_SIGN and the binary bit-edit
+// commands are special cases the caller handles itself.
+bool IsInputCommittingOpCode(OpCode opCode)
+{
+    return HasOpAttribute(opCode, OP_COMMITSINPUT);
 }
@@ -27,14 +27,15 @@ void CHistoryCollector::ReinitHistory()
     m_lastBinOpStartIndex = -1;
     m_curOperandIndex = 0;
     m_bLastOpndBrace = false;
-    if (m_spTokens != nullptr)
-    {
-        m_spTokens->Clear();
-    }
+    m_equationSz.clear();
+    m_tokens.clear();
     if (m_spCommands != nullptr)
     {
         m_spCommands->Clear();
     }
+    // Nodes of the finished expression keep the old arena alive on their
+    // own; the next expression bumps through fresh blocks.
+    m_commandArena.Reset();
 }
 
 // Constructor
@@ -43,7 +44,8 @@ CHistoryCollector::CHistoryCollector(ICalcDisplay *pCalcDisplay, std::shared_ptr
     m_pHistoryDisplay(pHistoryDisplay),
     m_pCalcDisplay(pCalcDisplay),
     m_iCurLineHistStart(-1),
-    m_decimalSymbol(decimalSymbol)
+    m_decimalSymbol(decimalSymbol),
+    m_fTokensLive(false)
 {
     ReinitHistory();
 }
@@ -52,16 +54,19 @@ CHistoryCollector::~CHistoryCollector()
 {
     m_pHistoryDisplay = nullptr;
     m_pCalcDisplay = nullptr;
+}
 
-    if (m_spTokens != nullptr)
-    {
-        m_spTokens->Clear();
-    }
+// Points the collector at the adopting manager's displays. Called when a
+// pre-built engine leaves the warm pool, before it has collected anything.
+void CHistoryCollector::RebindDisplays(ICalcDisplay* pCalcDisplay, std::shared_ptr<IHistoryDisplay> pHistoryDisplay)
+{
+    m_pCalcDisplay = pCalcDisplay;
+    m_pHistoryDisplay = pHistoryDisplay;
 }
 
 void CHistoryCollector::AddOpndToHistory(wstring_view numStr, Rational const& rat, bool fRepetition)
 {
-    std::shared_ptr<CalculatorVector<int>> commands = std::make_shared<CalculatorVector<int>>();
+    std::shared_ptr<CalculatorVector<int>> commands = m_commandArena.Make<CalculatorVector<int>>();
     // Check for negate
     bool fNegative = (numStr[0] == L'-');
     bool fSciFmt = false;
@@ -99,7 +104,7 @@ void CHistoryCollector::AddOpndToHistory(wstring_view numStr, Rational const& ra
         }
     }
 
-    auto operandCommand = std::make_shared<COpndCommand>(commands, fNegative, fDecimal, fSciFmt);
+    auto operandCommand = m_commandArena.Make<COpndCommand>(commands, fNegative, fDecimal, fSciFmt);
     operandCommand->Initialize(rat);
     int iCommandEnd = AddCommand(operandCommand);
     m_lastOpStartIndex = IchAddSzToEquationSz(numStr, iCommandEnd);
@@ -122,7 +127,7 @@ void CHistoryCollector::RemoveLastOpndFromHistory()
 
 void CHistoryCollector::AddBinOpToHistory(int nOpCode, bool fNoRepetition)
 {
-    int iCommandEnd = AddCommand(std::make_shared<CBinaryCommand>(nOpCode));
+    int iCommandEnd = AddCommand(m_commandArena.Make<CBinaryCommand>(nOpCode));
     m_lastBinOpStartIndex = IchAddSzToEquationSz(L" ", -1);
 
     IchAddSzToEquationSz(CCalcEngine::OpCodeToString(nOpCode), iCommandEnd);
@@ -168,7 +173,7 @@ void CHistoryCollector::PopLastOpndStart()
 
 void CHistoryCollector::AddOpenBraceToHistory()
 {
-    AddCommand(std::make_shared<CParentheses>(IDC_OPENP));
+    AddCommand(m_commandArena.Make<CParentheses>(IDC_OPENP));
     int ichOpndStart = IchAddSzToEquationSz(CCalcEngine::OpCodeToString(IDC_OPENP), -1);
     PushLastOpndStart(ichOpndStart);
 
@@ -178,7 +183,7 @@ void CHistoryCollector::AddOpenBraceToHistory()
 
 void CHistoryCollector::AddCloseBraceToHistory()
 {
-    AddCommand(std::make_shared<CParentheses>(IDC_CLOSEP));
+    AddCommand(m_commandArena.Make<CParentheses>(IDC_CLOSEP));
     IchAddSzToEquationSz(CCalcEngine::OpCodeToString(IDC_CLOSEP), -1);
     SetExpressionDisplay();
     PopLastOpndStart();
@@ -213,7 +218,7 @@ void CHistoryCollector::AddUnaryOpToHistory(int nOpCode, bool fInv, ANGLE_TYPE a
     // A very special case of % which is a funny post op unary op.
     if (IDC_PERCENT == nOpCode)
     {
-        iCommandEnd = AddCommand(std::make_shared<CUnaryCommand>(nOpCode));
+        iCommandEnd = AddCommand(m_commandArena.Make<CUnaryCommand>(nOpCode));
         IchAddSzToEquationSz(CCalcEngine::OpCodeToString(nOpCode), iCommandEnd);
     }
     else // all the other unary ops
@@ -221,7 +226,7 @@ void CHistoryCollector::AddUnaryOpToHistory(int nOpCode, bool fInv, ANGLE_TYPE a
         std::shared_ptr<IOperatorCommand> spExpressionCommand;
         if (IDC_SIGN == nOpCode)
         {
-            spExpressionCommand = std::make_shared<CUnaryCommand>(nOpCode);
+            spExpressionCommand = m_commandArena.Make<CUnaryCommand>(nOpCode);
         }
         else
         {
@@ -244,34 +249,34 @@ void CHistoryCollector::AddUnaryOpToHistory(int nOpCode, bool fInv, ANGLE_TYPE a
             {
             case IDC_SIN:
                 command = fInv ? static_cast<int>(CalculationManager::Command::CommandASIN) : IDC_SIN;
-                spExpressionCommand = std::make_shared<CUnaryCommand>(static_cast<int>(angleOpCode), command);
+                spExpressionCommand = m_commandArena.Make<CUnaryCommand>(static_cast<int>(angleOpCode), command);
                 break;
             case IDC_COS:
                 command = fInv ? static_cast<int>(CalculationManager::Command::CommandACOS) : IDC_COS;
-                spExpressionCommand = std::make_shared<CUnaryCommand>(static_cast<int>(angleOpCode), command);
+                spExpressionCommand = m_commandArena.Make<CUnaryCommand>(static_cast<int>(angleOpCode), command);
                 break;
             case IDC_TAN:
                 command = fInv ? static_cast<int>(CalculationManager::Command::CommandATAN) : IDC_TAN;
-                spExpressionCommand = std::make_shared<CUnaryCommand>(static_cast<int>(angleOpCode), command);
+                spExpressionCommand = m_commandArena.Make<CUnaryCommand>(static_cast<int>(angleOpCode), command);
                 break;
             case IDC_SINH:
                 command = fInv ? static_cast<int>(CalculationManager::Command::CommandASINH) : IDC_SINH;
-                spExpressionCommand = std::make_shared<CUnaryCommand>(command);
+                spExpressionCommand = m_commandArena.Make<CUnaryCommand>(command);
                 break;
             case IDC_COSH:
                 command = fInv ? static_cast<int>(CalculationManager::Command::CommandACOSH) : IDC_COSH;
-                spExpressionCommand = std::make_shared<CUnaryCommand>(command);
+                spExpressionCommand = m_commandArena.Make<CUnaryCommand>(command);
                 break;
             case IDC_TANH:
                 command = fInv ? static_cast<int>(CalculationManager::Command::CommandATANH) : IDC_TANH;
-                spExpressionCommand = std::make_shared<CUnaryCommand>(command);
+                spExpressionCommand = m_commandArena.Make<CUnaryCommand>(command);
                 break;
             case IDC_LN:
                 command = fInv ? static_cast<int>(CalculationManager::Command::CommandPOWE) : IDC_LN;
-                spExpressionCommand = std::make_shared<CUnaryCommand>(command);
+                spExpressionCommand = m_commandArena.Make<CUnaryCommand>(command);
                 break;
             default:
-                spExpressionCommand = std::make_shared<CUnaryCommand>(nOpCode);
+                spExpressionCommand = m_commandArena.Make<CUnaryCommand>(nOpCode);
             }
         }
 
@@ -308,12 +313,12 @@ void CHistoryCollector::CompleteHistoryLine(wstring_view numStr)
 
     if (nullptr != m_pHistoryDisplay)
     {
-        unsigned int addedItemIndex = m_pHistoryDisplay->AddToHistory(m_spTokens, m_spCommands, numStr);
+        unsigned int addedItemIndex = m_pHistoryDisplay->AddToHistory(MaterializeTokens(), m_spCommands, numStr);
         m_pCalcDisplay->OnHistoryItemAdded(addedItemIndex);
     }
 
-    m_spTokens = nullptr;
     m_spCommands = nullptr;
+    m_fTokensLive = false;
     m_iCurLineHistStart = -1; // It will get recomputed at the first Opnd
     ReinitHistory();
 }
@@ -336,27 +341,24 @@ void CHistoryCollector::ClearHistoryLine(wstring_view errStr)
 //  Also returns the 0 based index in the string just added. Can throw out of memory error
 int CHistoryCollector::IchAddSzToEquationSz(wstring_view str, int icommandIndex)
 {
-    if (m_spTokens == nullptr)
-    {
-        m_spTokens = std::make_shared<CalculatorVector<std::pair<std::wstring, int>>>();
-    }
+    m_tokens.push_back(HistoryToken{ static_cast<uint32_t>(m_equationSz.size()), static_cast<uint32_t>(str.size()), icommandIndex });
+    m_equationSz.append(str);
+    m_fTokensLive = true;
 
-    if (FAILED(m_spTokens->Append(std::make_pair(wstring(str), icommandIndex))))
-    {
-        throw(CALC_E_OUTOFMEMORY);
-    }
-
-    unsigned int nTokens;
-    m_spTokens->GetSize(&nTokens);
-    return nTokens - 1;
+    return static_cast<int>(m_tokens.size()) - 1;
 }
 
 // Inserts a given string into the global m_pszEquation at the given index ich taking care of reallocations etc.
 void CHistoryCollector::InsertSzInEquationSz(wstring_view str, int icommandIndex, int ich)
 {
-    if (FAILED(m_spTokens->InsertAt(ich, std::make_pair(wstring(str), icommandIndex))))
+    uint32_t ichInsert = m_tokens[ich].ichStart;
+    m_equationSz.insert(ichInsert, str);
+    m_tokens.insert(m_tokens.begin() + ich, HistoryToken{ ichInsert, static_cast<uint32_t>(str.size()), icommandIndex });
+
+    // The interned text of every following token moved up by the insertion.
+    for (size_t i = static_cast<size_t>(ich) + 1; i < m_tokens.size(); i++)
     {
-        throw(CALC_E_OUTOFMEMORY);
+        m_tokens[i].ichStart += static_cast<uint32_t>(str.size());
     }
 }
 
@@ -365,14 +367,10 @@ void CHistoryCollector::TruncateEquationSzFromIch(int ich)
 {
     // Truncate commands
     int minIdx = -1;
-    unsigned int nTokens = 0;
-    std::pair<std::wstring, int> currentPair;
-    m_spTokens->GetSize(&nTokens);
 
-    for (unsigned int i = ich; i < nTokens; i++)
+    for (size_t i = ich; i < m_tokens.size(); i++)
     {
-        IFT(m_spTokens->GetAt(i, &currentPair));
-        int curTokenId = currentPair.second;
+        int curTokenId = m_tokens[i].iCommandIndex;
         if (curTokenId != -1)
         {
             if ((minIdx != -1) || (curTokenId < minIdx))
@@ -383,7 +381,13 @@ void CHistoryCollector::TruncateEquationSzFromIch(int ich)
         }
     }
 
-    IFT(m_spTokens->Truncate(ich));
+    if (static_cast<size_t>(ich) >= m_tokens.size())
+    {
+        throw(E_BOUNDS);
+    }
+
+    m_equationSz.resize(m_tokens[ich].ichStart);
+    m_tokens.resize(ich);
 }
 
 // Adds the m_pszEquation into the running history text
@@ -391,11 +395,32 @@ void CHistoryCollector::SetExpressionDisplay()
 {
     if (nullptr != m_pCalcDisplay)
     {
-        m_pCalcDisplay->SetExpressionDisplay(m_spTokens, m_spCommands);
+        m_pCalcDisplay->SetExpressionDisplay(MaterializeTokens(), m_spCommands);
     }
 
 }
 
+// Builds the shared token vector handed to the display and the history
+// list from the interned flat form.
+std::shared_ptr<CalculatorVector<std::pair<std::wstring, int>>> CHistoryCollector::MaterializeTokens()
+{
+    auto spTokens = std::make_shared<CalculatorVector<std::pair<std::wstring, int>>>();
+
+    if (FAILED(spTokens->Reserve(m_tokens.size())))
+    {
+        throw(CALC_E_OUTOFMEMORY);
+    }
+    for (auto const& token : m_tokens)
+    {
+        if (FAILED(spTokens->EmplaceBack(m_equationSz.substr(token.ichStart, token.cch), token.iCommandIndex)))
+        {
+            throw(CALC_E_OUTOFMEMORY);
+        }
+    }
+
+    return spTokens;
+}
+
 int CHistoryCollector::AddCommand(_In_ const std::shared_ptr<IExpressionCommand> & spCommand)
 {
     if (m_spCommands == nullptr)
@@ -408,43 +433,46 @@ int CHistoryCollector::AddCommand(_In_ const std::shared_ptr<IExpressionCommand>
         throw(CALC_E_OUTOFMEMORY);
     }
 
-    unsigned int nCommands = 0;
-    m_spCommands->GetSize(&nCommands);
-    return nCommands - 1;
+    return static_cast<int>(m_spCommands->size()) - 1;
 }
 
 // To Update the operands in the Expression according to the current Radix
 void CHistoryCollector::UpdateHistoryExpression(uint32_t radix, int32_t precision)
 {
-    if (m_spTokens == nullptr)
+    if (!m_fTokensLive)
     {
         return;
     }
 
-    unsigned int size;
-    IFT(m_spTokens->GetSize(&size));
+    // Operand lengths change with the radix, so rebuild the interned buffer
+    // once rather than shifting it per token.
+    wstring updatedSz;
+    updatedSz.reserve(m_equationSz.size());
 
-    for (unsigned int i = 0; i < size; ++i)
+    for (auto& token : m_tokens)
     {
-        std::pair<std::wstring, int> token;
-        IFT(m_spTokens->GetAt(i, &token));
-        int commandPosition = token.second;
-        if (commandPosition != -1)
+        wstring tokenStr = m_equationSz.substr(token.ichStart, token.cch);
+        if (token.iCommandIndex != -1)
         {
             std::shared_ptr<IExpressionCommand> expCommand;
-            IFT(m_spCommands->GetAt(commandPosition, &expCommand));
+            IFT(m_spCommands->GetAt(token.iCommandIndex, &expCommand));
             if (expCommand != nullptr && CalculationManager::CommandType::OperandCommand == expCommand->GetCommandType())
             {
                 std::shared_ptr<COpndCommand> opndCommand = std::static_pointer_cast<COpndCommand>(expCommand);
                 if (opndCommand != nullptr)
                 {
-                    token.first = opndCommand->GetString(radix, precision);
-                    IFT(m_spTokens->SetAt(i, token));
-                    opndCommand->SetCommands(GetOperandCommandsFromString(token.first));
+                    tokenStr = opndCommand->GetString(radix, precision);
+                    opndCommand->SetCommands(GetOperandCommandsFromString(tokenStr));
                 }
             }
         }
+
+        token.ichStart = static_cast<uint32_t>(updatedSz.size());
+        token.cch = static_cast<uint32_t>(tokenStr.size());
+        updatedSz.append(tokenStr);
     }
+
+    m_equationSz = std::move(updatedSz);
     SetExpressionDisplay();
 }
 
@@ -456,7 +484,7 @@ void CHistoryCollector::SetDecimalSymbol(wchar_t decimalSymbol)
 // Update the commands corresponding to the passed string Number
 std::shared_ptr<CalculatorVector<int>> CHistoryCollector::GetOperandCommandsFromString(wstring_view numStr)
 {
-    std::shared_ptr<CalculatorVector<int>> commands = std::make_shared<CalculatorVector<int>>();
+    std::shared_ptr<CalculatorVector<int>> commands = m_commandArena.Make<CalculatorVector<int>>();
     // Check for negate
     bool fNegative = (numStr[0] == L'-');
 
@@ -494,3 +522,69 @@ std::shared_ptr<CalculatorVector<int>> CHistoryCollector::GetOperandCommandsFrom
     }
     return commands;
 }
+
+// Copies the current equation line into the given snapshot. The command
+// vector is shared rather than cloned; callers encode it immediately and
+// do not hold on to it across further edits of the line.
+void CHistoryCollector::GetSnapshot(_Out_ Snapshot &snapshot)
+{
+    snapshot.iCurLineHistStart = m_iCurLineHistStart;
+    snapshot.lastOpStartIndex = m_lastOpStartIndex;
+    snapshot.lastBinOpStartIndex = m_lastBinOpStartIndex;
+    snapshot.operandIndices = m_operandIndices;
+    snapshot.curOperandIndex = m_curOperandIndex;
+    snapshot.bLastOpndBrace = m_bLastOpndBrace;
+    // A live but empty token list is indistinguishable from none (clearing
+    // the line reinitializes it without dropping the flag), so normalize:
+    // equivalent collector states then snapshot identically.
+    snapshot.fTokensLive = m_fTokensLive && !m_tokens.empty();
+    snapshot.equationSz = m_equationSz;
+
+    snapshot.tokens.clear();
+    snapshot.tokens.reserve(m_tokens.size() * 3);
+    for (auto const& token : m_tokens)
+    {
+        snapshot.tokens.push_back(static_cast<int>(token.ichStart));
+        snapshot.tokens.push_back(static_cast<int>(token.cch));
+        snapshot.tokens.push_back(token.iCommandIndex);
+    }
+
+    snapshot.spCommands = m_spCommands;
+}
+
+// Restores an equation line saved by GetSnapshot and refreshes the
+// expression display to match.
+void CHistoryCollector::ApplySnapshot(_In_ Snapshot const& snapshot)
+{
+    m_iCurLineHistStart = snapshot.iCurLineHistStart;
+    m_lastOpStartIndex = snapshot.lastOpStartIndex;
+    m_lastBinOpStartIndex = snapshot.lastBinOpStartIndex;
+    m_operandIndices = snapshot.operandIndices;
+    m_curOperandIndex = snapshot.curOperandIndex;
+    m_bLastOpndBrace = snapshot.bLastOpndBrace;
+    m_fTokensLive = snapshot.fTokensLive;
+    m_equationSz = snapshot.equationSz;
+
+    m_tokens.clear();
+    for (size_t i = 0; i + 2 < snapshot.tokens.size(); i += 3)
+    {
+        m_tokens.push_back(HistoryToken{ static_cast<uint32_t>(snapshot.tokens[i]),
+            static_cast<uint32_t>(snapshot.tokens[i + 1]), snapshot.tokens[i + 2] });
+    }
+
+    m_spCommands = snapshot.spCommands;
+
+    RepaintExpressionDisplay();
+}
+
+void CHistoryCollector::RepaintExpressionDisplay()
+{
+    if (m_fTokensLive)
+    {
+        SetExpressionDisplay();
+    }
+    else if (nullptr != m_pCalcDisplay)
+    {
+        m_pCalcDisplay->SetExpressionDisplay(std::make_shared<CalculatorVector<std::pair<std::wstring, int>>>(), std::make_shared<CalculatorVector<std::shared_ptr<IExpressionCommand>>>());
+    }
+}
@@ -11,7 +11,7 @@ namespace CalcEngine
         Number(1, 0, { 0 })
     {}
 
-    Number::Number(int32_t sign, int32_t exp, vector<uint32_t> const& mantissa) noexcept :
+    Number::Number(int32_t sign, int32_t exp, NumberMantissa const& mantissa) noexcept :
         m_sign{ sign },
         m_exp{ exp },
         m_mantissa{ mantissa }
@@ -20,11 +20,8 @@ namespace CalcEngine
     Number::Number(PNUMBER p) noexcept :
         m_sign{ p->sign },
         m_exp{ p->exp },
-        m_mantissa{}
-    {
-        m_mantissa.reserve(p->cdigit);
-        copy(p->mant, p->mant + p->cdigit, back_inserter(m_mantissa));
-    }
+        m_mantissa{ p->mant, static_cast<size_t>(p->cdigit) }
+    {}
 
     PNUMBER Number::ToPNUMBER() const
     {
@@ -52,7 +49,7 @@ namespace CalcEngine
         return m_exp;
     }
 
-    vector<uint32_t> const& Number::Mantissa() const
+    NumberMantissa const& Number::Mantissa() const
     {
         return m_mantissa;
     }
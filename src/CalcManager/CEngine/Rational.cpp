@@ -5,316 +5,475 @@
 
 using namespace std;
 
-namespace CalcEngine
+namespace
 {
-    Rational::Rational() noexcept :
-        m_p{},
-        m_q{ 1, 0, { 1 } }
-    {}
-
-    Rational::Rational(Number const& n) noexcept
+    // Overflow pre-checks for the integer lane.  Operands never hold
+    // INT64_MIN, and a result of INT64_MIN counts as overflow so the
+    // lane invariant survives every operation.
+    bool TryAddI64(int64_t lhs, int64_t rhs, _Out_ int64_t* result)
     {
-        int32_t qExp = 0;
-        if (n.Exp() < 0)
+        if ((rhs > 0 && lhs > INT64_MAX - rhs) || (rhs < 0 && lhs < INT64_MIN - rhs))
         {
-            qExp -= n.Exp();
+            return false;
         }
 
-        m_p = Number(n.Sign(), 0, n.Mantissa());
-        m_q = Number(1, qExp, { 1 });
+        int64_t sum = lhs + rhs;
+        if (sum == INT64_MIN)
+        {
+            return false;
+        }
+
+        *result = sum;
+        return true;
     }
 
-    Rational::Rational(Number const& p, Number const& q) noexcept :
-        m_p{ p },
-        m_q{ q }
-    {}
+    bool TrySubI64(int64_t lhs, int64_t rhs, _Out_ int64_t* result)
+    {
+        return TryAddI64(lhs, -rhs, result);
+    }
 
-    Rational::Rational(int32_t i)
+    bool TryMulI64(int64_t lhs, int64_t rhs, _Out_ int64_t* result)
     {
-        PRAT pr = i32torat(static_cast<int32_t>(i));
+        if (lhs == 0 || rhs == 0)
+        {
+            *result = 0;
+            return true;
+        }
 
-        m_p = Number{ pr->pp };
-        m_q = Number{ pr->pq };
+        int64_t lhsMag = (lhs < 0) ? -lhs : lhs;
+        int64_t rhsMag = (rhs < 0) ? -rhs : rhs;
+        if (lhsMag > INT64_MAX / rhsMag)
+        {
+            return false;
+        }
 
-        destroyrat(pr);
+        *result = lhs * rhs;
+        return true;
     }
 
-    Rational::Rational(uint32_t ui)
+    // Only exact quotients stay in the lane; division by zero falls
+    // through to Ratpack so it raises the same error it always has.
+    bool TryDivI64(int64_t lhs, int64_t rhs, _Out_ int64_t* result)
     {
-        PRAT pr = Ui32torat(static_cast<uint32_t>(ui));
-
-        m_p = Number{ pr->pp };
-        m_q = Number{ pr->pq };
+        if (rhs == 0 || lhs % rhs != 0)
+        {
+            return false;
+        }
 
-        destroyrat(pr);
+        *result = lhs / rhs;
+        return true;
     }
 
-    Rational::Rational(uint64_t ui)
+    // Builds the Ratpack form of a lane value: the magnitude split into
+    // BASEX limbs over a denominator of one, matching what i32torat
+    // produces for small inputs.
+    PRAT RatFromI64(int64_t value)
     {
-        uint32_t hi = HIDWORD(ui);
-        uint32_t lo = LODWORD(ui);
+        uint64_t mag = (value < 0) ? (0 - static_cast<uint64_t>(value)) : static_cast<uint64_t>(value);
 
-        Rational temp = (Rational{ hi } << 32) | lo;
+        PNUMBER pp = _createnum(MAX_LONG_SIZE);
+        pp->sign = (value < 0) ? -1 : 1;
+        pp->exp = 0;
+        pp->cdigit = 0;
+        do
+        {
+            pp->mant[pp->cdigit] = static_cast<MANTTYPE>(mag % BASEX);
+            pp->cdigit++;
+            mag /= BASEX;
+        } while (mag != 0);
 
-        m_p = Number{ temp.P() };
-        m_q = Number{ temp.Q() };
-    }
+        PRAT result = _createrat();
+        result->pp = pp;
+        result->pq = i32tonum(1L, BASEX);
 
-    Rational::Rational(PRAT prat) noexcept :
-        m_p{ Number{prat->pp} },
-        m_q{ Number{prat->pq} }
-    {}
+        return result;
+    }
 
-    PRAT Rational::ToPRAT() const
+    // Recognizes a Ratpack rational that fits the lane: a denominator of
+    // exactly one over at most two limbs of magnitude.  Rationals here
+    // are in the engine's internal BASEX form, so the limbs compose by
+    // BASEXPWR-bit shifts and two of them stay comfortably below
+    // INT64_MAX.
+    bool TryRatToLane(_In_ PRAT rat, _Out_ int64_t* value)
     {
-        PRAT ret = _createrat();
+        PNUMBER pq = rat->pq;
+        if (pq->cdigit != 1 || pq->exp != 0 || pq->mant[0] != 1 || pq->sign != 1)
+        {
+            return false;
+        }
 
-        ret->pp = this->P().ToPNUMBER();
-        ret->pq = this->Q().ToPNUMBER();
+        PNUMBER pp = rat->pp;
+        if (pp->exp < 0 || pp->cdigit + pp->exp > 2)
+        {
+            return false;
+        }
 
-        return ret;
+        uint64_t mag = 0;
+        for (int32_t i = pp->cdigit - 1; i >= 0; i--)
+        {
+            mag = (mag << BASEXPWR) | pp->mant[i];
+        }
+        mag <<= BASEXPWR * pp->exp;
+
+        *value = (pp->sign < 0) ? -static_cast<int64_t>(mag) : static_cast<int64_t>(mag);
+        return true;
     }
 
-    Number const& Rational::P() const
+    // Borrows the Ratpack view of a comparison operand, materializing a
+    // temporary only for lane values; *owned is what the caller must
+    // destroy afterwards.
+    PRAT BorrowRat(PRAT prat, int64_t i64, _Out_ PRAT* owned)
     {
-        return m_p;
+        if (prat != nullptr)
+        {
+            *owned = nullptr;
+            return prat;
+        }
+
+        *owned = RatFromI64(i64);
+        return *owned;
     }
+}
 
-    Number const& Rational::Q() const
+namespace CalcEngine
+{
+    void SetRationalPrecision(int32_t precision)
     {
-        return m_q;
+        RATIONAL_PRECISION = min(max(precision, RATIONAL_PRECISION_DEFAULT), RATIONAL_PRECISION_MAX);
     }
 
-    Rational Rational::operator-() const
+    bool Rational::IsI64() const
     {
-        return Rational{ Number{ -1 * m_p.Sign(), m_p.Exp(), m_p.Mantissa() }, m_q };
+        return m_prat == nullptr;
     }
 
-    Rational& Rational::operator+=(Rational const& rhs)
+    void Rational::Materialize()
+    {
+        if (m_prat == nullptr)
+        {
+            m_prat = RatFromI64(m_i64);
+        }
+    }
+
+    // Common slow path for the binary operators: leaves the integer lane
+    // on both sides, runs the Ratpack operation with the usual
+    // copy-then-swap error handling, then drops back into the lane when
+    // the result is again a small integer.
+    template <typename TRatOp>
+    Rational& Rational::ApplyRatOp(Rational const& rhs, TRatOp&& ratOp)
     {
-        PRAT lhsRat = this->ToPRAT();
-        PRAT rhsRat = rhs.ToPRAT();
+        Materialize();
+
+        PRAT rhsOwned = nullptr;
+        PRAT rhsRat = rhs.m_prat;
+        if (rhsRat == nullptr)
+        {
+            rhsOwned = RatFromI64(rhs.m_i64);
+            rhsRat = rhsOwned;
+        }
+
+        PRAT lhsRat = nullptr;
+        DUPRAT(lhsRat, m_prat);
 
         try
         {
-            addrat(&lhsRat, rhsRat, RATIONAL_PRECISION);
-            destroyrat(rhsRat);
+            ratOp(&lhsRat, rhsRat);
         }
         catch (uint32_t error)
         {
             destroyrat(lhsRat);
-            destroyrat(rhsRat);
+            destroyrat(rhsOwned);
             throw(error);
         }
 
-        *this = Rational{ lhsRat };
-        destroyrat(lhsRat);
+        destroyrat(rhsOwned);
+        destroyrat(m_prat);
+        m_prat = lhsRat;
+
+        if (TryRatToLane(m_prat, &m_i64))
+        {
+            destroyrat(m_prat);
+        }
 
         return *this;
     }
 
-    Rational& Rational::operator-=(Rational const& rhs)
-    {
-        PRAT lhsRat = this->ToPRAT();
-        PRAT rhsRat = rhs.ToPRAT();
+    Rational::Rational() :
+        m_prat{ nullptr },
+        m_i64{ 0 }
+    {}
 
-        try
+    Rational::Rational(Rational const& other) :
+        m_prat{ nullptr },
+        m_i64{ other.m_i64 }
+    {
+        if (other.m_prat != nullptr)
         {
-            subrat(&lhsRat, rhsRat, RATIONAL_PRECISION);
-            destroyrat(rhsRat);
+            DUPRAT(m_prat, other.m_prat);
         }
-        catch (uint32_t error)
+    }
+
+    Rational::Rational(Rational&& other) noexcept :
+        m_prat{ other.m_prat },
+        m_i64{ other.m_i64 }
+    {
+        // The moved-from value keeps a well-defined lane zero.
+        other.m_prat = nullptr;
+        other.m_i64 = 0;
+    }
+
+    Rational& Rational::operator=(Rational const& other)
+    {
+        if (this != &other)
         {
-            destroyrat(lhsRat);
-            destroyrat(rhsRat);
-            throw(error);
+            if (other.m_prat == nullptr)
+            {
+                destroyrat(m_prat);
+                m_i64 = other.m_i64;
+            }
+            else
+            {
+                DUPRAT(m_prat, other.m_prat);
+            }
         }
 
-        *this = Rational{ lhsRat };
-        destroyrat(lhsRat);
+        return *this;
+    }
+
+    Rational& Rational::operator=(Rational&& other) noexcept
+    {
+        swap(m_prat, other.m_prat);
+        swap(m_i64, other.m_i64);
 
         return *this;
     }
 
-    Rational& Rational::operator*=(Rational const& rhs)
+    Rational::~Rational()
     {
-        PRAT lhsRat = this->ToPRAT();
-        PRAT rhsRat = rhs.ToPRAT();
+        destroyrat(m_prat);
+    }
 
-        try
-        {
-            mulrat(&lhsRat, rhsRat, RATIONAL_PRECISION);
-            destroyrat(rhsRat);
-        }
-        catch (uint32_t error)
+    Rational::Rational(Number const& n)
+    {
+        int32_t qExp = 0;
+        if (n.Exp() < 0)
         {
-            destroyrat(lhsRat);
-            destroyrat(rhsRat);
-            throw(error);
+            qExp -= n.Exp();
         }
 
-        *this = Rational{ lhsRat };
-        destroyrat(lhsRat);
-
-        return *this;
+        m_prat = _createrat();
+        m_prat->pp = Number{ n.Sign(), 0, n.Mantissa() }.ToPNUMBER();
+        m_prat->pq = Number{ 1, qExp, { 1 } }.ToPNUMBER();
     }
 
-    Rational& Rational::operator/=(Rational const& rhs)
+    Rational::Rational(Number const& p, Number const& q)
     {
-        PRAT lhsRat = this->ToPRAT();
-        PRAT rhsRat = rhs.ToPRAT();
+        m_prat = _createrat();
+        m_prat->pp = p.ToPNUMBER();
+        m_prat->pq = q.ToPNUMBER();
+    }
 
-        try
+    Rational::Rational(int32_t i) :
+        m_prat{ nullptr },
+        m_i64{ i }
+    {}
+
+    Rational::Rational(uint32_t ui) :
+        m_prat{ nullptr },
+        m_i64{ static_cast<int64_t>(ui) }
+    {}
+
+    Rational::Rational(uint64_t ui) :
+        m_prat{ nullptr },
+        m_i64{ 0 }
+    {
+        if (ui <= static_cast<uint64_t>(INT64_MAX))
         {
-            divrat(&lhsRat, rhsRat, RATIONAL_PRECISION);
-            destroyrat(rhsRat);
+            m_i64 = static_cast<int64_t>(ui);
         }
-        catch (uint32_t error)
+        else
         {
-            destroyrat(lhsRat);
-            destroyrat(rhsRat);
-            throw(error);
-        }
-
-        *this = Rational{ lhsRat };
-        destroyrat(lhsRat);
+            uint32_t hi = HIDWORD(ui);
+            uint32_t lo = LODWORD(ui);
 
-        return *this;
+            *this = (Rational{ hi } << 32) | lo;
+        }
     }
 
-    Rational& Rational::operator%=(Rational const& rhs)
+    Rational::Rational(PRAT prat) :
+        m_prat{ nullptr },
+        m_i64{ 0 }
     {
-        PRAT lhsRat = this->ToPRAT();
-        PRAT rhsRat = rhs.ToPRAT();
-
-        try
+        // Ratpack hands back the engine's internal BASEX form, so small
+        // integer results drop straight into the lane.
+        if (!TryRatToLane(prat, &m_i64))
         {
-            modrat(&lhsRat, rhsRat);
-            destroyrat(rhsRat);
+            DUPRAT(m_prat, prat);
         }
-        catch (uint32_t error)
+    }
+
+    PRAT Rational::ToPRAT() const
+    {
+        if (m_prat == nullptr)
         {
-            destroyrat(lhsRat);
-            destroyrat(rhsRat);
-            throw(error);
+            return RatFromI64(m_i64);
         }
 
-        *this = Rational{ lhsRat };
-        destroyrat(lhsRat);
+        PRAT ret = nullptr;
+        DUPRAT(ret, m_prat);
 
-        return *this;
+        return ret;
     }
 
-    Rational& Rational::operator<<=(Rational const& rhs)
+    Number Rational::P() const
     {
-        PRAT lhsRat = this->ToPRAT();
-        PRAT rhsRat = rhs.ToPRAT();
-
-        try
+        if (m_prat == nullptr)
         {
-            lshrat(&lhsRat, rhsRat, RATIONAL_BASE, RATIONAL_PRECISION);
-            destroyrat(rhsRat);
+            PRAT rat = RatFromI64(m_i64);
+            Number result{ rat->pp };
+            destroyrat(rat);
+
+            return result;
         }
-        catch (uint32_t error)
+
+        return Number{ m_prat->pp };
+    }
+
+    Number Rational::Q() const
+    {
+        if (m_prat == nullptr)
         {
-            destroyrat(lhsRat);
-            destroyrat(rhsRat);
-            throw(error);
+            return Number{ 1, 0, { 1 } };
         }
 
-        *this = Rational{ lhsRat };
-        destroyrat(lhsRat);
-
-        return *this;
+        return Number{ m_prat->pq };
     }
 
-    Rational& Rational::operator>>=(Rational const& rhs)
+    Rational Rational::operator-() const
     {
-        PRAT lhsRat = this->ToPRAT();
-        PRAT rhsRat = rhs.ToPRAT();
-
-        try
+        Rational result{ *this };
+        if (result.m_prat == nullptr)
         {
-            rshrat(&lhsRat, rhsRat, RATIONAL_BASE, RATIONAL_PRECISION);
-            destroyrat(rhsRat);
+            result.m_i64 = -result.m_i64;
         }
-        catch (uint32_t error)
+        else
         {
-            destroyrat(lhsRat);
-            destroyrat(rhsRat);
-            throw(error);
+            result.m_prat->pp->sign *= -1;
         }
 
-        *this = Rational{ lhsRat };
-        destroyrat(lhsRat);
-
-        return *this;
+        return result;
     }
 
-    Rational& Rational::operator&=(Rational const& rhs)
+    Rational& Rational::operator+=(Rational const& rhs)
     {
-        PRAT lhsRat = this->ToPRAT();
-        PRAT rhsRat = rhs.ToPRAT();
-
-        try
+        if (IsI64() && rhs.IsI64())
         {
-            andrat(&lhsRat, rhsRat, RATIONAL_BASE, RATIONAL_PRECISION);
-            destroyrat(rhsRat);
+            int64_t sum;
+            if (TryAddI64(m_i64, rhs.m_i64, &sum))
+            {
+                m_i64 = sum;
+                return *this;
+            }
         }
-        catch (uint32_t error)
+
+        return ApplyRatOp(rhs, [](PRAT* lhsRat, PRAT rhsRat) { addrat(lhsRat, rhsRat, RATIONAL_PRECISION); });
+    }
+
+    Rational& Rational::operator-=(Rational const& rhs)
+    {
+        if (IsI64() && rhs.IsI64())
         {
-            destroyrat(lhsRat);
-            destroyrat(rhsRat);
-            throw(error);
+            int64_t difference;
+            if (TrySubI64(m_i64, rhs.m_i64, &difference))
+            {
+                m_i64 = difference;
+                return *this;
+            }
         }
 
-        *this = Rational{ lhsRat };
-        destroyrat(lhsRat);
-
-        return *this;
+        return ApplyRatOp(rhs, [](PRAT* lhsRat, PRAT rhsRat) { subrat(lhsRat, rhsRat, RATIONAL_PRECISION); });
     }
 
-    Rational& Rational::operator|=(Rational const& rhs)
+    Rational& Rational::operator*=(Rational const& rhs)
     {
-        PRAT lhsRat = this->ToPRAT();
-        PRAT rhsRat = rhs.ToPRAT();
-        try
+        if (IsI64() && rhs.IsI64())
         {
-            orrat(&lhsRat, rhsRat, RATIONAL_BASE, RATIONAL_PRECISION);
-            destroyrat(rhsRat);
+            int64_t product;
+            if (TryMulI64(m_i64, rhs.m_i64, &product))
+            {
+                m_i64 = product;
+                return *this;
+            }
         }
-        catch (uint32_t error)
+
+        return ApplyRatOp(rhs, [](PRAT* lhsRat, PRAT rhsRat) { mulrat(lhsRat, rhsRat, RATIONAL_PRECISION); });
+    }
+
+    Rational& Rational::operator/=(Rational const& rhs)
+    {
+        if (IsI64() && rhs.IsI64())
         {
-            destroyrat(lhsRat);
-            destroyrat(rhsRat);
-            throw(error);
+            int64_t quotient;
+            if (TryDivI64(m_i64, rhs.m_i64, &quotient))
+            {
+                m_i64 = quotient;
+                return *this;
+            }
         }
 
-        *this = Rational{ lhsRat };
-        destroyrat(lhsRat);
+        return ApplyRatOp(rhs, [](PRAT* lhsRat, PRAT rhsRat) { divrat(lhsRat, rhsRat, RATIONAL_PRECISION); });
+    }
 
-        return *this;
+    Rational& Rational::operator%=(Rational const& rhs)
+    {
+        return ApplyRatOp(rhs, [](PRAT* lhsRat, PRAT rhsRat) { modrat(lhsRat, rhsRat); });
+    }
+
+    Rational& Rational::operator<<=(Rational const& rhs)
+    {
+        return ApplyRatOp(rhs, [](PRAT* lhsRat, PRAT rhsRat) { lshrat(lhsRat, rhsRat, RATIONAL_BASE, RATIONAL_PRECISION); });
+    }
+
+    Rational& Rational::operator>>=(Rational const& rhs)
+    {
+        return ApplyRatOp(rhs, [](PRAT* lhsRat, PRAT rhsRat) { rshrat(lhsRat, rhsRat, RATIONAL_BASE, RATIONAL_PRECISION); });
+    }
+
+    Rational& Rational::operator&=(Rational const& rhs)
+    {
+        return ApplyRatOp(rhs, [](PRAT* lhsRat, PRAT rhsRat) { andrat(lhsRat, rhsRat, RATIONAL_BASE, RATIONAL_PRECISION); });
+    }
+
+    Rational& Rational::operator|=(Rational const& rhs)
+    {
+        return ApplyRatOp(rhs, [](PRAT* lhsRat, PRAT rhsRat) { orrat(lhsRat, rhsRat, RATIONAL_BASE, RATIONAL_PRECISION); });
     }
 
     Rational& Rational::operator^=(Rational const& rhs)
     {
-        PRAT lhsRat = this->ToPRAT();
-        PRAT rhsRat = rhs.ToPRAT();
-        try
-        {
-            xorrat(&lhsRat, rhsRat, RATIONAL_BASE, RATIONAL_PRECISION);
-            destroyrat(rhsRat);
-        }
-        catch (uint32_t error)
+        return ApplyRatOp(rhs, [](PRAT* lhsRat, PRAT rhsRat) { xorrat(lhsRat, rhsRat, RATIONAL_BASE, RATIONAL_PRECISION); });
+    }
+
+    Rational& Rational::ChopToBitWidth(uint32_t bits)
+    {
+        // A nonnegative lane value masks natively; with 64 or more bits
+        // kept it already fits the width.
+        if (IsI64() && m_i64 >= 0)
         {
-            destroyrat(lhsRat);
-            destroyrat(rhsRat);
-            throw(error);
+            if (bits < 64)
+            {
+                m_i64 = static_cast<int64_t>(static_cast<uint64_t>(m_i64) & ((1ULL << bits) - 1));
+            }
+            return *this;
         }
 
-        *this = Rational{ lhsRat };
-        destroyrat(lhsRat);
+        Materialize();
+        choprat(&m_prat, bits, RATIONAL_BASE, RATIONAL_PRECISION);
 
+        if (TryRatToLane(m_prat, &m_i64))
+        {
+            destroyrat(m_prat);
+        }
         return *this;
     }
 
@@ -380,8 +539,15 @@ namespace CalcEngine
 
     bool operator==(Rational const& lhs, Rational const& rhs)
     {
-        PRAT lhsRat = lhs.ToPRAT();
-        PRAT rhsRat = rhs.ToPRAT();
+        if (lhs.m_prat == nullptr && rhs.m_prat == nullptr)
+        {
+            return lhs.m_i64 == rhs.m_i64;
+        }
+
+        PRAT lhsOwned = nullptr;
+        PRAT lhsRat = BorrowRat(lhs.m_prat, lhs.m_i64, &lhsOwned);
+        PRAT rhsOwned = nullptr;
+        PRAT rhsRat = BorrowRat(rhs.m_prat, rhs.m_i64, &rhsOwned);
 
         bool result = false;
         try
@@ -390,13 +556,13 @@ namespace CalcEngine
         }
         catch (uint32_t error)
         {
-            destroyrat(lhsRat);
-            destroyrat(rhsRat);
+            destroyrat(lhsOwned);
+            destroyrat(rhsOwned);
             throw(error);
         }
 
-        destroyrat(lhsRat);
-        destroyrat(rhsRat);
+        destroyrat(lhsOwned);
+        destroyrat(rhsOwned);
 
         return result;
     }
@@ -408,8 +574,15 @@ namespace CalcEngine
 
     bool operator<(Rational const& lhs, Rational const& rhs)
     {
-        PRAT lhsRat = lhs.ToPRAT();
-        PRAT rhsRat = rhs.ToPRAT();
+        if (lhs.m_prat == nullptr && rhs.m_prat == nullptr)
+        {
+            return lhs.m_i64 < rhs.m_i64;
+        }
+
+        PRAT lhsOwned = nullptr;
+        PRAT lhsRat = BorrowRat(lhs.m_prat, lhs.m_i64, &lhsOwned);
+        PRAT rhsOwned = nullptr;
+        PRAT rhsRat = BorrowRat(rhs.m_prat, rhs.m_i64, &rhsOwned);
 
         bool result = false;
         try
@@ -418,13 +591,13 @@ namespace CalcEngine
         }
         catch (uint32_t error)
         {
-            destroyrat(lhsRat);
-            destroyrat(rhsRat);
+            destroyrat(lhsOwned);
+            destroyrat(rhsOwned);
             throw(error);
         }
 
-        destroyrat(lhsRat);
-        destroyrat(rhsRat);
+        destroyrat(lhsOwned);
+        destroyrat(rhsOwned);
 
         return result;
     }
@@ -466,6 +639,11 @@ namespace CalcEngine
 
     uint64_t Rational::ToUInt64_t() const
     {
+        if (m_prat == nullptr && m_i64 >= 0)
+        {
+            return static_cast<uint64_t>(m_i64);
+        }
+
         PRAT rat = this->ToPRAT();
         uint64_t result;
         try
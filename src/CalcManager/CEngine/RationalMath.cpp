@@ -7,383 +7,327 @@
 using namespace std;
 using namespace CalcEngine;
 
-Rational RationalMath::Frac(Rational const& rat)
+namespace CalcEngine::RationalMath
 {
-    PRAT prat = rat.ToPRAT();
-    try
+    Pipeline::Pipeline(Rational const& rat) :
+        m_prat{ rat.ToPRAT() }
+    {}
+
+    Pipeline::~Pipeline()
     {
-        fracrat(&prat, RATIONAL_BASE, RATIONAL_PRECISION);
+        destroyrat(m_prat);
     }
-    catch (uint32_t error)
+
+    Pipeline& Pipeline::Frac()
     {
-        destroyrat(prat);
-        throw(error);
+        fracrat(&m_prat, RATIONAL_BASE, RATIONAL_PRECISION);
+        return *this;
     }
 
-    Rational result{ prat };
-    destroyrat(prat);
-
-    return result;
-}
-
-Rational RationalMath::Integer(Rational const& rat)
-{
-    PRAT prat = rat.ToPRAT();
-    try
+    Pipeline& Pipeline::Integer()
     {
-        intrat(&prat, RATIONAL_BASE, RATIONAL_PRECISION);
+        intrat(&m_prat, RATIONAL_BASE, RATIONAL_PRECISION);
+        return *this;
     }
-    catch (uint32_t error)
+
+    Pipeline& Pipeline::Pow(Rational const& pow)
     {
-        destroyrat(prat);
-        throw(error);
+        PRAT powRat = pow.ToPRAT();
+
+        try
+        {
+            powrat(&m_prat, powRat, RATIONAL_BASE, RATIONAL_PRECISION);
+        }
+        catch (uint32_t error)
+        {
+            destroyrat(powRat);
+            throw(error);
+        }
+
+        destroyrat(powRat);
+        return *this;
     }
 
-    Rational result{ prat };
-    destroyrat(prat);
+    Pipeline& Pipeline::Root(Rational const& root)
+    {
+        PRAT rootRat = root.ToPRAT();
 
-    return result;
-}
+        try
+        {
+            rootrat(&m_prat, rootRat, RATIONAL_BASE, RATIONAL_PRECISION);
+        }
+        catch (uint32_t error)
+        {
+            destroyrat(rootRat);
+            throw(error);
+        }
 
-Rational RationalMath::Pow(Rational const& base, Rational const& pow)
-{
-    PRAT baseRat = base.ToPRAT();
-    PRAT powRat = pow.ToPRAT();
+        destroyrat(rootRat);
+        return *this;
+    }
 
-    try
+    Pipeline& Pipeline::Fact()
     {
-        powrat(&baseRat, powRat, RATIONAL_BASE, RATIONAL_PRECISION);
-        destroyrat(powRat);
+        factrat(&m_prat, RATIONAL_BASE, RATIONAL_PRECISION);
+        return *this;
     }
-    catch (uint32_t error)
+
+    Pipeline& Pipeline::Exp()
     {
-        destroyrat(baseRat);
-        destroyrat(powRat);
-        throw(error);
+        exprat(&m_prat, RATIONAL_BASE, RATIONAL_PRECISION);
+        return *this;
     }
 
-    Rational result{ baseRat };
-    destroyrat(baseRat);
+    Pipeline& Pipeline::Log()
+    {
+        lograt(&m_prat, RATIONAL_PRECISION);
+        return *this;
+    }
 
-    return result;
-}
+    Pipeline& Pipeline::Log10()
+    {
+        lograt(&m_prat, RATIONAL_PRECISION);
+        divrat(&m_prat, ln_ten, RATIONAL_PRECISION);
+        return *this;
+    }
 
-Rational RationalMath::Root(Rational const& base, Rational const& root)
-{
-    return Pow(base, Invert(root));
-}
+    Pipeline& Pipeline::Invert()
+    {
+        PRAT inverted = nullptr;
+        DUPRAT(inverted, rat_one);
 
-Rational RationalMath::Fact(Rational const& rat)
-{
-    PRAT prat = rat.ToPRAT();
+        try
+        {
+            divrat(&inverted, m_prat, RATIONAL_PRECISION);
+        }
+        catch (uint32_t error)
+        {
+            destroyrat(inverted);
+            throw(error);
+        }
 
-    try
-    {
-        factrat(&prat, RATIONAL_BASE, RATIONAL_PRECISION);
+        destroyrat(m_prat);
+        m_prat = inverted;
+        return *this;
     }
-    catch (uint32_t error)
+
+    Pipeline& Pipeline::Abs()
     {
-        destroyrat(prat);
-        throw(error);
+        m_prat->pp->sign = 1;
+        m_prat->pq->sign = 1;
+        return *this;
     }
 
-    Rational result{ prat };
-    destroyrat(prat);
+    Pipeline& Pipeline::Sin(ANGLE_TYPE angletype)
+    {
+        sinanglerat(&m_prat, angletype, RATIONAL_BASE, RATIONAL_PRECISION);
+        return *this;
+    }
 
-    return result;
-}
+    Pipeline& Pipeline::Cos(ANGLE_TYPE angletype)
+    {
+        cosanglerat(&m_prat, angletype, RATIONAL_BASE, RATIONAL_PRECISION);
+        return *this;
+    }
 
-Rational RationalMath::Exp(Rational const& rat)
-{
-    PRAT prat = rat.ToPRAT();
+    Pipeline& Pipeline::Tan(ANGLE_TYPE angletype)
+    {
+        tananglerat(&m_prat, angletype, RATIONAL_BASE, RATIONAL_PRECISION);
+        return *this;
+    }
 
-    try
+    Pipeline& Pipeline::ASin(ANGLE_TYPE angletype)
     {
-        exprat(&prat, RATIONAL_BASE, RATIONAL_PRECISION);
+        asinanglerat(&m_prat, angletype, RATIONAL_BASE, RATIONAL_PRECISION);
+        return *this;
     }
-    catch (uint32_t error)
+
+    Pipeline& Pipeline::ACos(ANGLE_TYPE angletype)
     {
-        destroyrat(prat);
-        throw(error);
+        acosanglerat(&m_prat, angletype, RATIONAL_BASE, RATIONAL_PRECISION);
+        return *this;
     }
 
-    Rational result{ prat };
-    destroyrat(prat);
+    Pipeline& Pipeline::ATan(ANGLE_TYPE angletype)
+    {
+        atananglerat(&m_prat, angletype, RATIONAL_BASE, RATIONAL_PRECISION);
+        return *this;
+    }
 
-    return result;
-}
+    Pipeline& Pipeline::Sinh()
+    {
+        sinhrat(&m_prat, RATIONAL_BASE, RATIONAL_PRECISION);
+        return *this;
+    }
 
-Rational RationalMath::Log(Rational const& rat)
-{
-    PRAT prat = rat.ToPRAT();
+    Pipeline& Pipeline::Cosh()
+    {
+        coshrat(&m_prat, RATIONAL_BASE, RATIONAL_PRECISION);
+        return *this;
+    }
 
-    try
+    Pipeline& Pipeline::Tanh()
     {
-        lograt(&prat, RATIONAL_PRECISION);
+        tanhrat(&m_prat, RATIONAL_BASE, RATIONAL_PRECISION);
+        return *this;
     }
-    catch (uint32_t error)
+
+    Pipeline& Pipeline::ASinh()
     {
-        destroyrat(prat);
-        throw(error);
+        asinhrat(&m_prat, RATIONAL_BASE, RATIONAL_PRECISION);
+        return *this;
     }
 
-    Rational result{ prat };
-    destroyrat(prat);
+    Pipeline& Pipeline::ACosh()
+    {
+        acoshrat(&m_prat, RATIONAL_BASE, RATIONAL_PRECISION);
+        return *this;
+    }
 
-    return result;
-}
+    Pipeline& Pipeline::ATanh()
+    {
+        atanhrat(&m_prat, RATIONAL_PRECISION);
+        return *this;
+    }
 
-Rational RationalMath::Log10(Rational const& rat)
-{
-    return Log(rat) / Rational{ ln_ten };
+    Rational Pipeline::ToRational() const
+    {
+        return Rational{ m_prat };
+    }
 }
 
-Rational RationalMath::Invert(Rational const& rat)
+Rational RationalMath::Frac(Rational const& rat)
 {
-    return 1 / rat;
+    return Pipeline{ rat }.Frac().ToRational();
 }
 
-Rational RationalMath::Abs(Rational const& rat)
+Rational RationalMath::Integer(Rational const& rat)
 {
-    return Rational{ Number{ 1, rat.P().Exp(), rat.P().Mantissa() }, Number{ 1, rat.Q().Exp(), rat.Q().Mantissa() } };
+    return Pipeline{ rat }.Integer().ToRational();
 }
 
-Rational RationalMath::Sin(Rational const& rat, ANGLE_TYPE angletype)
+Rational RationalMath::MulAdd(Rational const& rat, Rational const& mul, Rational const& add)
 {
-    PRAT prat = rat.ToPRAT();
+    PRAT ratPrat = rat.ToPRAT();
+    PRAT mulPrat = mul.ToPRAT();
+    PRAT addPrat = add.ToPRAT();
 
     try
     {
-        sinanglerat(&prat, angletype, RATIONAL_BASE, RATIONAL_PRECISION);
+        mulnaddrat(&ratPrat, mulPrat, addPrat, RATIONAL_PRECISION);
+        destroyrat(mulPrat);
+        destroyrat(addPrat);
     }
     catch (uint32_t error)
     {
-        destroyrat(prat);
+        destroyrat(ratPrat);
+        destroyrat(mulPrat);
+        destroyrat(addPrat);
         throw(error);
     }
 
-    Rational result{ prat };
-    destroyrat(prat);
+    Rational result{ ratPrat };
+    destroyrat(ratPrat);
 
     return result;
 }
 
-Rational RationalMath::Cos(Rational const& rat, ANGLE_TYPE angletype)
+Rational RationalMath::Pow(Rational const& base, Rational const& pow)
 {
-    PRAT prat = rat.ToPRAT();
+    return Pipeline{ base }.Pow(pow).ToRational();
+}
 
-    try
-    {
-        cosanglerat(&prat, angletype, RATIONAL_BASE, RATIONAL_PRECISION);
-    }
-    catch (uint32_t error)
-    {
-        destroyrat(prat);
-        throw(error);
-    }
+Rational RationalMath::Root(Rational const& base, Rational const& root)
+{
+    return Pipeline{ base }.Root(root).ToRational();
+}
 
-    Rational result{ prat };
-    destroyrat(prat);
+Rational RationalMath::Fact(Rational const& rat)
+{
+    return Pipeline{ rat }.Fact().ToRational();
+}
 
-    return result;
+Rational RationalMath::Exp(Rational const& rat)
+{
+    return Pipeline{ rat }.Exp().ToRational();
 }
 
-Rational RationalMath::Tan(Rational const& rat, ANGLE_TYPE angletype)
+Rational RationalMath::Log(Rational const& rat)
 {
-    PRAT prat = rat.ToPRAT();
+    return Pipeline{ rat }.Log().ToRational();
+}
 
-    try
-    {
-        tananglerat(&prat, angletype, RATIONAL_BASE, RATIONAL_PRECISION);
-    }
-    catch (uint32_t error)
-    {
-        destroyrat(prat);
-        throw(error);
-    }
+Rational RationalMath::Log10(Rational const& rat)
+{
+    return Pipeline{ rat }.Log10().ToRational();
+}
 
-    Rational result{ prat };
-    destroyrat(prat);
+Rational RationalMath::Invert(Rational const& rat)
+{
+    return Pipeline{ rat }.Invert().ToRational();
+}
 
-    return result;
+Rational RationalMath::Abs(Rational const& rat)
+{
+    return Pipeline{ rat }.Abs().ToRational();
 }
 
-Rational RationalMath::ASin(Rational const& rat, ANGLE_TYPE angletype)
+Rational RationalMath::Sin(Rational const& rat, ANGLE_TYPE angletype)
 {
-    PRAT prat = rat.ToPRAT();
+    return Pipeline{ rat }.Sin(angletype).ToRational();
+}
 
-    try
-    {
-        asinanglerat(&prat, angletype, RATIONAL_BASE, RATIONAL_PRECISION);
-    }
-    catch (uint32_t error)
-    {
-        destroyrat(prat);
-        throw(error);
-    }
+Rational RationalMath::Cos(Rational const& rat, ANGLE_TYPE angletype)
+{
+    return Pipeline{ rat }.Cos(angletype).ToRational();
+}
 
-    Rational result{ prat };
-    destroyrat(prat);
+Rational RationalMath::Tan(Rational const& rat, ANGLE_TYPE angletype)
+{
+    return Pipeline{ rat }.Tan(angletype).ToRational();
+}
 
-    return result;
+Rational RationalMath::ASin(Rational const& rat, ANGLE_TYPE angletype)
+{
+    return Pipeline{ rat }.ASin(angletype).ToRational();
 }
 
 Rational RationalMath::ACos(Rational const& rat, ANGLE_TYPE angletype)
 {
-    PRAT prat = rat.ToPRAT();
-
-    try
-    {
-        acosanglerat(&prat, angletype, RATIONAL_BASE, RATIONAL_PRECISION);
-    }
-    catch (uint32_t error)
-    {
-        destroyrat(prat);
-        throw(error);
-    }
-
-    Rational result{ prat };
-    destroyrat(prat);
-
-    return result;
+    return Pipeline{ rat }.ACos(angletype).ToRational();
 }
 
 Rational RationalMath::ATan(Rational const& rat, ANGLE_TYPE angletype)
 {
-    PRAT prat = rat.ToPRAT();
-
-    try
-    {
-        atananglerat(&prat, angletype, RATIONAL_BASE, RATIONAL_PRECISION);
-    }
-    catch (uint32_t error)
-    {
-        destroyrat(prat);
-        throw(error);
-    }
-
-    Rational result{ prat };
-    destroyrat(prat);
-
-    return result;
+    return Pipeline{ rat }.ATan(angletype).ToRational();
 }
 
 Rational RationalMath::Sinh(Rational const& rat)
 {
-    PRAT prat = rat.ToPRAT();
-
-    try
-    {
-        sinhrat(&prat, RATIONAL_BASE, RATIONAL_PRECISION);
-    }
-    catch (uint32_t error)
-    {
-        destroyrat(prat);
-        throw(error);
-    }
-
-    Rational result{ prat };
-    destroyrat(prat);
-
-    return result;
+    return Pipeline{ rat }.Sinh().ToRational();
 }
 
 Rational RationalMath::Cosh(Rational const& rat)
 {
-    PRAT prat = rat.ToPRAT();
-
-    try
-    {
-        coshrat(&prat, RATIONAL_BASE, RATIONAL_PRECISION);
-    }
-    catch (uint32_t error)
-    {
-        destroyrat(prat);
-        throw(error);
-    }
-
-    Rational result{ prat };
-    destroyrat(prat);
-
-    return result;
+    return Pipeline{ rat }.Cosh().ToRational();
 }
 
 Rational RationalMath::Tanh(Rational const& rat)
 {
-    PRAT prat = rat.ToPRAT();
-
-    try
-    {
-        tanhrat(&prat, RATIONAL_BASE, RATIONAL_PRECISION);
-    }
-    catch (uint32_t error)
-    {
-        destroyrat(prat);
-        throw(error);
-    }
-
-    Rational result{ prat };
-    destroyrat(prat);
-
-    return result;
+    return Pipeline{ rat }.Tanh().ToRational();
 }
 
 Rational RationalMath::ASinh(Rational const& rat)
 {
-    PRAT prat = rat.ToPRAT();
-
-    try
-    {
-        asinhrat(&prat, RATIONAL_BASE, RATIONAL_PRECISION);
-    }
-    catch (uint32_t error)
-    {
-        destroyrat(prat);
-        throw(error);
-    }
-
-    Rational result{ prat };
-    destroyrat(prat);
-
-    return result;
+    return Pipeline{ rat }.ASinh().ToRational();
 }
 
 Rational RationalMath::ACosh(Rational const& rat)
 {
-    PRAT prat = rat.ToPRAT();
-
-    try
-    {
-        acoshrat(&prat, RATIONAL_BASE, RATIONAL_PRECISION);
-    }
-    catch (uint32_t error)
-    {
-        destroyrat(prat);
-        throw(error);
-    }
-
-    Rational result{ prat };
-    destroyrat(prat);
-
-    return result;
+    return Pipeline{ rat }.ACosh().ToRational();
 }
 
 Rational RationalMath::ATanh(Rational const& rat)
 {
-    PRAT prat = rat.ToPRAT();
-
-    try
-    {
-        atanhrat(&prat, RATIONAL_PRECISION);
-    }
-    catch (uint32_t error)
-    {
-        destroyrat(prat);
-        throw(error);
-    }
-
-    Rational result{ prat };
-    destroyrat(prat);
-
-    return result;
+    return Pipeline{ rat }.ATanh().ToRational();
 }
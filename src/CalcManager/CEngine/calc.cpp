@@ -2,6 +2,8 @@
 // Licensed under the MIT License.
 
 #include "pch.h"
+#include <atomic>
+#include <mutex>
 #include "Header Files/CalcEngine.h"
 
 #include "CalculatorResource.h"
@@ -22,17 +24,35 @@ static constexpr wchar_t DEFAULT_GRP_SEPARATOR = L',';
 static constexpr wstring_view DEFAULT_GRP_STR = L"3;0";
 static constexpr wstring_view DEFAULT_NUMBER_STR = L"0";
 
-// Read strings for keys, errors, trig types, etc.
-// These will be copied from the resources to local memory.
+// Strings for keys, errors, trig types, etc.
+// These are copied from the resources to local memory on first use of
+// each id; standard mode touches only a fraction of the table, so no
+// construction path pays for a full resource sweep.
 
 array<wstring, CSTRINGSENGMAX> CCalcEngine::s_engineStrings;
 
-void CCalcEngine::LoadEngineStrings(CalculationManager::IResourceProvider& resourceProvider)
+namespace
 {
-    for (size_t i = 0; i < s_engineStrings.size(); i++)
+    // Guards first-use loads and provider registration. The provider
+    // implementations are stateless fronts over process-wide singletons,
+    // so the most recently registered one can serve any id.
+    mutex s_engineStringsMutex;
+    array<atomic<bool>, CSTRINGSENGMAX> s_engineStringLoaded;
+    CalculationManager::IResourceProvider* s_engineStringsProvider = nullptr;
+}
+
+wstring_view CCalcEngine::GetString(int ids)
+{
+    if (!s_engineStringLoaded[ids].load(memory_order_acquire))
     {
-        s_engineStrings[i] = resourceProvider.GetCEngineString(g_sids[i]);
+        lock_guard<mutex> lock(s_engineStringsMutex);
+        if (!s_engineStringLoaded[ids].load(memory_order_relaxed) && s_engineStringsProvider != nullptr)
+        {
+            s_engineStrings[ids] = s_engineStringsProvider->GetCEngineString(g_sids[ids]);
+            s_engineStringLoaded[ids].store(true, memory_order_release);
+        }
     }
+    return s_engineStrings[ids];
 }
 
 //////////////////////////////////////////////////
@@ -42,10 +62,31 @@ void CCalcEngine::LoadEngineStrings(CalculationManager::IResourceProvider& resou
 //////////////////////////////////////////////////
 void CCalcEngine::InitialOneTimeOnlySetup(CalculationManager::IResourceProvider& resourceProvider)
 {
-    LoadEngineStrings(resourceProvider);
+    // Register the provider; the string table itself fills lazily as ids
+    // are first used, so neither window open nor mode switch pays for a
+    // resource sweep here.
+    {
+        lock_guard<mutex> lock(s_engineStringsMutex);
+        s_engineStringsProvider = &resourceProvider;
+    }
 
     // we must now set up all the ratpak constants and our arrayed pointers
-    // to these constants.
+    // to these constants.  The constants are per thread, but derived sets
+    // are shared process-wide, so repeat setup copies instead of deriving.
+    InitialPerThreadSetup();
+}
+
+//////////////////////////////////////////////////
+//
+// InitialPerThreadSetup
+//
+//////////////////////////////////////////////////
+// The per-thread share of the setup above: derive (or copy from the
+// process-wide pool) this thread's ratpak constants. A worker thread
+// that constructs or runs engines must call this before its first use;
+// the string table is process-wide and is not touched here.
+void CCalcEngine::InitialPerThreadSetup()
+{
     ChangeBaseConstants(DEFAULT_RADIX, DEFAULT_MAX_DIGITS, DEFAULT_PRECISION);
 }
 
@@ -73,6 +114,7 @@ CCalcEngine::CCalcEngine(bool fPrecedence, bool fIntegerMode, CalculationManager
     m_parenVals{},
     m_precedenceVals{},
     m_bError(false),
+    m_nLastError(0),
     m_bInv(false),
     m_bNoPrevEqu(true),
     m_radix(DEFAULT_RADIX),
@@ -89,7 +131,18 @@ CCalcEngine::CCalcEngine(bool fPrecedence, bool fIntegerMode, CalculationManager
     m_angletype(ANGLE_DEG),
     m_numwidth(QWORD_WIDTH),
     m_HistoryCollector(pCalcDisplay, pHistoryDisplay, DEFAULT_DEC_SEPARATOR),
-    m_groupSeparator(DEFAULT_GRP_SEPARATOR)
+    m_groupSeparator(DEFAULT_GRP_SEPARATOR),
+    m_groupedCacheRadix(0),
+    m_radixStringCacheMask(0),
+    m_radixStringCachePrecision(-1),
+    m_radixStringCacheBitWidth(-1),
+    m_radixStringCacheFmt(FMT_FLOAT),
+    m_specCancel(false),
+    m_specExit(false),
+    m_specPending(false),
+    m_specDone(false),
+    m_specOpCode(0),
+    m_specError(0)
 {
     InitChopNumbers();
 
@@ -102,6 +155,21 @@ CCalcEngine::CCalcEngine(bool fPrecedence, bool fIntegerMode, CalculationManager
     DisplayNum();
 }
 
+CCalcEngine::~CCalcEngine()
+{
+    // Retire the repeat-equals speculation worker, if it was ever started.
+    if (m_specThread.joinable())
+    {
+        {
+            lock_guard<mutex> lock(m_specMutex);
+            m_specCancel = true;
+            m_specExit = true;
+        }
+        m_specWake.notify_one();
+        m_specThread.join();
+    }
+}
+
 void CCalcEngine::InitChopNumbers()
 {
     // these rat numbers are set only once and then never change regardless of
@@ -157,6 +225,8 @@ void CCalcEngine::SettingsChanged()
     // if the grouping pattern or thousands symbol changed we need to refresh the display
     if (m_decGrouping != lastDecGrouping || m_groupSeparator != lastSep)
     {
+        // Grouped strings cached under the old separators are stale now
+        m_groupedCacheRadix = 0;
         numChanged = true;
     }
 
@@ -167,10 +237,18 @@ void CCalcEngine::SettingsChanged()
         m_input.SetDecimalSymbol(m_decimalSeparator);
         m_HistoryCollector.SetDecimalSymbol(m_decimalSeparator);
 
-        // put the new decimal symbol into the table used to draw the decimal key
-        s_engineStrings[IDS_DECIMAL] = m_decimalSeparator;
+        // put the new decimal symbol into the table used to draw the decimal
+        // key, and mark the id loaded so a lazy fetch cannot clobber it
+        {
+            lock_guard<mutex> lock(s_engineStringsMutex);
+            s_engineStrings[IDS_DECIMAL] = m_decimalSeparator;
+            s_engineStringLoaded[IDS_DECIMAL].store(true, memory_order_release);
+        }
 
         // we need to redraw to update the decimal point button
+        m_groupedCacheRadix = 0;
+        // Rendered strings carry the decimal separator too
+        m_radixStringCacheMask = 0;
         numChanged = true;
     }
 
@@ -180,7 +258,41 @@ void CCalcEngine::SettingsChanged()
     }
 }
 
+// Drop the grouped-display and per-radix string caches so their backing
+// allocations go back to the heap. Both carry their own validity stamps
+// (m_groupedCacheRadix, m_radixStringCacheMask), so zeroing those is the
+// same invalidation SettingsChanged already performs; the shrink_to_fit
+// calls are what make this a memory trim rather than a plain invalidate.
+void CCalcEngine::TrimDisplayCaches()
+{
+    m_groupedCacheRadix = 0;
+    m_groupedCacheInput.clear();
+    m_groupedCacheInput.shrink_to_fit();
+    m_groupedCacheResult.clear();
+    m_groupedCacheResult.shrink_to_fit();
+
+    m_radixStringCacheMask = 0;
+    for (auto& cached : m_radixStringCache)
+    {
+        cached.clear();
+        cached.shrink_to_fit();
+    }
+}
+
 wchar_t CCalcEngine::DecimalSeparator() const
 {
     return m_decimalSeparator;
 }
+
+// Rebind a pre-built engine to the manager that adopts it. While the
+// engine waited in the warm pool its provider answered with defaults and
+// its display pointers were null; hook up the real ones and re-read the
+// separator settings, which refreshes the display if the locale differs
+// from the defaults the engine was built with.
+void CCalcEngine::AdoptCallbacks(CalculationManager::IResourceProvider* pResourceProvider, __in_opt ICalcDisplay* pCalcDisplay, __in_opt shared_ptr<IHistoryDisplay> pHistoryDisplay)
+{
+    m_resourceProvider = pResourceProvider;
+    m_pCalcDisplay = pCalcDisplay;
+    m_HistoryCollector.RebindDisplays(pCalcDisplay, pHistoryDisplay);
+    SettingsChanged();
+}
@@ -33,22 +33,29 @@ namespace {
     // 0 is returned. Higher the number, higher the precedence of the operator.
     int NPrecedenceOfOp(int nopCode)
     {
-        static uint8_t rgbPrec[] = { 0,0,  IDC_OR,0, IDC_XOR,0,  IDC_AND,1,
-            IDC_ADD,2, IDC_SUB,2,    IDC_RSHF,3, IDC_LSHF,3,
-            IDC_MOD,3, IDC_DIV,3, IDC_MUL,3,  IDC_PWR,4,   IDC_ROOT, 4 };
-        unsigned int iPrec;
-
-        iPrec = 0;
-        while ((iPrec < size(rgbPrec)) && (nopCode != rgbPrec[iPrec]))
-        {
-            iPrec += 2;
-        }
-        if (iPrec >= size(rgbPrec))
+        // The binary operators are a dense command range, so the precedence
+        // is a direct lookup indexed by nopCode - IDC_AND.
+        static constexpr uint8_t rgbPrec[] = {
+            1, // IDC_AND
+            0, // IDC_OR
+            0, // IDC_XOR
+            3, // IDC_LSHF
+            3, // IDC_RSHF
+            3, // IDC_DIV
+            3, // IDC_MUL
+            2, // IDC_ADD
+            2, // IDC_SUB
+            3, // IDC_MOD
+            4, // IDC_ROOT
+            4, // IDC_PWR
+        };
+
+        if (nopCode < IDC_AND || nopCode > IDC_PWR)
         {
-            iPrec = 0;
+            return 0;
         }
-        return rgbPrec[iPrec + 1];
 
+        return rgbPrec[nopCode - IDC_AND];
     }
 }
 
@@ -94,6 +101,87 @@ void CCalcEngine::ProcessCommand(OpCode wParam)
     ProcessCommandWorker(wParam);
 }
 
+// Processes count repetitions of a single keystroke, collapsing the run
+// into one engine operation where the command has a batched form. A held
+// Backspace or digit key delivers repeats faster than a full
+// ProcessCommand plus display refresh per keystroke can drain on a long
+// operand; for those commands the repeats beyond the first edit m_input
+// directly and refresh the display once. The first repetition always runs
+// the full per-command path, since only it can trigger the record-mode
+// transition, error recovery and history bookkeeping.
+void CCalcEngine::ProcessCommandRun(OpCode wParam, uint32_t count)
+{
+    bool fBatchable = (wParam == IDC_BACK) || IsDigitOpCode(wParam);
+
+    if (fBatchable && count > 0)
+    {
+        ProcessCommand(wParam);
+        count--;
+    }
+
+    if (count == 0)
+    {
+        return;
+    }
+
+    if (!fBatchable || !m_bRecord || m_bError)
+    {
+        // No batched form, or the first keystroke left a state (error,
+        // committed input) where each repeat has per-command semantics.
+        while (count-- > 0)
+        {
+            ProcessCommand(wParam);
+        }
+        return;
+    }
+
+    if (wParam == IDC_BACK)
+    {
+        m_input.Backspace(count);
+        DisplayNum();
+        return;
+    }
+
+    unsigned int iValue = static_cast<unsigned int>(wParam - IDC_0);
+
+    // TryAddDigit trusts its input; a digit outside the radix stays on the
+    // per-command path, which routes it through HandleErrorCommand.
+    if (iValue >= static_cast<unsigned int>(m_radix))
+    {
+        while (count-- > 0)
+        {
+            ProcessCommand(wParam);
+        }
+        return;
+    }
+
+    // Digit run. The per-keystroke path records each digit as the last
+    // command; after two or more repeats both slots hold this digit.
+    m_nLastCom = (int)wParam;
+    bool fAdded = false;
+
+    while (count-- > 0)
+    {
+        if (!m_input.TryAddDigit(iValue, m_radix, m_fIntegerMode, m_maxDecimalValueStrings[m_numwidth], m_dwWordBitWidth, m_cIntDigitsSav))
+        {
+            if (fAdded)
+            {
+                DisplayNum();
+                fAdded = false;
+            }
+            HandleErrorCommand(wParam);
+            HandleMaxDigitsReached();
+            return;
+        }
+        fAdded = true;
+    }
+
+    if (fAdded)
+    {
+        DisplayNum();
+    }
+}
+
 void CCalcEngine::ProcessCommandWorker(OpCode wParam)
 {
     int            nx, ni;
@@ -110,6 +198,13 @@ void CCalcEngine::ProcessCommandWorker(OpCode wParam)
         m_nTempCom = (int)wParam;
     }
 
+    // Anything but a repeat "=" invalidates the speculated iterate; retire
+    // it before the command can touch state the worker reads.
+    if (wParam != IDC_EQU)
+    {
+        DiscardEquSpeculation();
+    }
+
     if (m_bError)
     {
         if (wParam == IDC_CLEAR)
@@ -131,13 +226,8 @@ void CCalcEngine::ProcessCommandWorker(OpCode wParam)
     // Toggle Record/Display mode if appropriate.
     if (m_bRecord)
     {
-        if (IsOpInRange(wParam, IDC_AND, IDC_MMINUS) ||
-            IsOpInRange(wParam, IDC_OPENP, IDC_CLOSEP) ||
-            IsOpInRange(wParam, IDM_HEX, IDM_BIN) ||
-            IsOpInRange(wParam, IDM_QWORD, IDM_BYTE) ||
-            IsOpInRange(wParam, IDM_DEG, IDM_GRAD) ||
+        if (IsInputCommittingOpCode(wParam) ||
             IsOpInRange(wParam, IDC_BINEDITSTART, IDC_BINEDITSTART + 63) ||
-            (IDC_INV == wParam) ||
             (IDC_SIGN == wParam && 10 != m_radix))
         {
             m_bRecord = false;
@@ -482,8 +572,17 @@ void CCalcEngine::ProcessCommandWorker(OpCode wParam)
                     m_HistoryCollector.AddOpndToHistory(m_numberString, m_currentVal); // Adding the repeated last op to history
                 }
 
-                // Do the current or last operation.
-                m_currentVal = DoOperation(m_nOpCode, m_currentVal, m_lastVal);
+                // Do the current or last operation, consuming the iterate
+                // the speculation worker precomputed when it still applies.
+                Rational specResult;
+                if (!m_bNoPrevEqu && TryConsumeEquSpeculation(m_nOpCode, m_currentVal, m_lastVal, specResult))
+                {
+                    m_currentVal = std::move(specResult);
+                }
+                else
+                {
+                    m_currentVal = DoOperation(m_nOpCode, m_currentVal, m_lastVal);
+                }
                 m_nPrevOpCode = m_nOpCode;
                 m_lastVal = m_currentVal;
 
@@ -529,6 +628,14 @@ void CCalcEngine::ProcessCommandWorker(OpCode wParam)
         m_bChangeOp = false;
         m_nPrevOpCode = 0;
 
+        // A further "=" would re-apply the armed operator to the same right
+        // operand; start that iterate on the speculation worker so a repeat
+        // press lands on a precomputed result. Any other input discards it.
+        if (!m_bError && !m_bNoPrevEqu && IsBinOpCode(m_nOpCode))
+        {
+            StartEquSpeculation();
+        }
+
         break;
 
     case IDC_OPENP:
@@ -1024,7 +1131,11 @@ wstring CCalcEngine::GetCurrentResultForRadix(uint32_t radix, int32_t precision)
 
     ChangeConstants(m_radix, precision);
 
+    // This conversion runs under the caller's precision; keep the per-radix
+    // string cache, which is keyed on the engine's own precision, out of it.
+    m_radixStringCacheMask = 0;
     wstring numberString = GetStringForDisplay(rat, radix);
+    m_radixStringCacheMask = 0;
     if (!numberString.empty())
     {
         // Revert the precision to previously stored precision
@@ -1034,8 +1145,126 @@ wstring CCalcEngine::GetCurrentResultForRadix(uint32_t radix, int32_t precision)
     return GroupDigitsPerRadix(numberString, radix);
 }
 
+// Builds the digit string for a power-of-two radix directly from the raw
+// bits, most significant digit first.
+static wstring StringFromBits(uint64_t bits, uint32_t bitsPerDigit)
+{
+    static constexpr wchar_t digits[] = L"0123456789ABCDEF";
+    wstring result;
+    do
+    {
+        result.insert(result.begin(), digits[bits & ((1ULL << bitsPerDigit) - 1)]);
+        bits >>= bitsPerDigit;
+    } while (bits != 0);
+
+    return result;
+}
+
+CCalcEngine::RadixDisplays CCalcEngine::GetAllRadixDisplays(int32_t precision)
+{
+    RadixDisplays displays;
+    Rational rat = (m_bRecord ? m_input.ToRational(m_radix, m_precision) : m_currentVal);
+
+    ChangeConstants(m_radix, precision);
+
+    if (m_fIntegerMode)
+    {
+        auto tempRat = TruncateNumForIntMath(rat);
+
+        try
+        {
+            uint64_t w64Bits = tempRat.ToUInt64_t();
+            bool fMsb = ((w64Bits >> (m_dwWordBitWidth - 1)) & 1);
+
+            // Bin, oct and hex are regroupings of the same bits.
+            displays.binString = StringFromBits(w64Bits, 1);
+            displays.octString = StringFromBits(w64Bits, 3);
+            displays.hexString = StringFromBits(w64Bits, 4);
+
+            // Decimal shows the signed two's complement value.
+            if (fMsb)
+            {
+                uint64_t magnitude = ~w64Bits + 1;
+                if (m_dwWordBitWidth < 64)
+                {
+                    magnitude &= ((1ULL << m_dwWordBitWidth) - 1);
+                }
+                displays.decString = L'-' + std::to_wstring(magnitude);
+            }
+            else
+            {
+                displays.decString = std::to_wstring(w64Bits);
+            }
+        }
+        catch (uint32_t)
+        {
+        }
+    }
+    else
+    {
+        // No shared integer form outside programmer mode; convert per radix
+        // from the one snapshot taken above. These run under the caller's
+        // precision, so keep the per-radix string cache out of them.
+        m_radixStringCacheMask = 0;
+        displays.hexString = GetStringForDisplay(rat, 16);
+        displays.decString = GetStringForDisplay(rat, 10);
+        displays.octString = GetStringForDisplay(rat, 8);
+        displays.binString = GetStringForDisplay(rat, 2);
+        m_radixStringCacheMask = 0;
+    }
+
+    // Revert the precision to previously stored precision
+    ChangeConstants(m_radix, m_precision);
+
+    displays.hexString = GroupDigitsPerRadix(displays.hexString, 16);
+    displays.decString = GroupDigitsPerRadix(displays.decString, 10);
+    displays.octString = GroupDigitsPerRadix(displays.octString, 8);
+    displays.binString = GroupDigitsPerRadix(displays.binString, 2);
+
+    return displays;
+}
+
 wstring CCalcEngine::GetStringForDisplay(Rational const& rat, uint32_t radix)
 {
+    // Slot in the per-radix string cache; the programmer radix toggles ask
+    // for the same unchanged value over and over, so serve repeats from the
+    // cache instead of re-running the ratpak conversion.
+    int slot = -1;
+    switch (radix)
+    {
+    case 16:
+        slot = 0;
+        break;
+    case 10:
+        slot = 1;
+        break;
+    case 8:
+        slot = 2;
+        break;
+    case 2:
+        slot = 3;
+        break;
+    }
+
+    if (slot >= 0)
+    {
+        if (m_radixStringCacheMask != 0 &&
+            m_radixStringCachePrecision == m_precision &&
+            m_radixStringCacheBitWidth == m_dwWordBitWidth &&
+            m_radixStringCacheFmt == m_nFE &&
+            m_radixStringCacheValue == rat)
+        {
+            if (m_radixStringCacheMask & (1u << slot))
+            {
+                return m_radixStringCache[slot];
+            }
+        }
+        else
+        {
+            m_radixStringCacheMask = 0;
+        }
+    }
+
     wstring result{};
     // Check for standard\scientific mode
     if (!m_fIntegerMode)
@@ -1065,5 +1294,113 @@ wstring CCalcEngine::GetStringForDisplay(Rational const& rat, uint32_t radix)
         }
     }
 
+    if (slot >= 0)
+    {
+        if (m_radixStringCacheMask == 0)
+        {
+            m_radixStringCacheValue = rat;
+            m_radixStringCachePrecision = m_precision;
+            m_radixStringCacheBitWidth = m_dwWordBitWidth;
+            m_radixStringCacheFmt = m_nFE;
+        }
+
+        m_radixStringCache[slot] = result;
+        m_radixStringCacheMask |= (1u << slot);
+    }
+
     return result;
 }
+
+// Captures the evaluator state for the manager's state snapshot. Returns
+// false while typed digits are pending or the engine is in error: those
+// states live in the input accumulator and the error string rather than
+// the value stacks, and the command journal restores them instead.
+// Recording with nothing typed yet (right after clear) has no pending
+// state, so it snapshots fine; bRecord carries the distinction across.
+bool CCalcEngine::TryGetSnapshot(_Out_ Snapshot& snapshot)
+{
+    if (m_bError || (m_bRecord && !m_input.IsEmpty()))
+    {
+        return false;
+    }
+
+    snapshot.nOpCode = m_nOpCode;
+    snapshot.nPrevOpCode = m_nPrevOpCode;
+    snapshot.bChangeOp = m_bChangeOp;
+    snapshot.bNoPrevEqu = m_bNoPrevEqu;
+    snapshot.bInv = m_bInv;
+    snapshot.bRecord = m_bRecord;
+    snapshot.nFE = static_cast<int>(m_nFE);
+    snapshot.nTempCom = m_nTempCom;
+    snapshot.nLastCom = m_nLastCom;
+    snapshot.openParenCount = m_openParenCount;
+    snapshot.nOp = m_nOp;
+    snapshot.parenVals = m_parenVals;
+    snapshot.precedenceOpCount = m_precedenceOpCount;
+    snapshot.nPrecOp = m_nPrecOp;
+    snapshot.precedenceVals = m_precedenceVals;
+    snapshot.lastVal = m_lastVal;
+    snapshot.currentVal = m_currentVal;
+    snapshot.holdVal = m_holdVal;
+    m_HistoryCollector.GetSnapshot(snapshot.historyCollector);
+
+    return true;
+}
+
+// Restores the state saved by TryGetSnapshot and refreshes the displays.
+// The input accumulator starts out clear, just as after the digits were
+// folded into m_currentVal.
+void CCalcEngine::ApplySnapshot(_In_ Snapshot const& snapshot)
+{
+    DiscardEquSpeculation();
+    m_nOpCode = snapshot.nOpCode;
+    m_nPrevOpCode = snapshot.nPrevOpCode;
+    m_bChangeOp = snapshot.bChangeOp;
+    m_bNoPrevEqu = snapshot.bNoPrevEqu;
+    m_bInv = snapshot.bInv;
+    m_nFE = static_cast<eNUMOBJ_FMT>(snapshot.nFE);
+    m_nTempCom = snapshot.nTempCom;
+    m_nLastCom = snapshot.nLastCom;
+    m_openParenCount = snapshot.openParenCount;
+    m_nOp = snapshot.nOp;
+    m_parenVals = snapshot.parenVals;
+    m_precedenceOpCount = snapshot.precedenceOpCount;
+    m_nPrecOp = snapshot.nPrecOp;
+    m_precedenceVals = snapshot.precedenceVals;
+    m_lastVal = snapshot.lastVal;
+    m_currentVal = snapshot.currentVal;
+    m_holdVal = snapshot.holdVal;
+    m_bError = false;
+    m_bRecord = snapshot.bRecord;
+    m_input.Clear();
+    m_HistoryCollector.ApplySnapshot(snapshot.historyCollector);
+
+    if (nullptr != m_pCalcDisplay)
+    {
+        m_pCalcDisplay->SetParenDisplayText(m_openParenCount ? to_wstring(m_openParenCount) : L"");
+    }
+    DisplayNum();
+}
+
+// Repaints the parenthesis count, the expression line and the number
+// display from the engine's retained state. The manager calls this when it
+// makes a parked mode engine current again: the display callback last saw
+// another engine's output, so every surface has to catch up, but nothing
+// in the evaluator changes.
+void CCalcEngine::RefreshDisplay()
+{
+    if (nullptr != m_pCalcDisplay)
+    {
+        m_pCalcDisplay->SetParenDisplayText(m_openParenCount ? to_wstring(m_openParenCount) : L"");
+    }
+    m_HistoryCollector.RepaintExpressionDisplay();
+
+    if (m_bError)
+    {
+        // Re-derives the message from the retained code and leaves the
+        // expression line as it was, matching the original presentation.
+        DisplayError(m_nLastError);
+        return;
+    }
+    DisplayNum();
+}
@@ -68,7 +68,9 @@ CalcEngine::Rational CCalcEngine::TruncateNumForIntMath(CalcEngine::Rational con
         result ^= m_chopNumbers[m_numwidth];
     }
 
-    result &= m_chopNumbers[m_numwidth];
+    // The chop values are all 2^width - 1, so enforce the word size by
+    // limb truncation instead of a full rational AND.
+    result.ChopToBitWidth(m_dwWordBitWidth);
 
     return result;
 }
@@ -119,7 +121,12 @@ void CCalcEngine::DisplayNum(void)
         // Displayed number can go through transformation. So copy it after transformation
         gldPrevious.value = m_currentVal;
 
-        if ((m_radix == 10) && IsNumberInvalid(m_numberString, MAX_EXPONENT, m_precision, m_radix))
+        // Standard modes keep the historical four-digit exponent ceiling; at
+        // the top of the extended-precision range a full-precision result can
+        // legitimately carry a five-digit exponent.
+        int maxExponent = (m_precision > 9999) ? MAX_EXPONENT + 1 : MAX_EXPONENT;
+
+        if ((m_radix == 10) && IsNumberInvalid(m_numberString, maxExponent, m_precision, m_radix))
         {
             DisplayError(CALC_E_OVERFLOW);
         }
@@ -253,18 +260,36 @@ wstring CCalcEngine::GroupDigitsPerRadix(wstring_view numberString, uint32_t rad
         return wstring{};
     }
 
+    // Commands that don't change the value still refresh the display, so the
+    // same string is regrouped over and over. Serve those from the last
+    // result; SettingsChanged invalidates it when separators change.
+    if (radix == m_groupedCacheRadix && numberString == m_groupedCacheInput)
+    {
+        return m_groupedCacheResult;
+    }
+
+    wstring result;
     switch (radix)
     {
     case 10:
-        return GroupDigits(wstring{ m_groupSeparator }, m_decGrouping, numberString, (L'-' == numberString[0]));
+        result = GroupDigits(wstring{ m_groupSeparator }, m_decGrouping, numberString, (L'-' == numberString[0]));
+        break;
     case 8:
-        return GroupDigits(L" ", { 3, 0 }, numberString);
+        result = GroupDigits(L" ", { 3, 0 }, numberString);
+        break;
     case 2:
     case 16:
-        return GroupDigits(L" ", { 4, 0 }, numberString);
+        result = GroupDigits(L" ", { 4, 0 }, numberString);
+        break;
     default:
         return wstring{ numberString };
     }
+
+    m_groupedCacheInput = numberString;
+    m_groupedCacheResult = result;
+    m_groupedCacheRadix = radix;
+
+    return result;
 }
 
 /****************************************************************************\
@@ -302,87 +327,69 @@ wstring CCalcEngine::GroupDigits(wstring_view delimiter, vector<uint32_t> const&
     size_t dec = displayString.find(m_decimalSeparator);
     bool hasDecimal = (dec != wstring_view::npos);
 
-    // Create an iterator that points to the end of the portion of the number subject to grouping (i.e. left of the decimal)
-    auto ritr = displayString.rend();
-    if (hasDecimal)
-    {
-        ritr -= dec;
-    }
-    else if (hasExponent)
-    {
-        ritr -= exp;
-    }
-    else
-    {
-        ritr = displayString.rbegin();
-    }
+    // The portion of the number subject to grouping (i.e. left of the decimal),
+    // excluding the sign because we don't want to end up with e.g. "-,123,456"
+    size_t groupEnd = hasDecimal ? dec : (hasExponent ? exp : displayString.size());
+    size_t groupStart = isNumNegative ? 1 : 0;
+    size_t digitCount = groupEnd - groupStart;
 
-    wstringstream groupedStream{};
-    uint32_t groupingSize = 0;
+    // Walk the grouping pattern once to mark where separators fall, counted
+    // in digits from the right of the grouped region.
+    vector<uint32_t> boundaries;
+    uint32_t distanceFromRight = 0;
 
     auto groupItr = grouping.begin();
     auto currGrouping = *groupItr;
-    // Mark the 'end' of the string as either rend() or rend()-1 if there is a negative sign
-    // We exclude the sign here because we don't want to end up with e.g. "-,123,456"
-    // Then, iterate from back to front, adding group delimiters as needed.
-    auto reverse_end = displayString.rend() - (isNumNegative ? 1 : 0);
-    while (ritr != reverse_end)
+    while (currGrouping != 0 && distanceFromRight + currGrouping < digitCount)
     {
-        groupedStream << *ritr++;
-        groupingSize++;
-
-        // If a group is complete, add a separator
-        // Do not add a separator if:
-        // - grouping size is 0
-        // - we are at the end of the digit string
-        if (currGrouping != 0 && (groupingSize % currGrouping) == 0 && ritr != reverse_end)
-        {
-            groupedStream << wstring{ delimiter };
-            groupingSize = 0; // reset for a new group
+        distanceFromRight += currGrouping;
+        boundaries.push_back(distanceFromRight);
 
-            // Shift the grouping to next values if they exist
-            if (groupItr != grouping.end())
+        // Shift the grouping to next values if they exist
+        if (groupItr != grouping.end())
+        {
+            ++groupItr;
+
+            // Loop through grouping vector until we find a non-zero value.
+            // "0" values may appear in a form of either e.g. "3;0" or "3;0;0".
+            // A 0 in the last position means repeat the previous grouping.
+            // A 0 in another position is a group. So, "3;0;0" means "group 3, then group 0 repeatedly"
+            // This could be expressed as just "3" but GetLocaleInfo is returning 3;0;0 in some cases instead.
+            for (currGrouping = 0; groupItr != grouping.end(); ++groupItr)
             {
-                ++groupItr;
-
-                // Loop through grouping vector until we find a non-zero value.
-                // "0" values may appear in a form of either e.g. "3;0" or "3;0;0".
-                // A 0 in the last position means repeat the previous grouping.
-                // A 0 in another position is a group. So, "3;0;0" means "group 3, then group 0 repeatedly"
-                // This could be expressed as just "3" but GetLocaleInfo is returning 3;0;0 in some cases instead.
-                for (currGrouping = 0; groupItr != grouping.end(); ++groupItr)
+                // If it's a non-zero value, that's our new group
+                if (*groupItr != 0)
                 {
-                    // If it's a non-zero value, that's our new group
-                    if (*groupItr != 0)
-                    {
-                        currGrouping = *groupItr;
-                        break;
-                    }
-
-                    // Otherwise, save the previous grouping in case we need to repeat it
-                    currGrouping = *(groupItr - 1);
+                    currGrouping = *groupItr;
+                    break;
                 }
+
+                // Otherwise, save the previous grouping in case we need to repeat it
+                currGrouping = *(groupItr - 1);
             }
         }
     }
 
-    // now copy the negative sign if it is there
-    if (isNumNegative)
+    // Now build the final string left to right in one reserved write.
+    wstring result;
+    result.reserve(displayString.size() + boundaries.size() * delimiter.size());
+    result.append(displayString.substr(0, groupStart));
+
+    size_t nextBoundary = boundaries.size();
+    for (size_t i = groupStart; i < groupEnd; i++)
     {
-        groupedStream << displayString[0];
+        result += displayString[i];
+
+        auto remainingDigits = static_cast<uint32_t>(groupEnd - i - 1);
+        if (nextBoundary != 0 && boundaries[nextBoundary - 1] == remainingDigits)
+        {
+            result += delimiter;
+            nextBoundary--;
+        }
     }
 
-    auto groupedString = groupedStream.str();
-    wstring result(groupedString.rbegin(), groupedString.rend());
     // Add the right (fractional or exponential) part of the number to the final string.
-    if (hasDecimal)
-    {
-        result += displayString.substr(dec);
-    }
-    else if (hasExponent)
-    {
-        result += displayString.substr(exp);
-    }
+    result.append(displayString.substr(groupEnd));
 
     return result;
 }
@@ -195,11 +195,13 @@ CalcEngine::Rational CCalcEngine::SciCalcFunctions(CalcEngine::Rational const& r
                 //
 
                 shftRat = m_bInv ? 60 : 100;
-                secondRat /= shftRat;
+                Rational invShftRat = Invert(shftRat);
 
-                minuteRat = (minuteRat + secondRat) / shftRat;
+                // Fold the seconds into the minutes and the minutes into the
+                // degrees, each as one fused multiply-add.
+                minuteRat = MulAdd(secondRat, invShftRat, minuteRat);
 
-                result = degreeRat + minuteRat;
+                result = MulAdd(minuteRat, invShftRat, degreeRat);
             }
             break;
         }
@@ -207,7 +209,12 @@ CalcEngine::Rational CCalcEngine::SciCalcFunctions(CalcEngine::Rational const& r
     }
     catch (uint32_t nErrCode)
     {
-        DisplayError(nErrCode);
+        // A cancelled computation is not an error: keep the operand and
+        // stay out of the error state so the next command runs normally.
+        if (nErrCode != CALC_E_CANCELLED)
+        {
+            DisplayError(nErrCode);
+        }
         result = rat;
     }
 
@@ -224,6 +231,7 @@ void CCalcEngine::DisplayError(uint32_t nError)
     SetPrimaryDisplay(errorString, true /*isError*/);
 
     m_bError = true; /* Set error flag.  Only cleared with CLEAR or CENTR. */
+    m_nLastError = nError; /* Kept so RefreshDisplay can repaint the message. */
 
     m_HistoryCollector.ClearHistoryLine(errorString);
 }
@@ -8,138 +8,408 @@ using namespace CalcEngine;
 using namespace CalcEngine::RationalMath;
 
 // Routines to perform standard operations &|^~<<>>+-/*% and pwr.
-CalcEngine::Rational CCalcEngine::DoOperation(int operation, CalcEngine::Rational const& lhs, CalcEngine::Rational const& rhs)
+// The handlers take the zero-normalized left operand and the right operand
+// and return the operation result; DoOperation dispatches to them through a
+// table indexed by command code.
+
+CalcEngine::Rational CCalcEngine::DoOperationAnd(CalcEngine::Rational const& lhs, CalcEngine::Rational const& rhs)
 {
-    // Remove any variance in how 0 could be represented in rat e.g. -0, 0/n, etc.
-    auto result = (lhs != 0 ? lhs : 0);
+    return lhs & rhs;
+}
 
-    try
+CalcEngine::Rational CCalcEngine::DoOperationOr(CalcEngine::Rational const& lhs, CalcEngine::Rational const& rhs)
+{
+    return lhs | rhs;
+}
+
+CalcEngine::Rational CCalcEngine::DoOperationXor(CalcEngine::Rational const& lhs, CalcEngine::Rational const& rhs)
+{
+    return lhs ^ rhs;
+}
+
+CalcEngine::Rational CCalcEngine::DoOperationRshf(CalcEngine::Rational const& lhs, CalcEngine::Rational const& rhs)
+{
+    if (m_fIntegerMode && lhs >= m_dwWordBitWidth) // Lsh/Rsh >= than current word size is always 0
     {
-        switch (operation)
-        {
-        case IDC_AND:
-            result &= rhs;
-            break;
+        throw CALC_E_NORESULT;
+    }
 
-        case IDC_OR:
-            result |= rhs;
-            break;
+    uint64_t w64Bits = rhs.ToUInt64_t();
+    bool fMsb = (w64Bits >> (m_dwWordBitWidth - 1)) & 1;
 
-        case IDC_XOR:
-            result ^= rhs;
-            break;
+    Rational result = rhs >> lhs;
 
-        case IDC_RSHF:
-        {
-            if (m_fIntegerMode && result >= m_dwWordBitWidth) // Lsh/Rsh >= than current word size is always 0
-            {
-                throw CALC_E_NORESULT;
-            }
+    if (fMsb)
+    {
+        result = Integer(result);
 
-            uint64_t w64Bits = rhs.ToUInt64_t();
-            bool fMsb = (w64Bits >> (m_dwWordBitWidth - 1)) & 1;
+        auto tempRat = m_chopNumbers[m_numwidth] >> lhs;
+        tempRat = Integer(tempRat);
 
-            Rational holdVal = result;
-            result = rhs >> holdVal;
+        result |= tempRat ^ m_chopNumbers[m_numwidth];
+    }
 
-            if (fMsb)
-            {
-                result = Integer(result);
+    return result;
+}
 
-                auto tempRat = m_chopNumbers[m_numwidth] >> holdVal;
-                tempRat = Integer(tempRat);
+CalcEngine::Rational CCalcEngine::DoOperationLshf(CalcEngine::Rational const& lhs, CalcEngine::Rational const& rhs)
+{
+    if (m_fIntegerMode && lhs >= m_dwWordBitWidth) // Lsh/Rsh >= than current word size is always 0
+    {
+        throw CALC_E_NORESULT;
+    }
 
-                result |= tempRat ^ m_chopNumbers[m_numwidth];
-            }
-            break;
-        }
+    return rhs << lhs;
+}
 
-        case IDC_LSHF:
-            if (m_fIntegerMode && result >= m_dwWordBitWidth) // Lsh/Rsh >= than current word size is always 0
-            {
-                throw CALC_E_NORESULT;
-            }
+CalcEngine::Rational CCalcEngine::DoOperationAdd(CalcEngine::Rational const& lhs, CalcEngine::Rational const& rhs)
+{
+    return lhs + rhs;
+}
 
-            result = rhs << result;
-            break;
+CalcEngine::Rational CCalcEngine::DoOperationSub(CalcEngine::Rational const& lhs, CalcEngine::Rational const& rhs)
+{
+    return rhs - lhs;
+}
 
-        case IDC_ADD:
-            result += rhs;
-            break;
+CalcEngine::Rational CCalcEngine::DoOperationMul(CalcEngine::Rational const& lhs, CalcEngine::Rational const& rhs)
+{
+    return lhs * rhs;
+}
 
-        case IDC_SUB:
-            result = rhs - result;
-            break;
+CalcEngine::Rational CCalcEngine::DoOperationDiv(CalcEngine::Rational const& lhs, CalcEngine::Rational const& rhs)
+{
+    return DoOperationDivMod(lhs, rhs, false /* fIsMod */);
+}
 
-        case IDC_MUL:
-            result *= rhs;
-            break;
+CalcEngine::Rational CCalcEngine::DoOperationMod(CalcEngine::Rational const& lhs, CalcEngine::Rational const& rhs)
+{
+    return DoOperationDivMod(lhs, rhs, true /* fIsMod */);
+}
 
-        case IDC_DIV:
-        case IDC_MOD:
+CalcEngine::Rational CCalcEngine::DoOperationDivMod(CalcEngine::Rational const& lhs, CalcEngine::Rational const& rhs, bool fIsMod)
+{
+    int iNumeratorSign = 1, iDenominatorSign = 1, iFinalSign = 1;
+    auto temp = lhs;
+    Rational result = rhs;
+
+    if (m_fIntegerMode)
+    {
+        uint64_t w64Bits = rhs.ToUInt64_t();
+        bool fMsb = (w64Bits >> (m_dwWordBitWidth - 1)) & 1;
+
+        if (fMsb)
         {
-            int iNumeratorSign = 1, iDenominatorSign = 1, iFinalSign = 1;
-            auto temp = result;
-            result = rhs;
+            result = (rhs ^ m_chopNumbers[m_numwidth]) + 1;
 
-            if (m_fIntegerMode)
-            {
-                uint64_t w64Bits = rhs.ToUInt64_t();
-                bool fMsb = (w64Bits >> (m_dwWordBitWidth - 1)) & 1;
+            iNumeratorSign = -1;
+        }
 
-                if (fMsb)
-                {
-                    result = (rhs ^ m_chopNumbers[m_numwidth]) + 1;
+        w64Bits = temp.ToUInt64_t();
+        fMsb = (w64Bits >> (m_dwWordBitWidth - 1)) & 1;
 
-                    iNumeratorSign = -1;
-                }
+        if (fMsb)
+        {
+            temp = (temp ^ m_chopNumbers[m_numwidth]) + 1;
 
-                w64Bits = temp.ToUInt64_t();
-                fMsb = (w64Bits >> (m_dwWordBitWidth - 1)) & 1;
+            iDenominatorSign = -1;
+        }
+    }
 
-                if (fMsb)
-                {
-                    temp = (temp ^ m_chopNumbers[m_numwidth]) + 1;
+    if (!fIsMod)
+    {
+        iFinalSign = iNumeratorSign * iDenominatorSign;
+        result /= temp;
+    }
+    else
+    {
+        iFinalSign = iNumeratorSign;
+        result %= temp;
+    }
 
-                    iDenominatorSign = -1;
-                }
-            }
+    if (m_fIntegerMode && iFinalSign == -1)
+    {
+        result = -(Integer(result));
+    }
 
-            if (operation == IDC_DIV)
-            {
-                iFinalSign = iNumeratorSign * iDenominatorSign;
-                result /= temp;
-            }
-            else
-            {
-                iFinalSign = iNumeratorSign;
-                result %= temp;
-            }
+    return result;
+}
 
-            if (m_fIntegerMode && iFinalSign == -1)
-            {
-                result = -(Integer(result));
-            }
+CalcEngine::Rational CCalcEngine::DoOperationPwr(CalcEngine::Rational const& lhs, CalcEngine::Rational const& rhs)
+{
+    // Calculates rhs to the lhs(th) power.
+    return Pow(rhs, lhs);
+}
 
-            break;
+CalcEngine::Rational CCalcEngine::DoOperationRoot(CalcEngine::Rational const& lhs, CalcEngine::Rational const& rhs)
+{
+    // Calculates rhs to the lhs(th) root.
+    return Root(rhs, lhs);
+}
+
+CalcEngine::Rational CCalcEngine::DoOperationRaw(int operation, CalcEngine::Rational const& lhs, CalcEngine::Rational const& rhs)
+{
+    using BinOpFunc = Rational (CCalcEngine::*)(Rational const& lhs, Rational const& rhs);
+
+    // The binary operators are a dense command range, so dispatch is a
+    // single indexed load instead of a branch chain.
+    static constexpr std::array<BinOpFunc, IDC_PWR - IDC_AND + 1> s_operationHandlers = {
+        &CCalcEngine::DoOperationAnd,  // IDC_AND
+        &CCalcEngine::DoOperationOr,   // IDC_OR
+        &CCalcEngine::DoOperationXor,  // IDC_XOR
+        &CCalcEngine::DoOperationLshf, // IDC_LSHF
+        &CCalcEngine::DoOperationRshf, // IDC_RSHF
+        &CCalcEngine::DoOperationDiv,  // IDC_DIV
+        &CCalcEngine::DoOperationMul,  // IDC_MUL
+        &CCalcEngine::DoOperationAdd,  // IDC_ADD
+        &CCalcEngine::DoOperationSub,  // IDC_SUB
+        &CCalcEngine::DoOperationMod,  // IDC_MOD
+        &CCalcEngine::DoOperationRoot, // IDC_ROOT
+        &CCalcEngine::DoOperationPwr,  // IDC_PWR
+    };
+
+    // Remove any variance in how 0 could be represented in rat e.g. -0, 0/n, etc.
+    auto result = (lhs != 0 ? lhs : 0);
+
+    if (operation < IDC_AND || operation > IDC_PWR)
+    {
+        return result;
+    }
+
+    return (this->*s_operationHandlers[operation - IDC_AND])(result, rhs);
+}
+
+// Detects the error conditions that are expected user inputs - divide or
+// mod by zero, shifts past the word size - with cheap operand tests before
+// the operation runs. Automation drives these thousands of times per run,
+// and answering them here keeps them off the thrown-error channel, which
+// stays reserved for the conditions only ratpak can discover (overflow deep
+// in a series, out of memory). Returns 0 when no expected error applies.
+uint32_t CCalcEngine::PrecheckOperationError(int operation, CalcEngine::Rational const& lhs, CalcEngine::Rational const& rhs)
+{
+    switch (operation)
+    {
+    case IDC_DIV:
+        // DoOperationDivMod divides rhs by the (zero-normalized) lhs.
+        if (lhs == 0)
+        {
+            return rhs == 0 ? CALC_E_INDEFINITE : CALC_E_DIVIDEBYZERO;
         }
+        break;
+    case IDC_MOD:
+        if (lhs == 0)
+        {
+            return CALC_E_INDEFINITE;
+        }
+        break;
+    case IDC_LSHF:
+    case IDC_RSHF:
+        if (m_fIntegerMode && lhs >= m_dwWordBitWidth)
+        {
+            return CALC_E_NORESULT;
+        }
+        break;
+    default:
+        break;
+    }
 
-        case IDC_PWR: // Calculates rhs to the result(th) power.
-            result = Pow(rhs, result);
-            break;
+    return 0;
+}
 
-        case IDC_ROOT: // Calculates rhs to the result(th) root.
-            result = Root(rhs, result);
-            break;
+CalcEngine::Rational CCalcEngine::DoOperation(int operation, CalcEngine::Rational const& lhs, CalcEngine::Rational const& rhs)
+{
+    try
+    {
+        uint32_t expectedError = PrecheckOperationError(operation, lhs, rhs);
+        if (expectedError != 0)
+        {
+            DisplayError(expectedError);
+            return lhs;
         }
+
+        return DoOperationRaw(operation, lhs, rhs);
     }
     catch (uint32_t dwErrCode)
     {
-        DisplayError(dwErrCode);
+        // Cancellation quietly keeps the left operand; real errors latch
+        // the error state and its display.
+        if (dwErrCode != CALC_E_CANCELLED)
+        {
+            DisplayError(dwErrCode);
+        }
 
         // On error, return the original value
-        result = lhs;
+        return lhs;
+    }
+}
+
+// Speculative precomputation of the repeat-equals iterate. After an "="
+// completes, the next press of "=" would compute
+// DoOperation(m_nOpCode, m_holdVal, m_lastVal); StartEquSpeculation hands a
+// copy of those inputs to the parked worker so the repeat press can consume
+// a finished result. The worker only reads engine state, and every command
+// other than "=" discards the speculation before the engine mutates
+// anything, so the two never run concurrently with a state change.
+
+void CCalcEngine::StartEquSpeculation()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_specMutex);
+        m_specCancel = false;
+        m_specOpCode = m_nOpCode;
+        m_specHoldVal = m_holdVal;
+        m_specLastVal = m_lastVal;
+        m_specError = 0;
+        m_specDone = false;
+        m_specPending = true;
     }
 
-    return result;
+    if (!m_specThread.joinable())
+    {
+        m_specThread = std::thread(&CCalcEngine::EquSpeculationThreadProc, this);
+    }
+
+    m_specWake.notify_one();
+}
+
+// Consumes the speculated iterate for DoOperation(operation, lhs, rhs).
+// Returns false when no speculation is live or its inputs no longer match,
+// in which case the caller computes inline as before. A speculated error is
+// replayed here, on the engine's own thread, so the display callbacks stay
+// single-threaded exactly as in DoOperation.
+bool CCalcEngine::TryConsumeEquSpeculation(int operation, CalcEngine::Rational const& lhs, CalcEngine::Rational const& rhs, _Out_ CalcEngine::Rational& result)
+{
+    if (!m_specThread.joinable())
+    {
+        return false;
+    }
+
+    std::unique_lock<std::mutex> lock(m_specMutex);
+    if (!m_specPending && !m_specDone)
+    {
+        return false;
+    }
+
+    bool matches = false;
+    try
+    {
+        matches = (operation == m_specOpCode && lhs == m_specHoldVal && rhs == m_specLastVal);
+    }
+    catch (uint32_t)
+    {
+        // A compare that cannot be carried out means the speculation cannot
+        // be trusted either.
+        matches = false;
+    }
+
+    if (!matches)
+    {
+        if (m_specPending)
+        {
+            m_specCancel = true; // unwinds the worker at its next checkpoint
+            m_specDoneWake.wait(lock, [this]() { return !m_specPending; });
+            m_specCancel = false;
+        }
+        m_specDone = false;
+        return false;
+    }
+
+    if (m_specPending)
+    {
+        // The iterate is still in flight; waiting out the remainder is
+        // never slower than starting the same computation over.
+        m_specDoneWake.wait(lock, [this]() { return !m_specPending; });
+    }
+
+    m_specDone = false;
+    if (m_specError != 0)
+    {
+        if (m_specError == CALC_E_CANCELLED)
+        {
+            return false;
+        }
+
+        lock.unlock();
+        DisplayError(m_specError);
+        result = lhs; // DoOperation keeps the original value on error
+        return true;
+    }
+
+    result = std::move(m_specResult);
+    return true;
+}
+
+// Retires any live speculation: cancels an in-flight iterate through the
+// ratpak checkpoints and forgets a finished one. Called before anything
+// the worker might read can change.
+void CCalcEngine::DiscardEquSpeculation()
+{
+    if (!m_specThread.joinable())
+    {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(m_specMutex);
+    if (m_specPending)
+    {
+        m_specCancel = true;
+        m_specDoneWake.wait(lock, [this]() { return !m_specPending; });
+        m_specCancel = false;
+    }
+    m_specDone = false;
+}
+
+// The parked worker behind repeat-equals speculation. Computes armed
+// iterates with this thread's ratpak constants and publishes the result --
+// or the raw error code the operation raised -- back under the lock.
+// DisplayError never runs here; the consume path replays errors on the
+// engine's thread.
+void CCalcEngine::EquSpeculationThreadProc()
+{
+    SetComputationHooks(&m_specCancel, nullptr, nullptr);
+
+    std::unique_lock<std::mutex> lock(m_specMutex);
+    for (;;)
+    {
+        m_specWake.wait(lock, [this]() { return m_specPending || m_specExit; });
+        if (m_specExit)
+        {
+            break;
+        }
+
+        int opCode = m_specOpCode;
+        Rational holdVal = m_specHoldVal;
+        Rational lastVal = m_specLastVal;
+        lock.unlock();
+
+        Rational result;
+        uint32_t errorCode = 0;
+        try
+        {
+            // The ratpak constants are thread_local; re-derive them here in
+            // case the radix or precision changed since the last iterate.
+            BaseOrPrecisionChanged();
+            errorCode = PrecheckOperationError(opCode, holdVal, lastVal);
+            if (errorCode == 0)
+            {
+                result = DoOperationRaw(opCode, holdVal, lastVal);
+            }
+        }
+        catch (uint32_t dwErrCode)
+        {
+            errorCode = dwErrCode;
+        }
+
+        lock.lock();
+        m_specResult = std::move(result);
+        m_specError = errorCode;
+        m_specPending = false;
+        m_specDone = true;
+        m_specDoneWake.notify_one();
+    }
+    lock.unlock();
+
+    // This thread's constants and free lists die with it; release them so
+    // the join in the engine's destructor hands the memory back.
+    ReleaseRatpakThreadState();
 }
@@ -2,13 +2,76 @@
 // Licensed under the MIT License.
 
 #include "pch.h"
+#include <algorithm>
+#include <cwctype>
 #include "CalculatorHistory.h"
+#include "ExpressionCommand.h"
+#include "ExpressionCommandArena.h"
 
 using namespace std;
 using namespace CalculationManager;
 
+// Interns the token text in one buffer and records an
+// (offset, length, command index) triple per token.
+static void PackTokens(_In_ shared_ptr<CalculatorVector<pair<wstring, int>>> const &tokens, _Inout_ HISTORYITEMVECTOR &itemVector)
+{
+    itemVector.packedTokens.reserve(tokens->size() * 3);
+    for (auto const& token : *tokens)
+    {
+        itemVector.packedTokens.push_back(static_cast<int>(itemVector.tokenChars.size()));
+        itemVector.packedTokens.push_back(static_cast<int>(token.first.size()));
+        itemVector.packedTokens.push_back(token.second);
+        itemVector.tokenChars += token.first;
+    }
+}
+
+// Flattens one command list into tagged int records: the command type,
+// then its payload in the order the hydrator consumes it. Operand flags
+// (negative/decimal/scientific) share one int.
+void CalculatorHistory::PackCommands(_In_ shared_ptr<CalculatorVector<shared_ptr<IExpressionCommand>>> const &spCommands, _Inout_ vector<int>& packed)
+{
+    for (auto const& spCommand : *spCommands)
+    {
+        CommandType type = spCommand->GetCommandType();
+        packed.push_back(static_cast<int>(type));
+        switch (type)
+        {
+        case CommandType::OperandCommand:
+        {
+            auto opndCommand = static_cast<IOpndCommand *>(spCommand.get());
+            int flags = (opndCommand->IsNegative() ? 1 : 0)
+                | (opndCommand->IsDecimalPresent() ? 2 : 0)
+                | (opndCommand->IsSciFmt() ? 4 : 0);
+            packed.push_back(flags);
+
+            auto const& opndCommands = opndCommand->GetCommands();
+            packed.push_back(static_cast<int>(opndCommands->size()));
+            packed.insert(packed.end(), opndCommands->begin(), opndCommands->end());
+            break;
+        }
+        case CommandType::UnaryCommand:
+        {
+            auto const& unaryCommands = static_cast<IUnaryCommand *>(spCommand.get())->GetCommands();
+            packed.push_back(static_cast<int>(unaryCommands->size()));
+            packed.insert(packed.end(), unaryCommands->begin(), unaryCommands->end());
+            break;
+        }
+        case CommandType::BinaryCommand:
+            packed.push_back(static_cast<IBinaryCommand *>(spCommand.get())->GetCommand());
+            break;
+        case CommandType::Parentheses:
+            packed.push_back(static_cast<IParenthesisCommand *>(spCommand.get())->GetCommand());
+            break;
+        }
+    }
+}
+
 CalculatorHistory::CalculatorHistory(size_t maxSize) :
-    m_maxHistorySize(maxSize)
+    m_iStartIndex(0),
+    m_fLinearizedStale(false),
+    m_maxHistorySize(maxSize),
+    m_nextItemSeq(0),
+    m_cEvictedSinceRebuild(0)
 {}
 
 unsigned int CalculatorHistory::AddToHistory(_In_ shared_ptr<CalculatorVector <pair<wstring, int>>> const &tokens, _In_ shared_ptr<CalculatorVector<shared_ptr<IExpressionCommand>>> const &commands, _In_ wstring_view result)
@@ -16,30 +79,147 @@ unsigned int CalculatorHistory::AddToHistory(_In_ shared_ptr<CalculatorVector <p
     unsigned int addedIndex;
     wstring generatedExpression;
     shared_ptr<HISTORYITEM> spHistoryItem = make_shared<HISTORYITEM>();
+    HISTORYITEMVECTOR& itemVector = spHistoryItem->historyItemVector;
 
-    spHistoryItem->historyItemVector.spTokens = tokens;
-    spHistoryItem->historyItemVector.spCommands = commands;
+    // Keep only the packed image; the token and command vectors are
+    // rebuilt by HydrateItem if this item is ever recalled.
+    PackTokens(tokens, itemVector);
+    PackCommands(commands, itemVector.packedCommands);
 
     // to be changed when pszexp is back
     tokens->GetString(&generatedExpression);
     // Prefixing and suffixing the special Unicode markers to ensure that the expression
     // in the history doesn't get broken for RTL languages
-    spHistoryItem->historyItemVector.expression = L'\u202d' + generatedExpression + L'\u202c';
-    spHistoryItem->historyItemVector.result = wstring(result);
+    itemVector.expression = L'\u202d' + generatedExpression + L'\u202c';
+    itemVector.result = wstring(result);
     addedIndex = AddItem(spHistoryItem);
 
     return addedIndex;
 }
 
+void CalculatorHistory::PackItem(_In_ HISTORYITEMVECTOR &itemVector)
+{
+    // Inverse of HydrateItem, for items that arrived carrying only the
+    // hydrated vectors (e.g. restored by an older build).
+    if (!itemVector.packedTokens.empty() || !itemVector.packedCommands.empty()
+        || itemVector.spTokens == nullptr || itemVector.spCommands == nullptr)
+    {
+        return;
+    }
+
+    PackTokens(itemVector.spTokens, itemVector);
+    PackCommands(itemVector.spCommands, itemVector.packedCommands);
+}
+
+void CalculatorHistory::HydrateItem(_In_ HISTORYITEMVECTOR &itemVector)
+{
+    // Already hydrated, or built directly from the app's own deserializer.
+    if (itemVector.spTokens != nullptr && itemVector.spCommands != nullptr)
+    {
+        return;
+    }
+
+    auto spTokens = make_shared<CalculatorVector<pair<wstring, int>>>();
+    spTokens->Reserve(itemVector.packedTokens.size() / 3);
+    for (size_t i = 0; i + 2 < itemVector.packedTokens.size(); i += 3)
+    {
+        size_t ichStart = static_cast<size_t>(itemVector.packedTokens[i]);
+        size_t cch = static_cast<size_t>(itemVector.packedTokens[i + 1]);
+        spTokens->EmplaceBack(itemVector.tokenChars.substr(ichStart, cch), itemVector.packedTokens[i + 2]);
+    }
+
+    itemVector.spTokens = spTokens;
+    itemVector.spCommands = HydrateCommands(itemVector.packedCommands);
+}
+
+// Rebuilds a command vector from the tagged int records PackCommands
+// produced. The records are assumed structurally valid; external data is
+// checked before it gets here.
+shared_ptr<CalculatorVector<shared_ptr<IExpressionCommand>>> CalculatorHistory::HydrateCommands(_In_ vector<int> const& packedCommands)
+{
+    // One arena per hydrated item keeps the rebuilt nodes contiguous; the
+    // nodes themselves keep it alive after this returns.
+    CExpressionCommandArena arena;
+    auto spCommands = make_shared<CalculatorVector<shared_ptr<IExpressionCommand>>>();
+    size_t i = 0;
+    while (i < packedCommands.size())
+    {
+        CommandType type = static_cast<CommandType>(packedCommands[i++]);
+        switch (type)
+        {
+        case CommandType::OperandCommand:
+        {
+            int flags = packedCommands[i++];
+            size_t nOpndCommands = static_cast<size_t>(packedCommands[i++]);
+            auto opndCommands = arena.Make<CalculatorVector<int>>();
+            for (size_t j = 0; j < nOpndCommands; j++)
+            {
+                opndCommands->Append(packedCommands[i++]);
+            }
+            spCommands->Append(arena.Make<COpndCommand>(opndCommands, (flags & 1) != 0, (flags & 2) != 0, (flags & 4) != 0));
+            break;
+        }
+        case CommandType::UnaryCommand:
+        {
+            size_t nUnaryCommands = static_cast<size_t>(packedCommands[i++]);
+            if (nUnaryCommands == 2)
+            {
+                int command1 = packedCommands[i++];
+                int command2 = packedCommands[i++];
+                spCommands->Append(arena.Make<CUnaryCommand>(command1, command2));
+            }
+            else
+            {
+                spCommands->Append(arena.Make<CUnaryCommand>(packedCommands[i++]));
+            }
+            break;
+        }
+        case CommandType::BinaryCommand:
+            spCommands->Append(arena.Make<CBinaryCommand>(packedCommands[i++]));
+            break;
+        case CommandType::Parentheses:
+            spCommands->Append(arena.Make<CParentheses>(packedCommands[i++]));
+            break;
+        }
+    }
+
+    return spCommands;
+}
+
 
 unsigned int CalculatorHistory::AddItem(_In_ shared_ptr<HISTORYITEM> const &spHistoryItem)
 {
+    uint32_t seq = m_nextItemSeq++;
+    bool fEvicted = false;
+
     if (m_historyItems.size() >= m_maxHistorySize)
     {
-        m_historyItems.erase(m_historyItems.begin());
+        // The ring is full: drop the oldest item by overwriting its slot
+        // instead of shifting everything down.
+        m_historyItems[m_iStartIndex] = spHistoryItem;
+        m_itemSeqs[m_iStartIndex] = seq;
+        m_iStartIndex = (m_iStartIndex + 1) % m_maxHistorySize;
+        fEvicted = true;
+    }
+    else
+    {
+        m_historyItems.push_back(spHistoryItem);
+        m_itemSeqs.push_back(seq);
+    }
+
+    // An eviction leaves the dropped item's postings behind as tombstones;
+    // once a full ring of them has piled up, rebuild instead of indexing
+    // incrementally, which keeps the index within 2x the live items.
+    if (fEvicted && ++m_cEvictedSinceRebuild >= m_maxHistorySize)
+    {
+        RebuildIndex();
+    }
+    else
+    {
+        IndexItem(*spHistoryItem, seq);
     }
 
-    m_historyItems.push_back(spHistoryItem);
+    m_fLinearizedStale = true;
     unsigned int lastIndex = static_cast<unsigned>(m_historyItems.size() - 1);
     return lastIndex;
 }
@@ -51,19 +231,230 @@ bool CalculatorHistory::RemoveItem(_In_ unsigned int uIdx)
         return false;
     }
 
+    // Removal from the middle is a user action and rare, so unwind the ring
+    // into order, erase, and start over with a straight buffer.
+    vector<shared_ptr<HISTORYITEM>> const& linearized = GetHistory();
+    m_historyItems = linearized;
     m_historyItems.erase(m_historyItems.begin() + uIdx);
+
+    vector<uint32_t> linearSeqs;
+    linearSeqs.reserve(m_historyItems.size() + 1);
+    for (size_t i = 0; i < m_itemSeqs.size(); i++)
+    {
+        linearSeqs.push_back(m_itemSeqs[(m_iStartIndex + i) % m_itemSeqs.size()]);
+    }
+    linearSeqs.erase(linearSeqs.begin() + uIdx);
+    m_itemSeqs = move(linearSeqs);
+
+    m_iStartIndex = 0;
+    m_fLinearizedStale = true;
+    RebuildIndex();
     return true;
 }
 
+// Lowercases and strips the directional marks AddToHistory wraps around
+// expressions, so queries match what the user sees regardless of case.
+void CalculatorHistory::FoldForIndex(wstring_view text, _Inout_ wstring& folded)
+{
+    folded.clear();
+    folded.reserve(text.size());
+    for (wchar_t ch : text)
+    {
+        if (ch == L'\u202d' || ch == L'\u202c')
+        {
+            continue;
+        }
+        folded.push_back(towlower(ch));
+    }
+}
+
+// Packs each run of three adjacent characters into one key (three UTF-16
+// units fit in 48 bits), deduplicated so an item lands at most once in
+// each posting list.
+void CalculatorHistory::CollectTrigramKeys(wstring_view folded, _Inout_ vector<uint64_t>& keys)
+{
+    for (size_t i = 0; i + 2 < folded.size(); i++)
+    {
+        uint64_t key = (static_cast<uint64_t>(folded[i]) << 32)
+                     | (static_cast<uint64_t>(folded[i + 1]) << 16)
+                     | static_cast<uint64_t>(folded[i + 2]);
+        keys.push_back(key);
+    }
+
+    sort(keys.begin(), keys.end());
+    keys.erase(unique(keys.begin(), keys.end()), keys.end());
+}
+
+void CalculatorHistory::IndexItem(HISTORYITEM const& item, uint32_t seq)
+{
+    wstring folded;
+    vector<uint64_t> keys;
+
+    FoldForIndex(item.historyItemVector.expression, folded);
+    CollectTrigramKeys(folded, keys);
+
+    wstring foldedResult;
+    FoldForIndex(item.historyItemVector.result, foldedResult);
+    CollectTrigramKeys(foldedResult, keys); // re-sorts; trigrams shared by both strings collapse
+
+    for (uint64_t key : keys)
+    {
+        vector<uint32_t>& postings = m_trigramPostings[key];
+        // Sequence numbers only grow, so appending keeps each list sorted.
+        if (postings.empty() || postings.back() != seq)
+        {
+            postings.push_back(seq);
+        }
+    }
+}
+
+void CalculatorHistory::RebuildIndex()
+{
+    m_trigramPostings.clear();
+    m_cEvictedSinceRebuild = 0;
+
+    // Ring order is oldest to newest, so posting lists come out sorted.
+    for (size_t i = 0; i < m_historyItems.size(); i++)
+    {
+        size_t slot = (m_iStartIndex + i) % m_historyItems.size();
+        IndexItem(*m_historyItems[slot], m_itemSeqs[slot]);
+    }
+}
+
+// Returns the linear (oldest-to-newest, GetHistory-order) indices of the
+// items whose expression or result contains the query as a substring.
+// Queries of three characters or more intersect the trigram posting
+// lists and only then touch the candidates' strings; shorter queries
+// fall back to scanning, which the ring bounds.
+vector<unsigned int> CalculatorHistory::Search(wstring_view query)
+{
+    vector<unsigned int> matches;
+    size_t cItems = m_historyItems.size();
+    if (cItems == 0)
+    {
+        return matches;
+    }
+
+    wstring foldedQuery;
+    FoldForIndex(query, foldedQuery);
+    if (foldedQuery.empty())
+    {
+        return matches;
+    }
+
+    // Checks one item's strings for the folded query.
+    wstring foldedItem;
+    auto fItemMatches = [&](HISTORYITEM const& item) {
+        FoldForIndex(item.historyItemVector.expression, foldedItem);
+        if (foldedItem.find(foldedQuery) != wstring::npos)
+        {
+            return true;
+        }
+        FoldForIndex(item.historyItemVector.result, foldedItem);
+        return foldedItem.find(foldedQuery) != wstring::npos;
+    };
+
+    if (foldedQuery.size() < 3)
+    {
+        for (size_t i = 0; i < cItems; i++)
+        {
+            if (fItemMatches(*m_historyItems[(m_iStartIndex + i) % cItems]))
+            {
+                matches.push_back(static_cast<unsigned int>(i));
+            }
+        }
+        return matches;
+    }
+
+    // Candidates are the intersection of the query trigrams' posting
+    // lists; any trigram with no postings means no item can match.
+    vector<uint64_t> keys;
+    CollectTrigramKeys(foldedQuery, keys);
+
+    vector<uint32_t> candidates;
+    bool fFirstKey = true;
+    for (uint64_t key : keys)
+    {
+        auto itPostings = m_trigramPostings.find(key);
+        if (itPostings == m_trigramPostings.end())
+        {
+            return matches;
+        }
+
+        if (fFirstKey)
+        {
+            candidates = itPostings->second;
+            fFirstKey = false;
+            continue;
+        }
+
+        vector<uint32_t> narrowed;
+        narrowed.reserve(min(candidates.size(), itPostings->second.size()));
+        set_intersection(candidates.begin(), candidates.end(),
+                         itPostings->second.begin(), itPostings->second.end(),
+                         back_inserter(narrowed));
+        candidates = move(narrowed);
+        if (candidates.empty())
+        {
+            return matches;
+        }
+    }
+
+    // Map each surviving sequence number back to its linear index. Live
+    // sequence numbers ascend in ring order, so one binary search per
+    // candidate over the ring suffices; tombstoned numbers miss.
+    for (uint32_t seq : candidates)
+    {
+        size_t lo = 0;
+        size_t hi = cItems;
+        while (lo < hi)
+        {
+            size_t mid = lo + (hi - lo) / 2;
+            if (m_itemSeqs[(m_iStartIndex + mid) % cItems] < seq)
+            {
+                lo = mid + 1;
+            }
+            else
+            {
+                hi = mid;
+            }
+        }
+
+        if (lo < cItems && m_itemSeqs[(m_iStartIndex + lo) % cItems] == seq
+            && fItemMatches(*m_historyItems[(m_iStartIndex + lo) % cItems]))
+        {
+            matches.push_back(static_cast<unsigned int>(lo));
+        }
+    }
+
+    sort(matches.begin(), matches.end());
+    return matches;
+}
+
 vector<shared_ptr<HISTORYITEM>> const& CalculatorHistory::GetHistory()
 {
-    return m_historyItems;
+    if (m_fLinearizedStale)
+    {
+        m_linearizedItems.clear();
+        m_linearizedItems.reserve(m_historyItems.size());
+        for (size_t i = 0; i < m_historyItems.size(); i++)
+        {
+            m_linearizedItems.push_back(m_historyItems[(m_iStartIndex + i) % m_historyItems.size()]);
+        }
+        m_fLinearizedStale = false;
+    }
+
+    return m_linearizedItems;
 }
 
 shared_ptr<HISTORYITEM> const& CalculatorHistory::GetHistoryItem(_In_ unsigned int uIdx)
 {
     assert(uIdx >= 0 && uIdx < m_historyItems.size());
-    return m_historyItems.at(uIdx);
+    shared_ptr<HISTORYITEM> const& spHistoryItem = m_historyItems.at((m_iStartIndex + uIdx) % m_historyItems.size());
+
+    // Single-item access is the recall path, so hand back the full form.
+    HydrateItem(spHistoryItem->historyItemVector);
+    return spHistoryItem;
 }
 
 CalculatorHistory::~CalculatorHistory(void)
@@ -74,4 +465,10 @@ CalculatorHistory::~CalculatorHistory(void)
 void CalculatorHistory::ClearHistory()
 {
     m_historyItems.clear();
+    m_linearizedItems.clear();
+    m_iStartIndex = 0;
+    m_fLinearizedStale = false;
+    m_trigramPostings.clear();
+    m_itemSeqs.clear();
+    m_cEvictedSinceRebuild = 0;
 }
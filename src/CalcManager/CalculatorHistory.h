@@ -2,6 +2,9 @@
 // Licensed under the MIT License.
 
 #pragma once
+#include <cstdint>
+#include <unordered_map>
+
 #include "ExpressionCommandInterface.h"
 #include "Header Files/IHistoryDisplay.h"
 
@@ -15,10 +18,22 @@ namespace CalculationManager
 
     struct HISTORYITEMVECTOR
     {
+        // Hydrated forms; null for an item that has never been recalled.
         std::shared_ptr<CalculatorVector <std::pair<std::wstring, int>>> spTokens;
         std::shared_ptr<CalculatorVector<std::shared_ptr<IExpressionCommand>>> spCommands;
         std::wstring    expression;
         std::wstring    result;
+
+        // Packed image of the same tokens and commands: token text interned
+        // in one buffer with (offset, length, command index) triples, and
+        // commands flattened into tagged int records. AddToHistory stores
+        // only this form; CalculatorHistory::HydrateItem rebuilds the
+        // vectors above when an item is actually recalled into the editor.
+        // Keeping the shared_ptr graphs out of untouched items is what makes
+        // a deep history affordable.
+        std::wstring     tokenChars;
+        std::vector<int> packedTokens;
+        std::vector<int> packedCommands;
     };
 
     struct HISTORYITEM
@@ -38,11 +53,39 @@ namespace CalculationManager
         void ClearHistory();
         unsigned int AddItem(_In_ std::shared_ptr<HISTORYITEM> const &spHistoryItem);
         bool RemoveItem(unsigned int uIdx);
+        static void HydrateItem(_In_ HISTORYITEMVECTOR &itemVector);
+        static void PackItem(_In_ HISTORYITEMVECTOR &itemVector);
+        static void PackCommands(_In_ std::shared_ptr<CalculatorVector<std::shared_ptr<IExpressionCommand>>> const &spCommands, _Inout_ std::vector<int>& packedCommands);
+        static std::shared_ptr<CalculatorVector<std::shared_ptr<IExpressionCommand>>> HydrateCommands(_In_ std::vector<int> const& packedCommands);
         const size_t MaxHistorySize() const { return m_maxHistorySize; }
+        std::vector<unsigned int> Search(std::wstring_view query);
         ~CalculatorHistory(void);
 
     private:
+        // Items live in a ring: m_iStartIndex is the slot holding the oldest
+        // item, and once the buffer is full an addition simply overwrites
+        // that slot, so append/evict stays O(1) regardless of capacity. The
+        // contiguous oldest-to-newest vector handed out by GetHistory is
+        // rebuilt from the ring only when it is requested after a change.
         std::vector<std::shared_ptr<HISTORYITEM>> m_historyItems;
+        size_t m_iStartIndex;
+        std::vector<std::shared_ptr<HISTORYITEM>> m_linearizedItems;
+        bool m_fLinearizedStale;
         const size_t m_maxHistorySize;
+
+        // Trigram index over item expressions and results, maintained
+        // incrementally as items are added so Search answers substring
+        // queries without scanning every stored string. Posting lists hold
+        // per-item sequence numbers in insertion order; entries for items
+        // the ring has since overwritten stay behind as tombstones and the
+        // whole index is rebuilt once a ring's worth of them accumulates.
+        std::unordered_map<uint64_t, std::vector<uint32_t>> m_trigramPostings;
+        std::vector<uint32_t> m_itemSeqs; // parallel to m_historyItems
+        uint32_t m_nextItemSeq;
+        size_t m_cEvictedSinceRebuild;
+        void IndexItem(HISTORYITEM const& item, uint32_t seq);
+        void RebuildIndex();
+        static void FoldForIndex(std::wstring_view text, _Inout_ std::wstring& folded);
+        static void CollectTrigramKeys(std::wstring_view folded, _Inout_ std::vector<uint64_t>& keys);
     };
 }
@@ -5,13 +5,30 @@
 #include "Header Files/CalcEngine.h"
 #include "CalculatorManager.h"
 #include "CalculatorResource.h"
+#include "HistoryJournal.h"
+#include "SharedHistoryStore.h"
 
 using namespace std;
 using namespace CalcEngine;
 
-static constexpr size_t MAX_HISTORY_ITEMS = 20;
+// Items are kept in packed form and only hydrated on recall, so a deep
+// history stays cheap; see CalculatorHistory.
+static constexpr size_t MAX_HISTORY_ITEMS = 1000;
 static constexpr size_t SERIALIZED_NUMBER_MINSIZE = 3;
 
+// Version of the state snapshot produced by SerializeStateSnapshot. A
+// reader seeing any other version falls back to the command journal.
+// Version 2 added the engine's bRecord flag.
+static constexpr long SERIALIZED_STATE_SNAPSHOT_VERSION = 2;
+
+// Once the command journal reaches this many entries it is folded into a
+// checkpoint snapshot, so journal memory and suspend payloads stay
+// bounded no matter how long an expression the user types.
+static constexpr size_t SAVED_COMMANDS_COMPACT_THRESHOLD = 256;
+
+// Version byte leading every byte stream produced by PackLongs.
+static constexpr unsigned char SERIALIZED_PACK_VERSION = 1;
+
 // Converts Memory Command enum value to unsigned char,
 // while ignoring Warning C4309: 'conversion' : truncation of constant value
 #define MEMORY_COMMAND_TO_UNSIGNED_CHAR(c)\
@@ -22,6 +39,46 @@ static constexpr size_t SERIALIZED_NUMBER_MINSIZE = 3;
 
 namespace CalculationManager
 {
+    namespace
+    {
+        // Provider handed to engines built ahead of any window. It answers
+        // every query with an empty string, which the engine treats as "use
+        // the default separators"; adoption re-reads the real settings.
+        class WarmEngineResourceProvider : public IResourceProvider
+        {
+        public:
+            std::wstring GetCEngineString(const std::wstring& /*id*/) override
+            {
+                return std::wstring{};
+            }
+        };
+
+        WarmEngineResourceProvider s_warmEngineResourceProvider;
+
+        // One pre-built engine per flavor, filled on a background thread so
+        // that a new window's first mode selection adopts a finished engine
+        // instead of paying construction and per-thread constant setup on
+        // the UI thread. The destructor joins a straggling fill so process
+        // teardown never races it.
+        struct WarmEnginePool
+        {
+            std::mutex poolMutex;
+            std::array<std::unique_ptr<CCalcEngine>, 3> engines;
+            std::thread filler;
+            std::atomic<bool> fillDone{ false };
+
+            ~WarmEnginePool()
+            {
+                if (filler.joinable())
+                {
+                    filler.join();
+                }
+            }
+        };
+
+        WarmEnginePool s_warmEnginePool;
+    }
+
     CalculatorManager::CalculatorManager(_In_ ICalcDisplay* displayCallback, _In_ IResourceProvider* resourceProvider) :
         m_displayCallback(displayCallback),
         m_currentCalculatorEngine(nullptr),
@@ -32,7 +89,20 @@ namespace CalculationManager
         m_currentDegreeMode(Command::CommandNULL),
         m_savedDegreeMode(Command::CommandDEG),
         m_pStdHistory(new CalculatorHistory(MAX_HISTORY_ITEMS)),
-        m_pSciHistory(new CalculatorHistory(MAX_HISTORY_ITEMS))
+        m_pSciHistory(new CalculatorHistory(MAX_HISTORY_ITEMS)),
+        m_batchedCommandMode(false),
+        m_batchedPrimaryPending(false),
+        m_batchedPrimaryIsError(false),
+        m_batchedExpressionPending(false),
+        m_batchedParenPending(false),
+        m_batchedErrorPending(false),
+        m_batchedIsInError(false),
+        m_engineThreadActive(false),
+        m_commandsQueued(0),
+        m_commandsExecuted(0),
+        m_computationCancelled(false),
+        m_memoCacheUseCounter(0),
+        m_engineTrimRequested(false)
     {
         CCalcEngine::InitialOneTimeOnlySetup(*m_resourceProvider);
     }
@@ -43,6 +113,12 @@ namespace CalculationManager
     /// </summary>
     CalculatorManager::~CalculatorManager()
     {
+        this->SetBackgroundExecution(false);
+        // The ratpak hooks armed by SendCommandWorker point into this
+        // object; disarm them so series work on this thread after we are
+        // gone does not poll a dead flag. The engine thread's copies died
+        // with the thread above.
+        SetComputationHooks(nullptr, nullptr, nullptr);
         this->MemorizedNumberClearAll();
     }
 
@@ -53,6 +129,14 @@ namespace CalculationManager
     /// <param name="text">wstring representing text to be displayed</param>
     void CalculatorManager::SetPrimaryDisplay(_In_ const wstring& displayString, _In_ bool isError)
     {
+        if (m_batchedCommandMode)
+        {
+            m_batchedPrimaryDisplay = displayString;
+            m_batchedPrimaryIsError = isError;
+            m_batchedPrimaryPending = true;
+            return;
+        }
+
         if (!m_inHistoryItemLoadMode)
         {
             m_displayCallback->SetPrimaryDisplay(displayString, isError);
@@ -61,6 +145,13 @@ namespace CalculationManager
 
     void CalculatorManager::SetIsInError(bool isError)
     {
+        if (m_batchedCommandMode)
+        {
+            m_batchedIsInError = isError;
+            m_batchedErrorPending = true;
+            return;
+        }
+
         m_displayCallback->SetIsInError(isError);
     }
 
@@ -91,6 +182,16 @@ namespace CalculationManager
     /// <param name="expressionString">wstring representing expression to be displayed</param>
     void CalculatorManager::SetExpressionDisplay(_Inout_ shared_ptr<CalculatorVector<pair<wstring, int>>> const &tokens, _Inout_ shared_ptr<CalculatorVector<shared_ptr<IExpressionCommand>>> const &commands)
     {
+        if (m_batchedCommandMode)
+        {
+            // Copy the vectors: the engine keeps mutating them as the batch
+            // continues, and the flush must deliver what this callback saw.
+            m_batchedExpressionTokens = make_shared<CalculatorVector<pair<wstring, int>>>(*tokens);
+            m_batchedExpressionCommands = make_shared<CalculatorVector<shared_ptr<IExpressionCommand>>>(*commands);
+            m_batchedExpressionPending = true;
+            return;
+        }
+
         if (!m_inHistoryItemLoadMode)
         {
             m_displayCallback->SetExpressionDisplay(tokens, commands);
@@ -113,6 +214,13 @@ namespace CalculationManager
     /// <param name="parenthesisCount">string containing the parenthesis count</param>
     void CalculatorManager::SetParenDisplayText(const wstring& parenthesisCount)
     {
+        if (m_batchedCommandMode)
+        {
+            m_batchedParenText = parenthesisCount;
+            m_batchedParenPending = true;
+            return;
+        }
+
         m_displayCallback->SetParenDisplayText(parenthesisCount);
     }
 
@@ -133,9 +241,15 @@ namespace CalculationManager
     /// </summary>
     void CalculatorManager::Reset(bool clearMemory /* = true*/)
     {
+        this->SyncWithEngineThread();
         m_savedCommands.clear();
+        m_checkpointSnapshot.clear();
         SetStandardMode();
 
+        // Mode engines retain their state across switches, but not across
+        // a reset; clear each one that exists.
+        m_standardCalculatorEngine->ProcessCommand(IDC_CLEAR);
+
         if (m_scientificCalculatorEngine)
         {
             m_scientificCalculatorEngine->ProcessCommand(IDC_DEG);
@@ -149,75 +263,283 @@ namespace CalculationManager
         }
         if (m_programmerCalculatorEngine)
         {
+            m_programmerCalculatorEngine->ProcessCommand(IDC_DEC);
             m_programmerCalculatorEngine->ProcessCommand(IDC_CLEAR);
         }
 
+        // The clears above may have re-derived this thread's ratpak
+        // constants for a non-current engine; put them back in step with
+        // the active one.
+        m_currentCalculatorEngine->BaseOrPrecisionChanged();
+
         if (clearMemory)
         {
             this->MemorizedNumberClearAll();
         }
     }
 
+    /// <summary>
+    /// Build one engine of each flavor on a background thread and park them
+    /// for the next manager (window) to adopt, so its first mode selection
+    /// does no cold-start work on the UI thread. Safe to call repeatedly: a
+    /// fill already in flight, or a full pool, makes this a no-op.
+    /// </summary>
+    void CalculatorManager::PrewarmEngines()
+    {
+        lock_guard<mutex> lock(s_warmEnginePool.poolMutex);
+        if (s_warmEnginePool.filler.joinable())
+        {
+            if (!s_warmEnginePool.fillDone.load(memory_order_acquire))
+            {
+                return;
+            }
+            s_warmEnginePool.filler.join();
+        }
+
+        bool anySlotEmpty = false;
+        for (auto const& engine : s_warmEnginePool.engines)
+        {
+            anySlotEmpty = anySlotEmpty || engine == nullptr;
+        }
+        if (!anySlotEmpty)
+        {
+            return;
+        }
+
+        s_warmEnginePool.fillDone.store(false, memory_order_release);
+        s_warmEnginePool.filler = thread([]() {
+            // The ratpak constants are thread_local; set up this thread's
+            // before constructing engines on it. The string table is not
+            // needed during construction, so warming works even before the
+            // first manager has loaded it.
+            CCalcEngine::InitialPerThreadSetup();
+            for (size_t flavor = 0; flavor < s_warmEnginePool.engines.size(); flavor++)
+            {
+                bool slotEmpty;
+                {
+                    lock_guard<mutex> poolLock(s_warmEnginePool.poolMutex);
+                    slotEmpty = s_warmEnginePool.engines[flavor] == nullptr;
+                }
+                if (!slotEmpty)
+                {
+                    continue;
+                }
+
+                bool fPrecedence = flavor != static_cast<size_t>(WarmEngineFlavor::Standard);
+                bool fIntegerMode = flavor == static_cast<size_t>(WarmEngineFlavor::Programmer);
+                auto engine = make_unique<CCalcEngine>(fPrecedence, fIntegerMode, &s_warmEngineResourceProvider, nullptr, nullptr);
+
+                lock_guard<mutex> poolLock(s_warmEnginePool.poolMutex);
+                s_warmEnginePool.engines[flavor] = move(engine);
+            }
+            // The filler exits after the refill; its thread_local constants
+            // would otherwise leak once per refill. The parked engines own
+            // their numbers outright, so they are unaffected.
+            ReleaseRatpakThreadState();
+            s_warmEnginePool.fillDone.store(true, memory_order_release);
+        });
+    }
+
+    /// <summary>
+    /// Drop the pre-built engines parked in the warm pool. The pool only
+    /// exists to make the next window open fast, so under memory pressure
+    /// it is pure resident set; a later CreateEngine miss just builds
+    /// inline and restarts the background refill. A fill still in flight
+    /// keeps running - the slots it has already filled are cleared here
+    /// and the rest will be cleared by the next trim.
+    /// </summary>
+    void CalculatorManager::TrimWarmEnginePool()
+    {
+        lock_guard<mutex> lock(s_warmEnginePool.poolMutex);
+        if (s_warmEnginePool.filler.joinable() && s_warmEnginePool.fillDone.load(memory_order_acquire))
+        {
+            s_warmEnginePool.filler.join();
+        }
+        for (auto& engine : s_warmEnginePool.engines)
+        {
+            engine.reset();
+        }
+    }
+
+    /// <summary>
+    /// Hand the mode setters their engine: the warm pre-built one when the
+    /// pool has this flavor, rebound to this manager's provider and
+    /// displays, otherwise one built inline as before. A successful take
+    /// starts a background refill so the next window finds the pool warm
+    /// again.
+    /// </summary>
+    unique_ptr<CCalcEngine> CalculatorManager::CreateEngine(_In_ WarmEngineFlavor flavor, _In_ shared_ptr<IHistoryDisplay> const& pHistoryDisplay)
+    {
+        unique_ptr<CCalcEngine> engine;
+        {
+            lock_guard<mutex> lock(s_warmEnginePool.poolMutex);
+            engine = move(s_warmEnginePool.engines[static_cast<size_t>(flavor)]);
+        }
+
+        if (engine)
+        {
+            engine->AdoptCallbacks(m_resourceProvider, this, pHistoryDisplay);
+            PrewarmEngines();
+            return engine;
+        }
+
+        bool fPrecedence = flavor != WarmEngineFlavor::Standard; /* Respect Order of Operations */
+        bool fIntegerMode = flavor == WarmEngineFlavor::Programmer; /* Set to Integer Mode */
+        return make_unique<CCalcEngine>(fPrecedence, fIntegerMode, m_resourceProvider, this, pHistoryDisplay);
+    }
+
+    /// <summary>
+    /// Make a parked mode engine current again without disturbing the
+    /// state it retained: re-derive this thread's ratpak constants and
+    /// the Rational layer precision for its settings, then repaint the
+    /// displays from it. Each mode engine is initialized only on first
+    /// use, so a mode switch is this activation and nothing else.
+    /// </summary>
+    /// <param name="engine">Engine to make current</param>
+    void CalculatorManager::ActivateEngine(_In_ CCalcEngine* engine)
+    {
+        m_currentCalculatorEngine = engine;
+        CalcEngine::SetRationalPrecision(engine->GetPrecision());
+        engine->BaseOrPrecisionChanged();
+        engine->RefreshDisplay();
+    }
+
     /// <summary>
     /// Change the current calculator engine to standard calculator engine.
+    /// The engine is created and initialized on first use only; after that
+    /// a switch just reactivates it, so the value, expression and
+    /// parenthesis state it held survive a round trip through another mode.
     /// </summary>
     void CalculatorManager::SetStandardMode()
     {
+        this->SyncWithEngineThread();
         if (!m_standardCalculatorEngine)
         {
-            m_standardCalculatorEngine = make_unique<CCalcEngine>(false /* Respect Order of Operations */, false /* Set to Integer Mode */, m_resourceProvider, this, m_pStdHistory);
+            m_standardCalculatorEngine = CreateEngine(WarmEngineFlavor::Standard, m_pStdHistory);
+            m_currentCalculatorEngine = m_standardCalculatorEngine.get();
+            m_currentCalculatorEngine->ProcessCommand(IDC_DEC);
+            m_currentCalculatorEngine->ProcessCommand(IDC_CLEAR);
+            m_currentCalculatorEngine->ChangePrecision(static_cast<int>(CalculatorPrecision::StandardModePrecision));
+            UpdateMaxIntDigits();
+        }
+        else
+        {
+            this->ActivateEngine(m_standardCalculatorEngine.get());
         }
-
-        m_currentCalculatorEngine = m_standardCalculatorEngine.get();
-        m_currentCalculatorEngine->ProcessCommand(IDC_DEC);
-        m_currentCalculatorEngine->ProcessCommand(IDC_CLEAR);
-        m_currentCalculatorEngine->ChangePrecision(static_cast<int>(CalculatorPrecision::StandardModePrecision));
-        UpdateMaxIntDigits();
         m_pHistory = m_pStdHistory.get();
     }
 
     /// <summary>
     /// Change the current calculator engine to scientific calculator engine.
+    /// Initialized on first use only; later switches reactivate the engine
+    /// with its retained state intact.
     /// </summary>
     void CalculatorManager::SetScientificMode()
     {
+        this->SyncWithEngineThread();
         if (!m_scientificCalculatorEngine)
         {
-            m_scientificCalculatorEngine = make_unique<CCalcEngine>(true /* Respect Order of Operations */, false /* Set to Integer Mode */, m_resourceProvider, this, m_pSciHistory);
+            m_scientificCalculatorEngine = CreateEngine(WarmEngineFlavor::Scientific, m_pSciHistory);
+            m_currentCalculatorEngine = m_scientificCalculatorEngine.get();
+            m_currentCalculatorEngine->ProcessCommand(IDC_DEC);
+            m_currentCalculatorEngine->ProcessCommand(IDC_CLEAR);
+            m_currentCalculatorEngine->ChangePrecision(static_cast<int>(CalculatorPrecision::ScientificModePrecision));
+        }
+        else
+        {
+            this->ActivateEngine(m_scientificCalculatorEngine.get());
         }
-
-        m_currentCalculatorEngine = m_scientificCalculatorEngine.get();
-        m_currentCalculatorEngine->ProcessCommand(IDC_DEC);
-        m_currentCalculatorEngine->ProcessCommand(IDC_CLEAR);
-        m_currentCalculatorEngine->ChangePrecision(static_cast<int>(CalculatorPrecision::ScientificModePrecision));
         m_pHistory = m_pSciHistory.get();
     }
 
     /// <summary>
-    /// Change the current calculator engine to scientific calculator engine.
+    /// Change the current calculator engine to programmer calculator engine.
+    /// Initialized on first use only; later switches reactivate the engine
+    /// with its retained state - including its radix and word size - intact.
     /// </summary>
     void CalculatorManager::SetProgrammerMode()
     {
+        this->SyncWithEngineThread();
         if(!m_programmerCalculatorEngine)
         {
-            m_programmerCalculatorEngine = make_unique<CCalcEngine>(true /* Respect Order of Operations */, true /* Set to Integer Mode */, m_resourceProvider, this, nullptr);
+            m_programmerCalculatorEngine = CreateEngine(WarmEngineFlavor::Programmer, nullptr);
+            m_currentCalculatorEngine = m_programmerCalculatorEngine.get();
+            m_currentCalculatorEngine->ProcessCommand(IDC_DEC);
+            m_currentCalculatorEngine->ProcessCommand(IDC_CLEAR);
+            m_currentCalculatorEngine->ChangePrecision(static_cast<int>(CalculatorPrecision::ProgrammerModePrecision));
+        }
+        else
+        {
+            this->ActivateEngine(m_programmerCalculatorEngine.get());
         }
-
-        m_currentCalculatorEngine = m_programmerCalculatorEngine.get();
-        m_currentCalculatorEngine->ProcessCommand(IDC_DEC);
-        m_currentCalculatorEngine->ProcessCommand(IDC_CLEAR);
-        m_currentCalculatorEngine->ChangePrecision(static_cast<int>(CalculatorPrecision::ProgrammerModePrecision));
     }
 
 
     /// <summary>
-    /// Send command to the Calc Engine
+    /// Send command to the Calc Engine.
+    /// One command can raise several display callbacks; run it as a display
+    /// transaction so the callback sees each display at most once, bracketed
+    /// by Begin/EndDisplayTransaction for a single UI-thread dispatch.
+    /// </summary>
+    /// <param name="command">Enum Command</command>
+    void CalculatorManager::SendCommand(_In_ Command command)
+    {
+        if (m_engineThreadActive.load(memory_order_acquire) && !this->OnEngineThread())
+        {
+            // Hand the command to the engine thread. The ring is large
+            // enough that a full queue means the engine is deep in a long
+            // computation; yield until it frees a slot rather than dropping
+            // or reordering input.
+            while (!m_commandQueue.TryPush(command))
+            {
+                this_thread::yield();
+            }
+            m_commandsQueued.fetch_add(1, memory_order_release);
+
+            {
+                lock_guard<mutex> lock(m_engineThreadMutex);
+            }
+            m_engineWake.notify_one();
+            return;
+        }
+
+        if (m_batchedCommandMode)
+        {
+            // Already inside a SendCommands batch; its flush covers us.
+            this->SendCommandWorker(command);
+            return;
+        }
+
+        m_batchedCommandMode = true;
+        this->SendCommandWorker(command);
+        m_batchedCommandMode = false;
+
+        m_displayCallback->BeginDisplayTransaction();
+        this->FlushBatchedDisplay();
+        m_displayCallback->EndDisplayTransaction();
+    }
+
+    /// <summary>
     /// Cast Command Enum to OpCode.
     /// Handle special commands such as mode change and combination of two commands.
     /// </summary>
     /// <param name="command">Enum Command</command>
-    void CalculatorManager::SendCommand(_In_ Command command)
+    void CalculatorManager::SendCommandWorker(_In_ Command command)
     {
+        // Each command starts with a clean cancellation slate and this
+        // thread's ratpak checkpoints armed, so CancelComputation from
+        // another thread can abort long series work mid-command.
+        m_computationCancelled.store(false, memory_order_relaxed);
+        SetComputationHooks(&m_computationCancelled, &CalculatorManager::ComputationProgressHeartbeat, this);
+
+        // Every command so far is reflected in the engine, so once the
+        // journal reaches the threshold it can be folded into a checkpoint
+        // before this command is recorded.
+        if (m_savedCommands.size() >= SAVED_COMMANDS_COMPACT_THRESHOLD)
+        {
+            this->TryCompactSavedCommands();
+        }
+
         // When the expression line is cleared, we save the current state, which includes,
         // primary display, memory, and degree mode
         if (command == Command::CommandCLEAR || command == Command::CommandEQU
@@ -239,6 +561,7 @@ namespace CalculationManager
             }
 
             m_savedCommands.clear(); // Clear the previous command history
+            m_checkpointSnapshot.clear(); // The boundary state below supersedes it
 
             if (command != Command::CommandEQU && command != Command::CommandCLEAR)
             {
@@ -297,193 +620,1305 @@ namespace CalculationManager
             m_currentCalculatorEngine->ProcessCommand(static_cast<OpCode>(command));
             break;
         }
-    }
+    }
+
+    /// <summary>
+    /// Send a sequence of commands (e.g. a pasted expression) as one batch.
+    /// Each command runs through the normal SendCommand pipeline, but the
+    /// per-keystroke display callbacks are latched and only the final state
+    /// of each display is forwarded once the batch completes, so a long
+    /// paste does not visibly replay keystroke by keystroke.
+    /// </summary>
+    /// <param name="commands">Commands to process, in order</param>
+    void CalculatorManager::SendCommands(_In_ const vector<Command>& commands)
+    {
+        if (m_engineThreadActive.load(memory_order_acquire) && !this->OnEngineThread())
+        {
+            for (auto const& command : commands)
+            {
+                while (!m_commandQueue.TryPush(command))
+                {
+                    this_thread::yield();
+                }
+                m_commandsQueued.fetch_add(1, memory_order_release);
+            }
+
+            {
+                lock_guard<mutex> lock(m_engineThreadMutex);
+            }
+            m_engineWake.notify_one();
+            return;
+        }
+
+        m_batchedCommandMode = true;
+
+        for (auto const& command : commands)
+        {
+            this->SendCommandWorker(command);
+        }
+
+        m_batchedCommandMode = false;
+
+        m_displayCallback->BeginDisplayTransaction();
+        this->FlushBatchedDisplay();
+        m_displayCallback->EndDisplayTransaction();
+    }
+
+    /// <summary>
+    /// Send count repetitions of one command as a single batch, e.g. the
+    /// repeats a held Backspace or digit key produced while the previous
+    /// keystroke was still processing. Digit and backspace runs reach the
+    /// engine as one batched edit through ProcessCommandRun; any other
+    /// command repeats through the normal per-command pipeline. Either way
+    /// the displays are flushed once for the whole run.
+    /// </summary>
+    /// <param name="command">Command to repeat</param>
+    /// <param name="count">Number of repetitions</param>
+    void CalculatorManager::SendCommandRun(_In_ Command command, uint32_t count)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        if (m_engineThreadActive.load(memory_order_acquire) && !this->OnEngineThread())
+        {
+            // The engine thread drains its queue as one batched burst, so
+            // queueing the repeats individually already coalesces their
+            // display updates.
+            for (uint32_t i = 0; i < count; i++)
+            {
+                while (!m_commandQueue.TryPush(command))
+                {
+                    this_thread::yield();
+                }
+                m_commandsQueued.fetch_add(1, memory_order_release);
+            }
+
+            {
+                lock_guard<mutex> lock(m_engineThreadMutex);
+            }
+            m_engineWake.notify_one();
+            return;
+        }
+
+        m_batchedCommandMode = true;
+        this->SendCommandRunWorker(command, count);
+        m_batchedCommandMode = false;
+
+        m_displayCallback->BeginDisplayTransaction();
+        this->FlushBatchedDisplay();
+        m_displayCallback->EndDisplayTransaction();
+    }
+
+    /// <summary>
+    /// Run worker: commands with a batched engine form (digits, backspace)
+    /// are recorded once per repetition for replay but execute as a single
+    /// ProcessCommandRun; everything else falls back to SendCommandWorker
+    /// per repetition, which keeps the special-command bookkeeping (mode
+    /// changes, clear, equals) exactly as SendCommand would do it.
+    /// </summary>
+    void CalculatorManager::SendCommandRunWorker(_In_ Command command, uint32_t count)
+    {
+        const bool fBatchable = (command >= Command::Command0 && command <= Command::CommandF) || command == Command::CommandBACK;
+
+        if (!fBatchable)
+        {
+            for (uint32_t i = 0; i < count; i++)
+            {
+                this->SendCommandWorker(command);
+            }
+            return;
+        }
+
+        m_computationCancelled.store(false, memory_order_relaxed);
+        SetComputationHooks(&m_computationCancelled, &CalculatorManager::ComputationProgressHeartbeat, this);
+
+        if (m_savedCommands.size() >= SAVED_COMMANDS_COMPACT_THRESHOLD)
+        {
+            this->TryCompactSavedCommands();
+        }
+
+        // Replay and serialization see the run exactly as count keystrokes.
+        for (uint32_t i = 0; i < count; i++)
+        {
+            m_savedCommands.push_back(MapCommandForSerialize(command));
+        }
+
+        m_currentCalculatorEngine->ProcessCommandRun(static_cast<OpCode>(command), count);
+    }
+
+    /// <summary>
+    /// Forward the display callbacks latched during a SendCommands batch,
+    /// once each, in the order the engine would normally raise them.
+    /// </summary>
+    void CalculatorManager::FlushBatchedDisplay()
+    {
+        if (m_batchedExpressionPending)
+        {
+            m_batchedExpressionPending = false;
+            this->SetExpressionDisplay(m_batchedExpressionTokens, m_batchedExpressionCommands);
+            m_batchedExpressionTokens = nullptr;
+            m_batchedExpressionCommands = nullptr;
+        }
+
+        if (m_batchedParenPending)
+        {
+            m_batchedParenPending = false;
+            this->SetParenDisplayText(m_batchedParenText);
+        }
+
+        if (m_batchedPrimaryPending)
+        {
+            m_batchedPrimaryPending = false;
+            this->SetPrimaryDisplay(m_batchedPrimaryDisplay, m_batchedPrimaryIsError);
+        }
+
+        if (m_batchedErrorPending)
+        {
+            m_batchedErrorPending = false;
+            this->SetIsInError(m_batchedIsInError);
+        }
+    }
+
+    /// <summary>
+    /// Turn the dedicated engine thread on or off. While it is on,
+    /// SendCommand and SendCommands enqueue into the lock-free ring and
+    /// return immediately, and the engine thread raises the display
+    /// callbacks (from its own thread, bracketed by display transactions
+    /// so an implementation can marshal each burst in one dispatch).
+    /// Turning it off drains the ring first, so no input is lost and the
+    /// manager returns to the fully synchronous behavior.
+    /// </summary>
+    /// <param name="enable">true to process commands on the engine thread</param>
+    void CalculatorManager::SetBackgroundExecution(bool enable)
+    {
+        if (enable == m_engineThreadActive.load(memory_order_acquire))
+        {
+            return;
+        }
+
+        if (enable)
+        {
+            m_engineThreadActive.store(true, memory_order_release);
+            m_engineThread = thread(&CalculatorManager::EngineThreadProc, this);
+        }
+        else
+        {
+            this->SyncWithEngineThread();
+            {
+                lock_guard<mutex> lock(m_engineThreadMutex);
+                m_engineThreadActive.store(false, memory_order_release);
+            }
+            m_engineWake.notify_one();
+            m_engineThread.join();
+        }
+    }
+
+    /// <summary>
+    /// Release the allocations this manager holds purely for burst
+    /// performance. Retained per-mode engines keep their user-visible
+    /// state (values, history, word size) - only their display caches are
+    /// dropped. Everything released here rebuilds lazily, so the only cost
+    /// of an unnecessary trim is the next burst's warm-up.
+    /// </summary>
+    void CalculatorManager::TrimMemory()
+    {
+        this->SyncWithEngineThread();
+
+        m_memoCache.clear();
+        m_memoCache.shrink_to_fit();
+
+        for (CCalcEngine* engine : { m_standardCalculatorEngine.get(), m_scientificCalculatorEngine.get(), m_programmerCalculatorEngine.get() })
+        {
+            if (engine != nullptr)
+            {
+                engine->TrimDisplayCaches();
+            }
+        }
+
+        // Destroying the pooled engines parks their numbers on this
+        // thread's free lists, so trim the pool before the lists.
+        TrimWarmEnginePool();
+        TrimRatpakPools();
+
+        // The engine thread's free lists are thread_local; ask it to trim
+        // its own on the next wake.
+        if (m_engineThreadActive.load(memory_order_acquire))
+        {
+            m_engineTrimRequested.store(true, memory_order_release);
+            m_engineWake.notify_one();
+        }
+    }
+
+    /// <summary>
+    /// Engine thread main loop: sleep until commands arrive, then drain the
+    /// ring as one burst through the regular SendCommandWorker pipeline with
+    /// the display callbacks latched, and forward the burst's final display
+    /// state as a single transaction. Commands that arrive while a burst is
+    /// executing simply extend it, so a replayed expression pipelines
+    /// through instead of dispatching a display update per keystroke.
+    /// </summary>
+    void CalculatorManager::EngineThreadProc()
+    {
+        for (;;)
+        {
+            {
+                unique_lock<mutex> lock(m_engineThreadMutex);
+                m_engineWake.wait(lock, [this] {
+                    return !m_commandQueue.IsEmpty() || m_engineTrimRequested.load(memory_order_acquire)
+                        || !m_engineThreadActive.load(memory_order_acquire);
+                });
+            }
+
+            // TrimMemory can only release the caller's thread_local free
+            // lists; it hands this thread's to us through the flag.
+            if (m_engineTrimRequested.exchange(false, memory_order_acq_rel))
+            {
+                TrimRatpakPools();
+            }
+
+            if (m_commandQueue.IsEmpty())
+            {
+                if (!m_engineThreadActive.load(memory_order_acquire))
+                {
+                    // This thread's constants and free lists die with it;
+                    // release them so the join hands the memory back.
+                    ReleaseRatpakThreadState();
+                    return;
+                }
+                continue;
+            }
+
+            // The ratpak constants are thread_local; re-derive them here in
+            // case the engine, radix or precision changed on the caller's
+            // thread since the last burst.
+            if (m_currentCalculatorEngine != nullptr)
+            {
+                m_currentCalculatorEngine->BaseOrPrecisionChanged();
+            }
+
+            size_t commandsInBurst = 0;
+            Command command;
+
+            m_batchedCommandMode = true;
+            while (m_commandQueue.TryPop(command))
+            {
+                this->SendCommandWorker(command);
+                commandsInBurst++;
+            }
+            m_batchedCommandMode = false;
+
+            m_displayCallback->BeginDisplayTransaction();
+            this->FlushBatchedDisplay();
+            m_displayCallback->EndDisplayTransaction();
+
+            // Count the burst only after its displays are flushed, so a
+            // caller released by SyncWithEngineThread never races a pending
+            // display transaction.
+            {
+                lock_guard<mutex> lock(m_engineThreadMutex);
+                m_commandsExecuted.fetch_add(commandsInBurst, memory_order_release);
+            }
+            m_engineDrained.notify_all();
+        }
+    }
+
+    /// <summary>
+    /// Block until every queued command has executed and its displays have
+    /// been flushed. Called on entry to the public state readers and
+    /// mutators so that, with background execution on, they still observe
+    /// the state the caller's preceding SendCommand calls produced. A no-op
+    /// when background execution is off or when called from the engine
+    /// thread itself (mode changes run through SendCommandWorker there).
+    /// </summary>
+    void CalculatorManager::SyncWithEngineThread()
+    {
+        if (!m_engineThreadActive.load(memory_order_acquire) || this->OnEngineThread())
+        {
+            return;
+        }
+
+        {
+            unique_lock<mutex> lock(m_engineThreadMutex);
+            m_engineDrained.wait(lock, [this] {
+                return m_commandsExecuted.load(memory_order_acquire) == m_commandsQueued.load(memory_order_acquire);
+            });
+        }
+
+        // Commands run on the engine thread may have changed the engine,
+        // radix or precision; re-derive this thread's ratpak constants
+        // before the caller computes with them.
+        if (m_currentCalculatorEngine != nullptr)
+        {
+            m_currentCalculatorEngine->BaseOrPrecisionChanged();
+        }
+    }
+
+    bool CalculatorManager::OnEngineThread() const
+    {
+        return m_engineThread.get_id() == this_thread::get_id();
+    }
+
+    /// <summary>
+    /// Ask the command currently executing to abandon its computation at
+    /// the next ratpak checkpoint. Deliberately does not wait for the
+    /// engine thread - this is the one call the UI makes while a long
+    /// computation is still in flight. A cancelled operation quietly keeps
+    /// its operand; no error state is entered and no input is lost.
+    /// </summary>
+    void CalculatorManager::CancelComputation()
+    {
+        m_computationCancelled.store(true, memory_order_release);
+    }
+
+    /// <summary>
+    /// Opt-in engine diagnostics: ratpak's allocation and multiply
+    /// counters (see RATPAK_STATS). Process-wide, off by default; while
+    /// off the instrumented paths cost a single predicted branch. Static
+    /// because the counters are shared by every engine in the process -
+    /// callers hosting multiple windows see the aggregate.
+    /// </summary>
+    void CalculatorManager::SetDiagnosticsEnabled(bool enable)
+    {
+        EnableRatpakStats(enable);
+    }
+
+    bool CalculatorManager::DiagnosticsEnabled()
+    {
+        return g_ratpakStatsEnabled.load(memory_order_relaxed);
+    }
+
+    RATPAK_STATS CalculatorManager::GetDiagnostics()
+    {
+        return GetRatpakStats();
+    }
+
+    void CalculatorManager::ResetDiagnostics()
+    {
+        ResetRatpakStats();
+    }
+
+    static atomic<uint64_t> s_memoCacheLookups{ 0 };
+    static atomic<uint64_t> s_memoCacheHits{ 0 };
+
+    CalculatorManager::MEMO_CACHE_STATS CalculatorManager::GetMemoCacheStats()
+    {
+        return { s_memoCacheLookups.load(memory_order_relaxed), s_memoCacheHits.load(memory_order_relaxed) };
+    }
+
+    /// <summary>
+    /// Ratpak progress hook: forwards the iteration heartbeat of a long
+    /// series evaluation to the display callback, on the computing thread.
+    /// </summary>
+    /// <param name="pContext">The CalculatorManager that armed the hook</param>
+    /// <param name="cIterations">Series iterations completed so far</param>
+    void CalculatorManager::ComputationProgressHeartbeat(void* pContext, uint32_t cIterations)
+    {
+        auto pManager = static_cast<CalculatorManager*>(pContext);
+        pManager->m_displayCallback->OnComputationProgress(cIterations);
+    }
+
+    /// <summary>
+    /// Convert Command to unsigned char.
+    /// Since some Commands are higher than 255, they are saved after subtracting 255
+    /// The smallest Command is CommandSIGN = 80, thus, subtracted value does not overlap with other values.
+    /// </summary>
+    /// <param name="command">Enum Command</command>
+    unsigned char CalculatorManager::MapCommandForSerialize(Command command)
+    {
+        unsigned int commandToSave = static_cast<unsigned int>(command);
+        if (commandToSave > UCHAR_MAX)
+        {
+            commandToSave -= UCHAR_MAX;
+        }
+        return static_cast<unsigned char>(commandToSave);
+    }
+
+    /// <summary>
+    /// Convert Command to unsigned int
+    /// The command that is smaller than 80, CommandSIGN, can be converted back to original value by adding 255.
+    /// </summary>
+    /// <param name="command">unsigned char value represent the saved command</command>
+    unsigned int CalculatorManager::MapCommandForDeSerialize(unsigned char command)
+    {
+        unsigned int commandToLoad = command;
+        if (command < static_cast<unsigned int>(Command::CommandSIGN))
+        {
+            commandToLoad += UCHAR_MAX;
+        }
+        return commandToLoad;
+    }
+
+    /// <summary>
+    /// Return saved degree mode which is saved when last time the expression was cleared.
+    /// </summary>
+    Command CalculatorManager::SerializeSavedDegreeMode()
+    {
+        this->SyncWithEngineThread();
+        return m_savedDegreeMode;
+    }
+
+    void CalculatorManager::SerializePrimaryDisplay()
+    {
+        this->SyncWithEngineThread();
+        m_savedPrimaryValue.clear();
+        m_currentCalculatorEngine->ProcessCommand(IDC_STORE);
+        auto memoryObject = m_currentCalculatorEngine->PersistedMemObject();
+        if (memoryObject != nullptr)
+        {
+            m_savedPrimaryValue = SerializeRational(*memoryObject);
+        }
+    }
+
+    /// <summary>
+    /// Return serialized primary display that is saved when the expression line was cleared.
+    /// </summary>
+    vector<long> CalculatorManager::GetSerializedPrimaryDisplay()
+    {
+        this->SyncWithEngineThread();
+        return m_savedPrimaryValue;
+    }
+
+    /// <summary>
+    /// DeSerialize the primary display from vector of long
+    /// </summary>
+    /// <param name = "serializedPrimaryDisplay">Serialized Rational of primary display</param>
+    void CalculatorManager::DeSerializePrimaryDisplay(const vector<long> &serializedPrimaryDisplay)
+    {
+        this->SyncWithEngineThread();
+        if (serializedPrimaryDisplay.empty())
+        {
+            return;
+        }
+        m_persistedPrimaryValue = DeSerializeRational(serializedPrimaryDisplay.begin());
+        this->LoadPersistedPrimaryValue();
+    }
+
+    /// <summary>
+    /// Load the persisted value that is saved in memory of CalcEngine
+    /// </summary>
+    void CalculatorManager::LoadPersistedPrimaryValue()
+    {
+        m_currentCalculatorEngine->PersistedMemObject(m_persistedPrimaryValue);
+        m_currentCalculatorEngine->ProcessCommand(IDC_RECALL);
+    }
+
+    /// <summary>
+    /// Serialize the Memory to vector of long
+    /// </summary>
+    /// <return type = "std::vector<long>">Serialized Rational of memory</return>
+    void CalculatorManager::SerializeMemory()
+    {
+        this->SyncWithEngineThread();
+        m_serializedMemory.clear();
+
+        for (auto const& memoryItem : m_memorizedNumbers)
+        {
+            auto serialMem = SerializeRational(memoryItem);
+            m_serializedMemory.insert(m_serializedMemory.end(), serialMem.begin(), serialMem.end());
+        }
+    }
+
+    vector<long> CalculatorManager::GetSerializedMemory()
+    {
+        this->SyncWithEngineThread();
+        return m_serializedMemory;
+    }
+
+    /// <summary>
+    /// DeSerialize the Memory from vector of long
+    /// </summary>
+    /// <param name = "serializedMemory">Serialized Rational of memory</param>
+    void CalculatorManager::DeSerializeMemory(const vector<long> &serializedMemory)
+    {
+        this->SyncWithEngineThread();
+        vector<long>::const_iterator itr = serializedMemory.begin();
+        while (itr != serializedMemory.end())
+        {
+            Rational memoryItem = DeSerializeRational(itr);
+            auto lengthMemoryItem = (2 * SERIALIZED_NUMBER_MINSIZE) + memoryItem.P().Mantissa().size() + memoryItem.Q().Mantissa().size();
+            m_memorizedNumbers.push_back(memoryItem);
+            itr += lengthMemoryItem;
+        }
+        this->SetMemorizedNumbersString();
+    }
+
+    /// <summary>
+    /// Validated variant of DeSerializeMemory for streams read back from
+    /// disk: the slots are replaced as a whole, and a stream that does not
+    /// parse cleanly restores nothing rather than garbage.
+    /// </summary>
+    /// <param name = "serializedMemory">Serialized Rational of memory</param>
+    bool CalculatorManager::TryDeSerializeMemory(const vector<long> &serializedMemory)
+    {
+        this->SyncWithEngineThread();
+        vector<Rational> memorizedNumbers;
+        size_t iStream = 0;
+        while (iStream < serializedMemory.size())
+        {
+            if (memorizedNumbers.size() >= m_maximumMemorySize)
+            {
+                return false;
+            }
+            Rational memoryItem;
+            if (!TryDeSerializeRational(serializedMemory, iStream, memoryItem))
+            {
+                return false;
+            }
+            memorizedNumbers.push_back(memoryItem);
+        }
+
+        m_memorizedNumbers = std::move(memorizedNumbers);
+        this->SetMemorizedNumbersString();
+        return true;
+    }
+
+    /// <summary>
+    /// Return the commands saved since the expression has been cleared.
+    /// </summary>
+    vector<unsigned char> CalculatorManager::SerializeCommands()
+    {
+        this->SyncWithEngineThread();
+        return m_savedCommands;
+    }
+
+    // FNV-1a over a byte range, used to key the replay memo cache. Hash
+    // equality is only a fast reject; hits are confirmed by comparing the
+    // command bytes themselves.
+    static size_t HashBytes(size_t hash, _In_reads_(cb) const unsigned char* pb, size_t cb)
+    {
+        for (size_t i = 0; i < cb; i++)
+        {
+            hash ^= pb[i];
+            hash *= static_cast<size_t>(0x100000001b3);
+        }
+        return hash;
+    }
+
+    static constexpr size_t HASH_SEED = static_cast<size_t>(0xcbf29ce484222325);
+
+    /// <summary>
+    /// Fingerprint of the settings that change what a replayed command
+    /// stream evaluates to but live outside the state snapshot: the active
+    /// mode and its radix and precision, plus the saved degree mode.
+    /// </summary>
+    size_t CalculatorManager::MemoCacheSettingsStamp()
+    {
+        long stamp[4];
+        stamp[0] = (m_currentCalculatorEngine == m_standardCalculatorEngine.get()) ? 0
+                 : (m_currentCalculatorEngine == m_scientificCalculatorEngine.get()) ? 1 : 2;
+        stamp[1] = m_currentCalculatorEngine->GetCurrentRadix();
+        stamp[2] = m_currentCalculatorEngine->GetPrecision();
+        stamp[3] = static_cast<long>(this->SerializeSavedDegreeMode());
+        return HashBytes(HASH_SEED, reinterpret_cast<const unsigned char*>(stamp), sizeof(stamp));
+    }
+
+    /// <summary>
+    /// Replay the serialized commands
+    /// </summary>
+    /// <param name = "serializedData">Serialized commands</param>
+    void CalculatorManager::DeSerializeCommands(_In_ const vector<unsigned char>& serializedData)
+    {
+        this->SyncWithEngineThread();
+
+        // Identical command bytes replayed from an identical starting state
+        // under identical settings end in an identical state, so replaying
+        // a journal already seen restores the memoized snapshot instead of
+        // re-evaluating every command. A starting state that cannot be
+        // snapshotted (mid number entry or in error) bypasses the cache.
+        size_t commandsHash = 0;
+        size_t settingsStamp = 0;
+        size_t preStateHash = 0;
+        bool fCacheable = m_currentCalculatorEngine != nullptr;
+        if (fCacheable)
+        {
+            commandsHash = HashBytes(HASH_SEED, serializedData.data(), serializedData.size());
+            settingsStamp = this->MemoCacheSettingsStamp();
+            vector<long> preState = this->SerializeStateSnapshot();
+            fCacheable = !preState.empty() && preState[4] == 0;
+            if (fCacheable)
+            {
+                // Hash only the replay-relevant parts of the starting
+                // state: the degree mode and format flags, the memory
+                // slots and the engine image. The journal and boundary
+                // bookkeeping sections in between are rewritten by the
+                // replay itself, so starting states differing only there
+                // evaluate identically.
+                size_t iState = 5;
+                for (int cSkip = 0; cSkip < 3 && iState < preState.size(); cSkip++)
+                {
+                    iState += static_cast<size_t>(preState[iState]) + 1;
+                }
+                long header[2] = { preState[1], preState[3] };
+                preStateHash = HashBytes(HASH_SEED, reinterpret_cast<const unsigned char*>(header), sizeof(header));
+                if (iState < preState.size())
+                {
+                    preStateHash = HashBytes(preStateHash, reinterpret_cast<const unsigned char*>(preState.data() + iState),
+                                             (preState.size() - iState) * sizeof(long));
+                }
+            }
+        }
+        if (fCacheable)
+        {
+            s_memoCacheLookups.fetch_add(1, memory_order_relaxed);
+            for (auto& entry : m_memoCache)
+            {
+                if (entry.commandsHash == commandsHash && entry.settingsStamp == settingsStamp
+                    && entry.preStateHash == preStateHash && entry.commands == serializedData)
+                {
+                    if (this->DeSerializeStateSnapshot(entry.snapshot))
+                    {
+                        entry.lastUse = ++m_memoCacheUseCounter;
+                        s_memoCacheHits.fetch_add(1, memory_order_relaxed);
+                        return;
+                    }
+                    break;
+                }
+            }
+        }
+
+        m_savedCommands.clear();
+
+        for (auto commandItr = serializedData.begin(); commandItr != serializedData.end(); ++commandItr)
+        {
+            if (*commandItr >= MEMORY_COMMAND_TO_UNSIGNED_CHAR(MemoryCommand::MemorizeNumber) &&
+                *commandItr <= MEMORY_COMMAND_TO_UNSIGNED_CHAR(MemoryCommand::MemorizedNumberClearAll))
+            {
+                // MemoryCommands(which have values above 255) are pushed on m_savedCommands upon casting to unsigned char.
+                // SerializeCommands uses m_savedCommands, which is then used in DeSerializeCommands.
+                // Hence, a simple cast to MemoryCommand is not sufficient.
+                MemoryCommand memoryCommand = static_cast<MemoryCommand>(*commandItr + UCHAR_MAX + 1);
+                unsigned int indexOfMemory = 0;
+                switch (memoryCommand)
+                {
+                case MemoryCommand::MemorizeNumber:
+                    this->MemorizeNumber();
+                    break;
+                case MemoryCommand::MemorizedNumberLoad:
+                    if (commandItr + 1 == serializedData.end())
+                    {
+                        throw out_of_range("Expecting index of memory, data ended prematurely");
+                    }
+                    indexOfMemory = *(++commandItr);
+                    this->MemorizedNumberLoad(indexOfMemory);
+                    break;
+                case MemoryCommand::MemorizedNumberAdd:
+                    if (commandItr + 1 == serializedData.end())
+                    {
+                        throw out_of_range("Expecting index of memory, data ended prematurely");
+                    }
+                    indexOfMemory = *(++commandItr);
+                    this->MemorizedNumberAdd(indexOfMemory);
+                    break;
+                case MemoryCommand::MemorizedNumberSubtract:
+                    if (commandItr + 1 == serializedData.end())
+                    {
+                        throw out_of_range("Expecting index of memory, data ended prematurely");
+                    }
+                    indexOfMemory = *(++commandItr);
+                    this->MemorizedNumberSubtract(indexOfMemory);
+                    break;
+                case MemoryCommand::MemorizedNumberClearAll:
+                    this->MemorizedNumberClearAll();
+                    break;
+                default:
+                    break;
+                }
+            }
+            else
+            {
+                this->SendCommand(static_cast<Command>(MapCommandForDeSerialize(*commandItr)));
+            }
+        }
+
+        if (fCacheable)
+        {
+            // Memoize only a fully settled result; a suffix-form snapshot
+            // would replay the journal on restore and save nothing.
+            vector<long> finalState = this->SerializeStateSnapshot();
+            if (!finalState.empty() && finalState[4] == 0)
+            {
+                if (m_memoCache.size() >= m_memoCacheCapacity)
+                {
+                    auto victim = m_memoCache.begin();
+                    for (auto itr = m_memoCache.begin(); itr != m_memoCache.end(); ++itr)
+                    {
+                        if (itr->lastUse < victim->lastUse)
+                        {
+                            victim = itr;
+                        }
+                    }
+                    m_memoCache.erase(victim);
+                }
+                m_memoCache.push_back({ commandsHash, serializedData, settingsStamp, preStateHash, move(finalState), ++m_memoCacheUseCounter });
+            }
+        }
+    }
+
+    /// <summary>
+    /// Serialize the complete manager and engine state into a versioned
+    /// vector of long, so a later resume restores it in one step instead of
+    /// replaying the keystroke journal through DeSerializeCommands. Returns
+    /// an empty vector when the engine cannot be snapshotted (mid number
+    /// entry or in error state); the journal stays the restore path there.
+    /// </summary>
+    vector<long> CalculatorManager::SerializeStateSnapshot()
+    {
+        this->SyncWithEngineThread();
+        vector<long> stream;
+
+        CCalcEngine::Snapshot engineSnapshot;
+        if (!m_currentCalculatorEngine->TryGetSnapshot(engineSnapshot))
+        {
+            // Mid number entry or in error the live state cannot be
+            // snapshotted, but if the journal has been compacted, the
+            // checkpoint taken then plus the commands recorded since
+            // restores the same state: emit the checkpoint image with the
+            // journal suffix spliced in and marked for replay.
+            if (!m_checkpointSnapshot.empty())
+            {
+                stream.reserve(m_checkpointSnapshot.size() + m_savedCommands.size());
+                stream.push_back(m_checkpointSnapshot[0]); // version
+                stream.push_back(static_cast<long>(m_currentDegreeMode));
+                stream.push_back(static_cast<long>(m_savedDegreeMode));
+                stream.push_back(m_isExponentialFormat ? 1 : 0);
+                stream.push_back(1); // journal is a replay suffix
+                stream.push_back(static_cast<long>(m_savedCommands.size()));
+                stream.insert(stream.end(), m_savedCommands.begin(), m_savedCommands.end());
+                stream.insert(stream.end(), m_checkpointSnapshot.begin() + 6, m_checkpointSnapshot.end());
+            }
+            return stream;
+        }
+
+        auto appendRational = [&stream](Rational const& rat)
+        {
+            auto serialRat = SerializeRational(rat);
+            stream.insert(stream.end(), serialRat.begin(), serialRat.end());
+        };
+
+        stream.push_back(SERIALIZED_STATE_SNAPSHOT_VERSION);
+        stream.push_back(static_cast<long>(m_currentDegreeMode));
+        stream.push_back(static_cast<long>(m_savedDegreeMode));
+        stream.push_back(m_isExponentialFormat ? 1 : 0);
+        stream.push_back(0); // journal already reflected in the engine state
+
+        stream.push_back(static_cast<long>(m_savedCommands.size()));
+        stream.insert(stream.end(), m_savedCommands.begin(), m_savedCommands.end());
+        stream.push_back(static_cast<long>(m_savedPrimaryValue.size()));
+        stream.insert(stream.end(), m_savedPrimaryValue.begin(), m_savedPrimaryValue.end());
+        stream.push_back(static_cast<long>(m_serializedMemory.size()));
+        stream.insert(stream.end(), m_serializedMemory.begin(), m_serializedMemory.end());
+        stream.push_back(static_cast<long>(m_memorizedNumbers.size()));
+        for (auto const& memoryItem : m_memorizedNumbers)
+        {
+            appendRational(memoryItem);
+        }
+
+        stream.push_back(engineSnapshot.nOpCode);
+        stream.push_back(engineSnapshot.nPrevOpCode);
+        stream.push_back(engineSnapshot.bChangeOp ? 1 : 0);
+        stream.push_back(engineSnapshot.bNoPrevEqu ? 1 : 0);
+        stream.push_back(engineSnapshot.bInv ? 1 : 0);
+        stream.push_back(engineSnapshot.bRecord ? 1 : 0);
+        stream.push_back(engineSnapshot.nFE);
+        stream.push_back(engineSnapshot.nTempCom);
+        stream.push_back(engineSnapshot.nLastCom);
+        stream.push_back(engineSnapshot.openParenCount);
+        for (int i = 0; i < engineSnapshot.openParenCount; i++)
+        {
+            stream.push_back(engineSnapshot.nOp[i]);
+            appendRational(engineSnapshot.parenVals[i]);
+        }
+        stream.push_back(static_cast<long>(engineSnapshot.precedenceOpCount));
+        for (size_t i = 0; i < engineSnapshot.precedenceOpCount; i++)
+        {
+            stream.push_back(engineSnapshot.nPrecOp[i]);
+            appendRational(engineSnapshot.precedenceVals[i]);
+        }
+        appendRational(engineSnapshot.lastVal);
+        appendRational(engineSnapshot.currentVal);
+        appendRational(engineSnapshot.holdVal);
+
+        auto const& collector = engineSnapshot.historyCollector;
+        stream.push_back(collector.iCurLineHistStart);
+        stream.push_back(collector.lastOpStartIndex);
+        stream.push_back(collector.lastBinOpStartIndex);
+        stream.push_back(collector.bLastOpndBrace ? 1 : 0);
+        stream.push_back(collector.fTokensLive ? 1 : 0);
+        stream.push_back(collector.curOperandIndex);
+        for (int i = 0; i < collector.curOperandIndex; i++)
+        {
+            stream.push_back(collector.operandIndices[i]);
+        }
+        stream.push_back(static_cast<long>(collector.equationSz.size()));
+        for (wchar_t wch : collector.equationSz)
+        {
+            stream.push_back(static_cast<long>(wch));
+        }
+        stream.push_back(static_cast<long>(collector.tokens.size()));
+        stream.insert(stream.end(), collector.tokens.begin(), collector.tokens.end());
+
+        vector<int> packedCommands;
+        if (collector.spCommands != nullptr)
+        {
+            CalculatorHistory::PackCommands(collector.spCommands, packedCommands);
+        }
+        stream.push_back(static_cast<long>(packedCommands.size()));
+        stream.insert(stream.end(), packedCommands.begin(), packedCommands.end());
+
+        return stream;
+    }
+
+    /// <summary>
+    /// Restore the state saved by SerializeStateSnapshot. Everything is
+    /// validated before any of it is applied; on a malformed or
+    /// wrong-version snapshot the manager is left untouched and false is
+    /// returned so the caller can fall back to replaying the journal.
+    /// </summary>
+    /// <param name = "serializedSnapshot">Serialized state snapshot</param>
+    bool CalculatorManager::DeSerializeStateSnapshot(_In_ const vector<long>& serializedSnapshot)
+    {
+        this->SyncWithEngineThread();
+        size_t iStream = 0;
+        auto readLong = [&serializedSnapshot, &iStream](long& value)
+        {
+            if (iStream >= serializedSnapshot.size())
+            {
+                return false;
+            }
+            value = serializedSnapshot[iStream++];
+            return true;
+        };
+        auto readCount = [&serializedSnapshot, &iStream, &readLong](size_t& count)
+        {
+            long value;
+            if (!readLong(value) || value < 0 || static_cast<size_t>(value) > serializedSnapshot.size() - iStream)
+            {
+                return false;
+            }
+            count = static_cast<size_t>(value);
+            return true;
+        };
+
+        long version, currentDegreeMode, savedDegreeMode, isExponentialFormat, journalIsSuffix;
+        if (!readLong(version) || version != SERIALIZED_STATE_SNAPSHOT_VERSION
+            || !readLong(currentDegreeMode) || !readLong(savedDegreeMode) || !readLong(isExponentialFormat)
+            || !readLong(journalIsSuffix) || (journalIsSuffix != 0 && journalIsSuffix != 1))
+        {
+            return false;
+        }
+
+        auto isDegreeMode = [](long mode)
+        {
+            return mode == static_cast<long>(Command::CommandNULL) || mode == static_cast<long>(Command::CommandDEG)
+                || mode == static_cast<long>(Command::CommandRAD) || mode == static_cast<long>(Command::CommandGRAD);
+        };
+        if (!isDegreeMode(currentDegreeMode) || !isDegreeMode(savedDegreeMode))
+        {
+            return false;
+        }
+
+        size_t cSavedCommands;
+        if (!readCount(cSavedCommands))
+        {
+            return false;
+        }
+        vector<unsigned char> savedCommands;
+        savedCommands.reserve(cSavedCommands);
+        for (size_t i = 0; i < cSavedCommands; i++)
+        {
+            long command;
+            if (!readLong(command) || command < 0 || command > UCHAR_MAX)
+            {
+                return false;
+            }
+            savedCommands.push_back(static_cast<unsigned char>(command));
+        }
+
+        size_t cSavedPrimaryValue, cSerializedMemory;
+        if (!readCount(cSavedPrimaryValue))
+        {
+            return false;
+        }
+        vector<long> savedPrimaryValue(serializedSnapshot.begin() + iStream, serializedSnapshot.begin() + iStream + cSavedPrimaryValue);
+        iStream += cSavedPrimaryValue;
+        if (!readCount(cSerializedMemory))
+        {
+            return false;
+        }
+        vector<long> serializedMemory(serializedSnapshot.begin() + iStream, serializedSnapshot.begin() + iStream + cSerializedMemory);
+        iStream += cSerializedMemory;
+
+        size_t cMemorizedNumbers;
+        if (!readCount(cMemorizedNumbers) || cMemorizedNumbers > m_maximumMemorySize)
+        {
+            return false;
+        }
+        vector<Rational> memorizedNumbers;
+        for (size_t i = 0; i < cMemorizedNumbers; i++)
+        {
+            Rational memoryItem;
+            if (!TryDeSerializeRational(serializedSnapshot, iStream, memoryItem))
+            {
+                return false;
+            }
+            memorizedNumbers.push_back(memoryItem);
+        }
+
+        CCalcEngine::Snapshot engineSnapshot = {};
+        long value;
+        if (!readLong(value))
+        {
+            return false;
+        }
+        engineSnapshot.nOpCode = static_cast<int>(value);
+        if (!readLong(value))
+        {
+            return false;
+        }
+        engineSnapshot.nPrevOpCode = static_cast<int>(value);
+        if (!readLong(value))
+        {
+            return false;
+        }
+        engineSnapshot.bChangeOp = (value != 0);
+        if (!readLong(value))
+        {
+            return false;
+        }
+        engineSnapshot.bNoPrevEqu = (value != 0);
+        if (!readLong(value))
+        {
+            return false;
+        }
+        engineSnapshot.bInv = (value != 0);
+        if (!readLong(value))
+        {
+            return false;
+        }
+        engineSnapshot.bRecord = (value != 0);
+        if (!readLong(value))
+        {
+            return false;
+        }
+        engineSnapshot.nFE = static_cast<int>(value);
+        if (!readLong(value))
+        {
+            return false;
+        }
+        engineSnapshot.nTempCom = static_cast<int>(value);
+        if (!readLong(value))
+        {
+            return false;
+        }
+        engineSnapshot.nLastCom = static_cast<int>(value);
+
+        size_t openParenCount;
+        if (!readCount(openParenCount) || openParenCount > MAXPRECDEPTH)
+        {
+            return false;
+        }
+        engineSnapshot.openParenCount = static_cast<int>(openParenCount);
+        for (size_t i = 0; i < openParenCount; i++)
+        {
+            if (!readLong(value) || !TryDeSerializeRational(serializedSnapshot, iStream, engineSnapshot.parenVals[i]))
+            {
+                return false;
+            }
+            engineSnapshot.nOp[i] = static_cast<int>(value);
+        }
+        size_t precedenceOpCount;
+        if (!readCount(precedenceOpCount) || precedenceOpCount > MAXPRECDEPTH)
+        {
+            return false;
+        }
+        engineSnapshot.precedenceOpCount = precedenceOpCount;
+        for (size_t i = 0; i < precedenceOpCount; i++)
+        {
+            if (!readLong(value) || !TryDeSerializeRational(serializedSnapshot, iStream, engineSnapshot.precedenceVals[i]))
+            {
+                return false;
+            }
+            engineSnapshot.nPrecOp[i] = static_cast<int>(value);
+        }
+        if (!TryDeSerializeRational(serializedSnapshot, iStream, engineSnapshot.lastVal)
+            || !TryDeSerializeRational(serializedSnapshot, iStream, engineSnapshot.currentVal)
+            || !TryDeSerializeRational(serializedSnapshot, iStream, engineSnapshot.holdVal))
+        {
+            return false;
+        }
+
+        auto& collector = engineSnapshot.historyCollector;
+        if (!readLong(value))
+        {
+            return false;
+        }
+        collector.iCurLineHistStart = static_cast<int>(value);
+        if (!readLong(value))
+        {
+            return false;
+        }
+        collector.lastOpStartIndex = static_cast<int>(value);
+        if (!readLong(value))
+        {
+            return false;
+        }
+        collector.lastBinOpStartIndex = static_cast<int>(value);
+        if (!readLong(value))
+        {
+            return false;
+        }
+        collector.bLastOpndBrace = (value != 0);
+        if (!readLong(value))
+        {
+            return false;
+        }
+        collector.fTokensLive = (value != 0);
+
+        size_t curOperandIndex;
+        if (!readCount(curOperandIndex) || curOperandIndex > MAXPRECDEPTH)
+        {
+            return false;
+        }
+        collector.curOperandIndex = static_cast<int>(curOperandIndex);
+        for (size_t i = 0; i < curOperandIndex; i++)
+        {
+            if (!readLong(value))
+            {
+                return false;
+            }
+            collector.operandIndices[i] = static_cast<int>(value);
+        }
+
+        size_t cchEquation;
+        if (!readCount(cchEquation))
+        {
+            return false;
+        }
+        collector.equationSz.reserve(cchEquation);
+        for (size_t i = 0; i < cchEquation; i++)
+        {
+            if (!readLong(value))
+            {
+                return false;
+            }
+            collector.equationSz.push_back(static_cast<wchar_t>(value));
+        }
 
-    /// <summary>
-    /// Convert Command to unsigned char.
-    /// Since some Commands are higher than 255, they are saved after subtracting 255
-    /// The smallest Command is CommandSIGN = 80, thus, subtracted value does not overlap with other values.
-    /// </summary>
-    /// <param name="command">Enum Command</command>
-    unsigned char CalculatorManager::MapCommandForSerialize(Command command)
-    {
-        unsigned int commandToSave = static_cast<unsigned int>(command);
-        if (commandToSave > UCHAR_MAX)
+        size_t cTokenInts;
+        if (!readCount(cTokenInts) || cTokenInts % 3 != 0)
         {
-            commandToSave -= UCHAR_MAX;
+            return false;
+        }
+        collector.tokens.reserve(cTokenInts);
+        for (size_t i = 0; i < cTokenInts; i++)
+        {
+            if (!readLong(value))
+            {
+                return false;
+            }
+            collector.tokens.push_back(static_cast<int>(value));
+        }
+        for (size_t i = 0; i + 2 < collector.tokens.size(); i += 3)
+        {
+            int ichStart = collector.tokens[i];
+            int cch = collector.tokens[i + 1];
+            if (ichStart < 0 || cch < 0 || static_cast<size_t>(ichStart) + cch > collector.equationSz.size())
+            {
+                return false;
+            }
         }
-        return static_cast<unsigned char>(commandToSave);
-    }
 
-    /// <summary>
-    /// Convert Command to unsigned int
-    /// The command that is smaller than 80, CommandSIGN, can be converted back to original value by adding 255.
-    /// </summary>
-    /// <param name="command">unsigned char value represent the saved command</command>
-    unsigned int CalculatorManager::MapCommandForDeSerialize(unsigned char command)
-    {
-        unsigned int commandToLoad = command;
-        if (command < static_cast<unsigned int>(Command::CommandSIGN))
+        size_t cCommandInts;
+        if (!readCount(cCommandInts))
         {
-            commandToLoad += UCHAR_MAX;
+            return false;
+        }
+        vector<int> packedCommands;
+        packedCommands.reserve(cCommandInts);
+        for (size_t i = 0; i < cCommandInts; i++)
+        {
+            if (!readLong(value))
+            {
+                return false;
+            }
+            packedCommands.push_back(static_cast<int>(value));
+        }
+        if (!HistoryJournal::FValidPackedCommands(packedCommands))
+        {
+            return false;
+        }
+        if (!packedCommands.empty())
+        {
+            collector.spCommands = CalculatorHistory::HydrateCommands(packedCommands);
         }
-        return commandToLoad;
-    }
 
-    /// <summary>
-    /// Return saved degree mode which is saved when last time the expression was cleared.
-    /// </summary>
-    Command CalculatorManager::SerializeSavedDegreeMode()
-    {
-        return m_savedDegreeMode;
-    }
+        // Everything checked out; apply it in one go.
+        m_currentDegreeMode = static_cast<Command>(currentDegreeMode);
+        m_savedDegreeMode = static_cast<Command>(savedDegreeMode);
+        m_isExponentialFormat = (isExponentialFormat != 0);
+        m_savedPrimaryValue = savedPrimaryValue;
+        m_serializedMemory = serializedMemory;
+        m_memorizedNumbers = memorizedNumbers;
 
-    void CalculatorManager::SerializePrimaryDisplay()
-    {
-        m_savedPrimaryValue.clear();
-        m_currentCalculatorEngine->ProcessCommand(IDC_STORE);
-        auto memoryObject = m_currentCalculatorEngine->PersistedMemObject();
-        if (memoryObject != nullptr)
+        m_currentCalculatorEngine->ApplySnapshot(engineSnapshot);
+        if (m_currentDegreeMode != Command::CommandNULL)
         {
-            m_savedPrimaryValue = SerializeRational(*memoryObject);
+            m_currentCalculatorEngine->ProcessCommand(static_cast<OpCode>(m_currentDegreeMode));
         }
-    }
+        this->SetMemorizedNumbersString();
 
-    /// <summary>
-    /// Return serialized primary display that is saved when the expression line was cleared.
-    /// </summary>
-    vector<long> CalculatorManager::GetSerializedPrimaryDisplay()
-    {
-        return m_savedPrimaryValue;
-    }
+        // Keep the applied state as the checkpoint (the stream with its
+        // journal section emptied), so a later serialize from an unsettled
+        // state still has a base to pair with the journal suffix.
+        m_checkpointSnapshot.assign(serializedSnapshot.begin(), serializedSnapshot.begin() + 5);
+        m_checkpointSnapshot[4] = 0;
+        m_checkpointSnapshot.push_back(0);
+        m_checkpointSnapshot.insert(m_checkpointSnapshot.end(), serializedSnapshot.begin() + 6 + cSavedCommands, serializedSnapshot.end());
 
-    /// <summary>
-    /// DeSerialize the primary display from vector of long
-    /// </summary>
-    /// <param name = "serializedPrimaryDisplay">Serialized Rational of primary display</param>
-    void CalculatorManager::DeSerializePrimaryDisplay(const vector<long> &serializedPrimaryDisplay)
-    {
-        if (serializedPrimaryDisplay.empty())
+        if (journalIsSuffix != 0)
         {
-            return;
+            // The journal was recorded after the checkpoint was taken;
+            // replay it on top of the restored state. The replay refills
+            // m_savedCommands as it goes.
+            this->DeSerializeCommands(savedCommands);
+        }
+        else
+        {
+            m_savedCommands = savedCommands;
         }
-        m_persistedPrimaryValue = DeSerializeRational(serializedPrimaryDisplay.begin());
-        this->LoadPersistedPrimaryValue();
-    }
 
-    /// <summary>
-    /// Load the persisted value that is saved in memory of CalcEngine
-    /// </summary>
-    void CalculatorManager::LoadPersistedPrimaryValue()
-    {
-        m_currentCalculatorEngine->PersistedMemObject(m_persistedPrimaryValue);
-        m_currentCalculatorEngine->ProcessCommand(IDC_RECALL);
+        return true;
     }
 
     /// <summary>
-    /// Serialize the Memory to vector of long
+    /// Fork the complete state of another manager into this one, for
+    /// "duplicate window". The engine state travels as one snapshot
+    /// instead of a keystroke replay, and the recorded history is shared:
+    /// items are immutable once added, so both windows can safely hold
+    /// the same item objects and only the index vectors are copied. The
+    /// caller must have put this manager into the same mode as the source
+    /// first. Returns false when the source cannot be snapshotted (mid
+    /// keystroke entry or in error with no checkpoint to lean on); the
+    /// new window then starts blank as it does today.
     /// </summary>
-    /// <return type = "std::vector<long>">Serialized Rational of memory</return>
-    void CalculatorManager::SerializeMemory()
+    /// <param name = "other">Manager whose state to duplicate</param>
+    bool CalculatorManager::CloneStateFrom(_In_ CalculatorManager& other)
     {
-        m_serializedMemory.clear();
-
-        for (auto const& memoryItem : m_memorizedNumbers)
+        if (this == &other)
         {
-            auto serialMem = SerializeRational(memoryItem);
-            m_serializedMemory.insert(m_serializedMemory.end(), serialMem.begin(), serialMem.end());
+            return true;
         }
-    }
 
-    vector<long> CalculatorManager::GetSerializedMemory()
-    {
-        return m_serializedMemory;
-    }
+        vector<long> snapshot = other.SerializeStateSnapshot();
+        if (snapshot.empty() || !this->DeSerializeStateSnapshot(snapshot))
+        {
+            return false;
+        }
 
-    /// <summary>
-    /// DeSerialize the Memory from vector of long
-    /// </summary>
-    /// <param name = "serializedMemory">Serialized Rational of memory</param>
-    void CalculatorManager::DeSerializeMemory(const vector<long> &serializedMemory)
-    {
-        vector<long>::const_iterator itr = serializedMemory.begin();
-        while (itr != serializedMemory.end())
+        m_pStdHistory->ClearHistory();
+        for (auto const& item : other.m_pStdHistory->GetHistory())
         {
-            Rational memoryItem = DeSerializeRational(itr);
-            auto lengthMemoryItem = (2 * SERIALIZED_NUMBER_MINSIZE) + memoryItem.P().Mantissa().size() + memoryItem.Q().Mantissa().size();
-            m_memorizedNumbers.push_back(memoryItem);
-            itr += lengthMemoryItem;
+            m_pStdHistory->AddItem(item);
         }
-        this->SetMemorizedNumbersString();
+        m_pSciHistory->ClearHistory();
+        for (auto const& item : other.m_pSciHistory->GetHistory())
+        {
+            m_pSciHistory->AddItem(item);
+        }
+
+        return true;
     }
 
     /// <summary>
-    /// Return the commands saved since the expression has been cleared.
+    /// Pack a serialized vector of long into a compact byte stream: one
+    /// version byte, then every value zigzag mapped and LEB128 encoded.
+    /// Counts, opcodes and mantissa limbs are mostly small, so this is a
+    /// fraction of the size of writing each long out as four bytes.
     /// </summary>
-    vector<unsigned char> CalculatorManager::SerializeCommands()
+    /// <param name = "values">Serialized longs to pack</param>
+    vector<unsigned char> CalculatorManager::PackLongs(_In_ const vector<long>& values)
     {
-        return m_savedCommands;
+        vector<unsigned char> packed;
+        packed.reserve(values.size() + 1);
+        packed.push_back(SERIALIZED_PACK_VERSION);
+        for (long value : values)
+        {
+            unsigned long long zigzag = (static_cast<unsigned long long>(static_cast<long long>(value)) << 1)
+                ^ static_cast<unsigned long long>(static_cast<long long>(value) >> 63);
+            do
+            {
+                unsigned char lowBits = zigzag & 0x7F;
+                zigzag >>= 7;
+                packed.push_back(lowBits | (zigzag != 0 ? 0x80 : 0));
+            } while (zigzag != 0);
+        }
+        return packed;
     }
 
     /// <summary>
-    /// Replay the serialized commands
+    /// Unpack a byte stream produced by PackLongs. Returns false on an
+    /// unknown version, an overlong encoding or a stream that ends in the
+    /// middle of a value; the values decoded so far are discarded.
     /// </summary>
-    /// <param name = "serializedData">Serialized commands</param>
-    void CalculatorManager::DeSerializeCommands(_In_ const vector<unsigned char>& serializedData)
+    /// <param name = "packed">Packed byte stream</param>
+    /// <param name = "values">Receives the decoded longs</param>
+    bool CalculatorManager::TryUnpackLongs(_In_ const vector<unsigned char>& packed, _Out_ vector<long>& values)
     {
-        m_savedCommands.clear();
+        values.clear();
+        if (packed.empty() || packed[0] != SERIALIZED_PACK_VERSION)
+        {
+            return false;
+        }
 
-        for (auto commandItr = serializedData.begin(); commandItr != serializedData.end(); ++commandItr)
+        unsigned long long zigzag = 0;
+        int shift = 0;
+        for (size_t i = 1; i < packed.size(); i++)
         {
-            if (*commandItr >= MEMORY_COMMAND_TO_UNSIGNED_CHAR(MemoryCommand::MemorizeNumber) &&
-                *commandItr <= MEMORY_COMMAND_TO_UNSIGNED_CHAR(MemoryCommand::MemorizedNumberClearAll))
+            if (shift >= 64)
             {
-                // MemoryCommands(which have values above 255) are pushed on m_savedCommands upon casting to unsigned char.
-                // SerializeCommands uses m_savedCommands, which is then used in DeSerializeCommands.
-                // Hence, a simple cast to MemoryCommand is not sufficient.
-                MemoryCommand memoryCommand = static_cast<MemoryCommand>(*commandItr + UCHAR_MAX + 1);
-                unsigned int indexOfMemory = 0;
-                switch (memoryCommand)
-                {
-                case MemoryCommand::MemorizeNumber:
-                    this->MemorizeNumber();
-                    break;
-                case MemoryCommand::MemorizedNumberLoad:
-                    if (commandItr + 1 == serializedData.end())
-                    {
-                        throw out_of_range("Expecting index of memory, data ended prematurely");
-                    }
-                    indexOfMemory = *(++commandItr);
-                    this->MemorizedNumberLoad(indexOfMemory);
-                    break;
-                case MemoryCommand::MemorizedNumberAdd:
-                    if (commandItr + 1 == serializedData.end())
-                    {
-                        throw out_of_range("Expecting index of memory, data ended prematurely");
-                    }
-                    indexOfMemory = *(++commandItr);
-                    this->MemorizedNumberAdd(indexOfMemory);
-                    break;
-                case MemoryCommand::MemorizedNumberSubtract:
-                    if (commandItr + 1 == serializedData.end())
-                    {
-                        throw out_of_range("Expecting index of memory, data ended prematurely");
-                    }
-                    indexOfMemory = *(++commandItr);
-                    this->MemorizedNumberSubtract(indexOfMemory);
-                    break;
-                case MemoryCommand::MemorizedNumberClearAll:
-                    this->MemorizedNumberClearAll();
-                    break;
-                default:
-                    break;
-                }
+                values.clear();
+                return false;
             }
-            else
+            zigzag |= static_cast<unsigned long long>(packed[i] & 0x7F) << shift;
+            shift += 7;
+            if ((packed[i] & 0x80) == 0)
             {
-                this->SendCommand(static_cast<Command>(MapCommandForDeSerialize(*commandItr)));
+                long long value = static_cast<long long>(zigzag >> 1) ^ -static_cast<long long>(zigzag & 1);
+                values.push_back(static_cast<long>(value));
+                zigzag = 0;
+                shift = 0;
             }
         }
+
+        if (shift != 0) // ended on a continuation byte
+        {
+            values.clear();
+            return false;
+        }
+        return true;
+    }
+
+    /// <summary>
+    /// Fold the command journal into a checkpoint snapshot once the engine
+    /// is in a state the snapshot covers, so the journal never grows past
+    /// the compaction threshold no matter how long a session runs. The
+    /// journal is cleared first so the checkpoint embeds an empty journal
+    /// section; commands recorded afterwards are the suffix that pairs
+    /// with it.
+    /// </summary>
+    bool CalculatorManager::TryCompactSavedCommands()
+    {
+        CCalcEngine::Snapshot engineSnapshot;
+        if (!m_currentCalculatorEngine->TryGetSnapshot(engineSnapshot))
+        {
+            return false;
+        }
+
+        m_savedCommands.clear();
+        m_checkpointSnapshot = this->SerializeStateSnapshot();
+        return true;
     }
 
     /// <summary>
@@ -492,6 +1927,7 @@ namespace CalculationManager
     /// </summary>
     void CalculatorManager::MemorizeNumber()
     {
+        this->SyncWithEngineThread();
         m_savedCommands.push_back(MEMORY_COMMAND_TO_UNSIGNED_CHAR(MemoryCommand::MemorizeNumber));
 
         if (m_currentCalculatorEngine->FInErrorState())
@@ -521,6 +1957,7 @@ namespace CalculationManager
     /// <param name="indexOfMemory">Index of the target memory</param>
     void CalculatorManager::MemorizedNumberLoad(_In_ unsigned int indexOfMemory)
     {
+        this->SyncWithEngineThread();
         SaveMemoryCommand(MemoryCommand::MemorizedNumberLoad, indexOfMemory);
 
         if (m_currentCalculatorEngine->FInErrorState())
@@ -540,6 +1977,7 @@ namespace CalculationManager
     /// <param name="indexOfMemory">Index of the target memory</param>
     void CalculatorManager::MemorizedNumberAdd(_In_ unsigned int indexOfMemory)
     {
+        this->SyncWithEngineThread();
         SaveMemoryCommand(MemoryCommand::MemorizedNumberAdd, indexOfMemory);
 
         if (m_currentCalculatorEngine->FInErrorState())
@@ -558,7 +1996,7 @@ namespace CalculationManager
 
             this->MemorizedNumberChanged(indexOfMemory);
 
-            this->SetMemorizedNumbersString();
+            this->SetMemorizedNumberString(indexOfMemory);
         }
 
         m_displayCallback->MemoryItemChanged(indexOfMemory);
@@ -566,6 +2004,7 @@ namespace CalculationManager
 
     void CalculatorManager::MemorizedNumberClear(_In_ unsigned int indexOfMemory)
     {
+        this->SyncWithEngineThread();
         if (indexOfMemory < m_memorizedNumbers.size())
         {
             SaveMemoryCommand(MemoryCommand::MemorizedNumberClear, indexOfMemory);
@@ -581,6 +2020,7 @@ namespace CalculationManager
     /// <param name="indexOfMemory">Index of the target memory</param>
     void CalculatorManager::MemorizedNumberSubtract(_In_ unsigned int indexOfMemory)
     {
+        this->SyncWithEngineThread();
         SaveMemoryCommand(MemoryCommand::MemorizedNumberSubtract, indexOfMemory);
 
         if (m_currentCalculatorEngine->FInErrorState())
@@ -602,7 +2042,7 @@ namespace CalculationManager
 
             this->MemorizedNumberChanged(indexOfMemory);
 
-            this->SetMemorizedNumbersString();
+            this->SetMemorizedNumberString(indexOfMemory);
         }
 
         m_displayCallback->MemoryItemChanged(indexOfMemory);
@@ -614,6 +2054,7 @@ namespace CalculationManager
     /// </summary>
     void CalculatorManager::MemorizedNumberClearAll()
     {
+        this->SyncWithEngineThread();
         m_savedCommands.push_back(MEMORY_COMMAND_TO_UNSIGNED_CHAR(MemoryCommand::MemorizedNumberClearAll));
         m_memorizedNumbers.clear();
 
@@ -668,11 +2109,13 @@ namespace CalculationManager
 
     vector<shared_ptr<HISTORYITEM>> const& CalculatorManager::GetHistoryItems()
     {
+        this->SyncWithEngineThread();
         return m_pHistory->GetHistory();
     }
 
     vector<shared_ptr<HISTORYITEM>> const& CalculatorManager::GetHistoryItems(_In_ CALCULATOR_MODE mode)
     {
+        this->SyncWithEngineThread();
         return (mode == CM_STD) ?
             m_pStdHistory->GetHistory() :
             m_pSciHistory->GetHistory();
@@ -680,26 +2123,61 @@ namespace CalculationManager
 
     shared_ptr<HISTORYITEM> const& CalculatorManager::GetHistoryItem(_In_ unsigned int uIdx)
     {
+        this->SyncWithEngineThread();
         return m_pHistory->GetHistoryItem(uIdx);
     }
 
+    /// <summary>
+    /// Substring search over the current mode's history, answered from the
+    /// trigram index. Returns the matching indices into GetHistoryItems order.
+    /// </summary>
+    /// <param name="query">Text to find in item expressions or results</param>
+    vector<unsigned int> CalculatorManager::SearchHistory(wstring_view query)
+    {
+        this->SyncWithEngineThread();
+        return m_pHistory->Search(query);
+    }
+
     void CalculatorManager::OnHistoryItemAdded(_In_ unsigned int addedItemIndex)
     {
+        // Publish the completed item so other windows can adopt it. This
+        // runs once per finished equation (possibly on the engine thread),
+        // never per keystroke, so the shared writer mutex stays off the
+        // calculation path.
+        CALCULATOR_MODE mode = CurrentHistoryMode();
+        m_sharedHistoryGenerationSeen[mode].store(
+            SharedHistoryStore::GetInstance().Publish(mode, m_pHistory->GetHistoryItem(addedItemIndex)), memory_order_release);
         m_displayCallback->OnHistoryItemAdded(addedItemIndex);
     }
 
     bool CalculatorManager::RemoveHistoryItem(_In_ unsigned int uIdx)
     {
-        return m_pHistory->RemoveItem(uIdx);
+        this->SyncWithEngineThread();
+        shared_ptr<HISTORYITEM> removedItem;
+        if (uIdx < m_pHistory->GetHistory().size())
+        {
+            removedItem = m_pHistory->GetHistoryItem(uIdx);
+        }
+        bool removed = m_pHistory->RemoveItem(uIdx);
+        if (removed && removedItem != nullptr)
+        {
+            CALCULATOR_MODE mode = CurrentHistoryMode();
+            m_sharedHistoryGenerationSeen[mode].store(SharedHistoryStore::GetInstance().Remove(mode, removedItem), memory_order_release);
+        }
+        return removed;
     }
 
     void CalculatorManager::ClearHistory()
     {
+        this->SyncWithEngineThread();
         m_pHistory->ClearHistory();
+        CALCULATOR_MODE mode = CurrentHistoryMode();
+        m_sharedHistoryGenerationSeen[mode].store(SharedHistoryStore::GetInstance().Clear(mode), memory_order_release);
     }
 
     void CalculatorManager::SetRadix(RADIX_TYPE iRadixType)
     {
+        this->SyncWithEngineThread();
         switch (iRadixType)
         {
         case RADIX_TYPE::HEX_RADIX:
@@ -720,8 +2198,30 @@ namespace CalculationManager
         SetMemorizedNumbersString();
     }
 
+    /// <summary>
+    /// Return the radix the current engine is displaying in, as a radix
+    /// type. Lets the client align its radix selection UI with a
+    /// programmer engine that kept its base across a mode switch.
+    /// </summary>
+    RADIX_TYPE CalculatorManager::GetCurrentRadixType()
+    {
+        this->SyncWithEngineThread();
+        switch (m_currentCalculatorEngine != nullptr ? m_currentCalculatorEngine->GetCurrentRadix() : 10)
+        {
+        case 16:
+            return RADIX_TYPE::HEX_RADIX;
+        case 8:
+            return RADIX_TYPE::OCT_RADIX;
+        case 2:
+            return RADIX_TYPE::BIN_RADIX;
+        default:
+            return RADIX_TYPE::DEC_RADIX;
+        }
+    }
+
     void CalculatorManager::SetMemorizedNumbersString()
     {
+        this->SyncWithEngineThread();
         vector<wstring> resultVector;
         for (auto const& memoryItem : m_memorizedNumbers)
         {
@@ -736,8 +2236,32 @@ namespace CalculationManager
         m_displayCallback->SetMemorizedNumbers(resultVector);
     }
 
+    /// <summary>
+    /// Refresh the display string for a single memorized number, for
+    /// operations that change one slot in place (M+/M-). Additions,
+    /// removals and radix changes go through SetMemorizedNumbersString.
+    /// </summary>
+    /// <param name="indexOfMemory">Index of the target memory</param>
+    void CalculatorManager::SetMemorizedNumberString(_In_ unsigned int indexOfMemory)
+    {
+        this->SyncWithEngineThread();
+        if (indexOfMemory >= m_memorizedNumbers.size())
+        {
+            return;
+        }
+
+        int radix = m_currentCalculatorEngine->GetCurrentRadix();
+        wstring stringValue = m_currentCalculatorEngine->GetStringForDisplay(m_memorizedNumbers.at(indexOfMemory), radix);
+
+        if (!stringValue.empty())
+        {
+            m_displayCallback->SetMemorizedNumber(indexOfMemory, m_currentCalculatorEngine->GroupDigitsPerRadix(stringValue, radix));
+        }
+    }
+
     CalculationManager::Command CalculatorManager::GetCurrentDegreeMode()
     {
+        this->SyncWithEngineThread();
         if (m_currentDegreeMode == Command::CommandNULL)
         {
             m_currentDegreeMode = Command::CommandDEG;
@@ -747,6 +2271,7 @@ namespace CalculationManager
 
     void CalculatorManager::SetHistory(_In_ CALCULATOR_MODE eMode, _In_ vector<shared_ptr<HISTORYITEM>> const& history)
     {
+        this->SyncWithEngineThread();
         CalculatorHistory* pHistory = nullptr;
 
         switch (eMode)
@@ -767,35 +2292,102 @@ namespace CalculationManager
                 pHistory->AddItem(history[i]);
             }
         }
+
+        // The first window to restore the journal seeds the shared store;
+        // later windows restoring the same journal adopt whatever has been
+        // published since through SyncHistoryFromShared instead.
+        if (SharedHistoryStore::GetInstance().SeedIfEmpty(eMode, history))
+        {
+            m_sharedHistoryGenerationSeen[eMode].store(SharedHistoryStore::GetInstance().Generation(eMode), memory_order_release);
+        }
+    }
+
+    bool CalculatorManager::SyncHistoryFromShared(_In_ CALCULATOR_MODE eMode)
+    {
+        SharedHistoryStore& store = SharedHistoryStore::GetInstance();
+        unsigned int generation = store.Generation(eMode);
+        if (generation == m_sharedHistoryGenerationSeen[eMode].load(memory_order_acquire))
+        {
+            return false;
+        }
+
+        SharedHistoryStore::Snapshot snapshot = store.GetSnapshot(eMode);
+        if (snapshot != nullptr)
+        {
+            SetHistory(eMode, *snapshot);
+        }
+        // Record the generation read before the copy; a publication racing
+        // with the adoption just leaves the next sync something to fold in.
+        m_sharedHistoryGenerationSeen[eMode].store(generation, memory_order_release);
+        return true;
     }
 
     wstring CalculatorManager::GetResultForRadix(uint32_t radix, int32_t precision)
     {
+        this->SyncWithEngineThread();
         return m_currentCalculatorEngine ? m_currentCalculatorEngine->GetCurrentResultForRadix(radix, precision) : L"";
     }
 
+    CCalcEngine::RadixDisplays CalculatorManager::GetAllRadixDisplays(int32_t precision)
+    {
+        this->SyncWithEngineThread();
+        return m_currentCalculatorEngine ? m_currentCalculatorEngine->GetAllRadixDisplays(precision) : CCalcEngine::RadixDisplays{};
+    }
+
     void CalculatorManager::SetPrecision(int32_t precision)
     {
+        this->SyncWithEngineThread();
         m_currentCalculatorEngine->ChangePrecision(precision);
     }
 
+    /// <summary>
+    /// Put the current engine in extended-precision mode: computation and
+    /// display carry the requested number of significant digits.  The
+    /// request is clamped to the supported range.  Switching the calculator
+    /// mode afterwards restores that mode's standard precision.
+    /// </summary>
+    /// <param name="digits">requested significant digits</param>
+    void CalculatorManager::SetExtendedPrecision(int32_t digits)
+    {
+        this->SyncWithEngineThread();
+        digits = max(digits, static_cast<int32_t>(CalculatorPrecision::ExtendedModePrecisionMin));
+        digits = min(digits, static_cast<int32_t>(CalculatorPrecision::ExtendedModePrecisionMax));
+        m_currentCalculatorEngine->ChangePrecision(digits);
+    }
+
+    /// <summary>
+    /// Bound how many threads high-precision series evaluation may use.
+    /// Zero selects the hardware thread count; one (the default) keeps
+    /// computation single threaded.
+    /// </summary>
+    /// <param name="maxThreads">maximum worker threads</param>
+    void CalculatorManager::SetComputeConcurrency(uint32_t maxThreads)
+    {
+        this->SyncWithEngineThread();
+        ChangeSeriesConcurrency(maxThreads);
+    }
+
     void CalculatorManager::UpdateMaxIntDigits()
     {
+        this->SyncWithEngineThread();
         m_currentCalculatorEngine->UpdateMaxIntDigits();
     }
 
     wchar_t CalculatorManager::DecimalSeparator()
     {
+        this->SyncWithEngineThread();
         return m_currentCalculatorEngine ? m_currentCalculatorEngine->DecimalSeparator() : m_resourceProvider->GetCEngineString(L"sDecimal")[0];
     }
 
     bool CalculatorManager::IsEngineRecording()
     {
+        this->SyncWithEngineThread();
         return m_currentCalculatorEngine->FInRecordingState() ? true : false;
     }
 
     void CalculatorManager::SetInHistoryItemLoadMode(_In_ bool isHistoryItemLoadMode)
     {
+        this->SyncWithEngineThread();
         m_inHistoryItemLoadMode = isHistoryItemLoadMode;
     }
 
@@ -839,6 +2431,34 @@ namespace CalculationManager
         return Rational(p, q);
     }
 
+    /// <summary>
+    /// Bounds-checked companion to DeSerializeRational for data that
+    /// arrives from outside the process. On success the Rational is read
+    /// and iStream advances past it; on truncated or malformed data false
+    /// is returned with iStream unchanged.
+    /// </summary>
+    bool CalculatorManager::TryDeSerializeRational(_In_ const vector<long>& stream, _Inout_ size_t& iStream, _Out_ Rational& rat)
+    {
+        size_t iNext = iStream;
+        for (int iNumber = 0; iNumber < 2; iNumber++)
+        {
+            if (iNext + SERIALIZED_NUMBER_MINSIZE > stream.size())
+            {
+                return false;
+            }
+            long mantissaSize = stream[iNext + 1];
+            if (mantissaSize < 0 || static_cast<size_t>(mantissaSize) > stream.size() - iNext - SERIALIZED_NUMBER_MINSIZE)
+            {
+                return false;
+            }
+            iNext += SERIALIZED_NUMBER_MINSIZE + static_cast<size_t>(mantissaSize);
+        }
+
+        rat = DeSerializeRational(stream.begin() + iStream);
+        iStream = iNext;
+        return true;
+    }
+
     /// <summary>
     /// Serialize Number to vector of long
     /// How Number is saved :
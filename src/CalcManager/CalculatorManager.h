@@ -3,7 +3,13 @@
 
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 #include "CalculatorHistory.h"
+#include "CommandQueue.h"
 #include "Header Files/CalcEngine.h"
 #include "Header Files/Rational.h"
 #include "Header Files/ICalcDisplay.h"
@@ -24,7 +30,9 @@ namespace CalculationManager
     {
         StandardModePrecision = 16,
         ScientificModePrecision = 32,
-        ProgrammerModePrecision = 64
+        ProgrammerModePrecision = 64,
+        ExtendedModePrecisionMin = 1000,
+        ExtendedModePrecisionMax = 10000
     };
 
     // Numbering continues from the Enum Command from Command.h
@@ -62,6 +70,13 @@ namespace CalculationManager
 
         // For persistence
         std::vector<unsigned char> m_savedCommands;
+        // State snapshot taken when the command journal was last compacted,
+        // with an empty journal section. m_savedCommands then holds only the
+        // commands recorded after it; the pair restores what the dropped
+        // prefix used to. Empty when no compaction has happened since the
+        // last expression boundary.
+        std::vector<long> m_checkpointSnapshot;
+        bool TryCompactSavedCommands();
         std::vector<long> m_savedPrimaryValue;
         std::vector<long> m_serializedMemory;
         std::vector<long> m_currentSerializedMemory;
@@ -79,6 +94,7 @@ namespace CalculationManager
 
         static std::vector<long> SerializeRational(CalcEngine::Rational const& rat);
         static CalcEngine::Rational DeSerializeRational(std::vector<long>::const_iterator itr);
+        static bool TryDeSerializeRational(_In_ const std::vector<long>& stream, _Inout_ size_t& iStream, _Out_ CalcEngine::Rational& rat);
 
         static std::vector<long> SerializeNumber(CalcEngine::Number const& num);
         static CalcEngine::Number DeSerializeNumber(std::vector<long>::const_iterator itr);
@@ -87,6 +103,100 @@ namespace CalculationManager
         std::shared_ptr<CalculatorHistory> m_pSciHistory;
         CalculatorHistory* m_pHistory;
 
+        // Last SharedHistoryStore generation this manager has folded in (or
+        // produced itself), per mode, so SyncHistoryFromShared is one atomic
+        // compare when no other window published. Atomic because additions
+        // publish from the engine thread while syncs run on the caller's.
+        std::atomic<unsigned int> m_sharedHistoryGenerationSeen[2] = {};
+        CALCULATOR_MODE CurrentHistoryMode() const
+        {
+            return m_pHistory == m_pSciHistory.get() ? CM_SCI : CM_STD;
+        }
+
+        // While SendCommands processes a batch, the per-keystroke display
+        // callbacks below latch their latest arguments here instead of
+        // forwarding, and FlushBatchedDisplay emits each display once.
+        bool m_batchedCommandMode;
+        bool m_batchedPrimaryPending;
+        std::wstring m_batchedPrimaryDisplay;
+        bool m_batchedPrimaryIsError;
+        bool m_batchedExpressionPending;
+        std::shared_ptr<CalculatorVector<std::pair<std::wstring, int>>> m_batchedExpressionTokens;
+        std::shared_ptr<CalculatorVector<std::shared_ptr<IExpressionCommand>>> m_batchedExpressionCommands;
+        bool m_batchedParenPending;
+        std::wstring m_batchedParenText;
+        bool m_batchedErrorPending;
+        bool m_batchedIsInError;
+        void FlushBatchedDisplay();
+        void SendCommandWorker(_In_ Command command);
+        void SendCommandRunWorker(_In_ Command command, uint32_t count);
+
+        // Background execution: when enabled, SendCommand/SendCommands hand
+        // their commands to a dedicated engine thread through the SPSC ring
+        // below instead of running them inline, so long computations never
+        // stall the calling (UI) thread. The engine thread drains the ring
+        // in bursts and forwards each burst's display state as one
+        // Begin/EndDisplayTransaction. Every other public entry point first
+        // waits for the ring to drain, so callers still observe the
+        // synchronous contract. Off by default; behavior is then unchanged.
+        static const size_t m_commandQueueCapacity = 512;
+        CommandQueue<Command, m_commandQueueCapacity> m_commandQueue;
+        std::thread m_engineThread;
+        std::atomic<bool> m_engineThreadActive;
+        std::atomic<size_t> m_commandsQueued;
+        std::atomic<size_t> m_commandsExecuted;
+        std::mutex m_engineThreadMutex;
+        std::condition_variable m_engineWake;
+        std::condition_variable m_engineDrained;
+        void EngineThreadProc();
+        void SyncWithEngineThread();
+        bool OnEngineThread() const;
+
+        // Set by CancelComputation, polled by the ratpak checkpoints armed
+        // at the start of each command, and cleared when the next command
+        // starts. The heartbeat below is the ratpak progress hook; it
+        // forwards to the display callback on the computing thread.
+        std::atomic<bool> m_computationCancelled;
+        static void ComputationProgressHeartbeat(void* pContext, uint32_t cIterations);
+
+        // Replay memoization: DeSerializeCommands caches the state snapshot
+        // that an identical command stream, replayed from an identical
+        // starting state under identical settings (mode, radix, precision,
+        // degree mode), produced before - so re-running the same journal is
+        // a snapshot restore instead of a command-by-command replay. Keys
+        // carry the settings stamp, so a changed setting simply misses and
+        // the stale entry ages out of the small LRU.
+        struct MemoCacheEntry
+        {
+            size_t commandsHash;
+            std::vector<unsigned char> commands;
+            size_t settingsStamp;
+            size_t preStateHash;
+            std::vector<long> snapshot;
+            size_t lastUse;
+        };
+        static const size_t m_memoCacheCapacity = 16;
+        std::vector<MemoCacheEntry> m_memoCache;
+        size_t m_memoCacheUseCounter;
+        size_t MemoCacheSettingsStamp();
+
+        // The three engine flavors a manager can host, used as warm pool
+        // slot indices. The flavor fixes the constructor arguments: only
+        // standard ignores operator precedence, only programmer is integer.
+        enum class WarmEngineFlavor
+        {
+            Standard = 0,
+            Scientific = 1,
+            Programmer = 2,
+        };
+        std::unique_ptr<CCalcEngine> CreateEngine(_In_ WarmEngineFlavor flavor, _In_ std::shared_ptr<IHistoryDisplay> const& pHistoryDisplay);
+        void ActivateEngine(_In_ CCalcEngine* engine);
+        static void TrimWarmEnginePool();
+
+        // Set by TrimMemory, consumed by the engine thread on its next
+        // wake so that thread's ratpak free lists get released too.
+        std::atomic<bool> m_engineTrimRequested;
+
     public:
         // ICalcDisplay
         void SetPrimaryDisplay(_In_ const std::wstring& displayString, _In_ bool isError) override;
@@ -110,15 +220,45 @@ namespace CalculationManager
         void SetScientificMode();
         void SetProgrammerMode();
         void SendCommand(_In_ Command command);
+        void SendCommands(_In_ const std::vector<Command>& commands);
+        void SendCommandRun(_In_ Command command, uint32_t count);
+        void SetBackgroundExecution(bool enable);
+        void CancelComputation();
+        // Releases caches and pooled allocations that only exist for burst
+        // performance: the replay memo cache, the engines' display caches,
+        // the warm engine pool and the ratpak per-thread free lists. Called
+        // on platform memory-pressure notifications; everything released
+        // here rebuilds on demand.
+        void TrimMemory();
+        static void PrewarmEngines();
+        static void SetDiagnosticsEnabled(bool enable);
+        static bool DiagnosticsEnabled();
+        static RATPAK_STATS GetDiagnostics();
+        static void ResetDiagnostics();
+        // Hit/lookup counters for the replay memo cache. Process-wide relaxed
+        // atomics like the ratpak counters, so the diagnostics view shows one
+        // hit rate across every window's manager.
+        struct MEMO_CACHE_STATS
+        {
+            uint64_t cLookups;
+            uint64_t cHits;
+        };
+        static MEMO_CACHE_STATS GetMemoCacheStats();
         std::vector<unsigned char> SerializeCommands();
         void DeSerializeCommands(_In_ const std::vector<unsigned char>& serializedData);
         void SerializeMemory();
         std::vector<long> GetSerializedMemory();
         void DeSerializeMemory(const std::vector<long> &serializedMemory);
+        bool TryDeSerializeMemory(const std::vector<long> &serializedMemory);
         void SerializePrimaryDisplay();
         std::vector<long> GetSerializedPrimaryDisplay();
         void DeSerializePrimaryDisplay(const std::vector<long> &serializedPrimaryDisplay);
         Command SerializeSavedDegreeMode();
+        std::vector<long> SerializeStateSnapshot();
+        bool DeSerializeStateSnapshot(_In_ const std::vector<long>& serializedSnapshot);
+        bool CloneStateFrom(_In_ CalculatorManager& other);
+        static std::vector<unsigned char> PackLongs(_In_ const std::vector<long>& values);
+        static bool TryUnpackLongs(_In_ const std::vector<unsigned char>& packed, _Out_ std::vector<long>& values);
 
         void MemorizeNumber();
         void MemorizedNumberLoad(_In_ unsigned int);
@@ -128,22 +268,32 @@ namespace CalculationManager
         void MemorizedNumberClearAll();
 
         bool IsEngineRecording();
-        std::vector<unsigned char> GetSavedCommands(){ return m_savedCommands; }
+        std::vector<unsigned char> GetSavedCommands(){ SyncWithEngineThread(); return m_savedCommands; }
         void SetRadix(RADIX_TYPE iRadixType);
+        RADIX_TYPE GetCurrentRadixType();
         void SetMemorizedNumbersString();
+        void SetMemorizedNumberString(_In_ unsigned int indexOfMemory);
         std::wstring GetResultForRadix(uint32_t radix, int32_t precision);
+        CCalcEngine::RadixDisplays GetAllRadixDisplays(int32_t precision);
         void SetPrecision(int32_t precision);
+        void SetExtendedPrecision(int32_t digits);
+        void SetComputeConcurrency(uint32_t maxThreads);
         void UpdateMaxIntDigits();
         wchar_t DecimalSeparator();
 
         std::vector<std::shared_ptr<HISTORYITEM>> const& GetHistoryItems();
         std::vector<std::shared_ptr<HISTORYITEM>> const& GetHistoryItems(_In_ CalculationManager::CALCULATOR_MODE mode);
         std::shared_ptr<HISTORYITEM> const& GetHistoryItem(_In_ unsigned int uIdx);
+        std::vector<unsigned int> SearchHistory(std::wstring_view query);
         bool RemoveHistoryItem(_In_ unsigned int uIdx);
         void ClearHistory();
         size_t MaxHistorySize() const { return m_pHistory->MaxHistorySize(); }
         CalculationManager::Command GetCurrentDegreeMode();
         void SetHistory(_In_ CALCULATOR_MODE eMode, _In_ std::vector<std::shared_ptr<HISTORYITEM>> const& history);
+        // Folds history other windows published to the SharedHistoryStore
+        // into this manager's list for the given mode. One atomic read when
+        // nothing changed; returns true when items were adopted.
+        bool SyncHistoryFromShared(_In_ CALCULATOR_MODE eMode);
         void SetInHistoryItemLoadMode(_In_ bool isHistoryItemLoadMode);
     };
 }
@@ -9,6 +9,22 @@ template <typename TType>
 class CalculatorVector
 {
 public:
+    // Direct access for consumers that walk the whole container: the
+    // serializers and display loops pay per-element HRESULT checks for
+    // nothing, since they iterate strictly within the size they just
+    // read. The checked accessors below remain for random access.
+    using iterator = typename std::vector<TType>::iterator;
+    using const_iterator = typename std::vector<TType>::const_iterator;
+
+    iterator begin() { return m_vector.begin(); }
+    iterator end() { return m_vector.end(); }
+    const_iterator begin() const { return m_vector.begin(); }
+    const_iterator end() const { return m_vector.end(); }
+
+    TType* data() { return m_vector.data(); }
+    const TType* data() const { return m_vector.data(); }
+    size_t size() const { return m_vector.size(); }
+
     ResultCode GetAt(_In_opt_ unsigned int index, _Out_ TType *item)
     {
         ResultCode hr = S_OK;
@@ -92,7 +108,38 @@ public:
         ResultCode hr = S_OK;
         try
         {
-            m_vector.push_back(item);
+            m_vector.push_back(std::move(item));
+        }
+        catch (const std::bad_alloc& /*ex*/)
+        {
+            hr = E_OUTOFMEMORY;
+        }
+        return hr;
+    }
+
+    // Construct in place, for appends that would otherwise build a
+    // temporary just to copy it in (token pairs, command pointers).
+    template <typename... TArgs>
+    ResultCode EmplaceBack(TArgs&&... args)
+    {
+        ResultCode hr = S_OK;
+        try
+        {
+            m_vector.emplace_back(std::forward<TArgs>(args)...);
+        }
+        catch (const std::bad_alloc& /*ex*/)
+        {
+            hr = E_OUTOFMEMORY;
+        }
+        return hr;
+    }
+
+    ResultCode Reserve(_In_ size_t capacity)
+    {
+        ResultCode hr = S_OK;
+        try
+        {
+            m_vector.reserve(capacity);
         }
         catch (const std::bad_alloc& /*ex*/)
         {
@@ -116,33 +163,23 @@ public:
     ResultCode GetString(_Out_ std::wstring* expression)
     {
         ResultCode hr = S_OK;
-        unsigned int nTokens = 0;
-        std::pair <std::wstring, int> currentPair;
-        hr = this->GetSize(&nTokens);
-        if (SUCCEEDED(hr))
+        for (auto iter = m_vector.begin(); iter != m_vector.end(); ++iter)
         {
-            for (unsigned int i = 0; i < nTokens; i++)
-            {
-                hr = this->GetAt(i, &currentPair);
-                if (SUCCEEDED(hr))
-                {
-                    expression->append(currentPair.first);
-
-                    if (i != (nTokens - 1))
-                    {
-                        expression->append(L" ");
-                    }
-                }
-            }
+            expression->append(iter->first);
 
-            std::wstring expressionSuffix{};
-            hr = GetExpressionSuffix(&expressionSuffix);
-            if (SUCCEEDED(hr))
+            if (iter + 1 != m_vector.end())
             {
-                expression->append(expressionSuffix);
+                expression->append(L" ");
             }
         }
 
+        std::wstring expressionSuffix{};
+        hr = GetExpressionSuffix(&expressionSuffix);
+        if (SUCCEEDED(hr))
+        {
+            expression->append(expressionSuffix);
+        }
+
         return hr;
     }
 
@@ -0,0 +1,78 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace CalculationManager
+{
+    // Fixed-capacity single-producer/single-consumer ring. One thread may
+    // push and one other thread may pop, with no lock on either side: the
+    // producer owns the tail index, the consumer owns the head index, and
+    // each publishes its own index with a release store that the other reads
+    // with an acquire load. Capacity must be a power of two so the indices
+    // can grow monotonically and wrap by masking.
+    //
+    // This backs the manager's background execution mode, where the UI
+    // thread feeds keystrokes to a dedicated engine thread. Neither side
+    // blocks in the queue itself; the caller decides what a full or empty
+    // queue means (the producer yields, the consumer goes to sleep).
+    template <typename TType, size_t TCapacity>
+    class CommandQueue
+    {
+        static_assert((TCapacity & (TCapacity - 1)) == 0, "CommandQueue capacity must be a power of two");
+
+    public:
+        CommandQueue() :
+            m_head(0),
+            m_tail(0)
+        {
+        }
+
+        // Producer side. Returns false when the ring is full; the item is
+        // untouched and the producer can retry after the consumer catches up.
+        bool TryPush(const TType& item)
+        {
+            size_t tail = m_tail.load(std::memory_order_relaxed);
+            if (tail - m_head.load(std::memory_order_acquire) == TCapacity)
+            {
+                return false;
+            }
+
+            m_ring[tail & (TCapacity - 1)] = item;
+            m_tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Consumer side. Returns false when the ring is empty.
+        bool TryPop(_Out_ TType& item)
+        {
+            size_t head = m_head.load(std::memory_order_relaxed);
+            if (head == m_tail.load(std::memory_order_acquire))
+            {
+                return false;
+            }
+
+            item = m_ring[head & (TCapacity - 1)];
+            m_head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Snapshot only: the answer can change under either caller's feet,
+        // so use it for wakeup predicates, not for deciding a pop is safe.
+        bool IsEmpty() const
+        {
+            return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+        }
+
+    private:
+        TType m_ring[TCapacity];
+
+        // The indices live on their own cache lines so the producer's tail
+        // stores do not bounce the consumer's head line and vice versa.
+        alignas(64) std::atomic<size_t> m_head;
+        alignas(64) std::atomic<size_t> m_tail;
+    };
+}
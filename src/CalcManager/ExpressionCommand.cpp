@@ -108,6 +108,7 @@ void COpndCommand::Initialize(Rational const& rat)
 {
     m_value = rat;
     m_fInitialized = true;
+    m_cachedStrRadix = 0;
 }
 
 const shared_ptr<CalculatorVector<int>> & COpndCommand::GetCommands() const
@@ -122,8 +123,6 @@ void COpndCommand::SetCommands(shared_ptr<CalculatorVector<int>> const& commands
 
 void COpndCommand::AppendCommand(int command)
 {
-    unsigned int nCommands;
-    m_commands->GetSize(&nCommands);
     if (m_fSciFmt)
     {
         ClearAllAndAppendCommand(static_cast<CalculationManager::Command>(command));
@@ -140,14 +139,8 @@ void COpndCommand::AppendCommand(int command)
 
 void COpndCommand::ToggleSign()
 {
-    unsigned int commandCount;
-    m_commands->GetSize(&commandCount);
-
-    for (unsigned int i = 0; i < commandCount; i++)
+    for (int nOpCode : *m_commands)
     {
-        int nOpCode;
-        m_commands->GetAt(i, &nOpCode);
-
         if (nOpCode != IDC_0)
         {
             m_fNegative = !m_fNegative;
@@ -217,14 +210,13 @@ const wstring & COpndCommand::GetToken(wchar_t decimalSymbol)
 {
     static const wchar_t chZero = L'0';
 
-    unsigned int nCommands;
-    m_commands->GetSize(&nCommands);
+    const int* commands = m_commands->data();
+    size_t nCommands = m_commands->size();
     m_token.clear();
-    int nOpCode;
 
-    for (unsigned int i = 0; i < nCommands; i++)
+    for (size_t i = 0; i < nCommands; i++)
     {
-        m_commands->GetAt(i, &nOpCode);
+        int nOpCode = commands[i];
         if (nOpCode == IDC_PNT)
         {
             m_token.append(wstring{ decimalSymbol });
@@ -232,9 +224,7 @@ const wstring & COpndCommand::GetToken(wchar_t decimalSymbol)
         else if (nOpCode == IDC_EXP)
         {
             m_token.append(&chExp);
-            int nextOpCode;
-            m_commands->GetAt(i + 1, &nextOpCode);
-            if (nextOpCode != IDC_SIGN)
+            if (i + 1 == nCommands || commands[i + 1] != IDC_SIGN)
             {
                 m_token.append(&chPlus);
             }
@@ -289,14 +279,19 @@ const wstring & COpndCommand::GetToken(wchar_t decimalSymbol)
 
 wstring COpndCommand::GetString(uint32_t radix, int32_t precision)
 {
-    wstring result{};
+    if (!m_fInitialized)
+    {
+        return wstring{};
+    }
 
-    if (m_fInitialized)
+    if (radix != m_cachedStrRadix || precision != m_cachedStrPrecision)
     {
-        result = m_value.ToString(radix, eNUMOBJ_FMT::FMT_FLOAT, precision);
+        m_cachedStr = m_value.ToString(radix, eNUMOBJ_FMT::FMT_FLOAT, precision);
+        m_cachedStrRadix = radix;
+        m_cachedStrPrecision = precision;
     }
 
-    return result;
+    return m_cachedStr;
 }
 
 void COpndCommand::Accept(_In_ ISerializeCommandVisitor &commandVisitor)
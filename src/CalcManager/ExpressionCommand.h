@@ -77,6 +77,15 @@ private:
     bool m_fInitialized;
     std::wstring m_token;
     CalcEngine::Rational m_value;
+
+    // Rendering m_value is a full ratpak conversion, and history assembly
+    // asks for the same radix and precision repeatedly, so keep the last
+    // rendering. A radix of 0 marks the cache empty; m_value only changes
+    // through Initialize, which resets it.
+    uint32_t m_cachedStrRadix = 0;
+    int32_t m_cachedStrPrecision = 0;
+    std::wstring m_cachedStr;
+
     void ClearAllAndAppendCommand(CalculationManager::Command command);
 };
 
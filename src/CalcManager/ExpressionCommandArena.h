@@ -0,0 +1,119 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include <memory>
+#include <vector>
+
+// Monotonic allocation arena for expression command nodes. Building an
+// expression allocates one IExpressionCommand node (plus its operand digit
+// vector) per keystroke through make_shared, which scatters the command
+// graph and its refcount blocks across the heap. Nodes made through
+// Make() instead come from large contiguous blocks, with the object and
+// its shared_ptr control block placed together by allocate_shared, so
+// walking the graph in the serializer and the history recall path stays
+// cache local and per-node heap traffic disappears.
+//
+// The arena is monotonic: Deallocate is a no-op and nothing is reclaimed
+// until the backing state dies. Every allocator copy (and therefore every
+// control block it created) shares ownership of that state, so nodes may
+// outlive the arena handle itself — history items keep their command
+// vectors valid after the collector has moved on to a fresh arena.
+class CExpressionCommandArena
+{
+private:
+    struct ArenaState
+    {
+        static constexpr size_t BLOCK_SIZE = 4096;
+        std::vector<std::unique_ptr<unsigned char[]>> blocks;
+        unsigned char* pbBump = nullptr; // current bump block, nullptr until the first Allocate
+        size_t cbBlockUsed = 0; // offset of the next free byte in the bump block
+
+        void* Allocate(size_t cb, size_t alignment)
+        {
+            // Oversized requests get a dedicated block, leaving the
+            // current bump block untouched.
+            if (cb > BLOCK_SIZE)
+            {
+                blocks.push_back(std::make_unique<unsigned char[]>(cb));
+                return blocks.back().get();
+            }
+
+            size_t ib = (cbBlockUsed + (alignment - 1)) & ~(alignment - 1);
+            if (pbBump == nullptr || ib + cb > BLOCK_SIZE)
+            {
+                blocks.push_back(std::make_unique<unsigned char[]>(BLOCK_SIZE));
+                pbBump = blocks.back().get();
+                ib = 0;
+            }
+            cbBlockUsed = ib + cb;
+            return pbBump + ib;
+        }
+    };
+
+    std::shared_ptr<ArenaState> m_state;
+
+public:
+    CExpressionCommandArena() : m_state(std::make_shared<ArenaState>())
+    {
+    }
+
+    // Minimal std allocator over the arena. Copies share ownership of the
+    // arena state, which is what keeps allocate_shared nodes valid for as
+    // long as any shared_ptr to them exists.
+    template <typename T>
+    class Allocator
+    {
+    public:
+        using value_type = T;
+
+        explicit Allocator(std::shared_ptr<ArenaState> state) : m_state(std::move(state))
+        {
+        }
+
+        template <typename U>
+        Allocator(Allocator<U> const& other) : m_state(other.m_state)
+        {
+        }
+
+        T* allocate(size_t n)
+        {
+            return static_cast<T*>(m_state->Allocate(n * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T*, size_t)
+        {
+            // Monotonic: memory is reclaimed when the arena state dies.
+        }
+
+        template <typename U>
+        bool operator==(Allocator<U> const& other) const
+        {
+            return m_state == other.m_state;
+        }
+
+        template <typename U>
+        bool operator!=(Allocator<U> const& other) const
+        {
+            return m_state != other.m_state;
+        }
+
+    private:
+        template <typename U>
+        friend class Allocator;
+        std::shared_ptr<ArenaState> m_state;
+    };
+
+    template <typename T, typename... Args>
+    std::shared_ptr<T> Make(Args&&... args)
+    {
+        return std::allocate_shared<T>(Allocator<T>(m_state), std::forward<Args>(args)...);
+    }
+
+    // Start a fresh arena for the next expression. Existing nodes keep the
+    // old state (and its blocks) alive through their allocators.
+    void Reset()
+    {
+        m_state = std::make_shared<ArenaState>();
+    }
+};
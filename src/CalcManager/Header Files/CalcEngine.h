@@ -14,6 +14,11 @@
 *
 \****************************************************************************/
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 #include "CCommand.h"
 #include "EngineStrings.h"
 #include "../Command.h"
@@ -53,7 +58,12 @@ namespace CalculatorUnitTests
 class CCalcEngine {
 public:
     CCalcEngine(bool fPrecedence, bool fIntegerMode, CalculationManager::IResourceProvider* const pResourceProvider, __in_opt ICalcDisplay *pCalcDisplay, __in_opt std::shared_ptr<IHistoryDisplay> pHistoryDisplay);
+    ~CCalcEngine();
     void ProcessCommand(OpCode wID);
+    // Processes count repetitions of one keystroke. Backspace and digit
+    // runs while recording collapse into a single input edit and one
+    // display refresh; every other command repeats through ProcessCommand.
+    void ProcessCommandRun(OpCode wID, uint32_t count);
     void DisplayError (uint32_t   nError);
     std::unique_ptr<CalcEngine::Rational> PersistedMemObject();
     void PersistedMemObject(CalcEngine::Rational const& memObject);
@@ -62,17 +72,88 @@ public:
     void SettingsChanged();
     bool IsCurrentTooBigForTrig();
     int GetCurrentRadix();
+    int32_t GetPrecision() { return m_precision; }
     std::wstring GetCurrentResultForRadix(uint32_t radix, int32_t precision);
-    void ChangePrecision(int32_t precision) { m_precision = precision; ChangeConstants(m_radix, precision); }
+    // Hex, dec, oct and bin display strings for the programmer panel,
+    // derived from one conversion of the current value instead of a
+    // separate NumberToString pass per radix.
+    struct RadixDisplays
+    {
+        std::wstring hexString;
+        std::wstring decString;
+        std::wstring octString;
+        std::wstring binString;
+    };
+    RadixDisplays GetAllRadixDisplays(int32_t precision);
+    void ChangePrecision(int32_t precision)
+    {
+        DiscardEquSpeculation(); // a precomputed iterate at the old precision is stale
+        m_precision = precision;
+        // Keep the Rational layer's working precision in step, so extended
+        // precision carries through intermediate results, not just display.
+        CalcEngine::SetRationalPrecision(precision);
+        ChangeConstants(m_radix, precision);
+    }
+    // A settled image of the evaluator: the operand and operator stacks,
+    // the repeat-equals state and the equation line under construction.
+    // Taken by the manager so a suspended session resumes in one step
+    // instead of replaying the keystroke journal.
+    struct Snapshot
+    {
+        int nOpCode;
+        int nPrevOpCode;
+        bool bChangeOp;
+        bool bNoPrevEqu;
+        bool bInv;
+        bool bRecord;
+        int nFE;
+        int nTempCom;
+        int nLastCom;
+        int openParenCount;
+        std::array<int, MAXPRECDEPTH> nOp;
+        std::array<CalcEngine::Rational, MAXPRECDEPTH> parenVals;
+        size_t precedenceOpCount;
+        std::array<int, MAXPRECDEPTH> nPrecOp;
+        std::array<CalcEngine::Rational, MAXPRECDEPTH> precedenceVals;
+        CalcEngine::Rational lastVal;
+        CalcEngine::Rational currentVal;
+        CalcEngine::Rational holdVal;
+        CHistoryCollector::Snapshot historyCollector;
+    };
+    bool TryGetSnapshot(_Out_ Snapshot& snapshot);
+    void ApplySnapshot(_In_ Snapshot const& snapshot);
+    // Repaints the parenthesis count, the expression line and the number
+    // display from the engine's retained state. Used when the manager
+    // makes a parked mode engine current again: nothing in the evaluator
+    // changes, the displays just catch up.
+    void RefreshDisplay();
+
     std::wstring GroupDigitsPerRadix(std::wstring_view numberString, uint32_t radix);
     std::wstring GetStringForDisplay(CalcEngine::Rational const& rat, uint32_t radix);
     void UpdateMaxIntDigits();
+    // Re-derives the ratpak constants for the engine's current radix and
+    // precision. The constants are thread_local, so a thread that starts
+    // (or resumes) running engine work must call this before its first
+    // command; repeat calls are satisfied from the per-thread constant
+    // cache.
+    void BaseOrPrecisionChanged();
+    // Rebinds a pre-built engine (from the manager's warm pool) to the
+    // manager that adopts it: resource provider, display callback and
+    // history display, then re-reads the separator settings from the
+    // real provider.
+    void AdoptCallbacks(CalculationManager::IResourceProvider* pResourceProvider, __in_opt ICalcDisplay* pCalcDisplay, __in_opt std::shared_ptr<IHistoryDisplay> pHistoryDisplay);
+    // Releases the memory held by the grouped-display and per-radix string
+    // caches; the next display paint rebuilds them. Called under memory
+    // pressure.
+    void TrimDisplayCaches();
     wchar_t DecimalSeparator() const;
 
     // Static methods for the instance
     static void InitialOneTimeOnlySetup(CalculationManager::IResourceProvider& resourceProvider); // Once per load time to call to initialize all shared global variables
+    static void InitialPerThreadSetup(); // Once per worker thread that constructs or runs engines; sets up that thread's ratpak constants
     // returns the ptr to string representing the operator. Mostly same as the button, but few special cases for x^y etc.
-    static std::wstring_view GetString(int ids) { return s_engineStrings[ids]; }
+    // Fetches the id from the resource provider on first use.
+    static std::wstring_view GetString(int ids);
     static std::wstring_view OpCodeToString(int nOpCode) { return GetString(IdStrFromCmdId(nOpCode)); }
     static std::wstring_view OpCodeToUnaryString(int nOpCode, bool fInv, ANGLE_TYPE angletype);
 
@@ -80,7 +161,7 @@ private:
     bool m_fPrecedence;
     bool m_fIntegerMode; /* This is true if engine is explicitly called to be in integer mode. All bases are restricted to be in integers only */
     ICalcDisplay *m_pCalcDisplay;
-    CalculationManager::IResourceProvider* const m_resourceProvider;
+    CalculationManager::IResourceProvider* m_resourceProvider; // non-const so a warm-pool engine can be rebound on adoption
     int m_nOpCode;    /* ID value of operation.                       */
     int m_nPrevOpCode; // opcode which computed the number in m_currentVal. 0 if it is already bracketed or plain number or
     // if it hasn't yet been computed
@@ -99,6 +180,7 @@ private:
     std::array<CalcEngine::Rational, MAXPRECDEPTH> m_parenVals; // Holding array for parenthesis values.
     std::array<CalcEngine::Rational, MAXPRECDEPTH> m_precedenceVals; // Holding array for precedence values.
     bool m_bError;        // Error flag.
+    uint32_t m_nLastError; // Code behind m_bError, so a reactivated engine can repaint its error text.
     bool m_bInv;          // Inverse on/off flag.
     bool m_bNoPrevEqu; /* Flag for previous equals.          */
 
@@ -123,10 +205,53 @@ private:
 
     std::array<CalcEngine::Rational, NUM_WIDTH_LENGTH> m_chopNumbers; // word size enforcement
     std::array<std::wstring, NUM_WIDTH_LENGTH> m_maxDecimalValueStrings; // maximum values represented by a given word width based off m_chopNumbers
-    static std::array<std::wstring, CSTRINGSENGMAX> s_engineStrings; // the string table shared across all instances
+    static std::array<std::wstring, CSTRINGSENGMAX> s_engineStrings; // the string table shared across all instances, filled lazily per id
     wchar_t m_decimalSeparator;
     wchar_t m_groupSeparator;
 
+    // Last GroupDigitsPerRadix input and output, so the frequent display
+    // refreshes that don't change the number skip the separator pass.
+    // A radix of zero marks the cache empty; separator setting changes
+    // invalidate it in SettingsChanged.
+    std::wstring m_groupedCacheInput;
+    std::wstring m_groupedCacheResult;
+    uint32_t m_groupedCacheRadix;
+
+    // Rendered (ungrouped) strings for one value, one slot per programmer
+    // radix, so toggling HEX/DEC/OCT/BIN redisplays the same value with a
+    // lookup instead of another ratpak conversion. The mask tracks which
+    // slots are filled; a different value or display shape (precision, word
+    // width, notation, separators) clears it.
+    CalcEngine::Rational m_radixStringCacheValue;
+    std::array<std::wstring, 4> m_radixStringCache;
+    uint32_t m_radixStringCacheMask;
+    int32_t m_radixStringCachePrecision;
+    int32_t m_radixStringCacheBitWidth;
+    eNUMOBJ_FMT m_radixStringCacheFmt;
+
+    // Speculative repeat-equals state. Once an "=" completes with a binary
+    // operator still armed, a further "=" would recompute
+    // DoOperation(m_nOpCode, m_holdVal, m_lastVal); that iterate is started
+    // on a parked worker thread so the repeat press lands on a finished
+    // result. The worker only ever reads engine state, and every command
+    // other than "=" (as well as precision and snapshot changes) discards
+    // the speculation before mutating anything, so the two never overlap.
+    // The thread is started lazily on the first speculation and joined in
+    // the destructor.
+    std::thread m_specThread;
+    std::mutex m_specMutex;
+    std::condition_variable m_specWake;     // engine -> worker: iterate armed, or exit
+    std::condition_variable m_specDoneWake; // worker -> engine: iterate retired
+    std::atomic<bool> m_specCancel;         // armed into the worker's ratpak checkpoints
+    bool m_specExit;
+    bool m_specPending; // armed and not yet computed
+    bool m_specDone;    // m_specResult/m_specError hold a retired iterate
+    int m_specOpCode;
+    CalcEngine::Rational m_specHoldVal;
+    CalcEngine::Rational m_specLastVal;
+    CalcEngine::Rational m_specResult;
+    uint32_t m_specError; // error code the iterate raised, 0 for a clean result
+
 private:
     void ProcessCommandWorker(OpCode wParam);
     void HandleErrorCommand(OpCode idc);
@@ -139,6 +264,34 @@ private:
     CalcEngine::Rational TruncateNumForIntMath(CalcEngine::Rational const& rat);
     CalcEngine::Rational SciCalcFunctions(CalcEngine::Rational const& rat, uint32_t op);
     CalcEngine::Rational DoOperation(int operation, CalcEngine::Rational const& lhs, CalcEngine::Rational const& rhs);
+    // The dispatch half of DoOperation: throws the raw error code instead of
+    // latching the error display, so it can also run on the speculation
+    // worker where the display callbacks must not be touched.
+    CalcEngine::Rational DoOperationRaw(int operation, CalcEngine::Rational const& lhs, CalcEngine::Rational const& rhs);
+    // Cheap operand tests for the errors that are expected user inputs
+    // (divide/mod by zero, oversized shifts), so those report without
+    // exception unwinding; returns 0 when none applies.
+    uint32_t PrecheckOperationError(int operation, CalcEngine::Rational const& lhs, CalcEngine::Rational const& rhs);
+    // Speculative precomputation of the repeat-equals iterate.
+    void StartEquSpeculation();
+    bool TryConsumeEquSpeculation(int operation, CalcEngine::Rational const& lhs, CalcEngine::Rational const& rhs, _Out_ CalcEngine::Rational& result);
+    void DiscardEquSpeculation();
+    void EquSpeculationThreadProc();
+    // Individual binary operator handlers; DoOperation dispatches to these
+    // through a table indexed by command code.
+    CalcEngine::Rational DoOperationAnd(CalcEngine::Rational const& lhs, CalcEngine::Rational const& rhs);
+    CalcEngine::Rational DoOperationOr(CalcEngine::Rational const& lhs, CalcEngine::Rational const& rhs);
+    CalcEngine::Rational DoOperationXor(CalcEngine::Rational const& lhs, CalcEngine::Rational const& rhs);
+    CalcEngine::Rational DoOperationRshf(CalcEngine::Rational const& lhs, CalcEngine::Rational const& rhs);
+    CalcEngine::Rational DoOperationLshf(CalcEngine::Rational const& lhs, CalcEngine::Rational const& rhs);
+    CalcEngine::Rational DoOperationAdd(CalcEngine::Rational const& lhs, CalcEngine::Rational const& rhs);
+    CalcEngine::Rational DoOperationSub(CalcEngine::Rational const& lhs, CalcEngine::Rational const& rhs);
+    CalcEngine::Rational DoOperationMul(CalcEngine::Rational const& lhs, CalcEngine::Rational const& rhs);
+    CalcEngine::Rational DoOperationDiv(CalcEngine::Rational const& lhs, CalcEngine::Rational const& rhs);
+    CalcEngine::Rational DoOperationMod(CalcEngine::Rational const& lhs, CalcEngine::Rational const& rhs);
+    CalcEngine::Rational DoOperationDivMod(CalcEngine::Rational const& lhs, CalcEngine::Rational const& rhs, bool fIsMod);
+    CalcEngine::Rational DoOperationPwr(CalcEngine::Rational const& lhs, CalcEngine::Rational const& rhs);
+    CalcEngine::Rational DoOperationRoot(CalcEngine::Rational const& lhs, CalcEngine::Rational const& rhs);
     void SetRadixTypeAndNumWidth(RADIX_TYPE radixtype, NUM_WIDTH numwidth);
     int32_t DwWordBitWidthFromeNumWidth(NUM_WIDTH numwidth);
     uint32_t NRadixFromRadixType( RADIX_TYPE radixtype);
@@ -149,7 +302,6 @@ private:
 
     void InitChopNumbers();
 
-    static void LoadEngineStrings(CalculationManager::IResourceProvider& resourceProvider);
     static int IdStrFromCmdId(int id) { return id - IDC_FIRSTCONTROL + IDS_FIRSTENGSTR; }
 
     static std::vector<uint32_t> DigitGroupingStringToGroupingVector(std::wstring_view groupingString);
@@ -157,7 +309,6 @@ private:
 
     static int QuickLog2(int iNum);
     static void ChangeBaseConstants(uint32_t radix, int maxIntDigits, int32_t precision);
-    void BaseOrPrecisionChanged();
 
     friend class CalculatorUnitTests::CalcEngineTests;
 };
@@ -42,26 +42,42 @@ namespace CalcEngine
             m_decPtIndex(0),
             m_decSymbol(decSymbol),
             m_base(),
-            m_exponent()
+            m_exponent(),
+            m_mantissaValid(true),
+            m_mantissaRadix(0),
+            m_cachedMantissa()
         {}
 
         void Clear();
+        bool IsEmpty();
         bool TryToggleSign(bool isIntegerMode, std::wstring_view maxNumStr);
         bool TryAddDigit(unsigned int value, uint32_t radix, bool isIntegerMode, std::wstring_view maxNumStr, int32_t wordBitWidth, int maxDigits);
         bool TryAddDecimalPt();
         bool HasDecimalPt();
         bool TryBeginExponent();
         void Backspace();
+        void Backspace(uint32_t count);
         void SetDecimalSymbol(wchar_t decSymbol);
         std::wstring ToString(uint32_t radix);
         Rational ToRational(uint32_t radix, int32_t precision);
 
     private:
+        void AppendCachedDigit(unsigned int value, uint32_t radix);
+        void RecomputeMantissa(uint32_t radix);
+
         bool m_hasExponent;
         bool m_hasDecimal;
         size_t m_decPtIndex;
         wchar_t m_decSymbol;
         CalcNumSec m_base;
         CalcNumSec m_exponent;
+
+        // The typed mantissa digits as an integer (decimal point ignored),
+        // kept in step by multiply-by-radix-and-add on each digit keystroke.
+        // Structural edits like backspace just invalidate it; ToRational
+        // reparses the string only then.
+        bool m_mantissaValid;
+        uint32_t m_mantissaRadix;
+        Rational m_cachedMantissa;
     };
 }
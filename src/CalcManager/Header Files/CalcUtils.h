@@ -13,3 +13,7 @@ bool IsBinOpCode(OpCode opCode);
 bool IsUnaryOpCode(OpCode opCode);
 bool IsDigitOpCode(OpCode opCode);
 bool IsGuiSettingOpCode(OpCode opCode);
+
+// Commands that commit the number being recorded. IDC_SIGN and the binary
+// bit-edit commands are special cases the caller handles itself.
+bool IsInputCommittingOpCode(OpCode opCode);
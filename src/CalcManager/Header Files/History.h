@@ -6,6 +6,7 @@
 #include "ICalcDisplay.h"
 #include "IHistoryDisplay.h"
 #include "Rational.h"
+#include "../ExpressionCommandArena.h"
 
 // maximum depth you can get by precedence. It is just an array's size limit.
 static constexpr size_t MAXPRECDEPTH = 25;
@@ -33,6 +34,30 @@ public:
     int AddCommand(_In_ const std::shared_ptr<IExpressionCommand> & spCommand);
     void UpdateHistoryExpression(uint32_t radix, int32_t precision);
     void SetDecimalSymbol(wchar_t decimalSymbol);
+    void RebindDisplays(ICalcDisplay* pCalcDisplay, std::shared_ptr<IHistoryDisplay> pHistoryDisplay);
+    // Re-emits the expression line onto the display callback without
+    // changing any collector state; used when the displays were last
+    // painted by a different engine.
+    void RepaintExpressionDisplay();
+
+    // Flat image of the equation line under construction, exposed so the
+    // engine state snapshot can carry it across a suspend. Tokens are the
+    // same (offset, length, command index) triples as the interned form.
+    struct Snapshot
+    {
+        int iCurLineHistStart;
+        int lastOpStartIndex;
+        int lastBinOpStartIndex;
+        std::array<int, MAXPRECDEPTH> operandIndices;
+        int curOperandIndex;
+        bool bLastOpndBrace;
+        bool fTokensLive;
+        std::wstring equationSz;
+        std::vector<int> tokens;
+        std::shared_ptr<CalculatorVector<std::shared_ptr<IExpressionCommand>>> spCommands;
+    };
+    void GetSnapshot(_Out_ Snapshot &snapshot);
+    void ApplySnapshot(_In_ Snapshot const& snapshot);
 
 private:
     std::shared_ptr<IHistoryDisplay> m_pHistoryDisplay;
@@ -47,8 +72,30 @@ private:
     int m_curOperandIndex; // Stack index for the above stack
     bool m_bLastOpndBrace;    // iff the last opnd in history is already braced so we can avoid putting another one for unary operator
     wchar_t m_decimalSymbol;
-    std::shared_ptr<CalculatorVector <std::pair<std::wstring, int>>> m_spTokens;
+
+    // The equation line under construction. All token text is interned in
+    // one buffer and each token is an (offset, length) view into it plus its
+    // command index, so append/insert/truncate are offset bookkeeping
+    // instead of per-token string traffic. A CalculatorVector is
+    // materialized from this form only when handed to the display or the
+    // history list.
+    struct HistoryToken
+    {
+        uint32_t ichStart;
+        uint32_t cch;
+        int iCommandIndex;
+    };
+    std::wstring m_equationSz;
+    std::vector<HistoryToken> m_tokens;
+    // The token vector this buffer replaced was created lazily and only
+    // released when a line completed; an empty-but-live buffer still
+    // refreshes the expression display on a radix change.
+    bool m_fTokensLive;
     std::shared_ptr<CalculatorVector<std::shared_ptr<IExpressionCommand>>> m_spCommands;
+    // Backs the command nodes of the expression under construction; a
+    // fresh arena is started whenever the history line reinitializes.
+    // Completed lines keep the retired arena alive through their nodes.
+    CExpressionCommandArena m_commandArena;
 
 private:
     void ReinitHistory();
@@ -56,5 +103,6 @@ private:
     void TruncateEquationSzFromIch(int ich);
     void SetExpressionDisplay();
     void InsertSzInEquationSz(std::wstring_view str, int icommandIndex, int ich);
+    std::shared_ptr<CalculatorVector<std::pair<std::wstring, int>>> MaterializeTokens();
     std::shared_ptr<CalculatorVector<int>> GetOperandCommandsFromString(std::wstring_view numStr);
 };
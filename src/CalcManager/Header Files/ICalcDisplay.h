@@ -19,4 +19,24 @@ public:
     virtual void OnHistoryItemAdded(_In_ unsigned int addedItemIndex) = 0;
     virtual void SetMemorizedNumbers(const std::vector<std::wstring>& memorizedNumbers) = 0;
     virtual void MemoryItemChanged(unsigned int indexOfMemory) = 0;
+
+    // Single-slot companion to SetMemorizedNumbers, raised when one
+    // existing slot changes value (M+/M-) so the display does not have to
+    // re-render the whole list. Additions, removals and radix changes
+    // still come through the full-vector callback. No-op by default.
+    virtual void SetMemorizedNumber(_In_ unsigned int /*indexOfMemory*/, const std::wstring& /*memorizedNumber*/) {}
+
+    // Bracket the display updates triggered by one command, so an
+    // implementation that marshals to a UI thread can batch everything
+    // between the two calls into a single dispatch. No-ops by default for
+    // displays that forward synchronously.
+    virtual void BeginDisplayTransaction() {}
+    virtual void EndDisplayTransaction() {}
+
+    // Heartbeat from a long computation, raised on the computing thread
+    // every few hundred series iterations with the running iteration
+    // count. There is no total to report a fraction of; use it to show a
+    // busy indicator with a cancel affordance (CalculatorManager::
+    // CancelComputation). No-op by default.
+    virtual void OnComputationProgress(_In_ uint32_t /*cIterations*/) {}
 };
@@ -7,24 +7,133 @@
 
 namespace CalcEngine
 {
+    // Small-buffer storage for Number's mantissa digits.  Values in the
+    // standard calculator modes fit INLINE_CAPACITY limbs, so the digits
+    // live inline and only longer numbers touch the heap.
+    class NumberMantissa
+    {
+    public:
+        static constexpr size_t INLINE_CAPACITY = 4;
+
+        NumberMantissa() noexcept :
+            m_size{ 0 }
+        {}
+
+        NumberMantissa(uint32_t const* digits, size_t count)
+        {
+            Assign(digits, count);
+        }
+
+        NumberMantissa(std::vector<uint32_t> const& digits) :
+            NumberMantissa{ digits.data(), digits.size() }
+        {}
+
+        NumberMantissa(std::initializer_list<uint32_t> digits) :
+            NumberMantissa{ digits.begin(), digits.size() }
+        {}
+
+        NumberMantissa(NumberMantissa const& other) = default;
+        NumberMantissa& operator=(NumberMantissa const& other) = default;
+
+        NumberMantissa(NumberMantissa&& other) noexcept :
+            m_size{ other.m_size },
+            m_overflow{ std::move(other.m_overflow) }
+        {
+            for (size_t i = 0; i < INLINE_CAPACITY; ++i)
+            {
+                m_inline[i] = other.m_inline[i];
+            }
+            other.m_size = 0;
+        }
+
+        NumberMantissa& operator=(NumberMantissa&& other) noexcept
+        {
+            m_size = other.m_size;
+            for (size_t i = 0; i < INLINE_CAPACITY; ++i)
+            {
+                m_inline[i] = other.m_inline[i];
+            }
+            m_overflow = std::move(other.m_overflow);
+            other.m_size = 0;
+
+            return *this;
+        }
+
+        size_t size() const
+        {
+            return m_size;
+        }
+
+        bool empty() const
+        {
+            return m_size == 0;
+        }
+
+        uint32_t const* data() const
+        {
+            return (m_size <= INLINE_CAPACITY) ? m_inline : m_overflow.data();
+        }
+
+        uint32_t const* begin() const
+        {
+            return data();
+        }
+
+        uint32_t const* end() const
+        {
+            return data() + m_size;
+        }
+
+        uint32_t const& front() const
+        {
+            return *data();
+        }
+
+        uint32_t const& operator[](size_t index) const
+        {
+            return data()[index];
+        }
+
+    private:
+        void Assign(uint32_t const* digits, size_t count)
+        {
+            m_size = count;
+            if (count <= INLINE_CAPACITY)
+            {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    m_inline[i] = digits[i];
+                }
+            }
+            else
+            {
+                m_overflow.assign(digits, digits + count);
+            }
+        }
+
+        size_t m_size;
+        uint32_t m_inline[INLINE_CAPACITY];
+        std::vector<uint32_t> m_overflow;
+    };
+
     class Number
     {
     public:
         Number() noexcept;
-        Number(int32_t sign, int32_t exp, std::vector<uint32_t> const& mantissa) noexcept;
+        Number(int32_t sign, int32_t exp, NumberMantissa const& mantissa) noexcept;
 
         explicit Number(PNUMBER p) noexcept;
         PNUMBER ToPNUMBER() const;
 
         int32_t const& Sign() const;
         int32_t const& Exp() const;
-        std::vector<uint32_t> const& Mantissa() const;
+        NumberMantissa const& Mantissa() const;
 
         bool IsZero() const;
 
     private:
         int32_t m_sign;
         int32_t m_exp;
-        std::vector<uint32_t> m_mantissa;
+        NumberMantissa m_mantissa;
     };
 }
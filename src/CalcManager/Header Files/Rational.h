@@ -11,24 +11,45 @@ namespace CalcEngine
     // RatPack calculations currently support up to Base64.
     inline constexpr uint32_t RATIONAL_BASE = 10;
 
-    // Default Precision to use for Rational calculations
-    inline constexpr int32_t RATIONAL_PRECISION = 128;
+    // Baseline precision to use for Rational calculations, enough guard
+    // digits for every standard calculator mode.
+    inline constexpr int32_t RATIONAL_PRECISION_DEFAULT = 128;
+
+    // Upper bound for the user-selectable extended-precision mode.
+    inline constexpr int32_t RATIONAL_PRECISION_MAX = 10000;
+
+    // Active precision for Rational calculations.  Deliberately not a
+    // constant: the extended-precision mode raises it at runtime through
+    // SetRationalPrecision and every operation reads the active value.  It
+    // never drops below the default, so the standard modes always keep
+    // their guard digits.
+    inline int32_t RATIONAL_PRECISION = RATIONAL_PRECISION_DEFAULT;
+
+    // Sets the active precision for Rational calculations, clamped to
+    // [RATIONAL_PRECISION_DEFAULT, RATIONAL_PRECISION_MAX].
+    void SetRationalPrecision(int32_t precision);
 
     class Rational
     {
     public:
-        Rational() noexcept;
-        Rational(Number const& n) noexcept;
-        Rational(Number const& p, Number const& q) noexcept;
+        Rational();
+        Rational(Rational const& other);
+        Rational(Rational&& other) noexcept;
+        Rational& operator=(Rational const& other);
+        Rational& operator=(Rational&& other) noexcept;
+        ~Rational();
+
+        Rational(Number const& n);
+        Rational(Number const& p, Number const& q);
         Rational(int32_t i);
         Rational(uint32_t ui);
         Rational(uint64_t ui);
 
-        explicit Rational(PRAT prat) noexcept;
+        explicit Rational(PRAT prat);
         PRAT ToPRAT() const;
 
-        Number const& P() const;
-        Number const& Q() const;
+        Number P() const;
+        Number Q() const;
 
         Rational operator-() const;
         Rational& operator+=(Rational const& rhs);
@@ -44,6 +65,11 @@ namespace CalcEngine
         Rational& operator|=(Rational const& rhs);
         Rational& operator^=(Rational const& rhs);
 
+        // Masks the value to its low `bits` bits - the programmer-mode
+        // word-size chop.  Equivalent to `*this &= 2^bits - 1` but runs
+        // as a limb truncation instead of a full Ratpack AND.
+        Rational& ChopToBitWidth(uint32_t bits);
+
         friend Rational operator+(Rational lhs, Rational const& rhs);
         friend Rational operator-(Rational lhs, Rational const& rhs);
         friend Rational operator*(Rational lhs, Rational const& rhs);
@@ -68,7 +94,21 @@ namespace CalcEngine
         uint64_t ToUInt64_t() const;
 
     private:
-        Number m_p;
-        Number m_q;
+        bool IsI64() const;
+        void Materialize();
+
+        template <typename TRatOp>
+        Rational& ApplyRatOp(Rational const& rhs, TRatOp&& ratOp);
+
+        // Owned Ratpack representation, with a tagged integer lane in
+        // front of it: when m_prat is null the value is the native
+        // integer m_i64, and add, subtract, multiply, exact divide and
+        // compare between two lane values run without touching Ratpack.
+        // Any other operation -- and any result the lane cannot hold
+        // exactly -- materializes m_prat and proceeds on the Ratpack
+        // form, so ToPRAT, P and Q still hand out copies either way.
+        // INT64_MIN never enters the lane, keeping negation safe.
+        PRAT m_prat = nullptr;
+        int64_t m_i64 = 0;
     };
 }
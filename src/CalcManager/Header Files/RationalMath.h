@@ -7,9 +7,59 @@
 
 namespace CalcEngine::RationalMath
 {
+    // Keeps a value in PRAT form across a chain of math calls, so composed
+    // functions pay one conversion in and one conversion out instead of a
+    // round trip per call.  Chains read left to right:
+    //     Pipeline{ x }.Pow(2).Sin(angletype).Invert().ToRational()
+    class Pipeline
+    {
+    public:
+        explicit Pipeline(Rational const& rat);
+        ~Pipeline();
+
+        Pipeline(Pipeline const&) = delete;
+        Pipeline& operator=(Pipeline const&) = delete;
+
+        Pipeline& Frac();
+        Pipeline& Integer();
+
+        Pipeline& Pow(Rational const& pow);
+        Pipeline& Root(Rational const& root);
+        Pipeline& Fact();
+
+        Pipeline& Exp();
+        Pipeline& Log();
+        Pipeline& Log10();
+
+        Pipeline& Invert();
+        Pipeline& Abs();
+
+        Pipeline& Sin(ANGLE_TYPE angletype);
+        Pipeline& Cos(ANGLE_TYPE angletype);
+        Pipeline& Tan(ANGLE_TYPE angletype);
+        Pipeline& ASin(ANGLE_TYPE angletype);
+        Pipeline& ACos(ANGLE_TYPE angletype);
+        Pipeline& ATan(ANGLE_TYPE angletype);
+
+        Pipeline& Sinh();
+        Pipeline& Cosh();
+        Pipeline& Tanh();
+        Pipeline& ASinh();
+        Pipeline& ACosh();
+        Pipeline& ATanh();
+
+        Rational ToRational() const;
+
+    private:
+        PRAT m_prat;
+    };
+
     Rational Frac(Rational const& rat);
     Rational Integer(Rational const& rat);
 
+    // Fused rat * mul + add with a single trim and temporary set.
+    Rational MulAdd(Rational const& rat, Rational const& mul, Rational const& add);
+
     Rational Pow(Rational const& base, Rational const& pow);
     Rational Root(Rational const& base, Rational const& root);
     Rational Fact(Rational const& rat);
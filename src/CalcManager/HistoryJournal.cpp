@@ -0,0 +1,221 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "pch.h"
+#include <cstring>
+#include "HistoryJournal.h"
+
+using namespace std;
+using namespace CalculationManager;
+
+namespace
+{
+    void AppendBytes(_Inout_ vector<unsigned char>& buffer, _In_reads_bytes_(cb) void const* pData, size_t cb)
+    {
+        auto pb = static_cast<unsigned char const*>(pData);
+        buffer.insert(buffer.end(), pb, pb + cb);
+    }
+
+    // Characters are stored as UTF-16 code units regardless of the width of
+    // wchar_t, so the file format does not depend on the compiler.
+    void AppendChars(_Inout_ vector<unsigned char>& buffer, _In_ wstring const& str)
+    {
+        for (wchar_t wch : str)
+        {
+            uint16_t unit = static_cast<uint16_t>(wch);
+            AppendBytes(buffer, &unit, sizeof(unit));
+        }
+    }
+
+    wstring ReadChars(_In_reads_bytes_(cch * sizeof(uint16_t)) unsigned char const* pbData, size_t cch)
+    {
+        wstring str;
+        str.reserve(cch);
+        for (size_t i = 0; i < cch; i++)
+        {
+            uint16_t unit;
+            memcpy(&unit, pbData + i * sizeof(uint16_t), sizeof(unit));
+            str.push_back(static_cast<wchar_t>(unit));
+        }
+        return str;
+    }
+
+}
+
+// A malformed command segment would send HydrateCommands off the end of
+// the vector, so walk the tagged records up front and reject the segment
+// if the structure does not add up.
+bool HistoryJournal::FValidPackedCommands(_In_ vector<int> const& packedCommands)
+{
+    size_t i = 0;
+    while (i < packedCommands.size())
+    {
+        auto type = static_cast<CommandType>(packedCommands[i++]);
+        switch (type)
+        {
+        case CommandType::OperandCommand:
+            if (i + 1 >= packedCommands.size() || packedCommands[i + 1] < 0)
+            {
+                return false;
+            }
+            i += static_cast<size_t>(packedCommands[i + 1]) + 2;
+            break;
+        case CommandType::UnaryCommand:
+            if (i >= packedCommands.size() || packedCommands[i] < 0)
+            {
+                return false;
+            }
+            i += static_cast<size_t>(packedCommands[i]) + 1;
+            break;
+        case CommandType::BinaryCommand:
+        case CommandType::Parentheses:
+            i++;
+            break;
+        default:
+            return false;
+        }
+    }
+    return i == packedCommands.size();
+}
+
+vector<unsigned char> HistoryJournal::SerializeItem(_In_ shared_ptr<HISTORYITEM> const& spHistoryItem)
+{
+    HISTORYITEMVECTOR& itemVector = spHistoryItem->historyItemVector;
+    CalculatorHistory::PackItem(itemVector);
+
+    JOURNALRECORD record = {};
+    record.cchExpression = static_cast<uint32_t>(itemVector.expression.size());
+    record.cchResult = static_cast<uint32_t>(itemVector.result.size());
+    record.cchTokenChars = static_cast<uint32_t>(itemVector.tokenChars.size());
+    record.cTokens = static_cast<uint32_t>(itemVector.packedTokens.size() / 3);
+    record.cCommandInts = static_cast<uint32_t>(itemVector.packedCommands.size());
+
+    size_t cbChars = (record.cchExpression + record.cchResult + record.cchTokenChars) * sizeof(uint16_t);
+    size_t cbPad = cbChars % sizeof(int32_t);
+    size_t cbInts = (static_cast<size_t>(record.cTokens) * 3 + record.cCommandInts) * sizeof(int32_t);
+    record.cbBlock = static_cast<uint32_t>(sizeof(JOURNALRECORD) + cbChars + cbPad + cbInts);
+
+    vector<unsigned char> block;
+    block.reserve(record.cbBlock);
+    AppendBytes(block, &record, sizeof(record));
+    AppendChars(block, itemVector.expression);
+    AppendChars(block, itemVector.result);
+    AppendChars(block, itemVector.tokenChars);
+    block.resize(block.size() + cbPad);
+    for (int value : itemVector.packedTokens)
+    {
+        int32_t serialized = value;
+        AppendBytes(block, &serialized, sizeof(serialized));
+    }
+    for (int value : itemVector.packedCommands)
+    {
+        int32_t serialized = value;
+        AppendBytes(block, &serialized, sizeof(serialized));
+    }
+
+    return block;
+}
+
+vector<unsigned char> HistoryJournal::Serialize(_In_ vector<shared_ptr<HISTORYITEM>> const& items)
+{
+    JOURNALHEADER header = {};
+    header.magic = JOURNAL_MAGIC;
+    header.version = JOURNAL_VERSION;
+    header.itemCount = static_cast<uint32_t>(items.size());
+
+    vector<unsigned char> buffer;
+    AppendBytes(buffer, &header, sizeof(header));
+    for (auto const& spHistoryItem : items)
+    {
+        vector<unsigned char> block = SerializeItem(spHistoryItem);
+        AppendBytes(buffer, block.data(), block.size());
+    }
+
+    return buffer;
+}
+
+bool HistoryJournal::Deserialize(_In_reads_bytes_(cbData) unsigned char const* pbData, size_t cbData, _Out_ vector<shared_ptr<HISTORYITEM>>& items)
+{
+    items.clear();
+    if (pbData == nullptr || cbData < sizeof(JOURNALHEADER))
+    {
+        return false;
+    }
+
+    JOURNALHEADER header;
+    memcpy(&header, pbData, sizeof(header));
+    if (header.magic != JOURNAL_MAGIC || header.version != JOURNAL_VERSION)
+    {
+        return false;
+    }
+
+    size_t ib = sizeof(header);
+    for (uint32_t iItem = 0; iItem < header.itemCount; iItem++)
+    {
+        if (ib + sizeof(JOURNALRECORD) > cbData)
+        {
+            return false;
+        }
+
+        JOURNALRECORD record;
+        memcpy(&record, pbData + ib, sizeof(record));
+
+        size_t cbChars = (static_cast<size_t>(record.cchExpression) + record.cchResult + record.cchTokenChars) * sizeof(uint16_t);
+        size_t cbPad = cbChars % sizeof(int32_t);
+        size_t cbInts = (static_cast<size_t>(record.cTokens) * 3 + record.cCommandInts) * sizeof(int32_t);
+        if (record.cbBlock != sizeof(JOURNALRECORD) + cbChars + cbPad + cbInts || ib + record.cbBlock > cbData)
+        {
+            return false;
+        }
+
+        auto spHistoryItem = make_shared<HISTORYITEM>();
+        HISTORYITEMVECTOR& itemVector = spHistoryItem->historyItemVector;
+
+        unsigned char const* pbChars = pbData + ib + sizeof(JOURNALRECORD);
+        itemVector.expression = ReadChars(pbChars, record.cchExpression);
+        pbChars += record.cchExpression * sizeof(uint16_t);
+        itemVector.result = ReadChars(pbChars, record.cchResult);
+        pbChars += record.cchResult * sizeof(uint16_t);
+        itemVector.tokenChars = ReadChars(pbChars, record.cchTokenChars);
+        pbChars += record.cchTokenChars * sizeof(uint16_t);
+
+        unsigned char const* pbInts = pbChars + cbPad;
+        itemVector.packedTokens.reserve(static_cast<size_t>(record.cTokens) * 3);
+        for (size_t i = 0; i < static_cast<size_t>(record.cTokens) * 3; i++)
+        {
+            int32_t value;
+            memcpy(&value, pbInts + i * sizeof(int32_t), sizeof(value));
+            itemVector.packedTokens.push_back(value);
+        }
+        pbInts += static_cast<size_t>(record.cTokens) * 3 * sizeof(int32_t);
+        itemVector.packedCommands.reserve(record.cCommandInts);
+        for (size_t i = 0; i < record.cCommandInts; i++)
+        {
+            int32_t value;
+            memcpy(&value, pbInts + i * sizeof(int32_t), sizeof(value));
+            itemVector.packedCommands.push_back(value);
+        }
+
+        // Reject anything hydration could trip over.
+        for (size_t i = 0; i + 2 < itemVector.packedTokens.size(); i += 3)
+        {
+            int ichStart = itemVector.packedTokens[i];
+            int cch = itemVector.packedTokens[i + 1];
+            if (ichStart < 0 || cch < 0 || static_cast<size_t>(ichStart) + cch > itemVector.tokenChars.size())
+            {
+                return false;
+            }
+        }
+        if (!FValidPackedCommands(itemVector.packedCommands))
+        {
+            return false;
+        }
+
+        items.push_back(spHistoryItem);
+        ib += record.cbBlock;
+    }
+
+    // Trailing bytes past the counted blocks are tolerated: an append that
+    // died before the header count was patched leaves exactly that behind.
+    return true;
+}
@@ -0,0 +1,48 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include "CalculatorHistory.h"
+
+namespace CalculationManager
+{
+    // On-disk layout of the history journal: one fixed-size header, then one
+    // block per item. Each block is a fixed-size record followed by its
+    // interned character segment (UTF-16 code units) and its int segment, so
+    // a mapped file can be walked record by record without any text parsing.
+    // Items come back in packed form and hydrate only on recall.
+    struct JOURNALHEADER
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t itemCount;
+        uint32_t reserved;
+    };
+
+    struct JOURNALRECORD
+    {
+        uint32_t cbBlock;       // whole block, record included
+        uint32_t cchExpression;
+        uint32_t cchResult;
+        uint32_t cchTokenChars;
+        uint32_t cTokens;       // packedTokens triples
+        uint32_t cCommandInts;  // packedCommands entries
+        uint32_t reserved0;
+        uint32_t reserved1;
+    };
+
+    class HistoryJournal
+    {
+    public:
+        static constexpr uint32_t JOURNAL_MAGIC = 0x4A484C43; // "CLHJ"
+        static constexpr uint32_t JOURNAL_VERSION = 1;
+
+        static std::vector<unsigned char> Serialize(_In_ std::vector<std::shared_ptr<HISTORYITEM>> const& items);
+        static std::vector<unsigned char> SerializeItem(_In_ std::shared_ptr<HISTORYITEM> const& spHistoryItem);
+        static bool Deserialize(_In_reads_bytes_(cbData) unsigned char const* pbData, size_t cbData, _Out_ std::vector<std::shared_ptr<HISTORYITEM>>& items);
+
+        // Structural check for a packed command segment read from external
+        // data; shared with the manager's state snapshot deserializer.
+        static bool FValidPackedCommands(_In_ std::vector<int> const& packedCommands);
+    };
+}
@@ -84,3 +84,10 @@ typedef int32_t ResultCode;
 // The result of this operation is undefined
 #define CALC_E_NORESULT         ((uint32_t)0x80000009)
 
+// CALC_E_CANCELLED
+//
+// The user cancelled the computation while it was in progress. Unlike the
+// codes above this one never reaches DisplayError; the engine quietly
+// keeps the original operand and stays out of the error state.
+#define CALC_E_CANCELLED        ((uint32_t)0x8000000B)
+
@@ -17,8 +17,1017 @@
 #include "pch.h"
 #include "ratpak.h"
 
+// 64-bit targets get a multiplication kernel that packs pairs of 31-bit
+// limbs into 62-bit limbs and multiplies with 128-bit intermediates.
+#if defined(_M_AMD64) || defined(_M_ARM64) || defined(__x86_64__) || defined(__aarch64__)
+#define RATPAK_WIDE_MUL 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#else
+#define RATPAK_WIDE_MUL 0
+#endif
+
 void _mulnumx( PNUMBER *pa, PNUMBER b );
 
+//-----------------------------------------------------------------------------
+//
+//   Karatsuba multiplication over raw BASEX limb spans.
+//
+//   The grade-school loop in _mulnumx is O(n^2) in the limb count, which
+//   makes high-precision work (long factorials, powrat chains) quadratic in
+//   the operand size.  Above KARATSUBA_THRESHOLD limbs the product is split
+//   into three half-size multiplies instead.  All helpers below work on bare
+//   mantissa arrays, least significant limb first, with limb values < BASEX.
+//
+//-----------------------------------------------------------------------------
+
+namespace {
+
+// Below this many limbs (on the smaller operand) the schoolbook loop wins.
+constexpr int32_t KARATSUBA_THRESHOLD = 32;
+
+// dest[0..na+nb) += a * b, schoolbook.  dest must have na+nb limbs and carry
+// headroom is guaranteed because the product fits in na+nb limbs.
+void MulSchoolbook(const MANTTYPE* a, int32_t na, const MANTTYPE* b, int32_t nb, MANTTYPE* dest)
+{
+    for (int32_t i = 0; i < na; i++)
+    {
+        TWO_MANTTYPE da = a[i];
+        if (da == 0)
+        {
+            continue;
+        }
+
+        TWO_MANTTYPE cy = 0;
+        for (int32_t j = 0; j < nb; j++)
+        {
+            TWO_MANTTYPE t = da * b[j] + dest[i + j] + cy;
+            dest[i + j] = (MANTTYPE)(t & (BASEX - 1));
+            cy = t >> BASEXPWR;
+        }
+
+        for (int32_t k = i + nb; cy != 0; k++)
+        {
+            TWO_MANTTYPE t = dest[k] + cy;
+            dest[k] = (MANTTYPE)(t & (BASEX - 1));
+            cy = t >> BASEXPWR;
+        }
+    }
+}
+
+// dest[0..2*na) = a * a, schoolbook.  dest must be zeroed on entry.  Each
+// cross product a[i]*a[j] with i < j is computed once, the partial sum is
+// doubled, and the diagonal terms a[i]^2 are added last, so roughly half
+// the multiplies of the general loop.
+void SqrSchoolbook(const MANTTYPE* a, int32_t na, MANTTYPE* dest)
+{
+    for (int32_t i = 0; i < na; i++)
+    {
+        TWO_MANTTYPE da = a[i];
+        if (da == 0)
+        {
+            continue;
+        }
+
+        TWO_MANTTYPE cy = 0;
+        for (int32_t j = i + 1; j < na; j++)
+        {
+            TWO_MANTTYPE t = da * a[j] + dest[i + j] + cy;
+            dest[i + j] = (MANTTYPE)(t & (BASEX - 1));
+            cy = t >> BASEXPWR;
+        }
+
+        for (int32_t k = i + na; cy != 0; k++)
+        {
+            TWO_MANTTYPE t = dest[k] + cy;
+            dest[k] = (MANTTYPE)(t & (BASEX - 1));
+            cy = t >> BASEXPWR;
+        }
+    }
+
+    // Double the off-diagonal sum; the full square fits in 2*na limbs so
+    // the final carry is zero.
+    TWO_MANTTYPE cy = 0;
+    for (int32_t i = 0; i < 2 * na; i++)
+    {
+        TWO_MANTTYPE t = ((TWO_MANTTYPE)dest[i] << 1) + cy;
+        dest[i] = (MANTTYPE)(t & (BASEX - 1));
+        cy = t >> BASEXPWR;
+    }
+
+    // Diagonal terms land on even limb pairs.
+    cy = 0;
+    for (int32_t i = 0; i < na; i++)
+    {
+        TWO_MANTTYPE t = (TWO_MANTTYPE)a[i] * a[i] + dest[2 * i] + cy;
+        dest[2 * i] = (MANTTYPE)(t & (BASEX - 1));
+        t = (t >> BASEXPWR) + dest[2 * i + 1];
+        dest[2 * i + 1] = (MANTTYPE)(t & (BASEX - 1));
+        cy = t >> BASEXPWR;
+    }
+}
+
+// dest[0..na) = a + b where na >= nb; returns the final carry (0 or 1).
+MANTTYPE AddSpans(const MANTTYPE* a, int32_t na, const MANTTYPE* b, int32_t nb, MANTTYPE* dest)
+{
+    TWO_MANTTYPE cy = 0;
+    for (int32_t i = 0; i < nb; i++)
+    {
+        cy += (TWO_MANTTYPE)a[i] + b[i];
+        dest[i] = (MANTTYPE)(cy & (BASEX - 1));
+        cy >>= BASEXPWR;
+    }
+    for (int32_t i = nb; i < na; i++)
+    {
+        cy += a[i];
+        dest[i] = (MANTTYPE)(cy & (BASEX - 1));
+        cy >>= BASEXPWR;
+    }
+    return (MANTTYPE)cy;
+}
+
+// dest -= s in place; caller guarantees dest >= s as an integer.
+void SubSpansInPlace(MANTTYPE* dest, int32_t nd, const MANTTYPE* s, int32_t ns)
+{
+    int64_t borrow = 0;
+    for (int32_t i = 0; i < ns; i++)
+    {
+        int64_t t = (int64_t)dest[i] - s[i] + borrow;
+        borrow = (t < 0) ? -1 : 0;
+        dest[i] = (MANTTYPE)(t & (BASEX - 1));
+    }
+    for (int32_t i = ns; borrow != 0 && i < nd; i++)
+    {
+        int64_t t = (int64_t)dest[i] + borrow;
+        borrow = (t < 0) ? -1 : 0;
+        dest[i] = (MANTTYPE)(t & (BASEX - 1));
+    }
+}
+
+// dest += src with carry propagation past src's end; caller guarantees the
+// final sum fits in dest.
+void AddIntoSpan(MANTTYPE* dest, const MANTTYPE* src, int32_t ns)
+{
+    TWO_MANTTYPE cy = 0;
+    for (int32_t i = 0; i < ns; i++)
+    {
+        cy += (TWO_MANTTYPE)dest[i] + src[i];
+        dest[i] = (MANTTYPE)(cy & (BASEX - 1));
+        cy >>= BASEXPWR;
+    }
+    for (int32_t k = ns; cy != 0; k++)
+    {
+        cy += dest[k];
+        dest[k] = (MANTTYPE)(cy & (BASEX - 1));
+        cy >>= BASEXPWR;
+    }
+}
+
+// Index just past the most significant nonzero limb.
+int32_t TrimmedLength(const MANTTYPE* a, int32_t na)
+{
+    while (na > 0 && a[na - 1] == 0)
+    {
+        na--;
+    }
+    return na;
+}
+
+// Dispatcher over the multiplication tiers; dest must be zeroed on entry and
+// hold na+nb limbs.  Defined after the tiers below.
+void MulSpans(const MANTTYPE* a, int32_t na, const MANTTYPE* b, int32_t nb, MANTTYPE* dest);
+
+// Squaring dispatcher; dest must be zeroed on entry and hold 2*na limbs.
+// Defined after the tiers below.
+void SqrSpans(const MANTTYPE* a, int32_t na, MANTTYPE* dest);
+
+// Smaller operand size at which packing into 62-bit limbs beats the plain
+// 31-bit schoolbook loop.
+constexpr int32_t WIDE_MUL_THRESHOLD = 8;
+
+#if RATPAK_WIDE_MUL
+
+// Minimal 128-bit helpers; MSVC has no __int128 so the x64/ARM64 intrinsics
+// are wrapped instead.
+struct UINT128
+{
+    uint64_t lo;
+    uint64_t hi;
+};
+
+inline UINT128 Mul64x64(uint64_t a, uint64_t b)
+{
+#if defined(_MSC_VER)
+    UINT128 r;
+    r.lo = _umul128(a, b, &r.hi);
+    return r;
+#else
+    unsigned __int128 p = (unsigned __int128)a * b;
+    return { (uint64_t)p, (uint64_t)(p >> 64) };
+#endif
+}
+
+inline void Add128(UINT128& acc, uint64_t v)
+{
+    acc.lo += v;
+    if (acc.lo < v)
+    {
+        acc.hi++;
+    }
+}
+
+// dest[0..na+nb) = a * b.  dest must be zeroed on entry.  Pairs of 31-bit
+// limbs are packed into base-2^62 'digits' so each inner-loop step does one
+// 64x64->128 multiply in place of four 32x32->64 ones, then the product is
+// unpacked; a 62-bit digit splits exactly back into two 31-bit limbs.
+void MulSchoolbookWide(const MANTTYPE* a, int32_t na, const MANTTYPE* b, int32_t nb, MANTTYPE* dest)
+{
+    constexpr uint64_t MASK62 = ((uint64_t)1 << 62) - 1;
+
+    int32_t na64 = (na + 1) / 2;
+    int32_t nb64 = (nb + 1) / 2;
+    std::vector<uint64_t> pa(na64), pb(nb64), prod(na64 + nb64, 0);
+    for (int32_t i = 0; i < na64; i++)
+    {
+        pa[i] = (uint64_t)a[2 * i] | ((2 * i + 1 < na) ? ((uint64_t)a[2 * i + 1] << BASEXPWR) : 0);
+    }
+    for (int32_t i = 0; i < nb64; i++)
+    {
+        pb[i] = (uint64_t)b[2 * i] | ((2 * i + 1 < nb) ? ((uint64_t)b[2 * i + 1] << BASEXPWR) : 0);
+    }
+
+    for (int32_t i = 0; i < na64; i++)
+    {
+        if (pa[i] == 0)
+        {
+            continue;
+        }
+
+        uint64_t cy = 0;
+        for (int32_t j = 0; j < nb64; j++)
+        {
+            UINT128 t = Mul64x64(pa[i], pb[j]);
+            Add128(t, prod[i + j]);
+            Add128(t, cy);
+            prod[i + j] = t.lo & MASK62;
+            cy = (t.hi << 2) | (t.lo >> 62);
+        }
+        for (int32_t k = i + nb64; cy != 0; k++)
+        {
+            uint64_t t = prod[k] + cy;
+            prod[k] = t & MASK62;
+            cy = t >> 62;
+        }
+    }
+
+    // Unpack; positions beyond na+nb are guaranteed zero since the product
+    // fits in na+nb limbs.
+    for (int32_t i = 0; i < na64 + nb64; i++)
+    {
+        if (2 * i < na + nb)
+        {
+            dest[2 * i] = (MANTTYPE)(prod[i] & (BASEX - 1));
+        }
+        if (2 * i + 1 < na + nb)
+        {
+            dest[2 * i + 1] = (MANTTYPE)(prod[i] >> BASEXPWR);
+        }
+    }
+}
+
+// dest[0..2*na) = a * a.  dest must be zeroed on entry.  Same packing as
+// MulSchoolbookWide, with the cross products computed once and doubled.
+void SqrSchoolbookWide(const MANTTYPE* a, int32_t na, MANTTYPE* dest)
+{
+    constexpr uint64_t MASK62 = ((uint64_t)1 << 62) - 1;
+
+    int32_t na64 = (na + 1) / 2;
+    std::vector<uint64_t> pa(na64), prod(2 * na64, 0);
+    for (int32_t i = 0; i < na64; i++)
+    {
+        pa[i] = (uint64_t)a[2 * i] | ((2 * i + 1 < na) ? ((uint64_t)a[2 * i + 1] << BASEXPWR) : 0);
+    }
+
+    for (int32_t i = 0; i < na64; i++)
+    {
+        if (pa[i] == 0)
+        {
+            continue;
+        }
+
+        uint64_t cy = 0;
+        for (int32_t j = i + 1; j < na64; j++)
+        {
+            UINT128 t = Mul64x64(pa[i], pa[j]);
+            Add128(t, prod[i + j]);
+            Add128(t, cy);
+            prod[i + j] = t.lo & MASK62;
+            cy = (t.hi << 2) | (t.lo >> 62);
+        }
+        for (int32_t k = i + na64; cy != 0; k++)
+        {
+            uint64_t t = prod[k] + cy;
+            prod[k] = t & MASK62;
+            cy = t >> 62;
+        }
+    }
+
+    // Double the off-diagonal sum, then add the diagonal squares.
+    uint64_t cy = 0;
+    for (int32_t i = 0; i < 2 * na64; i++)
+    {
+        uint64_t t = (prod[i] << 1) | cy;
+        prod[i] = t & MASK62;
+        cy = t >> 62;
+    }
+
+    for (int32_t i = 0; i < na64; i++)
+    {
+        UINT128 t = Mul64x64(pa[i], pa[i]);
+        Add128(t, prod[2 * i]);
+        prod[2 * i] = t.lo & MASK62;
+        uint64_t dcy = (t.hi << 2) | (t.lo >> 62);
+        for (int32_t k = 2 * i + 1; dcy != 0; k++)
+        {
+            uint64_t u = prod[k] + dcy;
+            prod[k] = u & MASK62;
+            dcy = u >> 62;
+        }
+    }
+
+    // Unpack; positions beyond 2*na are guaranteed zero since the square
+    // fits in 2*na limbs.
+    for (int32_t i = 0; i < 2 * na64; i++)
+    {
+        if (2 * i < 2 * na)
+        {
+            dest[2 * i] = (MANTTYPE)(prod[i] & (BASEX - 1));
+        }
+        if (2 * i + 1 < 2 * na)
+        {
+            dest[2 * i + 1] = (MANTTYPE)(prod[i] >> BASEXPWR);
+        }
+    }
+}
+
+#endif // RATPAK_WIDE_MUL
+
+// dest[0..na+nb) = a * b.  dest must be zeroed on entry.
+// Caller (MulSpans) guarantees na >= nb >= KARATSUBA_THRESHOLD.
+void MulKaratsuba(const MANTTYPE* a, int32_t na, const MANTTYPE* b, int32_t nb, MANTTYPE* dest)
+{
+    int32_t m = (na + 1) / 2;
+    if (nb <= m)
+    {
+        // b only spans the low half of a; split a and recombine two products.
+        // a * b == a0*b + (a1*b << m)
+        MulSpans(a, m, b, nb, dest);
+        std::vector<MANTTYPE> hi((na - m) + nb, 0);
+        MulSpans(a + m, na - m, b, nb, hi.data());
+        AddIntoSpan(dest + m, hi.data(), TrimmedLength(hi.data(), (int32_t)hi.size()));
+        return;
+    }
+
+    // Standard three-multiply split around limb m:
+    // a == a1*B^m + a0, b == b1*B^m + b0
+    // a*b == z2*B^2m + (z1 - z0 - z2)*B^m + z0
+    // with z0 == a0*b0, z2 == a1*b1, z1 == (a0+a1)*(b0+b1)
+    std::vector<MANTTYPE> z0(2 * m, 0);
+    MulSpans(a, m, b, m, z0.data());
+
+    std::vector<MANTTYPE> z2((na - m) + (nb - m), 0);
+    MulSpans(a + m, na - m, b + m, nb - m, z2.data());
+
+    std::vector<MANTTYPE> sa(m + 1, 0);
+    sa[m] = AddSpans(a, m, a + m, na - m, sa.data());
+    std::vector<MANTTYPE> sb(m + 1, 0);
+    sb[m] = AddSpans(b, m, b + m, nb - m, sb.data());
+
+    int32_t salen = TrimmedLength(sa.data(), m + 1);
+    int32_t sblen = TrimmedLength(sb.data(), m + 1);
+    std::vector<MANTTYPE> z1(salen + sblen, 0);
+    MulSpans(sa.data(), salen, sb.data(), sblen, z1.data());
+    SubSpansInPlace(z1.data(), (int32_t)z1.size(), z0.data(), TrimmedLength(z0.data(), (int32_t)z0.size()));
+    SubSpansInPlace(z1.data(), (int32_t)z1.size(), z2.data(), TrimmedLength(z2.data(), (int32_t)z2.size()));
+
+    // Recompose into dest; z0 and z2 land on disjoint zeroed regions, z1
+    // overlaps both and is carry-added.
+    memcpy(dest, z0.data(), z0.size() * sizeof(MANTTYPE));
+    memcpy(dest + 2 * m, z2.data(), z2.size() * sizeof(MANTTYPE));
+    AddIntoSpan(dest + m, z1.data(), TrimmedLength(z1.data(), (int32_t)z1.size()));
+}
+
+// dest[0..2*na) = a * a.  dest must be zeroed on entry.  Same three-way
+// split as MulKaratsuba, except all three sub-products are themselves
+// squares: a^2 == z2*B^2m + (z1 - z0 - z2)*B^m + z0 with z0 == a0^2,
+// z2 == a1^2 and z1 == (a0+a1)^2.
+void SqrKaratsuba(const MANTTYPE* a, int32_t na, MANTTYPE* dest)
+{
+    int32_t m = (na + 1) / 2;
+
+    std::vector<MANTTYPE> z0(2 * m, 0);
+    SqrSpans(a, m, z0.data());
+
+    std::vector<MANTTYPE> z2(2 * (na - m), 0);
+    SqrSpans(a + m, na - m, z2.data());
+
+    std::vector<MANTTYPE> sa(m + 1, 0);
+    sa[m] = AddSpans(a, m, a + m, na - m, sa.data());
+
+    int32_t salen = TrimmedLength(sa.data(), m + 1);
+    std::vector<MANTTYPE> z1(2 * salen, 0);
+    SqrSpans(sa.data(), salen, z1.data());
+    SubSpansInPlace(z1.data(), (int32_t)z1.size(), z0.data(), TrimmedLength(z0.data(), (int32_t)z0.size()));
+    SubSpansInPlace(z1.data(), (int32_t)z1.size(), z2.data(), TrimmedLength(z2.data(), (int32_t)z2.size()));
+
+    // Recompose; z0 and z2 exactly tile the zeroed dest, z1 overlaps both
+    // and is carry-added.
+    memcpy(dest, z0.data(), z0.size() * sizeof(MANTTYPE));
+    memcpy(dest + 2 * m, z2.data(), z2.size() * sizeof(MANTTYPE));
+    AddIntoSpan(dest + m, z1.data(), TrimmedLength(z1.data(), (int32_t)z1.size()));
+}
+
+//-----------------------------------------------------------------------------
+//
+//   Toom-3 tier for the extreme-precision mantissas produced by factrat and
+//   friends.  Splits each operand into three parts, evaluates at the points
+//   0, 1, -1, 2 and infinity (five multiplies of a third the size, versus
+//   nine for schoolbook), and interpolates the product coefficients.  The
+//   interpolation works on small signed scratch integers since intermediate
+//   values can go negative and need exact division by 2 and 3.
+//
+//-----------------------------------------------------------------------------
+
+// Smaller operand must have at least this many limbs before Toom-3 pays for
+// its bookkeeping over Karatsuba.
+constexpr int32_t TOOM3_THRESHOLD = 128;
+
+// Signed arbitrary-precision scratch value; mantissa is least significant
+// limb first and kept trimmed.  Zero is represented by an empty mantissa
+// with sign +1.
+struct SPANINT
+{
+    int32_t sign = 1;
+    std::vector<MANTTYPE> mant;
+};
+
+void TrimSpanInt(SPANINT& x)
+{
+    while (!x.mant.empty() && x.mant.back() == 0)
+    {
+        x.mant.pop_back();
+    }
+    if (x.mant.empty())
+    {
+        x.sign = 1;
+    }
+}
+
+SPANINT SpanIntFrom(const MANTTYPE* a, int32_t na)
+{
+    SPANINT r;
+    r.mant.assign(a, a + TrimmedLength(a, na));
+    return r;
+}
+
+int32_t CompareMag(const std::vector<MANTTYPE>& a, const std::vector<MANTTYPE>& b)
+{
+    if (a.size() != b.size())
+    {
+        return a.size() < b.size() ? -1 : 1;
+    }
+    for (size_t i = a.size(); i-- > 0;)
+    {
+        if (a[i] != b[i])
+        {
+            return a[i] < b[i] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+// a += b * bsign, signed.
+void AddSigned(SPANINT& a, const SPANINT& b, int32_t bsign)
+{
+    if (b.mant.empty())
+    {
+        return;
+    }
+
+    int32_t sb = b.sign * bsign;
+    if (a.mant.empty())
+    {
+        a.mant = b.mant;
+        a.sign = sb;
+        return;
+    }
+
+    if (a.sign == sb)
+    {
+        if (a.mant.size() < b.mant.size())
+        {
+            a.mant.resize(b.mant.size(), 0);
+        }
+        a.mant.push_back(0);
+        AddIntoSpan(a.mant.data(), b.mant.data(), (int32_t)b.mant.size());
+        TrimSpanInt(a);
+        return;
+    }
+
+    int32_t cmp = CompareMag(a.mant, b.mant);
+    if (cmp == 0)
+    {
+        a.mant.clear();
+        a.sign = 1;
+    }
+    else if (cmp > 0)
+    {
+        SubSpansInPlace(a.mant.data(), (int32_t)a.mant.size(), b.mant.data(), (int32_t)b.mant.size());
+        TrimSpanInt(a);
+    }
+    else
+    {
+        std::vector<MANTTYPE> t = b.mant;
+        SubSpansInPlace(t.data(), (int32_t)t.size(), a.mant.data(), (int32_t)a.mant.size());
+        a.mant = std::move(t);
+        a.sign = sb;
+        TrimSpanInt(a);
+    }
+}
+
+// a *= m for a small constant m.
+void MulSmall(SPANINT& a, MANTTYPE m)
+{
+    TWO_MANTTYPE cy = 0;
+    for (auto& d : a.mant)
+    {
+        cy += (TWO_MANTTYPE)d * m;
+        d = (MANTTYPE)(cy & (BASEX - 1));
+        cy >>= BASEXPWR;
+    }
+    while (cy != 0)
+    {
+        a.mant.push_back((MANTTYPE)(cy & (BASEX - 1)));
+        cy >>= BASEXPWR;
+    }
+}
+
+// a /= 2; caller guarantees a is even.
+void DivExact2(SPANINT& a)
+{
+    MANTTYPE highbit = 0;
+    for (size_t i = a.mant.size(); i-- > 0;)
+    {
+        MANTTYPE d = a.mant[i];
+        a.mant[i] = (d >> 1) | (highbit << (BASEXPWR - 1));
+        highbit = d & 1;
+    }
+    TrimSpanInt(a);
+}
+
+// a /= 3; caller guarantees a is an exact multiple of 3.
+void DivExact3(SPANINT& a)
+{
+    TWO_MANTTYPE rem = 0;
+    for (size_t i = a.mant.size(); i-- > 0;)
+    {
+        TWO_MANTTYPE cur = (rem << BASEXPWR) | a.mant[i];
+        a.mant[i] = (MANTTYPE)(cur / 3);
+        rem = cur % 3;
+    }
+    TrimSpanInt(a);
+}
+
+SPANINT MulBig(const SPANINT& a, const SPANINT& b)
+{
+    SPANINT r;
+    if (a.mant.empty() || b.mant.empty())
+    {
+        return r;
+    }
+    r.sign = a.sign * b.sign;
+    r.mant.assign(a.mant.size() + b.mant.size(), 0);
+    MulSpans(a.mant.data(), (int32_t)a.mant.size(), b.mant.data(), (int32_t)b.mant.size(), r.mant.data());
+    TrimSpanInt(r);
+    return r;
+}
+
+// dest[0..na+nb) = a * b via Toom-3; dest zeroed on entry.
+// Caller guarantees na >= nb > 2k with k = ceil(na/3), so both operands
+// genuinely split into three parts.
+void MulToom3(const MANTTYPE* a, int32_t na, const MANTTYPE* b, int32_t nb, int32_t k, MANTTYPE* dest)
+{
+    SPANINT a0 = SpanIntFrom(a, k);
+    SPANINT a1 = SpanIntFrom(a + k, k);
+    SPANINT a2 = SpanIntFrom(a + 2 * k, na - 2 * k);
+    SPANINT b0 = SpanIntFrom(b, k);
+    SPANINT b1 = SpanIntFrom(b + k, k);
+    SPANINT b2 = SpanIntFrom(b + 2 * k, nb - 2 * k);
+
+    // Evaluate both polynomials at 1, -1 and 2.
+    SPANINT ae1 = a0;
+    AddSigned(ae1, a1, 1);
+    AddSigned(ae1, a2, 1);
+    SPANINT aem1 = a0;
+    AddSigned(aem1, a1, -1);
+    AddSigned(aem1, a2, 1);
+    SPANINT ae2 = a2; // 4*a2 + 2*a1 + a0, Horner style
+    MulSmall(ae2, 2);
+    AddSigned(ae2, a1, 1);
+    MulSmall(ae2, 2);
+    AddSigned(ae2, a0, 1);
+
+    SPANINT be1 = b0;
+    AddSigned(be1, b1, 1);
+    AddSigned(be1, b2, 1);
+    SPANINT bem1 = b0;
+    AddSigned(bem1, b1, -1);
+    AddSigned(bem1, b2, 1);
+    SPANINT be2 = b2;
+    MulSmall(be2, 2);
+    AddSigned(be2, b1, 1);
+    MulSmall(be2, 2);
+    AddSigned(be2, b0, 1);
+
+    // Five third-size multiplies.
+    SPANINT v0 = MulBig(a0, b0);
+    SPANINT v1 = MulBig(ae1, be1);
+    SPANINT vm1 = MulBig(aem1, bem1);
+    SPANINT v2 = MulBig(ae2, be2);
+    SPANINT vinf = MulBig(a2, b2);
+
+    // Interpolate the five product coefficients:
+    // w3 = (v2 - vm1)/3           == c1 + c2 + 3*c3 + 5*c4
+    // w1 = (v1 - vm1)/2           == c1 + c3
+    // w2 = v1 - v0                == c1 + c2 + c3 + c4
+    // w3 = (w3 - w2)/2 - 2*vinf   == c3
+    // w2 = w2 - w1 - vinf         == c2
+    // w1 = w1 - w3                == c1
+    SPANINT w3 = v2;
+    AddSigned(w3, vm1, -1);
+    DivExact3(w3);
+    SPANINT w1 = v1;
+    AddSigned(w1, vm1, -1);
+    DivExact2(w1);
+    SPANINT w2 = v1;
+    AddSigned(w2, v0, -1);
+    AddSigned(w3, w2, -1);
+    DivExact2(w3);
+    SPANINT vinf2 = vinf;
+    MulSmall(vinf2, 2);
+    AddSigned(w3, vinf2, -1);
+    AddSigned(w2, w1, -1);
+    AddSigned(w2, vinf, -1);
+    AddSigned(w1, w3, -1);
+
+    // All five coefficients are nonnegative for nonnegative inputs; place
+    // them at their limb offsets, carry-adding the overlaps.
+    if (!v0.mant.empty())
+    {
+        AddIntoSpan(dest, v0.mant.data(), (int32_t)v0.mant.size());
+    }
+    if (!w1.mant.empty())
+    {
+        AddIntoSpan(dest + k, w1.mant.data(), (int32_t)w1.mant.size());
+    }
+    if (!w2.mant.empty())
+    {
+        AddIntoSpan(dest + 2 * k, w2.mant.data(), (int32_t)w2.mant.size());
+    }
+    if (!w3.mant.empty())
+    {
+        AddIntoSpan(dest + 3 * k, w3.mant.data(), (int32_t)w3.mant.size());
+    }
+    if (!vinf.mant.empty())
+    {
+        AddIntoSpan(dest + 4 * k, vinf.mant.data(), (int32_t)vinf.mant.size());
+    }
+}
+
+void MulSpans(const MANTTYPE* a, int32_t na, const MANTTYPE* b, int32_t nb, MANTTYPE* dest)
+{
+    if (na < nb)
+    {
+        std::swap(a, b);
+        std::swap(na, nb);
+    }
+
+    if (nb < KARATSUBA_THRESHOLD)
+    {
+#if RATPAK_WIDE_MUL
+        if (nb >= WIDE_MUL_THRESHOLD)
+        {
+            MulSchoolbookWide(a, na, b, nb, dest);
+            return;
+        }
+#endif
+        MulSchoolbook(a, na, b, nb, dest);
+        return;
+    }
+
+    if (nb >= TOOM3_THRESHOLD)
+    {
+        int32_t k = (na + 2) / 3;
+        if (nb > 2 * k)
+        {
+            MulToom3(a, na, b, nb, k, dest);
+            return;
+        }
+    }
+
+    MulKaratsuba(a, na, b, nb, dest);
+}
+
+// Above this many limbs the Toom-3 multiply tier's better exponent beats
+// the halved base-case cost of Karatsuba squaring (measured crossover is
+// around 1024 limbs, roughly 9500 decimal digits).
+constexpr int32_t SQR_TOOM3_CROSSOVER = 1024;
+
+void SqrSpans(const MANTTYPE* a, int32_t na, MANTTYPE* dest)
+{
+    if (na < KARATSUBA_THRESHOLD)
+    {
+#if RATPAK_WIDE_MUL
+        if (na >= WIDE_MUL_THRESHOLD)
+        {
+            SqrSchoolbookWide(a, na, dest);
+            return;
+        }
+#endif
+        SqrSchoolbook(a, na, dest);
+        return;
+    }
+
+    if (na >= SQR_TOOM3_CROSSOVER)
+    {
+        MulSpans(a, na, a, na, dest);
+        return;
+    }
+
+    SqrKaratsuba(a, na, dest);
+}
+
+// Operand size at which _mulnumx leaves its in-place loop for the span path;
+// on 64-bit targets the packed kernel already wins well below Karatsuba.
+constexpr int32_t SPAN_MUL_THRESHOLD = RATPAK_WIDE_MUL ? WIDE_MUL_THRESHOLD : KARATSUBA_THRESHOLD;
+
+//-----------------------------------------------------------------------------
+//
+//   Newton-Raphson reciprocal division.
+//
+//   The historical _divnumx loop guesses each quotient limb by repeatedly
+//   doubling the divisor, costing ~31 full-width additions per produced limb.
+//   For operands past a handful of limbs it is far cheaper to compute a
+//   scaled reciprocal R ~= BASEX^(m+p)/B by Newton iteration (doubling the
+//   accurate limb count each pass, and riding the fast multiply tiers), take
+//   Q = N*R >> (m+p), and then nudge Q by at most a few ulps so that
+//   0 <= N - Q*B < B, which makes the result the exact floor quotient.
+//
+//   Helpers below work on trimmed little-endian limb vectors.
+//
+//-----------------------------------------------------------------------------
+
+void TrimVec(std::vector<MANTTYPE>& v)
+{
+    while (!v.empty() && v.back() == 0)
+    {
+        v.pop_back();
+    }
+}
+
+// a -= b; caller guarantees a >= b.
+void SubVec(std::vector<MANTTYPE>& a, const std::vector<MANTTYPE>& b)
+{
+    SubSpansInPlace(a.data(), (int32_t)a.size(), b.data(), (int32_t)b.size());
+    TrimVec(a);
+}
+
+// a += 1.
+void IncVec(std::vector<MANTTYPE>& a)
+{
+    for (auto& d : a)
+    {
+        if (++d < BASEX)
+        {
+            return;
+        }
+        d = 0;
+    }
+    a.push_back(1);
+}
+
+// a -= 1; caller guarantees a > 0.
+void DecVec(std::vector<MANTTYPE>& a)
+{
+    for (auto& d : a)
+    {
+        if (d-- != 0)
+        {
+            break;
+        }
+        d = BASEX - 1;
+    }
+    TrimVec(a);
+}
+
+// a = b * c.
+std::vector<MANTTYPE> MulVec(const std::vector<MANTTYPE>& b, const std::vector<MANTTYPE>& c)
+{
+    std::vector<MANTTYPE> r;
+    if (b.empty() || c.empty())
+    {
+        return r;
+    }
+    r.assign(b.size() + c.size(), 0);
+    MulSpans(b.data(), (int32_t)b.size(), c.data(), (int32_t)c.size(), r.data());
+    TrimVec(r);
+    return r;
+}
+
+// One Newton pass: refine R from k to K accurate limbs against the top
+// limbs of B.  R' = R*(2*BASEX^(k+h) - R*Bh) >> (2k+h-K), keeping the scale
+// invariant R ~= BASEX^(m+K)/B.
+void NewtonRecipStep(std::vector<MANTTYPE>& R, const MANTTYPE* b, int32_t m, int32_t k, int32_t K)
+{
+    int32_t h = std::min(m, K + 1);
+    const MANTTYPE* bh = b + (m - h);
+
+    std::vector<MANTTYPE> T(R.size() + h, 0);
+    MulSpans(R.data(), (int32_t)R.size(), bh, h, T.data());
+    TrimVec(T);
+
+    // E = 2*BASEX^(k+h) - T; R never strays near twice the reciprocal so E
+    // stays positive.
+    std::vector<MANTTYPE> E(k + h + 1, 0);
+    E[k + h] = 2;
+    if (CompareMag(E, T) <= 0)
+    {
+        // Defensive: a degenerate seed would wedge the correction loop; make
+        // the caller fall back instead.
+        R.clear();
+        return;
+    }
+    SubVec(E, T);
+
+    std::vector<MANTTYPE> P = MulVec(R, E);
+    int32_t drop = 2 * k + h - K;
+    if ((int32_t)P.size() <= drop)
+    {
+        R.clear();
+        return;
+    }
+    R.assign(P.begin() + drop, P.end());
+    TrimVec(R);
+}
+
+// Returns R ~= BASEX^(m+p)/B for B of m limbs (top limb nonzero), accurate
+// to ~p limbs, always from below within a few ulps.
+std::vector<MANTTYPE> NewtonRecip(const MANTTYPE* b, int32_t m, int32_t p)
+{
+    // Single-limb seed; (d+1) keeps the estimate below the true reciprocal.
+    uint64_t d = b[m - 1];
+    uint64_t r0 = (((uint64_t)1 << (2 * BASEXPWR)) - 1) / (d + 1);
+    std::vector<MANTTYPE> R{ (MANTTYPE)(r0 & (BASEX - 1)), (MANTTYPE)(r0 >> BASEXPWR) };
+    TrimVec(R);
+
+    // Cheap single-limb passes sharpen the seed before the doubling schedule
+    // starts.  The seed can begin with only one accurate bit (top limb 1),
+    // and each pass squares the error, so five passes guarantee a full limb
+    // of accuracy: 2^-1 -> 2^-32.
+    for (int32_t warm = 0; warm < 5 && !R.empty(); warm++)
+    {
+        NewtonRecipStep(R, b, m, 1, 1);
+    }
+
+    int32_t k = 1;
+    while (k < p && !R.empty())
+    {
+        int32_t K = std::min(2 * k, p);
+        NewtonRecipStep(R, b, m, k, K);
+        k = K;
+    }
+    return R;
+}
+
+// Computes *pa = exact floor quotient of (A*BASEX^s)/B in c, or returns
+// false to let the caller run the legacy digit-guess loop.
+bool TryNewtonDivnumx(PNUMBER* pa, PNUMBER b, int32_t s)
+{
+    PNUMBER a = *pa;
+    int32_t na = a->cdigit;
+    int32_t nb = b->cdigit;
+
+    // N = A shifted left s limbs.
+    std::vector<MANTTYPE> N(na + s, 0);
+    memcpy(N.data() + s, a->mant, na * sizeof(MANTTYPE));
+    TrimVec(N);
+
+    std::vector<MANTTYPE> B(b->mant, b->mant + nb);
+    TrimVec(B);
+    if (B.empty())
+    {
+        // Leave division by zero to the legacy loop's behavior.
+        return false;
+    }
+
+    int32_t n = (int32_t)N.size();
+    int32_t m = (int32_t)B.size();
+
+    std::vector<MANTTYPE> Q;
+    if (n >= m)
+    {
+        int32_t q = n - m + 1; // quotient limb bound
+        int32_t p = q + 2;     // reciprocal precision with guard limbs
+
+        std::vector<MANTTYPE> R = NewtonRecip(B.data(), m, p);
+        if (R.empty())
+        {
+            return false;
+        }
+
+        // Q0 = N_top * R >> (nh + 1), using just enough top limbs of N that
+        // the truncation error stays far below one quotient ulp.
+        int32_t nh = std::min(n, q + 3);
+        std::vector<MANTTYPE> Ntop(N.end() - nh, N.end());
+        std::vector<MANTTYPE> P = MulVec(Ntop, R);
+        // Q0 = Ntop*R >> (m + p - (n - nh)); with p = q + 2 that is nh + 3.
+        int32_t drop = nh + 3;
+        if ((int32_t)P.size() > drop)
+        {
+            Q.assign(P.begin() + drop, P.end());
+            TrimVec(Q);
+        }
+
+        // Correction: enforce 0 <= N - Q*B < B, which pins Q to the exact
+        // floor quotient.  The reciprocal guard limbs keep this to a couple
+        // of steps; bail out to the legacy loop if something is off.
+        std::vector<MANTTYPE> QB = MulVec(Q, B);
+        int32_t guard = 8;
+        if (CompareMag(N, QB) >= 0)
+        {
+            std::vector<MANTTYPE> rem = N;
+            if (!QB.empty())
+            {
+                SubVec(rem, QB);
+            }
+            while (CompareMag(rem, B) >= 0)
+            {
+                if (--guard < 0)
+                {
+                    return false;
+                }
+                SubVec(rem, B);
+                IncVec(Q);
+            }
+        }
+        else
+        {
+            std::vector<MANTTYPE> negrem = QB;
+            SubVec(negrem, N);
+            // Q is too big by ceil(negrem / B) steps.
+            while (!negrem.empty())
+            {
+                if (--guard < 0)
+                {
+                    return false;
+                }
+                DecVec(Q);
+                if (CompareMag(negrem, B) <= 0)
+                {
+                    break;
+                }
+                SubVec(negrem, B);
+            }
+        }
+    }
+
+    // Build the result number.
+    PNUMBER c = nullptr;
+    if (Q.empty())
+    {
+        c = i32tonum(0, BASEX);
+        c->sign = a->sign * b->sign;
+    }
+    else
+    {
+        createnum(c, (uint32_t)Q.size());
+        c->cdigit = (int32_t)Q.size();
+        c->sign = a->sign * b->sign;
+        c->exp = a->exp - b->exp - s;
+        memcpy(c->mant, Q.data(), Q.size() * sizeof(MANTTYPE));
+    }
+
+    destroynum(*pa);
+    *pa = c;
+    return true;
+}
+
+// Operand size at which the reciprocal machinery beats the digit-guess loop.
+constexpr int32_t NEWTON_DIV_THRESHOLD = 8;
+
+} // namespace
+
 //----------------------------------------------------------------------------
 //
 //    FUNCTION: mulnumx
@@ -97,6 +1106,35 @@ void _mulnumx( PNUMBER *pa, PNUMBER b )
 
     a=*pa;
 
+    if ( g_ratpakStatsEnabled.load(std::memory_order_relaxed) )
+        {
+        // The grade-school loop performs cdigit(a) * cdigit(b) limb
+        // multiplies regardless of which path below runs.
+        RatpakStatsRecordMul( static_cast<uint64_t>(a->cdigit) * static_cast<uint64_t>(b->cdigit) );
+        }
+
+    if ( std::min( a->cdigit, b->cdigit ) >= SPAN_MUL_THRESHOLD )
+        {
+        // Both operands are large enough for the tiered span path.
+        ibdigit = a->cdigit + b->cdigit;
+        createnum( c, ibdigit );
+        c->cdigit = ibdigit;
+        c->sign = a->sign * b->sign;
+        c->exp = a->exp + b->exp;
+
+        MulSpans( a->mant, a->cdigit, b->mant, b->cdigit, c->mant );
+
+        // strip leading zero limbs, digits are in increasing significance.
+        while ( c->cdigit > 1 && c->mant[c->cdigit-1] == 0 )
+            {
+            c->cdigit--;
+            }
+
+        destroynum( *pa );
+        *pa=c;
+        return;
+        }
+
     ibdigit = a->cdigit + b->cdigit - 1;
     createnum( c,  ibdigit + 1 );
     c->cdigit = ibdigit;
@@ -158,6 +1196,190 @@ void _mulnumx( PNUMBER *pa, PNUMBER b )
     destroynum( *pa );
     *pa=c;
 }
+
+//----------------------------------------------------------------------------
+//
+//    FUNCTION: sqrnumx
+//
+//    ARGUMENTS: pointer to a number, the base is always BASEX.
+//
+//    RETURN: None, changes the pointer.
+//
+//    DESCRIPTION: Does the number equivalent of *pa *= *pa.  Squaring only
+//    needs the upper triangle of partial products, so this is roughly half
+//    the multiplies of the general _mulnumx path.
+//
+//----------------------------------------------------------------------------
+
+void sqrnumx( PNUMBER *pa )
+
+{
+    PNUMBER a= nullptr;
+    PNUMBER c= nullptr;
+    int32_t cdigits;
+
+    a=*pa;
+
+    if ( a->cdigit == 1 && a->mant[0] <= 1 && a->exp == 0 )
+        {
+        // 0, 1 and -1 square to themselves up to sign.
+        a->sign = 1;
+        return;
+        }
+
+    cdigits = a->cdigit * 2;
+    createnum( c, cdigits );
+    c->cdigit = cdigits;
+    c->sign = 1;
+    c->exp = a->exp * 2;
+
+    SqrSpans( a->mant, a->cdigit, c->mant );
+
+    // strip leading zero limbs, digits are in increasing significance.
+    while ( c->cdigit > 1 && c->mant[c->cdigit-1] == 0 )
+        {
+        c->cdigit--;
+        }
+
+    destroynum( *pa );
+    *pa=c;
+}
+
+//-----------------------------------------------------------------------------
+//
+//    FUNCTION: radixpowi32x
+//
+//    ARGUMENTS: radix as uint32_t, power as int32_t.
+//
+//    RETURN: newly allocated number holding radix ** power in base BASEX.
+//            The caller owns the result.
+//
+//    DESCRIPTION: radix conversion and display scaling keep asking for the
+//    same radix powers — every numtonRadixx split needs radix^half and every
+//    exponent scale needs radix^exp.  This keeps a per-thread ladder of
+//    radix^(2^i) squarings, invalidated when the radix changes, so repeated
+//    requests only pay the multiplies for the on bits of the power instead
+//    of re-squaring from scratch each time.  The last full result is kept
+//    too, since conversions of p over q ask for the same power twice in a
+//    row.
+//
+//-----------------------------------------------------------------------------
+
+namespace {
+
+// Powers are positive int32_t, so the highest on bit is at most 30.
+constexpr int32_t RADIXPOW_LADDER_DEPTH = 31;
+
+// Kept trivially destructible on purpose: ReleaseRatpakThreadState runs from
+// a thread_local destructor and must be able to touch this cache without
+// caring about destruction order.
+struct RADIXPOWCACHE
+{
+    uint32_t radix = 0;               // radix the ladder was built for
+    PNUMBER squares[RADIXPOW_LADDER_DEPTH] = {}; // squares[i] holds radix^(2^i)
+    int32_t cSquares = 0;             // entries of the ladder built so far
+    int32_t lastPower = -1;           // most recent power handed out ...
+    PNUMBER lastResult = nullptr;     // ... and the number that went with it
+};
+
+thread_local RADIXPOWCACHE g_radixPowCache;
+
+// Drops the ladder and the memoized last result.
+void ResetRadixPowCache( RADIXPOWCACHE *cache )
+{
+    for ( int32_t i = 0; i < cache->cSquares; i++ )
+        {
+        destroynum( cache->squares[i] );
+        }
+    cache->cSquares = 0;
+    destroynum( cache->lastResult );
+    cache->lastResult = nullptr;
+    cache->lastPower = -1;
+    cache->radix = 0;
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+//
+//    FUNCTION: TrimRadixPowMemoCache
+//
+//    ARGUMENTS: none
+//
+//    RETURN: None, thread locals change.
+//
+//    DESCRIPTION: Releases the calling thread's radix power ladder.  Called
+//    from TrimRatpakPools so the ladder's numbers land on the free lists
+//    before those are drained.
+//
+//-----------------------------------------------------------------------------
+
+void TrimRadixPowMemoCache( void )
+
+{
+    ResetRadixPowCache( &g_radixPowCache );
+}
+
+PNUMBER radixpowi32x( uint32_t radix, int32_t power )
+
+{
+    // Powers of zero or below scale by one, matching numpowi32x.
+    if ( power <= 0 || radix == 0 )
+        {
+        return i32tonum( 1, BASEX );
+        }
+
+    RADIXPOWCACHE *cache = &g_radixPowCache;
+    if ( cache->radix != radix )
+        {
+        // Radix changed, drop the ladder before rebuilding it.
+        ResetRadixPowCache( cache );
+        cache->radix = radix;
+        }
+
+    if ( power == cache->lastPower )
+        {
+        PNUMBER lret = nullptr;
+        DUPNUM( lret, cache->lastResult );
+        return lret;
+        }
+
+    // Extend the squaring ladder far enough to cover the highest on bit.
+    if ( cache->cSquares == 0 )
+        {
+        cache->squares[0] = i32tonum( (int32_t)radix, BASEX );
+        cache->cSquares = 1;
+        }
+    for ( int32_t bit = 1; ( power >> bit ) > 0; bit++ )
+        {
+        if ( bit >= cache->cSquares )
+            {
+            PNUMBER square = nullptr;
+            DUPNUM( square, cache->squares[bit - 1] );
+            sqrnumx( &square );
+            cache->squares[bit] = square;
+            cache->cSquares = bit + 1;
+            }
+        }
+
+    // Multiply together the ladder entries for the on bits of the power.
+    PNUMBER lret = i32tonum( 1, BASEX );
+    for ( int32_t bit = 0; ( power >> bit ) > 0; bit++ )
+        {
+        if ( ( power >> bit ) & 1 )
+            {
+            mulnumx( &lret, cache->squares[bit] );
+            }
+        }
+
+    destroynum( cache->lastResult );
+    cache->lastResult = nullptr;
+    cache->lastPower = power;
+    DUPNUM( cache->lastResult, lret );
+
+    return lret;
+}
+
 //-----------------------------------------------------------------------------
 //
 //    FUNCTION: numpowi32x
@@ -189,12 +1411,15 @@ void numpowi32x( _Inout_ PNUMBER *proot, _In_ int32_t power )
             mulnumx( &lret, *proot );
             }
 
-        // multiply the root number by itself to scale for the next bit (i.e.
-        // square it.
-        mulnumx( proot, *proot );
-
         // move the next bit of the power into place.
         power >>= 1;
+
+        // square the root number to scale for the next bit, unless this was
+        // the last one.
+        if ( power > 0 )
+            {
+            sqrnumx( proot );
+            }
         }
     destroynum( *proot );
     *proot=lret;
@@ -287,6 +1512,18 @@ void _divnumx( PNUMBER *pa, PNUMBER b, int32_t precision)
         thismax = b->cdigit;
         }
 
+    // Reciprocal path for operands big enough that the digit-guess loop's
+    // per-limb doubling passes dominate.  Produces the exact floor quotient
+    // of a scaled by thismax-(na-nb) limbs, matching the loop's truncation.
+    if ( thismax >= NEWTON_DIV_THRESHOLD && !zernum( a ) )
+        {
+        int32_t s = thismax - ( a->cdigit - b->cdigit );
+        if ( s >= 1 && TryNewtonDivnumx( pa, b, s ) )
+            {
+            return;
+            }
+        }
+
     // Create c (the divide answer) and set up exponent and sign.
     createnum( c, thismax + 1 );
     c->exp = (a->cdigit+a->exp) - (b->cdigit+b->exp) + 1;
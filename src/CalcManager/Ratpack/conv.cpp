@@ -29,9 +29,9 @@ static constexpr wstring_view DIGITS = L"0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabc
 
 // ratio of internal 'digits' to output 'digits'
 // Calculated elsewhere as part of initialization and when base is changed
-int32_t g_ratio;    // int(log(2L^BASEXPWR)/log(radix))
+thread_local int32_t g_ratio;    // int(log(2L^BASEXPWR)/log(radix))
 // Default decimal separator
-wchar_t g_decimalSeparator = L'.';
+thread_local wchar_t g_decimalSeparator = L'.';
 
 // The following defines and Calc_ULong* functions were taken from
 // https://github.com/dotnet/coreclr/blob/8b1595b74c943b33fa794e63e440e6f4c9679478/src/pal/inc/rt/intsafe.h
@@ -124,6 +124,190 @@ void* zmalloc(size_t a)
     return calloc(a, sizeof(unsigned char));
 }
 
+//-----------------------------------------------------------------------------
+//
+//   Size-class pool allocator for NUMBER and RAT objects.
+//
+//   Ratpack churns through enormous numbers of short-lived NUMBERs; paying a
+//   heap round trip for every intermediate dominates profiles under command
+//   replay.  Freed blocks are parked on per-thread free lists bucketed by
+//   mantissa capacity and handed back zeroed on the next _createnum of a
+//   compatible size.  Lists are per-thread because each calculator window
+//   drives its engine from its own thread.
+//
+//-----------------------------------------------------------------------------
+
+namespace {
+    // Mantissa capacities (in 'digits') for each size class.  The dedicated
+    // 3-digit class keeps the 1-2 limb values that dominate the per-keystroke
+    // path (typed digits, loop counters, series terms) on their own tiny
+    // blocks where reuse costs a ~40 byte memset.
+    constexpr uint32_t POOL_CLASS_DIGITS[] = { 3, 8, 16, 32, 64, 128, 256 };
+    constexpr uint32_t POOL_CLASS_COUNT = static_cast<uint32_t>(std::size(POOL_CLASS_DIGITS));
+    constexpr uint32_t POOL_CLASS_OVERSIZE = 0xffffffff; // too big to pool, raw heap block
+    constexpr uint32_t POOL_MAX_FREE_PER_CLASS = 128; // bound on parked blocks per class
+
+    // Every pooled block carries its size class in a hidden header just ahead
+    // of the NUMBER, 8 bytes wide to preserve alignment of the mantissa.
+    struct NUMPOOLHDR
+    {
+        uint32_t sizeClass;
+        uint32_t capacity; // digit slots in the block, also keeps NUMBER 8-byte aligned
+    };
+
+    // Free blocks are chained through their own storage.
+    struct NUMPOOLFREE
+    {
+        NUMPOOLFREE* next;
+    };
+
+    thread_local NUMPOOLFREE* t_numFreeList[POOL_CLASS_COUNT] = {};
+    thread_local uint32_t t_numFreeCount[POOL_CLASS_COUNT] = {};
+    thread_local NUMPOOLFREE* t_ratFreeList = nullptr;
+    thread_local uint32_t t_ratFreeCount = 0;
+
+    // Returns the thread's parked blocks to the heap when the thread exits.
+    // Registered at block creation, so the sentinel always outlives whatever
+    // gets parked; owners that park blocks from their own thread_local
+    // destructors drain after themselves, so the lists this sees are only
+    // ever left by ordinary computation.
+    struct POOLDRAIN
+    {
+        ~POOLDRAIN()
+        {
+            TrimRatpakPools();
+        }
+    };
+
+    void EnsureThreadExitDrain()
+    {
+        thread_local POOLDRAIN t_drain;
+    }
+
+    // Bytes needed for a NUMBER whose mantissa holds `digits` digits, plus the
+    // pool header.
+    constexpr size_t PoolBlockSize(uint32_t digits)
+    {
+        return sizeof(NUMPOOLHDR) + sizeof(NUMBER) + digits * sizeof(MANTTYPE);
+    }
+
+    uint32_t PoolClassForDigits(uint32_t digits)
+    {
+        for (uint32_t sizeClass = 0; sizeClass < POOL_CLASS_COUNT; sizeClass++)
+        {
+            if (digits <= POOL_CLASS_DIGITS[sizeClass])
+            {
+                return sizeClass;
+            }
+        }
+        return POOL_CLASS_OVERSIZE;
+    }
+
+    // Upper bound on the 'digits' needed to hold a 32-bit value in the given
+    // radix.  i32tonum/Ui32tonum historically reserved the base-2 worst case
+    // (MAX_LONG_SIZE) for every value; sizing to the radix keeps the small
+    // integers that dominate the per-keystroke path in the smallest pool
+    // class.  In BASEX a 32-bit value never needs more than two limbs.
+    uint32_t MaxDigitsForUi32(uint32_t radix)
+    {
+        if (radix == BASEX)
+        {
+            return 2;
+        }
+        if (radix >= 16)
+        {
+            return 9;
+        }
+        if (radix >= 8)
+        {
+            return 12;
+        }
+        return MAX_LONG_SIZE - 1;
+    }
+
+    // Statistics counters behind g_ratpakStatsEnabled. Relaxed atomics:
+    // the counts are diagnostics, not synchronization, and exactness
+    // across racing threads is not worth fencing the allocation path.
+    struct RatpakStatsCounters
+    {
+        std::atomic<uint64_t> cCreateNum{ 0 };
+        std::atomic<uint64_t> cDestroyNum{ 0 };
+        std::atomic<uint64_t> cPoolHits{ 0 };
+        std::atomic<uint64_t> cHeapAllocs{ 0 };
+        std::atomic<uint64_t> cMulNumX{ 0 };
+        std::atomic<uint64_t> cLimbOps{ 0 };
+        std::atomic<uint64_t> cbLive{ 0 };
+        std::atomic<uint64_t> cbHighWater{ 0 };
+    };
+
+    RatpakStatsCounters s_ratpakStats;
+
+    void RatpakStatsRecordCreate(uint64_t cb, bool fromPool)
+    {
+        s_ratpakStats.cCreateNum.fetch_add(1, std::memory_order_relaxed);
+        (fromPool ? s_ratpakStats.cPoolHits : s_ratpakStats.cHeapAllocs).fetch_add(1, std::memory_order_relaxed);
+
+        uint64_t live = s_ratpakStats.cbLive.fetch_add(cb, std::memory_order_relaxed) + cb;
+        uint64_t highWater = s_ratpakStats.cbHighWater.load(std::memory_order_relaxed);
+        while (live > highWater
+            && !s_ratpakStats.cbHighWater.compare_exchange_weak(highWater, live, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    void RatpakStatsRecordDestroy(uint64_t cb)
+    {
+        s_ratpakStats.cDestroyNum.fetch_add(1, std::memory_order_relaxed);
+
+        // Blocks created before the counters were enabled can be destroyed
+        // after; clamp instead of wrapping.
+        uint64_t live = s_ratpakStats.cbLive.load(std::memory_order_relaxed);
+        while (!s_ratpakStats.cbLive.compare_exchange_weak(live, (cb < live) ? live - cb : 0, std::memory_order_relaxed))
+        {
+        }
+    }
+}
+
+std::atomic<bool> g_ratpakStatsEnabled{ false };
+
+void EnableRatpakStats(bool enable)
+{
+    g_ratpakStatsEnabled.store(enable, std::memory_order_relaxed);
+}
+
+RATPAK_STATS GetRatpakStats()
+{
+    RATPAK_STATS stats;
+    stats.cCreateNum = s_ratpakStats.cCreateNum.load(std::memory_order_relaxed);
+    stats.cDestroyNum = s_ratpakStats.cDestroyNum.load(std::memory_order_relaxed);
+    stats.cPoolHits = s_ratpakStats.cPoolHits.load(std::memory_order_relaxed);
+    stats.cHeapAllocs = s_ratpakStats.cHeapAllocs.load(std::memory_order_relaxed);
+    stats.cMulNumX = s_ratpakStats.cMulNumX.load(std::memory_order_relaxed);
+    stats.cLimbOps = s_ratpakStats.cLimbOps.load(std::memory_order_relaxed);
+    stats.cbLive = s_ratpakStats.cbLive.load(std::memory_order_relaxed);
+    stats.cbHighWater = s_ratpakStats.cbHighWater.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void ResetRatpakStats()
+{
+    s_ratpakStats.cCreateNum.store(0, std::memory_order_relaxed);
+    s_ratpakStats.cDestroyNum.store(0, std::memory_order_relaxed);
+    s_ratpakStats.cPoolHits.store(0, std::memory_order_relaxed);
+    s_ratpakStats.cHeapAllocs.store(0, std::memory_order_relaxed);
+    s_ratpakStats.cMulNumX.store(0, std::memory_order_relaxed);
+    s_ratpakStats.cLimbOps.store(0, std::memory_order_relaxed);
+
+    // cbLive is a level, not a rate; carry it over and rebaseline the peak.
+    s_ratpakStats.cbHighWater.store(s_ratpakStats.cbLive.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+void RatpakStatsRecordMul(uint64_t limbOps)
+{
+    s_ratpakStats.cMulNumX.fetch_add(1, std::memory_order_relaxed);
+    s_ratpakStats.cLimbOps.fetch_add(limbOps, std::memory_order_relaxed);
+}
+
 //-----------------------------------------------------------------------------
 //
 //    FUNCTION: _dupnum
@@ -141,6 +325,73 @@ void _dupnum(_In_ PNUMBER dest, _In_ const NUMBER * const src)
     memcpy(dest, src, (int)(sizeof(NUMBER) + ((src)->cdigit)*(sizeof(MANTTYPE))));
 }
 
+//-----------------------------------------------------------------------------
+//
+//    FUNCTION: dupnum
+//
+//    ARGUMENTS: pointer to the destination number pointer, source number
+//
+//    RETURN: None
+//
+//    DESCRIPTION: Smashes the destination with a copy of the source,
+//    reusing the destination's existing block when it has the capacity.
+//    DUPNUM runs at the top of nearly every rational operation, so
+//    skipping the destroy/create round trip there keeps the hot loops
+//    allocation free.
+//
+//-----------------------------------------------------------------------------
+
+void dupnum( _Inout_ PNUMBER *pa, _In_ const NUMBER * const b )
+
+{
+    if ( *pa == b )
+        {
+        return;
+        }
+    if ( *pa != nullptr )
+        {
+        NUMPOOLHDR* hdr = reinterpret_cast<NUMPOOLHDR*>(*pa) - 1;
+        // Keep the one digit of headroom _createnum guarantees.
+        if ( hdr->capacity >= static_cast<uint32_t>(b->cdigit) + 1 )
+            {
+            _dupnum( *pa, b );
+            return;
+            }
+        _destroynum( *pa );
+        *pa = nullptr;
+        }
+    createnum( *pa, b->cdigit );
+    _dupnum( *pa, b );
+}
+
+//-----------------------------------------------------------------------------
+//
+//    FUNCTION: duprat
+//
+//    ARGUMENTS: pointer to the destination rational pointer, source rational
+//
+//    RETURN: None
+//
+//    DESCRIPTION: Smashes the destination with a copy of the source,
+//    reusing the destination's RAT shell and number blocks when possible.
+//
+//-----------------------------------------------------------------------------
+
+void duprat( _Inout_ PRAT *pa, _In_ PRAT b )
+
+{
+    if ( *pa == b )
+        {
+        return;
+        }
+    if ( *pa == nullptr )
+        {
+        createrat( *pa );
+        }
+    dupnum( &((*pa)->pp), b->pp );
+    dupnum( &((*pa)->pq), b->pq );
+}
+
 //-----------------------------------------------------------------------------
 //
 //    FUNCTION: _destroynum
@@ -150,6 +401,8 @@ void _dupnum(_In_ PNUMBER dest, _In_ const NUMBER * const src)
 //    RETURN: None
 //
 //    DESCRIPTION: Deletes the number and associated allocation
+//    Pooled blocks are parked on the per-thread free list for reuse;
+//    oversize blocks go straight back to the heap.
 //
 //-----------------------------------------------------------------------------
 
@@ -158,7 +411,23 @@ void _destroynum( _In_ PNUMBER pnum )
 {
     if ( pnum != nullptr)
         {
-        free( pnum );
+        NUMPOOLHDR* hdr = reinterpret_cast<NUMPOOLHDR*>(pnum) - 1;
+        uint32_t sizeClass = hdr->sizeClass;
+        if ( g_ratpakStatsEnabled.load(std::memory_order_relaxed) )
+            {
+            RatpakStatsRecordDestroy( PoolBlockSize( hdr->capacity ) );
+            }
+        if ( sizeClass < POOL_CLASS_COUNT && t_numFreeCount[sizeClass] < POOL_MAX_FREE_PER_CLASS )
+            {
+            NUMPOOLFREE* node = reinterpret_cast<NUMPOOLFREE*>(hdr);
+            node->next = t_numFreeList[sizeClass];
+            t_numFreeList[sizeClass] = node;
+            t_numFreeCount[sizeClass]++;
+            }
+        else
+            {
+            free( hdr );
+            }
         }
 }
 
@@ -183,8 +452,63 @@ void _destroyrat( _In_ PRAT prat )
         {
         destroynum( prat->pp );
         destroynum( prat->pq );
-        free( prat );
+        if ( t_ratFreeCount < POOL_MAX_FREE_PER_CLASS )
+            {
+            NUMPOOLFREE* node = reinterpret_cast<NUMPOOLFREE*>(prat);
+            node->next = t_ratFreeList;
+            t_ratFreeList = node;
+            t_ratFreeCount++;
+            }
+        else
+            {
+            free( prat );
+            }
+        }
+}
+
+
+//-----------------------------------------------------------------------------
+//
+//    FUNCTION: TrimRatpakPools
+//
+//    ARGUMENTS: None
+//
+//    RETURN: None
+//
+//    DESCRIPTION: Returns every block parked on the calling thread's free
+//    lists to the heap.  Called under memory pressure; the lists refill
+//    naturally as the thread computes again, so trimming costs only the
+//    next burst's allocation round trips.
+//
+//-----------------------------------------------------------------------------
+
+void TrimRatpakPools(void)
+
+{
+    // Drop the memo caches first so their numbers land on the free lists
+    // below before those are released.
+    TrimPowMemoCache();
+    TrimReduceMemoCache();
+    TrimHypExpMemoCache();
+    TrimRadixPowMemoCache();
+
+    for ( uint32_t sizeClass = 0; sizeClass < POOL_CLASS_COUNT; sizeClass++ )
+        {
+        while ( t_numFreeList[sizeClass] != nullptr )
+            {
+            NUMPOOLFREE* node = t_numFreeList[sizeClass];
+            t_numFreeList[sizeClass] = node->next;
+            free( node );
+            }
+        t_numFreeCount[sizeClass] = 0;
         }
+    while ( t_ratFreeList != nullptr )
+        {
+        NUMPOOLFREE* node = t_ratFreeList;
+        t_ratFreeList = node->next;
+        free( node );
+        }
+    t_ratFreeCount = 0;
 }
 
 
@@ -197,31 +521,67 @@ void _destroyrat( _In_ PRAT prat )
 //    RETURN: pointer to a number
 //
 //    DESCRIPTION: allocates and zeros out number type.
+//    Satisfied from the per-thread size-class pool when a parked block of
+//    sufficient capacity is available, falling back to the heap otherwise.
 //
 //-----------------------------------------------------------------------------
 
 PNUMBER _createnum( _In_ uint32_t size )
 
 {
-    PNUMBER pnumret= nullptr;
+    uint32_t cdigitAlloc;
+
+    EnsureThreadExitDrain();
+
+    // One extra 'digit' of headroom, same as the historical allocation.
+    if (FAILED(Calc_ULongAdd(size, 1, &cdigitAlloc)))
+    {
+        throw( CALC_E_INVALIDRANGE );
+    }
+
+    uint32_t sizeClass = PoolClassForDigits(cdigitAlloc);
+    if ( sizeClass < POOL_CLASS_COUNT && t_numFreeList[sizeClass] != nullptr )
+        {
+        // Reuse a parked block; callers rely on zeroed storage.
+        NUMPOOLHDR* hdr = reinterpret_cast<NUMPOOLHDR*>(t_numFreeList[sizeClass]);
+        t_numFreeList[sizeClass] = t_numFreeList[sizeClass]->next;
+        t_numFreeCount[sizeClass]--;
+        memset( hdr, 0, PoolBlockSize( POOL_CLASS_DIGITS[sizeClass] ) );
+        hdr->sizeClass = sizeClass;
+        hdr->capacity = POOL_CLASS_DIGITS[sizeClass];
+        if ( g_ratpakStatsEnabled.load(std::memory_order_relaxed) )
+            {
+            RatpakStatsRecordCreate( PoolBlockSize( hdr->capacity ), true /* fromPool */ );
+            }
+        return reinterpret_cast<PNUMBER>(hdr + 1);
+        }
+
+    // Round pooled classes up to class capacity so the block is reusable for
+    // any allocation in the class; oversize requests get an exact-size block.
     uint32_t cbAlloc;
+    uint32_t cdigitBlock = ( sizeClass < POOL_CLASS_COUNT ) ? POOL_CLASS_DIGITS[sizeClass] : cdigitAlloc;
 
     // sizeof( MANTTYPE ) is the size of a 'digit'
-    if (SUCCEEDED(Calc_ULongAdd(size, 1, &cbAlloc)) &&
-        SUCCEEDED(Calc_ULongMult(cbAlloc, sizeof(MANTTYPE), &cbAlloc)) &&
-        SUCCEEDED(Calc_ULongAdd(cbAlloc, sizeof(NUMBER), &cbAlloc)))
+    if (SUCCEEDED(Calc_ULongMult(cdigitBlock, sizeof(MANTTYPE), &cbAlloc)) &&
+        SUCCEEDED(Calc_ULongAdd(cbAlloc, sizeof(NUMBER) + sizeof(NUMPOOLHDR), &cbAlloc)))
     {
-        pnumret = (PNUMBER)zmalloc( cbAlloc );
-        if ( pnumret == nullptr)
+        NUMPOOLHDR* hdr = (NUMPOOLHDR*)zmalloc( cbAlloc );
+        if ( hdr == nullptr)
         {
             throw( CALC_E_OUTOFMEMORY );
         }
+        hdr->sizeClass = sizeClass;
+        hdr->capacity = cdigitBlock;
+        if ( g_ratpakStatsEnabled.load(std::memory_order_relaxed) )
+            {
+            RatpakStatsRecordCreate( PoolBlockSize( hdr->capacity ), false /* fromPool */ );
+            }
+        return reinterpret_cast<PNUMBER>(hdr + 1);
     }
     else
     {
         throw( CALC_E_INVALIDRANGE );
     }
-    return( pnumret );
 }
 
 //-----------------------------------------------------------------------------
@@ -244,7 +604,18 @@ PRAT _createrat( void )
 {
     PRAT prat= nullptr;
 
-    prat = (PRAT)zmalloc( sizeof( RAT ) );
+    EnsureThreadExitDrain();
+
+    if ( t_ratFreeList != nullptr )
+    {
+        prat = reinterpret_cast<PRAT>(t_ratFreeList);
+        t_ratFreeList = t_ratFreeList->next;
+        t_ratFreeCount--;
+    }
+    else
+    {
+        prat = (PRAT)zmalloc( sizeof( RAT ) );
+    }
 
     if ( prat == nullptr)
     {
@@ -317,14 +688,168 @@ PRAT numtorat( _In_ PNUMBER pin, uint32_t radix)
 //
 //----------------------------------------------------------------------------
 
+namespace {
+    // Below this many BASEX limbs the bit-by-bit doubling loop is cheap
+    // enough; above it the divide-and-conquer split pays off.
+    constexpr int32_t RADIX_CONV_THRESHOLD = 8;
+
+    // Converts an integral BASEX number (exp == 0, sign ignored) to its
+    // digit string in the given radix, least significant digit first, with
+    // no leading zeros (zero converts to an empty vector).
+    //
+    // Large numbers are split as A = Q*radix^h + R around half the expected
+    // output length, so both halves convert independently and the combine
+    // step is digit concatenation; the divide rides the fast BASEX division.
+    vector<MANTTYPE> BasexToRadixDigits(_In_ PNUMBER a, uint32_t radix)
+    {
+        vector<MANTTYPE> digits;
+
+        if (a->cdigit <= RADIX_CONV_THRESHOLD)
+        {
+            // Classic doubling loop over the bits, MSB to LSB.
+            PNUMBER sum = i32tonum(0, radix);
+            for (MANTTYPE* ptr = &(a->mant[a->cdigit - 1]); ptr >= a->mant; ptr--)
+            {
+                for (uint32_t bitmask = BASEX / 2; bitmask > 0; bitmask /= 2)
+                {
+                    addnum(&sum, sum, radix);
+                    if (*ptr & bitmask)
+                    {
+                        sum->mant[0] |= 1;
+                    }
+                }
+            }
+            if (!zernum(sum))
+            {
+                digits.assign(sum->mant, sum->mant + sum->cdigit);
+            }
+            destroynum(sum);
+            return digits;
+        }
+
+        // Split around half of the expected output digit count.
+        int32_t h = (a->cdigit * g_ratio) / 2;
+        if (h < 1)
+        {
+            h = 1;
+        }
+
+        PNUMBER power = radixpowi32x(radix, h);
+
+        // Q = trunc(a / power); divnumx truncates at or just below the true
+        // quotient, the remainder correction below settles the difference.
+        PNUMBER q = nullptr;
+        DUPNUM(q, a);
+        q->sign = 1;
+        divnumx(&q, power, a->cdigit);
+        if (q->exp < 0)
+        {
+            int32_t drop = -q->exp;
+            if (drop >= q->cdigit)
+            {
+                q->cdigit = 1;
+                q->mant[0] = 0;
+            }
+            else
+            {
+                memmove(q->mant, q->mant + drop, (q->cdigit - drop) * sizeof(MANTTYPE));
+                q->cdigit -= drop;
+            }
+            q->exp = 0;
+        }
+        else if (q->exp > 0)
+        {
+            // Materialize the implicit trailing zeros so the recursion only
+            // ever sees exp == 0 integers.
+            PNUMBER shifted = nullptr;
+            createnum(shifted, q->cdigit + q->exp);
+            shifted->cdigit = q->cdigit + q->exp;
+            shifted->exp = 0;
+            shifted->sign = 1;
+            memcpy(shifted->mant + q->exp, q->mant, q->cdigit * sizeof(MANTTYPE));
+            destroynum(q);
+            q = shifted;
+        }
+
+        if (zernum(q))
+        {
+            // The split produced nothing; the dividend was smaller than
+            // radix^h.  Convert it directly rather than recursing in place.
+            destroynum(power);
+            destroynum(q);
+            PNUMBER sum = i32tonum(0, radix);
+            for (MANTTYPE* ptr = &(a->mant[a->cdigit - 1]); ptr >= a->mant; ptr--)
+            {
+                for (uint32_t bitmask = BASEX / 2; bitmask > 0; bitmask /= 2)
+                {
+                    addnum(&sum, sum, radix);
+                    if (*ptr & bitmask)
+                    {
+                        sum->mant[0] |= 1;
+                    }
+                }
+            }
+            if (!zernum(sum))
+            {
+                digits.assign(sum->mant, sum->mant + sum->cdigit);
+            }
+            destroynum(sum);
+            return digits;
+        }
+
+        // R = a - Q*power, then settle 0 <= R < power.
+        PNUMBER r = nullptr;
+        DUPNUM(r, a);
+        r->sign = 1;
+        PNUMBER t = nullptr;
+        DUPNUM(t, q);
+        mulnumx(&t, power);
+        t->sign = -1;
+        addnum(&r, t, BASEX);
+        destroynum(t);
+        while (r->sign < 0 && !zernum(r))
+        {
+            addnum(&r, power, BASEX);
+            PNUMBER one = i32tonum(-1, BASEX);
+            addnum(&q, one, BASEX);
+            destroynum(one);
+        }
+        while (!lessnum(r, power))
+        {
+            power->sign = -1;
+            addnum(&r, power, BASEX);
+            power->sign = 1;
+            PNUMBER one = i32tonum(1, BASEX);
+            addnum(&q, one, BASEX);
+            destroynum(one);
+        }
+
+        std::vector<MANTTYPE> low = BasexToRadixDigits(r, radix);
+        std::vector<MANTTYPE> high;
+        if (!zernum(q))
+        {
+            high = BasexToRadixDigits(q, radix);
+        }
+
+        destroynum(power);
+        destroynum(q);
+        destroynum(r);
+
+        if (high.empty())
+        {
+            return low;
+        }
+        low.resize(h, 0);
+        low.insert(low.end(), high.begin(), high.end());
+        return low;
+    }
+}
+
 PNUMBER nRadixxtonum( _In_ PNUMBER a, uint32_t radix, int32_t precision)
 
 {
-    uint32_t bitmask;
     uint32_t cdigits;
-    MANTTYPE *ptr;
 
-    PNUMBER sum = i32tonum( 0, radix );
     PNUMBER powofnRadix = i32tonum( BASEX, radix );
 
     // A large penalty is paid for conversion of digits no one will see anyway.
@@ -339,19 +864,29 @@ PNUMBER nRadixxtonum( _In_ PNUMBER a, uint32_t radix, int32_t precision)
     // scale by the internal base to the internal exponent offset of the LSD
     numpowi32( &powofnRadix, a->exp + (a->cdigit - cdigits), radix, precision);
 
-    // Loop over all the relative digits from MSD to LSD
-    for ( ptr = &(a->mant[a->cdigit-1]); cdigits > 0;
-        ptr--, cdigits-- )
+    // Convert the integer formed by the top cdigits limbs.
+    PNUMBER intpart = nullptr;
+    createnum( intpart, cdigits );
+    intpart->cdigit = cdigits;
+    intpart->exp = 0;
+    intpart->sign = 1;
+    memcpy( intpart->mant, &a->mant[a->cdigit - cdigits], cdigits * sizeof(MANTTYPE) );
+
+    std::vector<MANTTYPE> digits = BasexToRadixDigits( intpart, radix );
+    destroynum( intpart );
+
+    PNUMBER sum = nullptr;
+    if ( digits.empty() )
         {
-        // Loop over all the bits from MSB to LSB
-        for ( bitmask = BASEX/2; bitmask > 0; bitmask /= 2 )
-            {
-            addnum( &sum, sum, radix );
-            if ( *ptr & bitmask )
-                {
-                sum->mant[0] |= 1;
-                }
-            }
+        sum = i32tonum( 0, radix );
+        }
+    else
+        {
+        createnum( sum, static_cast<uint32_t>(digits.size()) );
+        sum->cdigit = static_cast<int32_t>(digits.size());
+        sum->exp = 0;
+        sum->sign = 1;
+        memcpy( sum->mant, digits.data(), digits.size() * sizeof(MANTTYPE) );
         }
 
     // Scale answer by power of internal exponent.
@@ -376,31 +911,64 @@ PNUMBER nRadixxtonum( _In_ PNUMBER a, uint32_t radix, int32_t precision)
 //
 //-----------------------------------------------------------------------------
 
-PNUMBER numtonRadixx(_In_ PNUMBER a, uint32_t radix)
-{
-    PNUMBER pnumret = i32tonum(0, BASEX); // pnumret is the number in internal form.
-    PNUMBER num_radix = i32tonum(radix, BASEX);
-    MANTTYPE *ptrdigit = a->mant; // pointer to digit being worked on.
+namespace {
+    // Below this many source digits plain Horner evaluation is cheap enough;
+    // above it the divide-and-conquer split pays off.
+    constexpr int32_t RADIX_HORNER_THRESHOLD = 64;
+
+    // Converts a digit span (LSD first) in the given radix to an integral
+    // BASEX number.  Large spans split in half and combine as
+    // high*radix^half + low, so the work rides the subquadratic BASEX
+    // multiply instead of one full-width multiply per digit.
+    PNUMBER RadixDigitsToBasex(_In_reads_(cdigit) const MANTTYPE* digits, int32_t cdigit, uint32_t radix)
+    {
+        if (cdigit <= RADIX_HORNER_THRESHOLD)
+        {
+            PNUMBER pnumret = i32tonum(0, BASEX);
+            PNUMBER num_radix = i32tonum(radix, BASEX);
 
-    // Digits are in reverse order, back over them LSD first.
-    ptrdigit += a->cdigit-1;
+            // Digits are in reverse order, back over them MSD first.
+            const MANTTYPE* ptrdigit = digits + cdigit - 1;
 
-    PNUMBER thisdigit = nullptr;      // thisdigit holds the current digit of a
-                                   // being summed into result.
-    int32_t idigit;                   // idigit is the iterate of digits in a.
-    for ( idigit = 0; idigit < a->cdigit; idigit++ )
-        {
-        mulnumx( &pnumret, num_radix);
-        // WARNING:
-        // This should just smack in each digit into a 'special' thisdigit.
-        // and not do the overhead of recreating the number type each time.
-        thisdigit = i32tonum( *ptrdigit--, BASEX );
-        addnum( &pnumret, thisdigit, BASEX );
-        destroynum( thisdigit );
+            PNUMBER thisdigit = nullptr;      // thisdigit holds the current digit of a
+                                           // being summed into result.
+            int32_t idigit;                   // idigit is the iterate of digits in a.
+            for ( idigit = 0; idigit < cdigit; idigit++ )
+                {
+                mulnumx( &pnumret, num_radix);
+                // WARNING:
+                // This should just smack in each digit into a 'special' thisdigit.
+                // and not do the overhead of recreating the number type each time.
+                thisdigit = i32tonum( *ptrdigit--, BASEX );
+                addnum( &pnumret, thisdigit, BASEX );
+                destroynum( thisdigit );
+                }
+
+            destroynum( num_radix );
+            return pnumret;
         }
 
+        int32_t half = cdigit / 2;
+        PNUMBER low = RadixDigitsToBasex(digits, half, radix);
+        PNUMBER high = RadixDigitsToBasex(digits + half, cdigit - half, radix);
+
+        PNUMBER power = radixpowi32x(radix, half);
+        mulnumx(&high, power);
+        addnum(&high, low, BASEX);
+
+        destroynum(power);
+        destroynum(low);
+        return high;
+    }
+}
+
+PNUMBER numtonRadixx(_In_ PNUMBER a, uint32_t radix)
+{
+    // pnumret is the number in internal form.
+    PNUMBER pnumret = RadixDigitsToBasex(a->mant, a->cdigit, radix);
+
     // Calculate the exponent of the external base for scaling.
-    numpowi32x( &num_radix, a->exp );
+    PNUMBER num_radix = radixpowi32x( radix, a->exp );
 
     // ... and scale the result.
     mulnumx( &pnumret, num_radix);
@@ -484,8 +1052,7 @@ PRAT StringToRat(bool mantissaIsNegative, wstring_view mantissa, bool exponentIs
     }
 
     // Convert native integral exponent form to rational multiplier form.
-    PNUMBER pnumexp = i32tonum(radix, BASEX);
-    numpowi32x(&pnumexp, abs(expt));
+    PNUMBER pnumexp = radixpowi32x(radix, abs(expt));
 
     PRAT pratexp = nullptr;
     createrat(pratexp);
@@ -635,32 +1202,136 @@ static constexpr uint8_t machine[ERR+1][EX+1]= {
         {     ERR,    ERR,     ERR,     ERR,    ERR }
 };
 
-wchar_t NormalizeCharDigit(wchar_t c, uint32_t radix)
+// Digit values indexed by character, built from DIGITS at compile time so the
+// scanner never walks the digit string per character.  Entries hold the value
+// of the character as a digit, or -1 for characters outside DIGITS.
+struct DIGITVALUES
+{
+    int8_t value[128];
+};
+
+static constexpr DIGITVALUES BuildDigitValues()
+{
+    DIGITVALUES table{};
+    for (auto& entry : table.value)
+    {
+        entry = -1;
+    }
+    for (size_t i = 0; i < DIGITS.size(); i++)
+    {
+        table.value[DIGITS[i]] = static_cast<int8_t>(i);
+    }
+    return table;
+}
+
+static constexpr DIGITVALUES DIGIT_VALUES = BuildDigitValues();
+
+// Radix range in which upper and lower case letters are folded together.
+static constexpr uint32_t CASE_FOLD_RADIX_MIN = static_cast<uint32_t>(DIGITS.find(L'A'));
+static constexpr uint32_t CASE_FOLD_RADIX_MAX = static_cast<uint32_t>(DIGITS.find(L'Z'));
+
+// Table-backed equivalent of normalizing the character's case and searching
+// DIGITS; returns the value of c as a digit, or -1 if c is not a digit.
+static int32_t DigitValue(wchar_t c, uint32_t radix)
 {
     // Allow upper and lower case letters as equivalent, base
     // is in the range where this is not ambiguous.
-    if (size_t{ radix } >= DIGITS.find(L'A') && size_t { radix } <= DIGITS.find(L'Z'))
+    if (c >= L'a' && c <= L'z' && radix >= CASE_FOLD_RADIX_MIN && radix <= CASE_FOLD_RADIX_MAX)
     {
-        return towupper(c);
+        c -= L'a' - L'A';
     }
 
-    return c;
+    return (static_cast<uint32_t>(c) < static_cast<uint32_t>(size(DIGIT_VALUES.value))) ? DIGIT_VALUES.value[c] : -1;
 }
 
 PNUMBER StringToNumber(wstring_view numberString, uint32_t radix, int32_t precision)
 {
+    // If we don't have a number, clear our result.
+    if (numberString.empty())
+    {
+        return nullptr;
+    }
+
     int32_t expSign = 1L;           // expSign is exponent sign ( +/- 1 )
     int32_t expValue = 0L;          // expValue is exponent mantissa, should be unsigned
+    int32_t mantDigits = 0;         // count of mantissa digits scanned
+
+    // First pass: drive the state machine over the whole string without
+    // storing anything, validating the input and counting the mantissa
+    // digits so the NUMBER below gets one exact-size allocation instead of
+    // one digit per input character (signs, separators and the exponent all
+    // inflate the character count).
+    uint8_t state = START; // state is the state of the input state machine.
+    wchar_t curChar;
+    for (const auto& c : numberString)
+    {
+        // If the character is the decimal separator, use L'.' for the purposes of the state machine.
+        curChar = (c == g_decimalSeparator ? L'.' : c);
+
+        // Switch states based on the character we encountered
+        switch (curChar)
+        {
+        case L'-':
+        case L'+':
+            state = machine[state][SG];
+            break;
+        case L'.':
+            state = machine[state][DP];
+            break;
+        case L'0':
+            state = machine[state][ZR];
+            break;
+        case L'^':
+        case L'e':
+            if (curChar == L'^' || radix == 10)
+            {
+                state = machine[state][EX];
+                break;
+            }
+            // Drop through in the 'e'-as-a-digit case
+            [[fallthrough]];
+        default:
+            state = machine[state][NZ];
+            break;
+        }
+
+        switch (state)
+        {
+        case EXPDZ:
+        case EXPD:
+            if (DigitValue(curChar, radix) < 0)
+            {
+                state = ERR;
+            }
+            break;
+        case LD:
+        case DD:
+            {
+                int32_t pos = DigitValue(curChar, radix);
+                if (pos >= 0 && pos < static_cast<int32_t>(radix))
+                {
+                    mantDigits++;
+                }
+                else
+                {
+                    state = ERR;
+                }
+            }
+            break;
+        }
+    }
 
     PNUMBER pnumret = nullptr;
-    createnum(pnumret, static_cast<uint32_t>(numberString.length()));
+    createnum(pnumret, max(mantDigits, 1));
     pnumret->sign = 1L;
-    pnumret->cdigit = 0;
+    pnumret->cdigit = mantDigits;
     pnumret->exp = 0;
-    MANTTYPE *pmant = pnumret->mant + numberString.length() - 1;
+    MANTTYPE *pmant = pnumret->mant + mantDigits - 1;
 
-    uint8_t state = START; // state is the state of the input state machine.
-    wchar_t curChar;
+    // Second pass: fill the mantissa most significant digit first and pick
+    // up the signs and the exponent.  The states evolve exactly as in the
+    // first pass, so precisely mantDigits digits get stored.
+    state = START;
     for (const auto& c : numberString)
     {
         // If the character is the decimal separator, use L'.' for the purposes of the state machine.
@@ -706,13 +1377,11 @@ PNUMBER StringToNumber(wstring_view numberString, uint32_t radix, int32_t precis
         case EXPDZ:
         case EXPD:
             {
-                curChar = NormalizeCharDigit(curChar, radix);
-
-                size_t pos = DIGITS.find(curChar);
-                if (pos != wstring_view::npos)
+                int32_t pos = DigitValue(curChar, radix);
+                if (pos >= 0)
                 {
                     expValue *= radix;
-                    expValue += static_cast<int32_t>(pos);
+                    expValue += pos;
                 }
                 else
                 {
@@ -725,14 +1394,11 @@ PNUMBER StringToNumber(wstring_view numberString, uint32_t radix, int32_t precis
             [[fallthrough]];
         case DD:
             {
-                curChar = NormalizeCharDigit(curChar, radix);
-
-                size_t pos = DIGITS.find(curChar);
-                if (pos != wstring_view::npos && pos < static_cast<size_t>(radix))
+                int32_t pos = DigitValue(curChar, radix);
+                if (pos >= 0 && pos < static_cast<int32_t>(radix))
                 {
                     *pmant-- = static_cast<MANTTYPE>(pos);
                     pnumret->exp--;
-                    pnumret->cdigit++;
                 }
                 else
                 {
@@ -758,22 +1424,9 @@ PNUMBER StringToNumber(wstring_view numberString, uint32_t radix, int32_t precis
     }
     else
     {
-        while (pnumret->cdigit < static_cast<int32_t>(numberString.length()))
-        {
-            pnumret->cdigit++;
-            pnumret->exp--;
-        }
-
         pnumret->exp += expSign * expValue;
     }
 
-    // If we don't have a number, clear our result.
-    if (pnumret->cdigit == 0)
-    {
-        destroynum(pnumret);
-        pnumret = nullptr;
-    }
-
     stripzeroesnum(pnumret, precision);
 
     return pnumret;
@@ -845,7 +1498,7 @@ PNUMBER i32tonum( int32_t ini32, uint32_t radix)
     MANTTYPE *pmant;
     PNUMBER pnumret= nullptr;
 
-    createnum( pnumret, MAX_LONG_SIZE );
+    createnum( pnumret, MaxDigitsForUi32( radix ) );
     pmant = pnumret->mant;
     pnumret->cdigit = 0;
     pnumret->exp = 0;
@@ -888,7 +1541,7 @@ PNUMBER Ui32tonum(uint32_t ini32, uint32_t radix)
     MANTTYPE *pmant;
     PNUMBER pnumret= nullptr;
 
-    createnum( pnumret, MAX_LONG_SIZE );
+    createnum( pnumret, MaxDigitsForUi32( radix ) );
     pmant = pnumret->mant;
     pnumret->cdigit = 0;
     pnumret->exp = 0;
@@ -904,6 +1557,65 @@ PNUMBER Ui32tonum(uint32_t ini32, uint32_t radix)
 }
 
 
+//-----------------------------------------------------------------------------
+//
+//    FUNCTION: rattomag
+//
+//    ARGUMENTS: rational number in internal base, pointers receiving the
+//    magnitude and the sign.
+//
+//    RETURN: true when the number was an exact integer whose magnitude
+//    fits in 64 bits and was read straight out of the limb array.
+//
+//    DESCRIPTION: Common fast path for the rat-to-integer conversions
+//    below.  A denominator of exactly one means the value is already an
+//    integer, and its magnitude recombines from the BASEX limbs with
+//    shifts alone -- no duplicated rational, no intrat, no division.
+//    Anything else (a real fraction, a negative exponent, more than 64
+//    bits of magnitude) reports false and the caller takes the general
+//    path.
+//
+//-----------------------------------------------------------------------------
+
+static bool rattomag( _In_ PRAT prat, _Out_ uint64_t *pmag, _Out_ int32_t *psign )
+
+{
+    PNUMBER pq = prat->pq;
+    if ( pq->cdigit != 1 || pq->exp != 0 || pq->mant[0] != 1 || pq->sign != 1 )
+    {
+        return false;
+    }
+
+    PNUMBER pp = prat->pp;
+    if ( pp->exp < 0 )
+    {
+        return false;
+    }
+
+    uint64_t mag = 0;
+    for ( int32_t i = pp->cdigit - 1; i >= 0; i-- )
+    {
+        if ( mag > ( UINT64_MAX >> BASEXPWR ) )
+        {
+            return false;
+        }
+        mag = ( mag << BASEXPWR ) | pp->mant[i];
+    }
+
+    for ( int32_t i = 0; i < pp->exp; i++ )
+    {
+        if ( mag > ( UINT64_MAX >> BASEXPWR ) )
+        {
+            return false;
+        }
+        mag <<= BASEXPWR;
+    }
+
+    *pmag = mag;
+    *psign = pp->sign;
+    return true;
+}
+
 //-----------------------------------------------------------------------------
 //
 //    FUNCTION: rattoi32
@@ -920,6 +1632,18 @@ PNUMBER Ui32tonum(uint32_t ini32, uint32_t radix)
 
 int32_t rattoi32( _In_ PRAT prat , uint32_t radix, int32_t precision)
 {
+    uint64_t mag;
+    int32_t sign;
+    if ( rattomag( prat, &mag, &sign ) )
+    {
+        if ( ( sign > 0 && mag > (uint64_t)INT32_MAX ) ||
+             ( sign < 0 && mag > (uint64_t)INT32_MAX + 1 ) )
+        {
+            throw( CALC_E_DOMAIN );
+        }
+        return( sign < 0 ? (int32_t)( -(int64_t)mag ) : (int32_t)mag );
+    }
+
     if ( rat_gt( prat, rat_max_i32, precision) || rat_lt( prat, rat_min_i32, precision) )
     {
         // Don't attempt rattoi32 of anything too big or small
@@ -955,6 +1679,17 @@ int32_t rattoi32( _In_ PRAT prat , uint32_t radix, int32_t precision)
 //-----------------------------------------------------------------------------
 uint32_t rattoUi32( _In_ PRAT prat, uint32_t radix, int32_t precision)
 {
+    uint64_t mag;
+    int32_t sign;
+    if ( rattomag( prat, &mag, &sign ) )
+    {
+        if ( ( sign < 0 && mag != 0 ) || mag > (uint64_t)UINT32_MAX )
+        {
+            throw( CALC_E_DOMAIN );
+        }
+        return( (uint32_t)mag );
+    }
+
     if ( rat_gt( prat, rat_dword, precision) || rat_lt( prat, rat_zero, precision) )
     {
         // Don't attempt rattoui32 of anything too big or small
@@ -993,6 +1728,15 @@ uint32_t rattoUi32( _In_ PRAT prat, uint32_t radix, int32_t precision)
 
 uint64_t rattoUi64( _In_ PRAT prat, uint32_t radix, int32_t precision)
 {
+    uint64_t mag;
+    int32_t sign;
+    if ( rattomag( prat, &mag, &sign ) && sign > 0 )
+    {
+        // Exact nonnegative integer already in hand; the general path
+        // below would only mask and reassemble the same bits.
+        return( mag );
+    }
+
     PRAT pint = nullptr;
 
     // first get the LO 32 bit word
@@ -1111,10 +1855,13 @@ bool stripzeroesnum(_Inout_ PNUMBER pnum, int32_t starting)
 //    RETURN: String representation of number.
 //
 //    DESCRIPTION: Converts a number to it's string
-//    representation.
+//    representation.  The out-parameter form renders into the caller's
+//    string, reserving the final length up front, so a caller that keeps
+//    the same string across display refreshes performs no allocation in
+//    steady state.
 //
 //-----------------------------------------------------------------------------
-wstring NumberToString(_Inout_ PNUMBER& pnum, int format, uint32_t radix, int32_t precision)
+void NumberToString(_Inout_ PNUMBER& pnum, int format, uint32_t radix, int32_t precision, wstring& result)
 {
     stripzeroesnum(pnum, precision + 2);
     int32_t length = pnum->cdigit;
@@ -1191,7 +1938,8 @@ wstring NumberToString(_Inout_ PNUMBER& pnum, int format, uint32_t radix, int32_
         {
             // WARNING: nesting/recursion, too much has been changed, need to
             // re-figure format.
-            return NumberToString(pnum, oldFormat, radix, precision);
+            NumberToString(pnum, oldFormat, radix, precision, result);
+            return;
         }
     }
     else
@@ -1234,79 +1982,92 @@ wstring NumberToString(_Inout_ PNUMBER& pnum, int format, uint32_t radix, int32_
         eout = 0;
     }
 
-    // Begin building the result string
-    wstringstream resultStream{};
+    // Begin building the result string; everything emitted below is bounded
+    // by the mantissa digits plus the zero padding on one side of the
+    // decimal point plus the sign/separator/exponent decorations, so one
+    // reservation up front covers the whole render.
+    // length can have gone negative above when a tiny number is rendered in
+    // scientific form at low precision; the digit loop below simply emits
+    // nothing in that case, so clamp it for the reservation.
+    result.clear();
+    result.reserve((size_t)max(length, 0) + (size_t)abs(exponent) + 40);
 
     // Make sure negative zeros aren't allowed.
     if ((pnum->sign == -1) && (length > 0))
     {
-        resultStream << L'-';
+        result.push_back(L'-');
     }
 
     if (exponent <= 0 && !useSciForm)
     {
-        resultStream << L'0';
-        resultStream << g_decimalSeparator;
+        result.push_back(L'0');
+        result.push_back(g_decimalSeparator);
         // Used up a digit unaccounted for.
     }
 
     while (exponent < 0)
     {
-        resultStream << L'0';
+        result.push_back(L'0');
         exponent++;
     }
 
     while (length > 0)
     {
         exponent--;
-        resultStream << DIGITS[*pmant--];
+        result.push_back(DIGITS[*pmant--]);
         length--;
 
         // Be more regular in using a decimal point.
         if (exponent == 0)
         {
-            resultStream << g_decimalSeparator;
+            result.push_back(g_decimalSeparator);
         }
     }
 
     while (exponent > 0)
     {
-        resultStream << L'0';
+        result.push_back(L'0');
         exponent--;
         // Be more regular in using a decimal point.
         if (exponent == 0)
         {
-            resultStream << g_decimalSeparator;
+            result.push_back(g_decimalSeparator);
         }
     }
 
     if (useSciForm)
     {
-        resultStream << (radix == 10 ? L'e' : L'^');
-        resultStream << (eout < 0 ? L'-' : L'+');
+        result.push_back(radix == 10 ? L'e' : L'^');
+        result.push_back(eout < 0 ? L'-' : L'+');
         eout = abs(eout);
-        wstringstream exponentStream{};
+
+        // int32_t exponents need at most 32 digits even in radix 2.
+        wchar_t expDigits[33];
+        int32_t cExpDigits = 0;
         do
         {
-            exponentStream << DIGITS[eout % radix];
+            expDigits[cExpDigits++] = DIGITS[eout % radix];
             eout /= radix;
         } while (eout > 0);
 
-        auto expString = exponentStream.str();
-        for (auto ritr = expString.rbegin(); ritr != expString.rend(); ritr++)
+        while (cExpDigits > 0)
         {
-            resultStream << *ritr;
+            result.push_back(expDigits[--cExpDigits]);
         }
     }
 
     // Remove trailing decimal
-    auto resultString = resultStream.str();
-    if (!resultString.empty() && resultString.back() == g_decimalSeparator)
+    if (!result.empty() && result.back() == g_decimalSeparator)
     {
-        resultString.pop_back();
+        result.pop_back();
     }
+}
 
-    return resultString;
+wstring NumberToString(_Inout_ PNUMBER& pnum, int format, uint32_t radix, int32_t precision)
+{
+    wstring result{};
+    NumberToString(pnum, format, radix, precision, result);
+    return result;
 }
 
 //-----------------------------------------------------------------------------
@@ -1329,13 +2090,18 @@ wstring NumberToString(_Inout_ PNUMBER& pnum, int format, uint32_t radix, int32_
 //       why a pointer to the rational is passed in.
 //
 //-----------------------------------------------------------------------------
-wstring RatToString(_Inout_ PRAT& prat, int format, uint32_t radix, int32_t precision)
+void RatToString(_Inout_ PRAT& prat, int format, uint32_t radix, int32_t precision, wstring& result)
 {
     PNUMBER p = RatToNumber(prat, radix, precision);
 
-    wstring result = NumberToString(p, format, radix, precision);
+    NumberToString(p, format, radix, precision, result);
     destroynum(p);
+}
 
+wstring RatToString(_Inout_ PRAT& prat, int format, uint32_t radix, int32_t precision)
+{
+    wstring result{};
+    RatToString(prat, format, radix, precision, result);
     return result;
 }
 
@@ -1352,6 +2118,17 @@ PNUMBER RatToNumber(_In_ PRAT prat, uint32_t radix, int32_t precision)
     temprat->pq->exp -= scaleby;
 
     PNUMBER p = nRadixxtonum(temprat->pp, radix, precision);
+
+    // Canonical integers (pq == 1 with no scale) skip the denominator
+    // conversion and the division outright; this is the common shape on
+    // every display refresh of an integer result.
+    if (temprat->pq->cdigit == 1 && temprat->pq->mant[0] == 1 && temprat->pq->exp == 0)
+    {
+        p->sign *= temprat->pq->sign;
+        destroyrat(temprat);
+        return p;
+    }
+
     PNUMBER q = nRadixxtonum(temprat->pq, radix, precision);
 
     destroyrat(temprat);
@@ -1384,7 +2161,10 @@ void flatrat(_Inout_ PRAT& prat, uint32_t radix, int32_t precision)
 //
 //  RETURN: Greatest common divisor in internal BASEX PNUMBER form.
 //
-//  DESCRIPTION: gcd uses remainders to find the greatest common divisor.
+//  DESCRIPTION: gcd uses the binary (Stein) algorithm on the BASEX limb
+//        arrays; BASEX is a power of two so factors of two live in word
+//        and bit shifts, and the loop needs only compares and subtracts
+//        instead of the division-heavy remainder chain.
 //
 //  ASSUMPTIONS: gcd assumes inputs are integers.
 //
@@ -1394,12 +2174,104 @@ void flatrat(_Inout_ PRAT& prat, uint32_t radix, int32_t precision)
 //
 //-----------------------------------------------------------------------------
 
-PNUMBER gcd( _In_ PNUMBER a, _In_ PNUMBER b)
+namespace
 {
-    PNUMBER r= nullptr;
-    PNUMBER larger= nullptr;
-    PNUMBER smaller= nullptr;
+    // Limb vectors are least significant word first with BASEXPWR bits
+    // per word, matching NUMBER mantissas.
+
+    // Count of trailing zero bits; the vector must be nonzero.
+    int32_t GcdTrailingZeroBits(const vector<MANTTYPE>& v)
+    {
+        int32_t bits = 0;
+        size_t i = 0;
+        while (v[i] == 0)
+        {
+            bits += BASEXPWR;
+            i++;
+        }
+        for (MANTTYPE w = v[i]; (w & 1) == 0; w >>= 1)
+        {
+            bits++;
+        }
+        return bits;
+    }
+
+    // v >>= k, dropping whole words first and carrying the rest.
+    void GcdShiftRight(vector<MANTTYPE>& v, int32_t k)
+    {
+        v.erase(v.begin(), v.begin() + k / BASEXPWR);
+        int32_t r = k % BASEXPWR;
+        if (r != 0)
+        {
+            for (size_t i = 0; i < v.size(); i++)
+            {
+                MANTTYPE hi = (i + 1 < v.size()) ? v[i + 1] : 0;
+                v[i] = (v[i] >> r) | ((hi << (BASEXPWR - r)) & (BASEX - 1));
+            }
+        }
+        while (v.size() > 1 && v.back() == 0)
+        {
+            v.pop_back();
+        }
+    }
+
+    // Returns negative, zero or positive as u is less than, equal to or
+    // greater than w.
+    int32_t GcdCompare(const vector<MANTTYPE>& u, const vector<MANTTYPE>& w)
+    {
+        size_t cu = u.size();
+        while (cu > 1 && u[cu - 1] == 0)
+        {
+            cu--;
+        }
+        size_t cw = w.size();
+        while (cw > 1 && w[cw - 1] == 0)
+        {
+            cw--;
+        }
+        if (cu != cw)
+        {
+            return (cu > cw) ? 1 : -1;
+        }
+        for (size_t i = cu; i-- > 0;)
+        {
+            if (u[i] != w[i])
+            {
+                return (u[i] > w[i]) ? 1 : -1;
+            }
+        }
+        return 0;
+    }
+
+    // u -= w, assuming u >= w.
+    void GcdSubtract(vector<MANTTYPE>& u, const vector<MANTTYPE>& w)
+    {
+        MANTTYPE borrow = 0;
+        for (size_t i = 0; i < u.size(); i++)
+        {
+            TWO_MANTTYPE wi = (i < w.size()) ? w[i] : 0;
+            TWO_MANTTYPE d = (TWO_MANTTYPE)u[i] - wi - borrow;
+            u[i] = (MANTTYPE)(d & (BASEX - 1));
+            borrow = (MANTTYPE)((d >> BASEXPWR) & 1);
+        }
+        while (u.size() > 1 && u.back() == 0)
+        {
+            u.pop_back();
+        }
+    }
+
+    // Magnitude of a number as a limb vector, materializing the word
+    // shift in exp as low order zeros.
+    vector<MANTTYPE> GcdLoad(PNUMBER x)
+    {
+        vector<MANTTYPE> v(x->exp > 0 ? x->exp : 0, 0);
+        v.insert(v.end(), x->mant, x->mant + x->cdigit);
+        return v;
+    }
+}
 
+PNUMBER gcd( _In_ PNUMBER a, _In_ PNUMBER b)
+{
     if (zernum(a))
     {
         return b;
@@ -1409,27 +2281,52 @@ PNUMBER gcd( _In_ PNUMBER a, _In_ PNUMBER b)
         return a;
     }
 
-    if (lessnum(a, b))
-    {
-        DUPNUM(larger, b);
-        DUPNUM(smaller, a);
-    }
-    else
+    vector<MANTTYPE> u = GcdLoad(a);
+    vector<MANTTYPE> v = GcdLoad(b);
+
+    // Pull out the common power of two, then keep both operands odd;
+    // every subtract of two odd values is even, so each pass strips at
+    // least one more bit.
+    int32_t shift = min(GcdTrailingZeroBits(u), GcdTrailingZeroBits(v));
+    GcdShiftRight(u, GcdTrailingZeroBits(u));
+    GcdShiftRight(v, GcdTrailingZeroBits(v));
+
+    int32_t cmp;
+    while ((cmp = GcdCompare(u, v)) != 0)
     {
-        DUPNUM(larger, a);
-        DUPNUM(smaller, b);
+        if (cmp < 0)
+        {
+            u.swap(v);
+        }
+        GcdSubtract(u, v);
+        GcdShiftRight(u, GcdTrailingZeroBits(u));
     }
 
-    while (!zernum(smaller))
+    // Hand the common power of two back through the exponent where
+    // possible, the rest through a bit shift of the mantissa.
+    int32_t r = shift % BASEXPWR;
+    if (r != 0)
     {
-        remnum(&larger, smaller, BASEX);
-        // swap larger and smaller
-        r = larger;
-        larger = smaller;
-        smaller = r;
+        MANTTYPE carry = 0;
+        for (size_t i = 0; i < u.size(); i++)
+        {
+            TWO_MANTTYPE w = ((TWO_MANTTYPE)u[i] << r) | carry;
+            u[i] = (MANTTYPE)(w & (BASEX - 1));
+            carry = (MANTTYPE)(w >> BASEXPWR);
+        }
+        if (carry != 0)
+        {
+            u.push_back(carry);
+        }
     }
-    destroynum(smaller);
-    return larger;
+
+    PNUMBER result = nullptr;
+    createnum(result, static_cast<uint32_t>(u.size()));
+    result->cdigit = static_cast<int32_t>(u.size());
+    result->exp = shift / BASEXPWR;
+    result->sign = 1;
+    memcpy(result->mant, u.data(), u.size() * sizeof(MANTTYPE));
+    return result;
 }
 
 //-----------------------------------------------------------------------------
@@ -1447,21 +2344,43 @@ PNUMBER gcd( _In_ PNUMBER a, _In_ PNUMBER b)
 //
 //-----------------------------------------------------------------------------
 
-PNUMBER i32factnum(int32_t ini32, uint32_t radix)
-
+namespace
 {
-    PNUMBER lret= nullptr;
-    PNUMBER tmp= nullptr;
-
-    lret = i32tonum( 1, radix);
-
-    while ( ini32 > 0 )
+    // Balanced product of the integers lo..hi inclusive.  Pairing ranges of
+    // similar size keeps every multiply between operands of comparable
+    // length, instead of repeatedly multiplying a small term into an
+    // ever-growing accumulator.  Zero terms are skipped, matching the
+    // sequential loops this replaces.
+    PNUMBER ProdNumRange(int32_t lo, int32_t hi, uint32_t radix)
+    {
+        if (hi - lo < 8)
         {
-        tmp = i32tonum( ini32--, radix);
-        mulnum( &lret, tmp, radix);
-        destroynum( tmp );
+            PNUMBER lret = i32tonum(1, radix);
+            for (int32_t i = lo; i <= hi; i++)
+            {
+                if (i)
+                {
+                    PNUMBER tmp = i32tonum(i, radix);
+                    mulnum(&lret, tmp, radix);
+                    destroynum(tmp);
+                }
+            }
+            return lret;
         }
-    return( lret );
+
+        int32_t mid = lo + (hi - lo) / 2;
+        PNUMBER left = ProdNumRange(lo, mid, radix);
+        PNUMBER right = ProdNumRange(mid + 1, hi, radix);
+        mulnum(&left, right, radix);
+        destroynum(right);
+        return left;
+    }
+}
+
+PNUMBER i32factnum(int32_t ini32, uint32_t radix)
+
+{
+    return ProdNumRange(1, ini32, radix);
 }
 
 //-----------------------------------------------------------------------------
@@ -1480,22 +2399,7 @@ PNUMBER i32factnum(int32_t ini32, uint32_t radix)
 PNUMBER i32prodnum(int32_t start, int32_t stop, uint32_t radix)
 
 {
-    PNUMBER lret= nullptr;
-    PNUMBER tmp= nullptr;
-
-    lret = i32tonum( 1, radix);
-
-    while ( start <= stop )
-        {
-        if ( start )
-            {
-            tmp = i32tonum( start, radix);
-            mulnum( &lret, tmp, radix);
-            destroynum( tmp );
-            }
-        start++;
-        }
-    return( lret );
+    return ProdNumRange(start, stop, radix);
 }
 
 //-----------------------------------------------------------------------------
@@ -1569,10 +2473,14 @@ void ratpowi32( _Inout_ PRAT *proot, int32_t power, int32_t precision)
                 mulnumx( &(lret->pp), (*proot)->pp );
                 mulnumx( &(lret->pq), (*proot)->pq );
                 }
-            mulrat( proot, *proot, precision);
             trimit(&lret, precision);
-            trimit(proot, precision);
             power >>= 1;
+            if ( power > 0 )
+                {
+                // Square the root for the next bit through the dedicated
+                // half-cost kernel; skipped after the last bit.
+                sqrrat( proot, precision);
+                }
             }
         destroyrat( *proot );
         *proot=lret;
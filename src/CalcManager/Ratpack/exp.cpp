@@ -16,7 +16,193 @@
 //-----------------------------------------------------------------------------
 #include "pch.h"
 #include "ratpak.h"
+#include <cmath>
+#include <future>
+#include <thread>
+
+namespace {
+
+    // Binary-splitting evaluation for the exp and ln Taylor series.
+    //
+    // Both series have term ratios that are small rationals, so a range of
+    // terms [lo, hi) can be collapsed into integers P, Q, T with
+    //
+    //    sum(j=lo..hi-1) prod(i=lo..j) n_i/d_i  =  T(lo,hi) / Q(lo,hi)
+    //
+    // by the usual recursion P = Pl*Pr, Q = Ql*Qr, T = Tl*Qr + Pl*Tr.  The
+    // integer work rides the subquadratic BASEX multiply, so the cost per
+    // term stays near the size of the term ratio instead of the size of the
+    // full-precision running sum.  This only wins when the reduced argument
+    // p/q itself is small - exp/ln of the ratpak constants and of compact
+    // user arguments at high precision - because P and Q grow by the size of
+    // p and q per term.  Large arguments keep the term-by-term loop.
+    constexpr int32_t SERIES_SPLIT_CHUNK = 32;      // terms collapsed per chunk
+    constexpr int32_t SERIES_SPLIT_MAX_DIGITS = 2;  // p/q limb bound for the fast path
+    constexpr int32_t SERIES_SPLIT_MIN_PRECISION = 64; // below this the loop is fine
+
+    // Concurrency cap for fanning split subtrees out across threads, set
+    // through ChangeSeriesConcurrency.  One keeps everything on the calling
+    // thread.  The subtree products only touch their own NUMBERs plus the
+    // shared read-only p and q, so ranges can evaluate independently.
+    uint32_t g_seriesConcurrency = 1;
+
+    // A subtree is only worth a thread once it collapses at least this many
+    // terms; below that the future machinery costs more than the multiplies.
+    constexpr int32_t SERIES_SPLIT_PARALLEL_MIN = 2 * SERIES_SPLIT_CHUNK;
+
+    // Term ratio r_i = n_i/d_i for the two series, i >= 1.
+    // exp(p/q):  r_i = p / (q*i)
+    // ln(1+v), v = pv/qv:  r_i = -(pv*i) / (qv*(i+1))
+    enum class SERIESKIND { EXP, LN };
+
+    void splitrange( SERIESKIND kind, int32_t lo, int32_t hi, PNUMBER p, PNUMBER q,
+        PNUMBER *pP, PNUMBER *pQ, PNUMBER *pT, uint32_t cThreads )
+    {
+        if ( hi - lo == 1 )
+            {
+            PNUMBER scale = nullptr;
+            if ( kind == SERIESKIND::EXP )
+                {
+                DUPNUM(*pP,p);
+                *pQ = i32tonum( lo, BASEX );
+                mulnumx( pQ, q );
+                }
+            else
+                {
+                scale = i32tonum( -lo, BASEX );
+                DUPNUM(*pP,p);
+                mulnumx( pP, scale );
+                destroynum( scale );
+                scale = i32tonum( lo + 1, BASEX );
+                DUPNUM(*pQ,q);
+                mulnumx( pQ, scale );
+                destroynum( scale );
+                }
+            DUPNUM(*pT,*pP);
+            return;
+            }
+
+        int32_t mid = lo + ( hi - lo ) / 2;
+        PNUMBER pl = nullptr, ql = nullptr, tl = nullptr;
+        PNUMBER pr = nullptr, qr = nullptr, tr = nullptr;
+        if ( cThreads > 1 && hi - lo >= SERIES_SPLIT_PARALLEL_MIN )
+            {
+            // Evaluate the right half on its own thread with half the
+            // budget; the future's get() rethrows any ratpak error raised
+            // on the worker.
+            uint32_t cRight = cThreads / 2;
+            auto right = std::async( std::launch::async,
+                [=, &pr, &qr, &tr]() { splitrange( kind, mid, hi, p, q, &pr, &qr, &tr, cRight ); } );
+            splitrange( kind, lo, mid, p, q, &pl, &ql, &tl, cThreads - cRight );
+            right.get();
+            }
+        else
+            {
+            splitrange( kind, lo, mid, p, q, &pl, &ql, &tl, cThreads );
+            splitrange( kind, mid, hi, p, q, &pr, &qr, &tr, cThreads );
+            }
+
+        // T = Tl*Qr + Pl*Tr
+        mulnumx( &tl, qr );
+        mulnumx( &tr, pl );
+        addnum( &tl, tr, BASEX );
+        *pT = tl;
+
+        mulnumx( &pl, pr );
+        *pP = pl;
+        mulnumx( &ql, qr );
+        *pQ = ql;
+
+        destroynum( pr );
+        destroynum( qr );
+        destroynum( tr );
+    }
+
+    // Sums the series 1 + sum(j>=1) prod(i=1..j) r_i in binary-split chunks.
+    // Returns the sum through *psum; terms are consumed until a whole chunk's
+    // contribution falls below precision.
+    void splitseries( SERIESKIND kind, PNUMBER p, PNUMBER q, int32_t precision, PRAT *psum )
+    {
+        PRAT sum = nullptr;
+        DUPRAT(sum,rat_one);
+
+        // prefix carries prod(i<lo) r_i between chunks.
+        PRAT prefix = nullptr;
+        DUPRAT(prefix,rat_one);
+
+        // With concurrency enabled, widen the chunks so every worker gets a
+        // subtree of at least SERIES_SPLIT_CHUNK terms; wider chunks also
+        // amortize the full-precision prefix update over more terms.  The
+        // only waste is the tail chunk overshooting the stopping point.
+        uint32_t cThreads = g_seriesConcurrency;
+        int32_t chunkTerms = SERIES_SPLIT_CHUNK * (int32_t)cThreads;
+
+        PRAT chunk = nullptr;
+        int32_t lo = 1;
+        do
+            {
+            PNUMBER P = nullptr, Q = nullptr, T = nullptr;
+            splitrange( kind, lo, lo + chunkTerms, p, q, &P, &Q, &T, cThreads );
+
+            destroyrat( chunk );
+            createrat( chunk );
+            DUPNUM(chunk->pp,T);
+            DUPNUM(chunk->pq,Q);
+            mulrat( &chunk, prefix, precision );
+            addrat( &sum, chunk, precision );
+
+            PRAT step = nullptr;
+            createrat( step );
+            DUPNUM(step->pp,P);
+            DUPNUM(step->pq,Q);
+            mulrat( &prefix, step, precision );
+            destroyrat( step );
+
+            destroynum( P );
+            destroynum( Q );
+            destroynum( T );
+            lo += chunkTerms;
+            } while ( !SMALL_ENOUGH_RAT( chunk, precision ) );
+
+        destroyrat( chunk );
+        destroyrat( prefix );
+        destroyrat( *psum );
+        *psum = sum;
+    }
+
+    bool usesplitseries( PRAT x, int32_t precision )
+    {
+        return precision >= SERIES_SPLIT_MIN_PRECISION &&
+            x->pp->cdigit <= SERIES_SPLIT_MAX_DIGITS &&
+            x->pq->cdigit <= SERIES_SPLIT_MAX_DIGITS &&
+            x->pp->exp == 0 && x->pq->exp == 0;
+    }
+}
+
+//-----------------------------------------------------------------------------
+//
+//  FUNCTION: ChangeSeriesConcurrency
+//
+//  ARGUMENTS: cThreads max worker threads for series evaluation, zero
+//             picks the hardware thread count.
+//
+//  RETURN: None.
+//
+//  EXPLANATION: Bounds how many threads the binary-split series evaluators
+//  may fan subtree products out to.  One (the default) keeps evaluation on
+//  the calling thread, preserving the classic behavior.
+//
+//-----------------------------------------------------------------------------
+
+void ChangeSeriesConcurrency( uint32_t cThreads )
 
+{
+    if ( cThreads == 0 )
+        {
+        cThreads = std::thread::hardware_concurrency();
+        }
+    g_seriesConcurrency = std::min( std::max( cThreads, 1u ), 64u );
+}
 
 //-----------------------------------------------------------------------------
 //
@@ -44,6 +230,13 @@
 void _exprat( PRAT *px, int32_t precision)
 
 {
+    if ( usesplitseries( *px, precision ) )
+        {
+        splitseries( SERIESKIND::EXP, (*px)->pp, (*px)->pq, precision, px );
+        trimit(px, precision);
+        return;
+        }
+
     CREATETAYLOR();
 
     addnum(&(pret->pp),num_one, BASEX);
@@ -128,15 +321,24 @@ void exprat( PRAT *px, uint32_t radix, int32_t precision)
 void _lograt( PRAT *px, int32_t precision)
 
 {
-    CREATETAYLOR();
-
-    createrat(thisterm);
-
-    // sub one from x
+    // sub one from x, series variable is v = x - 1
     (*px)->pq->sign *= -1;
     addnum(&((*px)->pp),(*px)->pq, BASEX);
     (*px)->pq->sign *= -1;
 
+    if ( usesplitseries( *px, precision ) )
+        {
+        // ln(1+v) = v * ( 1 + sum(j>=1) prod(i=1..j) -v*i/(i+1) )
+        PRAT sum = nullptr;
+        splitseries( SERIESKIND::LN, (*px)->pp, (*px)->pq, precision, &sum );
+        mulrat( px, sum, precision );
+        destroyrat( sum );
+        trimit(px, precision);
+        return;
+        }
+
+    CREATETAYLOR();
+
     DUPRAT(pret,*px);
     DUPRAT(thisterm,*px);
 
@@ -256,6 +458,117 @@ bool IsEven(PRAT x, uint32_t radix, int32_t precision)
     return bRet;
 }
 
+namespace {
+
+    // Largest root degree handled by the direct Newton path; beyond this the
+    // seed accuracy margin over the iteration's k/2 error constant gets thin
+    // and the exp/ln composition is no slower anyway.
+    constexpr int32_t ROOT_NEWTON_MAX_DEGREE = 1000000;
+
+    // Seed accuracy in decimal digits; the double-based estimate is good to
+    // about fifteen, claimed conservatively.
+    constexpr int32_t ROOT_NEWTON_SEED_DIGITS = 8;
+
+    // log2 of the magnitude of a, estimated from the top limbs and the
+    // exponent field; good to double precision.
+    double numlog2est(PNUMBER a)
+    {
+        int32_t top = a->cdigit - 1;
+        double d = a->mant[top];
+        if (top >= 1)
+        {
+            d = d * BASEX + a->mant[top - 1];
+        }
+        if (top >= 2)
+        {
+            d = d * BASEX + a->mant[top - 2];
+        }
+        int32_t used = std::min(a->cdigit, (int32_t)3);
+        return std::log2(d) + ((double)(a->cdigit - used) + a->exp) * BASEXPWR;
+    }
+
+    // *pa *= 2^t for t >= 0, as a single-limb multiply with the word part
+    // carried in the exponent field.
+    void mulpow2num(PNUMBER *pa, int64_t t)
+    {
+        PNUMBER p2 = nullptr;
+
+        createnum(p2, 1);
+        p2->cdigit = 1;
+        p2->sign = 1;
+        p2->exp = (int32_t)(t / BASEXPWR);
+        p2->mant[0] = (MANTTYPE)((uint32_t)1 << (t % BASEXPWR));
+        mulnumx(pa, p2);
+        destroynum(p2);
+    }
+
+    // *px = (*px)^(1/k) for *px > 0 and 2 <= k <= ROOT_NEWTON_MAX_DEGREE by
+    // Newton iteration r += (x/r^(k-1) - r)/k, seeded from a double estimate
+    // built off the limb and exponent fields so the very first iterate
+    // already carries ~15 correct digits.  Working precision doubles with
+    // the accurate digit count, so total cost is a handful of multiplies
+    // instead of the series work exp(ln(x)/k) does.
+    void rootratnewton(PRAT *px, int32_t k, int32_t precision)
+    {
+        // x ~= 2^lg2x; seed r = m * 2^e with m in [1,2) from the fractional
+        // part of lg2x/k, carried as a 53-bit numerator over 2^52.
+        double lg2x = numlog2est((*px)->pp) - numlog2est((*px)->pq);
+        double lg2r = lg2x / k;
+        int64_t e = (int64_t)std::floor(lg2r);
+        uint64_t m53 = (uint64_t)(std::exp2(lg2r - e) * ((uint64_t)1 << 52));
+
+        PRAT r = nullptr;
+        DUPRAT(r, rat_one);
+        destroynum(r->pp);
+        createnum(r->pp, 2);
+        r->pp->sign = 1;
+        r->pp->exp = 0;
+        r->pp->cdigit = 2;
+        r->pp->mant[0] = (MANTTYPE)(m53 & (BASEX - 1));
+        r->pp->mant[1] = (MANTTYPE)(m53 >> BASEXPWR);
+
+        int64_t t = e - 52;
+        if (t >= 0)
+        {
+            mulpow2num(&(r->pp), t);
+        }
+        else
+        {
+            mulpow2num(&(r->pq), -t);
+        }
+
+        PRAT kr = i32torat(k);
+        PRAT tmp = nullptr;
+        int32_t digits = ROOT_NEWTON_SEED_DIGITS;
+        do
+        {
+            int32_t workprec = std::min(digits * 2, precision) + g_ratio;
+
+            // tmp = r^(k-1); quot = x / tmp - r, the Newton correction * k
+            DUPRAT(tmp, r);
+            ratpowi32(&tmp, k - 1, workprec);
+            PRAT quot = nullptr;
+            DUPRAT(quot, *px);
+            divrat(&quot, tmp, workprec);
+            subrat(&quot, r, workprec);
+
+            // r += quot / k
+            divrat(&quot, kr, workprec);
+            addrat(&r, quot, workprec);
+            destroyrat(quot);
+
+            digits *= 2;
+        }
+        while (digits < precision);
+
+        destroyrat(kr);
+        destroyrat(tmp);
+        destroyrat(*px);
+        trimit(&r, precision);
+        *px = r;
+    }
+}
+
 //---------------------------------------------------------------------------
 //
 //  FUNCTION: powrat
@@ -284,6 +597,37 @@ void powrat(PRAT *px, PRAT y, uint32_t radix, int32_t precision)
         return;
     }
 
+    // Integral exponents go straight to binary exponentiation, skipping the
+    // exp/ln machinery powratcomp would otherwise run just to guard its range.
+    PRAT podd = nullptr;
+    DUPRAT(podd, y);
+    fracrat(&podd, radix, precision);
+    if (rat_gt(podd, rat_negsmallest, precision) && rat_lt(podd, rat_smallest, precision) &&
+        !rat_gt(y, rat_max_i32, precision) && !rat_lt(y, rat_min_i32, precision))
+    {
+        PRAT iy = nullptr;
+        DUPRAT(iy, y);
+        subrat(&iy, podd, precision);
+        int32_t inty = rattoi32(iy, radix, precision);
+        destroyrat(iy);
+
+        // Estimate the magnitude of x^y in bits from LOGRAT2 (accurate to a
+        // BASEX word) and only stay on the fast path when it is comfortably
+        // inside rat_max_exp; borderline cases fall through to powratcomp's
+        // exact y*ln(x) range check so the thrown behavior is unchanged.
+        int32_t lg2 = LOGRAT2(*px);
+        uint64_t bits = static_cast<uint64_t>(inty < 0 ? -static_cast<int64_t>(inty) : inty) *
+            (static_cast<uint64_t>(lg2 < 0 ? -lg2 : lg2) + 1) * BASEXPWR;
+        int32_t maxexp = rattoi32(rat_max_exp, radix, precision);
+        if (bits * 6932 <= static_cast<uint64_t>(maxexp) * 10000) // bits*ln(2) <= rat_max_exp
+        {
+            destroyrat(podd);
+            ratpowi32(px, inty, precision);
+            return;
+        }
+    }
+    destroyrat(podd);
+
     try
     {
         powratNumeratorDenominator(px, y, radix, precision);
@@ -340,7 +684,26 @@ void powratNumeratorDenominator(PRAT *px, PRAT y, uint32_t radix, int32_t precis
         // ##################################
         PRAT originalResult = nullptr;
         DUPRAT(originalResult, pxPow);
-        powratcomp(&originalResult, oneoveryDenom, radix, precision);
+
+        // Positive bases with a small integral root degree take the direct
+        // Newton path; everything else (negative bases, huge degrees) keeps
+        // the exp/ln composition.
+        int32_t introot = 0;
+        if (pxPow->pp->sign * pxPow->pq->sign == 1 &&
+            rat_ge(yDenominator, rat_two, precision) &&
+            !rat_gt(yDenominator, rat_max_i32, precision))
+        {
+            introot = rattoi32(yDenominator, radix, precision);
+        }
+
+        if (introot >= 2 && introot <= ROOT_NEWTON_MAX_DEGREE)
+        {
+            rootratnewton(&originalResult, introot, precision);
+        }
+        else
+        {
+            powratcomp(&originalResult, oneoveryDenom, radix, precision);
+        }
 
         // ##################################
         // Round the originalResult to roundedResult
@@ -392,6 +755,98 @@ void powratNumeratorDenominator(PRAT *px, PRAT y, uint32_t radix, int32_t precis
     destroyrat(pxPow);
 }
 
+//-----------------------------------------------------------------------------
+//
+//  Memoized natural logs for power operations.
+//
+//  powratcomp computes x^y as exp(y*ln(x)), so sweeping exponents over a
+//  fixed base - the usual y^x workflow - recomputes the same ln(x) on every
+//  press, and the log is the expensive half.  Keep the last few
+//  (base, precision) -> ln(base) pairs per thread (ratpak state is
+//  thread-affine) and serve repeats from the cache.
+//
+//-----------------------------------------------------------------------------
+
+namespace {
+
+    constexpr size_t LOG_CACHE_ENTRIES = 4;
+
+    // Digits for the coarse tier of adaptive range guards; full precision
+    // is consulted only when a comparison lands too close to its boundary
+    // for this tier to decide.
+    constexpr int32_t POW_RANGE_GUARD_PRECISION = 32;
+
+    struct LOGCACHEENTRY
+    {
+        PRAT base = nullptr;    // nullptr marks an empty slot
+        PRAT logbase = nullptr;
+        int32_t precision = 0;
+    };
+
+    thread_local LOGCACHEENTRY t_logCache[LOG_CACHE_ENTRIES];
+    thread_local size_t t_logCacheNext = 0;
+
+    // lograt through the per-thread cache.  Entries are replaced
+    // round-robin; only positive bases reach this (powratcomp logs |x|).
+    void logratcached( PRAT *px, int32_t precision )
+    {
+        for ( auto &entry : t_logCache )
+            {
+            if ( entry.base != nullptr && entry.precision == precision && rat_equ( entry.base, *px, precision ) )
+                {
+                DUPRAT( *px, entry.logbase );
+                return;
+                }
+            }
+
+        PRAT base = nullptr;
+        DUPRAT( base, *px );
+        try
+            {
+            lograt( px, precision );
+            }
+        catch ( ... )
+            {
+            // Cancellation checkpoints can throw out of the series loop.
+            destroyrat( base );
+            throw;
+            }
+
+        LOGCACHEENTRY &entry = t_logCache[t_logCacheNext];
+        t_logCacheNext = ( t_logCacheNext + 1 ) % LOG_CACHE_ENTRIES;
+        destroyrat( entry.base );
+        destroyrat( entry.logbase );
+        entry.base = base;
+        DUPRAT( entry.logbase, *px );
+        entry.precision = precision;
+    }
+}
+
+//---------------------------------------------------------------------------
+//
+//  FUNCTION: TrimPowMemoCache
+//
+//  ARGUMENTS: none
+//
+//  RETURN: none
+//
+//  DESCRIPTION: Releases the calling thread's memoized ln(base) entries.
+//  Called from TrimRatpakPools so a memory-pressure trim drops this scratch
+//  along with the parked allocator free lists.
+//
+//---------------------------------------------------------------------------
+
+void TrimPowMemoCache( void )
+
+{
+    for ( auto &entry : t_logCache )
+        {
+        destroyrat( entry.base );
+        destroyrat( entry.logbase );
+        entry.precision = 0;
+        }
+}
+
 //---------------------------------------------------------------------------
 //
 //  FUNCTION: powratcomp
@@ -458,11 +913,69 @@ void powratcomp(PRAT *px, PRAT y, uint32_t radix, int32_t precision)
                 subrat(&iy, podd, precision);
                 inty = rattoi32(iy, radix, precision);
 
+                // The ln(x)*y below only decides whether the result is in
+                // exp's range, so evaluate it adaptively: a guard-precision
+                // log decides the comparison unless the estimate lands
+                // within 1% of the boundary (absurdly wide next to the
+                // coarse tier's ~10^-30 relative error), and only then is
+                // the full-precision log recomputed for the exact check.
+                // At extended precisions this skips the expensive half of
+                // an integral power's guard entirely.
                 PRAT plnx = nullptr;
                 DUPRAT(plnx,*px);
-                lograt(&plnx, precision);
-                mulrat(&plnx, iy, precision);
-                if ( rat_gt( plnx, rat_max_exp, precision) || rat_lt( plnx, rat_min_exp, precision) )
+                bool fInRange;
+                if ( precision <= POW_RANGE_GUARD_PRECISION * 2 )
+                    {
+                    logratcached(&plnx, precision);
+                    mulrat(&plnx, iy, precision);
+                    fInRange = !rat_gt( plnx, rat_max_exp, precision) && !rat_lt( plnx, rat_min_exp, precision);
+                    }
+                else
+                    {
+                    logratcached(&plnx, POW_RANGE_GUARD_PRECISION);
+                    mulrat(&plnx, iy, POW_RANGE_GUARD_PRECISION);
+
+                    // Compare 100*ln(x)*y against 99 and 101 times the
+                    // bounds so the band needs no fractional constants.
+                    PRAT p100 = i32torat( 100 );
+                    mulrat(&plnx, p100, POW_RANGE_GUARD_PRECISION);
+                    destroyrat(p100);
+
+                    PRAT bound = i32torat( 99 );
+                    PRAT maxband = nullptr;
+                    PRAT minband = nullptr;
+                    DUPRAT(maxband, rat_max_exp);
+                    DUPRAT(minband, rat_min_exp);
+                    mulrat(&maxband, bound, POW_RANGE_GUARD_PRECISION);
+                    mulrat(&minband, bound, POW_RANGE_GUARD_PRECISION);
+                    fInRange = rat_lt( plnx, maxband, POW_RANGE_GUARD_PRECISION) && rat_gt( plnx, minband, POW_RANGE_GUARD_PRECISION);
+
+                    if ( !fInRange )
+                        {
+                        destroyrat(bound);
+                        bound = i32torat( 101 );
+                        bool fOutOfRange;
+                        DUPRAT(maxband, rat_max_exp);
+                        DUPRAT(minband, rat_min_exp);
+                        mulrat(&maxband, bound, POW_RANGE_GUARD_PRECISION);
+                        mulrat(&minband, bound, POW_RANGE_GUARD_PRECISION);
+                        fOutOfRange = rat_gt( plnx, maxband, POW_RANGE_GUARD_PRECISION) || rat_lt( plnx, minband, POW_RANGE_GUARD_PRECISION);
+
+                        if ( !fOutOfRange )
+                            {
+                            // Boundary not decided at the guard tier; pay
+                            // for the verified full-precision refinement.
+                            DUPRAT(plnx, *px);
+                            logratcached(&plnx, precision);
+                            mulrat(&plnx, iy, precision);
+                            fInRange = !rat_gt( plnx, rat_max_exp, precision) && !rat_lt( plnx, rat_min_exp, precision);
+                            }
+                        }
+                    destroyrat(bound);
+                    destroyrat(maxband);
+                    destroyrat(minband);
+                    }
+                if ( !fInRange )
                     {
                     // Don't attempt exp of anything large or small.A
                     destroyrat(plnx);
@@ -528,7 +1041,7 @@ void powratcomp(PRAT *px, PRAT y, uint32_t radix, int32_t precision)
                     sign = 1;
                     }
 
-                lograt(px, precision);
+                logratcached(px, precision);
                 mulrat(px, y, precision);
                 exprat(px, radix, precision);
                 }
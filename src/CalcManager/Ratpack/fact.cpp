@@ -20,6 +20,34 @@
 #define ABSRAT(x) (((x)->pp->sign=1),((x)->pq->sign=1))
 #define NEGATE(x) ((x)->pp->sign *= -1)
 
+namespace {
+    // Multiplies the integers lo..hi inclusive by recursive halving, so the
+    // multiplier always sees two operands of similar magnitude instead of one
+    // huge running product and one tiny factor.
+    PNUMBER prodrange(int32_t lo, int32_t hi)
+    {
+        if (hi - lo < 8)
+        {
+            PNUMBER result = i32tonum(lo > hi ? 1L : lo, BASEX);
+            for (int32_t i = lo + 1; i <= hi; i++)
+            {
+                ratpakcheckpoint();
+                PNUMBER factor = i32tonum(i, BASEX);
+                mulnumx(&result, factor);
+                destroynum(factor);
+            }
+            return result;
+        }
+
+        int32_t mid = lo + (hi - lo) / 2;
+        PNUMBER left = prodrange(lo, mid);
+        PNUMBER right = prodrange(mid + 1, hi);
+        mulnumx(&left, right);
+        destroynum(right);
+        return left;
+    }
+}
+
 //-----------------------------------------------------------------------------
 //
 //  FUNCTION: factrat, _gamma, gamma
@@ -141,6 +169,7 @@ void _gamma( PRAT *pn, uint32_t radix, int32_t precision)
     // Loop until precision is reached, or asked to halt.
     while ( !zerrat( term ) && rat_gt( term, err, precision) )
         {
+        ratpakcheckpoint();
         addrat(pn, rat_two, precision);
 
         // WARNING: mixing numbers and  rationals here.
@@ -220,9 +249,30 @@ void factrat( PRAT *px, uint32_t radix, int32_t precision)
         {
         throw CALC_E_DOMAIN;
         }
+    // Non-negative integers (or values within precision of one) take a
+    // product-tree fast path; the sequential reduction below squares its
+    // cost with the size of the input.
+    if ( ( zerrat(frac) || ( LOGRATRADIX(frac) <= -precision) ) &&
+        !rat_lt( *px, rat_zero, precision) )
+        {
+        PRAT n = nullptr;
+        DUPRAT(n,*px);
+        intrat(&n, radix, precision);
+        int32_t nint = rattoi32(n, radix, precision);
+        destroyrat(n);
+
+        destroyrat(fact);
+        createrat(fact);
+        fact->pp = prodrange( 1L, nint );
+        DUPNUM(fact->pq,num_one);
+
+        DUPRAT(*px,rat_zero);
+        }
+
     while ( rat_gt(  *px, rat_zero, precision) &&
         ( LOGRATRADIX(*px) > -precision) )
         {
+        ratpakcheckpoint();
         mulrat( &fact, *px, precision);
         subrat( px, rat_one, precision);
         }
@@ -65,9 +65,87 @@ void ascalerat( _Inout_ PRAT *pa, ANGLE_TYPE angletype, int32_t precision)
 //
 //-----------------------------------------------------------------------------
 
+// Series kernels from trans.cpp; range reduction is unnecessary here since
+// the iterate stays within asin(0.85) of zero.
+extern void _sinrat( PRAT *px, int32_t precision);
+extern void _cosrat( PRAT *px, uint32_t radix, int32_t precision);
+void _asinrat( PRAT *px, int32_t precision);
+
+namespace
+{
+    // Precision at which the Newton inversion of sinrat overtakes the
+    // direct Taylor series, and the precision used to seed it.  Near the
+    // 0.85 branch point the series only gains log10(1/0.7225) digits per
+    // term, so the crossover comes early.
+    constexpr int32_t ASIN_NEWTON_MIN_PRECISION = 64;
+    constexpr int32_t ASIN_NEWTON_SEED_PRECISION = 32;
+}
+
+//-----------------------------------------------------------------------------
+//
+//  FUNCTION: _asinratnewton
+//
+//  ARGUMENTS: x PRAT representation of number to take the inverse
+//    sine of
+//  RETURN: asin of x in PRAT form.
+//
+//  EXPLANATION: Solves sin(y) = x by Newton iteration
+//
+//      y    = y  + ( x - sin(y ) ) / cos(y )
+//       j+1    j              j           j
+//
+//   seeded with a low precision Taylor approximation.  Every pass doubles
+//   the number of correct digits, and the sine series converges factorially
+//   fast, so the total work is a handful of sin/cos evaluations instead of
+//   the hundreds of geometric series terms the direct expansion needs near
+//   the 0.85 branch point.  Callers keep abs(x) below 0.85, which keeps
+//   cos(y) away from zero and the iteration well conditioned.
+//
+//-----------------------------------------------------------------------------
+
+void _asinratnewton( PRAT *px, int32_t precision)
+
+{
+    PRAT y= nullptr;
+    PRAT sine= nullptr;
+    PRAT cosine= nullptr;
+    PRAT delta= nullptr;
+    int32_t digits;
+    int32_t workprec;
+
+    DUPRAT(y,*px);
+    _asinrat( &y, ASIN_NEWTON_SEED_PRECISION);
+
+    for ( digits = ASIN_NEWTON_SEED_PRECISION; digits < precision; digits *= 2 )
+        {
+        workprec = std::min( digits * 2, precision ) + g_ratio;
+        DUPRAT(sine,y);
+        _sinrat( &sine, workprec);
+        DUPRAT(cosine,y);
+        _cosrat( &cosine, BASEX, workprec);
+        DUPRAT(delta,*px);
+        subrat( &delta, sine, workprec);
+        divrat( &delta, cosine, workprec);
+        addrat( &y, delta, workprec);
+        }
+
+    destroyrat(sine);
+    destroyrat(cosine);
+    destroyrat(delta);
+    destroyrat(*px);
+    trimit(&y, precision);
+    *px = y;
+}
+
 void _asinrat( PRAT *px, int32_t precision)
 
 {
+    if ( precision >= ASIN_NEWTON_MIN_PRECISION )
+        {
+        _asinratnewton( px, precision);
+        return;
+        }
+
     CREATETAYLOR();
     DUPRAT(pret,*px);
     DUPRAT(thisterm,*px);
@@ -185,9 +263,7 @@ void _acosrat( PRAT *px, int32_t precision)
 {
     CREATETAYLOR();
 
-    createrat(thisterm);
-    thisterm->pp=i32tonum( 1L, BASEX );
-    thisterm->pq=i32tonum( 1L, BASEX );
+    DUPRAT(thisterm,rat_one);
 
     DUPNUM(n2,num_one);
 
@@ -18,10 +18,116 @@
 
 using namespace std;
 
+//---------------------------------------------------------------------------
+//
+//    FUNCTION: rattokernel / kerneltorat
+//
+//    DESCRIPTION: Programmer-mode operands are integers masked to QWORD or
+//    smaller, so the logical ops almost always fit a native 64 bit word.
+//    rattokernel reads the magnitude of an integral rational (denominator
+//    of one, nonnegative exponent) into a uint64_t, returning false when
+//    the value is not in that form or doesn't fit; kerneltorat writes a
+//    kernel result back over the rational.  Callers fall through to the
+//    full rational path on a false return, so values beyond 64 bits keep
+//    the old behavior.
+//
+//---------------------------------------------------------------------------
+
+static bool rattokernel( PRAT a, uint64_t *pval )
+
+{
+    if ( !equnum( a->pq, num_one ) )
+        {
+        return( false );
+        }
+
+    PNUMBER pp = a->pp;
+    int32_t words = pp->cdigit + pp->exp;
+    if ( pp->exp < 0 || words > 3 ||
+        ( words == 3 && pp->mant[pp->cdigit-1] >= ( 1UL << ( 64 - 2 * BASEXPWR ) ) ) )
+        {
+        // Fractional part hiding in the exponent, or magnitude 2^64 or more.
+        return( false );
+        }
+
+    uint64_t val = 0;
+    for ( int32_t i = pp->cdigit - 1; i >= 0; i-- )
+        {
+        val = ( val << BASEXPWR ) | pp->mant[i];
+        }
+    *pval = val << ( BASEXPWR * pp->exp );
+    return( true );
+}
+
+static void kerneltorat( uint64_t val, int32_t sign, PRAT *pa )
+
+{
+    PNUMBER pnum = nullptr;
+    createnum( pnum, 3 );
+    pnum->exp = 0;
+    pnum->cdigit = 0;
+    do
+        {
+        pnum->mant[pnum->cdigit++] = (MANTTYPE)( val & ( BASEX - 1 ) );
+        val >>= BASEXPWR;
+        } while ( val != 0 );
+    pnum->sign = sign;
+
+    destroynum( (*pa)->pp );
+    (*pa)->pp = pnum;
+    DUPNUM( ((*pa)->pq), num_one );
+}
+
+//---------------------------------------------------------------------------
+//
+//    FUNCTION: numpow2x
+//
+//    ARGUMENTS: pointer to a number and a nonnegative bit count.
+//
+//    RETURN: None, changes first pointer.
+//
+//    DESCRIPTION: Does the number equivalent of *pa *= 2^k.  BASEX is a
+//    power of two, so whole words of the shift land in the exponent for
+//    free and only the remaining k mod BASEXPWR bits need a carry pass
+//    over the mantissa.  This keeps large shifts at O(n) instead of a
+//    full multiplication by a computed power of two.
+//
+//---------------------------------------------------------------------------
+
+static void numpow2x( PNUMBER *pa, int32_t k )
+
+{
+    PNUMBER a = *pa;
+    int32_t r = k % BASEXPWR;
+    if ( r == 0 )
+        {
+        a->exp += k / BASEXPWR;
+        return;
+        }
+
+    PNUMBER c = nullptr;
+    createnum( c, a->cdigit + 1 );
+    MANTTYPE carry = 0;
+    for ( int32_t i = 0; i < a->cdigit; i++ )
+        {
+        TWO_MANTTYPE w = ( ( (TWO_MANTTYPE)a->mant[i] ) << r ) | carry;
+        c->mant[i] = (MANTTYPE)( w & ( BASEX - 1 ) );
+        carry = (MANTTYPE)( w >> BASEXPWR );
+        }
+    c->cdigit = a->cdigit;
+    if ( carry != 0 )
+        {
+        c->mant[c->cdigit++] = carry;
+        }
+    c->exp = a->exp + k / BASEXPWR;
+    c->sign = a->sign;
+    destroynum( *pa );
+    *pa = c;
+}
+
 void lshrat( PRAT *pa, PRAT b, uint32_t radix, int32_t precision)
 
 {
-    PRAT pwr= nullptr;
     int32_t intb;
 
     intrat(pa, radix, precision);
@@ -34,17 +140,33 @@ void lshrat( PRAT *pa, PRAT b, uint32_t radix, int32_t precision)
             throw( CALC_E_DOMAIN );
             }
         intb = rattoi32(b, radix, precision);
-        DUPRAT(pwr,rat_two);
-        ratpowi32(&pwr, intb, precision);
-        mulrat(pa, pwr, precision);
-        destroyrat(pwr);
+
+        // Word-size shifts of word-size values stay native.
+        uint64_t ua;
+        if ( intb >= 0 && intb < 64 && rattokernel( *pa, &ua ) &&
+            ( intb == 0 || ( ua >> ( 64 - intb ) ) == 0 ) )
+            {
+            kerneltorat( ua << intb, (*pa)->pp->sign, pa );
+            return;
+            }
+
+        // Everything else is a limb shift; negative counts shift the
+        // value right by scaling the denominator instead.
+        if ( intb >= 0 )
+            {
+            numpow2x( &((*pa)->pp), intb );
+            }
+        else
+            {
+            numpow2x( &((*pa)->pq), -intb );
+            }
+        trimit(pa, precision);
         }
 }
 
 void rshrat( PRAT *pa, PRAT b, uint32_t radix, int32_t precision)
 
 {
-    PRAT pwr= nullptr;
     int32_t intb;
 
     intrat(pa, radix, precision);
@@ -57,10 +179,28 @@ void rshrat( PRAT *pa, PRAT b, uint32_t radix, int32_t precision)
             throw( CALC_E_DOMAIN );
             }
         intb = rattoi32(b, radix, precision);
-        DUPRAT(pwr,rat_two);
-        ratpowi32(&pwr, intb, precision);
-        divrat(pa, pwr, precision);
-        destroyrat(pwr);
+
+        // Only exact shifts may stay native; rshrat of a value with low
+        // bits set produces a fraction, which the rational path handles.
+        uint64_t ua;
+        if ( intb >= 0 && intb < 64 && rattokernel( *pa, &ua ) &&
+            ( ua & ( ( 1ULL << intb ) - 1 ) ) == 0 )
+            {
+            kerneltorat( ua >> intb, (*pa)->pp->sign, pa );
+            return;
+            }
+
+        // Everything else is a limb shift; negative counts shift the
+        // value left by scaling the numerator instead.
+        if ( intb >= 0 )
+            {
+            numpow2x( &((*pa)->pq), intb );
+            }
+        else
+            {
+            numpow2x( &((*pa)->pp), -intb );
+            }
+        trimit(pa, precision);
        }
 }
 
@@ -107,6 +247,27 @@ void xorrat( PRAT *pa, PRAT b, uint32_t radix, int32_t precision)
 void boolrat( PRAT *pa, PRAT b, int func, uint32_t radix, int32_t precision)
 
 {
+    // Both operands already integral and word size, do the op natively.
+    uint64_t ua;
+    uint64_t ub;
+    if ( rattokernel( *pa, &ua ) && rattokernel( b, &ub ) )
+        {
+        switch ( func )
+            {
+        case FUNC_AND:
+            ua &= ub;
+            break;
+        case FUNC_OR:
+            ua |= ub;
+            break;
+        case FUNC_XOR:
+            ua ^= ub;
+            break;
+            }
+        kerneltorat( ua, (*pa)->pp->sign, pa );
+        return;
+        }
+
     PRAT tmp= nullptr;
     intrat( pa, radix, precision);
     DUPRAT(tmp,b);
@@ -183,6 +344,60 @@ void boolnum( PNUMBER *pa, PNUMBER b, int func )
     *pa=c;
 }
 
+//---------------------------------------------------------------------------
+//
+//    FUNCTION: choprat
+//
+//    ARGUMENTS: pointer to a rational and a nonnegative bit count.
+//
+//    RETURN: None, changes pointer.
+//
+//    DESCRIPTION: Does the rational equivalent of *pa &= ( 2^bits - 1 ),
+//    the programmer mode word-size chop.  BASEX is a power of two, so the
+//    mask never needs boolnum: limbs wholly above the cut are dropped and
+//    the straddling limb keeps its low bits.  Cost is bounded by the size
+//    of the result however large the operand grew.
+//
+//---------------------------------------------------------------------------
+
+void choprat( PRAT *pa, uint32_t bits, uint32_t radix, int32_t precision)
+
+{
+    intrat( pa, radix, precision );
+
+    PNUMBER pp = (*pa)->pp;
+    int32_t idx = (int32_t)( bits / BASEXPWR ) - pp->exp;
+    uint32_t rem = bits % BASEXPWR;
+
+    if ( idx >= pp->cdigit )
+        {
+        // Already below the cut.
+        return;
+        }
+
+    if ( idx < 0 )
+        {
+        // Every stored limb lies at or above the cut.
+        pp->cdigit = 1;
+        pp->exp = 0;
+        pp->mant[0] = 0;
+        pp->sign = 1;
+        return;
+        }
+
+    pp->cdigit = idx + 1;
+    pp->mant[idx] &= ( 1UL << rem ) - 1;
+    while ( pp->cdigit > 1 && pp->mant[pp->cdigit-1] == 0 )
+        {
+        pp->cdigit--;
+        }
+    if ( pp->cdigit == 1 && pp->mant[0] == 0 )
+        {
+        pp->exp = 0;
+        pp->sign = 1;
+        }
+}
+
 //-----------------------------------------------------------------------------
 //
 //    FUNCTION: modrat
@@ -204,6 +419,16 @@ void modrat( PRAT *pa, PRAT b )
         {
         throw CALC_E_INDEFINITE;
         }
+
+    // Word-size integer remainders stay native.
+    uint64_t ua;
+    uint64_t ub;
+    if ( rattokernel( *pa, &ua ) && rattokernel( b, &ub ) )
+        {
+        kerneltorat( ua % ub, (*pa)->pp->sign, pa );
+        return;
+        }
+
     DUPRAT(tmp,b);
 
     mulnumx( &((*pa)->pp), tmp->pq );
@@ -58,6 +58,72 @@ void __inline addnum( PNUMBER *pa, PNUMBER b, uint32_t radix)
         }
 }
 
+//----------------------------------------------------------------------------
+//
+//    FUNCTION: _addnumbasex
+//
+//    ARGUMENTS: pointer to a number, a second number of the same sign,
+//               both in internal BASEX form.
+//
+//    RETURN: None, changes first pointer.
+//
+//    DESCRIPTION: Same-sign add specialized for BASEX.  The generic loop
+//    below divides by the runtime radix for every digit and carries the
+//    complement machinery for mixed signs; since BASEX is a power of two and
+//    the signs match, this reduces to masked 64-bit accumulation, which is
+//    what the inner loops of the engine hit on nearly every operation.
+//
+//----------------------------------------------------------------------------
+
+void _addnumbasex( PNUMBER *pa, PNUMBER b )
+
+{
+    PNUMBER a = *pa;
+    PNUMBER c = nullptr;
+
+    int32_t cdigits = std::max( a->cdigit + a->exp, b->cdigit + b->exp ) -
+            std::min( a->exp, b->exp );
+
+    createnum( c, cdigits + 1 );
+    c->exp = std::min( a->exp, b->exp );
+    c->cdigit = cdigits;
+    c->sign = a->sign;
+
+    // Offsets of each operand's least significant digit in c's digit space.
+    int32_t ea = a->exp - c->exp;
+    int32_t eb = b->exp - c->exp;
+
+    TWO_MANTTYPE cy = 0;
+    for ( int32_t i = 0; i < cdigits; i++ )
+        {
+        TWO_MANTTYPE s = cy;
+        if ( i >= ea && i < ea + a->cdigit )
+            {
+            s += a->mant[i - ea];
+            }
+        if ( i >= eb && i < eb + b->cdigit )
+            {
+            s += b->mant[i - eb];
+            }
+        c->mant[i] = (MANTTYPE)( s & ( BASEX - 1 ) );
+        cy = s >> BASEXPWR;
+        }
+
+    if ( cy )
+        {
+        c->mant[c->cdigit++] = (MANTTYPE)cy;
+        }
+
+    // Remove leading zeros, digits are in order of increasing significance.
+    while ( c->cdigit > 1 && c->mant[c->cdigit-1] == 0 )
+        {
+        c->cdigit--;
+        }
+
+    destroynum( *pa );
+    *pa=c;
+}
+
 void _addnum( PNUMBER *pa, PNUMBER b, uint32_t radix)
 
 {
@@ -77,6 +143,13 @@ void _addnum( PNUMBER *pa, PNUMBER b, uint32_t radix)
 
     a=*pa;
 
+    if ( radix == BASEX && a->sign == b->sign )
+        {
+        // The overwhelmingly common internal case has a div-free path.
+        _addnumbasex( pa, b );
+        return;
+        }
+
 
     // Calculate the overlap of the numbers after alignment, this includes
     // necessary padding 0's
@@ -418,36 +491,64 @@ void _divnum( PNUMBER *pa, PNUMBER b, uint32_t radix, int32_t precision)
     tmp->sign = a->sign;
     rem->exp = b->cdigit + b->exp - rem->cdigit;
 
-    // Build a table of multiplications of the divisor, this is quicker for
-    // more than radix 'digits'
-    list<PNUMBER> numberList{ i32tonum(0L, radix) };
+    // Build a table of multiples of the divisor, indexed by digit, this is
+    // quicker for more than radix 'digits'
+    vector<PNUMBER> multiples{ i32tonum(0L, radix) };
     for (uint32_t i = 1; i < radix; i++)
     {
         PNUMBER newValue = nullptr;
-        DUPNUM(newValue, numberList.front());
+        DUPNUM(newValue, multiples.back());
         addnum(&newValue, tmp, radix);
 
-        numberList.emplace_front(newValue);
+        multiples.emplace_back(newValue);
     }
     destroynum(tmp);
 
+    // Knuth Algorithm-D style trial digits: estimate each quotient digit
+    // from the leading digits of the remainder and divisor instead of
+    // walking the multiple table.  Digits are < radix <= 64 so the estimate
+    // arithmetic fits comfortably in 64 bits.  The correction loops below
+    // make the digit exact regardless of the estimate, which only has to be
+    // close (and is, within a step or two).
+    uint64_t bTop = (uint64_t)MSD(b) * radix + (b->cdigit > 1 ? b->mant[b->cdigit - 2] : 0);
+
     int32_t digit;
     int32_t cdigits = 0;
     while (cdigits++ < thismax && !zernum(rem))
     {
-        digit = radix - 1;
-        PNUMBER multiple = nullptr;
-        for (const auto& num : numberList)
+        // Alignment of the remainder's MSD relative to the divisor's.
+        int32_t diff = (rem->cdigit + rem->exp) - (b->cdigit + b->exp);
+        if (diff < 0)
         {
-            if (!lessnum(rem, num) || !--digit)
+            digit = 0;
+        }
+        else
+        {
+            // Numerator takes diff+2 leading remainder digits against the
+            // divisor's leading two; missing digits read as zero.
+            uint64_t remTop = 0;
+            for (int32_t j = 0; j < diff + 2; j++)
             {
-                multiple = num;
-                break;
+                int32_t idx = rem->cdigit - 1 - j;
+                remTop = remTop * radix + (idx >= 0 ? rem->mant[idx] : 0);
+            }
+
+            digit = (int32_t)min<uint64_t>(remTop / bTop, radix - 1);
+
+            // Correct the estimate to the exact floor digit.
+            while (digit > 0 && lessnum(rem, multiples[digit]))
+            {
+                digit--;
+            }
+            while (digit < (int32_t)radix - 1 && !lessnum(rem, multiples[digit + 1]))
+            {
+                digit++;
             }
         }
 
         if (digit)
         {
+            PNUMBER multiple = multiples[digit];
             multiple->sign *= -1;
             addnum(&rem, multiple, radix);
             multiple->sign *= -1;
@@ -463,7 +564,7 @@ void _divnum( PNUMBER *pa, PNUMBER b, uint32_t radix, int32_t precision)
     }
 
     // Cleanup table structure
-    for (auto& num : numberList)
+    for (auto& num : multiples)
     {
         destroynum(num);
     }
@@ -510,8 +611,6 @@ bool equnum( PNUMBER a, PNUMBER b )
     MANTTYPE *pb;
     int32_t cdigits;
     int32_t ccdigits;
-    MANTTYPE  da;
-    MANTTYPE  db;
 
     diff = ( a->cdigit + a->exp ) - ( b->cdigit + b->exp );
     if ( diff < 0 )
@@ -528,23 +627,32 @@ bool equnum( PNUMBER a, PNUMBER b )
             }
         else
             {
-            // OK the exponents match.
-            pa = a->mant;
-            pb = b->mant;
-            pa += a->cdigit - 1;
-            pb += b->cdigit - 1;
-            cdigits = max( a->cdigit, b->cdigit );
-            ccdigits = cdigits;
-
-            // Loop over all digits until we run out of digits or there is a
-            // difference in the digits.
+            // OK the exponents match, scan most significant digit first and
+            // bail at the first difference.
+            pa = a->mant + a->cdigit - 1;
+            pb = b->mant + b->cdigit - 1;
+            cdigits = min( a->cdigit, b->cdigit );
+
             for ( ;cdigits > 0; cdigits-- )
                 {
-                da = ( (cdigits > (ccdigits - a->cdigit) ) ?
-                    *pa-- : 0 );
-                db = ( (cdigits > (ccdigits - b->cdigit) ) ?
-                    *pb-- : 0 );
-                if ( da != db )
+                if ( *pa-- != *pb-- )
+                    {
+                    return false;
+                    }
+                }
+
+            // Digits in common match; the longer mantissa must be all zeros
+            // below the overlap for the numbers to be equal.
+            for ( ccdigits = a->cdigit - b->cdigit; ccdigits > 0; ccdigits-- )
+                {
+                if ( *pa-- )
+                    {
+                    return false;
+                    }
+                }
+            for ( ccdigits = b->cdigit - a->cdigit; ccdigits > 0; ccdigits-- )
+                {
+                if ( *pb-- )
                     {
                     return false;
                     }
@@ -578,8 +686,6 @@ bool lessnum( PNUMBER a, PNUMBER b )
     MANTTYPE *pb;
     int32_t cdigits;
     int32_t ccdigits;
-    MANTTYPE  da;
-    MANTTYPE  db;
 
 
     diff = ( a->cdigit + a->exp ) - ( b->cdigit + b->exp );
@@ -596,24 +702,38 @@ bool lessnum( PNUMBER a, PNUMBER b )
             }
         else
             {
-            pa = a->mant;
-            pb = b->mant;
-            pa += a->cdigit - 1;
-            pb += b->cdigit - 1;
-            cdigits = max( a->cdigit, b->cdigit );
-            ccdigits = cdigits;
+            // Scan most significant digit first, the first difference
+            // decides the compare.
+            pa = a->mant + a->cdigit - 1;
+            pb = b->mant + b->cdigit - 1;
+            cdigits = min( a->cdigit, b->cdigit );
             for ( ;cdigits > 0; cdigits-- )
                 {
-                da = ( (cdigits > (ccdigits - a->cdigit) ) ?
-                    *pa-- : 0 );
-                db = ( (cdigits > (ccdigits - b->cdigit) ) ?
-                    *pb-- : 0 );
-                diff = da-db;
-                if ( diff )
+                if ( *pa != *pb )
+                    {
+                    return( *pa < *pb );
+                    }
+                pa--;
+                pb--;
+                }
+
+            // Digits in common match, whoever still has a nonzero digit
+            // below the overlap is the bigger number.
+            for ( ccdigits = a->cdigit - b->cdigit; ccdigits > 0; ccdigits-- )
+                {
+                if ( *pa-- )
                     {
-                    return( diff < 0 );
+                    return false;
                     }
                 }
+            for ( ccdigits = b->cdigit - a->cdigit; ccdigits > 0; ccdigits-- )
+                {
+                if ( *pb-- )
+                    {
+                    return true;
+                    }
+                }
+
             // In this case, they are equal.
             return false;
             }
@@ -86,6 +86,62 @@ void fracrat( PRAT *pa , uint32_t radix, int32_t precision)
     RENORMALIZE(*pa);
 }
 
+//-----------------------------------------------------------------------------
+//
+//    FUNCTION: canonrat
+//
+//    ARGUMENTS: pointer to a rational.
+//
+//    RETURN: None, changes pointer.
+//
+//    DESCRIPTION: Restores the canonical integer form pq == 1 when the
+//    denominator is a single BASEX word that divides the numerator evenly.
+//    Integer values keep a denominator of one through multiplies thanks to
+//    the multiply-by-one stub in mulnumx, but division reintroduces small
+//    denominators (6/2 is left as 6 over 2); putting such results back in
+//    integer form lets later adds take the matched-denominator path and
+//    later multiplies skip the denominator entirely.
+//
+//-----------------------------------------------------------------------------
+
+static void canonrat( PRAT *pa )
+
+{
+    PNUMBER pq = (*pa)->pq;
+    if ( pq->cdigit != 1 || pq->exp != 0 || pq->mant[0] <= 1 )
+        {
+        return;
+        }
+
+    PNUMBER pp = (*pa)->pp;
+    MANTTYPE den = pq->mant[0];
+    TWO_MANTTYPE rem = 0;
+    for ( int32_t i = pp->cdigit - 1; i >= 0; i-- )
+        {
+        rem = ( ( rem << BASEXPWR ) | pp->mant[i] ) % den;
+        }
+    if ( rem != 0 )
+        {
+        return;
+        }
+
+    // Divides evenly, replace the numerator with the exact single-word
+    // quotient and blast a one in the denominator.
+    rem = 0;
+    for ( int32_t i = pp->cdigit - 1; i >= 0; i-- )
+        {
+        rem = ( rem << BASEXPWR ) | pp->mant[i];
+        pp->mant[i] = (MANTTYPE)( rem / den );
+        rem %= den;
+        }
+    while ( pp->cdigit > 1 && pp->mant[pp->cdigit-1] == 0 )
+        {
+        pp->cdigit--;
+        }
+    pp->sign *= pq->sign;
+    DUPNUM( ((*pa)->pq), num_one );
+}
+
 //-----------------------------------------------------------------------------
 //
 //    FUNCTION: mulrat
@@ -108,6 +164,7 @@ void mulrat( PRAT *pa, PRAT b, int32_t precision)
         mulnumx( &((*pa)->pp), b->pp );
         mulnumx( &((*pa)->pq), b->pq );
         trimit(pa, precision);
+        canonrat(pa);
         }
     else
         {
@@ -121,6 +178,84 @@ void mulrat( PRAT *pa, PRAT b, int32_t precision)
 
 }
 
+//-----------------------------------------------------------------------------
+//
+//    FUNCTION: mulnaddrat
+//
+//    ARGUMENTS: pointer to a rational, a second and a third rational.
+//
+//    RETURN: None, changes first pointer.
+//
+//    DESCRIPTION: Does the rational equivalent of *pa = *pa * b + c in one
+//    fused step.  The product and the sum share one set of temporaries and
+//    the result is trimmed once, where mulrat followed by addrat trims both
+//    intermediates and walks the denominators twice.
+//
+//-----------------------------------------------------------------------------
+
+void mulnaddrat( PRAT *pa, PRAT b, PRAT c, int32_t precision)
+
+{
+    PNUMBER cross= nullptr;
+
+    if ( zernum( (*pa)->pp ) || zernum( b->pp ) )
+        {
+        // The product term vanishes, the sum is just c.
+        DUPRAT( *pa, c );
+        return;
+        }
+
+    // Result is ( a.pp*b.pp*c.pq + c.pp*(a.pq*b.pq) ) / ( a.pq*b.pq*c.pq ).
+    mulnumx( &((*pa)->pp), b->pp );
+    mulnumx( &((*pa)->pq), b->pq );
+
+    DUPNUM( cross, c->pp );
+    mulnumx( &cross, (*pa)->pq );
+    mulnumx( &((*pa)->pp), c->pq );
+    addnum( &((*pa)->pp), cross, BASEX );
+    destroynum( cross );
+    mulnumx( &((*pa)->pq), c->pq );
+
+    trimit(pa, precision);
+    canonrat(pa);
+
+    // Get rid of negative zeros here.
+    (*pa)->pp->sign *= (*pa)->pq->sign;
+    (*pa)->pq->sign = 1;
+}
+
+//-----------------------------------------------------------------------------
+//
+//    FUNCTION: sqrrat
+//
+//    ARGUMENTS: pointer to a rational.
+//
+//    RETURN: None, changes the pointer.
+//
+//    DESCRIPTION: Does the rational equivalent of *pa *= *pa through the
+//    dedicated squaring kernel, which needs roughly half the multiplies of
+//    the general path.  The result is always non-negative.
+//
+//-----------------------------------------------------------------------------
+
+void sqrrat( PRAT *pa, int32_t precision)
+
+    {
+    // Only do the square if it isn't zero.
+    if ( !zernum( (*pa)->pp ) )
+        {
+        sqrnumx( &((*pa)->pp) );
+        sqrnumx( &((*pa)->pq) );
+        trimit(pa, precision);
+        }
+    else
+        {
+        // If it is zero, blast a one in the denominator.
+        DUPNUM( ((*pa)->pq), num_one );
+        (*pa)->pp->sign = 1;
+        }
+}
+
 //-----------------------------------------------------------------------------
 //
 //    FUNCTION: divrat
@@ -151,6 +286,7 @@ void divrat( PRAT *pa, PRAT b, int32_t precision)
             throw( CALC_E_DIVIDEBYZERO );
             }
         trimit(pa, precision);
+        canonrat(pa);
         }
     else
         {
@@ -242,6 +378,14 @@ void addrat( PRAT *pa, PRAT b, int32_t precision)
         (*pa)->pq->sign = 1;
         }
 
+    // A sum that cancelled to zero would otherwise keep the accumulated
+    // denominator; give zero its unique 0/1 form so later additions take
+    // the matched-denominator path against integers again.
+    if ( zernum( (*pa)->pp ) && !equnum( (*pa)->pq, num_one ) )
+        {
+        DUPNUM( ((*pa)->pq), num_one );
+        }
+
 #ifdef ADDGCD
     gcdrat( pa );
 #endif
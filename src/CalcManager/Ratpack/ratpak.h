@@ -17,6 +17,8 @@
 //
 //-----------------------------------------------------------------------------
 
+#include <atomic>
+
 #include "CalcErr.h"
 
 static constexpr uint32_t BASEXPWR = 31L;// Internal log2(BASEX)
@@ -88,53 +90,55 @@ static constexpr uint32_t MAX_LONG_SIZE = 33; // Base 2 requires 32 'digits'
 //
 //-----------------------------------------------------------------------------
 
-extern PNUMBER num_one;
-extern PNUMBER num_two;
-extern PNUMBER num_five;
-extern PNUMBER num_six;
-extern PNUMBER num_ten;
-
-extern PRAT ln_ten;
-extern PRAT ln_two;
-extern PRAT rat_zero;
-extern PRAT rat_neg_one;
-extern PRAT rat_one;
-extern PRAT rat_two;
-extern PRAT rat_six;
-extern PRAT rat_half;
-extern PRAT rat_ten;
-extern PRAT pt_eight_five;
-extern PRAT pi;
-extern PRAT pi_over_two;
-extern PRAT two_pi;
-extern PRAT one_pt_five_pi;
-extern PRAT e_to_one_half;
-extern PRAT rat_exp;
-extern PRAT rad_to_deg;
-extern PRAT rad_to_grad;
-extern PRAT rat_qword;
-extern PRAT rat_dword;
-extern PRAT rat_word;
-extern PRAT rat_byte;
-extern PRAT rat_360;
-extern PRAT rat_400;
-extern PRAT rat_180;
-extern PRAT rat_200;
-extern PRAT rat_nRadix;
-extern PRAT rat_smallest;
-extern PRAT rat_negsmallest;
-extern PRAT rat_max_exp;
-extern PRAT rat_min_exp;
-extern PRAT rat_max_fact;
-extern PRAT rat_min_fact;
-extern PRAT rat_max_i32;
-extern PRAT rat_min_i32;
-
-// DUPNUM Duplicates a number taking care of allocation and internals
-#define DUPNUM(a,b) destroynum(a);createnum( a, (b)->cdigit );_dupnum(a, b);
-
-// DUPRAT Duplicates a rational taking care of allocation and internals
-#define DUPRAT(a,b) destroyrat(a);createrat(a);DUPNUM((a)->pp,(b)->pp);DUPNUM((a)->pq,(b)->pq);
+extern thread_local PNUMBER num_one;
+extern thread_local PNUMBER num_two;
+extern thread_local PNUMBER num_five;
+extern thread_local PNUMBER num_six;
+extern thread_local PNUMBER num_ten;
+
+extern thread_local PRAT ln_ten;
+extern thread_local PRAT ln_two;
+extern thread_local PRAT rat_zero;
+extern thread_local PRAT rat_neg_one;
+extern thread_local PRAT rat_one;
+extern thread_local PRAT rat_two;
+extern thread_local PRAT rat_six;
+extern thread_local PRAT rat_half;
+extern thread_local PRAT rat_ten;
+extern thread_local PRAT pt_eight_five;
+extern thread_local PRAT pi;
+extern thread_local PRAT pi_over_two;
+extern thread_local PRAT two_pi;
+extern thread_local PRAT one_pt_five_pi;
+extern thread_local PRAT e_to_one_half;
+extern thread_local PRAT rat_exp;
+extern thread_local PRAT rad_to_deg;
+extern thread_local PRAT rad_to_grad;
+extern thread_local PRAT rat_qword;
+extern thread_local PRAT rat_dword;
+extern thread_local PRAT rat_word;
+extern thread_local PRAT rat_byte;
+extern thread_local PRAT rat_360;
+extern thread_local PRAT rat_400;
+extern thread_local PRAT rat_180;
+extern thread_local PRAT rat_200;
+extern thread_local PRAT rat_nRadix;
+extern thread_local PRAT rat_smallest;
+extern thread_local PRAT rat_negsmallest;
+extern thread_local PRAT rat_max_exp;
+extern thread_local PRAT rat_min_exp;
+extern thread_local PRAT rat_max_fact;
+extern thread_local PRAT rat_min_fact;
+extern thread_local PRAT rat_max_i32;
+extern thread_local PRAT rat_min_i32;
+
+// DUPNUM Duplicates a number taking care of allocation and internals,
+// reusing the destination's allocation when it is big enough.
+#define DUPNUM(a,b) dupnum(&(a), b);
+
+// DUPRAT Duplicates a rational taking care of allocation and internals,
+// reusing the destination's allocations when they are big enough.
+#define DUPRAT(a,b) duprat(&(a), b);
 
 // LOG*RADIX calculates the integral portion of the log of a number in
 // the base currently being used, only accurate to within g_ratio
@@ -237,24 +241,45 @@ memmove( (x)->pp->mant, &((x)->pp->mant[trim]), sizeof(MANTTYPE)*((x)->pp->cdigi
 //   Defines for setting up taylor series expansions for infinite precision
 //   functions.
 //
+//   The scratch rationals live in a per-thread freelist so repeated series
+//   evaluations reuse the same shells and their mantissa blocks instead of
+//   allocating and destroying xx/pret/thisterm/n2 every call.  xx and
+//   thisterm stay in the scratch across evaluations (every caller DUPRATs
+//   over them before use); pret is handed to the caller as the result, and
+//   n2 is destroyed since callers assign it directly.
+//
 //-----------------------------------------------------------------------------
 
-#define CREATETAYLOR() PRAT xx=nullptr;\
-    PNUMBER n2=nullptr; \
-    PRAT pret=nullptr; \
-    PRAT thisterm=nullptr; \
+typedef struct _taylorscratch
+{
+    PRAT xx;
+    PNUMBER n2;
+    PRAT pret;
+    PRAT thisterm;
+    struct _taylorscratch *next;
+} TAYLORSCRATCH, *PTAYLORSCRATCH;
+
+extern PTAYLORSCRATCH taylorscratchacquire( void );
+extern void taylorscratchrelease( PTAYLORSCRATCH ts );
+
+#define CREATETAYLOR() PTAYLORSCRATCH ts_taylor_=taylorscratchacquire();\
+    PRAT& xx = ts_taylor_->xx; \
+    PNUMBER& n2 = ts_taylor_->n2; \
+    PRAT& pret = ts_taylor_->pret; \
+    PRAT& thisterm = ts_taylor_->thisterm; \
     DUPRAT(xx,*px); \
-    mulrat(&xx,*px, precision); \
+    sqrrat(&xx, precision); \
     createrat(pret); \
     pret->pp=i32tonum( 0L, BASEX ); \
     pret->pq=i32tonum( 0L, BASEX );
 
 #define DESTROYTAYLOR() destroynum( n2 ); \
-    destroyrat( xx );\
-    destroyrat( thisterm );\
+    n2 = nullptr; \
     destroyrat( *px );\
     trimit(&pret, precision);\
-    *px=pret;
+    *px=pret;\
+    pret = nullptr; \
+    taylorscratchrelease( ts_taylor_ );
 
 // INC(a) is the rational equivalent of a++
 // Check to see if we can avoid doing this the hard way.
@@ -282,7 +307,9 @@ memmove( (x)->pp->mant, &((x)->pp->mant[trim]), sizeof(MANTTYPE)*((x)->pp->cdigi
 // thisterm *= p
 // d    <d is usually an expansion of operations to get thisterm updated.>
 // pret += thisterm
-#define NEXTTERM(p,d,precision) mulrat(&thisterm,p,precision);d addrat( &pret, thisterm, precision )
+// Every series iteration passes through a cancellation/progress checkpoint
+// first, so a long expansion can be aborted between terms.
+#define NEXTTERM(p,d,precision) ratpakcheckpoint(); mulrat(&thisterm,p,precision);d addrat( &pret, thisterm, precision )
 
 //-----------------------------------------------------------------------------
 //
@@ -290,11 +317,11 @@ memmove( (x)->pp->mant, &((x)->pp->mant[trim]), sizeof(MANTTYPE)*((x)->pp->cdigi
 //
 //-----------------------------------------------------------------------------
 
-extern bool g_ftrueinfinite; // set to true to allow infinite precision
+extern thread_local bool g_ftrueinfinite; // set to true to allow infinite precision
                              // don't use unless you know what you are doing
                       // used to help decide when to stop calculating.
 
-extern int32_t g_ratio;  // Internally calculated ratio of internal radix
+extern thread_local int32_t g_ratio;  // Internally calculated ratio of internal radix
 
 //-----------------------------------------------------------------------------
 //
@@ -307,15 +334,52 @@ extern void SetDecimalSeparator(wchar_t decimalSeparator);
 
 // Call whenever either radix or precision changes, is smarter about recalculating constants.
 extern void ChangeConstants(uint32_t radix, int32_t precision);
+extern void ChangeSeriesConcurrency(uint32_t cThreads);
+
+// Cooperative cancellation and progress for the long series loops. The
+// hooks are thread_local, so arm them on the thread that will run the
+// computation. ratpakcheckpoint() is called once per series iteration
+// (NEXTTERM and the factorial loops); it throws CALC_E_CANCELLED when the
+// armed flag is set and reports a heartbeat every
+// RATPAK_PROGRESS_INTERVAL iterations. Either hook may be nullptr.
+static constexpr uint32_t RATPAK_PROGRESS_INTERVAL = 256;
+extern void SetComputationHooks(const std::atomic<bool>* pfCancelRequested, void (*pfnProgress)(void* pContext, uint32_t cIterations), void* pProgressContext);
+extern void ratpakcheckpoint(void);
+
+// Opt-in allocation and operation statistics. Counters are process-wide
+// relaxed atomics and cost one predicted branch on the allocation and
+// multiply paths while disabled, so the flag can stay off in production
+// and be flipped when a trace session is listening. cbLive tracks bytes
+// owned by live numbers; reset it only via ResetRatpakStats, which
+// rebaselines the high-water mark to the current level.
+struct RATPAK_STATS
+{
+    uint64_t cCreateNum;   // _createnum calls
+    uint64_t cDestroyNum;  // _destroynum calls
+    uint64_t cPoolHits;    // creates satisfied from the per-thread pool
+    uint64_t cHeapAllocs;  // creates that fell through to the heap
+    uint64_t cMulNumX;     // mulnumx invocations
+    uint64_t cLimbOps;     // limb multiplies performed by mulnumx
+    uint64_t cbLive;       // bytes currently owned by live numbers
+    uint64_t cbHighWater;  // peak of cbLive since the last reset
+};
+
+extern std::atomic<bool> g_ratpakStatsEnabled;
+extern void EnableRatpakStats(bool enable);
+extern RATPAK_STATS GetRatpakStats();
+extern void ResetRatpakStats();
+extern void RatpakStatsRecordMul(uint64_t limbOps);
 
 extern bool equnum(_In_ PNUMBER a, _In_ PNUMBER b );     // returns true of a == b
 extern bool lessnum(_In_ PNUMBER a, _In_ PNUMBER b );    // returns true of a < b
 extern bool zernum(_In_ PNUMBER a );                // returns true of a == 0
 extern bool zerrat(_In_ PRAT a );                   // returns true if a == 0/q
 extern std::wstring NumberToString(_Inout_ PNUMBER& pnum, int format, uint32_t radix, int32_t precision);
+extern void NumberToString(_Inout_ PNUMBER& pnum, int format, uint32_t radix, int32_t precision, std::wstring& result);
 
 // returns a text representation of a PRAT
 extern std::wstring RatToString(_Inout_ PRAT& prat, int format, uint32_t radix, int32_t precision);
+extern void RatToString(_Inout_ PRAT& prat, int format, uint32_t radix, int32_t precision, std::wstring& result);
 // converts a PRAT into a PNUMBER
 extern PNUMBER RatToNumber(_In_ PRAT prat, uint32_t radix, int32_t precision);
 // flattens a PRAT by converting it to a PNUMBER and back to a PRAT
@@ -398,7 +462,11 @@ extern PRAT Ui32torat( uint32_t inui32 );
 extern PRAT numtorat( _In_ PNUMBER pin, uint32_t radix);
 
 extern void sinhrat( _Inout_ PRAT *px, uint32_t radix, int32_t precision);
-extern void sinrat( _Inout_ PRAT *px );
+extern void sinrat( _Inout_ PRAT *px, uint32_t radix, int32_t precision);
+
+// smashes *px with the sin and *pcos with the cos of x->p/x->q, evaluating
+// both series in one pass over a shared range-reduced argument
+extern void sincosrat( _Inout_ PRAT *px, _Inout_ PRAT *pcos, uint32_t radix, int32_t precision);
 
 // returns a new rat structure with the sin of x->p/x->q taking into account
 // angle type
@@ -412,12 +480,32 @@ extern void tanrat( _Inout_ PRAT *px, uint32_t radix, int32_t precision);
 extern void tananglerat( _Inout_ PRAT *px, ANGLE_TYPE angletype, uint32_t radix, int32_t precision);
 
 extern void _dupnum(_In_ PNUMBER dest, _In_ const NUMBER * const src);
+extern void dupnum(_Inout_ PNUMBER *pa, _In_ const NUMBER * const b);
+extern void duprat(_Inout_ PRAT *pa, _In_ PRAT b);
 
 extern void _destroynum( _In_ PNUMBER pnum );
 extern void _destroyrat( _In_ PRAT prat );
+// releases the calling thread's parked allocator free lists back to the heap
+extern void TrimRatpakPools(void);
+// releases the calling thread's memoized ln(base) entries (exp.cpp)
+extern void TrimPowMemoCache(void);
+// releases the calling thread's trig range-reduction memo (trans.cpp)
+extern void TrimReduceMemoCache(void);
+// releases the calling thread's memoized e^x pair for the hyperbolics (transh.cpp)
+extern void TrimHypExpMemoCache(void);
+// releases the calling thread's radix power ladder (basex.cpp)
+extern void TrimRadixPowMemoCache(void);
+// Releases everything ratpak keeps per thread: the live constants, the
+// cached constant sets, the memo caches and the parked pool blocks.
+// Thread exit reclaims the same state automatically; worker threads call
+// this before their thread procedure returns so a join hands the memory
+// back at a known point.  The thread may compute again afterwards, paying
+// the first-use derivation costs once more.
+extern void ReleaseRatpakThreadState(void);
 extern void addnum( _Inout_ PNUMBER *pa, _In_ PNUMBER b, uint32_t radix);
 extern void addrat( _Inout_ PRAT *pa, _In_ PRAT b, int32_t precision);
 extern void andrat( _Inout_ PRAT *pa, _In_ PRAT b, uint32_t radix, int32_t precision);
+extern void choprat( _Inout_ PRAT *pa, uint32_t bits, uint32_t radix, int32_t precision);
 extern void divnum( _Inout_ PNUMBER *pa, _In_ PNUMBER b, uint32_t radix, int32_t precision);
 extern void divnumx( _Inout_ PNUMBER *pa, _In_ PNUMBER b, int32_t precision);
 extern void divrat( _Inout_ PRAT *pa, _In_ PRAT b, int32_t precision);
@@ -428,9 +516,13 @@ extern void gcdrat( _Inout_ PRAT *pa, int32_t precision);
 extern void intrat( _Inout_ PRAT *px, uint32_t radix, int32_t precision);
 extern void mulnum( _Inout_ PNUMBER *pa, _In_ PNUMBER b, uint32_t radix);
 extern void mulnumx( _Inout_ PNUMBER *pa, _In_ PNUMBER b );
+extern void sqrnumx( _Inout_ PNUMBER *pa );
+extern void mulnaddrat( _Inout_ PRAT *pa, _In_ PRAT b, _In_ PRAT c, int32_t precision);
 extern void mulrat( _Inout_ PRAT *pa, _In_ PRAT b, int32_t precision);
+extern void sqrrat( _Inout_ PRAT *pa, int32_t precision);
 extern void numpowi32( _Inout_ PNUMBER *proot, int32_t power, uint32_t radix, int32_t precision);
 extern void numpowi32x( _Inout_ PNUMBER *proot, int32_t power );
+extern PNUMBER radixpowi32x( uint32_t radix, int32_t power );
 extern void orrat( _Inout_ PRAT *pa, _In_ PRAT b, uint32_t radix, int32_t precision);
 extern void powrat( _Inout_ PRAT *pa, _In_ PRAT b , uint32_t radix, int32_t precision);
 extern void powratNumeratorDenominator(_Inout_ PRAT *pa, _In_ PRAT b, uint32_t radix, int32_t precision);
@@ -19,6 +19,7 @@
 //----------------------------------------------------------------------------
 
 #include "pch.h"
+#include <mutex>
 #include "ratpak.h"
 
 using namespace std;
@@ -26,24 +27,22 @@ using namespace std;
 void _readconstants( void );
 
 #if defined( GEN_CONST )
-static int cbitsofprecision = 0;
+static thread_local int cbitsofprecision = 0;
 #define READRAWRAT(v)
 #define READRAWNUM(v)
 #define DUMPRAWRAT(v) _dumprawrat(#v,v, wcout)
 #define DUMPRAWNUM(v) fprintf( stderr, \
 "// Autogenerated by _dumprawrat in support.cpp\n" ); \
-    fprintf( stderr, "inline const NUMBER init_" #v "= {\n" ); \
-    _dumprawnum(v, wcout); \
-    fprintf( stderr, "};\n" )
+    _dumprawnum(L"init_" #v, v, wcout)
 
 
 #else
 
 #define DUMPRAWRAT(v)
 #define DUMPRAWNUM(v)
-#define READRAWRAT(v) createrat(v); DUPNUM((v)->pp,(&(init_p_##v))); \
-DUPNUM((v)->pq,(&(init_q_##v)));
-#define READRAWNUM(v) DUPNUM(v,(&(init_##v)))
+#define READRAWRAT(v) createrat(v); DUPNUM((v)->pp,NUMCONST(init_p_##v)); \
+DUPNUM((v)->pq,NUMCONST(init_q_##v));
+#define READRAWNUM(v) DUPNUM(v,NUMCONST(init_##v))
 
 #define INIT_AND_DUMP_RAW_NUM_IF_NULL(r, v) if (r == nullptr) { r = i32tonum(v, BASEX); DUMPRAWNUM(v); }
 #define INIT_AND_DUMP_RAW_RAT_IF_NULL(r, v) if (r == nullptr) { r = i32torat(v); DUMPRAWRAT(v); }
@@ -52,57 +51,334 @@ static constexpr int RATIO_FOR_DECIMAL = 9;
 static constexpr int DECIMAL = 10;
 static constexpr int CALC_DECIMAL_DIGITS_DEFAULT = 32;
 
-static int cbitsofprecision = RATIO_FOR_DECIMAL * DECIMAL * CALC_DECIMAL_DIGITS_DEFAULT;
+static thread_local int cbitsofprecision = RATIO_FOR_DECIMAL * DECIMAL * CALC_DECIMAL_DIGITS_DEFAULT;
 
 #include "ratconst.h"
 
 #endif
 
-bool g_ftrueinfinite = false;  // Set to true if you don't want
+thread_local bool g_ftrueinfinite = false;  // Set to true if you don't want
                                         // chopping internally
                                         // precision used internally
 
-PNUMBER num_one= nullptr;
-PNUMBER num_two= nullptr;
-PNUMBER num_five= nullptr;
-PNUMBER num_six= nullptr;
-PNUMBER num_ten= nullptr;
-
-PRAT ln_ten= nullptr;
-PRAT ln_two= nullptr;
-PRAT rat_zero= nullptr;
-PRAT rat_one= nullptr;
-PRAT rat_neg_one= nullptr;
-PRAT rat_two= nullptr;
-PRAT rat_six= nullptr;
-PRAT rat_half= nullptr;
-PRAT rat_ten= nullptr;
-PRAT pt_eight_five= nullptr;
-PRAT pi= nullptr;
-PRAT pi_over_two= nullptr;
-PRAT two_pi= nullptr;
-PRAT one_pt_five_pi= nullptr;
-PRAT e_to_one_half= nullptr;
-PRAT rat_exp= nullptr;
-PRAT rad_to_deg= nullptr;
-PRAT rad_to_grad= nullptr;
-PRAT rat_qword= nullptr;
-PRAT rat_dword= nullptr; // unsigned max ui32
-PRAT rat_word= nullptr;
-PRAT rat_byte= nullptr;
-PRAT rat_360= nullptr;
-PRAT rat_400= nullptr;
-PRAT rat_180= nullptr;
-PRAT rat_200= nullptr;
-PRAT rat_nRadix= nullptr;
-PRAT rat_smallest= nullptr;
-PRAT rat_negsmallest= nullptr;
-PRAT rat_max_exp= nullptr;
-PRAT rat_min_exp= nullptr;
-PRAT rat_max_fact = nullptr;
-PRAT rat_min_fact = nullptr;
-PRAT rat_min_i32= nullptr; // min signed i32
-PRAT rat_max_i32= nullptr; // max signed i32
+thread_local PNUMBER num_one= nullptr;
+thread_local PNUMBER num_two= nullptr;
+thread_local PNUMBER num_five= nullptr;
+thread_local PNUMBER num_six= nullptr;
+thread_local PNUMBER num_ten= nullptr;
+
+thread_local PRAT ln_ten= nullptr;
+thread_local PRAT ln_two= nullptr;
+thread_local PRAT rat_zero= nullptr;
+thread_local PRAT rat_one= nullptr;
+thread_local PRAT rat_neg_one= nullptr;
+thread_local PRAT rat_two= nullptr;
+thread_local PRAT rat_six= nullptr;
+thread_local PRAT rat_half= nullptr;
+thread_local PRAT rat_ten= nullptr;
+thread_local PRAT pt_eight_five= nullptr;
+thread_local PRAT pi= nullptr;
+thread_local PRAT pi_over_two= nullptr;
+thread_local PRAT two_pi= nullptr;
+thread_local PRAT one_pt_five_pi= nullptr;
+thread_local PRAT e_to_one_half= nullptr;
+thread_local PRAT rat_exp= nullptr;
+thread_local PRAT rad_to_deg= nullptr;
+thread_local PRAT rad_to_grad= nullptr;
+thread_local PRAT rat_qword= nullptr;
+thread_local PRAT rat_dword= nullptr; // unsigned max ui32
+thread_local PRAT rat_word= nullptr;
+thread_local PRAT rat_byte= nullptr;
+thread_local PRAT rat_360= nullptr;
+thread_local PRAT rat_400= nullptr;
+thread_local PRAT rat_180= nullptr;
+thread_local PRAT rat_200= nullptr;
+thread_local PRAT rat_nRadix= nullptr;
+thread_local PRAT rat_smallest= nullptr;
+thread_local PRAT rat_negsmallest= nullptr;
+thread_local PRAT rat_max_exp= nullptr;
+thread_local PRAT rat_min_exp= nullptr;
+thread_local PRAT rat_max_fact= nullptr;
+thread_local PRAT rat_min_fact= nullptr;
+thread_local PRAT rat_min_i32= nullptr; // min signed i32
+thread_local PRAT rat_max_i32= nullptr; // max signed i32
+
+namespace {
+
+// Snapshot of every constant ChangeConstants derives from a given
+// (radix, precision) pair.  The literal constants (num_one, rat_two, ...)
+// never vary, so they are not part of the snapshot.
+struct CONSTANTSET
+{
+    int32_t ratio;
+    PRAT nRadix;
+    PRAT smallest;
+    PRAT negsmallest;
+    PRAT qword;
+    PRAT dword;
+    PRAT max_i32;
+    PRAT min_i32;
+    PRAT min_exp;
+    PRAT c_pi;
+    PRAT c_two_pi;
+    PRAT c_pi_over_two;
+    PRAT c_one_pt_five_pi;
+    PRAT c_e_to_one_half;
+    PRAT c_rat_exp;
+    PRAT c_ln_ten;
+    PRAT c_ln_two;
+    PRAT c_rad_to_deg;
+    PRAT c_rad_to_grad;
+};
+
+// Derived constant sets, keyed by radix in the upper half and precision in
+// the lower.  Programmer mode flips radix on every HEX/DEC/OCT/BIN toggle,
+// so sets are kept for the life of the thread once derived.  The store
+// owns its sets: the map destructor alone would free the nodes but leak
+// every PRAT inside, and threads come and go (engine workers, the
+// warm-pool filler, speculation workers).
+struct CONSTANTSETSTORE
+{
+    unordered_map<uint64_t, CONSTANTSET> sets;
+
+    void clear();
+
+    ~CONSTANTSETSTORE()
+    {
+        clear();
+        // The destroys above parked their blocks on this thread's free
+        // lists.  Destruction order between the ratpak thread locals is
+        // unspecified, so every owner drains after itself.
+        TrimRatpakPools();
+    }
+};
+thread_local CONSTANTSETSTORE g_constantSetStore;
+
+// Master copies of the derived sets, shared by every thread in the
+// process.  Entries are immutable once published, so the mutex guards
+// only map access and readers duplicate out from under it.  A new
+// window's thread seeds its constants from here instead of re-deriving
+// pi, e and the logarithm constants all over again.
+mutex g_sharedConstantSetsMutex;
+unordered_map<uint64_t, CONSTANTSET> g_sharedConstantSets;
+
+uint64_t ConstantSetKey(uint32_t radix, int32_t precision)
+{
+    return (static_cast<uint64_t>(radix) << 32) | static_cast<uint32_t>(precision);
+}
+
+// Installs a derived set into this thread's live constants.
+void ApplyConstantSet(const CONSTANTSET& set)
+{
+    g_ratio = set.ratio;
+    DUPRAT(rat_nRadix, set.nRadix);
+    DUPRAT(rat_smallest, set.smallest);
+    DUPRAT(rat_negsmallest, set.negsmallest);
+    DUPRAT(rat_qword, set.qword);
+    DUPRAT(rat_dword, set.dword);
+    DUPRAT(rat_max_i32, set.max_i32);
+    DUPRAT(rat_min_i32, set.min_i32);
+    DUPRAT(rat_min_exp, set.min_exp);
+    DUPRAT(pi, set.c_pi);
+    DUPRAT(two_pi, set.c_two_pi);
+    DUPRAT(pi_over_two, set.c_pi_over_two);
+    DUPRAT(one_pt_five_pi, set.c_one_pt_five_pi);
+    DUPRAT(e_to_one_half, set.c_e_to_one_half);
+    DUPRAT(rat_exp, set.c_rat_exp);
+    DUPRAT(ln_ten, set.c_ln_ten);
+    DUPRAT(ln_two, set.c_ln_two);
+    DUPRAT(rad_to_deg, set.c_rad_to_deg);
+    DUPRAT(rad_to_grad, set.c_rad_to_grad);
+}
+
+// Deep copy of a derived set, for publishing to or seeding from the
+// shared pool without aliasing rationals across threads.
+CONSTANTSET CopyConstantSet(const CONSTANTSET& set)
+{
+    CONSTANTSET copy = {};
+    copy.ratio = set.ratio;
+    DUPRAT(copy.nRadix, set.nRadix);
+    DUPRAT(copy.smallest, set.smallest);
+    DUPRAT(copy.negsmallest, set.negsmallest);
+    DUPRAT(copy.qword, set.qword);
+    DUPRAT(copy.dword, set.dword);
+    DUPRAT(copy.max_i32, set.max_i32);
+    DUPRAT(copy.min_i32, set.min_i32);
+    DUPRAT(copy.min_exp, set.min_exp);
+    DUPRAT(copy.c_pi, set.c_pi);
+    DUPRAT(copy.c_two_pi, set.c_two_pi);
+    DUPRAT(copy.c_pi_over_two, set.c_pi_over_two);
+    DUPRAT(copy.c_one_pt_five_pi, set.c_one_pt_five_pi);
+    DUPRAT(copy.c_e_to_one_half, set.c_e_to_one_half);
+    DUPRAT(copy.c_rat_exp, set.c_rat_exp);
+    DUPRAT(copy.c_ln_ten, set.c_ln_ten);
+    DUPRAT(copy.c_ln_two, set.c_ln_two);
+    DUPRAT(copy.c_rad_to_deg, set.c_rad_to_deg);
+    DUPRAT(copy.c_rad_to_grad, set.c_rad_to_grad);
+    return copy;
+}
+
+// Releases a derived set's rationals; the inverse of CopyConstantSet.
+void DestroyConstantSet(CONSTANTSET& set)
+{
+    destroyrat(set.nRadix);
+    destroyrat(set.smallest);
+    destroyrat(set.negsmallest);
+    destroyrat(set.qword);
+    destroyrat(set.dword);
+    destroyrat(set.max_i32);
+    destroyrat(set.min_i32);
+    destroyrat(set.min_exp);
+    destroyrat(set.c_pi);
+    destroyrat(set.c_two_pi);
+    destroyrat(set.c_pi_over_two);
+    destroyrat(set.c_one_pt_five_pi);
+    destroyrat(set.c_e_to_one_half);
+    destroyrat(set.c_rat_exp);
+    destroyrat(set.c_ln_ten);
+    destroyrat(set.c_ln_two);
+    destroyrat(set.c_rad_to_deg);
+    destroyrat(set.c_rad_to_grad);
+}
+
+void CONSTANTSETSTORE::clear()
+{
+    for (auto& entry : sets)
+    {
+        DestroyConstantSet(entry.second);
+    }
+    sets.clear();
+}
+
+// Releases the thread's ratpak state for threads that exit without calling
+// ReleaseRatpakThreadState themselves (the UI thread, thread-pool threads).
+// Registered on a thread's first ChangeConstants call - after the store
+// above is constructed, and nothing can hold ratpak state before that
+// call - so at thread exit it runs while the store is still alive;
+// everything else it releases lives in trivially destructible
+// thread_local storage, where order does not matter.
+struct THREADSTATERELEASER
+{
+    ~THREADSTATERELEASER()
+    {
+        ReleaseRatpakThreadState();
+    }
+};
+
+void EnsureThreadStateRelease()
+{
+    thread_local THREADSTATERELEASER t_releaser;
+}
+
+// The literal constants (1, 2, ten, 1/2, ...) do not vary with radix or
+// precision but live per thread; a thread seeded from the shared pool
+// still needs them created once.
+void InitLiteralConstants()
+{
+    INIT_AND_DUMP_RAW_NUM_IF_NULL(num_one, 1L);
+    INIT_AND_DUMP_RAW_NUM_IF_NULL(num_two, 2L);
+    INIT_AND_DUMP_RAW_NUM_IF_NULL(num_five, 5L);
+    INIT_AND_DUMP_RAW_NUM_IF_NULL(num_six, 6L);
+    INIT_AND_DUMP_RAW_NUM_IF_NULL(num_ten, 10L);
+    INIT_AND_DUMP_RAW_RAT_IF_NULL(rat_six, 6L);
+    INIT_AND_DUMP_RAW_RAT_IF_NULL(rat_two, 2L);
+    INIT_AND_DUMP_RAW_RAT_IF_NULL(rat_zero, 0L);
+    INIT_AND_DUMP_RAW_RAT_IF_NULL(rat_one, 1L);
+    INIT_AND_DUMP_RAW_RAT_IF_NULL(rat_neg_one, -1L);
+    INIT_AND_DUMP_RAW_RAT_IF_NULL(rat_ten, 10L);
+    INIT_AND_DUMP_RAW_RAT_IF_NULL(rat_word, 0xffff);
+    INIT_AND_DUMP_RAW_RAT_IF_NULL(rat_byte, 0xff);
+    INIT_AND_DUMP_RAW_RAT_IF_NULL(rat_400, 400);
+    INIT_AND_DUMP_RAW_RAT_IF_NULL(rat_360, 360);
+    INIT_AND_DUMP_RAW_RAT_IF_NULL(rat_200, 200);
+    INIT_AND_DUMP_RAW_RAT_IF_NULL(rat_180, 180);
+    INIT_AND_DUMP_RAW_RAT_IF_NULL(rat_max_exp, 100000);
+
+    // 3248, is the max number for which calc is able to compute factorial, after that it is unable to compute due to overflow.
+    // Hence restricted factorial range as at most 3248.Beyond that calc will throw overflow error immediately.
+    INIT_AND_DUMP_RAW_RAT_IF_NULL(rat_max_fact, 3249);
+
+    // -1000, is the min number for which calc is able to compute factorial, after that it takes too long to compute.
+    INIT_AND_DUMP_RAW_RAT_IF_NULL(rat_min_fact, -1000);
+
+    if (rat_half == nullptr)
+    {
+        createrat(rat_half);
+        DUPNUM(rat_half->pp, num_one);
+        DUPNUM(rat_half->pq, num_two);
+        DUMPRAWRAT(rat_half);
+    }
+
+    if (pt_eight_five == nullptr)
+    {
+        createrat(pt_eight_five);
+        pt_eight_five->pp = i32tonum(85L, BASEX);
+        pt_eight_five->pq = i32tonum(100L, BASEX);
+        DUMPRAWRAT(pt_eight_five);
+    }
+}
+
+} // namespace
+
+// Per-thread computation hooks, armed through SetComputationHooks by
+// whoever drives the computation (the calculator manager arms them per
+// command).  The iteration counter restarts whenever the hooks are armed.
+static thread_local const std::atomic<bool>* t_pfCancelRequested = nullptr;
+static thread_local void (*t_pfnProgress)(void*, uint32_t) = nullptr;
+static thread_local void* t_pProgressContext = nullptr;
+static thread_local uint32_t t_cCheckpointIterations = 0;
+
+//----------------------------------------------------------------------------
+//
+//  FUNCTION: SetComputationHooks
+//
+//  ARGUMENTS: pfCancelRequested flag polled at every checkpoint, pfnProgress
+//             heartbeat raised every RATPAK_PROGRESS_INTERVAL checkpoints
+//             with pProgressContext and the iteration count.  Either may be
+//             nullptr to disarm that hook.
+//
+//  RETURN: None
+//
+//  EXPLANATION: Arms the calling thread's cancellation and progress hooks
+//  for subsequent series evaluations and resets the iteration counter, so
+//  the heartbeat counts iterations of the computation about to start.
+//
+//----------------------------------------------------------------------------
+
+void SetComputationHooks(const std::atomic<bool>* pfCancelRequested, void (*pfnProgress)(void* pContext, uint32_t cIterations), void* pProgressContext)
+{
+    t_pfCancelRequested = pfCancelRequested;
+    t_pfnProgress = pfnProgress;
+    t_pProgressContext = pProgressContext;
+    t_cCheckpointIterations = 0;
+}
+
+//----------------------------------------------------------------------------
+//
+//  FUNCTION: ratpakcheckpoint
+//
+//  ARGUMENTS: None
+//
+//  RETURN: None, throws CALC_E_CANCELLED when cancellation was requested.
+//
+//  EXPLANATION: Called once per iteration from the series loops (NEXTTERM,
+//  the factorial product and gamma loops).  Unarmed it is a pair of
+//  thread-local loads, cheap against the rational arithmetic of one term.
+//
+//----------------------------------------------------------------------------
+
+void ratpakcheckpoint(void)
+{
+    if (t_pfCancelRequested != nullptr && t_pfCancelRequested->load(std::memory_order_relaxed))
+    {
+        throw( CALC_E_CANCELLED );
+    }
+
+    if (++t_cCheckpointIterations % RATPAK_PROGRESS_INTERVAL == 0 && t_pfnProgress != nullptr)
+    {
+        t_pfnProgress(t_pProgressContext, t_cCheckpointIterations);
+    }
+}
 
 //----------------------------------------------------------------------------
 //
@@ -119,6 +395,33 @@ PRAT rat_max_i32= nullptr; // max signed i32
 
 void ChangeConstants(uint32_t radix, int32_t precision)
 {
+    // Reuse a previously derived constant set whenever this (radix,
+    // precision) pair has been seen before on this thread.
+    const uint64_t key = ConstantSetKey(radix, precision);
+    const auto cached = g_constantSetStore.sets.find(key);
+    EnsureThreadStateRelease();
+    if (cached != g_constantSetStore.sets.end())
+    {
+        ApplyConstantSet(cached->second);
+        return;
+    }
+
+    // Another thread (another window, or the series workers) may have
+    // derived and published this set already.  Masters are immutable, so
+    // duplicating out from under the map lock is safe and far cheaper
+    // than recomputing pi and friends at this precision.
+    {
+        lock_guard<mutex> lock(g_sharedConstantSetsMutex);
+        const auto shared = g_sharedConstantSets.find(key);
+        if (shared != g_sharedConstantSets.end())
+        {
+            InitLiteralConstants();
+            ApplyConstantSet(shared->second);
+            g_constantSetStore.sets.emplace(key, CopyConstantSet(shared->second));
+            return;
+        }
+    }
+
     // ratio is set to the number of digits in the current radix, you can get
     // in the internal BASEX radix, this is important for length calculations
     // in translating from radix to BASEX and back.
@@ -139,31 +442,7 @@ void ChangeConstants(uint32_t radix, int32_t precision)
     {
         g_ftrueinfinite = false;
 
-        INIT_AND_DUMP_RAW_NUM_IF_NULL(num_one, 1L);
-        INIT_AND_DUMP_RAW_NUM_IF_NULL(num_two, 2L);
-        INIT_AND_DUMP_RAW_NUM_IF_NULL(num_five, 5L);
-        INIT_AND_DUMP_RAW_NUM_IF_NULL(num_six, 6L);
-        INIT_AND_DUMP_RAW_NUM_IF_NULL(num_ten, 10L);
-        INIT_AND_DUMP_RAW_RAT_IF_NULL(rat_six, 6L);
-        INIT_AND_DUMP_RAW_RAT_IF_NULL(rat_two, 2L);
-        INIT_AND_DUMP_RAW_RAT_IF_NULL(rat_zero, 0L);
-        INIT_AND_DUMP_RAW_RAT_IF_NULL(rat_one, 1L);
-        INIT_AND_DUMP_RAW_RAT_IF_NULL(rat_neg_one, -1L);
-        INIT_AND_DUMP_RAW_RAT_IF_NULL(rat_ten, 10L);
-        INIT_AND_DUMP_RAW_RAT_IF_NULL(rat_word, 0xffff);
-        INIT_AND_DUMP_RAW_RAT_IF_NULL(rat_word, 0xff);
-        INIT_AND_DUMP_RAW_RAT_IF_NULL(rat_400, 400);
-        INIT_AND_DUMP_RAW_RAT_IF_NULL(rat_360, 360);
-        INIT_AND_DUMP_RAW_RAT_IF_NULL(rat_200, 200);
-        INIT_AND_DUMP_RAW_RAT_IF_NULL(rat_180, 180);
-        INIT_AND_DUMP_RAW_RAT_IF_NULL(rat_max_exp, 100000);
-
-        // 3248, is the max number for which calc is able to compute factorial, after that it is unable to compute due to overflow.
-        // Hence restricted factorial range as at most 3248.Beyond that calc will throw overflow error immediately.
-        INIT_AND_DUMP_RAW_RAT_IF_NULL(rat_max_fact, 3249);
-
-        // -1000, is the min number for which calc is able to compute factorial, after that it takes too long to compute.
-        INIT_AND_DUMP_RAW_RAT_IF_NULL(rat_min_fact, -1000);
+        InitLiteralConstants();
 
         DUPRAT(rat_smallest, rat_nRadix);
         ratpowi32(&rat_smallest, -precision, precision);
@@ -172,22 +451,6 @@ void ChangeConstants(uint32_t radix, int32_t precision)
         DUMPRAWRAT(rat_smallest);
         DUMPRAWRAT(rat_negsmallest);
 
-        if (rat_half == nullptr)
-        {
-            createrat(rat_half);
-            DUPNUM(rat_half->pp, num_one);
-            DUPNUM(rat_half->pq, num_two);
-            DUMPRAWRAT(rat_half);
-        }
-
-        if (pt_eight_five == nullptr)
-        {
-            createrat(pt_eight_five);
-            pt_eight_five->pp = i32tonum(85L, BASEX);
-            pt_eight_five->pq = i32tonum(100L, BASEX);
-            DUMPRAWRAT(pt_eight_five);
-        }
-
         DUPRAT(rat_qword, rat_two);
         numpowi32(&(rat_qword->pp), 64, BASEX, precision);
         subrat(&rat_qword, rat_one, precision);
@@ -272,6 +535,40 @@ void ChangeConstants(uint32_t radix, int32_t precision)
         rat_negsmallest->pp->sign = -1;
     }
 
+    // Remember the derived set so the next switch to this (radix, precision)
+    // is a copy instead of a recomputation.
+    CONSTANTSET set = {};
+    set.ratio = g_ratio;
+    DUPRAT(set.nRadix, rat_nRadix);
+    DUPRAT(set.smallest, rat_smallest);
+    DUPRAT(set.negsmallest, rat_negsmallest);
+    DUPRAT(set.qword, rat_qword);
+    DUPRAT(set.dword, rat_dword);
+    DUPRAT(set.max_i32, rat_max_i32);
+    DUPRAT(set.min_i32, rat_min_i32);
+    DUPRAT(set.min_exp, rat_min_exp);
+    DUPRAT(set.c_pi, pi);
+    DUPRAT(set.c_two_pi, two_pi);
+    DUPRAT(set.c_pi_over_two, pi_over_two);
+    DUPRAT(set.c_one_pt_five_pi, one_pt_five_pi);
+    DUPRAT(set.c_e_to_one_half, e_to_one_half);
+    DUPRAT(set.c_rat_exp, rat_exp);
+    DUPRAT(set.c_ln_ten, ln_ten);
+    DUPRAT(set.c_ln_two, ln_two);
+    DUPRAT(set.c_rad_to_deg, rad_to_deg);
+    DUPRAT(set.c_rad_to_grad, rad_to_grad);
+
+    // Publish a master copy for the other threads; the first deriver of a
+    // key wins and the set is immutable from then on.
+    {
+        lock_guard<mutex> lock(g_sharedConstantSetsMutex);
+        if (g_sharedConstantSets.find(key) == g_sharedConstantSets.end())
+        {
+            g_sharedConstantSets.emplace(key, CopyConstantSet(set));
+        }
+    }
+
+    g_constantSetStore.sets.emplace(key, set);
 }
 
 //----------------------------------------------------------------------------
@@ -298,11 +595,16 @@ void intrat( PRAT *px, uint32_t radix, int32_t precision)
         DUPRAT(pret,*px);
         modrat( &pret, rat_one );
 
-        subrat( px, pret, precision);
-        destroyrat( pret );
+        // If the value was already integral the flatrat above left it in
+        // simplest form; only the nonzero-fraction case needs more work.
+        if ( !zerrat( pret ) )
+        {
+            subrat( px, pret, precision);
 
-        // Simplify the value if possible to resolve rounding errors
-        flatrat(*px, radix, precision);
+            // Simplify the value if possible to resolve rounding errors
+            flatrat(*px, radix, precision);
+        }
+        destroyrat( pret );
     }
 }
 
@@ -317,9 +619,75 @@ void intrat( PRAT *px, uint32_t radix, int32_t precision)
 //
 //---------------------------------------------------------------------------
 
+//---------------------------------------------------------------------------
+//
+//  FUNCTION: ratcmpquick
+//
+//  ARGUMENTS:  PRAT a, PRAT b and an out pointer for the comparison result.
+//
+//  RETURN: true when the ordering could be decided from signs and BASEX
+//          word counts alone, with *pcmp set to -1, 0 or 1.  false means
+//          the caller has to do the full cross multiply.
+//
+//  Spares the comparison helpers an addrat when the operands differ in
+//  sign or differ in magnitude by several BASEX words, which covers most
+//  of the compares issued from scaling and domain-check loops.
+//
+//---------------------------------------------------------------------------
+
+static bool ratcmpquick( PRAT a, PRAT b, int32_t *pcmp )
+
+{
+    int32_t sgna = zernum( a->pp ) ? 0 : a->pp->sign * a->pq->sign;
+    int32_t sgnb = zernum( b->pp ) ? 0 : b->pp->sign * b->pq->sign;
+    if ( sgna != sgnb )
+        {
+        *pcmp = ( sgna > sgnb ) ? 1 : -1;
+        return( true );
+        }
+    if ( sgna == 0 )
+        {
+        *pcmp = 0;
+        return( true );
+        }
+
+    // Same nonzero sign.  LOGRAT2 locates each magnitude to within a
+    // couple of BASEX words, so a wide enough gap decides the compare;
+    // for negative values the larger magnitude is the smaller value.
+    int32_t la = LOGRAT2(a);
+    int32_t lb = LOGRAT2(b);
+    if ( la - lb >= 4 || lb - la >= 4 )
+        {
+        *pcmp = ( ( la > lb ) == ( sgna == 1 ) ) ? 1 : -1;
+        return( true );
+        }
+
+    // Matching denominator magnitudes (the common case: both integers with
+    // q == 1, or results of the matched-denominator add path) order by the
+    // numerators alone — a limb scan instead of a cross multiply.
+    if ( equnum( a->pq, b->pq ) )
+        {
+        if ( equnum( a->pp, b->pp ) )
+            {
+            *pcmp = 0;
+            }
+        else
+            {
+            *pcmp = ( lessnum( a->pp, b->pp ) == ( sgna == 1 ) ) ? -1 : 1;
+            }
+        return( true );
+        }
+    return( false );
+}
+
 bool rat_equ( PRAT a, PRAT b, int32_t precision)
 
 {
+    int32_t cmp;
+    if ( ratcmpquick( a, b, &cmp ) )
+        {
+        return( cmp == 0 );
+        }
     PRAT rattmp= nullptr;
     DUPRAT(rattmp,a);
     rattmp->pp->sign *= -1;
@@ -343,6 +711,11 @@ bool rat_equ( PRAT a, PRAT b, int32_t precision)
 bool rat_ge( PRAT a, PRAT b, int32_t precision)
 
 {
+    int32_t cmp;
+    if ( ratcmpquick( a, b, &cmp ) )
+        {
+        return( cmp >= 0 );
+        }
     PRAT rattmp= nullptr;
     DUPRAT(rattmp,a);
     b->pp->sign *= -1;
@@ -369,6 +742,11 @@ bool rat_ge( PRAT a, PRAT b, int32_t precision)
 bool rat_gt( PRAT a, PRAT b, int32_t precision)
 
 {
+    int32_t cmp;
+    if ( ratcmpquick( a, b, &cmp ) )
+        {
+        return( cmp > 0 );
+        }
     PRAT rattmp= nullptr;
     DUPRAT(rattmp,a);
     b->pp->sign *= -1;
@@ -394,6 +772,11 @@ bool rat_gt( PRAT a, PRAT b, int32_t precision)
 bool rat_le( PRAT a, PRAT b, int32_t precision)
 
 {
+    int32_t cmp;
+    if ( ratcmpquick( a, b, &cmp ) )
+        {
+        return( cmp <= 0 );
+        }
 
     PRAT rattmp= nullptr;
     DUPRAT(rattmp,a);
@@ -421,6 +804,11 @@ bool rat_le( PRAT a, PRAT b, int32_t precision)
 bool rat_lt( PRAT a, PRAT b, int32_t precision)
 
 {
+    int32_t cmp;
+    if ( ratcmpquick( a, b, &cmp ) )
+        {
+        return( cmp < 0 );
+        }
     PRAT rattmp= nullptr;
     DUPRAT(rattmp,a);
     b->pp->sign *= -1;
@@ -448,6 +836,11 @@ bool rat_lt( PRAT a, PRAT b, int32_t precision)
 bool rat_neq( PRAT a, PRAT b, int32_t precision)
 
 {
+    int32_t cmp;
+    if ( ratcmpquick( a, b, &cmp ) )
+        {
+        return( cmp != 0 );
+        }
     PRAT rattmp= nullptr;
     DUPRAT(rattmp,a);
     rattmp->pp->sign *= -1;
@@ -484,11 +877,11 @@ void scale( PRAT *px, PRAT scalefact, uint32_t radix, int32_t precision )
 
     divrat( &pret, scalefact, precision);
     intrat(&pret, radix, precision);
-    mulrat( &pret, scalefact, precision);
     pret->pp->sign *= -1;
-    addrat( px, pret, precision);
+    mulnaddrat( &pret, scalefact, *px, precision);
 
-    destroyrat( pret );
+    destroyrat( *px );
+    *px = pret;
 }
 
 //---------------------------------------------------------------------------
@@ -502,6 +895,13 @@ void scale( PRAT *px, PRAT scalefact, uint32_t radix, int32_t precision )
 //
 //---------------------------------------------------------------------------
 
+// 1/(2 pi), derived once per (radix, precision) pair on each thread so the
+// common-case range reduction below is a multiply-truncate instead of a
+// full-precision divide on every trig call.
+static thread_local PRAT two_pi_recip = nullptr;
+static thread_local uint32_t two_pi_recip_radix = 0;
+static thread_local int32_t two_pi_recip_precision = -1;
+
 void scale2pi( PRAT *px, uint32_t radix, int32_t precision )
 {
     PRAT pret = nullptr;
@@ -519,21 +919,54 @@ void scale2pi( PRAT *px, uint32_t radix, int32_t precision )
         asinrat( &my_two_pi, radix, precision);
         mulrat( &my_two_pi, rat_six, precision);
         mulrat( &my_two_pi, rat_two, precision);
+
+        // Oversized arguments keep the boosted-precision divide; the
+        // cached reciprocal below only covers the working precision.
+        divrat( &pret, my_two_pi, precision);
     }
     else
     {
+        // Numerator words below denominator words means |x| < 1, already
+        // inside one period.
+        if ( pret->pp->cdigit + pret->pp->exp < pret->pq->cdigit + pret->pq->exp )
+        {
+            destroyrat( pret );
+            return;
+        }
+
         DUPRAT(my_two_pi,two_pi);
         logscale = 0;
+
+        if ( two_pi_recip == nullptr || two_pi_recip_radix != radix ||
+            two_pi_recip_precision != precision )
+        {
+            destroyrat( two_pi_recip );
+            DUPRAT(two_pi_recip, rat_one);
+            divrat( &two_pi_recip, two_pi, precision);
+            two_pi_recip_radix = radix;
+            two_pi_recip_precision = precision;
+        }
+        mulrat( &pret, two_pi_recip, precision);
     }
 
-    divrat( &pret, my_two_pi, precision);
     intrat(&pret, radix, precision);
-    mulrat( &pret, my_two_pi, precision);
+    if ( zernum( pret->pp ) )
+    {
+        // Quotient truncated to zero: the argument needs no reduction.
+        // The old divide path reached the same answer through a multiply
+        // and add of zero.
+        destroyrat( pret );
+        destroyrat( my_two_pi );
+        return;
+    }
+
     pret->pp->sign *= -1;
-    addrat( px, pret, precision);
+    mulnaddrat( &pret, my_two_pi, *px, precision);
+
+    destroyrat( *px );
+    *px = pret;
 
     destroyrat( my_two_pi );
-    destroyrat( pret );
 }
 
 //---------------------------------------------------------------------------
@@ -598,7 +1031,7 @@ void _dumprawnum(const wchar_t *varname, PNUMBER num, wostream& out)
 {
     int i;
 
-    out << L"NUMBER " << varname << L" = {\n";
+    out << L"inline constexpr RAWNUM<" << num->cdigit << L"> " << varname << L" = {\n";
     out << L"\t"<< num->sign << L",\n";
     out << L"\t" << num->cdigit << L",\n";
     out << L"\t" << num->exp << L",\n";
@@ -679,6 +1112,11 @@ void _readconstants( void )
 void trimit( PRAT *px, int32_t precision)
 
 {
+    // A physical trim memmoves the retained mantissa words, so small
+    // excesses are carried as extra guard words until this many words of
+    // waste have built up; exponent-absorbed trims stay free and immediate.
+    constexpr int32_t TRIM_DEFER_WORDS = 4;
+
     if ( !g_ftrueinfinite )
         {
         int32_t trim;
@@ -689,26 +1127,35 @@ void trimit( PRAT *px, int32_t precision)
             {
             trim /= g_ratio;
 
-            if ( trim <= pp->exp )
+            if ( trim <= pp->exp && trim <= pq->exp )
                 {
+                // Both drops land in the exponents, pure bookkeeping.
                 pp->exp -= trim;
-                }
-            else
-                {
-                memmove( pp->mant, &(pp->mant[trim-pp->exp]), sizeof(MANTTYPE)*(pp->cdigit-trim+pp->exp) );
-                pp->cdigit -= trim-pp->exp;
-                pp->exp = 0;
-                }
-
-            if ( trim <= pq->exp )
-                {
                 pq->exp -= trim;
                 }
-            else
+            else if ( trim >= TRIM_DEFER_WORDS )
                 {
-                memmove( pq->mant, &(pq->mant[trim-pq->exp]), sizeof(MANTTYPE)*(pq->cdigit-trim+pq->exp) );
-                pq->cdigit -= trim-pq->exp;
-                pq->exp = 0;
+                if ( trim <= pp->exp )
+                    {
+                    pp->exp -= trim;
+                    }
+                else
+                    {
+                    memmove( pp->mant, &(pp->mant[trim-pp->exp]), sizeof(MANTTYPE)*(pp->cdigit-trim+pp->exp) );
+                    pp->cdigit -= trim-pp->exp;
+                    pp->exp = 0;
+                    }
+
+                if ( trim <= pq->exp )
+                    {
+                    pq->exp -= trim;
+                    }
+                else
+                    {
+                    memmove( pq->mant, &(pq->mant[trim-pq->exp]), sizeof(MANTTYPE)*(pq->cdigit-trim+pq->exp) );
+                    pq->cdigit -= trim-pq->exp;
+                    pq->exp = 0;
+                    }
                 }
             }
         trim = min(pp->exp,pq->exp);
@@ -716,3 +1163,148 @@ void trimit( PRAT *px, int32_t precision)
         pq->exp -= trim;
         }
 }
+
+//---------------------------------------------------------------------------
+//
+//  FUNCTION: taylorscratchacquire, taylorscratchrelease
+//
+//  ARGUMENTS: none / the scratch set to return.
+//
+//  RETURN: a scratch set for the CREATETAYLOR machinery.
+//
+//  DESCRIPTION: Backs the Taylor series macros with a per-thread freelist
+//  of scratch rationals.  Released sets keep their xx and thisterm shells
+//  (and mantissa blocks) alive, so the next series evaluation DUPRATs into
+//  warm storage instead of allocating; pret leaves with the caller as the
+//  series result and n2 is destroyed by DESTROYTAYLOR.  The list grows to
+//  the deepest nesting seen on the thread, which is never more than a few
+//  entries.
+//
+//---------------------------------------------------------------------------
+
+static thread_local PTAYLORSCRATCH g_taylorFreeList = nullptr;
+
+PTAYLORSCRATCH taylorscratchacquire( void )
+
+{
+    PTAYLORSCRATCH ts = g_taylorFreeList;
+    if ( ts != nullptr )
+        {
+        g_taylorFreeList = ts->next;
+        }
+    else
+        {
+        ts = new TAYLORSCRATCH;
+        ts->xx = nullptr;
+        ts->n2 = nullptr;
+        ts->pret = nullptr;
+        ts->thisterm = nullptr;
+        }
+    ts->next = nullptr;
+    return( ts );
+}
+
+void taylorscratchrelease( PTAYLORSCRATCH ts )
+
+{
+    ts->next = g_taylorFreeList;
+    g_taylorFreeList = ts;
+}
+
+//---------------------------------------------------------------------------
+//
+//  FUNCTION: ReleaseRatpakThreadState
+//
+//  ARGUMENTS: none
+//
+//  RETURN: None, globals change.
+//
+//  DESCRIPTION: Frees everything ratpak keeps per thread: the literal and
+//  derived constants, the cached constant sets, the 2pi reciprocal memo,
+//  the memo caches, the Taylor scratch freelist and the parked pool
+//  blocks.  The thread-exit sentinel
+//  registered by ChangeConstants calls this automatically; worker threads
+//  that a join will reclaim call it explicitly before their thread
+//  procedure returns.  The thread is left looking like a brand-new one and
+//  may compute again afterwards, paying the first-use derivation costs
+//  once more.
+//
+//---------------------------------------------------------------------------
+
+void ReleaseRatpakThreadState( void )
+
+{
+    destroynum( num_one );
+    destroynum( num_two );
+    destroynum( num_five );
+    destroynum( num_six );
+    destroynum( num_ten );
+
+    destroyrat( ln_ten );
+    destroyrat( ln_two );
+    destroyrat( rat_zero );
+    destroyrat( rat_one );
+    destroyrat( rat_neg_one );
+    destroyrat( rat_two );
+    destroyrat( rat_six );
+    destroyrat( rat_half );
+    destroyrat( rat_ten );
+    destroyrat( pt_eight_five );
+    destroyrat( pi );
+    destroyrat( pi_over_two );
+    destroyrat( two_pi );
+    destroyrat( one_pt_five_pi );
+    destroyrat( e_to_one_half );
+    destroyrat( rat_exp );
+    destroyrat( rad_to_deg );
+    destroyrat( rad_to_grad );
+    destroyrat( rat_qword );
+    destroyrat( rat_dword );
+    destroyrat( rat_word );
+    destroyrat( rat_byte );
+    destroyrat( rat_360 );
+    destroyrat( rat_400 );
+    destroyrat( rat_180 );
+    destroyrat( rat_200 );
+    destroyrat( rat_nRadix );
+    destroyrat( rat_smallest );
+    destroyrat( rat_negsmallest );
+    destroyrat( rat_max_exp );
+    destroyrat( rat_min_exp );
+    destroyrat( rat_max_fact );
+    destroyrat( rat_min_fact );
+    destroyrat( rat_min_i32 );
+    destroyrat( rat_max_i32 );
+
+    destroyrat( two_pi_recip );
+    two_pi_recip_radix = 0;
+    two_pi_recip_precision = -1;
+
+    g_constantSetStore.clear();
+
+    // Drain the Taylor scratch freelist; released sets keep their xx and
+    // thisterm shells warm, which is exactly what must not outlive the
+    // thread.
+    while ( g_taylorFreeList != nullptr )
+        {
+        PTAYLORSCRATCH ts = g_taylorFreeList;
+        g_taylorFreeList = ts->next;
+        destroyrat( ts->xx );
+        destroynum( ts->n2 );
+        destroyrat( ts->pret );
+        destroyrat( ts->thisterm );
+        delete ts;
+        }
+
+    // Make the next ChangeConstants rederive from scratch, exactly as on a
+    // fresh thread.
+#if defined( GEN_CONST )
+    cbitsofprecision = 0;
+#else
+    cbitsofprecision = RATIO_FOR_DECIMAL * DECIMAL * CALC_DECIMAL_DIGITS_DEFAULT;
+#endif
+
+    // Last: drops the memo caches onto the free lists and then frees the
+    // lists themselves, so nothing stays parked.
+    TrimRatpakPools();
+}
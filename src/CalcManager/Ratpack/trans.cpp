@@ -19,6 +19,71 @@
 
 
 
+namespace {
+
+    // One-slot memo of the last 2-pi range reduction.  Scientific workflows
+    // commonly evaluate sin, cos and tan of the same angle back to back, and
+    // the reduction (a divide, an intrat and a multiply against two_pi) is a
+    // large share of each call.
+    thread_local PRAT t_lastReduceIn = nullptr;
+    thread_local PRAT t_lastReduceOut = nullptr;
+    thread_local uint32_t t_lastReduceRadix = 0;
+    thread_local int32_t t_lastReducePrecision = 0;
+
+    void reduce2pi( PRAT *px, uint32_t radix, int32_t precision )
+    {
+        if ( t_lastReduceIn != nullptr && t_lastReduceRadix == radix &&
+            t_lastReducePrecision == precision && rat_equ( *px, t_lastReduceIn, precision ) )
+            {
+            DUPRAT(*px,t_lastReduceOut);
+            return;
+            }
+        DUPRAT(t_lastReduceIn,*px);
+        scale2pi( px, radix, precision );
+        DUPRAT(t_lastReduceOut,*px);
+        t_lastReduceRadix = radix;
+        t_lastReducePrecision = precision;
+    }
+
+    // One update of a sin/cos style Taylor term and its running sum:
+    // term *= xx / ((n2+1)*(n2+2)); sum += term.
+    void taylorstep( PRAT& term, PRAT& sum, PRAT xx, PNUMBER& n2, int32_t precision )
+    {
+        // Once per series iteration, like NEXTTERM: keeps the fused sin/cos
+        // expansion cancellable and its progress heartbeat ticking.
+        ratpakcheckpoint();
+        mulrat( &term, xx, precision );
+        INC(n2);
+        mulnumx( &(term->pq), n2 );
+        INC(n2);
+        mulnumx( &(term->pq), n2 );
+        addrat( &sum, term, precision );
+    }
+}
+
+//-----------------------------------------------------------------------------
+//
+//  FUNCTION: TrimReduceMemoCache
+//
+//  ARGUMENTS: none
+//
+//  RETURN: None, thread locals change.
+//
+//  DESCRIPTION: Releases the calling thread's range-reduction memo.  Called
+//  from TrimRatpakPools so the memoized pair lands on the free lists before
+//  those are drained.
+//
+//-----------------------------------------------------------------------------
+
+void TrimReduceMemoCache( void )
+
+{
+    destroyrat( t_lastReduceIn );
+    destroyrat( t_lastReduceOut );
+    t_lastReduceRadix = 0;
+    t_lastReducePrecision = 0;
+}
+
 void scalerat( _Inout_ PRAT *pa, ANGLE_TYPE angletype, uint32_t radix, int32_t precision )
 {
     switch ( angletype )
@@ -98,10 +163,96 @@ void _sinrat( PRAT *px, int32_t precision)
 
 void sinrat( PRAT *px, uint32_t radix, int32_t precision)
 {
-    scale2pi(px, radix, precision);
+    reduce2pi(px, radix, precision);
     _sinrat(px, precision);
 }
 
+//-----------------------------------------------------------------------------
+//
+//  FUNCTION: sincosrat, _sincosrat
+//
+//  ARGUMENTS:  px PRAT representation of the angle, *pcos receives cos.
+//
+//  RETURN: *px smashed with sin of x, *pcos smashed with cos of x.
+//
+//  EXPLANATION: Evaluates both Taylor series (see _sinrat and _cosrat)
+//  in one pass, sharing the range-reduced argument and the common -x^2
+//  term multiplier, so requesting both costs little more than one.
+//
+//-----------------------------------------------------------------------------
+
+void _sincosrat( PRAT *psin, PRAT *pcos, uint32_t radix, int32_t precision)
+
+{
+    // xx = -x^2 drives both term recurrences.
+    PRAT xx = nullptr;
+    DUPRAT(xx,*psin);
+    mulrat(&xx, *psin, precision);
+    xx->pp->sign *= -1;
+
+    PRAT sinsum = nullptr;
+    PRAT sinterm = nullptr;
+    PNUMBER nsin = nullptr;
+    DUPRAT(sinsum,*psin);
+    DUPRAT(sinterm,*psin);
+    DUPNUM(nsin,num_one);
+
+    PRAT cossum = nullptr;
+    PRAT costerm = nullptr;
+    createrat(cossum);
+    cossum->pp=i32tonum( 1L, radix);
+    cossum->pq=i32tonum( 1L, radix);
+    DUPRAT(costerm,cossum);
+    PNUMBER ncos = i32tonum(0L, radix);
+
+    bool sindone = false;
+    bool cosdone = false;
+    do    {
+        if ( !cosdone )
+            {
+            taylorstep( costerm, cossum, xx, ncos, precision );
+            cosdone = SMALL_ENOUGH_RAT( costerm, precision);
+            }
+        if ( !sindone )
+            {
+            taylorstep( sinterm, sinsum, xx, nsin, precision );
+            sindone = SMALL_ENOUGH_RAT( sinterm, precision);
+            }
+        } while ( !sindone || !cosdone );
+
+    destroynum( nsin );
+    destroynum( ncos );
+    destroyrat( xx );
+    destroyrat( sinterm );
+    destroyrat( costerm );
+
+    destroyrat( *psin );
+    trimit(&sinsum, precision);
+    *psin = sinsum;
+    destroyrat( *pcos );
+    trimit(&cossum, precision);
+    *pcos = cossum;
+
+    // Same epsilon clamps as _sinrat/_cosrat.
+    inbetween(psin, rat_one, precision);
+    if ( rat_le(*psin, rat_smallest, precision) && rat_ge(*psin, rat_negsmallest, precision) )
+        {
+        DUPRAT(*psin,rat_zero);
+        }
+    inbetween(pcos, rat_one, precision);
+    if ( rat_le(*pcos, rat_smallest, precision) && rat_ge(*pcos, rat_negsmallest, precision) )
+        {
+        DUPRAT(*pcos,rat_zero);
+        }
+}
+
+void sincosrat( PRAT *px, PRAT *pcos, uint32_t radix, int32_t precision)
+{
+    reduce2pi(px, radix, precision);
+    DUPRAT(*pcos,*px);
+    _sincosrat(px, pcos, radix, precision);
+}
+
 void sinanglerat( _Inout_ PRAT *pa, ANGLE_TYPE angletype, uint32_t radix, int32_t precision)
 
 {
@@ -193,7 +344,7 @@ void _cosrat( PRAT *px, uint32_t radix, int32_t precision)
 
 void cosrat( PRAT *px, uint32_t radix, int32_t precision)
 {
-    scale2pi(px, radix, precision);
+    reduce2pi(px, radix, precision);
     _cosrat(px, radix, precision);
 }
 
@@ -250,8 +401,7 @@ void _tanrat( PRAT *px, uint32_t radix, int32_t precision)
     PRAT ptmp= nullptr;
 
     DUPRAT(ptmp,*px);
-    _sinrat(px, precision);
-    _cosrat(&ptmp, radix, precision);
+    _sincosrat(px, &ptmp, radix, precision);
     if ( zerrat( ptmp ) )
         {
         destroyrat(ptmp);
@@ -265,7 +415,7 @@ void _tanrat( PRAT *px, uint32_t radix, int32_t precision)
 
 void tanrat( PRAT *px, uint32_t radix, int32_t precision)
 {
-    scale2pi(px, radix, precision);
+    reduce2pi(px, radix, precision);
     _tanrat(px, radix, precision);
 }
 
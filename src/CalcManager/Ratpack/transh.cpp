@@ -35,6 +35,86 @@ bool IsValidForHypFunc(PRAT px, int32_t precision)
 
 }
 
+namespace
+{
+    // Most recent exphyp evaluation.  Scientific mode users commonly apply
+    // sinh/cosh/tanh to the same operand back to back, and all three derive
+    // from the same e^x.
+    struct HYPEXPCACHE
+    {
+        PRAT arg = nullptr;
+        PRAT ex = nullptr;
+        PRAT exinv = nullptr;
+        uint32_t radix = 0;
+        int32_t precision = 0;
+    };
+
+    thread_local HYPEXPCACHE g_hypExpCache;
+}
+
+//-----------------------------------------------------------------------------
+//
+//  FUNCTION: TrimHypExpMemoCache
+//
+//  ARGUMENTS: none
+//
+//  RETURN: None, thread locals change.
+//
+//  DESCRIPTION: Releases the calling thread's memoized e^x pair.  Called
+//  from TrimRatpakPools so the cached rationals land on the free lists
+//  before those are drained.
+//
+//-----------------------------------------------------------------------------
+
+void TrimHypExpMemoCache( void )
+
+{
+    destroyrat( g_hypExpCache.arg );
+    destroyrat( g_hypExpCache.ex );
+    destroyrat( g_hypExpCache.exinv );
+    g_hypExpCache.radix = 0;
+    g_hypExpCache.precision = 0;
+}
+
+//-----------------------------------------------------------------------------
+//
+//  FUNCTION: exphyp
+//
+//  ARGUMENTS: x PRAT to exponentiate, radix and precision of the result,
+//    pex and pexinv out parameters receiving e^x and e^-x.
+//
+//  RETURN: None, pex and pexinv are fresh copies owned by the caller.
+//
+//  EXPLANATION: Computes e^x once, derives e^-x by reciprocal instead of a
+//   second series evaluation, and memoizes both against the argument so the
+//   hyperbolic functions sharing an operand reuse the expensive exprat call.
+//
+//-----------------------------------------------------------------------------
+
+static void exphyp( PRAT x, uint32_t radix, int32_t precision, PRAT *pex, PRAT *pexinv)
+
+{
+    if ( g_hypExpCache.arg == nullptr ||
+         g_hypExpCache.radix != radix ||
+         g_hypExpCache.precision != precision ||
+         !rat_equ( g_hypExpCache.arg, x, precision) )
+        {
+        // Invalidate first so a throw from exprat can't leave a stale
+        // argument paired with the old results.
+        destroyrat( g_hypExpCache.arg );
+        g_hypExpCache.arg = nullptr;
+        DUPRAT(g_hypExpCache.ex,x);
+        exprat(&(g_hypExpCache.ex), radix, precision);
+        DUPRAT(g_hypExpCache.exinv,rat_one);
+        divrat(&(g_hypExpCache.exinv), g_hypExpCache.ex, precision);
+        g_hypExpCache.radix = radix;
+        g_hypExpCache.precision = precision;
+        DUPRAT(g_hypExpCache.arg,x);
+        }
+    DUPRAT(*pex,g_hypExpCache.ex);
+    DUPRAT(*pexinv,g_hypExpCache.exinv);
+}
+
 //-----------------------------------------------------------------------------
 //
 //  FUNCTION: sinhrat, _sinhrat
@@ -95,22 +175,30 @@ void _sinhrat( PRAT *px, int32_t precision)
 void sinhrat( PRAT *px, uint32_t radix, int32_t precision)
 
 {
-    PRAT tmpx= nullptr;
+    PRAT pex= nullptr;
+    PRAT pexinv= nullptr;
+    int32_t sgn;
+
+    // sinh is odd, so evaluate on abs(x) and put the sign back at the end;
+    // this lets negative arguments share the memoized e^x as well.
+    sgn = (*px)->pp->sign * (*px)->pq->sign;
+    (*px)->pp->sign = 1;
+    (*px)->pq->sign = 1;
 
     if ( rat_ge( *px, rat_one, precision) )
         {
-        DUPRAT(tmpx,*px);
-        exprat(px, radix, precision);
-        tmpx->pp->sign *= -1;
-        exprat(&tmpx, radix, precision);
-        subrat( px, tmpx, precision);
+        exphyp( *px, radix, precision, &pex, &pexinv);
+        destroyrat(*px);
+        *px = pex;
+        subrat( px, pexinv, precision);
         divrat( px, rat_two, precision);
-        destroyrat( tmpx );
+        destroyrat( pexinv );
         }
     else
         {
         _sinhrat( px, precision);
         }
+    (*px)->pp->sign *= sgn;
 }
 
 //-----------------------------------------------------------------------------
@@ -176,19 +264,19 @@ void _coshrat( PRAT *px, uint32_t radix, int32_t precision)
 void coshrat( PRAT *px, uint32_t radix, int32_t precision)
 
 {
-    PRAT tmpx= nullptr;
+    PRAT pex= nullptr;
+    PRAT pexinv= nullptr;
 
     (*px)->pp->sign = 1;
     (*px)->pq->sign = 1;
     if ( rat_ge( *px, rat_one, precision) )
         {
-        DUPRAT(tmpx,*px);
-        exprat(px, radix, precision);
-        tmpx->pp->sign *= -1;
-        exprat(&tmpx, radix, precision);
-        addrat( px, tmpx, precision);
+        exphyp( *px, radix, precision, &pex, &pexinv);
+        destroyrat(*px);
+        *px = pex;
+        addrat( px, pexinv, precision);
         divrat( px, rat_two, precision);
-        destroyrat( tmpx );
+        destroyrat( pexinv );
         }
     else
         {
@@ -211,7 +299,8 @@ void coshrat( PRAT *px, uint32_t radix, int32_t precision)
 //
 //  RETURN: tanh    of x in PRAT form.
 //
-//  EXPLANATION: This uses sinhrat and coshrat
+//  EXPLANATION: This uses (e^x-e^-x)/(e^x+e^-x) through the shared
+//   exphyp kernel for large arguments, and sinhrat/coshrat otherwise.
 //
 //-----------------------------------------------------------------------------
 
@@ -219,13 +308,34 @@ void tanhrat( PRAT *px, uint32_t radix, int32_t precision)
 
 {
     PRAT ptmp= nullptr;
+    PRAT pex= nullptr;
+    PRAT pexinv= nullptr;
+    int32_t sgn;
 
-    DUPRAT(ptmp,*px);
-    sinhrat(px, radix, precision);
-    coshrat(&ptmp, radix, precision);
-    mulnumx(&((*px)->pp),ptmp->pq);
-    mulnumx(&((*px)->pq),ptmp->pp);
+    // tanh is odd like sinh, so work on abs(x).
+    sgn = (*px)->pp->sign * (*px)->pq->sign;
+    (*px)->pp->sign = 1;
+    (*px)->pq->sign = 1;
 
+    if ( rat_ge( *px, rat_one, precision) )
+        {
+        exphyp( *px, radix, precision, &pex, &pexinv);
+        DUPRAT(ptmp,pex);
+        addrat( &ptmp, pexinv, precision);
+        destroyrat(*px);
+        *px = pex;
+        subrat( px, pexinv, precision);
+        divrat( px, ptmp, precision);
+        destroyrat( pexinv );
+        }
+    else
+        {
+        DUPRAT(ptmp,*px);
+        sinhrat(px, radix, precision);
+        coshrat(&ptmp, radix, precision);
+        mulnumx(&((*px)->pp),ptmp->pq);
+        mulnumx(&((*px)->pq),ptmp->pp);
+        }
     destroyrat(ptmp);
-
+    (*px)->pp->sign *= sgn;
 }
@@ -0,0 +1,105 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "pch.h"
+#include <algorithm>
+#include "SharedHistoryStore.h"
+
+using namespace std;
+using namespace CalculationManager;
+
+namespace
+{
+    // Matches the cap each window's CalculatorHistory enforces; the shared
+    // list evicts oldest-first the same way the per-window ring does.
+    constexpr size_t SHARED_HISTORY_MAX_ITEMS = 1000;
+}
+
+SharedHistoryStore& SharedHistoryStore::GetInstance()
+{
+    static SharedHistoryStore s_instance;
+    return s_instance;
+}
+
+SharedHistoryStore::ModeStore& SharedHistoryStore::StoreFor(_In_ CALCULATOR_MODE eMode) const
+{
+    return m_modeStores[eMode == CM_SCI ? 1 : 0];
+}
+
+unsigned int SharedHistoryStore::Publish(_In_ CALCULATOR_MODE eMode, _In_ shared_ptr<HISTORYITEM> const& spHistoryItem)
+{
+    ModeStore& store = StoreFor(eMode);
+    lock_guard<mutex> lock(store.writerMutex);
+
+    Snapshot current = atomic_load(&store.snapshot);
+    auto next = make_shared<vector<shared_ptr<HISTORYITEM>>>();
+    if (current != nullptr)
+    {
+        *next = *current;
+    }
+    next->push_back(spHistoryItem);
+    if (next->size() > SHARED_HISTORY_MAX_ITEMS)
+    {
+        next->erase(next->begin(), next->begin() + (next->size() - SHARED_HISTORY_MAX_ITEMS));
+    }
+
+    atomic_store(&store.snapshot, Snapshot(move(next)));
+    return store.generation.fetch_add(1, memory_order_acq_rel) + 1;
+}
+
+unsigned int SharedHistoryStore::Remove(_In_ CALCULATOR_MODE eMode, _In_ shared_ptr<HISTORYITEM> const& spHistoryItem)
+{
+    ModeStore& store = StoreFor(eMode);
+    lock_guard<mutex> lock(store.writerMutex);
+
+    Snapshot current = atomic_load(&store.snapshot);
+    if (current == nullptr)
+    {
+        return store.generation.load(memory_order_acquire);
+    }
+
+    auto next = make_shared<vector<shared_ptr<HISTORYITEM>>>(*current);
+    auto iter = find(next->begin(), next->end(), spHistoryItem);
+    if (iter == next->end())
+    {
+        return store.generation.load(memory_order_acquire);
+    }
+    next->erase(iter);
+
+    atomic_store(&store.snapshot, Snapshot(move(next)));
+    return store.generation.fetch_add(1, memory_order_acq_rel) + 1;
+}
+
+unsigned int SharedHistoryStore::Clear(_In_ CALCULATOR_MODE eMode)
+{
+    ModeStore& store = StoreFor(eMode);
+    lock_guard<mutex> lock(store.writerMutex);
+
+    atomic_store(&store.snapshot, Snapshot(make_shared<vector<shared_ptr<HISTORYITEM>>>()));
+    return store.generation.fetch_add(1, memory_order_acq_rel) + 1;
+}
+
+bool SharedHistoryStore::SeedIfEmpty(_In_ CALCULATOR_MODE eMode, _In_ vector<shared_ptr<HISTORYITEM>> const& items)
+{
+    ModeStore& store = StoreFor(eMode);
+    lock_guard<mutex> lock(store.writerMutex);
+
+    if (store.generation.load(memory_order_acquire) != 0)
+    {
+        return false;
+    }
+
+    atomic_store(&store.snapshot, Snapshot(make_shared<vector<shared_ptr<HISTORYITEM>>>(items)));
+    store.generation.fetch_add(1, memory_order_acq_rel);
+    return true;
+}
+
+SharedHistoryStore::Snapshot SharedHistoryStore::GetSnapshot(_In_ CALCULATOR_MODE eMode) const
+{
+    return atomic_load(&StoreFor(eMode).snapshot);
+}
+
+unsigned int SharedHistoryStore::Generation(_In_ CALCULATOR_MODE eMode) const
+{
+    return StoreFor(eMode).generation.load(memory_order_acquire);
+}
@@ -0,0 +1,73 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "CalculatorHistory.h"
+
+namespace CalculationManager
+{
+    // Process-wide history shared by every calculator window. Each window's
+    // CalculatorManager keeps its own CalculatorHistory for the calculation
+    // path and publishes completed items here; the panes of every window can
+    // then fold the union back in on demand.
+    //
+    // Publication is RCU-style: writers rebuild an immutable snapshot vector
+    // under a short mutex and swap it in atomically, so readers never take a
+    // lock and never observe a half-updated list. The writer mutex is touched
+    // only when an equation completes or history is edited - never per
+    // keystroke - so the calculation path stays free of cross-window locking.
+    class SharedHistoryStore
+    {
+    public:
+        using Snapshot = std::shared_ptr<const std::vector<std::shared_ptr<HISTORYITEM>>>;
+
+        static SharedHistoryStore& GetInstance();
+
+        // Appends one item a window just added to its local history.
+        // Returns the store generation after the append.
+        unsigned int Publish(_In_ CALCULATOR_MODE eMode, _In_ std::shared_ptr<HISTORYITEM> const& spHistoryItem);
+
+        // Removes one item (matched by identity) after a window deleted it.
+        unsigned int Remove(_In_ CALCULATOR_MODE eMode, _In_ std::shared_ptr<HISTORYITEM> const& spHistoryItem);
+
+        // Drops the whole list for a mode after a window cleared history.
+        unsigned int Clear(_In_ CALCULATOR_MODE eMode);
+
+        // Installs the journal's items as the initial contents, but only if
+        // no window has published yet; later windows restoring the same
+        // journal must not clobber items published since. Returns true when
+        // the seed was installed.
+        bool SeedIfEmpty(_In_ CALCULATOR_MODE eMode, _In_ std::vector<std::shared_ptr<HISTORYITEM>> const& items);
+
+        // Lock-free: one atomic shared_ptr load. The returned vector is
+        // immutable; concurrent publication swaps in a fresh one.
+        Snapshot GetSnapshot(_In_ CALCULATOR_MODE eMode) const;
+
+        // Monotonic per-mode version, bumped on every mutation, so callers
+        // can detect cross-window changes with one atomic read.
+        unsigned int Generation(_In_ CALCULATOR_MODE eMode) const;
+
+    private:
+        SharedHistoryStore() = default;
+        SharedHistoryStore(SharedHistoryStore const&) = delete;
+        SharedHistoryStore& operator=(SharedHistoryStore const&) = delete;
+
+        struct ModeStore
+        {
+            std::mutex writerMutex;
+            Snapshot snapshot; // accessed only via std::atomic_load/atomic_store
+            std::atomic<unsigned int> generation{ 0 };
+        };
+
+        ModeStore& StoreFor(_In_ CALCULATOR_MODE eMode) const;
+
+        // Indexed by CALCULATOR_MODE; mutable so the const read side can
+        // hand out stable references.
+        mutable ModeStore m_modeStores[2];
+    };
+}
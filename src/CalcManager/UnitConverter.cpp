@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "pch.h"
+#include <ppl.h>
 #include "Command.h"
 #include "UnitConverter.h"
 
@@ -19,6 +20,19 @@ static constexpr uint32_t EXPECTEDMAPCOMPONENTTOKENCOUNT = 2;
 static constexpr int32_t MAXIMUMDIGITSALLOWED = 15;
 static constexpr int32_t OPTIMALDIGITSALLOWED = 7;
 
+// Category size at which the suggested-value sweep formats its entries in
+// parallel. Small categories stay on one thread; the fork/join overhead
+// would exceed the formatting work.
+static constexpr size_t SUGGESTEDPARALLELMINUNITS = 32;
+
+// Version tag of the compact serialization format: numeric fields and
+// unit/category ids only, ';' separated, resolved against freshly loaded
+// data on restore. The legacy quoted format is recognized on read by its
+// '|' outer separators, which the compact format never contains.
+static constexpr uint32_t COMPACTSERIALIZATIONVERSION = 2;
+static constexpr uint32_t EXPECTEDCOMPACTSTATETOKENCOUNT = 9;
+static constexpr uint32_t EXPECTEDCOMPACTPREFERENCESTOKENCOUNT = 4;
+
 static constexpr wchar_t LEFTESCAPECHAR = L'{';
 static constexpr wchar_t RIGHTESCAPECHAR = L'}';
 
@@ -63,6 +77,8 @@ UnitConverter::UnitConverter(_In_ const shared_ptr<IConverterDataLoader>& dataLo
     unquoteConversions[L"{sc}"] = L';';
     unquoteConversions[L"{lb}"] = LEFTESCAPECHAR;
     unquoteConversions[L"{rb}"] = RIGHTESCAPECHAR;
+    m_activeRatioMatrix = nullptr;
+    m_suggestedGeneration = 0;
     Reset();
 }
 
@@ -106,7 +122,7 @@ CategorySelectionInitializer UnitConverter::SetCurrentCategory(const Category& i
     {
         if (m_currentCategory.id != input.id)
         {
-            vector<Unit>& unitVector = m_categoryToUnits[m_currentCategory];
+            vector<Unit>& unitVector = m_categoryIdToUnits[m_currentCategory.id];
             for (unsigned int i = 0; i < unitVector.size(); i++)
             {
                 unitVector[i].isConversionSource = (unitVector[i].id == m_fromType.id);
@@ -116,10 +132,11 @@ CategorySelectionInitializer UnitConverter::SetCurrentCategory(const Category& i
             if (!m_currentCategory.supportsNegative && m_currentDisplay.front() == L'-')
             {
                 m_currentDisplay.erase(0, 1);
+                m_currentValue = -m_currentValue;
             }
         }
 
-        newUnitList = m_categoryToUnits[input];
+        newUnitList = m_categoryIdToUnits[input.id];
     }
 
     InitializeSelectedUnits();
@@ -134,6 +151,88 @@ Category UnitConverter::GetCurrentCategory()
     return m_currentCategory;
 }
 
+// Lowercases a display string the same way the search index was built,
+// so a query matches regardless of typed case.
+static wstring LowercaseForSearch(const wstring& text)
+{
+    wstring lowered;
+    lowered.reserve(text.size());
+    for (wchar_t ch : text)
+    {
+        lowered.push_back(towlower(ch));
+    }
+    return lowered;
+}
+
+/// <summary>
+/// Type-ahead search over the current category's units. An empty query
+/// returns the full ordered list; otherwise units whose name words or
+/// abbreviation start with the lowercased query are returned, name-start
+/// matches first, ties in category order. Runs entirely against the
+/// prefix index built at load time, so no names are re-localized or
+/// scanned per keystroke.
+/// </summary>
+/// <param name="query">the prefix the user has typed so far</param>
+vector<Unit> UnitConverter::SearchUnits(const wstring& query)
+{
+    vector<Unit> results;
+    if (!CheckLoad())
+    {
+        return results;
+    }
+
+    auto unitsItr = m_categoryIdToUnits.find(m_currentCategory.id);
+    if (unitsItr == m_categoryIdToUnits.end())
+    {
+        return results;
+    }
+    const vector<Unit>& units = unitsItr->second;
+
+    // Ignore surrounding whitespace the search box may hand us; an
+    // effectively empty query means no filter.
+    wstring needle = LowercaseForSearch(query);
+    size_t firstNonSpace = needle.find_first_not_of(L' ');
+    if (firstNonSpace == wstring::npos)
+    {
+        return units;
+    }
+    needle = needle.substr(firstNonSpace, needle.find_last_not_of(L' ') - firstNonSpace + 1);
+
+    auto tokensItr = m_categoryIdToSearchTokens.find(m_currentCategory.id);
+    if (tokensItr == m_categoryIdToSearchTokens.end())
+    {
+        return results;
+    }
+    const vector<UnitSearchToken>& tokens = tokensItr->second;
+
+    // The tokens sharing the query as a prefix form one contiguous range.
+    auto match = lower_bound(tokens.begin(), tokens.end(), needle,
+        [](const UnitSearchToken& token, const wstring& value) { return token.text < value; });
+
+    vector<size_t> bestRank(units.size(), SIZE_MAX);
+    for (; match != tokens.end() && match->text.compare(0, needle.size(), needle) == 0; ++match)
+    {
+        bestRank[match->unitIndex] = min(bestRank[match->unitIndex], match->rank);
+    }
+
+    vector<pair<size_t, size_t>> ranked;
+    for (size_t unitIndex = 0; unitIndex < units.size(); unitIndex++)
+    {
+        if (bestRank[unitIndex] != SIZE_MAX)
+        {
+            ranked.emplace_back(bestRank[unitIndex], unitIndex);
+        }
+    }
+    sort(ranked.begin(), ranked.end());
+
+    results.reserve(ranked.size());
+    for (const auto& entry : ranked)
+    {
+        results.push_back(units[entry.second]);
+    }
+    return results;
+}
+
 /// <summary>
 /// Sets the current unit types to be used, indicates a likely change in the
 /// display values, so we re-calculate and callback the updated values
@@ -180,6 +279,7 @@ void UnitConverter::SwitchActive(const wstring& newValue)
     m_currentDisplay = newValue;
     m_currentHasDecimal = (m_currentDisplay.find(L'.') != m_currentDisplay.npos);
     m_switchedActive = true;
+    SyncCurrentValue();
 
     if (m_currencyDataLoader != nullptr && m_vmCurrencyCallback != nullptr)
     {
@@ -190,13 +290,6 @@ void UnitConverter::SwitchActive(const wstring& newValue)
     }
 }
 
-wstring UnitConverter::CategoryToString(const Category& c, const wchar_t * delimiter)
-{
-    wstringstream out(wstringstream::out);
-    out << Quote(std::to_wstring(c.id)) << delimiter << Quote(std::to_wstring(c.supportsNegative)) << delimiter << Quote(c.name) << delimiter;
-    return out.str();
-}
-
 vector<wstring> UnitConverter::StringToVector(const wstring& w, const wchar_t * delimiter, bool addRemainder)
 {
     size_t delimiterIndex = w.find(delimiter);
@@ -227,13 +320,6 @@ Category UnitConverter::StringToCategory(const wstring& w)
     return serializedCategory;
 }
 
-wstring UnitConverter::UnitToString(const Unit& u, const wchar_t * delimiter)
-{
-    wstringstream out(wstringstream::out);
-    out << Quote(std::to_wstring(u.id)) << delimiter << Quote(u.name) << delimiter << Quote(u.abbreviation) << delimiter << std::to_wstring(u.isConversionSource) << delimiter << std::to_wstring(u.isConversionTarget) << delimiter << std::to_wstring(u.isWhimsical) << delimiter;
-    return out.str();
-}
-
 Unit UnitConverter::StringToUnit(const wstring& w)
 {
     vector<wstring> tokenList = StringToVector(w, L";");
@@ -260,24 +346,11 @@ ConversionData UnitConverter::StringToConversionData(const wstring& w)
     return serializedConversionData;
 }
 
-wstring UnitConverter::ConversionDataToString(ConversionData d, const wchar_t * delimiter)
-{
-    wstringstream out(wstringstream::out);
-    out.precision(32);
-    out << fixed << d.ratio;
-    wstring ratio = out.str();
-    out.str(L"");
-    out << fixed << d.offset;
-    wstring offset = out.str();
-    out.str(L"");
-    TrimString(ratio);
-    TrimString(offset);
-    out << Quote(ratio) << delimiter << Quote(offset) << delimiter << std::to_wstring(d.offsetFirst) << delimiter;
-    return out.str();
-}
-
 /// <summary>
-/// Serializes the data in the converter and returns it as a string
+/// Serializes the data in the converter and returns it as a string.
+/// Only ids, flags and the display strings are persisted: DeSerialize
+/// starts from a Reset, which reloads the categories, units and ratios
+/// from the data loaders, so the maps never need to round-trip.
 /// </summary>
 wstring UnitConverter::Serialize()
 {
@@ -286,63 +359,104 @@ wstring UnitConverter::Serialize()
         return wstring();
     }
 
-    wstringstream out(wstringstream::out);
-    const wchar_t * delimiter = L";";
+    wstring out = to_wstring(COMPACTSERIALIZATIONVERSION);
+    out += L';';
+    out += to_wstring(m_currentCategory.id);
+    out += L';';
+    out += to_wstring(m_fromType.id);
+    out += L';';
+    out += to_wstring(m_toType.id);
+    out += L';';
+    out += m_currentHasDecimal ? L'1' : L'0';
+    out += L';';
+    out += m_returnHasDecimal ? L'1' : L'0';
+    out += L';';
+    out += m_switchedActive ? L'1' : L'0';
+    out += L';';
+    out += m_currentDisplay;
+    out += L';';
+    out += m_returnDisplay;
+    out += L';';
+    return out;
+}
+
+/// <summary>
+/// De-Serializes the data in the converter from a string
+/// </summary>
+/// <param name="serializedData">wstring holding the serialized data. If it does not have expected number of parameters, we will ignore it</param>
+void UnitConverter::DeSerialize(const wstring& serializedData)
+{
+    Reset();
+
+    if (serializedData.empty())
+    {
+        return;
+    }
+
+    if (serializedData.find(L'|') != serializedData.npos)
+    {
+        DeSerializeLegacy(serializedData);
+        // The maps the matrices were built from were replaced wholesale.
+        m_ratioMatrixCache.clear();
+        m_activeRatioMatrix = nullptr;
+        UpdateViewModel();
+        return;
+    }
 
-    out << UnitToString(m_fromType, delimiter) << "|";
-    out << UnitToString(m_toType, delimiter) << "|";
-    out << CategoryToString(m_currentCategory, delimiter) << "|";
-    out << std::to_wstring(m_currentHasDecimal) << delimiter << std::to_wstring(m_returnHasDecimal) << delimiter << std::to_wstring(m_switchedActive) << delimiter;
-    out << m_currentDisplay << delimiter << m_returnDisplay << delimiter << "|";
-    wstringstream categoryString(wstringstream::out);
-    wstringstream categoryToUnitString(wstringstream::out);
-    wstringstream unitToUnitToDoubleString(wstringstream::out);
-    for (const Category& c : m_categories)
+    vector<wstring> tokens = StringToVector(serializedData, L";");
+    if (tokens.size() != EXPECTEDCOMPACTSTATETOKENCOUNT || static_cast<uint32_t>(_wtoi(tokens[0].c_str())) != COMPACTSERIALIZATIONVERSION)
     {
-        categoryString << CategoryToString(c, delimiter) << ",";
+        // Unknown format; stay with the freshly reset state.
+        return;
     }
 
-    for (const auto& cur : m_categoryToUnits)
+    // Resolve the ids against the data Reset just loaded; an id that no
+    // longer exists keeps the corresponding Reset default.
+    int categoryId = _wtoi(tokens[1].c_str());
+    for (const Category& category : m_categories)
     {
-        categoryToUnitString << CategoryToString(cur.first, delimiter) << "[";
-        for (const Unit& u : cur.second)
+        if (category.id == categoryId)
         {
-            categoryToUnitString << UnitToString(u, delimiter) << ",";
+            m_currentCategory = category;
+            break;
         }
-        categoryToUnitString << "[" << "]";
     }
 
-    for (const auto& cur : m_ratioMap)
+    int fromId = _wtoi(tokens[2].c_str());
+    int toId = _wtoi(tokens[3].c_str());
+    InitializeSelectedUnits();
+    auto itr = m_categoryIdToUnits.find(m_currentCategory.id);
+    if (itr != m_categoryIdToUnits.end())
     {
-        unitToUnitToDoubleString << UnitToString(cur.first, delimiter) << "[";
-        for (const auto& curConversion : cur.second)
+        for (const Unit& unit : itr->second)
         {
-            unitToUnitToDoubleString << UnitToString(curConversion.first, delimiter) << ":";
-            unitToUnitToDoubleString << ConversionDataToString(curConversion.second, delimiter) << ":,";
+            if (unit.id == fromId)
+            {
+                m_fromType = unit;
+            }
+            if (unit.id == toId)
+            {
+                m_toType = unit;
+            }
         }
-        unitToUnitToDoubleString << "[" << "]";
     }
 
-    out << categoryString.str() << "|";
-    out << categoryToUnitString.str() << "|";
-    out << unitToUnitToDoubleString.str() << "|";
-    wstring test = out.str();
-    return test;
+    m_currentHasDecimal = (tokens[4].compare(L"1") == 0);
+    m_returnHasDecimal = (tokens[5].compare(L"1") == 0);
+    m_switchedActive = (tokens[6].compare(L"1") == 0);
+    m_currentDisplay = tokens[7];
+    m_returnDisplay = tokens[8];
+    SyncCurrentValue();
+    UpdateViewModel();
 }
 
 /// <summary>
-/// De-Serializes the data in the converter from a string
+/// Reads the legacy quoted serialization format, including the category,
+/// unit and ratio maps it carries, for blobs written before the compact
+/// format existed.
 /// </summary>
-/// <param name="serializedData">wstring holding the serialized data. If it does not have expected number of parameters, we will ignore it</param>
-void UnitConverter::DeSerialize(const wstring& serializedData)
+void UnitConverter::DeSerializeLegacy(const wstring& serializedData)
 {
-    Reset();
-
-    if (serializedData.empty())
-    {
-        return;
-    }
-
     vector<wstring> outerTokens = StringToVector(serializedData, L"|");
     assert(outerTokens.size() == EXPECTEDSERIALIZEDTOKENCOUNT);
     m_fromType = StringToUnit(outerTokens[0]);
@@ -355,6 +469,7 @@ void UnitConverter::DeSerialize(const wstring& serializedData)
     m_switchedActive = (stateDataTokens[2].compare(L"1") == 0);
     m_currentDisplay = stateDataTokens[3];
     m_returnDisplay = stateDataTokens[4];
+    SyncCurrentValue();
     vector<wstring> categoryListTokens = StringToVector(outerTokens[4], L",");
     for (wstring token : categoryListTokens)
     {
@@ -369,7 +484,7 @@ void UnitConverter::DeSerialize(const wstring& serializedData)
         vector<wstring> units = StringToVector(mapcomponents[1], L",");
         for (wstring unit : units)
         {
-            m_categoryToUnits[key].push_back(StringToUnit(unit));
+            m_categoryIdToUnits[key.id].push_back(StringToUnit(unit));
         }
     }
     vector<wstring> ratioMapTokens = StringToVector(outerTokens[6], L"]");
@@ -385,10 +500,13 @@ void UnitConverter::DeSerialize(const wstring& serializedData)
             assert(ratioMapSubComponentTokens.size() == EXPECTEDMAPCOMPONENTTOKENCOUNT);
             Unit subkey = StringToUnit(ratioMapSubComponentTokens[0]);
             ConversionData conversion = StringToConversionData(ratioMapSubComponentTokens[1]);
-            m_ratioMap[key][subkey] = conversion;
+            m_ratioMap[key.id][subkey.id] = conversion;
         }
     }
-    UpdateViewModel();
+
+    // The unit lists arrived from the payload rather than Reset, so the
+    // search index has to be rebuilt over them here.
+    BuildUnitSearchIndex();
 }
 
 /// <summary>
@@ -402,12 +520,51 @@ void UnitConverter::RestoreUserPreferences(const wstring& userPreferences)
         return;
     }
 
-    vector<wstring> outerTokens = StringToVector(userPreferences, L"|");
-    if (outerTokens.size() == 3)
+    // Legacy preferences carried whole quoted unit and category structs.
+    if (userPreferences.find(L'|') != userPreferences.npos)
+    {
+        vector<wstring> outerTokens = StringToVector(userPreferences, L"|");
+        if (outerTokens.size() == 3)
+        {
+            m_fromType = StringToUnit(outerTokens[0]);
+            m_toType = StringToUnit(outerTokens[1]);
+            m_currentCategory = StringToCategory(outerTokens[2]);
+        }
+        return;
+    }
+
+    vector<wstring> tokens = StringToVector(userPreferences, L";");
+    if (tokens.size() != EXPECTEDCOMPACTPREFERENCESTOKENCOUNT || static_cast<uint32_t>(_wtoi(tokens[0].c_str())) != COMPACTSERIALIZATIONVERSION || !CheckLoad())
+    {
+        return;
+    }
+
+    int categoryId = _wtoi(tokens[3].c_str());
+    for (const Category& category : m_categories)
     {
-        m_fromType = StringToUnit(outerTokens[0]);
-        m_toType = StringToUnit(outerTokens[1]);
-        m_currentCategory = StringToCategory(outerTokens[2]);
+        if (category.id == categoryId)
+        {
+            m_currentCategory = category;
+            break;
+        }
+    }
+
+    int fromId = _wtoi(tokens[1].c_str());
+    int toId = _wtoi(tokens[2].c_str());
+    auto itr = m_categoryIdToUnits.find(m_currentCategory.id);
+    if (itr != m_categoryIdToUnits.end())
+    {
+        for (const Unit& unit : itr->second)
+        {
+            if (unit.id == fromId)
+            {
+                m_fromType = unit;
+            }
+            if (unit.id == toId)
+            {
+                m_toType = unit;
+            }
+        }
     }
 }
 
@@ -416,14 +573,15 @@ void UnitConverter::RestoreUserPreferences(const wstring& userPreferences)
 /// </summary>
 wstring UnitConverter::SaveUserPreferences()
 {
-    wstringstream out(wstringstream::out);
-    const wchar_t * delimiter = L";";
-
-    out << UnitToString(m_fromType, delimiter) << "|";
-    out << UnitToString(m_toType, delimiter) << "|";
-    out << CategoryToString(m_currentCategory, delimiter) << "|";
-    wstring test = out.str();
-    return test;
+    wstring out = to_wstring(COMPACTSERIALIZATIONVERSION);
+    out += L';';
+    out += to_wstring(m_fromType.id);
+    out += L';';
+    out += to_wstring(m_toType.id);
+    out += L';';
+    out += to_wstring(m_currentCategory.id);
+    out += L';';
+    return out;
 }
 
 /// <summary>
@@ -522,43 +680,43 @@ void UnitConverter::SendCommand(Command command)
     switch (command)
     {
     case Command::Zero:
-        m_currentDisplay += L"0";
+        AppendDigit(0);
         break;
 
     case Command::One:
-        m_currentDisplay += L"1";
+        AppendDigit(1);
         break;
 
     case Command::Two:
-        m_currentDisplay += L"2";
+        AppendDigit(2);
         break;
 
     case Command::Three:
-        m_currentDisplay += L"3";
+        AppendDigit(3);
         break;
 
     case Command::Four:
-        m_currentDisplay += L"4";
+        AppendDigit(4);
         break;
 
     case Command::Five:
-        m_currentDisplay += L"5";
+        AppendDigit(5);
         break;
 
     case Command::Six:
-        m_currentDisplay += L"6";
+        AppendDigit(6);
         break;
 
     case Command::Seven:
-        m_currentDisplay += L"7";
+        AppendDigit(7);
         break;
 
     case Command::Eight:
-        m_currentDisplay += L"8";
+        AppendDigit(8);
         break;
 
     case Command::Nine:
-        m_currentDisplay += L"9";
+        AppendDigit(9);
         break;
 
     case Command::Decimal:
@@ -587,6 +745,7 @@ void UnitConverter::SendCommand(Command command)
             m_currentDisplay = L"0";
             m_currentHasDecimal = false;
         }
+        SyncCurrentValue();
         break;
 
     case Command::Negate:
@@ -602,6 +761,7 @@ void UnitConverter::SendCommand(Command command)
             {
                 m_currentDisplay.insert(0, 1, '-');
             }
+            m_currentValue = -m_currentValue;
         }
         break;
 
@@ -630,6 +790,7 @@ void UnitConverter::SendCommand(Command command)
     if (clearBack)
     {
         m_currentDisplay.erase(m_currentDisplay.size() - 1, 1);
+        SyncCurrentValue();
         m_vmCallback->MaxDigitsReached();
     }
 
@@ -710,29 +871,112 @@ double UnitConverter::Convert(double value, ConversionData conversionData)
 }
 
 /// <summary>
-/// Calculates the suggested values for the current display value and returns them as a vector
+/// Points m_activeRatioMatrix at the current category's prepared matrix,
+/// building it on the category's first visit this session. After this, every
+/// from/to pair in the category is a single multiply away through
+/// RatioFromMatrix, with no hash probes or map copies on the keystroke path,
+/// and revisiting a category costs one hash lookup instead of a rebuild.
 /// </summary>
-vector<tuple<wstring, Unit>> UnitConverter::CalculateSuggested()
+void UnitConverter::EnsureRatioMatrix()
 {
-    if (m_currencyDataLoader != nullptr && m_currencyDataLoader->SupportsCategory(m_currentCategory))
+    auto cached = m_ratioMatrixCache.find(m_currentCategory.id);
+    if (cached != m_ratioMatrixCache.end())
+    {
+        m_activeRatioMatrix = &cached->second;
+        return;
+    }
+
+    CategoryRatioMatrix& entry = m_ratioMatrixCache[m_currentCategory.id];
+    entry.units = m_categoryIdToUnits[m_currentCategory.id];
+    const size_t unitCount = entry.units.size();
+    for (size_t i = 0; i < unitCount; i++)
     {
-        return vector<tuple<wstring, Unit>>();
+        entry.unitIdToIndex[entry.units[i].id] = i;
     }
 
+    // Pairs the loader did not provide stay at the identity conversion,
+    // which Calculate treats as "pass the display through unchanged".
+    entry.ratios.assign(unitCount * unitCount, ConversionData(1.0, 0.0, false));
+    for (size_t i = 0; i < unitCount; i++)
+    {
+        auto ratios = m_ratioMap.find(entry.units[i].id);
+        if (ratios == m_ratioMap.end())
+        {
+            continue;
+        }
+
+        for (const auto& conversion : ratios->second)
+        {
+            auto column = entry.unitIdToIndex.find(conversion.first);
+            if (column != entry.unitIdToIndex.end())
+            {
+                entry.ratios[i * unitCount + column->second] = conversion.second;
+            }
+        }
+    }
+
+    m_activeRatioMatrix = &entry;
+}
+
+/// <summary>
+/// Looks up the conversion data for a unit pair in the precomputed matrix.
+/// Returns nullptr when either unit is not part of the current category.
+/// </summary>
+const ConversionData* UnitConverter::RatioFromMatrix(const Unit& fromType, const Unit& toType)
+{
+    if (m_activeRatioMatrix == nullptr)
+    {
+        return nullptr;
+    }
+
+    auto row = m_activeRatioMatrix->unitIdToIndex.find(fromType.id);
+    auto column = m_activeRatioMatrix->unitIdToIndex.find(toType.id);
+    if (row == m_activeRatioMatrix->unitIdToIndex.end() || column == m_activeRatioMatrix->unitIdToIndex.end())
+    {
+        return nullptr;
+    }
+
+    return &m_activeRatioMatrix->ratios[row->second * m_activeRatioMatrix->units.size() + column->second];
+}
+
+/// <summary>
+/// True if the rounded string contains no nonzero digit ("0.00", "-0.0").
+/// Cheaper than parsing the string back through stod just to compare
+/// against zero.
+/// </summary>
+static bool IsZeroValueString(const wstring& roundedString)
+{
+    for (wchar_t ch : roundedString)
+    {
+        if (ch >= L'1' && ch <= L'9')
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// <summary>
+/// Calculates the suggested values for the captured sweep inputs and returns
+/// them as a vector. Runs on a background task (see UpdateViewModel), so it
+/// only reads the snapshot it is handed, never live converter state.
+/// </summary>
+vector<tuple<wstring, Unit>> UnitConverter::CalculateSuggested(const SuggestedSweep& sweep)
+{
     vector<tuple<wstring, Unit>> returnVector;
     vector<SuggestedValueIntermediate> intermediateVector;
     vector<SuggestedValueIntermediate> intermediateWhimsicalVector;
-    unordered_map<Unit, ConversionData, UnitHash> ratios = m_ratioMap[m_fromType];
     // Calculate converted values for every other unit type in this category, along with their magnitude
-    for (const auto& cur : ratios)
+    for (size_t i = 0; i < sweep.units.size(); i++)
     {
-        if (cur.first != m_fromType && cur.first != m_toType)
+        const Unit& targetType = sweep.units[i];
+        if (targetType != sweep.fromType && targetType != sweep.toType)
         {
-            double convertedValue = Convert(stod(m_currentDisplay), cur.second);
+            double convertedValue = Convert(sweep.currentValue, sweep.ratioRow[i]);
             SuggestedValueIntermediate newEntry;
             newEntry.magnitude = log10(convertedValue);
             newEntry.value = convertedValue;
-            newEntry.type = cur.first;
+            newEntry.type = targetType;
             if(newEntry.type.isWhimsical == false)
                 intermediateVector.push_back(newEntry);
             else
@@ -755,7 +999,7 @@ vector<tuple<wstring, Unit>> UnitConverter::CalculateSuggested()
     });
 
     // Now that the list is sorted, iterate over it and populate the return vector with properly rounded and formatted return strings
-    for (const auto& entry : intermediateVector)
+    auto roundEntry = [this](const SuggestedValueIntermediate& entry)
     {
         wstring roundedString;
         if (abs(entry.value) < 100)
@@ -764,16 +1008,41 @@ vector<tuple<wstring, Unit>> UnitConverter::CalculateSuggested()
         }
         else if (abs(entry.value) < 1000)
         {
-        roundedString = RoundSignificant(entry.value, 1);
+            roundedString = RoundSignificant(entry.value, 1);
         }
         else
         {
             roundedString = RoundSignificant(entry.value, 0);
         }
-        if (stod(roundedString) != 0.0 || m_currentCategory.supportsNegative)
+        TrimString(roundedString);
+        return roundedString;
+    };
+
+    // Each entry's rounding and formatting is independent, so for large
+    // categories (currency has around a hundred units) the entries are
+    // formatted in parallel, keeping the sorted order by writing into a
+    // pre-sized vector. The zero filter and the push stay sequential.
+    vector<wstring> roundedStrings(intermediateVector.size());
+    if (intermediateVector.size() >= SUGGESTEDPARALLELMINUNITS)
+    {
+        parallel_for(size_t(0), intermediateVector.size(), [&](size_t i)
+        {
+            roundedStrings[i] = roundEntry(intermediateVector[i]);
+        });
+    }
+    else
+    {
+        for (size_t i = 0; i < intermediateVector.size(); i++)
+        {
+            roundedStrings[i] = roundEntry(intermediateVector[i]);
+        }
+    }
+
+    for (size_t i = 0; i < intermediateVector.size(); i++)
+    {
+        if (!IsZeroValueString(roundedStrings[i]) || sweep.supportsNegative)
         {
-            TrimString(roundedString);
-            returnVector.push_back(make_tuple(roundedString, entry.type));
+            returnVector.push_back(make_tuple(move(roundedStrings[i]), intermediateVector[i].type));
         }
     }
 
@@ -797,24 +1066,11 @@ vector<tuple<wstring, Unit>> UnitConverter::CalculateSuggested()
 
     for (const auto& entry : intermediateWhimsicalVector)
     {
-        wstring roundedString;
-        if (abs(entry.value) < 100)
-        {
-            roundedString = RoundSignificant(entry.value, 2);
-        }
-        else if (abs(entry.value) < 1000)
-        {
-            roundedString = RoundSignificant(entry.value, 1);
-        }
-        else
-        {
-            roundedString = RoundSignificant(entry.value, 0);
-        }
+        wstring roundedString = roundEntry(entry);
 
         // How to work out which is the best whimsical value to add to the vector?
-        if (stod(roundedString) != 0.0)
+        if (!IsZeroValueString(roundedString))
         {
-            TrimString(roundedString);
             whimsicalReturnVector.push_back(make_tuple(roundedString, entry.type));
         }
     }
@@ -846,8 +1102,10 @@ void UnitConverter::Reset()
 
     m_currentCategory = m_categories[0];
 
-    m_categoryToUnits.clear();
+    m_categoryIdToUnits.clear();
     m_ratioMap.clear();
+    m_ratioMatrixCache.clear();
+    m_activeRatioMatrix = nullptr;
     bool readyCategoryFound = false;
     for (const Category& category : m_categories)
     {
@@ -861,15 +1119,20 @@ void UnitConverter::Reset()
         }
 
         vector<Unit> units = activeDataLoader->LoadOrderedUnits(category);
-        m_categoryToUnits[category] = units;
+        m_categoryIdToUnits[category.id] = units;
 
         // Just because the units are empty, doesn't mean the user can't select this category,
         // we just want to make sure we don't let an unready category be the default.
         if (!units.empty())
         {
-            for (Unit u : units)
+            for (const Unit& u : units)
             {
-                m_ratioMap[u] = activeDataLoader->LoadOrderedRatios(u);
+                // Intern the loader's unit-keyed ratios down to plain ids.
+                unordered_map<int, ConversionData>& ratios = m_ratioMap[u.id];
+                for (const auto& ratio : activeDataLoader->LoadOrderedRatios(u))
+                {
+                    ratios[ratio.first.id] = ratio.second;
+                }
             }
 
             if (!readyCategoryFound)
@@ -880,10 +1143,62 @@ void UnitConverter::Reset()
         }
     }
 
+    BuildUnitSearchIndex();
     InitializeSelectedUnits();
     Calculate();
 }
 
+/// <summary>
+/// Precompute the lowercase prefix index behind SearchUnits: every word of
+/// every unit's name plus its abbreviation, lowercased once here so a
+/// keystroke never pays for case folding a category's worth of names.
+/// Name-start words rank 0 and abbreviations rank 1, so typing "d" puts
+/// "Dollar" above "Canadian Dollar" while "cad" still finds it directly.
+/// </summary>
+void UnitConverter::BuildUnitSearchIndex()
+{
+    m_categoryIdToSearchTokens.clear();
+    for (const auto& categoryUnits : m_categoryIdToUnits)
+    {
+        vector<UnitSearchToken>& tokens = m_categoryIdToSearchTokens[categoryUnits.first];
+        for (size_t unitIndex = 0; unitIndex < categoryUnits.second.size(); unitIndex++)
+        {
+            const Unit& unit = categoryUnits.second[unitIndex];
+
+            size_t wordPosition = 0;
+            wstring word;
+            for (wchar_t ch : unit.name)
+            {
+                if (ch == L' ' || ch == L'-' || ch == L'(' || ch == L')' || ch == L'/')
+                {
+                    if (!word.empty())
+                    {
+                        tokens.push_back({ word, unitIndex, wordPosition == 0 ? 0 : wordPosition + 1 });
+                        word.clear();
+                        wordPosition++;
+                    }
+                }
+                else
+                {
+                    word.push_back(towlower(ch));
+                }
+            }
+            if (!word.empty())
+            {
+                tokens.push_back({ word, unitIndex, wordPosition == 0 ? 0 : wordPosition + 1 });
+            }
+
+            if (!unit.abbreviation.empty())
+            {
+                tokens.push_back({ LowercaseForSearch(unit.abbreviation), unitIndex, 1 });
+            }
+        }
+
+        sort(tokens.begin(), tokens.end(),
+            [](const UnitSearchToken& a, const UnitSearchToken& b) { return a.text < b.text; });
+    }
+}
+
 /// <summary>
 /// Sets the active data loader based on the input category.
 /// </summary>
@@ -908,13 +1223,13 @@ shared_ptr<IConverterDataLoader> UnitConverter::GetDataLoaderForCategory(const C
 void UnitConverter::InitializeSelectedUnits()
 {
 
-    if (m_categoryToUnits.empty())
+    if (m_categoryIdToUnits.empty())
     {
         return;
     }
 
-    auto itr = m_categoryToUnits.find(m_currentCategory);
-    if (itr == m_categoryToUnits.end())
+    auto itr = m_categoryIdToUnits.find(m_currentCategory.id);
+    if (itr == m_categoryIdToUnits.end())
     {
         return;
     }
@@ -957,6 +1272,88 @@ void UnitConverter::ClearValues()
     m_currentHasDecimal = false;
     m_returnHasDecimal = false;
     m_currentDisplay = L"0";
+    m_currentValue = 0.0;
+    m_currentMantissa = 0.0;
+    m_currentFractionDigits = 0;
+}
+
+/// <summary>
+/// Appends a digit to the current display while folding it into the
+/// incrementally maintained numeric value, so the keystroke's conversion
+/// starts from a ready double instead of a string re-parse.
+/// </summary>
+/// <param name="digit">digit value 0-9 to append</param>
+void UnitConverter::AppendDigit(unsigned int digit)
+{
+    m_currentDisplay += static_cast<wchar_t>(L'0' + digit);
+    m_currentMantissa = (m_currentMantissa * 10.0) + digit;
+    if (m_currentHasDecimal)
+    {
+        m_currentFractionDigits++;
+    }
+
+    // Dividing the integer mantissa by the exact power of ten yields the
+    // same correctly rounded double a full parse would have produced.
+    double scale = 1.0;
+    for (int i = 0; i < m_currentFractionDigits; i++)
+    {
+        scale *= 10.0;
+    }
+    double value = m_currentMantissa / scale;
+    m_currentValue = (m_currentDisplay.front() == L'-') ? -value : value;
+}
+
+/// <summary>
+/// Rebuilds the incremental numeric state from m_currentDisplay after an
+/// edit that did not go through AppendDigit, such as a backspace, a switch
+/// of the active field, or deserialization.
+/// </summary>
+void UnitConverter::SyncCurrentValue()
+{
+    m_currentMantissa = 0.0;
+    m_currentFractionDigits = 0;
+
+    if (m_currentDisplay.find_first_of(L"eE") != m_currentDisplay.npos)
+    {
+        // Scientific notation only appears when a calculated result was
+        // switched into the active field; any further typing clears the
+        // value first, so a full parse here is fine.
+        m_currentValue = stod(m_currentDisplay);
+        return;
+    }
+
+    bool negative = false;
+    bool decimalSeen = false;
+    for (wchar_t ch : m_currentDisplay)
+    {
+        if (ch == L'-')
+        {
+            negative = true;
+        }
+        else if (ch == L'.')
+        {
+            decimalSeen = true;
+        }
+        else if (ch >= L'0' && ch <= L'9')
+        {
+            m_currentMantissa = (m_currentMantissa * 10.0) + (ch - L'0');
+            if (decimalSeen)
+            {
+                m_currentFractionDigits++;
+            }
+        }
+    }
+
+    double scale = 1.0;
+    for (int i = 0; i < m_currentFractionDigits; i++)
+    {
+        scale *= 10.0;
+    }
+    m_currentValue = m_currentMantissa / scale;
+    if (negative)
+    {
+        m_currentValue = -m_currentValue;
+    }
 }
 
 /// <summary>
@@ -972,16 +1369,17 @@ bool UnitConverter::AnyUnitIsEmpty()
 /// </summary>
 void UnitConverter::Calculate()
 {
-    unordered_map<Unit, ConversionData, UnitHash> conversionTable = m_ratioMap[m_fromType];
-    double returnValue = stod(m_currentDisplay);
-    if (AnyUnitIsEmpty() || (conversionTable[m_toType].ratio == 1.0 && conversionTable[m_toType].offset == 0.0))
+    EnsureRatioMatrix();
+    const ConversionData* conversionData = RatioFromMatrix(m_fromType, m_toType);
+    double returnValue = m_currentValue;
+    if (AnyUnitIsEmpty() || conversionData == nullptr || (conversionData->ratio == 1.0 && conversionData->offset == 0.0))
     {
         m_returnDisplay = m_currentDisplay;
         TrimString(m_returnDisplay);
     }
     else
     {
-        returnValue = Convert(returnValue, conversionTable[m_toType]);
+        returnValue = Convert(returnValue, *conversionData);
         m_returnDisplay = RoundSignificant(returnValue, MAXIMUMDIGITSALLOWED);
         TrimString(m_returnDisplay);
         int numPreDecimal = (int)m_returnDisplay.size();
@@ -1053,7 +1451,14 @@ void UnitConverter::TrimString(wstring& returnString)
 /// <param name="numSignificant">int number of significant digits to round to</param>
 wstring UnitConverter::RoundSignificant(double num, int numSignificant)
 {
-    wstringstream out(wstringstream::out);
+    // Reused across calls: this runs several times per suggested value on
+    // every keystroke, and constructing a wstringstream (with its locale
+    // machinery) each time dominated the cost of the rounding itself. The
+    // stream is thread_local because suggested values can be computed off
+    // the UI thread.
+    static thread_local wstringstream out;
+    out.str(wstring());
+    out.clear();
     out << fixed;
     out.precision(numSignificant);
     out << num;
@@ -1076,5 +1481,54 @@ void UnitConverter::UpdateCurrencySymbols()
 void UnitConverter::UpdateViewModel()
 {
     m_vmCallback->DisplayCallback(m_currentDisplay, m_returnDisplay);
-    m_vmCallback->SuggestedValueCallback(CalculateSuggested());
+
+    // The suggested-value sweep formats a result for every unit in the
+    // category (around a hundred for currency), so it runs as a background
+    // task and the primary conversion above paints immediately. Inputs are
+    // snapshotted here; the task reads no live converter state. A newer
+    // keystroke bumps the generation, and a sweep that comes back stale
+    // drops its results. Delivery off the calling thread is safe: the view
+    // model's supplementary-results path is mutex-guarded and timer-driven.
+    const uint32_t generation = ++m_suggestedGeneration;
+    if (m_currencyDataLoader != nullptr && m_currencyDataLoader->SupportsCategory(m_currentCategory))
+    {
+        m_vmCallback->SuggestedValueCallback(vector<tuple<wstring, Unit>>());
+        return;
+    }
+
+    EnsureRatioMatrix();
+    SuggestedSweep sweep;
+    sweep.currentValue = 0.0;
+    sweep.fromType = m_fromType;
+    sweep.toType = m_toType;
+    sweep.supportsNegative = m_currentCategory.supportsNegative;
+    if (m_activeRatioMatrix != nullptr)
+    {
+        auto row = m_activeRatioMatrix->unitIdToIndex.find(m_fromType.id);
+        if (row != m_activeRatioMatrix->unitIdToIndex.end())
+        {
+            sweep.currentValue = m_currentValue;
+            sweep.units = m_activeRatioMatrix->units;
+            const size_t unitCount = sweep.units.size();
+            sweep.ratioRow.assign(m_activeRatioMatrix->ratios.begin() + row->second * unitCount,
+                m_activeRatioMatrix->ratios.begin() + (row->second + 1) * unitCount);
+        }
+    }
+
+    weak_ptr<UnitConverter> weakThis = weak_from_this();
+    shared_ptr<IUnitConverterVMCallback> vmCallback = m_vmCallback;
+    create_task([weakThis, vmCallback, sweep, generation]()
+    {
+        shared_ptr<UnitConverter> converter = weakThis.lock();
+        if (converter == nullptr || generation != converter->m_suggestedGeneration.load())
+        {
+            return;
+        }
+
+        vector<tuple<wstring, Unit>> suggested = converter->CalculateSuggested(sweep);
+        if (generation == converter->m_suggestedGeneration.load())
+        {
+            vmCallback->SuggestedValueCallback(suggested);
+        }
+    });
 }
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <atomic>
+
 namespace UnitConversionManager
 {
     enum class Command;
@@ -185,6 +187,7 @@ namespace UnitConversionManager
         virtual std::vector<Category> GetCategories() = 0;
         virtual CategorySelectionInitializer SetCurrentCategory(const Category& input) = 0;
         virtual Category GetCurrentCategory() = 0;
+        virtual std::vector<Unit> SearchUnits(const std::wstring& query) = 0;
         virtual void SetCurrentUnitTypes(const Unit& fromType, const Unit& toType) = 0;
         virtual void SwitchActive(const std::wstring& newValue) = 0;
         virtual std::wstring Serialize() = 0;
@@ -208,6 +211,7 @@ namespace UnitConversionManager
         std::vector<Category> GetCategories() override;
         CategorySelectionInitializer SetCurrentCategory(const Category& input) override;
         Category GetCurrentCategory() override;
+        std::vector<Unit> SearchUnits(const std::wstring& query) override;
         void SetCurrentUnitTypes(const Unit& fromType, const Unit& toType) override;
         void SwitchActive(const std::wstring& newValue) override;
         std::wstring Serialize() override;
@@ -227,19 +231,45 @@ namespace UnitConversionManager
     private:
         bool CheckLoad();
         double Convert(double value, ConversionData conversionData);
-        std::vector<std::tuple<std::wstring, Unit>> CalculateSuggested();
+        void EnsureRatioMatrix();
+        const ConversionData* RatioFromMatrix(const Unit& fromType, const Unit& toType);
+
+        // Inputs for one suggested-value sweep, captured on the input
+        // thread so the background task reads no live converter state.
+        struct SuggestedSweep
+        {
+            double currentValue;
+            Unit fromType;
+            Unit toType;
+            bool supportsNegative;
+            std::vector<Unit> units;
+            std::vector<ConversionData> ratioRow;
+        };
+        // One searchable token of a unit's display text: the lowercased
+        // token, the unit's position in its category's unit vector and a
+        // rank (0 for the start of the name, higher for later words) that
+        // orders matches.
+        struct UnitSearchToken
+        {
+            std::wstring text;
+            size_t unitIndex;
+            size_t rank;
+        };
+        void BuildUnitSearchIndex();
+
+        std::vector<std::tuple<std::wstring, Unit>> CalculateSuggested(const SuggestedSweep& sweep);
         void Reset();
         void ClearValues();
+        void AppendDigit(unsigned int digit);
+        void SyncCurrentValue();
         void Calculate();
         void TrimString(std::wstring& input);
         void InitializeSelectedUnits();
         std::wstring RoundSignificant(double num, int numSignificant);
         Category StringToCategory(const std::wstring& w);
-        std::wstring CategoryToString(const Category& c, const wchar_t * delimiter);
-        std::wstring UnitToString(const Unit& u, const wchar_t * delimiter);
         Unit StringToUnit(const std::wstring& w);
         ConversionData StringToConversionData(const std::wstring& w);
-        std::wstring ConversionDataToString(ConversionData d, const wchar_t * delimiter);
+        void DeSerializeLegacy(const std::wstring& serializedData);
         void UpdateCurrencySymbols();
         void UpdateViewModel();
         bool AnyUnitIsEmpty();
@@ -252,8 +282,18 @@ namespace UnitConversionManager
         std::shared_ptr<IUnitConverterVMCallback> m_vmCallback;
         std::shared_ptr<IViewModelCurrencyCallback> m_vmCurrencyCallback;
         std::vector<Category> m_categories;
-        CategoryToUnitVectorMap m_categoryToUnits;
-        UnitToUnitToConversionDataMap m_ratioMap;
+
+        // Categories and units are interned to their integer ids at load
+        // time, so the internal maps never hash or copy the wstring-bearing
+        // display structs; those only appear in the unit vectors handed to
+        // the view model.
+        std::unordered_map<int, std::vector<Unit>> m_categoryIdToUnits;
+        std::unordered_map<int, std::unordered_map<int, ConversionData>> m_ratioMap;
+
+        // Lowercase prefix index over each category's unit names and
+        // abbreviations, built once at load time and sorted so a query is
+        // a binary search plus a scan of the contiguous matching range.
+        std::unordered_map<int, std::vector<UnitSearchToken>> m_categoryIdToSearchTokens;
         Category m_currentCategory;
         Unit m_fromType;
         Unit m_toType;
@@ -262,5 +302,38 @@ namespace UnitConversionManager
         bool m_currentHasDecimal;
         bool m_returnHasDecimal;
         bool m_switchedActive;
+
+        // Numeric mirror of m_currentDisplay, maintained incrementally as
+        // digits arrive: the typed digits as an integer mantissa, the count
+        // of digits after the decimal point, and the resulting value.
+        // Edits that bypass AppendDigit resync through SyncCurrentValue.
+        double m_currentValue;
+        double m_currentMantissa;
+        int m_currentFractionDigits;
+
+        // Flat view of m_ratioMap for one category: the category's units,
+        // a map from unit id to row/column index, and a dense row-major
+        // unit-by-unit matrix of conversion data. The per-keystroke
+        // conversion and the suggested-value sweep index into the matrix
+        // instead of copying and re-probing the nested hash maps.
+        struct CategoryRatioMatrix
+        {
+            std::vector<Unit> units;
+            std::unordered_map<int, size_t> unitIdToIndex;
+            std::vector<ConversionData> ratios;
+        };
+
+        // Matrices are built on a category's first visit and kept for the
+        // session, so bouncing between recently used categories skips the
+        // rebuild. m_activeRatioMatrix points at the current category's
+        // entry (stable, as the map is node-based) and the cache is
+        // dropped whenever m_ratioMap itself is reloaded.
+        std::unordered_map<int, CategoryRatioMatrix> m_ratioMatrixCache;
+        const CategoryRatioMatrix* m_activeRatioMatrix;
+
+        // Each suggested-value sweep launched by UpdateViewModel bumps this;
+        // a sweep that finds itself stale on completion drops its results,
+        // so rapid keystrokes cancel the sweeps they obsolete.
+        std::atomic<uint32_t> m_suggestedGeneration;
     };
 }
@@ -0,0 +1,548 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// Micro-benchmark driver for the CalcManager kernels. Links CalcManager
+// directly (no UI) and sweeps the hot ratpak primitives and full
+// CalculatorManager command sequences across precision and radix.
+//
+// Output is CSV on stdout, one row per benchmark/configuration:
+//
+//     benchmark,param,radix,precision,iterations,ns_per_op
+//
+// so results can be diffed across releases by the perf scripts. An
+// optional command-line argument filters benchmarks by substring.
+//
+// A second mode replays captured keystroke journals:
+//
+//     calcbench --replay <journal.bin> [passes]
+//
+// where journal.bin holds the byte stream SerializeCommands produces.
+// Each pass dispatches the journal command by command at full speed and
+// accumulates a latency histogram per command type, then a final pass
+// goes through DeSerializeCommands itself so the compaction and replay
+// memoization paths are exercised the way a session restore runs them.
+
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "CalcManager/CalculatorManager.h"
+#include "CalcManager/Header Files/CalcEngine.h"
+#include "CalcManager/Ratpack/ratpak.h"
+
+using namespace CalculationManager;
+using namespace std;
+
+namespace
+{
+    // The engine treats empty resource strings as "use the default
+    // separators", the same contract the warm engine pool relies on.
+    class BenchResourceProvider : public IResourceProvider
+    {
+    public:
+        wstring GetCEngineString(const wstring& /*id*/) override
+        {
+            return wstring{};
+        }
+    };
+
+    // Swallows every display callback; the benchmarks time computation,
+    // not rendering.
+    class NullCalcDisplay : public ICalcDisplay
+    {
+    public:
+        void SetPrimaryDisplay(const wstring& /*pszText*/, bool /*isError*/) override {}
+        void SetIsInError(bool /*isInError*/) override {}
+        void SetExpressionDisplay(
+            _Inout_ shared_ptr<CalculatorVector<pair<wstring, int>>> const& /*tokens*/,
+            _Inout_ shared_ptr<CalculatorVector<shared_ptr<IExpressionCommand>>> const& /*commands*/) override {}
+        void SetParenDisplayText(const wstring& /*pszText*/) override {}
+        void OnNoRightParenAdded() override {}
+        void MaxDigitsReached() override {}
+        void BinaryOperatorReceived() override {}
+        void OnHistoryItemAdded(_In_ unsigned int /*addedItemIndex*/) override {}
+        void SetMemorizedNumbers(const vector<wstring>& /*memorizedNumbers*/) override {}
+        void MemoryItemChanged(unsigned int /*indexOfMemory*/) override {}
+    };
+
+    const char* g_filter = "";
+
+    // Runs the operation until enough wall time has accumulated for a
+    // stable per-op figure, doubling the batch size so the clock is read
+    // rarely, and emits one CSV row.
+    template <typename TOperation>
+    void RunBenchmark(const char* name, const char* param, uint32_t radix, int32_t precision, TOperation&& operation)
+    {
+        if (strstr(name, g_filter) == nullptr)
+        {
+            return;
+        }
+
+        using namespace std::chrono;
+        static constexpr uint64_t targetNs = 200'000'000; // 200 ms per configuration
+
+        operation(); // warm-up; also derives any lazily computed constants
+
+        uint64_t iterations = 0;
+        uint64_t elapsedNs = 0;
+        uint64_t batch = 1;
+
+        while (elapsedNs < targetNs)
+        {
+            auto start = steady_clock::now();
+            for (uint64_t i = 0; i < batch; i++)
+            {
+                operation();
+            }
+            elapsedNs += static_cast<uint64_t>(duration_cast<nanoseconds>(steady_clock::now() - start).count());
+            iterations += batch;
+
+            if (batch < (1ull << 20))
+            {
+                batch *= 2;
+            }
+        }
+
+        printf("%s,%s,%u,%d,%llu,%.1f\n",
+            name, param, radix, precision,
+            static_cast<unsigned long long>(iterations),
+            static_cast<double>(elapsedNs) / static_cast<double>(iterations));
+        fflush(stdout);
+    }
+
+    // A digit string of the requested length that is valid in the given
+    // radix, leading digit non-zero.
+    wstring MakeDigitString(size_t length, uint32_t radix)
+    {
+        uint32_t digitSpan = (radix < 10) ? radix : 10;
+        wstring digits;
+        digits.reserve(length);
+        digits.push_back(L'1');
+        for (size_t i = 1; i < length; i++)
+        {
+            digits.push_back(static_cast<wchar_t>(L'0' + (i * 7 + 3) % digitSpan));
+        }
+        return digits;
+    }
+
+    void BenchMulDivNumX()
+    {
+        static constexpr size_t mantissaDigits[] = { 16, 128, 1024 };
+        static constexpr int32_t precisions[] = { 32, 128 };
+
+        for (int32_t precision : precisions)
+        {
+            ChangeConstants(10, precision);
+
+            for (size_t digits : mantissaDigits)
+            {
+                char param[32];
+                snprintf(param, sizeof(param), "%zu_digits", digits);
+
+                // pp of a rational built from the digit string is the
+                // mantissa in internal BASEX form, which is what the x-form
+                // kernels operate on.
+                PRAT operandRat = StringToRat(false, MakeDigitString(digits, 10), false, {}, 10, precision);
+                PNUMBER operand = nullptr;
+                DUPNUM(operand, operandRat->pp);
+
+                RunBenchmark("ratpak_mulnumx", param, 10, precision, [&]() {
+                    PNUMBER product = nullptr;
+                    DUPNUM(product, operand);
+                    mulnumx(&product, operand);
+                    destroynum(product);
+                });
+
+                RunBenchmark("ratpak_divnumx", param, 10, precision, [&]() {
+                    PNUMBER quotient = nullptr;
+                    DUPNUM(quotient, operand);
+                    divnumx(&quotient, operand, precision);
+                    destroynum(quotient);
+                });
+
+                destroynum(operand);
+                destroyrat(operandRat);
+            }
+        }
+    }
+
+    void BenchTranscendentals()
+    {
+        static constexpr int32_t precisions[] = { 32, 128, 512 };
+
+        for (int32_t precision : precisions)
+        {
+            ChangeConstants(10, precision);
+
+            PRAT arg = StringToRat(false, L"0.5", false, {}, 10, precision);
+
+            RunBenchmark("ratpak_sinrat", "0.5", 10, precision, [&]() {
+                PRAT x = nullptr;
+                DUPRAT(x, arg);
+                sinrat(&x, 10, precision);
+                destroyrat(x);
+            });
+
+            RunBenchmark("ratpak_exprat", "0.5", 10, precision, [&]() {
+                PRAT x = nullptr;
+                DUPRAT(x, arg);
+                exprat(&x, 10, precision);
+                destroyrat(x);
+            });
+
+            destroyrat(arg);
+        }
+    }
+
+    void BenchFactorial()
+    {
+        static constexpr int32_t operands[] = { 50, 200 };
+        static constexpr int32_t precisions[] = { 32, 128 };
+
+        for (int32_t precision : precisions)
+        {
+            ChangeConstants(10, precision);
+
+            for (int32_t operandValue : operands)
+            {
+                char param[32];
+                snprintf(param, sizeof(param), "%d", operandValue);
+
+                PRAT operand = i32torat(operandValue);
+
+                RunBenchmark("ratpak_factrat", param, 10, precision, [&]() {
+                    PRAT x = nullptr;
+                    DUPRAT(x, operand);
+                    factrat(&x, 10, precision);
+                    destroyrat(x);
+                });
+
+                destroyrat(operand);
+            }
+        }
+    }
+
+    void BenchNumberToString()
+    {
+        static constexpr size_t mantissaDigits[] = { 16, 128, 1024 };
+        static constexpr uint32_t radixes[] = { 2, 10, 16 };
+        static constexpr int32_t precision = 32;
+
+        for (uint32_t radix : radixes)
+        {
+            ChangeConstants(radix, precision);
+
+            for (size_t digits : mantissaDigits)
+            {
+                char param[32];
+                snprintf(param, sizeof(param), "%zu_digits", digits);
+
+                PNUMBER source = StringToNumber(MakeDigitString(digits, radix), radix, precision);
+
+                RunBenchmark("ratpak_numbertostring", param, radix, precision, [&]() {
+                    // NumberToString may reformat its input, so each pass
+                    // formats a fresh copy.
+                    PNUMBER n = nullptr;
+                    DUPNUM(n, source);
+                    wstring result;
+                    NumberToString(n, FMT_FLOAT, radix, precision, result);
+                    destroynum(n);
+                });
+
+                destroynum(source);
+            }
+        }
+    }
+
+    void SendSequence(CalculatorManager& manager, const Command* commands, size_t count)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            manager.SendCommand(commands[i]);
+        }
+    }
+
+    void BenchManagerSequences()
+    {
+        BenchResourceProvider resourceProvider;
+        NullCalcDisplay display;
+        CalculatorManager manager(&display, &resourceProvider);
+
+        // 12345.678 + 87654.321 = , the per-keystroke standard-mode path.
+        static constexpr Command additionSequence[] = {
+            Command::CommandCLEAR,
+            Command::Command1, Command::Command2, Command::Command3, Command::Command4, Command::Command5,
+            Command::CommandPNT, Command::Command6, Command::Command7, Command::Command8,
+            Command::CommandADD,
+            Command::Command8, Command::Command7, Command::Command6, Command::Command5, Command::Command4,
+            Command::CommandPNT, Command::Command3, Command::Command2, Command::Command1,
+            Command::CommandEQU,
+        };
+
+        manager.SendCommand(Command::ModeBasic);
+        RunBenchmark("manager_standard_add_equals", "20_keys", 10, 32, [&]() {
+            SendSequence(manager, additionSequence, size(additionSequence));
+        });
+
+        // sin(0.5) in scientific mode, dominated by the taylor series.
+        static constexpr Command sineSequence[] = {
+            Command::CommandCLEAR,
+            Command::Command0, Command::CommandPNT, Command::Command5,
+            Command::CommandSIN,
+        };
+
+        manager.SendCommand(Command::ModeScientific);
+        RunBenchmark("manager_scientific_sin", "5_keys", 10, 32, [&]() {
+            SendSequence(manager, sineSequence, size(sineSequence));
+        });
+    }
+
+    // ---- Command-stream replay ------------------------------------------
+
+    // Per-command-type latency accumulator. Buckets are powers of two of
+    // nanoseconds starting at 64 ns, wide enough that the top bucket holds
+    // anything from a quarter second up.
+    struct ReplayStats
+    {
+        static constexpr size_t bucketCount = 22;
+        static constexpr uint64_t firstBucketNs = 64;
+
+        uint64_t count = 0;
+        uint64_t totalNs = 0;
+        uint64_t minNs = UINT64_MAX;
+        uint64_t maxNs = 0;
+        uint64_t buckets[bucketCount] = {};
+
+        void Record(uint64_t ns)
+        {
+            count++;
+            totalNs += ns;
+            minNs = (ns < minNs) ? ns : minNs;
+            maxNs = (ns > maxNs) ? ns : maxNs;
+
+            size_t bucket = 0;
+            for (uint64_t bound = firstBucketNs; ns >= bound && bucket < bucketCount - 1; bound *= 2)
+            {
+                bucket++;
+            }
+            buckets[bucket]++;
+        }
+    };
+
+    bool LoadJournal(const char* path, vector<unsigned char>& journal)
+    {
+        FILE* file = fopen(path, "rb");
+        if (file == nullptr)
+        {
+            return false;
+        }
+
+        unsigned char chunk[4096];
+        size_t read;
+        while ((read = fread(chunk, 1, sizeof(chunk), file)) > 0)
+        {
+            journal.insert(journal.end(), chunk, chunk + read);
+        }
+
+        fclose(file);
+        return !journal.empty();
+    }
+
+    // Dispatches one journal pass command by command, timing each dispatch.
+    // Decoding matches DeSerializeCommands: bytes in the memory-command
+    // range carry their slot index as the following byte, every other byte
+    // below CommandSIGN was folded down by UCHAR_MAX when serialized.
+    void ReplayJournalPass(CalculatorManager& manager, const vector<unsigned char>& journal, map<unsigned int, ReplayStats>& perCommand)
+    {
+        using namespace std::chrono;
+
+        constexpr unsigned char memoryCommandFirst = static_cast<unsigned char>(static_cast<unsigned int>(MemoryCommand::MemorizeNumber));
+        constexpr unsigned char memoryCommandLast = static_cast<unsigned char>(static_cast<unsigned int>(MemoryCommand::MemorizedNumberClearAll));
+
+        for (size_t i = 0; i < journal.size(); i++)
+        {
+            unsigned char commandByte = journal[i];
+            unsigned int commandId;
+            unsigned int indexOfMemory = 0;
+
+            if (commandByte >= memoryCommandFirst && commandByte <= memoryCommandLast)
+            {
+                commandId = commandByte + UCHAR_MAX + 1;
+                MemoryCommand memoryCommand = static_cast<MemoryCommand>(commandId);
+                if (memoryCommand != MemoryCommand::MemorizeNumber && memoryCommand != MemoryCommand::MemorizedNumberClearAll)
+                {
+                    if (i + 1 == journal.size())
+                    {
+                        throw out_of_range("Expecting index of memory, journal ended prematurely");
+                    }
+                    indexOfMemory = journal[++i];
+                }
+            }
+            else
+            {
+                commandId = commandByte;
+                if (commandByte < static_cast<unsigned int>(Command::CommandSIGN))
+                {
+                    commandId += UCHAR_MAX;
+                }
+            }
+
+            auto start = steady_clock::now();
+            switch (static_cast<MemoryCommand>(commandId))
+            {
+            case MemoryCommand::MemorizeNumber:
+                manager.MemorizeNumber();
+                break;
+            case MemoryCommand::MemorizedNumberLoad:
+                manager.MemorizedNumberLoad(indexOfMemory);
+                break;
+            case MemoryCommand::MemorizedNumberAdd:
+                manager.MemorizedNumberAdd(indexOfMemory);
+                break;
+            case MemoryCommand::MemorizedNumberSubtract:
+                manager.MemorizedNumberSubtract(indexOfMemory);
+                break;
+            default:
+                manager.SendCommand(static_cast<Command>(commandId));
+                break;
+            }
+            uint64_t ns = static_cast<uint64_t>(duration_cast<nanoseconds>(steady_clock::now() - start).count());
+
+            perCommand[commandId].Record(ns);
+        }
+    }
+
+    int RunReplay(const char* path, int passes)
+    {
+        using namespace std::chrono;
+
+        vector<unsigned char> journal;
+        if (!LoadJournal(path, journal))
+        {
+            fprintf(stderr, "cannot read journal '%s'\n", path);
+            return 1;
+        }
+
+        BenchResourceProvider resourceProvider;
+        NullCalcDisplay display;
+        CalculatorManager manager(&display, &resourceProvider);
+
+        map<unsigned int, ReplayStats> perCommand;
+
+        printf("record,command,count,min_ns,avg_ns,max_ns\n");
+
+        for (int pass = 0; pass < passes; pass++)
+        {
+            manager.Reset();
+            auto start = steady_clock::now();
+            ReplayJournalPass(manager, journal, perCommand);
+            double elapsedMs = duration_cast<duration<double, milli>>(steady_clock::now() - start).count();
+            printf("replay_pass,%d,%zu,,%.3f,\n", pass, journal.size(), elapsedMs * 1e6 / static_cast<double>(journal.size()));
+        }
+
+        // Whole-stream replays through the public restore path; the first
+        // run pays for the replay, repeats should hit the memo cache.
+        for (int pass = 0; pass < 2; pass++)
+        {
+            manager.Reset();
+            auto start = steady_clock::now();
+            manager.DeSerializeCommands(journal);
+            double elapsedMs = duration_cast<duration<double, milli>>(steady_clock::now() - start).count();
+            printf("deserialize_pass,%d,%zu,,%.3f,\n", pass, journal.size(), elapsedMs * 1e6 / static_cast<double>(journal.size()));
+        }
+
+        for (const auto& entry : perCommand)
+        {
+            const ReplayStats& stats = entry.second;
+            printf("replay_command,%u,%llu,%llu,%.1f,%llu\n",
+                entry.first,
+                static_cast<unsigned long long>(stats.count),
+                static_cast<unsigned long long>(stats.minNs),
+                static_cast<double>(stats.totalNs) / static_cast<double>(stats.count),
+                static_cast<unsigned long long>(stats.maxNs));
+
+            // One histogram row per occupied bucket; the bound column is
+            // the bucket's exclusive upper edge in nanoseconds.
+            uint64_t bound = ReplayStats::firstBucketNs;
+            for (size_t bucket = 0; bucket < ReplayStats::bucketCount; bucket++, bound *= 2)
+            {
+                if (stats.buckets[bucket] != 0)
+                {
+                    printf("replay_hist,%u,%llu,%llu,,\n",
+                        entry.first,
+                        static_cast<unsigned long long>(bound),
+                        static_cast<unsigned long long>(stats.buckets[bucket]));
+                }
+            }
+        }
+
+        return 0;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // Load the engine string table and this thread's ratpak constants
+    // before any kernel runs against them.
+    BenchResourceProvider resourceProvider;
+    CCalcEngine::InitialOneTimeOnlySetup(resourceProvider);
+
+    if (argc > 1 && strcmp(argv[1], "--replay") == 0)
+    {
+        if (argc < 3)
+        {
+            fprintf(stderr, "usage: calcbench --replay <journal.bin> [passes]\n");
+            return 2;
+        }
+
+        int passes = (argc > 3) ? atoi(argv[3]) : 3;
+        try
+        {
+            return RunReplay(argv[2], (passes > 0) ? passes : 1);
+        }
+        catch (const exception& e)
+        {
+            fprintf(stderr, "replay aborted: %s\n", e.what());
+            return 1;
+        }
+        catch (uint32_t calcError)
+        {
+            // A journal can legitimately drive the engine into an error
+            // state; a thrown CALC_E means the stream itself is damaged.
+            fprintf(stderr, "replay aborted by calc error 0x%08X\n", calcError);
+            return 1;
+        }
+    }
+
+    if (argc > 1)
+    {
+        g_filter = argv[1];
+    }
+
+    printf("benchmark,param,radix,precision,iterations,ns_per_op\n");
+
+    try
+    {
+        BenchMulDivNumX();
+        BenchTranscendentals();
+        BenchFactorial();
+        BenchNumberToString();
+        BenchManagerSequences();
+    }
+    catch (uint32_t calcError)
+    {
+        // Ratpak reports overflow and domain errors as thrown CALC_E codes.
+        fprintf(stderr, "benchmark aborted by calc error 0x%08X\n", calcError);
+        return 1;
+    }
+
+    return 0;
+}
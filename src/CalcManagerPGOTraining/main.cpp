@@ -0,0 +1,340 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// PGO training driver for CalcManager. Runs the scenario mix we see in
+// production - standard arithmetic dominating, then scientific chains,
+// programmer bitwise work and converter ratio math - so /GENPROFILE
+// release builds collect counts that match real usage rather than
+// whatever a unit-test pass happens to touch.
+//
+//     calcpgotrain [scale]
+//
+// scale multiplies every scenario's repetition count (default 1, a few
+// seconds on an instrumented build). Scenarios are deterministic so two
+// training runs produce the same profile.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "CalcManager/CalculatorManager.h"
+#include "CalcManager/Header Files/CalcEngine.h"
+#include "CalcManager/UnitConverter.h"
+
+using namespace CalculationManager;
+using namespace std;
+
+namespace
+{
+    // Relative weights of the scenario groups, from the function-usage
+    // telemetry: most sessions are short standard-mode arithmetic, the
+    // rest splits across scientific, programmer and converter use.
+    constexpr int StandardWeight = 11;
+    constexpr int ScientificWeight = 4;
+    constexpr int ProgrammerWeight = 3;
+    constexpr int ConverterWeight = 2;
+
+    // The engine treats empty resource strings as "use the default
+    // separators", the same contract the warm engine pool relies on.
+    class TrainingResourceProvider : public IResourceProvider
+    {
+    public:
+        wstring GetCEngineString(const wstring& /*id*/) override
+        {
+            return wstring{};
+        }
+    };
+
+    class NullCalcDisplay : public ICalcDisplay
+    {
+    public:
+        void SetPrimaryDisplay(const wstring& /*pszText*/, bool /*isError*/) override {}
+        void SetIsInError(bool /*isInError*/) override {}
+        void SetExpressionDisplay(
+            _Inout_ shared_ptr<CalculatorVector<pair<wstring, int>>> const& /*tokens*/,
+            _Inout_ shared_ptr<CalculatorVector<shared_ptr<IExpressionCommand>>> const& /*commands*/) override {}
+        void SetParenDisplayText(const wstring& /*pszText*/) override {}
+        void OnNoRightParenAdded() override {}
+        void MaxDigitsReached() override {}
+        void BinaryOperatorReceived() override {}
+        void OnHistoryItemAdded(_In_ unsigned int /*addedItemIndex*/) override {}
+        void SetMemorizedNumbers(const vector<wstring>& /*memorizedNumbers*/) override {}
+        void MemoryItemChanged(unsigned int /*indexOfMemory*/) override {}
+    };
+
+    class NullConverterCallback : public UnitConversionManager::IUnitConverterVMCallback
+    {
+    public:
+        void DisplayCallback(const wstring& /*from*/, const wstring& /*to*/) override {}
+        void SuggestedValueCallback(const vector<tuple<wstring, UnitConversionManager::Unit>>& /*suggestedValues*/) override {}
+        void MaxDigitsReached() override {}
+    };
+
+    // Two units with a plain ratio drive the converter's quantize and
+    // format path; the profile cares about the math, not the catalog.
+    class TrainingConverterDataLoader : public UnitConversionManager::IConverterDataLoader
+    {
+    public:
+        TrainingConverterDataLoader()
+        {
+            m_category.id = 1;
+            m_category.name = L"Length";
+            m_category.supportsNegative = true;
+
+            m_from = UnitConversionManager::Unit(1, L"Inches", L"In", true, true, false);
+            m_to = UnitConversionManager::Unit(2, L"Feet", L"Ft", false, false, false);
+
+            UnitConversionManager::ConversionData identity;
+            identity.ratio = 1.0;
+            identity.offset = 0.0;
+            identity.offsetFirst = false;
+
+            UnitConversionManager::ConversionData toFeet;
+            toFeet.ratio = 1.0 / 12.0;
+            toFeet.offset = 0.0;
+            toFeet.offsetFirst = false;
+
+            UnitConversionManager::ConversionData toInches;
+            toInches.ratio = 12.0;
+            toInches.offset = 0.0;
+            toInches.offsetFirst = false;
+
+            m_ratios[m_from][m_from] = identity;
+            m_ratios[m_from][m_to] = toFeet;
+            m_ratios[m_to][m_to] = identity;
+            m_ratios[m_to][m_from] = toInches;
+        }
+
+        void LoadData() override {}
+
+        vector<UnitConversionManager::Category> LoadOrderedCategories() override
+        {
+            return vector<UnitConversionManager::Category>{ m_category };
+        }
+
+        vector<UnitConversionManager::Unit> LoadOrderedUnits(const UnitConversionManager::Category& /*category*/) override
+        {
+            return vector<UnitConversionManager::Unit>{ m_from, m_to };
+        }
+
+        unordered_map<UnitConversionManager::Unit, UnitConversionManager::ConversionData, UnitConversionManager::UnitHash>
+            LoadOrderedRatios(const UnitConversionManager::Unit& unit) override
+        {
+            return m_ratios[unit];
+        }
+
+        bool SupportsCategory(const UnitConversionManager::Category& /*target*/) override
+        {
+            return true;
+        }
+
+    private:
+        UnitConversionManager::Category m_category;
+        UnitConversionManager::Unit m_from;
+        UnitConversionManager::Unit m_to;
+        unordered_map<UnitConversionManager::Unit,
+            unordered_map<UnitConversionManager::Unit, UnitConversionManager::ConversionData, UnitConversionManager::UnitHash>,
+            UnitConversionManager::UnitHash> m_ratios;
+    };
+
+    // Deterministic digit source so every training run walks the same
+    // command stream.
+    struct DigitStream
+    {
+        uint32_t state = 0x2545f491;
+
+        Command NextDigit(uint32_t span)
+        {
+            state = state * 1664525u + 1013904223u;
+            return static_cast<Command>(static_cast<uint32_t>(Command::Command0) + (state >> 16) % span);
+        }
+    };
+
+    void EnterNumber(CalculatorManager& manager, DigitStream& digits, int length, uint32_t span, bool withDecimal)
+    {
+        for (int i = 0; i < length; i++)
+        {
+            manager.SendCommand(digits.NextDigit(span));
+        }
+        if (withDecimal)
+        {
+            manager.SendCommand(Command::CommandPNT);
+            manager.SendCommand(digits.NextDigit(span));
+            manager.SendCommand(digits.NextDigit(span));
+        }
+    }
+
+    // Short arithmetic bursts with the occasional memory round trip: the
+    // bread-and-butter standard-mode session.
+    void TrainStandardArithmetic(CalculatorManager& manager, int repetitions)
+    {
+        static constexpr Command operators[] = {
+            Command::CommandADD, Command::CommandSUB, Command::CommandMUL, Command::CommandDIV,
+        };
+
+        DigitStream digits;
+        manager.SendCommand(Command::ModeBasic);
+
+        for (int i = 0; i < repetitions; i++)
+        {
+            manager.SendCommand(Command::CommandCLEAR);
+            EnterNumber(manager, digits, 4, 10, (i % 2) == 0);
+            for (int op = 0; op < 3; op++)
+            {
+                manager.SendCommand(operators[(i + op) % size(operators)]);
+                EnterNumber(manager, digits, 3, 10, false);
+            }
+            manager.SendCommand(Command::CommandEQU);
+
+            if ((i % 8) == 0)
+            {
+                manager.MemorizeNumber();
+                manager.MemorizedNumberAdd(0);
+                manager.MemorizedNumberLoad(0);
+                manager.MemorizedNumberClearAll();
+            }
+        }
+    }
+
+    // Trig/log/power chains: the taylor-series and exponent kernels that
+    // dominate scientific-mode time.
+    void TrainScientificChains(CalculatorManager& manager, int repetitions)
+    {
+        static constexpr Command unaryChain[] = {
+            Command::CommandSIN, Command::CommandCOS, Command::CommandTAN,
+            Command::CommandLN, Command::CommandLOG, Command::CommandSQRT,
+        };
+
+        DigitStream digits;
+        manager.SendCommand(Command::ModeScientific);
+
+        for (int i = 0; i < repetitions; i++)
+        {
+            manager.SendCommand(Command::CommandCLEAR);
+            manager.SendCommand(Command::Command0);
+            manager.SendCommand(Command::CommandPNT);
+            EnterNumber(manager, digits, 3, 10, false);
+            for (size_t f = 0; f < size(unaryChain); f++)
+            {
+                manager.SendCommand(unaryChain[(i + f) % size(unaryChain)]);
+            }
+
+            // x^y pulls in the general power path.
+            manager.SendCommand(Command::CommandCLEAR);
+            EnterNumber(manager, digits, 2, 10, false);
+            manager.SendCommand(Command::CommandPWR);
+            manager.SendCommand(Command::Command7);
+            manager.SendCommand(Command::CommandEQU);
+        }
+    }
+
+    // Wide bitwise expressions with radix flips; programmer mode keeps all
+    // four radix renderings warm.
+    void TrainProgrammerBitwise(CalculatorManager& manager, int repetitions)
+    {
+        static constexpr Command bitwiseOperators[] = {
+            Command::CommandAnd, Command::CommandOR, Command::CommandXor,
+            Command::CommandLSHF, Command::CommandRSHF, Command::CommandMOD,
+        };
+
+        DigitStream digits;
+        manager.SendCommand(Command::ModeProgrammer);
+
+        for (int i = 0; i < repetitions; i++)
+        {
+            manager.SendCommand(Command::CommandCLEAR);
+            EnterNumber(manager, digits, 8, 10, false);
+            for (int op = 0; op < 3; op++)
+            {
+                manager.SendCommand(bitwiseOperators[(i + op) % size(bitwiseOperators)]);
+                EnterNumber(manager, digits, 4, 10, false);
+            }
+            manager.SendCommand(Command::CommandEQU);
+            manager.SendCommand(Command::CommandNot);
+
+            manager.SetRadix(HEX_RADIX);
+            manager.SetRadix(OCT_RADIX);
+            manager.SetRadix(BIN_RADIX);
+            manager.SetRadix(DEC_RADIX);
+        }
+    }
+
+    // Converter keystroke storms with active-side switches: ratio math,
+    // quantize and the suggested-value sweep.
+    void TrainConverterRatios(int repetitions)
+    {
+        static constexpr UnitConversionManager::Command digitCommands[] = {
+            UnitConversionManager::Command::One, UnitConversionManager::Command::Four,
+            UnitConversionManager::Command::Two, UnitConversionManager::Command::Eight,
+            UnitConversionManager::Command::Five, UnitConversionManager::Command::Nine,
+        };
+
+        auto dataLoader = make_shared<TrainingConverterDataLoader>();
+        UnitConversionManager::UnitConverter converter(dataLoader);
+        converter.SetViewModelCallback(make_shared<NullConverterCallback>());
+        converter.Initialize();
+
+        auto initializer = converter.SetCurrentCategory(dataLoader->LoadOrderedCategories()[0]);
+        converter.SetCurrentUnitTypes(get<1>(initializer), get<2>(initializer));
+
+        for (int i = 0; i < repetitions; i++)
+        {
+            converter.SendCommand(UnitConversionManager::Command::Clear);
+            for (size_t d = 0; d < size(digitCommands); d++)
+            {
+                converter.SendCommand(digitCommands[(i + d) % size(digitCommands)]);
+            }
+            converter.SendCommand(UnitConversionManager::Command::Decimal);
+            converter.SendCommand(digitCommands[i % size(digitCommands)]);
+            converter.SendCommand(UnitConversionManager::Command::Backspace);
+            converter.SwitchActive(L"144");
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    int scale = 1;
+    if (argc > 1)
+    {
+        scale = atoi(argv[1]);
+        if (scale < 1)
+        {
+            fprintf(stderr, "usage: calcpgotrain [scale]\n");
+            return 2;
+        }
+    }
+
+    // Load the engine string table and this thread's ratpak constants
+    // before the scenarios run.
+    TrainingResourceProvider resourceProvider;
+    CCalcEngine::InitialOneTimeOnlySetup(resourceProvider);
+
+    NullCalcDisplay display;
+    CalculatorManager manager(&display, &resourceProvider);
+
+    static constexpr int repetitionsPerWeight = 25;
+
+    try
+    {
+        TrainStandardArithmetic(manager, StandardWeight * repetitionsPerWeight * scale);
+        TrainScientificChains(manager, ScientificWeight * repetitionsPerWeight * scale);
+        TrainProgrammerBitwise(manager, ProgrammerWeight * repetitionsPerWeight * scale);
+        TrainConverterRatios(ConverterWeight * repetitionsPerWeight * scale);
+    }
+    catch (uint32_t calcError)
+    {
+        // Ratpak reports overflow and domain errors as thrown CALC_E codes.
+        fprintf(stderr, "training aborted by calc error 0x%08X\n", calcError);
+        return 1;
+    }
+
+    printf("training complete (scale %d)\n", scale);
+    return 0;
+}
@@ -5,6 +5,7 @@
 #include "ApplicationViewModel.h"
 #include "Common/TraceLogger.h"
 #include "Common/AppResourceProvider.h"
+#include "Common/LocalizationService.h"
 #include "StandardCalculatorViewModel.h"
 #include "DateCalculatorViewModel.h"
 #include "DataLoaders/CurrencyHttpClient.h"
@@ -101,6 +102,125 @@ void ApplicationViewModel::Initialize(ViewMode mode)
             throw;
         }
     }
+
+    PreloadModeViewModels();
+    RegisterMemoryPressureTrim();
+}
+
+// Subscribes this window to the platform memory events so burst-performance
+// caches get released when the app approaches its memory cap - important on
+// the small-memory devices where the cap is tight. The MemoryManager events
+// are process-wide and fire on a worker thread; the handlers capture a weak
+// reference so a closed window's ViewModel can still be collected, and hop
+// to this window's dispatcher at low priority so the trim serializes with
+// the UI thread's own use of the calculator manager.
+void ApplicationViewModel::RegisterMemoryPressureTrim()
+{
+    if (m_memoryPressureRegistered)
+    {
+        return;
+    }
+
+    auto window = CoreWindow::GetForCurrentThread();
+    if (window == nullptr)
+    {
+        return;
+    }
+    m_memoryPressureRegistered = true;
+
+    auto dispatcher = window->Dispatcher;
+    WeakReference weakThis(this);
+    auto scheduleTrim = [weakThis, dispatcher]() {
+        dispatcher->RunAsync(CoreDispatcherPriority::Low, ref new DispatchedHandler([weakThis]() {
+            auto that = weakThis.Resolve<ApplicationViewModel>();
+            if (that != nullptr)
+            {
+                that->TrimMemory();
+            }
+        }));
+    };
+
+    MemoryManager::AppMemoryUsageIncreased += ref new Windows::Foundation::EventHandler<Object^>([scheduleTrim](Object^ /*sender*/, Object^ /*args*/) {
+        if (MemoryManager::AppMemoryUsageLevel != AppMemoryUsageLevel::Low)
+        {
+            scheduleTrim();
+        }
+    });
+
+    MemoryManager::AppMemoryUsageLimitChanging += ref new Windows::Foundation::EventHandler<AppMemoryUsageLimitChangingEventArgs^>(
+        [scheduleTrim](Object^ /*sender*/, AppMemoryUsageLimitChangingEventArgs^ args) {
+            // The limit drops before the app is expected to fit under it;
+            // trim proactively when current usage would not.
+            if (MemoryManager::AppMemoryUsage >= args->NewLimit)
+            {
+                scheduleTrim();
+            }
+        });
+}
+
+// Runs on the UI thread (dispatched by the handlers above). Everything
+// released here is a cache or pool that rebuilds on demand, so no
+// user-visible state changes.
+void ApplicationViewModel::TrimMemory()
+{
+    if (m_CalculatorViewModel != nullptr)
+    {
+        m_CalculatorViewModel->TrimMemory();
+    }
+}
+
+// Constructs the remaining mode ViewModels while the dispatcher is idle, so
+// the first switch to each mode after startup finds its ViewModel already
+// built — a binding refresh instead of construction plus data-loader setup.
+// The ViewModels must be created on the UI thread, but idle priority keeps
+// the work out of the launch render path, and the converter's data loaders
+// do their loading asynchronously once constructed.
+void ApplicationViewModel::PreloadModeViewModels()
+{
+    if (m_preloadScheduled)
+    {
+        return;
+    }
+    m_preloadScheduled = true;
+
+    auto window = CoreWindow::GetForCurrentThread();
+    if (window == nullptr)
+    {
+        return;
+    }
+
+    window->Dispatcher->RunIdleAsync(ref new IdleDispatchedHandler([this](IdleDispatchedHandlerArgs^ /*args*/) {
+        EnsureViewModelExists(ViewMode::Standard);
+        EnsureViewModelExists(ViewMode::Date);
+        EnsureViewModelExists(ViewMode::Volume);
+    }));
+}
+
+void ApplicationViewModel::EnsureViewModelExists(ViewMode mode)
+{
+    if (NavCategory::IsCalculatorViewMode(mode))
+    {
+        if (!m_CalculatorViewModel)
+        {
+            m_CalculatorViewModel = ref new StandardCalculatorViewModel();
+        }
+    }
+    else if (NavCategory::IsDateCalculatorViewMode(mode))
+    {
+        if (!m_DateCalcViewModel)
+        {
+            m_DateCalcViewModel = ref new DateCalculatorViewModel();
+        }
+    }
+    else if (NavCategory::IsConverterViewMode(mode))
+    {
+        if (!m_ConverterViewModel)
+        {
+            auto dataLoader = make_shared<UnitConverterDataLoader>(LocalizationService::GetRegionCodeTwoLetter());
+            auto currencyDataLoader = make_shared<CurrencyDataLoader>(make_unique<CurrencyHttpClient>());
+            m_ConverterViewModel = ref new UnitConverterViewModel(make_shared<UnitConversionManager::UnitConverter>(dataLoader, currencyDataLoader));
+        }
+    }
 }
 
 bool ApplicationViewModel::TryRecoverFromNavigationModeFailure()
@@ -123,33 +243,20 @@ void ApplicationViewModel::OnModeChanged()
 {
     assert(NavCategory::IsValidViewMode(m_mode));
     TraceLogger::GetInstance().LogModeChangeBegin(m_PreviousMode, m_mode, ApplicationView::GetApplicationViewIdForWindow(CoreWindow::GetForCurrentThread()));
+    EnsureViewModelExists(m_mode);
+
     if (NavCategory::IsCalculatorViewMode(m_mode))
     {
         TraceLogger::GetInstance().LogCalculatorModeViewed(m_mode, ApplicationView::GetApplicationViewIdForWindow(CoreWindow::GetForCurrentThread()));
-        if (!m_CalculatorViewModel)
-        {
-            m_CalculatorViewModel = ref new StandardCalculatorViewModel();
-        }
         m_CalculatorViewModel->SetCalculatorType(m_mode);
     }
     else if (NavCategory::IsDateCalculatorViewMode(m_mode))
     {
         TraceLogger::GetInstance().LogDateCalculatorModeViewed(m_mode, ApplicationView::GetApplicationViewIdForWindow(CoreWindow::GetForCurrentThread()));
-        if (!m_DateCalcViewModel)
-        {
-            m_DateCalcViewModel = ref new DateCalculatorViewModel();
-        }
     }
     else if (NavCategory::IsConverterViewMode(m_mode))
     {
         TraceLogger::GetInstance().LogConverterModeViewed(m_mode, ApplicationView::GetApplicationViewIdForWindow(CoreWindow::GetForCurrentThread()));
-        if (!m_ConverterViewModel)
-        {
-            auto dataLoader = make_shared<UnitConverterDataLoader>(ref new GeographicRegion());
-            auto currencyDataLoader = make_shared<CurrencyDataLoader>(make_unique<CurrencyHttpClient>());
-            m_ConverterViewModel = ref new UnitConverterViewModel(make_shared<UnitConversionManager::UnitConverter>(dataLoader, currencyDataLoader));
-        }
-
         m_ConverterViewModel->Mode = m_mode;
     }
 
@@ -80,6 +80,10 @@ namespace CalculatorApp
             bool TryRecoverFromNavigationModeFailure();
 
             void OnModeChanged();
+            void EnsureViewModelExists(CalculatorApp::Common::ViewMode mode);
+            void PreloadModeViewModels();
+            void RegisterMemoryPressureTrim();
+            void TrimMemory();
 
             void OnCopyCommand(Platform::Object^ parameter);
             void OnPasteCommand(Platform::Object^ parameter);
@@ -88,6 +92,8 @@ namespace CalculatorApp
 
             CalculatorApp::Common::ViewMode m_mode;
             Windows::Foundation::Collections::IObservableVector<CalculatorApp::Common::NavCategoryGroup^>^ m_categories;
+            bool m_preloadScheduled = false;
+            bool m_memoryPressureRegistered = false;
         };
     }
 }
@@ -67,7 +67,7 @@ namespace CalculatorApp { namespace Common
             if (item)
             {
                 unsigned int newCurrentPosition = 0;
-                bool result = m_source->IndexOf(item, &newCurrentPosition);
+                bool result = LookupIndex(item, &newCurrentPosition);
                 if (result)
                 {
                     m_currentPosition = newCurrentPosition;
@@ -209,7 +209,7 @@ namespace CalculatorApp { namespace Common
 
         virtual bool IndexOf(Platform::Object^ item, unsigned int* index) = Windows::Foundation::Collections::IVector<Platform::Object^>::IndexOf
         {
-            return m_source->IndexOf(item, index);
+            return LookupIndex(item, index);
         }
 
         property unsigned int Size
@@ -244,10 +244,64 @@ namespace CalculatorApp { namespace Common
         void OnSourceBindableVectorChanged(Windows::UI::Xaml::Interop::IBindableObservableVector^ source, Platform::Object^ e)
         {
             Windows::Foundation::Collections::IVectorChangedEventArgs^ args = safe_cast<Windows::Foundation::Collections::IVectorChangedEventArgs^>(e);
+            m_sourceIndexDirty = true;
             m_vectorChanged(this, args);
         }
 
+        // Item identity hashing for the item->index side map. The unit lists
+        // hold ref class instances, so handle identity matches the source
+        // vector's comparison; anything else falls back to the linear scan.
+        struct SourceItemHash
+        {
+            size_t operator()(Platform::Object^ item) const
+            {
+                return std::hash<void*>()(reinterpret_cast<void*>(item));
+            }
+        };
+
+        struct SourceItemEqual
+        {
+            bool operator()(Platform::Object^ left, Platform::Object^ right) const
+            {
+                return reinterpret_cast<void*>(left) == reinterpret_cast<void*>(right);
+            }
+        };
+
+        bool LookupIndex(Platform::Object^ item, unsigned int* index)
+        {
+            if (m_sourceIndexDirty)
+            {
+                RebuildSourceIndex();
+            }
+
+            auto entry = m_sourceIndex.find(item);
+            if (entry != m_sourceIndex.end())
+            {
+                *index = entry->second;
+                return true;
+            }
+
+            // Items that don't compare by handle identity still resolve
+            // through the source vector's own comparison.
+            return m_source->IndexOf(item, index);
+        }
+
+        void RebuildSourceIndex()
+        {
+            m_sourceIndex.clear();
+            unsigned int size = m_source->Size;
+            m_sourceIndex.reserve(size);
+            for (unsigned int i = 0; i < size; i++)
+            {
+                // emplace keeps the first occurrence, matching IndexOf.
+                m_sourceIndex.emplace(m_source->GetAt(i), i);
+            }
+            m_sourceIndexDirty = false;
+        }
+
         Windows::UI::Xaml::Interop::IBindableVector^ m_source;
+        std::unordered_map<Platform::Object^, unsigned int, SourceItemHash, SourceItemEqual> m_sourceIndex;
+        bool m_sourceIndexDirty = true;
         int m_currentPosition;
         event WF::EventHandler<Platform::Object^>^ m_currentChanged;
         event Windows::UI::Xaml::Data::CurrentChangingEventHandler^ m_currentChanging;
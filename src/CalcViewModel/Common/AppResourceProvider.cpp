@@ -4,7 +4,9 @@
 #include "pch.h"
 #include "AppResourceProvider.h"
 
+using namespace concurrency;
 using namespace Platform;
+using namespace std;
 using namespace Windows::ApplicationModel::Resources;
 using namespace CalculatorApp;
 
@@ -22,10 +24,31 @@ AppResourceProvider & AppResourceProvider::GetInstance()
 
 String^ AppResourceProvider::GetResourceString(_In_ String^ key)
 {
-    return m_stringResLoader->GetString(key);
+    return GetCachedString(m_stringCache, m_stringResLoader, key);
 }
 
 String^ AppResourceProvider::GetCEngineString(_In_ String^ key)
 {
-    return m_cEngineStringResLoader->GetString(key);
+    return GetCachedString(m_cEngineStringCache, m_cEngineStringResLoader, key);
+}
+
+String^ AppResourceProvider::GetCachedString(unordered_map<wstring, String^>& cache, ResourceLoader^ loader, _In_ String^ key)
+{
+    wstring keyString(key->Data(), key->Length());
+
+    {
+        reader_writer_lock::scoped_lock_read readLock(m_cacheLock);
+        auto entry = cache.find(keyString);
+        if (entry != cache.end())
+        {
+            return entry->second;
+        }
+    }
+
+    // Resolve outside the lock; concurrent lookups of the same key resolve
+    // to the same value and the first emplace wins.
+    String^ value = loader->GetString(key);
+
+    reader_writer_lock::scoped_lock writeLock(m_cacheLock);
+    return cache.emplace(move(keyString), value).first->second;
 }
@@ -14,7 +14,19 @@ namespace CalculatorApp
 
     private:
         AppResourceProvider();
+        Platform::String^ GetCachedString(
+            std::unordered_map<std::wstring, Platform::String^>& cache,
+            Windows::ApplicationModel::Resources::ResourceLoader^ loader,
+            _In_ Platform::String^ key);
+
         Windows::ApplicationModel::Resources::ResourceLoader^ m_stringResLoader;
         Windows::ApplicationModel::Resources::ResourceLoader^ m_cEngineStringResLoader;
+
+        // Process-wide caches in front of ResourceLoader, shared across
+        // windows. Resource strings are immutable for the process lifetime
+        // (a language change relaunches the app), so entries are only added.
+        concurrency::reader_writer_lock m_cacheLock;
+        std::unordered_map<std::wstring, Platform::String^> m_stringCache;
+        std::unordered_map<std::wstring, Platform::String^> m_cEngineStringCache;
     };
 }
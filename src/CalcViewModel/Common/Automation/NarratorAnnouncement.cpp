@@ -73,6 +73,12 @@ NarratorAnnouncement^ CalculatorAnnouncement::GetDisplayUpdatedAnnouncement(Stri
         AutomationNotificationProcessing::ImportantMostRecent);
 }
 
+bool CalculatorAnnouncement::IsDisplayUpdatedAnnouncement(NarratorAnnouncement^ announcement)
+{
+    return announcement != nullptr
+        && announcement->ActivityId == CalculatorActivityIds::DisplayUpdated;
+}
+
 NarratorAnnouncement^ CalculatorAnnouncement::GetMaxDigitsReachedAnnouncement(String^ announcement)
 {
     return ref new NarratorAnnouncement(
@@ -77,6 +77,7 @@ namespace CalculatorApp::Common::Automation
     {
     public:
         static NarratorAnnouncement^ GetDisplayUpdatedAnnouncement(Platform::String^ announcement);
+        static bool IsDisplayUpdatedAnnouncement(NarratorAnnouncement^ announcement);
         static NarratorAnnouncement^ GetMaxDigitsReachedAnnouncement(Platform::String^ announcement);
 
         static NarratorAnnouncement^ GetMemoryClearedAnnouncement(Platform::String^ announcement);
@@ -9,10 +9,19 @@
 
 using namespace CalculatorApp::Common::Automation;
 using namespace Platform;
+using namespace Windows::Foundation;
 using namespace Windows::UI::Xaml;
 using namespace Windows::UI::Xaml::Automation;
 using namespace Windows::UI::Xaml::Automation::Peers;
 
+namespace
+{
+    // How long input must be quiet before a pending display update is
+    // announced. Long enough to span the gap between rapid keystrokes,
+    // short enough that the settled result does not feel delayed.
+    constexpr long long QuietTimeBeforeAnnouncement = 2500000L; // 250 ms (in 100-ns units)
+}
+
 DependencyProperty^ NarratorNotifier::s_announcementProperty;
 
 NarratorNotifier::NarratorNotifier()
@@ -22,8 +31,46 @@ NarratorNotifier::NarratorNotifier()
 
 void NarratorNotifier::Announce(NarratorAnnouncement^ announcement)
 {
-    if (NarratorAnnouncement::IsValid(announcement)
-        && m_announcementHost != nullptr)
+    if (!NarratorAnnouncement::IsValid(announcement)
+        || m_announcementHost == nullptr)
+    {
+        return;
+    }
+
+    // Rapid typing raises a display update per keystroke; forwarding each one
+    // floods the screen reader and drags input handling while it is attached.
+    // Hold the latest display update and announce it once input goes quiet.
+    // All other announcements are one-shot and go out immediately.
+    if (CalculatorAnnouncement::IsDisplayUpdatedAnnouncement(announcement))
+    {
+        m_pendingDisplayAnnouncement = announcement;
+
+        if (m_coalesceTimer == nullptr)
+        {
+            m_coalesceTimer = ref new DispatcherTimer();
+            TimeSpan quietTime{};
+            quietTime.Duration = QuietTimeBeforeAnnouncement;
+            m_coalesceTimer->Interval = quietTime;
+            m_coalesceTimer->Tick += ref new EventHandler<Object^>(this, &NarratorNotifier::OnCoalesceTimerTick);
+        }
+
+        // Restarting the timer extends the quiet window while keys keep coming,
+        // so intermediate values are never announced.
+        m_coalesceTimer->Stop();
+        m_coalesceTimer->Start();
+        return;
+    }
+
+    m_announcementHost->Announce(announcement);
+}
+
+void NarratorNotifier::OnCoalesceTimerTick(Object^ /*sender*/, Object^ /*e*/)
+{
+    m_coalesceTimer->Stop();
+
+    auto announcement = m_pendingDisplayAnnouncement;
+    m_pendingDisplayAnnouncement = nullptr;
+    if (announcement != nullptr)
     {
         m_announcementHost->Announce(announcement);
     }
@@ -49,9 +49,17 @@ namespace CalculatorApp::Common::Automation
             _In_ Windows::UI::Xaml::DependencyObject^ dependencyObject,
             _In_ Windows::UI::Xaml::DependencyPropertyChangedEventArgs^ eventArgs);
 
+        void OnCoalesceTimerTick(Platform::Object^ sender, Platform::Object^ e);
+
         static Windows::UI::Xaml::DependencyProperty^ s_announcementProperty;
 
     private:
         INarratorAnnouncementHost^ m_announcementHost;
+
+        // Display update announcements arrive once per keystroke; the latest
+        // one is held here until input has been quiet long enough to announce
+        // the settled value.
+        NarratorAnnouncement^ m_pendingDisplayAnnouncement;
+        Windows::UI::Xaml::DispatcherTimer^ m_coalesceTimer;
     };
 }
@@ -6,10 +6,12 @@
 #include "pch.h"
 #include "CalculatorDisplay.h"
 #include "StandardCalculatorViewModel.h"
+#include "Common/TraceLogger.h"
 
 using namespace CalculatorApp;
 using namespace CalculationManager;
 using namespace std;
+using namespace Windows::UI::Core;
 
 CalculatorDisplay::CalculatorDisplay()
 {
@@ -18,6 +20,13 @@ CalculatorDisplay::CalculatorDisplay()
 void CalculatorDisplay::SetCallback(Platform::WeakReference callbackReference)
 {
     m_callbackReference = callbackReference;
+
+    // Called on the UI thread when the ViewModel hooks up; remember its
+    // dispatcher so display transactions ended on the engine thread can be
+    // drained back onto it. Unit tests run without a CoreWindow and stay
+    // fully synchronous.
+    auto window = CoreWindow::GetForCurrentThread();
+    m_dispatcher = (window != nullptr) ? window->Dispatcher : nullptr;
 }
 
 void CalculatorDisplay::SetHistoryCallback(Platform::WeakReference callbackReference)
@@ -27,6 +36,14 @@ void CalculatorDisplay::SetHistoryCallback(Platform::WeakReference callbackRefer
 
 void CalculatorDisplay::SetPrimaryDisplay(_In_ const wstring& displayStringValue, _In_ bool isError)
 {
+    if (m_inTransaction)
+    {
+        m_pending.primaryValue = displayStringValue;
+        m_pending.primaryIsError = isError;
+        m_pending.primaryPending = true;
+        return;
+    }
+
     if (m_callbackReference)
     {
         if (auto calcVM = m_callbackReference.Resolve<ViewModel::StandardCalculatorViewModel>())
@@ -38,6 +55,13 @@ void CalculatorDisplay::SetPrimaryDisplay(_In_ const wstring& displayStringValue
 
 void CalculatorDisplay::SetParenDisplayText(_In_ const std::wstring& parenthesisCount)
 {
+    if (m_inTransaction)
+    {
+        m_pending.parenText = parenthesisCount;
+        m_pending.parenPending = true;
+        return;
+    }
+
     if (m_callbackReference != nullptr)
     {
         if (auto calcVM = m_callbackReference.Resolve<ViewModel::StandardCalculatorViewModel>())
@@ -60,6 +84,13 @@ void CalculatorDisplay::OnNoRightParenAdded()
 
 void CalculatorDisplay::SetIsInError(bool isError)
 {
+    if (m_inTransaction)
+    {
+        m_pending.isInError = isError;
+        m_pending.errorPending = true;
+        return;
+    }
+
     if (m_callbackReference != nullptr)
     {
         if (auto calcVM = m_callbackReference.Resolve<ViewModel::StandardCalculatorViewModel>())
@@ -71,6 +102,14 @@ void CalculatorDisplay::SetIsInError(bool isError)
 
 void CalculatorDisplay::SetExpressionDisplay(_Inout_ std::shared_ptr<CalculatorVector<std::pair<std::wstring, int>>> const &tokens, _Inout_ std::shared_ptr<CalculatorVector <std::shared_ptr<IExpressionCommand>>> const &commands)
 {
+    if (m_inTransaction)
+    {
+        m_pending.expressionTokens = tokens;
+        m_pending.expressionCommands = commands;
+        m_pending.expressionPending = true;
+        return;
+    }
+
     if (m_callbackReference != nullptr)
     {
         if(auto calcVM = m_callbackReference.Resolve<ViewModel::StandardCalculatorViewModel>())
@@ -91,6 +130,17 @@ void CalculatorDisplay::SetMemorizedNumbers(_In_ const vector<std::wstring>& new
     }
 }
 
+void CalculatorDisplay::SetMemorizedNumber(_In_ unsigned int indexOfMemory, const std::wstring& memorizedNumber)
+{
+    if (m_callbackReference != nullptr)
+    {
+        if (auto calcVM = m_callbackReference.Resolve<ViewModel::StandardCalculatorViewModel>())
+        {
+            calcVM->SetMemorizedNumber(indexOfMemory, memorizedNumber);
+        }
+    }
+}
+
 void CalculatorDisplay::OnHistoryItemAdded(_In_ unsigned int addedItemIndex)
 {
     if (m_historyCallbackReference != nullptr)
@@ -134,3 +184,77 @@ void CalculatorDisplay::MemoryItemChanged(unsigned int indexOfMemory)
         }
     }
 }
+
+void CalculatorDisplay::BeginDisplayTransaction()
+{
+    m_pending = PendingDisplayUpdates{};
+    m_inTransaction = true;
+}
+
+void CalculatorDisplay::EndDisplayTransaction()
+{
+    m_inTransaction = false;
+
+    PendingDisplayUpdates updates = move(m_pending);
+    m_pending = PendingDisplayUpdates{};
+
+    if (!updates.expressionPending && !updates.parenPending
+        && !updates.primaryPending && !updates.errorPending)
+    {
+        return;
+    }
+
+    if (m_dispatcher == nullptr || m_dispatcher->HasThreadAccess)
+    {
+        ApplyUpdates(m_callbackReference, updates);
+        return;
+    }
+
+    // Ended on the engine thread: drain the whole burst in one dispatcher
+    // work item. The weak reference and the snapshot are captured by value,
+    // so nothing here races the next burst or outlives the ViewModel.
+    Platform::WeakReference callbackReference = m_callbackReference;
+    m_dispatcher->RunAsync(
+        CoreDispatcherPriority::Normal,
+        ref new DispatchedHandler([callbackReference, updates]()
+        {
+            ApplyUpdates(callbackReference, updates);
+        }));
+}
+
+// Forward one transaction's settled display state to the ViewModel, in the
+// order the manager's flush would have raised the callbacks.
+void CalculatorDisplay::ApplyUpdates(Platform::WeakReference callbackReference, const PendingDisplayUpdates& updates)
+{
+    auto calcVM = callbackReference.Resolve<ViewModel::StandardCalculatorViewModel>();
+    if (calcVM == nullptr)
+    {
+        return;
+    }
+
+    // One span per drained transaction; with background execution enabled
+    // this is the UI thread's share of a command burst. The local
+    // diagnostics view counts the same transactions.
+    auto displaySpan = TraceLogger::GetInstance().BeginDisplayUpdateActivity();
+    TraceLogger::GetInstance().RecordDisplayUpdate();
+
+    if (updates.expressionPending)
+    {
+        calcVM->SetExpressionDisplay(updates.expressionTokens, updates.expressionCommands);
+    }
+
+    if (updates.parenPending)
+    {
+        calcVM->SetParenthesisCount(updates.parenText);
+    }
+
+    if (updates.primaryPending)
+    {
+        calcVM->SetPrimaryDisplay(updates.primaryValue, updates.primaryIsError);
+    }
+
+    if (updates.errorPending)
+    {
+        calcVM->IsInError = updates.isInError;
+    }
+}
@@ -20,15 +20,44 @@ namespace CalculatorApp
         void SetIsInError(bool isError) override;
         void SetExpressionDisplay(_Inout_ std::shared_ptr<CalculatorVector<std::pair<std::wstring, int>>> const &tokens, _Inout_ std::shared_ptr<CalculatorVector<std::shared_ptr<IExpressionCommand>>> const &commands) override;
         void SetMemorizedNumbers(_In_ const std::vector<std::wstring>& memorizedNumbers) override;
+        void SetMemorizedNumber(_In_ unsigned int indexOfMemory, const std::wstring& memorizedNumber) override;
         void OnHistoryItemAdded(_In_ unsigned int addedItemIndex) override;
         void SetParenDisplayText(_In_ const std::wstring& parenthesisCount) override;
         void OnNoRightParenAdded() override;
         void MaxDigitsReached() override;
         void BinaryOperatorReceived() override;
         void MemoryItemChanged(unsigned int indexOfMemory) override;
+        void BeginDisplayTransaction() override;
+        void EndDisplayTransaction() override;
+
+    private:
+        // The display updates one transaction produced, in flush order. The
+        // snapshot travels into the dispatcher work item by value, so once a
+        // transaction ends the manager is free to start the next burst.
+        struct PendingDisplayUpdates
+        {
+            bool expressionPending = false;
+            std::shared_ptr<CalculatorVector<std::pair<std::wstring, int>>> expressionTokens;
+            std::shared_ptr<CalculatorVector<std::shared_ptr<IExpressionCommand>>> expressionCommands;
+
+            bool parenPending = false;
+            std::wstring parenText;
+
+            bool primaryPending = false;
+            std::wstring primaryValue;
+            bool primaryIsError = false;
+
+            bool errorPending = false;
+            bool isInError = false;
+        };
+
+        static void ApplyUpdates(Platform::WeakReference callbackReference, const PendingDisplayUpdates& updates);
 
     private:
         Platform::WeakReference m_callbackReference;
         Platform::WeakReference m_historyCallbackReference;
+        Windows::UI::Core::CoreDispatcher^ m_dispatcher;
+        bool m_inTransaction = false;
+        PendingDisplayUpdates m_pending;
     };
 }
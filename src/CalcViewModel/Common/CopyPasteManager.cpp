@@ -23,56 +23,415 @@ String^ CopyPasteManager::supportedFormats[] =
 };
 
 constexpr wstring_view c_validCharacterSet{ L"0123456789()+-*/.abcdefABCDEF" };
-// [\s\x85] means white-space characters
-static const wstring c_wspc = L"[\\s\\x85]*";
-static const wstring c_wspcLParens = c_wspc + L"[(]*" + c_wspc;
-static const wstring c_wspcLParenSigned = c_wspc + L"([-+]?[(])*" + c_wspc;
-static const wstring c_wspcRParens = c_wspc + L"[)]*" + c_wspc;
-static const wstring c_signedDecFloat = L"[-+]?\\d*(\\d|[.])\\d*";
-
-// Programmer Mode Integer patterns
-// Support digit separators ` (WinDbg/MASM), ' (C++), and _ (C# and other languages)
-static const wstring c_hexProgrammerChars = L"([a-f]|[A-F]|\\d)+((_|'|`)([a-f]|[A-F]|\\d)+)*";
-static const wstring c_decProgrammerChars = L"\\d+((_|'|`)\\d+)*";
-static const wstring c_octProgrammerChars = L"[0-7]+((_|'|`)[0-7]+)*";
-static const wstring c_binProgrammerChars = L"[0-1]+((_|'|`)[0-1]+)*";
-static const wstring c_uIntSuffixes = L"[uU]?[lL]{0,2}";
-
-// RegEx Patterns used by various modes
-static const array<wregex, 1> standardModePatterns =
-{
-    wregex(c_wspc + c_signedDecFloat + c_wspc)
-};
-static const array<wregex, 2> scientificModePatterns =
+
+// Operand validators used by the various modes. Each function replaces the
+// regex the mode previously compiled and ran (the original pattern is noted
+// above it) with a single left-to-right scan, so validating a large paste is
+// linear instead of a backtracking regex pass per operand.
+
+// The character class [\s\x85] the patterns used for whitespace.
+static bool IsPatternWhitespace(wchar_t ch)
 {
-    wregex(L"(" + c_wspc + L"[-+]?)|(" + c_wspcLParenSigned + L")" + c_signedDecFloat + c_wspcRParens),
-    wregex(L"(" + c_wspc + L"[-+]?)|(" + c_wspcLParenSigned + L")" + c_signedDecFloat + L"[e]([+]|[-])+\\d+" + c_wspcRParens)
-};
-static const array<array<wregex, 5>, 4> programmerModePatterns =
-{ {
-    // Hex numbers like 5F, 4A0C, 0xa9, 0xFFull, 47CDh
+    return ch == L' ' || (ch >= L'\t' && ch <= L'\r') || ch == L'\x85';
+}
+
+static bool IsDecDigit(wchar_t ch)
+{
+    return ch >= L'0' && ch <= L'9';
+}
+
+static bool IsHexDigit(wchar_t ch)
+{
+    return IsDecDigit(ch) || (ch >= L'a' && ch <= L'f') || (ch >= L'A' && ch <= L'F');
+}
+
+static bool IsOctDigit(wchar_t ch)
+{
+    return ch >= L'0' && ch <= L'7';
+}
+
+static bool IsBinDigit(wchar_t ch)
+{
+    return ch == L'0' || ch == L'1';
+}
+
+// Digit separators ` (WinDbg/MASM), ' (C++), and _ (C# and other languages)
+static bool IsDigitGroupSeparator(wchar_t ch)
+{
+    return ch == L'_' || ch == L'\'' || ch == L'`';
+}
+
+static void SkipWhitespace(const wstring& s, size_t& i)
+{
+    while (i < s.size() && IsPatternWhitespace(s[i]))
+    {
+        ++i;
+    }
+}
+
+// [(]*
+static void SkipOpenParens(const wstring& s, size_t& i)
+{
+    while (i < s.size() && s[i] == L'(')
+    {
+        ++i;
+    }
+}
+
+// ([-+]?[(])*
+static void SkipSignedOpenParens(const wstring& s, size_t& i)
+{
+    while (i < s.size())
+    {
+        if (s[i] == L'(')
+        {
+            ++i;
+        }
+        else if ((s[i] == L'+' || s[i] == L'-') && i + 1 < s.size() && s[i + 1] == L'(')
+        {
+            i += 2;
+        }
+        else
+        {
+            break;
+        }
+    }
+}
+
+// [)]*
+static void SkipCloseParens(const wstring& s, size_t& i)
+{
+    while (i < s.size() && s[i] == L')')
+    {
+        ++i;
+    }
+}
+
+// digits+ ((_|'|`) digits+)* for the given digit class
+static bool ScanDigitGroups(const wstring& s, size_t& i, bool (*isDigit)(wchar_t))
+{
+    if (i >= s.size() || !isDigit(s[i]))
+    {
+        return false;
+    }
+
+    while (i < s.size() && isDigit(s[i]))
+    {
+        ++i;
+    }
+
+    while (i < s.size() && IsDigitGroupSeparator(s[i]))
+    {
+        ++i;
+        if (i >= s.size() || !isDigit(s[i]))
+        {
+            return false;
+        }
+        while (i < s.size() && isDigit(s[i]))
+        {
+            ++i;
+        }
+    }
+
+    return true;
+}
+
+// [-+]?\d*(\d|[.])\d* : an optional sign, then at least one character,
+// all digits except for at most one decimal point.
+static bool ScanSignedDecFloat(const wstring& s, size_t& i)
+{
+    if (i < s.size() && (s[i] == L'+' || s[i] == L'-'))
+    {
+        ++i;
+    }
+
+    size_t start = i;
+    bool sawPoint = false;
+    while (i < s.size() && (IsDecDigit(s[i]) || (s[i] == L'.' && !sawPoint)))
+    {
+        sawPoint = sawPoint || s[i] == L'.';
+        ++i;
+    }
+
+    return i > start;
+}
+
+// [uU]?[lL]{0,2} — fully optional, so it always succeeds.
+static void ScanUIntSuffix(const wstring& s, size_t& i)
+{
+    if (i < s.size() && (s[i] == L'u' || s[i] == L'U'))
+    {
+        ++i;
+    }
+
+    for (int count = 0; count < 2 && i < s.size() && (s[i] == L'l' || s[i] == L'L'); ++count)
+    {
+        ++i;
+    }
+}
+
+using PatternValidator = bool (*)(const wstring&);
+
+// ws [-+]?\d*(\d|[.])\d* ws
+static bool MatchStandardOperand(const wstring& operand)
+{
+    size_t i = 0;
+    SkipWhitespace(operand, i);
+    if (!ScanSignedDecFloat(operand, i))
+    {
+        return false;
+    }
+    SkipWhitespace(operand, i);
+    return i == operand.size();
+}
+
+// The degenerate alternative (ws [-+]?) both scientific patterns accept.
+static bool MatchBareSign(const wstring& operand)
+{
+    size_t i = 0;
+    SkipWhitespace(operand, i);
+    if (i < operand.size() && (operand[i] == L'+' || operand[i] == L'-'))
+    {
+        ++i;
+    }
+    return i == operand.size();
+}
+
+// (ws [-+]?) | (ws ([-+]?[(])* ws [-+]?\d*(\d|[.])\d* [exponent] ws [)]* ws)
+// where the exponent, when required, is [e]([+]|[-])+\d+.
+static bool MatchScientificOperand(const wstring& operand, bool requireExponent)
+{
+    if (MatchBareSign(operand))
     {
-        wregex(c_wspcLParens + L"(0[xX])?" + c_hexProgrammerChars + c_uIntSuffixes + c_wspcRParens),
-        wregex(c_wspcLParens + c_hexProgrammerChars + L"[hH]?" + c_wspcRParens)
-    },
-    // Decimal numbers like -145, 145, 0n145, 123ull etc
+        return true;
+    }
+
+    size_t i = 0;
+    SkipWhitespace(operand, i);
+    SkipSignedOpenParens(operand, i);
+    SkipWhitespace(operand, i);
+    if (!ScanSignedDecFloat(operand, i))
     {
-        wregex(c_wspcLParens + L"[-+]?" + c_decProgrammerChars + L"[lL]{0,2}" +c_wspcRParens),
-        wregex(c_wspcLParens + L"(0[nN])?" + c_decProgrammerChars + c_uIntSuffixes + c_wspcRParens)
-    },
-    // Octal numbers like 06, 010, 0t77, 0o77, 077ull etc
+        return false;
+    }
+
+    if (requireExponent)
     {
-        wregex(c_wspcLParens + L"(0[otOT])?" + c_octProgrammerChars + c_uIntSuffixes + c_wspcRParens)
-    },
-    // Binary numbers like 011010110, 0010110, 10101001, 1001b, 0b1001, 0y1001, 0b1001ull
+        if (i >= operand.size() || operand[i] != L'e')
+        {
+            return false;
+        }
+        ++i;
+
+        size_t signStart = i;
+        while (i < operand.size() && (operand[i] == L'+' || operand[i] == L'-'))
+        {
+            ++i;
+        }
+        if (i == signStart)
+        {
+            return false;
+        }
+
+        size_t digitStart = i;
+        while (i < operand.size() && IsDecDigit(operand[i]))
+        {
+            ++i;
+        }
+        if (i == digitStart)
+        {
+            return false;
+        }
+    }
+
+    SkipWhitespace(operand, i);
+    SkipCloseParens(operand, i);
+    SkipWhitespace(operand, i);
+    return i == operand.size();
+}
+
+static bool MatchScientificNumberOperand(const wstring& operand)
+{
+    return MatchScientificOperand(operand, false /*requireExponent*/);
+}
+
+static bool MatchScientificExponentOperand(const wstring& operand)
+{
+    return MatchScientificOperand(operand, true /*requireExponent*/);
+}
+
+// ws [(]* ws <body> ws [)]* ws
+static bool MatchProgrammerOperand(const wstring& operand, bool (*scanBody)(const wstring&, size_t&))
+{
+    size_t i = 0;
+    SkipWhitespace(operand, i);
+    SkipOpenParens(operand, i);
+    SkipWhitespace(operand, i);
+    if (!scanBody(operand, i))
+    {
+        return false;
+    }
+    SkipWhitespace(operand, i);
+    SkipCloseParens(operand, i);
+    SkipWhitespace(operand, i);
+    return i == operand.size();
+}
+
+// (0[prefixChars])? digit-groups uint-suffix, trying the prefixed parse first
+static bool ScanPrefixedInteger(const wstring& s, size_t& i, const wchar_t* prefixChars, bool (*isDigit)(wchar_t))
+{
+    if (i + 1 < s.size() && s[i] == L'0' && wcschr(prefixChars, s[i + 1]) != nullptr)
+    {
+        size_t j = i + 2;
+        if (ScanDigitGroups(s, j, isDigit))
+        {
+            ScanUIntSuffix(s, j);
+            i = j;
+            return true;
+        }
+    }
+
+    if (!ScanDigitGroups(s, i, isDigit))
     {
-        wregex(c_wspcLParens + L"(0[byBY])?" + c_binProgrammerChars + c_uIntSuffixes + c_wspcRParens),
-        wregex(c_wspcLParens + c_binProgrammerChars + L"[bB]?" + c_wspcRParens)
+        return false;
     }
-    } };
-static const array<wregex, 1> unitConverterPatterns =
+    ScanUIntSuffix(s, i);
+    return true;
+}
+
+// Hex numbers like 5F, 4A0C, 0xa9, 0xFFull, 47CDh
+// (0[xX])? hex-groups [uU]?[lL]{0,2}
+static bool MatchHexPrefixedOperand(const wstring& operand)
+{
+    return MatchProgrammerOperand(operand, [](const wstring& s, size_t& i) {
+        return ScanPrefixedInteger(s, i, L"xX", IsHexDigit);
+    });
+}
+
+// hex-groups [hH]?
+static bool MatchHexSuffixedOperand(const wstring& operand)
+{
+    return MatchProgrammerOperand(operand, [](const wstring& s, size_t& i) {
+        if (!ScanDigitGroups(s, i, IsHexDigit))
+        {
+            return false;
+        }
+        if (i < s.size() && (s[i] == L'h' || s[i] == L'H'))
+        {
+            ++i;
+        }
+        return true;
+    });
+}
+
+// Decimal numbers like -145, 145, 0n145, 123ull etc
+// [-+]? dec-groups [lL]{0,2}
+static bool MatchDecSignedOperand(const wstring& operand)
+{
+    return MatchProgrammerOperand(operand, [](const wstring& s, size_t& i) {
+        if (i < s.size() && (s[i] == L'+' || s[i] == L'-'))
+        {
+            ++i;
+        }
+        if (!ScanDigitGroups(s, i, IsDecDigit))
+        {
+            return false;
+        }
+        for (int count = 0; count < 2 && i < s.size() && (s[i] == L'l' || s[i] == L'L'); ++count)
+        {
+            ++i;
+        }
+        return true;
+    });
+}
+
+// (0[nN])? dec-groups [uU]?[lL]{0,2}
+static bool MatchDecPrefixedOperand(const wstring& operand)
+{
+    return MatchProgrammerOperand(operand, [](const wstring& s, size_t& i) {
+        return ScanPrefixedInteger(s, i, L"nN", IsDecDigit);
+    });
+}
+
+// Octal numbers like 06, 010, 0t77, 0o77, 077ull etc
+// (0[otOT])? oct-groups [uU]?[lL]{0,2}
+static bool MatchOctOperand(const wstring& operand)
+{
+    return MatchProgrammerOperand(operand, [](const wstring& s, size_t& i) {
+        return ScanPrefixedInteger(s, i, L"otOT", IsOctDigit);
+    });
+}
+
+// Binary numbers like 011010110, 0010110, 10101001, 1001b, 0b1001, 0y1001, 0b1001ull
+// (0[byBY])? bin-groups [uU]?[lL]{0,2}
+static bool MatchBinPrefixedOperand(const wstring& operand)
+{
+    return MatchProgrammerOperand(operand, [](const wstring& s, size_t& i) {
+        return ScanPrefixedInteger(s, i, L"byBY", IsBinDigit);
+    });
+}
+
+// bin-groups [bB]?
+static bool MatchBinSuffixedOperand(const wstring& operand)
+{
+    return MatchProgrammerOperand(operand, [](const wstring& s, size_t& i) {
+        if (!ScanDigitGroups(s, i, IsBinDigit))
+        {
+            return false;
+        }
+        if (i < s.size() && (s[i] == L'b' || s[i] == L'B'))
+        {
+            ++i;
+        }
+        return true;
+    });
+}
+
+// ws [-+]?\d*[.]?\d* ws — every component optional, so the empty string matches.
+static bool MatchConverterOperand(const wstring& operand)
+{
+    size_t i = 0;
+    SkipWhitespace(operand, i);
+    if (i < operand.size() && (operand[i] == L'+' || operand[i] == L'-'))
+    {
+        ++i;
+    }
+    while (i < operand.size() && IsDecDigit(operand[i]))
+    {
+        ++i;
+    }
+    if (i < operand.size() && operand[i] == L'.')
+    {
+        ++i;
+    }
+    while (i < operand.size() && IsDecDigit(operand[i]))
+    {
+        ++i;
+    }
+    SkipWhitespace(operand, i);
+    return i == operand.size();
+}
+
+// Validators used by various modes
+static const array<PatternValidator, 1> standardModePatterns =
+{
+    MatchStandardOperand
+};
+static const array<PatternValidator, 2> scientificModePatterns =
+{
+    MatchScientificNumberOperand,
+    MatchScientificExponentOperand
+};
+static const array<array<PatternValidator, 2>, 4> programmerModePatterns =
+{ {
+    { MatchHexPrefixedOperand, MatchHexSuffixedOperand },
+    { MatchDecSignedOperand, MatchDecPrefixedOperand },
+    { MatchOctOperand, nullptr },
+    { MatchBinPrefixedOperand, MatchBinSuffixedOperand }
+} };
+static const array<PatternValidator, 1> unitConverterPatterns =
 {
-    wregex(c_wspc + L"[-+]?\\d*[.]?\\d*" + c_wspc)
+    MatchConverterOperand
 };
 
 void CopyPasteManager::CopyToClipboard(String^ stringToCopy)
@@ -269,7 +628,7 @@ bool CopyPasteManager::ExpressionRegExMatch(vector<wstring> operands, ViewMode m
     }
 
     bool expMatched = true;
-    vector<wregex> patterns{};
+    vector<PatternValidator> patterns{};
 
     pair<size_t, uint64_t> operandLimits = GetMaxOperandLengthAndValue(mode, modeType, programmerNumberBase, bitLengthType);
     size_t maxOperandLength = operandLimits.first;
@@ -296,9 +655,9 @@ bool CopyPasteManager::ExpressionRegExMatch(vector<wstring> operands, ViewMode m
     {
         // Each operand only needs to match one of the available patterns.
         bool operandMatched = false;
-        for (const wregex& pattern : patterns)
+        for (const PatternValidator& pattern : patterns)
         {
-            operandMatched = operandMatched || regex_match(operand, pattern);
+            operandMatched = operandMatched || (pattern != nullptr && pattern(operand));
         }
 
         if (operandMatched)
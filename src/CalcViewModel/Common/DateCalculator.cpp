@@ -9,17 +9,99 @@ using namespace Windows::Foundation;
 using namespace Windows::Globalization;
 using namespace CalculatorApp::Common::DateCalculation;
 
+// Civil-calendar day arithmetic for the Gregorian fast path. A "day number"
+// here is the count of days since 1970-01-01 (negative before it); the
+// algorithms are the well-known proleptic-Gregorian conversions built around
+// eras of 400 years (146097 days).
+
+// Number of days between 1601-01-01 (the DateTime epoch) and 1970-01-01.
+static constexpr long long c_epochOffsetDays = 134774;
+
+// The last year the Windows.Globalization.Calendar supports; the arithmetic
+// path reports failure past it just as the Calendar path throws.
+static constexpr int c_maxCalendarYear = 9999;
+
+static bool IsGregorianLeapYear(int year)
+{
+    return year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+}
+
+static int LastDayOfGregorianMonth(int year, int month)
+{
+    static constexpr int daysInMonth[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    return (month == 2 && IsGregorianLeapYear(year)) ? 29 : daysInMonth[month - 1];
+}
+
+static long long DayNumberFromCivilDate(int year, int month, int day)
+{
+    year -= month <= 2;
+    const long long era = (year >= 0 ? year : year - 399) / 400;
+    const int yearOfEra = static_cast<int>(year - era * 400);
+    const int dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    const int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+static void CivilDateFromDayNumber(long long dayNumber, int& year, int& month, int& day)
+{
+    dayNumber += 719468;
+    const long long era = (dayNumber >= 0 ? dayNumber : dayNumber - 146096) / 146097;
+    const int dayOfEra = static_cast<int>(dayNumber - era * 146097);
+    const int yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    const int dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    const int monthIndex = (5 * dayOfYear + 2) / 153;
+    day = dayOfYear - (153 * monthIndex + 2) / 5 + 1;
+    month = monthIndex + (monthIndex < 10 ? 3 : -9);
+    year = static_cast<int>(yearOfEra + era * 400) + (month <= 2);
+}
+
+// Splits a DateTime into its civil date and the time of day, and rebuilds one.
+static void CivilDateFromDateTime(DateTime date, int& year, int& month, int& day, long long& timeOfDayTicks)
+{
+    long long days = date.UniversalTime / static_cast<long long>(c_day);
+    timeOfDayTicks = date.UniversalTime - days * static_cast<long long>(c_day);
+    if (timeOfDayTicks < 0)
+    {
+        days -= 1;
+        timeOfDayTicks += static_cast<long long>(c_day);
+    }
+    CivilDateFromDayNumber(days - c_epochOffsetDays, year, month, day);
+}
+
+static DateTime DateTimeFromCivilDate(int year, int month, int day, long long timeOfDayTicks)
+{
+    DateTime result;
+    result.UniversalTime = (DayNumberFromCivilDate(year, month, day) + c_epochOffsetDays) * static_cast<long long>(c_day) + timeOfDayTicks;
+    return result;
+}
+
+// Adds months the way Calendar::AddMonths does for Gregorian dates: the day
+// is clamped to the length of the resulting month.
+static void AddGregorianMonths(int& year, int& month, int& day, int difference)
+{
+    const long long totalMonths = static_cast<long long>(year) * 12 + (month - 1) + difference;
+    year = static_cast<int>((totalMonths >= 0 ? totalMonths : totalMonths - 11) / 12);
+    month = static_cast<int>(totalMonths - static_cast<long long>(year) * 12) + 1;
+    day = std::min(day, LastDayOfGregorianMonth(year, month));
+}
+
 DateCalculationEngine::DateCalculationEngine(_In_ String^ calendarIdentifier)
 {
     m_calendar = ref new Calendar();
     m_calendar->ChangeTimeZone("UTC");
     m_calendar->ChangeCalendarSystem(calendarIdentifier);
+    m_isGregorianCalendar = (m_calendar->GetCalendarSystem() == CalendarIdentifiers::Gregorian);
 }
 
 // Adding Duration to a Date
 // Returns: True if function succeeds to calculate the date else returns False
 bool DateCalculationEngine::AddDuration(_In_ DateTime startDate, _In_ const DateDifference& duration, _Out_ DateTime *endDate)
 {
+    if (m_isGregorianCalendar)
+    {
+        return AddGregorianDuration(startDate, duration, endDate);
+    }
+
     try
     {
         m_calendar->SetDateTime(startDate);
@@ -52,6 +134,11 @@ bool DateCalculationEngine::AddDuration(_In_ DateTime startDate, _In_ const Date
 // Returns: True if function succeeds to calculate the date else returns False
 bool DateCalculationEngine::SubtractDuration(_In_ DateTime startDate, _In_ const DateDifference& duration, _Out_ DateTime *endDate)
 {
+    if (m_isGregorianCalendar)
+    {
+        return SubtractGregorianDuration(startDate, duration, endDate);
+    }
+
     // For Subtract the Algorithm is different than Add. Here the smaller units are subtracted first
     // and then the larger units.
     try
@@ -83,9 +170,89 @@ bool DateCalculationEngine::SubtractDuration(_In_ DateTime startDate, _In_ const
     return (endDate->UniversalTime >= 0);
 }
 
+// Gregorian counterpart of AddDuration: the same add order and day clamping
+// as the Calendar calls, in plain integer arithmetic.
+bool DateCalculationEngine::AddGregorianDuration(_In_ DateTime startDate, _In_ const DateDifference& duration, _Out_ DateTime *endDate)
+{
+    int year, month, day;
+    long long timeOfDayTicks;
+    CivilDateFromDateTime(startDate, year, month, day, timeOfDayTicks);
+
+    if (duration.year != 0)
+    {
+        year += duration.year;
+        day = std::min(day, LastDayOfGregorianMonth(year, month));
+    }
+    if (duration.month != 0)
+    {
+        AddGregorianMonths(year, month, day, duration.month);
+    }
+
+    DateTime result = DateTimeFromCivilDate(year, month, day, timeOfDayTicks);
+    if (duration.day != 0)
+    {
+        result.UniversalTime += static_cast<long long>(duration.day) * static_cast<long long>(c_day);
+    }
+
+    // Mirror the Calendar's supported range: it throws past year 9999 and
+    // cannot represent dates before the DateTime epoch.
+    CivilDateFromDateTime(result, year, month, day, timeOfDayTicks);
+    if (result.UniversalTime < 0 || year > c_maxCalendarYear)
+    {
+        return false;
+    }
+
+    *endDate = result;
+    return true;
+}
+
+// Gregorian counterpart of SubtractDuration; smaller units first, like the
+// Calendar path.
+bool DateCalculationEngine::SubtractGregorianDuration(_In_ DateTime startDate, _In_ const DateDifference& duration, _Out_ DateTime *endDate)
+{
+    DateTime pivot = startDate;
+    if (duration.day != 0)
+    {
+        pivot.UniversalTime -= static_cast<long long>(duration.day) * static_cast<long long>(c_day);
+        if (pivot.UniversalTime < 0)
+        {
+            return false;
+        }
+    }
+
+    int year, month, day;
+    long long timeOfDayTicks;
+    CivilDateFromDateTime(pivot, year, month, day, timeOfDayTicks);
+
+    if (duration.month != 0)
+    {
+        AddGregorianMonths(year, month, day, -duration.month);
+    }
+    if (duration.year != 0)
+    {
+        year -= duration.year;
+        day = std::min(day, LastDayOfGregorianMonth(year, month));
+    }
+
+    DateTime result = DateTimeFromCivilDate(year, month, day, timeOfDayTicks);
+    if (result.UniversalTime < 0 || year > c_maxCalendarYear)
+    {
+        return false;
+    }
+
+    *endDate = result;
+    return true;
+}
+
 // Calculate the difference between two dates
 void DateCalculationEngine::GetDateDifference(_In_ DateTime date1, _In_ DateTime date2, _In_ DateUnit outputFormat, _Out_ DateDifference *difference)
 {
+    if (m_isGregorianCalendar)
+    {
+        GetGregorianDateDifference(date1, date2, outputFormat, difference);
+        return;
+    }
+
     DateTime startDate;
     DateTime endDate;
     DateTime pivotDate;
@@ -200,6 +367,106 @@ void DateCalculationEngine::GetDateDifference(_In_ DateTime date1, _In_ DateTime
     difference->day = differenceInDates[3];
 }
 
+// Gregorian counterpart of GetDateDifference: the whole year/month/week/day
+// breakdown in one forward pass over civil dates.  Each requested unit takes
+// the largest count whose single jump from the running pivot stays within a
+// whole day of the end date -- the same truncated-day acceptance the probing
+// loop converges on -- so the breakdown costs a handful of integer
+// conversions instead of per-unit pivot-and-probe rounds.
+void DateCalculationEngine::GetGregorianDateDifference(_In_ DateTime date1, _In_ DateTime date2, _In_ DateUnit outputFormat, _Out_ DateDifference *difference)
+{
+    DateTime startDate = (date1.UniversalTime < date2.UniversalTime) ? date1 : date2;
+    DateTime endDate = (date1.UniversalTime < date2.UniversalTime) ? date2 : date1;
+
+    int pivotYear, pivotMonth, pivotDay;
+    long long timeOfDayTicks;
+    CivilDateFromDateTime(startDate, pivotYear, pivotMonth, pivotDay, timeOfDayTicks);
+
+    int endYear, endMonth, endDay;
+    long long endTimeOfDayTicks;
+    CivilDateFromDateTime(endDate, endYear, endMonth, endDay, endTimeOfDayTicks);
+
+    // A pivot is acceptable while its truncated day difference to the end
+    // date stays non-negative; in ticks that means less than one whole day
+    // past the end.
+    auto fits = [&](DateTime pivot)
+    {
+        return (endDate.UniversalTime - pivot.UniversalTime) > -static_cast<long long>(c_day);
+    };
+
+    UINT years = 0;
+    if (static_cast<int>(outputFormat & DateUnit::Year))
+    {
+        auto yearJump = [&](int count)
+        {
+            int year = pivotYear + count;
+            int day = std::min(pivotDay, LastDayOfGregorianMonth(year, pivotMonth));
+            return DateTimeFromCivilDate(year, pivotMonth, day, timeOfDayTicks);
+        };
+
+        int count = std::max(0, endYear - pivotYear);
+        while (count > 0 && !fits(yearJump(count)))
+        {
+            count--;
+        }
+        while (pivotYear + count < c_maxCalendarYear && fits(yearJump(count + 1)))
+        {
+            count++;
+        }
+
+        years = static_cast<UINT>(count);
+        pivotYear += count;
+        pivotDay = std::min(pivotDay, LastDayOfGregorianMonth(pivotYear, pivotMonth));
+    }
+
+    UINT months = 0;
+    if (static_cast<int>(outputFormat & DateUnit::Month))
+    {
+        auto monthJump = [&](int count)
+        {
+            int year = pivotYear;
+            int month = pivotMonth;
+            int day = pivotDay;
+            AddGregorianMonths(year, month, day, count);
+            return DateTimeFromCivilDate(year, month, day, timeOfDayTicks);
+        };
+
+        int count = std::max(0, (endYear * 12 + endMonth) - (pivotYear * 12 + pivotMonth));
+        while (count > 0 && !fits(monthJump(count)))
+        {
+            count--;
+        }
+        while (pivotYear * 12 + pivotMonth + count < c_maxCalendarYear * 12 && fits(monthJump(count + 1)))
+        {
+            count++;
+        }
+
+        months = static_cast<UINT>(count);
+        AddGregorianMonths(pivotYear, pivotMonth, pivotDay, count);
+    }
+
+    // Whatever the larger units left behind resolves directly: weeks are a
+    // whole-day division, days the remainder.
+    long long remainingDays =
+        (endDate.UniversalTime - DateTimeFromCivilDate(pivotYear, pivotMonth, pivotDay, timeOfDayTicks).UniversalTime) / static_cast<long long>(c_day);
+    if (remainingDays < 0)
+    {
+        remainingDays = 0;
+    }
+
+    UINT weeks = 0;
+    if (static_cast<int>(outputFormat & DateUnit::Week))
+    {
+        weeks = static_cast<UINT>(remainingDays / c_daysInWeek);
+        remainingDays -= static_cast<long long>(weeks) * c_daysInWeek;
+    }
+
+    difference->year = years;
+    difference->month = months;
+    difference->week = weeks;
+    difference->day = static_cast<int>(remainingDays);
+}
+
 
 // Private Methods
 
@@ -215,6 +482,15 @@ int DateCalculationEngine::GetDifferenceInDays(DateTime date1, DateTime date2)
 // Returns true if successful, false otherwise.
 bool DateCalculationEngine::TryGetCalendarDaysInMonth(_In_ DateTime date, _Out_ UINT& daysInMonth)
 {
+    if (m_isGregorianCalendar)
+    {
+        int year, month, day;
+        long long timeOfDayTicks;
+        CivilDateFromDateTime(date, year, month, day, timeOfDayTicks);
+        daysInMonth = static_cast<UINT>(LastDayOfGregorianMonth(year, month));
+        return true;
+    }
+
     bool result = false;
     m_calendar->SetDateTime(date);
 
@@ -233,6 +509,15 @@ bool DateCalculationEngine::TryGetCalendarDaysInMonth(_In_ DateTime date, _Out_
 // Returns true if successful, false otherwise.
 bool DateCalculationEngine::TryGetCalendarDaysInYear(_In_ DateTime date, _Out_ UINT& daysInYear)
 {
+    if (m_isGregorianCalendar)
+    {
+        int year, month, day;
+        long long timeOfDayTicks;
+        CivilDateFromDateTime(date, year, month, day, timeOfDayTicks);
+        daysInYear = IsGregorianLeapYear(year) ? 366 : 365;
+        return true;
+    }
+
     bool result = false;
     UINT days = 0;
 
@@ -274,6 +559,31 @@ bool DateCalculationEngine::TryGetCalendarDaysInYear(_In_ DateTime date, _Out_ U
 // Adds/Subtracts certain value for a particular date unit
 DateTime DateCalculationEngine::AdjustCalendarDate(Windows::Foundation::DateTime date, DateUnit dateUnit, int difference)
 {
+    if (m_isGregorianCalendar)
+    {
+        int year, month, day;
+        long long timeOfDayTicks;
+        CivilDateFromDateTime(date, year, month, day, timeOfDayTicks);
+
+        switch (dateUnit)
+        {
+            case DateUnit::Year:
+                year += difference;
+                day = std::min(day, LastDayOfGregorianMonth(year, month));
+                break;
+            case DateUnit::Month:
+                AddGregorianMonths(year, month, day, difference);
+                break;
+            case DateUnit::Week:
+            {
+                DateTime result = date;
+                result.UniversalTime += static_cast<long long>(difference) * 7 * static_cast<long long>(c_day);
+                return result;
+            }
+        }
+
+        return DateTimeFromCivilDate(year, month, day, timeOfDayTicks);
+    }
 
     m_calendar->SetDateTime(date);
 
@@ -51,11 +51,19 @@ namespace CalculatorApp
                 // Private Variables
                 Windows::Globalization::Calendar^ m_calendar;
 
+                // True when the engine was constructed for the Gregorian
+                // calendar; date arithmetic is then done directly on day
+                // numbers instead of through the Calendar object.
+                bool m_isGregorianCalendar = false;
+
                 // Private Methods
                 int GetDifferenceInDays(Windows::Foundation::DateTime date1, Windows::Foundation::DateTime date2);
                 bool TryGetCalendarDaysInMonth(_In_ Windows::Foundation::DateTime date, _Out_ UINT& daysInMonth);
                 bool TryGetCalendarDaysInYear(_In_ Windows::Foundation::DateTime date, _Out_ UINT& daysInYear);
                 Windows::Foundation::DateTime AdjustCalendarDate(Windows::Foundation::DateTime date, DateUnit dateUnit, int difference);
+                bool AddGregorianDuration(_In_ Windows::Foundation::DateTime startDate, _In_ const DateDifference& duration, _Out_ Windows::Foundation::DateTime *endDate);
+                bool SubtractGregorianDuration(_In_ Windows::Foundation::DateTime startDate, _In_ const DateDifference& duration, _Out_ Windows::Foundation::DateTime *endDate);
+                void GetGregorianDateDifference(_In_ Windows::Foundation::DateTime date1, _In_ Windows::Foundation::DateTime date2, _In_ DateUnit outputFormat, _Out_ DateDifference *difference);
             };
         }
     }
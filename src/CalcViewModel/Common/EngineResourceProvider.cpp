@@ -3,20 +3,15 @@
 
 #include "pch.h"
 #include "EngineResourceProvider.h"
+#include "Common/AppResourceProvider.h"
 #include "Common/LocalizationSettings.h"
 
 using namespace CalculatorApp::Common;
 using namespace Platform;
-using namespace Windows::ApplicationModel::Resources;
 using namespace std;
 
 namespace CalculatorApp
 {
-    EngineResourceProvider::EngineResourceProvider()
-    {
-        m_resLoader = ResourceLoader::GetForViewIndependentUse("CEngineStrings");
-    }
-
     wstring EngineResourceProvider::GetCEngineString(const wstring& id)
     {
         const auto& localizationSettings = LocalizationSettings::GetInstance();
@@ -43,8 +38,9 @@ namespace CalculatorApp
             return numberGroupingString;
         }
 
-        StringReference idRef(id.c_str());
-        String^ str = m_resLoader->GetString(idRef);
+        // Engine strings come from the process-wide cache; the engine asks
+        // for the same ids on every engine init and history append.
+        String^ str = AppResourceProvider::GetInstance().GetCEngineString(StringReference(id.c_str()));
         return str->Begin();
     }
 }
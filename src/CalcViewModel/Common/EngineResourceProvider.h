@@ -10,10 +10,6 @@ namespace CalculatorApp
     class EngineResourceProvider : public CalculationManager::IResourceProvider
     {
     public:
-        EngineResourceProvider();
         virtual std::wstring GetCEngineString(const std::wstring& id) override;
-
-    private:
-        Windows::ApplicationModel::Resources::ResourceLoader^ m_resLoader;
     };
 }
@@ -47,10 +47,27 @@ COpndCommand CommandDeserializer::DeserializeOperand()
     std::shared_ptr<CalculatorVector<int>> cmdVector = std::make_shared<CalculatorVector<int>>();
     auto cmdVectorSize = m_dataReader->ReadUInt32();
 
-    for (unsigned int j = 0; j < cmdVectorSize; ++j)
+    if (cmdVectorSize > m_dataReader->UnconsumedBufferLength / sizeof(int32_t))
     {
-        int eachOpndcmd = m_dataReader->ReadInt32();
-        cmdVector->Append(eachOpndcmd);
+        throw ref new Platform::Exception(E_INVALIDARG, ref new Platform::String(L"Operand command count exceeds the stream"));
+    }
+
+    if (cmdVectorSize > 0)
+    {
+        // Pull the whole digit list out of the stream in one read and
+        // decode the big-endian values here, instead of one WinRT call
+        // per digit.
+        auto bytes = ref new Platform::Array<unsigned char>(cmdVectorSize * 4u);
+        m_dataReader->ReadBytes(bytes);
+        cmdVector->Reserve(cmdVectorSize);
+        for (unsigned int j = 0; j < cmdVectorSize; ++j)
+        {
+            uint32_t value = (static_cast<uint32_t>(bytes[j * 4]) << 24)
+                | (static_cast<uint32_t>(bytes[j * 4 + 1]) << 16)
+                | (static_cast<uint32_t>(bytes[j * 4 + 2]) << 8)
+                | static_cast<uint32_t>(bytes[j * 4 + 3]);
+            cmdVector->Append(static_cast<int>(value));
+        }
     }
 
     return COpndCommand(cmdVector, fNegative, fDecimal, fSciFmt);
@@ -1,4 +1,4 @@
-﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
 #include "pch.h"
@@ -7,50 +7,77 @@
 using namespace CalculatorApp::Common;
 using namespace Windows::Storage::Streams;
 
-SerializeCommandVisitor::SerializeCommandVisitor(_In_ DataWriter^ dataWriter) :m_dataWriter(dataWriter)
+SerializeCommandVisitor::SerializeCommandVisitor()
 {
+    m_buffer.reserve(256);
+}
+
+void SerializeCommandVisitor::QueueCommand(_In_ IExpressionCommand& cmd)
+{
+    AppendInt32(static_cast<int32_t>(cmd.GetCommandType()));
+    cmd.Accept(*this);
+}
+
+void SerializeCommandVisitor::FlushTo(_In_ DataWriter^ dataWriter)
+{
+    if (!m_buffer.empty())
+    {
+        dataWriter->WriteBytes(Platform::ArrayReference<unsigned char>(m_buffer.data(), static_cast<unsigned int>(m_buffer.size())));
+    }
+}
+
+void SerializeCommandVisitor::AppendBoolean(bool value)
+{
+    m_buffer.push_back(value ? 1 : 0);
+}
+
+void SerializeCommandVisitor::AppendInt32(int32_t value)
+{
+    AppendUInt32(static_cast<uint32_t>(value));
+}
+
+void SerializeCommandVisitor::AppendUInt32(uint32_t value)
+{
+    // DataWriter's default byte order; keeps the stream identical to the
+    // per-field WriteUInt32 calls this replaces.
+    m_buffer.push_back(static_cast<unsigned char>(value >> 24));
+    m_buffer.push_back(static_cast<unsigned char>(value >> 16));
+    m_buffer.push_back(static_cast<unsigned char>(value >> 8));
+    m_buffer.push_back(static_cast<unsigned char>(value));
 }
 
 void SerializeCommandVisitor::Visit(_In_ COpndCommand &opndCmd)
 {
-    m_dataWriter->WriteBoolean(opndCmd.IsNegative());
-    m_dataWriter->WriteBoolean(opndCmd.IsDecimalPresent());
-    m_dataWriter->WriteBoolean(opndCmd.IsSciFmt());
+    AppendBoolean(opndCmd.IsNegative());
+    AppendBoolean(opndCmd.IsDecimalPresent());
+    AppendBoolean(opndCmd.IsSciFmt());
 
     auto opndCmds = opndCmd.GetCommands();
-    unsigned int opndCmdSize;
-    opndCmds->GetSize(&opndCmdSize);
-    m_dataWriter->WriteUInt32(opndCmdSize);
-    for (unsigned int j = 0; j < opndCmdSize; ++j)
+    AppendUInt32(static_cast<unsigned int>(opndCmds->size()));
+    for (int eachOpndcmd : *opndCmds)
     {
-        int eachOpndcmd;
-        opndCmds->GetAt(j, &eachOpndcmd);
-        m_dataWriter->WriteInt32(eachOpndcmd);
+        AppendInt32(eachOpndcmd);
     }
 }
 
 void SerializeCommandVisitor::Visit(_In_ CUnaryCommand &unaryCmd)
 {
     auto cmds = unaryCmd.GetCommands();
-    unsigned int cmdSize;
-    cmds->GetSize(&cmdSize);
-    m_dataWriter->WriteUInt32(cmdSize);
-    for (unsigned int j = 0; j < cmdSize; ++j)
+    AppendUInt32(static_cast<unsigned int>(cmds->size()));
+    for (int eachOpndcmd : *cmds)
     {
-        int eachOpndcmd;
-        cmds->GetAt(j, &eachOpndcmd);
-        m_dataWriter->WriteInt32(eachOpndcmd);
+        AppendInt32(eachOpndcmd);
     }
 }
 
 void SerializeCommandVisitor::Visit(_In_ CBinaryCommand &binaryCmd)
 {
     int cmd = binaryCmd.GetCommand();
-    m_dataWriter->WriteInt32(cmd);
+    AppendInt32(cmd);
 }
 
 void SerializeCommandVisitor::Visit(_In_ CParentheses &paraCmd)
 {
     int parenthesisCmd = paraCmd.GetCommand();
-    m_dataWriter->WriteInt32(parenthesisCmd);
+    AppendInt32(parenthesisCmd);
 }
@@ -9,10 +9,22 @@ namespace CalculatorApp
 {
     namespace Common
     {
+        // Serializes expression commands into an in-memory buffer that is
+        // handed to the DataWriter in a single call, instead of one WinRT
+        // write per field. The buffer encoding matches the DataWriter
+        // defaults (big-endian integers, one byte per boolean), so the
+        // produced stream is unchanged and CommandDeserializer reads it
+        // back as before.
         class SerializeCommandVisitor : public ISerializeCommandVisitor
         {
         public:
-            SerializeCommandVisitor(_In_ Windows::Storage::Streams::DataWriter^ dataWriter);
+            SerializeCommandVisitor();
+
+            // Queues one command - its type tag followed by its fields -
+            // into the buffer.
+            void QueueCommand(_In_ IExpressionCommand& cmd);
+            // Writes everything queued so far with a single DataWriter call.
+            void FlushTo(_In_ Windows::Storage::Streams::DataWriter^ dataWriter);
 
             void Visit(_In_ COpndCommand &opndCmd);
             void Visit(_In_ CUnaryCommand &unaryCmd);
@@ -20,7 +32,11 @@ namespace CalculatorApp
             void Visit(_In_ CParentheses &paraCmd);
 
         private:
-            Windows::Storage::Streams::DataWriter^ m_dataWriter;
+            void AppendBoolean(bool value);
+            void AppendInt32(int32_t value);
+            void AppendUInt32(uint32_t value);
+
+            std::vector<unsigned char> m_buffer;
         };
     }
 }
@@ -5,6 +5,7 @@
 #include "KeyboardShortcutManager.h"
 #include "AppResourceProvider.h"
 #include "ApplicationViewModel.h"
+#include "CalculatorButtonPressedEventArgs.h"
 #include "LocalizationSettings.h"
 
 using namespace Concurrency;
@@ -34,14 +35,126 @@ DEPENDENCY_PROPERTY_INITIALIZATION(KeyboardShortcutManager, VirtualKeyControlShi
 DEPENDENCY_PROPERTY_INITIALIZATION(KeyboardShortcutManager, VirtualKeyInverseChord);
 DEPENDENCY_PROPERTY_INITIALIZATION(KeyboardShortcutManager, VirtualKeyControlInverseChord);
 
-static multimap<int, multimap<wchar_t, WeakReference>> s_CharacterForButtons;
-static multimap<int, multimap<MyVirtualKey, WeakReference>> s_VirtualKeysForButtons;
-static multimap<int, multimap<MyVirtualKey, WeakReference>> s_VirtualKeyControlChordsForButtons;
-static multimap<int, multimap<MyVirtualKey, WeakReference>> s_VirtualKeyShiftChordsForButtons;
-static multimap<int, multimap<MyVirtualKey, WeakReference>> s_VirtualKeyAltChordsForButtons;
-static multimap<int, multimap<MyVirtualKey, WeakReference>> s_VirtualKeyControlShiftChordsForButtons;
-static multimap<int, multimap<MyVirtualKey, WeakReference>> s_VirtualKeyInverseChordsForButtons;
-static multimap<int, multimap<MyVirtualKey, WeakReference>> s_VirtualKeyControlInverseChordsForButtons;
+// The chord planes a shortcut can be registered against. The plane is folded
+// into the lookup key together with the key code, so resolving a keystroke is
+// a single probe instead of an equal_range over a multimap per plane.
+enum class ShortcutChord : unsigned int
+{
+    Character,
+    VirtualKey,
+    VirtualKeyControl,
+    VirtualKeyShift,
+    VirtualKeyAlt,
+    VirtualKeyControlShift,
+    VirtualKeyInverse,
+    VirtualKeyControlInverse
+};
+
+// Both key spaces fit in 16 bits: MyVirtualKey values stop at 165 and
+// characters arrive as wchar_t.
+static constexpr unsigned int MakeShortcutKey(ShortcutChord chord, unsigned int keyCode)
+{
+    return (static_cast<unsigned int>(chord) << 16) | (keyCode & 0xFFFF);
+}
+
+// Flat open-addressing hash from (chord, key code) to the buttons registered
+// for that shortcut. One table exists per window; the slot array is contiguous
+// so a lookup touches a single cache line in the common case.
+class ShortcutLookupTable
+{
+public:
+    ShortcutLookupTable() : m_slots(c_initialSlotCount), m_usedSlots(0)
+    {
+    }
+
+    void Insert(unsigned int key, WeakReference target)
+    {
+        // Grow at 50% load so probe chains stay short.
+        if ((m_usedSlots + 1) * 2 >= m_slots.size())
+        {
+            Rehash(m_slots.size() * 2);
+        }
+
+        Slot& slot = FindSlot(m_slots, key);
+        if (slot.key == c_emptySlotKey)
+        {
+            slot.key = key;
+            m_usedSlots++;
+        }
+        slot.targets.push_back(target);
+    }
+
+    void Erase(unsigned int key)
+    {
+        Slot& slot = FindSlot(m_slots, key);
+        if (slot.key != c_emptySlotKey)
+        {
+            // Keep the slot occupied so probe chains through it stay intact.
+            slot.targets.clear();
+        }
+    }
+
+    const std::vector<WeakReference>* Find(unsigned int key) const
+    {
+        const Slot& slot = FindSlot(const_cast<std::vector<Slot>&>(m_slots), key);
+        return (slot.key != c_emptySlotKey && !slot.targets.empty()) ? &slot.targets : nullptr;
+    }
+
+    bool HasKey(unsigned int key) const
+    {
+        return Find(key) != nullptr;
+    }
+
+private:
+    static constexpr unsigned int c_emptySlotKey = 0xFFFFFFFF;
+    static constexpr size_t c_initialSlotCount = 128; // power of two
+
+    struct Slot
+    {
+        unsigned int key = c_emptySlotKey;
+        std::vector<WeakReference> targets;
+    };
+
+    static Slot& FindSlot(std::vector<Slot>& slots, unsigned int key)
+    {
+        // Fibonacci hashing scatters the folded chord/key values well even
+        // though they occupy only the low bits.
+        size_t index = (key * 2654435761u) & (slots.size() - 1);
+        while (slots[index].key != c_emptySlotKey && slots[index].key != key)
+        {
+            index = (index + 1) & (slots.size() - 1);
+        }
+        return slots[index];
+    }
+
+    void Rehash(size_t newSlotCount)
+    {
+        std::vector<Slot> newSlots(newSlotCount);
+        for (Slot& slot : m_slots)
+        {
+            if (slot.key != c_emptySlotKey && !slot.targets.empty())
+            {
+                Slot& newSlot = FindSlot(newSlots, slot.key);
+                newSlot.key = slot.key;
+                newSlot.targets = std::move(slot.targets);
+            }
+        }
+        m_slots = std::move(newSlots);
+        m_usedSlots = 0;
+        for (const Slot& slot : m_slots)
+        {
+            if (slot.key != c_emptySlotKey)
+            {
+                m_usedSlots++;
+            }
+        }
+    }
+
+    std::vector<Slot> m_slots;
+    size_t m_usedSlots;
+};
+
+static map<int, ShortcutLookupTable> s_ShortcutsForWindows;
 
 static multimap<int, bool> s_ShiftKeyPressed;
 static multimap<int, bool> s_ControlKeyPressed;
@@ -50,26 +163,22 @@ static multimap<int, bool> s_IsDropDownOpen;
 
 static reader_writer_lock s_keyboardShortcutMapLock;
 
+// One pending typematic burst per window: the repeats a held key delivered
+// while a flush was already scheduled, waiting to execute as one batched
+// command run. Guarded by s_keyboardShortcutMapLock like the maps above.
+struct RepeatBurst
+{
+    WeakReference button;
+    unsigned int count = 0;
+    bool flushScheduled = false;
+};
+
+static map<int, RepeatBurst> s_repeatBursts;
+
 namespace CalculatorApp
 {
     namespace Common
     {
-        // Lights up all of the buttons in the given range
-        // The range is defined by a pair of iterators
-        template <typename T>
-        void LightUpButtons(const T& buttons)
-        {
-            auto iterator = buttons.first;
-            for (; iterator != buttons.second; ++iterator)
-            {
-                auto button = iterator->second.Resolve<ButtonBase>();
-                if (button && button->IsEnabled)
-                {
-                    LightUpButton(button);
-                }
-            }
-        }
-
         void LightUpButton(ButtonBase^ button)
         {
             // If the button is a toggle button then we don't need
@@ -111,21 +220,20 @@ namespace CalculatorApp
             timer->Start();
         }
 
-        // Looks for the first button reference that it can resolve
-        // and execute its command.
-        // NOTE: It is assumed that all buttons associated with a particular
-        // key have the same command
-        template <typename T>
-        void RunFirstEnabledButtonCommand(const T& buttons)
+        // Lights up all of the buttons registered for the resolved shortcut
+        void LightUpButtons(const std::vector<WeakReference>* buttons)
         {
-            auto buttonIterator = buttons.first;
-            for (; buttonIterator != buttons.second; ++buttonIterator)
+            if (buttons == nullptr)
+            {
+                return;
+            }
+
+            for (const WeakReference& buttonReference : *buttons)
             {
-                auto button = buttonIterator->second.Resolve<ButtonBase>();
+                auto button = buttonReference.Resolve<ButtonBase>();
                 if (button && button->IsEnabled)
                 {
-                    RunButtonCommand(button);
-                    break;
+                    LightUpButton(button);
                 }
             }
         }
@@ -156,6 +264,148 @@ namespace CalculatorApp
                 }
             }
         }
+
+        // Looks for the first button reference that it can resolve
+        // and execute its command.
+        // NOTE: It is assumed that all buttons associated with a particular
+        // key have the same command
+        void RunFirstEnabledButtonCommand(const std::vector<WeakReference>* buttons)
+        {
+            if (buttons == nullptr)
+            {
+                return;
+            }
+
+            for (const WeakReference& buttonReference : *buttons)
+            {
+                auto button = buttonReference.Resolve<ButtonBase>();
+                if (button && button->IsEnabled)
+                {
+                    RunButtonCommand(button);
+                    break;
+                }
+            }
+        }
+
+        // A repeat burst only forms for keys whose button command lands on
+        // a StandardCalculatorViewModel digit or backspace operation; only
+        // those have a batched engine run behind them.
+        StandardCalculatorViewModel^ GetRepeatBurstTarget(ButtonBase^ button, NumbersAndOperatorsEnum* operation)
+        {
+            auto viewModel = dynamic_cast<StandardCalculatorViewModel^>(button->DataContext);
+            if (viewModel == nullptr)
+            {
+                return nullptr;
+            }
+
+            auto op = CalculatorButtonPressedEventArgs::GetOperationFromCommandParameter(button->CommandParameter);
+            bool isDigit = op >= NumbersAndOperatorsEnum::Zero && op <= NumbersAndOperatorsEnum::F;
+            if (!isDigit && op != NumbersAndOperatorsEnum::Backspace)
+            {
+                return nullptr;
+            }
+
+            *operation = op;
+            return viewModel;
+        }
+
+        // Sends the repeats accumulated for this window as one batched run.
+        // Falls back to replaying them through the button command when the
+        // view model declines (error state, expression editing), so held
+        // keys behave identically there, just without the coalescing.
+        void FlushRepeatBurst(int viewId)
+        {
+            unsigned int count = 0;
+            WeakReference buttonReference;
+            {
+                // Writer lock for the static maps
+                reader_writer_lock::scoped_lock lock(s_keyboardShortcutMapLock);
+
+                auto burst = s_repeatBursts.find(viewId);
+                if (burst == s_repeatBursts.end() || burst->second.count == 0)
+                {
+                    return;
+                }
+
+                count = burst->second.count;
+                buttonReference = burst->second.button;
+                burst->second.count = 0;
+                burst->second.flushScheduled = false;
+            }
+
+            auto button = buttonReference.Resolve<ButtonBase>();
+            if (button == nullptr || !button->IsEnabled)
+            {
+                return;
+            }
+
+            NumbersAndOperatorsEnum operation;
+            auto viewModel = GetRepeatBurstTarget(button, &operation);
+            if (viewModel != nullptr && viewModel->TrySendRepeatBurst(operation, count))
+            {
+                return;
+            }
+
+            for (unsigned int i = 0; i < count; i++)
+            {
+                RunButtonCommand(button);
+            }
+        }
+
+        // Accumulates a typematic repeat instead of executing it. The flush
+        // runs at Low dispatcher priority, which sorts after any input
+        // already queued: while the engine keeps up each burst holds a
+        // single repeat, and when a long operand makes the per-keystroke
+        // refresh slower than the repeat rate the queued repeats collapse
+        // into one batched run instead of falling behind.
+        bool TryCoalesceRepeat(int viewId, const std::vector<WeakReference>* buttons, CorePhysicalKeyStatus keyStatus)
+        {
+            if (!keyStatus.WasKeyDown || buttons == nullptr)
+            {
+                return false;
+            }
+
+            ButtonBase^ button = nullptr;
+            for (const WeakReference& buttonReference : *buttons)
+            {
+                auto resolved = buttonReference.Resolve<ButtonBase>();
+                if (resolved && resolved->IsEnabled)
+                {
+                    button = resolved;
+                    break;
+                }
+            }
+
+            NumbersAndOperatorsEnum operation;
+            if (button == nullptr || GetRepeatBurstTarget(button, &operation) == nullptr)
+            {
+                return false;
+            }
+
+            bool scheduleFlush = false;
+            {
+                // Writer lock for the static maps
+                reader_writer_lock::scoped_lock lock(s_keyboardShortcutMapLock);
+
+                RepeatBurst& burst = s_repeatBursts[viewId];
+                burst.button = WeakReference(button);
+                burst.count += (keyStatus.RepeatCount > 1) ? keyStatus.RepeatCount : 1;
+                if (!burst.flushScheduled)
+                {
+                    burst.flushScheduled = true;
+                    scheduleFlush = true;
+                }
+            }
+
+            if (scheduleFlush)
+            {
+                Window::Current->CoreWindow->Dispatcher->RunAsync(
+                    CoreDispatcherPriority::Low,
+                    ref new DispatchedHandler([viewId]() { FlushRepeatBurst(viewId); }));
+            }
+
+            return true;
+        }
     }
 }
 
@@ -216,40 +466,23 @@ void KeyboardShortcutManager::OnCharacterPropertyChanged(
     auto button = safe_cast<ButtonBase^>(target);
 
     int viewId = Utils::GetWindowId();
-    auto iterViewMap = s_CharacterForButtons.find(viewId);
+    ShortcutLookupTable& table = s_ShortcutsForWindows[viewId];
 
-    if (iterViewMap != s_CharacterForButtons.end())
+    if (oldValue)
     {
-        if (oldValue)
-        {
-            iterViewMap->second.erase(oldValue->Data()[0]);
-        }
-
-        if (newValue)
-        {
-            if (newValue == L".")
-            {
-                wchar_t decSep = LocalizationSettings::GetInstance().GetDecimalSeparator();
-                iterViewMap->second.insert(std::make_pair(decSep, WeakReference(button)));
-            }
-            else
-            {
-                iterViewMap->second.insert(std::make_pair(newValue->Data()[0], WeakReference(button)));
-            }
-        }
+        table.Erase(MakeShortcutKey(ShortcutChord::Character, oldValue->Data()[0]));
     }
-    else
-    {
-        s_CharacterForButtons.insert(std::make_pair(viewId, std::multimap<wchar_t, WeakReference>()));
 
+    if (newValue)
+    {
         if (newValue == L".")
         {
             wchar_t decSep = LocalizationSettings::GetInstance().GetDecimalSeparator();
-            s_CharacterForButtons.find(viewId)->second.insert(std::make_pair(decSep, WeakReference(button)));
+            table.Insert(MakeShortcutKey(ShortcutChord::Character, decSep), WeakReference(button));
         }
         else
         {
-            s_CharacterForButtons.find(viewId)->second.insert(std::make_pair(newValue->Data()[0], WeakReference(button)));
+            table.Insert(MakeShortcutKey(ShortcutChord::Character, newValue->Data()[0]), WeakReference(button));
         }
     }
 }
@@ -265,19 +498,9 @@ void KeyboardShortcutManager::OnVirtualKeyPropertyChanged(
     auto button = static_cast<ButtonBase^>(target);
 
     int viewId = Utils::GetWindowId();
-    auto iterViewMap = s_VirtualKeysForButtons.find(viewId);
 
-    // Check if the View Id has already been registered
-    if (iterViewMap != s_VirtualKeysForButtons.end())
-    {
-        iterViewMap->second.insert(std::make_pair(newValue, WeakReference(button)));
-    }
-    else
-    {
-        // If the View Id is not already registered, then register it and make the entry
-        s_VirtualKeysForButtons.insert(std::make_pair(viewId, std::multimap<MyVirtualKey, WeakReference>()));
-        s_VirtualKeysForButtons.find(viewId)->second.insert(std::make_pair(newValue, WeakReference(button)));
-    }
+    // Registering the View Id if needed and making the entry is a single operation on the flat table
+    s_ShortcutsForWindows[viewId].Insert(MakeShortcutKey(ShortcutChord::VirtualKey, static_cast<unsigned int>(newValue)), WeakReference(button));
 }
 
 void KeyboardShortcutManager::OnVirtualKeyControlChordPropertyChanged(
@@ -297,19 +520,7 @@ void KeyboardShortcutManager::OnVirtualKeyControlChordPropertyChanged(
     }
 
     int viewId = Utils::GetWindowId();
-    auto iterViewMap = s_VirtualKeyControlChordsForButtons.find(viewId);
-
-    // Check if the View Id has already been registered
-    if (iterViewMap != s_VirtualKeyControlChordsForButtons.end())
-    {
-        iterViewMap->second.insert(std::make_pair(newValue, WeakReference(control)));
-    }
-    else
-    {
-        // If the View Id is not already registered, then register it and make the entry
-        s_VirtualKeyControlChordsForButtons.insert(std::make_pair(viewId, std::multimap<MyVirtualKey, WeakReference>()));
-        s_VirtualKeyControlChordsForButtons.find(viewId)->second.insert(std::make_pair(newValue, WeakReference(control)));
-    }
+    s_ShortcutsForWindows[viewId].Insert(MakeShortcutKey(ShortcutChord::VirtualKeyControl, static_cast<unsigned int>(newValue)), WeakReference(control));
 }
 
 void KeyboardShortcutManager::OnVirtualKeyShiftChordPropertyChanged(
@@ -323,19 +534,7 @@ void KeyboardShortcutManager::OnVirtualKeyShiftChordPropertyChanged(
     auto button = safe_cast<ButtonBase^>(target);
 
     int viewId = Utils::GetWindowId();
-    auto iterViewMap = s_VirtualKeyShiftChordsForButtons.find(viewId);
-
-    // Check if the View Id has already been registered
-    if (iterViewMap != s_VirtualKeyShiftChordsForButtons.end())
-    {
-        iterViewMap->second.insert(std::make_pair(newValue, WeakReference(button)));
-    }
-    else
-    {
-        // If the View Id is not already registered, then register it and make the entry
-        s_VirtualKeyShiftChordsForButtons.insert(std::make_pair(viewId, std::multimap<MyVirtualKey, WeakReference>()));
-        s_VirtualKeyShiftChordsForButtons.find(viewId)->second.insert(std::make_pair(newValue, WeakReference(button)));
-    }
+    s_ShortcutsForWindows[viewId].Insert(MakeShortcutKey(ShortcutChord::VirtualKeyShift, static_cast<unsigned int>(newValue)), WeakReference(button));
 }
 
 void KeyboardShortcutManager::OnVirtualKeyAltChordPropertyChanged(
@@ -349,19 +548,7 @@ void KeyboardShortcutManager::OnVirtualKeyAltChordPropertyChanged(
     MUXC::NavigationView^ navView = safe_cast<MUXC::NavigationView^>(target);
 
     int viewId = Utils::GetWindowId();
-    auto iterViewMap = s_VirtualKeyAltChordsForButtons.find(viewId);
-
-    // Check if the View Id has already been registered
-    if (iterViewMap != s_VirtualKeyAltChordsForButtons.end())
-    {
-        iterViewMap->second.insert(std::make_pair(newValue, WeakReference(navView)));
-    }
-    else
-    {
-        // If the View Id is not already registered, then register it and make the entry
-        s_VirtualKeyAltChordsForButtons.insert(std::make_pair(viewId, std::multimap<MyVirtualKey, WeakReference>()));
-        s_VirtualKeyAltChordsForButtons.find(viewId)->second.insert(std::make_pair(newValue, WeakReference(navView)));
-    }
+    s_ShortcutsForWindows[viewId].Insert(MakeShortcutKey(ShortcutChord::VirtualKeyAlt, static_cast<unsigned int>(newValue)), WeakReference(navView));
 }
 
 void KeyboardShortcutManager::OnVirtualKeyControlShiftChordPropertyChanged(
@@ -375,19 +562,7 @@ void KeyboardShortcutManager::OnVirtualKeyControlShiftChordPropertyChanged(
     auto button = safe_cast<ButtonBase^>(target);
 
     int viewId = Utils::GetWindowId();
-    auto iterViewMap = s_VirtualKeyControlShiftChordsForButtons.find(viewId);
-
-    // Check if the View Id has already been registered
-    if (iterViewMap != s_VirtualKeyControlShiftChordsForButtons.end())
-    {
-        iterViewMap->second.insert(std::make_pair(newValue, WeakReference(button)));
-    }
-    else
-    {
-        // If the View Id is not already registered, then register it and make the entry
-        s_VirtualKeyControlShiftChordsForButtons.insert(std::make_pair(viewId, std::multimap<MyVirtualKey, WeakReference>()));
-        s_VirtualKeyControlShiftChordsForButtons.find(viewId)->second.insert(std::make_pair(newValue, WeakReference(button)));
-    }
+    s_ShortcutsForWindows[viewId].Insert(MakeShortcutKey(ShortcutChord::VirtualKeyControlShift, static_cast<unsigned int>(newValue)), WeakReference(button));
 }
 
 void KeyboardShortcutManager::OnVirtualKeyInverseChordPropertyChanged(
@@ -401,19 +576,7 @@ void KeyboardShortcutManager::OnVirtualKeyInverseChordPropertyChanged(
     auto button = safe_cast<ButtonBase^>(target);
 
     int viewId = Utils::GetWindowId();
-    auto iterViewMap = s_VirtualKeyInverseChordsForButtons.find(viewId);
-
-    // Check if the View Id has already been registered
-    if (iterViewMap != s_VirtualKeyInverseChordsForButtons.end())
-    {
-        iterViewMap->second.insert(std::make_pair(newValue, WeakReference(button)));
-    }
-    else
-    {
-        // If the View Id is not already registered, then register it and make the entry
-        s_VirtualKeyInverseChordsForButtons.insert(std::make_pair(viewId, std::multimap<MyVirtualKey, WeakReference>()));
-        s_VirtualKeyInverseChordsForButtons.find(viewId)->second.insert(std::make_pair(newValue, WeakReference(button)));
-    }
+    s_ShortcutsForWindows[viewId].Insert(MakeShortcutKey(ShortcutChord::VirtualKeyInverse, static_cast<unsigned int>(newValue)), WeakReference(button));
 }
 
 void KeyboardShortcutManager::OnVirtualKeyControlInverseChordPropertyChanged(
@@ -427,19 +590,7 @@ void KeyboardShortcutManager::OnVirtualKeyControlInverseChordPropertyChanged(
     auto button = safe_cast<ButtonBase^>(target);
 
     int viewId = Utils::GetWindowId();
-    auto iterViewMap = s_VirtualKeyControlInverseChordsForButtons.find(viewId);
-
-    // Check if the View Id has already been registered
-    if (iterViewMap != s_VirtualKeyControlInverseChordsForButtons.end())
-    {
-        iterViewMap->second.insert(std::make_pair(newValue, WeakReference(button)));
-    }
-    else
-    {
-        // If the View Id is not already registered, then register it and make the entry
-        s_VirtualKeyControlInverseChordsForButtons.insert(std::make_pair(viewId, std::multimap<MyVirtualKey, WeakReference>()));
-        s_VirtualKeyControlInverseChordsForButtons.find(viewId)->second.insert(std::make_pair(newValue, WeakReference(button)));
-    }
+    s_ShortcutsForWindows[viewId].Insert(MakeShortcutKey(ShortcutChord::VirtualKeyControlInverse, static_cast<unsigned int>(newValue)), WeakReference(button));
 }
 
 // In the three event handlers below we will not mark the event as handled
@@ -455,69 +606,69 @@ void KeyboardShortcutManager::OnCharacterReceivedHandler(CoreWindow^ sender, Cha
         if (currentHonorShortcuts->second)
         {
             wchar_t character = static_cast<wchar_t>(args->KeyCode);
-            auto buttons = s_CharacterForButtons.find(viewId)->second.equal_range(character);
+            auto iterViewMap = s_ShortcutsForWindows.find(viewId);
+            if (iterViewMap != s_ShortcutsForWindows.end())
+            {
+                auto buttons = iterViewMap->second.Find(MakeShortcutKey(ShortcutChord::Character, character));
+
+                if (TryCoalesceRepeat(viewId, buttons, args->KeyStatus))
+                {
+                    return;
+                }
 
-            RunFirstEnabledButtonCommand(buttons);
+                // A fresh keystroke must not overtake repeats still waiting
+                // for their flush; drain them so command order matches key
+                // order.
+                FlushRepeatBurst(viewId);
 
-            LightUpButtons(buttons);
+                RunFirstEnabledButtonCommand(buttons);
+
+                LightUpButtons(buttons);
+            }
         }
     }
 }
 
-const std::multimap<MyVirtualKey, WeakReference>& GetCurrentKeyDictionary(MyVirtualKey key, bool altPressed = false)
+// Picks the chord plane the current modifier state dispatches the key to.
+// The plane is folded into the lookup key, so after this decision resolving
+// the shortcut is a single probe of the window's flat table.
+ShortcutChord GetCurrentShortcutChord(const ShortcutLookupTable& table, MyVirtualKey key, bool altPressed = false)
 {
     int viewId = Utils::GetWindowId();
 
     if (altPressed)
     {
-        return s_VirtualKeyAltChordsForButtons.find(viewId)->second;
+        return ShortcutChord::VirtualKeyAlt;
     }
     else if ((s_ShiftKeyPressed.find(viewId)->second) && ((Window::Current->CoreWindow->GetKeyState(VirtualKey::Control) & CoreVirtualKeyStates::Down) == CoreVirtualKeyStates::Down))
     {
-        return s_VirtualKeyControlShiftChordsForButtons.find(viewId)->second;
+        return ShortcutChord::VirtualKeyControlShift;
     }
     else if (s_ShiftKeyPressed.find(viewId)->second)
     {
-        return s_VirtualKeyShiftChordsForButtons.find(viewId)->second;
+        return ShortcutChord::VirtualKeyShift;
     }
     else if (s_ShiftButtonChecked.find(viewId)->second)
     {
-        if ((Window::Current->CoreWindow->GetKeyState(VirtualKey::Control) & CoreVirtualKeyStates::Down) == CoreVirtualKeyStates::Down)
+        if (table.HasKey(MakeShortcutKey(ShortcutChord::VirtualKeyControlInverse, static_cast<unsigned int>(key))))
         {
-            auto iterViewMap = s_VirtualKeyControlInverseChordsForButtons.find(viewId);
-            if (iterViewMap != s_VirtualKeyControlInverseChordsForButtons.end())
+            if ((Window::Current->CoreWindow->GetKeyState(VirtualKey::Control) & CoreVirtualKeyStates::Down) == CoreVirtualKeyStates::Down)
             {
-                for (auto iterator = iterViewMap->second.begin(); iterator != iterViewMap->second.end(); ++iterator)
-                {
-                    if (key == iterator->first)
-                    {
-                        return s_VirtualKeyControlInverseChordsForButtons.find(viewId)->second;
-                    }
-                }
+                return ShortcutChord::VirtualKeyControlInverse;
             }
-        }
-        else
-        {
-            auto iterViewMap = s_VirtualKeyControlInverseChordsForButtons.find(viewId);
-            if (iterViewMap != s_VirtualKeyControlInverseChordsForButtons.end())
+            else
             {
-                for (auto iterator = iterViewMap->second.begin(); iterator != iterViewMap->second.end(); ++iterator)
-                {
-                    if (key == iterator->first)
-                    {
-                        return s_VirtualKeyInverseChordsForButtons.find(viewId)->second;
-                    }
-                }
+                return ShortcutChord::VirtualKeyInverse;
             }
         }
     }
     if ((Window::Current->CoreWindow->GetKeyState(VirtualKey::Control) & CoreVirtualKeyStates::Down) == CoreVirtualKeyStates::Down)
     {
-        return s_VirtualKeyControlChordsForButtons.find(viewId)->second;
+        return ShortcutChord::VirtualKeyControl;
     }
     else
     {
-        return s_VirtualKeysForButtons.find(viewId)->second;
+        return ShortcutChord::VirtualKey;
     }
 }
 
@@ -540,9 +691,14 @@ void KeyboardShortcutManager::OnKeyDownHandler(CoreWindow^ sender, KeyEventArgs^
             isControlKeyPressed &&
             !isShiftKeyPressed)
         {
-            const auto& lookupMap = GetCurrentKeyDictionary(static_cast<MyVirtualKey>(key));
-            auto buttons = lookupMap.equal_range(static_cast<MyVirtualKey>(key));
-            auto navView = buttons.first->second.Resolve<MUXC::NavigationView>();
+            const ShortcutLookupTable& lookupTable = s_ShortcutsForWindows.find(viewId)->second;
+            auto chord = GetCurrentShortcutChord(lookupTable, static_cast<MyVirtualKey>(key));
+            auto buttons = lookupTable.Find(MakeShortcutKey(chord, static_cast<unsigned int>(key)));
+            if (buttons == nullptr)
+            {
+                return;
+            }
+            auto navView = buttons->front().Resolve<MUXC::NavigationView>();
             auto appViewModel = safe_cast<ApplicationViewModel^>(navView->DataContext);
             appViewModel->Mode = ViewMode::Date;
             auto categoryName = AppResourceProvider::GetInstance().GetResourceString(L"DateCalculationModeText");
@@ -604,8 +760,9 @@ void KeyboardShortcutManager::OnKeyDownHandler(CoreWindow^ sender, KeyEventArgs^
             return;
         }
 
-        const auto& lookupMap = GetCurrentKeyDictionary(static_cast<MyVirtualKey>(key));
-        auto buttons = lookupMap.equal_range(static_cast<MyVirtualKey>(key));
+        const ShortcutLookupTable& lookupTable = s_ShortcutsForWindows.find(viewId)->second;
+        auto chord = GetCurrentShortcutChord(lookupTable, static_cast<MyVirtualKey>(key));
+        auto buttons = lookupTable.Find(MakeShortcutKey(chord, static_cast<unsigned int>(key)));
 
         auto currentIsDropDownOpen = s_IsDropDownOpen.find(viewId);
 
@@ -613,6 +770,16 @@ void KeyboardShortcutManager::OnKeyDownHandler(CoreWindow^ sender, KeyEventArgs^
         {
             if (currentHonorShortcuts->second)
             {
+                if (TryCoalesceRepeat(viewId, buttons, args->KeyStatus))
+                {
+                    return;
+                }
+
+                // A fresh keystroke must not overtake repeats still waiting
+                // for their flush; drain them so command order matches key
+                // order.
+                FlushRepeatBurst(viewId);
+
                 RunFirstEnabledButtonCommand(buttons);
 
                 // Ctrl+C and Ctrl+V shifts focus to some button because of which enter doesn't work after copy/paste. So don't shift focus if Ctrl+C or Ctrl+V is pressed.
@@ -678,30 +845,34 @@ void KeyboardShortcutManager::OnAcceleratorKeyActivated(CoreDispatcher^, Acceler
             return;
         }
 
-        const auto& lookupMap = GetCurrentKeyDictionary(static_cast<MyVirtualKey>(key), altPressed);
-        auto listItems = lookupMap.equal_range(static_cast<MyVirtualKey>(key));
-        for (auto listIterator = listItems.first; listIterator != listItems.second; ++listIterator)
+        const ShortcutLookupTable& lookupTable = s_ShortcutsForWindows.find(Utils::GetWindowId())->second;
+        auto chord = GetCurrentShortcutChord(lookupTable, static_cast<MyVirtualKey>(key), altPressed);
+        auto listItems = lookupTable.Find(MakeShortcutKey(chord, static_cast<unsigned int>(key)));
+        if (listItems != nullptr)
         {
-            auto item = listIterator->second.Resolve<MUXC::NavigationView>();
-            if (item != nullptr)
+            for (const WeakReference& itemReference : *listItems)
             {
-                auto navView = safe_cast<MUXC::NavigationView^> (item);
-
-                auto menuItems = static_cast<IObservableVector<Object^>^>(navView->MenuItemsSource);
-                if (menuItems != nullptr)
+                auto item = itemReference.Resolve<MUXC::NavigationView>();
+                if (item != nullptr)
                 {
-                    auto vm = safe_cast<ApplicationViewModel^>(navView->DataContext);
-                    if (nullptr != vm)
+                    auto navView = safe_cast<MUXC::NavigationView^> (item);
+
+                    auto menuItems = static_cast<IObservableVector<Object^>^>(navView->MenuItemsSource);
+                    if (menuItems != nullptr)
                     {
-                        ViewMode toMode = NavCategory::GetViewModeForVirtualKey(static_cast<MyVirtualKey>(key));
-                        if (NavCategory::IsValidViewMode(toMode))
+                        auto vm = safe_cast<ApplicationViewModel^>(navView->DataContext);
+                        if (nullptr != vm)
                         {
-                            vm->Mode = toMode;
-                            navView->SelectedItem = menuItems->GetAt(NavCategory::GetFlatIndex(toMode));
+                            ViewMode toMode = NavCategory::GetViewModeForVirtualKey(static_cast<MyVirtualKey>(key));
+                            if (NavCategory::IsValidViewMode(toMode))
+                            {
+                                vm->Mode = toMode;
+                                navView->SelectedItem = menuItems->GetAt(NavCategory::GetFlatIndex(toMode));
+                            }
                         }
                     }
+                    break;
                 }
-                break;
             }
         }
     }
@@ -799,44 +970,9 @@ void KeyboardShortcutManager::RegisterNewAppViewId()
     int appViewId = Utils::GetWindowId();
 
     // Check if the View Id has already been registered
-    if (s_CharacterForButtons.find(appViewId) == s_CharacterForButtons.end())
-    {
-        s_CharacterForButtons.insert(std::make_pair(appViewId, std::multimap<wchar_t, WeakReference>()));
-    }
-
-    if (s_VirtualKeysForButtons.find(appViewId) == s_VirtualKeysForButtons.end())
-    {
-        s_VirtualKeysForButtons.insert(std::make_pair(appViewId, std::multimap<MyVirtualKey, WeakReference>()));
-    }
-
-    if (s_VirtualKeyControlChordsForButtons.find(appViewId) == s_VirtualKeyControlChordsForButtons.end())
+    if (s_ShortcutsForWindows.find(appViewId) == s_ShortcutsForWindows.end())
     {
-        s_VirtualKeyControlChordsForButtons.insert(std::make_pair(appViewId, std::multimap<MyVirtualKey, WeakReference>()));
-    }
-
-    if (s_VirtualKeyShiftChordsForButtons.find(appViewId) == s_VirtualKeyShiftChordsForButtons.end())
-    {
-        s_VirtualKeyShiftChordsForButtons.insert(std::make_pair(appViewId, std::multimap<MyVirtualKey, WeakReference>()));
-    }
-
-    if (s_VirtualKeyAltChordsForButtons.find(appViewId) == s_VirtualKeyAltChordsForButtons.end())
-    {
-        s_VirtualKeyAltChordsForButtons.insert(std::make_pair(appViewId, std::multimap<MyVirtualKey, WeakReference>()));
-    }
-
-    if (s_VirtualKeyControlShiftChordsForButtons.find(appViewId) == s_VirtualKeyControlShiftChordsForButtons.end())
-    {
-        s_VirtualKeyControlShiftChordsForButtons.insert(std::make_pair(appViewId, std::multimap<MyVirtualKey, WeakReference>()));
-    }
-
-    if (s_VirtualKeyInverseChordsForButtons.find(appViewId) == s_VirtualKeyInverseChordsForButtons.end())
-    {
-        s_VirtualKeyInverseChordsForButtons.insert(std::make_pair(appViewId, std::multimap<MyVirtualKey, WeakReference>()));
-    }
-
-    if (s_VirtualKeyControlInverseChordsForButtons.find(appViewId) == s_VirtualKeyControlInverseChordsForButtons.end())
-    {
-        s_VirtualKeyControlInverseChordsForButtons.insert(std::make_pair(appViewId, std::multimap<MyVirtualKey, WeakReference>()));
+        s_ShortcutsForWindows.insert(std::make_pair(appViewId, ShortcutLookupTable()));
     }
 
     s_ShiftKeyPressed.insert(std::make_pair(appViewId, false));
@@ -855,15 +991,7 @@ void KeyboardShortcutManager::OnWindowClosed(int viewId)
     // Writer lock for the static maps
     reader_writer_lock::scoped_lock lock(s_keyboardShortcutMapLock);
 
-    s_CharacterForButtons.erase(viewId);
-
-    s_VirtualKeysForButtons.erase(viewId);
-    s_VirtualKeyControlChordsForButtons.erase(viewId);
-    s_VirtualKeyShiftChordsForButtons.erase(viewId);
-    s_VirtualKeyAltChordsForButtons.erase(viewId);
-    s_VirtualKeyControlShiftChordsForButtons.erase(viewId);
-    s_VirtualKeyInverseChordsForButtons.erase(viewId);
-    s_VirtualKeyControlInverseChordsForButtons.erase(viewId);
+    s_ShortcutsForWindows.erase(viewId);
 
     s_ShiftKeyPressed.erase(viewId);
     s_ControlKeyPressed.erase(viewId);
@@ -874,4 +1002,5 @@ void KeyboardShortcutManager::OnWindowClosed(int viewId)
     s_fHonorShortcuts.erase(viewId);
     s_fHandledEnter.erase(viewId);
     s_AboutFlyout.erase(viewId);
+    s_repeatBursts.erase(viewId);
 }
@@ -0,0 +1,91 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "pch.h"
+#include "LaunchTimeline.h"
+#include "Common/TraceLogger.h"
+
+#include <chrono>
+#include <mutex>
+
+using namespace CalculatorApp;
+using namespace std;
+using namespace std::chrono;
+
+namespace
+{
+    // The XAML host loads this module before any authored code runs, so
+    // steady_clock at static initialization is close enough to process
+    // start for phase attribution.
+    const steady_clock::time_point s_moduleLoad = steady_clock::now();
+
+    constexpr size_t s_maxPhases = 16;
+
+    struct PhaseRecord
+    {
+        const wchar_t* name;
+        uint64_t microsecondsFromStart;
+    };
+
+    mutex s_timelineMutex;
+    PhaseRecord s_phases[s_maxPhases];
+    size_t s_phaseCount = 0;
+    bool s_emitted = false;
+}
+
+void LaunchTimeline::Record(const wchar_t* phaseName)
+{
+    // Take the timestamp before the lock so contention never skews it.
+    auto microsecondsFromStart = static_cast<uint64_t>(duration_cast<microseconds>(steady_clock::now() - s_moduleLoad).count());
+
+    lock_guard<mutex> lock(s_timelineMutex);
+    if (s_emitted || s_phaseCount == s_maxPhases)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < s_phaseCount; i++)
+    {
+        if (wcscmp(s_phases[i].name, phaseName) == 0)
+        {
+            return;
+        }
+    }
+
+    s_phases[s_phaseCount++] = PhaseRecord{ phaseName, microsecondsFromStart };
+}
+
+void LaunchTimeline::EmitOnce()
+{
+    vector<pair<wstring, uint64_t>> phases;
+    {
+        lock_guard<mutex> lock(s_timelineMutex);
+        if (s_emitted)
+        {
+            return;
+        }
+        s_emitted = true;
+
+        phases.reserve(s_phaseCount);
+        for (size_t i = 0; i < s_phaseCount; i++)
+        {
+            phases.emplace_back(s_phases[i].name, s_phases[i].microsecondsFromStart);
+        }
+    }
+
+    TraceLogger::GetInstance().LogLaunchTimeline(phases);
+}
+
+vector<pair<wstring, uint64_t>> LaunchTimeline::Snapshot()
+{
+    vector<pair<wstring, uint64_t>> phases;
+
+    lock_guard<mutex> lock(s_timelineMutex);
+    phases.reserve(s_phaseCount);
+    for (size_t i = 0; i < s_phaseCount; i++)
+    {
+        phases.emplace_back(s_phases[i].name, s_phases[i].microsecondsFromStart);
+    }
+
+    return phases;
+}
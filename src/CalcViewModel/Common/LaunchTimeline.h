@@ -0,0 +1,26 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+namespace CalculatorApp
+{
+    // Named phase markers on the cold-start path, timestamped against
+    // module load, emitted as one LaunchTimeline trace event once the
+    // window is interactive. Record keeps only the first occurrence of a
+    // phase name, so markers on re-entrant paths (a second window, a
+    // resume) cost a lookup and change nothing.
+    class LaunchTimeline
+    {
+    public:
+        static void Record(const wchar_t* phaseName);
+        static void EmitOnce();
+
+        // The phases recorded so far, for the in-app diagnostics view;
+        // available whether or not the trace event has been emitted.
+        static std::vector<std::pair<std::wstring, uint64_t>> Snapshot();
+
+    private:
+        LaunchTimeline() = default;
+    };
+}
@@ -85,6 +85,27 @@ LocalizationService::LocalizationService()
     }
 
     m_fontGroup = ref new LanguageFontGroup(m_language);
+
+    // Resolve the language font data once per language right here.
+    // FontFamily objects are shareable between controls, so everything
+    // styled later is served from these cached values instead of another
+    // round trip through Windows.Globalization.Fonts.
+    if (m_overrideFontApiValues)
+    {
+        m_uiTextFontFamily = ref new FontFamily(m_fontFamilyOverride);
+        m_uiCaptionFontFamily = m_uiTextFontFamily;
+        m_uiTextFontScaleFactor = m_uiTextFontScaleFactorOverride;
+        m_uiCaptionFontScaleFactor = m_uiCaptionFontScaleFactorOverride;
+    }
+    else
+    {
+        LanguageFont^ uiTextFont = m_fontGroup->UITextFont;
+        LanguageFont^ uiCaptionFont = m_fontGroup->UICaptionFont;
+        m_uiTextFontFamily = ref new FontFamily(uiTextFont->FontFamily);
+        m_uiCaptionFontFamily = ref new FontFamily(uiCaptionFont->FontFamily);
+        m_uiTextFontScaleFactor = uiTextFont->ScaleFactor;
+        m_uiCaptionFontScaleFactor = uiCaptionFont->ScaleFactor;
+    }
 }
 
 FontWeight LocalizationService::ParseFontWeight(String^ fontWeight)
@@ -165,13 +186,30 @@ bool LocalizationService::GetOverrideFontApiValues()
 
 FontFamily^ LocalizationService::GetLanguageFontFamilyForType(LanguageFontType fontType)
 {
-    if (m_overrideFontApiValues)
+    switch (fontType)
     {
-        return ref new FontFamily(m_fontFamilyOverride);
+    case LanguageFontType::UIText:
+        return m_uiTextFontFamily;
+    case LanguageFontType::UICaption:
+        return m_uiCaptionFontFamily;
+    default:
+        throw std::invalid_argument("fontType");
     }
-    else
+}
+
+// Scale factor for the cached language font, valid whether or not the
+// API values are overridden; expressed in percent like the LanguageFont
+// values it mirrors.
+double LocalizationService::GetFontScaleFactor(LanguageFontType fontType)
+{
+    switch (fontType)
     {
-        return ref new FontFamily(GetLanguageFont(fontType)->FontFamily);
+    case LanguageFontType::UIText:
+        return m_uiTextFontScaleFactor;
+    case LanguageFontType::UICaption:
+        return m_uiCaptionFontScaleFactor;
+    default:
+        throw invalid_argument("Invalid argument: fontType");
     }
 }
 
@@ -235,27 +273,21 @@ void LocalizationService::OnFontSizePropertyChanged(DependencyObject^ target, do
 
 void LocalizationService::UpdateFontFamilyAndSize(DependencyObject^ target)
 {
-    FontFamily^ fontFamily;
-    FontWeight fontWeight;
-    bool fOverrideFontWeight = false;
-    double scaleFactor;
-
     auto service = LocalizationService::GetInstance();
     auto fontType = LocalizationService::GetFontType(target);
 
+    // Everything comes from the per-language cache, so applying the
+    // override to a page full of controls resolves no fonts.
+    FontFamily^ fontFamily = service->GetLanguageFontFamilyForType(fontType);
+    double scaleFactor = service->GetFontScaleFactor(fontType) / 100.0;
+    FontWeight fontWeight;
+    bool fOverrideFontWeight = false;
+
     if (service->GetOverrideFontApiValues())
     {
-        fontFamily = ref new FontFamily(service->GetFontFamilyOverride());
-        scaleFactor = service->GetFontScaleFactorOverride(fontType) / 100.0;
         fontWeight = service->GetFontWeightOverride();
         fOverrideFontWeight = true;
     }
-    else
-    {
-        auto languageFont = service->GetLanguageFont(fontType);
-        fontFamily = ref new FontFamily(languageFont->FontFamily);
-        scaleFactor = languageFont->ScaleFactor / 100.0;
-    }
 
     double sizeToUse = LocalizationService::GetFontSize(target) * scaleFactor;
 
@@ -338,14 +370,65 @@ void LocalizationService::UpdateFontFamilyAndSize(DependencyObject^ target)
     }
 }
 
+// Formatter construction is an expensive WinRT activation that walks locale
+// data, and the date and number display paths request formatters repeatedly.
+// DateTimeFormatters are immutable once constructed, so they are pooled here
+// keyed by their construction inputs, together with the validated language
+// identifier list. Every acquisition re-validates the regional signature, so
+// settings changed through intl.cpl while the app is suspended empty the pool.
+static reader_writer_lock s_formatterCacheLock;
+static wstring s_formatterCacheSignature;
+static unordered_map<wstring, DateTimeFormatter^> s_dateTimeFormatterCache;
+static IIterable<String^>^ s_cachedLanguageIdentifiers = nullptr;
+static bool s_languageIdentifiersCached = false;
+
+static wstring GetRegionalFormatSignature()
+{
+    WCHAR currentLocale[LOCALE_NAME_MAX_LENGTH] = {};
+    GetUserDefaultLocaleName(currentLocale, LOCALE_NAME_MAX_LENGTH);
+
+    wstring signature{ currentLocale };
+    signature += L'|';
+    signature += LocalizationService::GetHomeGeographicRegion()->Data();
+
+    return signature;
+}
+
+// Session-stable globalization inputs. Magic-static initialization keeps
+// each to a single ABI crossing (for the region code, a GeographicRegion
+// activation) per process; concurrent first calls are safe. A change to
+// the user's region or language list takes effect on the next session,
+// which the loaders already assume by latching these at construction.
+String^ LocalizationService::GetHomeGeographicRegion()
+{
+    static String^ s_homeGeographicRegion = GlobalizationPreferences::HomeGeographicRegion;
+    return s_homeGeographicRegion;
+}
+
+String^ LocalizationService::GetRegionCodeTwoLetter()
+{
+    static String^ s_regionCodeTwoLetter = (ref new GeographicRegion())->CodeTwoLetter;
+    return s_regionCodeTwoLetter;
+}
+
+String^ LocalizationService::GetPreferredLanguage()
+{
+    static String^ s_preferredLanguage =
+        (GlobalizationPreferences::Languages->Size > 0) ? GlobalizationPreferences::Languages->GetAt(0) : ref new String(L"en-US");
+    return s_preferredLanguage;
+}
+
 // If successful, returns a formatter that respects the user's regional format settings,
 // as configured by running intl.cpl.
+//
+// The returned formatter is intentionally not pooled: callers configure the
+// grouping and fraction-digit properties on the instance they receive.
 DecimalFormatter^ LocalizationService::GetRegionalSettingsAwareDecimalFormatter()
 {
     IIterable<String^>^ languageIdentifiers = LocalizationService::GetLanguageIdentifiers();
     if (languageIdentifiers != nullptr)
     {
-        return ref new DecimalFormatter(languageIdentifiers, GlobalizationPreferences::HomeGeographicRegion);
+        return ref new DecimalFormatter(languageIdentifiers, GetHomeGeographicRegion());
     }
 
     return ref new DecimalFormatter();
@@ -357,13 +440,16 @@ DecimalFormatter^ LocalizationService::GetRegionalSettingsAwareDecimalFormatter(
 // This helper function creates a DateTimeFormatter with a TwentyFour hour clock
 DateTimeFormatter^ LocalizationService::GetRegionalSettingsAwareDateTimeFormatter(_In_ String^ format)
 {
-    IIterable<String^>^ languageIdentifiers = LocalizationService::GetLanguageIdentifiers();
-    if (languageIdentifiers == nullptr)
+    return AcquireDateTimeFormatter(wstring{ format->Data() } + L";;", [format]()
     {
-        languageIdentifiers = ApplicationLanguages::Languages;
-    }
+        IIterable<String^>^ languageIdentifiers = LocalizationService::GetLanguageIdentifiers();
+        if (languageIdentifiers == nullptr)
+        {
+            languageIdentifiers = ApplicationLanguages::Languages;
+        }
 
-    return ref new DateTimeFormatter(format, languageIdentifiers);
+        return ref new DateTimeFormatter(format, languageIdentifiers);
+    });
 }
 
 // If successful, returns a formatter that respects the user's regional format settings,
@@ -373,18 +459,57 @@ DateTimeFormatter^ LocalizationService::GetRegionalSettingsAwareDateTimeFormatte
     _In_ String^ calendarIdentifier,
     _In_ String^ clockIdentifier)
 {
-    IIterable<String^>^ languageIdentifiers = LocalizationService::GetLanguageIdentifiers();
-    if (languageIdentifiers == nullptr)
+    wstring cacheKey = wstring{ format->Data() } + L";" + calendarIdentifier->Data() + L";" + clockIdentifier->Data();
+
+    return AcquireDateTimeFormatter(cacheKey, [format, calendarIdentifier, clockIdentifier]()
     {
-        languageIdentifiers = ApplicationLanguages::Languages;
+        IIterable<String^>^ languageIdentifiers = LocalizationService::GetLanguageIdentifiers();
+        if (languageIdentifiers == nullptr)
+        {
+            languageIdentifiers = ApplicationLanguages::Languages;
+        }
+
+        return ref new DateTimeFormatter(
+            format,
+            languageIdentifiers,
+            GetHomeGeographicRegion(),
+            calendarIdentifier,
+            clockIdentifier);
+    });
+}
+
+DateTimeFormatter^ LocalizationService::AcquireDateTimeFormatter(const wstring& cacheKey, const function<DateTimeFormatter^()>& createFormatter)
+{
+    wstring signature = GetRegionalFormatSignature();
+
+    {
+        reader_writer_lock::scoped_lock_read lock(s_formatterCacheLock);
+        if (signature == s_formatterCacheSignature)
+        {
+            auto itr = s_dateTimeFormatterCache.find(cacheKey);
+            if (itr != s_dateTimeFormatterCache.end())
+            {
+                return itr->second;
+            }
+        }
     }
 
-    return ref new DateTimeFormatter(
-        format,
-        languageIdentifiers,
-        GlobalizationPreferences::HomeGeographicRegion,
-        calendarIdentifier,
-        clockIdentifier);
+    // DateTimeFormatter activation is too slow to hold the lock across it.
+    DateTimeFormatter^ formatter = createFormatter();
+
+    reader_writer_lock::scoped_lock lock(s_formatterCacheLock);
+    if (signature != s_formatterCacheSignature)
+    {
+        // Regional settings changed since the pool was filled.
+        s_dateTimeFormatterCache.clear();
+        s_cachedLanguageIdentifiers = nullptr;
+        s_languageIdentifiersCached = false;
+        s_formatterCacheSignature = signature;
+    }
+
+    s_dateTimeFormatterCache[cacheKey] = formatter;
+
+    return formatter;
 }
 
 CurrencyFormatter^ LocalizationService::GetRegionalSettingsAwareCurrencyFormatter()
@@ -402,7 +527,7 @@ CurrencyFormatter^ LocalizationService::GetRegionalSettingsAwareCurrencyFormatte
     auto currencyFormatter = ref new CurrencyFormatter(
         userCurrency,
         languageIdentifiers,
-        GlobalizationPreferences::HomeGeographicRegion);
+        GetHomeGeographicRegion());
 
     int fractionDigits = LocalizationSettings::GetInstance().GetCurrencyTrailingDigits();
     currencyFormatter->FractionDigits = fractionDigits;
@@ -411,6 +536,33 @@ CurrencyFormatter^ LocalizationService::GetRegionalSettingsAwareCurrencyFormatte
 }
 
 IIterable<String^>^ LocalizationService::GetLanguageIdentifiers()
+{
+    wstring signature = GetRegionalFormatSignature();
+
+    {
+        reader_writer_lock::scoped_lock_read lock(s_formatterCacheLock);
+        if (signature == s_formatterCacheSignature && s_languageIdentifiersCached)
+        {
+            return s_cachedLanguageIdentifiers;
+        }
+    }
+
+    IIterable<String^>^ identifiers = BuildLanguageIdentifiers();
+
+    reader_writer_lock::scoped_lock lock(s_formatterCacheLock);
+    if (signature != s_formatterCacheSignature)
+    {
+        s_dateTimeFormatterCache.clear();
+        s_formatterCacheSignature = signature;
+    }
+
+    s_cachedLanguageIdentifiers = identifiers;
+    s_languageIdentifiersCached = true;
+
+    return identifiers;
+}
+
+IIterable<String^>^ LocalizationService::BuildLanguageIdentifiers()
 {
     WCHAR currentLocale[LOCALE_NAME_MAX_LENGTH] = {};
     int result = GetUserDefaultLocaleName(currentLocale, LOCALE_NAME_MAX_LENGTH);
@@ -38,6 +38,7 @@ namespace CalculatorApp { namespace Common
         Platform::String^ GetFontFamilyOverride();
         Windows::UI::Text::FontWeight GetFontWeightOverride();
         double GetFontScaleFactorOverride(LanguageFontType fontType);
+        double GetFontScaleFactor(LanguageFontType fontType);
 
         static Windows::Globalization::NumberFormatting::DecimalFormatter^ GetRegionalSettingsAwareDecimalFormatter();
         static Windows::Globalization::DateTimeFormatting::DateTimeFormatter^ GetRegionalSettingsAwareDateTimeFormatter(_In_ Platform::String^ format);
@@ -48,6 +49,17 @@ namespace CalculatorApp { namespace Common
 
         static Windows::Globalization::NumberFormatting::CurrencyFormatter^ GetRegionalSettingsAwareCurrencyFormatter();
 
+        // Session-stable globalization inputs, resolved once per process.
+        // The converter data loaders and the formatter helpers all need the
+        // same home region and preferred language, and every re-read (or
+        // GeographicRegion activation) crosses the WinRT ABI. The loaders
+        // already latch these at construction, so a region or language
+        // change taking effect on the next session is the established
+        // behavior.
+        static Platform::String^ GetHomeGeographicRegion();
+        static Platform::String^ GetRegionCodeTwoLetter();
+        static Platform::String^ GetPreferredLanguage();
+
         static Platform::String^ GetNarratorReadableToken(Platform::String^ rawToken);
         static Platform::String^ GetNarratorReadableString(Platform::String^ rawString);
 
@@ -56,6 +68,10 @@ namespace CalculatorApp { namespace Common
         Windows::UI::Text::FontWeight ParseFontWeight(Platform::String^ fontWeight);
 
         static Windows::Foundation::Collections::IIterable<Platform::String^>^ GetLanguageIdentifiers();
+        static Windows::Foundation::Collections::IIterable<Platform::String^>^ BuildLanguageIdentifiers();
+        static Windows::Globalization::DateTimeFormatting::DateTimeFormatter^ AcquireDateTimeFormatter(
+            const std::wstring& cacheKey,
+            const std::function<Windows::Globalization::DateTimeFormatting::DateTimeFormatter^()>& createFormatter);
 
         // Attached property callbacks
         static void OnFontTypePropertyChanged(Windows::UI::Xaml::DependencyObject^ target, LanguageFontType oldValue, LanguageFontType newValue);
@@ -79,6 +95,13 @@ namespace CalculatorApp { namespace Common
         Windows::UI::Text::FontWeight m_fontWeightOverride;
         double m_uiTextFontScaleFactorOverride;
         double m_uiCaptionFontScaleFactorOverride;
+
+        // Language font data resolved once at construction; the FontFamily
+        // objects are shared by every control the override touches.
+        Windows::UI::Xaml::Media::FontFamily^ m_uiTextFontFamily;
+        Windows::UI::Xaml::Media::FontFamily^ m_uiCaptionFontFamily;
+        double m_uiTextFontScaleFactor;
+        double m_uiCaptionFontScaleFactor;
     };
 
 }}
@@ -130,6 +130,22 @@ namespace CalculatorApp
                 // DayOfWeek enum value varies from 0, 1, .. 6 for Sunday, Monday, ... Saturday
                 // Hence, DayOfWeek = (valueof(LOCALE_IFIRSTDAYOFWEEK) + 1) % 7
                 m_firstDayOfWeek = static_cast<Windows::Globalization::DayOfWeek>((_wtoi(day) + 1) % 7);    // static cast int to DayOfWeek enum
+
+                // Flat translation table for LocalizeDisplayValue: identity for
+                // every ASCII character except the en-US digits, which map to
+                // the locale's digit symbols. Localizing a display string is
+                // then a table walk instead of per-character range checks, and
+                // it runs on every keystroke.
+                for (size_t i = 0; i < m_asciiTranslationTable.size(); i++)
+                {
+                    m_asciiTranslationTable[i] = static_cast<wchar_t>(i);
+                }
+                for (unsigned int i = 0; i < 10; i++)
+                {
+                    m_asciiTranslationTable[L'0' + i] = m_digitSymbols[i];
+                }
+
+                m_isDigitEnUsSetting = (m_digitSymbols[0] == L'0');
             }
 
         public:
@@ -156,25 +172,55 @@ namespace CalculatorApp
 
             bool IsDigitEnUsSetting() const
             {
-                if (this->GetDigitSymbolFromEnUsDigit('0') == L'0')
+                return m_isDigitEnUsSetting;
+            }
+
+            void LocalizeDisplayValue(_Inout_ std::wstring* stringToLocalize) const
+            {
+                if (m_isDigitEnUsSetting)
                 {
-                    return true;
+                    return;
+                }
+
+                // Characters outside the table (already-localized separators,
+                // for example) pass through unchanged.
+                for (wchar_t& ch : *stringToLocalize)
+                {
+                    if (ch < m_asciiTranslationTable.size())
+                    {
+                        ch = m_asciiTranslationTable[ch];
+                    }
                 }
-                return false;
             }
 
-            void LocalizeDisplayValue(_Inout_ std::wstring* stringToLocalize) const
+            // True when localizing a raw en-US number string would change
+            // nothing: the digit map is identity and the decimal separator is
+            // the point. Worth testing before paying for a copy of the string.
+            bool IsRawNumberLocalizationIdentity() const
+            {
+                return m_isDigitEnUsSetting && m_decimalSeparator == L'.';
+            }
+
+            // Localizes a raw en-US number string in place in a single pass:
+            // digits go through the flat translation table and the '.' decimal
+            // point becomes the locale's separator. Sign, exponent marker and
+            // anything else pass through unchanged.
+            void LocalizeRawNumber(_Inout_ std::wstring* stringToLocalize) const
             {
-                if (IsDigitEnUsSetting())
+                if (IsRawNumberLocalizationIdentity())
                 {
                     return;
                 }
 
                 for (wchar_t& ch : *stringToLocalize)
                 {
-                    if (IsEnUsDigit(ch))
+                    if (ch == L'.')
+                    {
+                        ch = m_decimalSeparator;
+                    }
+                    else if (ch < m_asciiTranslationTable.size())
                     {
-                        ch = GetDigitSymbolFromEnUsDigit(ch);
+                        ch = m_asciiTranslationTable[ch];
                     }
                 }
             }
@@ -199,9 +245,8 @@ namespace CalculatorApp
                         {
                             if (ch == m_digitSymbols[j])
                             {
-                                ch = j.ToString()->Data()[0];
+                                ch = static_cast<wchar_t>(L'0' + j);
                                 break;
-                                //ch = val - L'0';
                             }
                         }
                     }
@@ -377,6 +422,8 @@ namespace CalculatorApp
             std::array<wchar_t, 10> m_digitSymbols;
             // Hexadecimal characters are not currently localized
             static constexpr std::array<wchar_t, 6> s_hexSymbols{ L'A', L'B', L'C', L'D', L'E', L'F' };
+            std::array<wchar_t, 128> m_asciiTranslationTable;
+            bool m_isDigitEnUsSetting;
             std::wstring m_listSeparator;
             Platform::String^ m_calendarIdentifier;
             Windows::Globalization::DayOfWeek m_firstDayOfWeek;
@@ -69,17 +69,81 @@ static constexpr array<const NavCategoryInitializer, 17> s_categoryManifest = {
     NavCategoryInitializer { ViewMode::Angle,       ANGLE_ID,       L"Angle",           L"CategoryName_Angle",       L"\uF515", CategoryGroupType::Converter,  MyVirtualKey::None,    POSITIVE_ONLY     }
 };
 
-// This function should only be used when storing the mode to app data.
-int NavCategory::Serialize(ViewMode mode)
+static constexpr int c_numberOfCategories = static_cast<int>(s_categoryManifest.size());
+
+// Maps a ViewMode's underlying value to its manifest slot, so the lookup
+// helpers below are table indexing instead of linear searches.
+static constexpr array<int, c_numberOfCategories> BuildModeToManifestIndex()
 {
-    auto iter = find_if(begin(s_categoryManifest), end(s_categoryManifest),
-        [mode](const NavCategoryInitializer& initializer)
+    array<int, c_numberOfCategories> table{};
+    for (int i = 0; i < c_numberOfCategories; ++i)
     {
-        return initializer.viewMode == mode;
-    });
+        table[static_cast<int>(s_categoryManifest[i].viewMode)] = i;
+    }
 
-    return (iter != s_categoryManifest.end())
-        ? iter->serializationId
+    return table;
+}
+
+static constexpr array<int, c_numberOfCategories> s_modeToManifestIndex = BuildModeToManifestIndex();
+
+// Flat menu index per mode: manifest order with one extra slot consumed at
+// each group header, exactly as the menu lays items out.
+static constexpr array<int, c_numberOfCategories> BuildFlatIndexTable()
+{
+    array<int, c_numberOfCategories> table{};
+    int index = -1;
+    CategoryGroupType type = CategoryGroupType::None;
+    for (int i = 0; i < c_numberOfCategories; ++i)
+    {
+        index++;
+        if (s_categoryManifest[i].groupType != type)
+        {
+            type = s_categoryManifest[i].groupType;
+            index++;
+        }
+
+        table[static_cast<int>(s_categoryManifest[i].viewMode)] = index;
+    }
+
+    return table;
+}
+
+static constexpr array<int, c_numberOfCategories> s_modeToFlatIndex = BuildFlatIndexTable();
+
+// 0-based ordinal of each mode within its own group.
+static constexpr array<int, c_numberOfCategories> BuildIndexInGroupTable()
+{
+    array<int, c_numberOfCategories> table{};
+    array<int, 2> groupCounts{};
+    for (int i = 0; i < c_numberOfCategories; ++i)
+    {
+        table[static_cast<int>(s_categoryManifest[i].viewMode)] = groupCounts[static_cast<int>(s_categoryManifest[i].groupType)]++;
+    }
+
+    return table;
+}
+
+static constexpr array<int, c_numberOfCategories> s_modeToIndexInGroup = BuildIndexInGroupTable();
+
+// Returns the manifest entry for a mode, or nullptr for values that are not
+// real categories (e.g. ViewMode::None).
+static constexpr const NavCategoryInitializer* FindCategory(ViewMode mode)
+{
+    const int modeValue = static_cast<int>(mode);
+    if (modeValue < 0 || modeValue >= c_numberOfCategories)
+    {
+        return nullptr;
+    }
+
+    return &s_categoryManifest[s_modeToManifestIndex[modeValue]];
+}
+
+// This function should only be used when storing the mode to app data.
+int NavCategory::Serialize(ViewMode mode)
+{
+    const NavCategoryInitializer* category = FindCategory(mode);
+    return (category != nullptr)
+        ? category->serializationId
         : -1;
 }
 
@@ -110,13 +174,7 @@ ViewMode NavCategory::Deserialize(Platform::Object^ obj)
 
 bool NavCategory::IsValidViewMode(ViewMode mode)
 {
-    auto iter = find_if(begin(s_categoryManifest), end(s_categoryManifest),
-        [mode](const NavCategoryInitializer& initializer)
-    {
-        return initializer.viewMode == mode;
-    });
-
-    return iter != s_categoryManifest.end();
+    return FindCategory(mode) != nullptr;
 }
 
 bool NavCategory::IsCalculatorViewMode(ViewMode mode)
@@ -138,25 +196,15 @@ bool NavCategory::IsConverterViewMode(ViewMode mode)
 
 bool NavCategory::IsModeInCategoryGroup(ViewMode mode, CategoryGroupType type)
 {
-    auto iter = find_if(begin(s_categoryManifest), end(s_categoryManifest),
-        [mode, type](const NavCategoryInitializer& initializer)
-    {
-        return initializer.viewMode == mode && initializer.groupType == type;
-    });
-
-    return iter != s_categoryManifest.end();
+    const NavCategoryInitializer* category = FindCategory(mode);
+    return category != nullptr && category->groupType == type;
 }
 
 String^ NavCategory::GetFriendlyName(ViewMode mode)
 {
-    auto iter = find_if(begin(s_categoryManifest), end(s_categoryManifest),
-        [mode](const NavCategoryInitializer& initializer)
-    {
-        return initializer.viewMode == mode;
-    });
-
-    return (iter != s_categoryManifest.end())
-        ? StringReference(iter->friendlyName)
+    const NavCategoryInitializer* category = FindCategory(mode);
+    return (category != nullptr)
+        ? StringReference(category->friendlyName)
         : L"None";
 }
 
@@ -175,27 +223,17 @@ ViewMode NavCategory::GetViewModeForFriendlyName(String^ name)
 
 String^ NavCategory::GetNameResourceKey(ViewMode mode)
 {
-    auto iter = find_if(begin(s_categoryManifest), end(s_categoryManifest),
-        [mode](const NavCategoryInitializer& initializer)
-    {
-        return initializer.viewMode == mode;
-    });
-
-    return (iter != s_categoryManifest.end())
-        ? StringReference(iter->nameResourceKey) + "Text"
+    const NavCategoryInitializer* category = FindCategory(mode);
+    return (category != nullptr)
+        ? StringReference(category->nameResourceKey) + "Text"
         : nullptr;
 }
 
 CategoryGroupType NavCategory::GetGroupType(ViewMode mode)
 {
-    auto iter = find_if(begin(s_categoryManifest), end(s_categoryManifest),
-        [mode](const NavCategoryInitializer& initializer)
-    {
-        return initializer.viewMode == mode;
-    });
-
-    return (iter != s_categoryManifest.end())
-        ? iter->groupType
+    const NavCategoryInitializer* category = FindCategory(mode);
+    return (category != nullptr)
+        ? category->groupType
         : CategoryGroupType::None;
 }
 
@@ -208,60 +246,25 @@ int NavCategory::GetIndex(ViewMode mode)
 
 int NavCategory::GetFlatIndex(ViewMode mode)
 {
-    int index = -1;
-    CategoryGroupType type = CategoryGroupType::None;
-    auto iter = find_if(begin(s_categoryManifest), end(s_categoryManifest),
-        [mode, &type, &index](const NavCategoryInitializer& initializer)
-    {
-        index++;
-        if (initializer.groupType != type)
-        {
-            type = initializer.groupType;
-            index++;
-        }
-
-        return initializer.viewMode == mode;
-    });
-
-    return (iter != s_categoryManifest.end())
-        ? index
+    return (FindCategory(mode) != nullptr)
+        ? s_modeToFlatIndex[static_cast<int>(mode)]
         : -1;
 }
 
 // GetIndex is 0-based, GetPosition is 1-based
 int NavCategory::GetIndexInGroup(ViewMode mode, CategoryGroupType type)
 {
-    int index = -1;
-    auto iter = find_if(begin(s_categoryManifest), end(s_categoryManifest),
-        [mode, type, &index](const NavCategoryInitializer& initializer)
-    {
-        if (initializer.groupType == type)
-        {
-            index++;
-            return initializer.viewMode == mode;
-        }
-
-        return false;
-    });
-
-    return (iter != s_categoryManifest.end())
-        ? index
+    const NavCategoryInitializer* category = FindCategory(mode);
+    return (category != nullptr && category->groupType == type)
+        ? s_modeToIndexInGroup[static_cast<int>(mode)]
         : -1;
 }
 
 // GetIndex is 0-based, GetPosition is 1-based
 int NavCategory::GetPosition(ViewMode mode)
 {
-    int position = 0;
-    auto iter = find_if(begin(s_categoryManifest), end(s_categoryManifest),
-        [mode, &position](const NavCategoryInitializer& initializer)
-    {
-        position++;
-        return initializer.viewMode == mode;
-    });
-
-    return (iter != s_categoryManifest.end())
-        ? position
+    return (FindCategory(mode) != nullptr)
+        ? s_modeToManifestIndex[static_cast<int>(mode)] + 1
         : -1;
 }
 
@@ -278,6 +281,25 @@ ViewMode NavCategory::GetViewModeForVirtualKey(MyVirtualKey virtualKey)
         : ViewMode::None;
 }
 
+// Resolves the localized name, automation name and access key the first time
+// any of them is read. Most categories are never shown focused or narrated in
+// a session, so the resource lookups are deferred until a consumer asks.
+void NavCategory::EnsureLocalizedNames()
+{
+    if (m_name != nullptr)
+    {
+        return;
+    }
+
+    auto resProvider = AppResourceProvider::GetInstance();
+    m_name = resProvider.GetResourceString(m_nameResourceKey + "Text");
+    m_accessKey = resProvider.GetResourceString(m_nameResourceKey + "AccessKey");
+    m_automationName = ref new String(LocalizationStringUtil::GetLocalizedString(
+        m_itemAutomationNameFormat->Data(),
+        m_name->Data(),
+        m_groupName->Data()).c_str());
+}
+
 vector<MyVirtualKey> NavCategory::GetCategoryAcceleratorKeys()
 {
     vector<MyVirtualKey> accelerators{};
@@ -316,18 +338,13 @@ NavCategoryGroup::NavCategoryGroup(const NavCategoryGroupInitializer& groupIniti
     {
         if (categoryInitializer.groupType == groupInitializer.type)
         {
-            String^ nameResourceKey = StringReference(categoryInitializer.nameResourceKey);
-            String^ categoryName = resProvider.GetResourceString(nameResourceKey + "Text");
-            String^ categoryAutomationName = ref new String(LocalizationStringUtil::GetLocalizedString(
-                navCategoryItemAutomationNameFormat->Data(),
-                categoryName->Data(),
-                m_Name->Data()).c_str());
-
+            // The category resolves its localized name, automation name and
+            // access key lazily from the resource key.
             m_Categories->Append(ref new NavCategory(
-                categoryName,
-                categoryAutomationName,
+                StringReference(categoryInitializer.nameResourceKey),
+                m_Name,
+                navCategoryItemAutomationNameFormat,
                 StringReference(categoryInitializer.glyph),
-                resProvider.GetResourceString(nameResourceKey + "AccessKey"),
                 groupMode,
                 categoryInitializer.viewMode,
                 categoryInitializer.supportsNegative));
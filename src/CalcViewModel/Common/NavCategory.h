@@ -103,14 +103,16 @@ namespace CalculatorApp
         public:
             OBSERVABLE_OBJECT();
 
+            // Localized strings resolve from resources on first read, so
+            // building the menu does not touch resources for every category.
             property Platform::String^ Name
             {
-                Platform::String^ get() { return m_name; }
+                Platform::String^ get() { EnsureLocalizedNames(); return m_name; }
             }
 
             property Platform::String^ AutomationName
             {
-                Platform::String^ get() { return m_automationName; }
+                Platform::String^ get() { EnsureLocalizedNames(); return m_automationName; }
             }
 
             property Platform::String^ Glyph
@@ -143,6 +145,7 @@ namespace CalculatorApp
             {
                 Platform::String^ get()
                 {
+                    EnsureLocalizedNames();
                     return m_accessKey;
                 }
             }
@@ -179,11 +182,18 @@ namespace CalculatorApp
             static ViewMode GetViewModeForVirtualKey(MyVirtualKey virtualKey);
 
         internal:
-            NavCategory(Platform::String^ name, Platform::String^ automationName, Platform::String^ glyph, Platform::String^ accessKey, Platform::String^ mode, ViewMode viewMode, bool supportsNegative) :
-                m_name(name),
-                m_automationName(automationName),
+            NavCategory(
+                Platform::String^ nameResourceKey,
+                Platform::String^ groupName,
+                Platform::String^ itemAutomationNameFormat,
+                Platform::String^ glyph,
+                Platform::String^ mode,
+                ViewMode viewMode,
+                bool supportsNegative) :
+                m_nameResourceKey(nameResourceKey),
+                m_groupName(groupName),
+                m_itemAutomationNameFormat(itemAutomationNameFormat),
                 m_glyph(glyph),
-                m_accessKey(accessKey),
                 m_mode(mode),
                 m_viewMode(viewMode),
                 m_supportsNegative(supportsNegative)
@@ -196,7 +206,12 @@ namespace CalculatorApp
         private:
             static bool IsModeInCategoryGroup(ViewMode mode, CategoryGroupType groupType);
 
+            void EnsureLocalizedNames();
+
             ViewMode m_viewMode;
+            Platform::String^ m_nameResourceKey;
+            Platform::String^ m_groupName;
+            Platform::String^ m_itemAutomationNameFormat;
             Platform::String^ m_name;
             Platform::String^ m_automationName;
             Platform::String^ m_glyph;
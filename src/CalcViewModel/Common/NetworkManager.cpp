@@ -40,7 +40,18 @@ NetworkAccessBehavior NetworkManager::GetNetworkAccessBehavior()
 
 void NetworkManager::OnNetworkStatusChange(_In_ Object^ /*sender*/)
 {
-    NetworkBehaviorChanged(GetNetworkAccessBehavior());
+    // NetworkStatusChanged fires in bursts while a transition settles, and
+    // most of the burst resolves to the same access behavior. Only forward
+    // the changes that alter the behavior subscribers act on.
+    NetworkAccessBehavior behavior = GetNetworkAccessBehavior();
+    if (m_behaviorKnown && behavior == m_lastBehavior)
+    {
+        return;
+    }
+
+    m_behaviorKnown = true;
+    m_lastBehavior = behavior;
+    NetworkBehaviorChanged(behavior);
 }
 
 // See app behavior guidelines at https://msdn.microsoft.com/en-us/library/windows/apps/xaml/jj835821(v=win.10).aspx
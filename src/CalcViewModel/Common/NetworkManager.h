@@ -31,5 +31,10 @@ namespace CalculatorApp
 
     private:
         Windows::Foundation::EventRegistrationToken m_NetworkStatusChangedToken;
+
+        // Last behavior raised, used to coalesce the bursts of status
+        // change events a single network transition produces.
+        bool m_behaviorKnown = false;
+        NetworkAccessBehavior m_lastBehavior = NetworkAccessBehavior::Normal;
     };
 }
@@ -2,9 +2,16 @@
 // Licensed under the MIT License.
 
 #include "pch.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <iomanip>
+
 #include "TraceLogger.h"
 #include "NetworkManager.h"
 #include "CalculatorButtonUser.h"
+#include "LaunchTimeline.h"
+#include "CalcManager/CalculatorManager.h"
 
 using namespace CalculatorApp;
 using namespace CalculatorApp::Common;
@@ -27,8 +34,132 @@ namespace CalculatorApp
         L"DecBase", L"OctBase", L"BinBase" };
     static reader_writer_lock s_traceLoggerLock;
 
+    // The event kinds the async trace pipeline carries. Only events whose
+    // payload is a couple of integers go through the ring buffer; events that
+    // carry strings are rare (errors, exceptions, conversions) and stay
+    // synchronous.
+    enum class TraceRecordType
+    {
+        FunctionUsage,
+        BitLengthButtonUsed,
+        RadixButtonUsed,
+        AngleButtonUsed,
+        HypButtonUsed,
+        DateDifferenceModeUsed,
+        DateAddSubtractModeUsed,
+        ValidInputPasted
+    };
+
+    struct TraceRecord
+    {
+        TraceRecordType type;
+        int windowId;
+        int arg;
+        unsigned int weight;
+    };
+
+    // Bounded multi-producer ring buffer (each window has its own UI thread,
+    // so several producers can race) with a single consumer, the drain thread.
+    // Enqueue is a CAS on the tail plus a slot-sequence publish; no locks are
+    // taken on the interaction path. When the ring is full the record is
+    // dropped - telemetry is best effort.
+    class TraceRecordQueue
+    {
+    public:
+        TraceRecordQueue()
+        {
+            for (size_t i = 0; i < c_capacity; i++)
+            {
+                m_slots[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        bool TryEnqueue(const TraceRecord& record)
+        {
+            size_t tail = m_tail.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                Slot& slot = m_slots[tail & (c_capacity - 1)];
+                size_t sequence = slot.sequence.load(std::memory_order_acquire);
+                intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(tail);
+                if (difference == 0)
+                {
+                    if (m_tail.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed))
+                    {
+                        slot.record = record;
+                        slot.sequence.store(tail + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (difference < 0)
+                {
+                    // The slot still holds a record the consumer has not
+                    // processed; the ring is full.
+                    return false;
+                }
+                else
+                {
+                    tail = m_tail.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        bool TryDequeue(TraceRecord& record)
+        {
+            Slot& slot = m_slots[m_head & (c_capacity - 1)];
+            size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            if (static_cast<intptr_t>(sequence) - static_cast<intptr_t>(m_head + 1) < 0)
+            {
+                return false;
+            }
+
+            record = slot.record;
+            slot.sequence.store(m_head + c_capacity, std::memory_order_release);
+            m_head++;
+            return true;
+        }
+
+        bool IsEmpty() const
+        {
+            const Slot& slot = m_slots[m_head & (c_capacity - 1)];
+            return static_cast<intptr_t>(slot.sequence.load(std::memory_order_acquire)) - static_cast<intptr_t>(m_head + 1) < 0;
+        }
+
+    private:
+        static constexpr size_t c_capacity = 1024; // power of two
+
+        struct Slot
+        {
+            std::atomic<size_t> sequence;
+            TraceRecord record;
+        };
+
+        std::array<Slot, c_capacity> m_slots;
+        std::atomic<size_t> m_tail{ 0 };
+        size_t m_head = 0; // touched only by the drain thread
+    };
+
+    static TraceRecordQueue s_traceRecordQueue;
+    static std::mutex s_traceQueueMutex;
+    static std::condition_variable s_traceWakeCondition;
+    static std::condition_variable s_traceDrainedCondition;
+    static std::atomic<unsigned int> s_traceSampleInterval{ 1 };
+    static std::atomic<unsigned int> s_traceSampleCounter{ 0 };
+
+    static void EnqueueTraceRecord(TraceRecordType type, int windowId, int arg = 0, unsigned int weight = 1)
+    {
+        // Dropped records are acceptable; never block the interaction path.
+        s_traceRecordQueue.TryEnqueue(TraceRecord{ type, windowId, arg, weight });
+    }
+
     // Telemetry events. Uploaded to asimov.
     constexpr auto EVENT_NAME_DEBUG                                                     = L"Debug";
+    constexpr auto EVENT_NAME_ENGINE_DIAGNOSTICS                                        = L"EngineDiagnostics";
+    constexpr auto EVENT_NAME_ENGINE_COMMAND_ACTIVITY                                   = L"EngineProcessCommand";
+    constexpr auto EVENT_NAME_CONVERTER_COMMAND_ACTIVITY                                = L"ConverterProcessCommand";
+    constexpr auto EVENT_NAME_CURRENCY_LOAD_ACTIVITY                                    = L"CurrencyDataLoad";
+    constexpr auto EVENT_NAME_DISPLAY_UPDATE_ACTIVITY                                   = L"DisplayUpdate";
+    constexpr auto EVENT_NAME_LAUNCH_TIMELINE                                           = L"LaunchTimeline";
     constexpr auto EVENT_NAME_ERROR                                                     = L"ErrorMessage";
     constexpr auto EVENT_NAME_APP_PRELAUNCHED_BY_SYSTEM                                 = L"AppPrelaunchedBySystem";
     constexpr auto EVENT_NAME_PRELAUNCHED_APP_ACTIVATED_BY_USER                         = L"PrelaunchedAppActivatedByUser";
@@ -108,10 +239,102 @@ namespace CalculatorApp
     {
         // initialize the function array
         InitFunctionLogArray();
+
+        // Field construction and ETW submission happen on this thread so the
+        // interaction path only pays for a ring-buffer enqueue.
+        m_traceDrainActive = true;
+        m_traceDrainThread = std::thread(&TraceLogger::DrainTraceRecords, this);
     }
 
     TraceLogger::~TraceLogger()
     {
+        m_traceDrainActive = false;
+        s_traceWakeCondition.notify_all();
+        if (m_traceDrainThread.joinable())
+        {
+            m_traceDrainThread.join();
+        }
+    }
+
+    void TraceLogger::SetTraceSamplingInterval(unsigned int everyNthRecord)
+    {
+        s_traceSampleInterval = (everyNthRecord > 0) ? everyNthRecord : 1;
+    }
+
+    void TraceLogger::DrainTraceRecords()
+    {
+        TraceRecord record;
+        while (m_traceDrainActive)
+        {
+            while (s_traceRecordQueue.TryDequeue(record))
+            {
+                ProcessTraceRecord(record);
+            }
+
+            std::unique_lock<std::mutex> lock(s_traceQueueMutex);
+            s_traceDrainedCondition.notify_all();
+            if (!m_traceDrainActive)
+            {
+                break;
+            }
+            s_traceWakeCondition.wait_for(lock, std::chrono::milliseconds(50));
+        }
+
+        // Submit whatever arrived before shutdown was requested.
+        while (s_traceRecordQueue.TryDequeue(record))
+        {
+            ProcessTraceRecord(record);
+        }
+        s_traceDrainedCondition.notify_all();
+    }
+
+    void TraceLogger::ProcessTraceRecord(const TraceRecord& record)
+    {
+        switch (record.type)
+        {
+        case TraceRecordType::FunctionUsage:
+        {
+            // Writer lock for the static resources
+            reader_writer_lock::scoped_lock lock(s_traceLoggerLock);
+
+            int funcIndex = record.arg;
+            if (GetIndex(funcIndex))
+            {
+                // funcIndex is passed by reference and will be having the returned index.
+                // The weight restores counts dropped by sampling.
+                funcLog[funcIndex].count += record.weight;
+            }
+            break;
+        }
+        case TraceRecordType::BitLengthButtonUsed:
+            LogBitLengthButtonUsedImpl(record.windowId);
+            break;
+        case TraceRecordType::RadixButtonUsed:
+            LogRadixButtonUsedImpl(record.windowId);
+            break;
+        case TraceRecordType::AngleButtonUsed:
+            LogAngleButtonUsedImpl(record.windowId);
+            break;
+        case TraceRecordType::HypButtonUsed:
+            LogHypButtonUsedImpl(record.windowId);
+            break;
+        case TraceRecordType::DateDifferenceModeUsed:
+            LogDateDifferenceModeUsedImpl(record.windowId);
+            break;
+        case TraceRecordType::DateAddSubtractModeUsed:
+            LogDateAddSubtractModeUsedImpl(record.windowId, record.arg != 0);
+            break;
+        case TraceRecordType::ValidInputPasted:
+            LogValidInputPastedImpl(static_cast<ViewMode>(record.arg));
+            break;
+        }
+    }
+
+    void TraceLogger::FlushTraceRecords()
+    {
+        std::unique_lock<std::mutex> lock(s_traceQueueMutex);
+        s_traceWakeCondition.notify_all();
+        s_traceDrainedCondition.wait_for(lock, std::chrono::milliseconds(500), [] { return s_traceRecordQueue.IsEmpty(); });
     }
 
     TraceLogger& TraceLogger::GetInstance()
@@ -155,6 +378,52 @@ namespace CalculatorApp
     {
         return make_unique<TraceActivity>(g_calculatorProvider, eventName, fields);
     }
+
+    unique_ptr<TraceActivity> TraceLogger::BeginEngineCommandActivity(int command) const
+    {
+        if (!GetTraceLoggingProviderEnabled())
+        {
+            return nullptr;
+        }
+
+        LoggingFields fields{};
+        fields.AddInt32(L"Command", command);
+        return CreateTraceActivity(EVENT_NAME_ENGINE_COMMAND_ACTIVITY, fields);
+    }
+
+    unique_ptr<TraceActivity> TraceLogger::BeginConverterCommandActivity(int command) const
+    {
+        if (!GetTraceLoggingProviderEnabled())
+        {
+            return nullptr;
+        }
+
+        LoggingFields fields{};
+        fields.AddInt32(L"Command", command);
+        return CreateTraceActivity(EVENT_NAME_CONVERTER_COMMAND_ACTIVITY, fields);
+    }
+
+    unique_ptr<TraceActivity> TraceLogger::BeginCurrencyLoadActivity() const
+    {
+        if (!GetTraceLoggingProviderEnabled())
+        {
+            return nullptr;
+        }
+
+        LoggingFields fields{};
+        return CreateTraceActivity(EVENT_NAME_CURRENCY_LOAD_ACTIVITY, fields);
+    }
+
+    unique_ptr<TraceActivity> TraceLogger::BeginDisplayUpdateActivity() const
+    {
+        if (!GetTraceLoggingProviderEnabled())
+        {
+            return nullptr;
+        }
+
+        LoggingFields fields{};
+        return CreateTraceActivity(EVENT_NAME_DISPLAY_UPDATE_ACTIVITY, fields);
+    }
 #pragma endregion
 
     void TraceLogger::InsertIntoMemoryMap(int windowId, bool isStandard, bool isScientific, bool isProgrammer)
@@ -383,6 +652,164 @@ namespace CalculatorApp
         LogTelemetryEvent(EVENT_NAME_DEBUG, fields);
     }
 
+    // One snapshot of the engine's ratpak counters, logged per completed
+    // calculation while a trace session is listening so stalls the user
+    // reports can be lined up with what the engine was doing.
+    void TraceLogger::LogEngineDiagnostics(
+        int windowId,
+        uint64_t createCount,
+        uint64_t poolHits,
+        uint64_t heapAllocs,
+        uint64_t mulCount,
+        uint64_t limbOps,
+        uint64_t highWaterBytes) const
+    {
+        if (!GetTraceLoggingProviderEnabled()) return;
+
+        LoggingFields fields{};
+        fields.AddInt32(L"WindowId", windowId);
+        fields.AddUInt64(L"NumberCreateCount", createCount);
+        fields.AddUInt64(L"NumberPoolHits", poolHits);
+        fields.AddUInt64(L"NumberHeapAllocs", heapAllocs);
+        fields.AddUInt64(L"MulNumXCount", mulCount);
+        fields.AddUInt64(L"LimbOpCount", limbOps);
+        fields.AddUInt64(L"BytesHighWater", highWaterBytes);
+        LogMeasureEvent(EVENT_NAME_ENGINE_DIAGNOSTICS, fields);
+    }
+
+    // The cold-start phase markers as one event, one field per phase with
+    // its offset from module load in microseconds, so launch time can be
+    // attributed between XAML, navigation, engine construction and first
+    // display per release.
+    void TraceLogger::LogLaunchTimeline(const vector<pair<wstring, uint64_t>>& phases) const
+    {
+        if (!GetTraceLoggingProviderEnabled()) return;
+
+        LoggingFields fields{};
+        for (const auto& phase : phases)
+        {
+            fields.AddUInt64(phase.first.c_str(), phase.second);
+        }
+        LogMeasureEvent(EVENT_NAME_LAUNCH_TIMELINE, fields);
+    }
+
+    static atomic<bool> s_localDiagnosticsActive{ false };
+
+    void TraceLogger::SetLocalDiagnosticsActive(bool active)
+    {
+        s_localDiagnosticsActive.store(active, memory_order_relaxed);
+
+        // The ratpak counters feed the same view; arm them alongside. On
+        // deactivation they stay armed only while an ETW session still wants
+        // them (LogEngineDiagnosticsSnapshot re-arms per calculation then).
+        if (active)
+        {
+            CalculationManager::CalculatorManager::SetDiagnosticsEnabled(true);
+        }
+        else if (!GetInstance().GetTraceLoggingProviderEnabled())
+        {
+            CalculationManager::CalculatorManager::SetDiagnosticsEnabled(false);
+        }
+    }
+
+    bool TraceLogger::LocalDiagnosticsActive()
+    {
+        return s_localDiagnosticsActive.load(memory_order_relaxed);
+    }
+
+    void TraceLogger::RecordCommandLatency(int command, uint64_t microseconds)
+    {
+        if (!LocalDiagnosticsActive()) return;
+
+        lock_guard<mutex> lock(m_localDiagnosticsMutex);
+        auto& stats = m_commandLatency[command];
+        stats.count++;
+        stats.totalMicroseconds += microseconds;
+        stats.maxMicroseconds = max(stats.maxMicroseconds, microseconds);
+
+        size_t bucket = 0;
+        while (bucket < stats.buckets.size() - 1 && microseconds >= (1ull << (bucket + 1)))
+        {
+            bucket++;
+        }
+        stats.buckets[bucket]++;
+    }
+
+    void TraceLogger::RecordDisplayUpdate()
+    {
+        if (!LocalDiagnosticsActive()) return;
+
+        lock_guard<mutex> lock(m_localDiagnosticsMutex);
+        m_displayUpdateCount++;
+    }
+
+    // Renders every locally collected counter as one plain-text report for
+    // the hidden diagnostics panel: the launch timeline, the ratpak
+    // allocation and multiply counters, the replay memo cache hit rate, the
+    // display transaction count and the per-command latency histograms
+    // (heaviest commands first).
+    wstring TraceLogger::BuildDiagnosticsReport()
+    {
+        wstringstream report;
+        report << fixed << setprecision(1);
+
+        report << L"Launch timeline (ms from module load)\n";
+        for (const auto& phase : LaunchTimeline::Snapshot())
+        {
+            report << L"  " << phase.first << L": " << (phase.second / 1000.0) << L"\n";
+        }
+
+        auto ratpak = CalculationManager::CalculatorManager::GetDiagnostics();
+        double poolRate = ratpak.cCreateNum != 0 ? 100.0 * ratpak.cPoolHits / ratpak.cCreateNum : 0.0;
+        report << L"Ratpak (since armed)\n";
+        report << L"  creates: " << ratpak.cCreateNum << L", pool hits: " << poolRate
+               << L"%, heap allocs: " << ratpak.cHeapAllocs << L"\n";
+        report << L"  mulnumx: " << ratpak.cMulNumX << L", limb ops: " << ratpak.cLimbOps << L"\n";
+        report << L"  live bytes: " << ratpak.cbLive << L", high water: " << ratpak.cbHighWater << L"\n";
+
+        auto memo = CalculationManager::CalculatorManager::GetMemoCacheStats();
+        double memoRate = memo.cLookups != 0 ? 100.0 * memo.cHits / memo.cLookups : 0.0;
+        report << L"Replay memo cache: " << memo.cHits << L"/" << memo.cLookups
+               << L" hits (" << memoRate << L"%)\n";
+
+        lock_guard<mutex> lock(m_localDiagnosticsMutex);
+        report << L"Display transactions drained: " << m_displayUpdateCount << L"\n";
+
+        report << L"Engine command latency (microseconds, log2 buckets)\n";
+        vector<pair<int, const CommandLatencyStats*>> byTotal;
+        byTotal.reserve(m_commandLatency.size());
+        for (const auto& entry : m_commandLatency)
+        {
+            byTotal.emplace_back(entry.first, &entry.second);
+        }
+        sort(byTotal.begin(), byTotal.end(), [](const auto& a, const auto& b)
+        {
+            return a.second->totalMicroseconds > b.second->totalMicroseconds;
+        });
+
+        for (const auto& entry : byTotal)
+        {
+            const auto& stats = *entry.second;
+            report << L"  cmd " << entry.first
+                   << L": n=" << stats.count
+                   << L", avg=" << (static_cast<double>(stats.totalMicroseconds) / stats.count)
+                   << L", max=" << stats.maxMicroseconds
+                   << L", [";
+            size_t lastBucket = stats.buckets.size();
+            while (lastBucket > 1 && stats.buckets[lastBucket - 1] == 0)
+            {
+                lastBucket--;
+            }
+            for (size_t i = 0; i < lastBucket; i++)
+            {
+                report << (i != 0 ? L" " : L"") << stats.buckets[i];
+            }
+            report << L"]\n";
+        }
+
+        return report.str();
+    }
+
     void TraceLogger::LogOnAppLaunch(wstring_view previousExecutionState) const
     {
         if (!GetTraceLoggingProviderEnabled()) return;
@@ -656,6 +1083,11 @@ namespace CalculatorApp
     }
 
     void TraceLogger::LogValidInputPasted(ViewMode mode) const
+    {
+        EnqueueTraceRecord(TraceRecordType::ValidInputPasted, 0 /*windowId*/, static_cast<int>(mode));
+    }
+
+    void TraceLogger::LogValidInputPastedImpl(ViewMode mode) const
     {
         if (!GetTraceLoggingProviderEnabled()) return;
 
@@ -700,14 +1132,16 @@ namespace CalculatorApp
 
     void TraceLogger::UpdateFunctionUsage(int funcIndex)
     {
-        // Writer lock for the static resources
-        reader_writer_lock::scoped_lock lock(s_traceLoggerLock);
-
-        if (GetIndex(funcIndex))
+        // This fires on every button press, so it is the one sampleable
+        // record type; the weight keeps the aggregated counts approximately
+        // right when sampling is enabled.
+        unsigned int interval = s_traceSampleInterval.load(std::memory_order_relaxed);
+        if (interval > 1 && (s_traceSampleCounter.fetch_add(1, std::memory_order_relaxed) % interval) != 0)
         {
-            // funcIndex is passed by reference and will be having the returned index
-            funcLog[funcIndex].count++;
+            return;
         }
+
+        EnqueueTraceRecord(TraceRecordType::FunctionUsage, 0 /*windowId*/, funcIndex, interval);
     }
 
     void TraceLogger::InitFunctionLogArray()
@@ -779,6 +1213,11 @@ namespace CalculatorApp
     }
 
     void TraceLogger::LogBitLengthButtonUsed(int windowId)
+    {
+        EnqueueTraceRecord(TraceRecordType::BitLengthButtonUsed, windowId);
+    }
+
+    void TraceLogger::LogBitLengthButtonUsedImpl(int windowId)
     {
         if (bitLengthButtonUsage.find(windowId) == bitLengthButtonUsage.end())
         {
@@ -799,6 +1238,11 @@ namespace CalculatorApp
     }
 
     void TraceLogger::LogRadixButtonUsed(int windowId)
+    {
+        EnqueueTraceRecord(TraceRecordType::RadixButtonUsed, windowId);
+    }
+
+    void TraceLogger::LogRadixButtonUsedImpl(int windowId)
     {
         if (radixButtonUsage.find(windowId) == radixButtonUsage.end())
         {
@@ -819,6 +1263,11 @@ namespace CalculatorApp
     }
 
     void TraceLogger::LogAngleButtonUsed(int windowId)
+    {
+        EnqueueTraceRecord(TraceRecordType::AngleButtonUsed, windowId);
+    }
+
+    void TraceLogger::LogAngleButtonUsedImpl(int windowId)
     {
         if (angleButtonUsage.find(windowId) == angleButtonUsage.end())
         {
@@ -857,6 +1306,11 @@ namespace CalculatorApp
     }
 
     void TraceLogger::LogHypButtonUsed(int windowId)
+    {
+        EnqueueTraceRecord(TraceRecordType::HypButtonUsed, windowId);
+    }
+
+    void TraceLogger::LogHypButtonUsedImpl(int windowId)
     {
         if (!isHypButtonLogged)
         {
@@ -869,6 +1323,11 @@ namespace CalculatorApp
     }
 
     void TraceLogger::LogDateDifferenceModeUsed(int windowId)
+    {
+        EnqueueTraceRecord(TraceRecordType::DateDifferenceModeUsed, windowId);
+    }
+
+    void TraceLogger::LogDateDifferenceModeUsedImpl(int windowId)
     {
         if (!m_dateDiffUsageLoggedInSession)
         {
@@ -881,6 +1340,11 @@ namespace CalculatorApp
     }
 
     void TraceLogger::LogDateAddSubtractModeUsed(int windowId, bool isAddMode)
+    {
+        EnqueueTraceRecord(TraceRecordType::DateAddSubtractModeUsed, windowId, isAddMode ? 1 : 0);
+    }
+
+    void TraceLogger::LogDateAddSubtractModeUsedImpl(int windowId, bool isAddMode)
     {
         auto usageMap = isAddMode ? &m_dateAddModeUsage : &m_dateSubtractModeUsage;
         auto isLoggedInSession = isAddMode ? &m_dateAddUsageLoggedInSession : &m_dateSubtractUsageLoggedInSession;
@@ -973,6 +1437,10 @@ namespace CalculatorApp
 
     void TraceLogger::LogViewClosingTelemetry(int windowId)
     {
+        // Make sure usage records still sitting in the ring buffer are
+        // reflected in the aggregates before they are reported.
+        FlushTraceRecords();
+
         LogFunctionUsage(windowId);
         LogMaxWindowCount();
     }
@@ -3,6 +3,11 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
 #include "CalcManager/Command.h"
 #include "TraceActivity.h"
 #include "NavCategory.h"
@@ -13,6 +18,10 @@ static const int maxFunctionSize = (int)CalculationManager::Command::CommandBINE
 // This class implements a singleton model ensure that only one instance is created.
 namespace CalculatorApp
 {
+    // Small POD record the interaction path enqueues into the trace ring
+    // buffer; the drain thread turns it into LoggingFields and submits it.
+    struct TraceRecord;
+
     struct FuncLog
     {
     public:
@@ -63,6 +72,41 @@ namespace CalculatorApp
         void LogMemoryBodyOpened() const;
         void LogMemoryFlyoutOpenBegin(unsigned int) const;
         void LogDebug(std::wstring_view debugData);
+        void LogEngineDiagnostics(
+            int windowId,
+            uint64_t createCount,
+            uint64_t poolHits,
+            uint64_t heapAllocs,
+            uint64_t mulCount,
+            uint64_t limbOps,
+            uint64_t highWaterBytes) const;
+        void LogLaunchTimeline(const std::vector<std::pair<std::wstring, uint64_t>>& phases) const;
+
+        // Local diagnostics behind the hidden in-app view (armed from the
+        // About flyout). While active, the keystroke path records each
+        // command's engine latency into per-command log2 histograms and the
+        // display drain counts its transactions; BuildDiagnosticsReport
+        // renders those together with the ratpak counters, the replay memo
+        // cache hit rate and the launch timeline as one readable string, so
+        // a slow machine can be diagnosed in the field without an ETW
+        // session. While inactive the recording paths cost one branch.
+        static void SetLocalDiagnosticsActive(bool active);
+        static bool LocalDiagnosticsActive();
+        void RecordCommandLatency(int command, uint64_t microseconds);
+        void RecordDisplayUpdate();
+        std::wstring BuildDiagnosticsReport();
+
+        // Scoped ETW spans around the hot paths (engine command processing,
+        // converter command processing, currency data load, display drain).
+        // Each returns nullptr when no trace session is listening, so the
+        // disabled cost is a single branch; otherwise the returned activity
+        // writes its Start event immediately and its Stop event when it is
+        // destroyed, giving WPA a duration per occurrence.
+        std::unique_ptr<TraceActivity> BeginEngineCommandActivity(int command) const;
+        std::unique_ptr<TraceActivity> BeginConverterCommandActivity(int command) const;
+        std::unique_ptr<TraceActivity> BeginCurrencyLoadActivity() const;
+        std::unique_ptr<TraceActivity> BeginDisplayUpdateActivity() const;
+
         void LogMemoryFlyoutOpenEnd(unsigned int) const;
         void LogInvalidPastedInputOccurred(std::wstring_view reason, CalculatorApp::Common::ViewMode mode, int ProgrammerNumberBase, int bitLengthType);
         void LogValidInputPasted(CalculatorApp::Common::ViewMode mode) const;
@@ -90,6 +134,11 @@ namespace CalculatorApp
         void LogViewClosingTelemetry(int);
         void LogCoreWindowWasNull() const;
 
+        // Log every Nth sampleable record (currently per-keystroke function
+        // usage); dropped records are weighted back in so counts stay
+        // approximately right. An interval of 1 logs everything.
+        static void SetTraceSamplingInterval(unsigned int everyNthRecord);
+
         // Trace methods for Date Calculator usage
         void LogDateDifferenceModeUsed(int windowId);
         void LogDateAddSubtractModeUsed(int windowId, bool isAddMode);
@@ -116,6 +165,20 @@ namespace CalculatorApp
 
         std::unique_ptr<TraceActivity> CreateTraceActivity(std::wstring_view activityName, winrt::Windows::Foundation::Diagnostics::LoggingFields fields) const;
 
+        // Async trace pipeline. Hot paths enqueue TraceRecords lock-free; the
+        // drain thread builds LoggingFields and submits events off the input path.
+        void DrainTraceRecords();
+        void ProcessTraceRecord(const TraceRecord& record);
+        void FlushTraceRecords();
+
+        void LogBitLengthButtonUsedImpl(int windowId);
+        void LogRadixButtonUsedImpl(int windowId);
+        void LogAngleButtonUsedImpl(int windowId);
+        void LogHypButtonUsedImpl(int windowId);
+        void LogDateDifferenceModeUsedImpl(int windowId);
+        void LogDateAddSubtractModeUsedImpl(int windowId, bool isAddMode);
+        void LogValidInputPastedImpl(CalculatorApp::Common::ViewMode mode) const;
+
         winrt::Windows::Foundation::Diagnostics::LoggingChannel g_calculatorProvider;
 
         bool isSizeChangeLogged = false;
@@ -153,5 +216,22 @@ namespace CalculatorApp
         size_t windowLaunchCount = 0;
 
         winrt::Windows::Foundation::Diagnostics::LoggingActivity m_appLaunchActivity;
+
+        std::atomic<bool> m_traceDrainActive{ false };
+        std::thread m_traceDrainThread;
+
+        // Per-command latency histograms and the display-update counter
+        // behind the local diagnostics view. Bucket i counts latencies in
+        // [2^i, 2^(i+1)) microseconds; the last bucket is the catch-all.
+        struct CommandLatencyStats
+        {
+            uint64_t count = 0;
+            uint64_t totalMicroseconds = 0;
+            uint64_t maxMicroseconds = 0;
+            std::array<uint64_t, 16> buckets{};
+        };
+        std::mutex m_localDiagnosticsMutex;
+        std::map<int, CommandLatencyStats> m_commandLatency;
+        uint64_t m_displayUpdateCount = 0;
     };
 }
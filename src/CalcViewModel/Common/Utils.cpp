@@ -100,32 +100,23 @@ void Utils::SerializeCommandsAndTokens(_In_ shared_ptr<CalculatorVector <pair<ws
     _In_ shared_ptr<CalculatorVector<shared_ptr<IExpressionCommand>>> const &commands,
     DataWriter^ writer)
 {
-    unsigned int commandsSize;
-    IFTPlatformException(commands->GetSize(&commandsSize));
-
     // Save the size of the commands vector
-    writer->WriteUInt32(commandsSize);
+    writer->WriteUInt32(static_cast<unsigned int>(commands->size()));
 
-    SerializeCommandVisitor cmdVisitor(writer);
-    for (unsigned int i = 0; i < commandsSize; ++i)
+    // Queue the whole command graph into one in-memory buffer and hand it
+    // to the DataWriter in a single call; the per-field WinRT writes this
+    // replaces dominated suspend-time expression serialization.
+    SerializeCommandVisitor cmdVisitor;
+    for (auto const& exprCmd : *commands)
     {
-        shared_ptr<IExpressionCommand> exprCmd;
-        IFTPlatformException(commands->GetAt(i, &exprCmd));
-
-        CalculationManager::CommandType commandType = exprCmd->GetCommandType();
-        writer->WriteInt32(static_cast<int>(commandType));
-        exprCmd->Accept(cmdVisitor);
+        cmdVisitor.QueueCommand(*exprCmd);
     }
+    cmdVisitor.FlushTo(writer);
 
-    unsigned int tokensSize;
-    IFTPlatformException(tokens->GetSize(&tokensSize));
-    writer->WriteUInt32(tokensSize);
+    writer->WriteUInt32(static_cast<unsigned int>(tokens->size()));
 
-    for (unsigned int i = 0; i < tokensSize; ++i)
+    for (auto const& eachToken : *tokens)
     {
-        pair<wstring, int> eachToken;
-        IFTPlatformException(tokens->GetAt(i, &eachToken));
-
         auto stringData = ref new Platform::String(eachToken.first.c_str());
         auto intData = eachToken.second;
         writer->WriteUInt32(writer->MeasureString(stringData));
@@ -139,13 +130,13 @@ const shared_ptr<CalculatorVector<shared_ptr<IExpressionCommand>>> Utils::Deseri
     shared_ptr<CalculatorVector<shared_ptr<IExpressionCommand>>> commandVector = make_shared<CalculatorVector<shared_ptr<IExpressionCommand>>>();
     auto commandVectorSize = reader->ReadUInt32();
 
+    commandVector->Reserve(commandVectorSize);
     CommandDeserializer cmdDeserializer(reader);
     for (unsigned int i = 0; i < commandVectorSize; ++i)
     {
         auto commandTypeInt = reader->ReadInt32();
         CalculationManager::CommandType commandType = static_cast<CalculationManager::CommandType>(commandTypeInt);
-        shared_ptr<IExpressionCommand> exprCmd = cmdDeserializer.Deserialize(commandType);
-        commandVector->Append(exprCmd);
+        commandVector->Append(cmdDeserializer.Deserialize(commandType));
     }
 
     return commandVector;
@@ -156,15 +147,13 @@ const shared_ptr<CalculatorVector <pair<wstring, int>>> Utils::DeserializeTokens
     shared_ptr<CalculatorVector <pair<wstring, int>>> tokenVector = make_shared<CalculatorVector<pair<wstring, int>>>();
     auto tokensSize = reader->ReadUInt32();
 
+    tokenVector->Reserve(tokensSize);
     for (unsigned int i = 0; i < tokensSize; ++i)
     {
-        pair<wstring, int> eachToken;
         auto stringDataLen = reader->ReadUInt32();
         auto stringData = reader->ReadString(stringDataLen);
         auto intData = reader->ReadInt32();
-        eachToken.first = stringData->Data();
-        eachToken.second = intData;
-        tokenVector->Append(eachToken);
+        tokenVector->EmplaceBack(stringData->Data(), intData);
     }
 
     return tokenVector;
@@ -225,3 +214,93 @@ task<String^> Utils::ReadFileFromFolder(IStorageFolder^ folder, String^ fileName
     String^ contents = co_await FileIO::ReadTextAsync(file);
     co_return contents;
 }
+
+task<void> Utils::WriteBufferToFolder(IStorageFolder^ folder, String^ fileName, IBuffer^ buffer, CreationCollisionOption collisionOption)
+{
+    if (folder == nullptr)
+    {
+        co_return;
+    }
+
+    StorageFile^ file = co_await folder->CreateFileAsync(fileName, collisionOption);
+    if (file == nullptr)
+    {
+        co_return;
+    }
+
+    co_await FileIO::WriteBufferAsync(file, buffer);
+}
+
+task<IBuffer^> Utils::ReadBufferFromFolder(IStorageFolder^ folder, String^ fileName)
+{
+    if (folder == nullptr)
+    {
+        co_return nullptr;
+    }
+
+    StorageFile^ file = co_await folder->GetFileAsync(fileName);
+    if (file == nullptr)
+    {
+        co_return nullptr;
+    }
+
+    IBuffer^ buffer = co_await FileIO::ReadBufferAsync(file);
+    co_return buffer;
+}
+
+task<void> Utils::WriteCompressedBufferToFolder(IStorageFolder^ folder, String^ fileName, IBuffer^ buffer, CreationCollisionOption collisionOption)
+{
+    if (folder == nullptr)
+    {
+        co_return;
+    }
+
+    StorageFile^ file = co_await folder->CreateFileAsync(fileName, collisionOption);
+    if (file == nullptr)
+    {
+        co_return;
+    }
+
+    IRandomAccessStream^ stream = co_await file->OpenAsync(FileAccessMode::ReadWrite);
+    stream->Size = 0;
+
+    auto compressor = ref new Compression::Compressor(stream->GetOutputStreamAt(0));
+    co_await compressor->WriteAsync(buffer);
+    co_await compressor->FinishAsync();
+
+    delete compressor;
+    delete stream;
+}
+
+task<IBuffer^> Utils::ReadCompressedBufferFromFolder(IStorageFolder^ folder, String^ fileName)
+{
+    if (folder == nullptr)
+    {
+        co_return nullptr;
+    }
+
+    StorageFile^ file = co_await folder->GetFileAsync(fileName);
+    if (file == nullptr)
+    {
+        co_return nullptr;
+    }
+
+    IRandomAccessStream^ stream = co_await file->OpenAsync(FileAccessMode::Read);
+    auto decompressor = ref new Compression::Decompressor(stream->GetInputStreamAt(0));
+    DataReader^ reader = ref new DataReader(decompressor);
+
+    constexpr unsigned int chunkSize = 64 * 1024;
+    unsigned int bytesLoaded = 0;
+    do
+    {
+        bytesLoaded = co_await reader->LoadAsync(chunkSize);
+    } while (bytesLoaded > 0);
+
+    IBuffer^ contents = reader->ReadBuffer(reader->UnconsumedBufferLength);
+
+    delete reader;
+    delete decompressor;
+    delete stream;
+
+    co_return contents;
+}
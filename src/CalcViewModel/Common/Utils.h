@@ -21,13 +21,15 @@
     void set(t value) { m_##n = value; }\
     } private: t m_##n; public:
 
+// Change notifications wrap the static name literal in a fast-pass
+// StringReference, so raising one allocates no Platform::String.
 #define OBSERVABLE_PROPERTY_R(t, n)\
     property t n {\
     t get() { return m_##n; }\
     private: void set(t value) {\
     if (m_##n != value) {\
     m_##n = value;\
-    RaisePropertyChanged(L#n);\
+    RaisePropertyChanged(Platform::StringReference(L#n));\
     }}\
     } private: t m_##n; public:
 
@@ -37,7 +39,7 @@
     void set(t value) {\
     if (m_##n != value) {\
     m_##n = value;\
-    RaisePropertyChanged(L#n);\
+    RaisePropertyChanged(Platform::StringReference(L#n));\
     }\
         }\
     } private: t m_##n; public:
@@ -301,6 +303,10 @@ namespace Utils
 
     concurrency::task<void> WriteFileToFolder(Windows::Storage::IStorageFolder^ folder, Platform::String^ fileName, Platform::String^ contents, Windows::Storage::CreationCollisionOption collisionOption);
     concurrency::task<Platform::String^> ReadFileFromFolder(Windows::Storage::IStorageFolder^ folder, Platform::String^ fileName);
+    concurrency::task<void> WriteBufferToFolder(Windows::Storage::IStorageFolder^ folder, Platform::String^ fileName, Windows::Storage::Streams::IBuffer^ buffer, Windows::Storage::CreationCollisionOption collisionOption);
+    concurrency::task<Windows::Storage::Streams::IBuffer^> ReadBufferFromFolder(Windows::Storage::IStorageFolder^ folder, Platform::String^ fileName);
+    concurrency::task<void> WriteCompressedBufferToFolder(Windows::Storage::IStorageFolder^ folder, Platform::String^ fileName, Windows::Storage::Streams::IBuffer^ buffer, Windows::Storage::CreationCollisionOption collisionOption);
+    concurrency::task<Windows::Storage::Streams::IBuffer^> ReadCompressedBufferFromFolder(Windows::Storage::IStorageFolder^ folder, Platform::String^ fileName);
 }
 
 // This goes into the header to define the property, in the public: section of the class
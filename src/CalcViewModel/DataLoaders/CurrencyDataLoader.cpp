@@ -26,7 +26,9 @@ using namespace Windows::Foundation;
 using namespace Windows::Foundation::Collections;
 using namespace Windows::Globalization::DateTimeFormatting;
 using namespace Windows::Globalization::NumberFormatting;
+using namespace Windows::Security::Cryptography;
 using namespace Windows::Storage;
+using namespace Windows::Storage::Streams;
 using namespace Windows::System::UserProfile;
 using namespace Windows::UI::Core;
 using namespace Windows::Web::Http;
@@ -43,6 +45,8 @@ static constexpr int FORMATTER_DIGIT_COUNT = 4;
 
 static constexpr auto CACHE_TIMESTAMP_KEY = L"CURRENCY_CONVERTER_TIMESTAMP";
 static constexpr auto CACHE_LANGCODE_KEY = L"CURRENCY_CONVERTER_LANGCODE";
+static constexpr auto CACHE_METADATA_ETAG_KEY = L"CURRENCY_CONVERTER_METADATA_ETAG";
+static constexpr auto CACHE_RATIOS_ETAG_KEY = L"CURRENCY_CONVERTER_RATIOS_ETAG";
 static constexpr auto CACHE_DELIMITER = L"%";
 
 static constexpr auto STATIC_DATA_FILENAME = L"CURRENCY_CONVERTER_STATIC_DATA.txt";
@@ -54,6 +58,12 @@ static constexpr array<wstring_view, 5> STATIC_DATA_PROPERTIES = {
     wstring_view{ L"CurrencySymbol", 14 }
 };
 
+// Parsed currency data persisted as a compact binary blob so the
+// open-converter path can skip re-parsing the JSON payloads.
+static constexpr auto PARSED_DATA_FILENAME = L"CURRENCY_CONVERTER_PARSED_DATA.bin";
+static constexpr unsigned int PARSED_DATA_MAGIC = 0x43435044; // 'CCPD'
+static constexpr unsigned int PARSED_DATA_VERSION = 1;
+
 static constexpr auto ALL_RATIOS_DATA_FILENAME = L"CURRENCY_CONVERTER_ALL_RATIOS_DATA.txt";
 static constexpr auto RATIO_KEY = L"Rt";
 static constexpr auto CURRENCY_CODE_KEY = L"An";
@@ -70,6 +80,19 @@ static constexpr auto TO_KEY = L"to";
 static constexpr auto DEFAULT_FROM_CURRENCY = DefaultCurrencyCode.data();
 static constexpr auto DEFAULT_TO_CURRENCY = L"EUR";
 
+// Session-lifetime snapshot of the parsed currency data. A loader created
+// later in the same process (another window, a converter rebuilt after its
+// view model was released) starts from this snapshot instead of re-reading
+// and re-parsing the ApplicationData cache. Every completed disk or web
+// load overwrites it, so the refresh scheduler is also what invalidates it.
+// The payload is plain std data guarded by the mutex.
+static mutex s_sessionCacheMutex;
+static bool s_sessionCacheValid = false;
+static wstring s_sessionCacheLanguage;
+static DateTime s_sessionCacheTimestamp;
+static vector<CurrencyStaticData> s_sessionCacheStaticData;
+static CurrencyRatioMap s_sessionCacheRatioMap;
+
 namespace CalculatorApp
 {
     namespace ViewModel
@@ -84,6 +107,8 @@ namespace CalculatorApp
         {
             StringReference CacheTimestampKey(CACHE_TIMESTAMP_KEY);
             StringReference CacheLangcodeKey(CACHE_LANGCODE_KEY);
+            StringReference CacheMetadataETagKey(CACHE_METADATA_ETAG_KEY);
+            StringReference CacheRatiosETagKey(CACHE_RATIOS_ETAG_KEY);
             StringReference CacheDelimiter(CACHE_DELIMITER);
             StringReference StaticDataFilename(STATIC_DATA_FILENAME);
             StringReference AllRatiosDataFilename(ALL_RATIOS_DATA_FILENAME);
@@ -99,12 +124,11 @@ CurrencyDataLoader::CurrencyDataLoader(_In_ unique_ptr<ICurrencyHttpClient> clie
     m_ratioFormat(L""),
     m_timestampFormat(L""),
     m_networkManager(ref new NetworkManager()),
-    m_meteredOverrideSet(false)
+    m_meteredOverrideSet(false),
+    m_refreshDeferred(false),
+    m_refreshInFlight(false)
 {
-    if (GlobalizationPreferences::Languages->Size > 0)
-    {
-        m_responseLanguage = GlobalizationPreferences::Languages->GetAt(0);
-    }
+    m_responseLanguage = LocalizationService::GetPreferredLanguage();
 
     if (m_client != nullptr)
     {
@@ -157,6 +181,14 @@ void CurrencyDataLoader::OnNetworkBehaviorChanged(NetworkAccessBehavior newBehav
     {
         m_vmCallback->NetworkBehaviorChanged(static_cast<int>(m_networkAccessBehavior));
     }
+
+    // A stale refresh deferred while the network was metered or offline
+    // waits for an unrestricted network and a converter actually listening;
+    // until then the cached snapshot keeps being served.
+    if (newBehavior == NetworkAccessBehavior::Normal && m_refreshDeferred && m_vmCallback != nullptr && LoadFinished())
+    {
+        StartBackgroundRatiosRefresh();
+    }
 }
 
 bool CurrencyDataLoader::LoadFinished()
@@ -186,6 +218,10 @@ void CurrencyDataLoader::LoadData()
 
     if (!LoadFinished())
     {
+        // Span the whole cache-or-web load up to the point the UI hears the
+        // result; the stale-cache background refresh stays outside it.
+        shared_ptr<TraceActivity> loadSpan = TraceLogger::GetInstance().BeginCurrencyLoadActivity();
+
         create_task([this]() -> task<bool>
         {
             vector<function<task<bool>()>> loadFunctions = {
@@ -204,15 +240,65 @@ void CurrencyDataLoader::LoadData()
             }
 
             co_return didLoad;
-        }).then([this](bool didLoad)
+        }).then([this, loadSpan](bool didLoad) mutable
         {
             UpdateDisplayedTimestamp();
             NotifyDataLoadFinished(didLoad);
+            loadSpan.reset();
+
+            // The cache path serves the persisted snapshot without waiting on
+            // the network. If that snapshot is stale, refresh it in the
+            // background and hot-swap the ratios when the download arrives.
+            if (didLoad && m_loadStatus == CurrencyLoadStatus::LoadedFromCache
+                && Utils::IsDateTimeOlderThan(m_cacheTimestamp, DAY_DURATION))
+            {
+                if (m_networkAccessBehavior == NetworkAccessBehavior::Normal)
+                {
+                    StartBackgroundRatiosRefresh();
+                }
+                else
+                {
+                    // Metered or offline: keep serving the cached snapshot
+                    // and remember it is stale, so the refresh runs once an
+                    // unrestricted network comes back instead of refetching
+                    // on every status event.
+                    m_refreshDeferred = true;
+                }
+            }
         }, task_continuation_context::use_current());
     }
 };
 #pragma optimize("", on)
 
+// Refreshes the ratios over the web behind the snapshot being presented,
+// hot-swapping them when the download arrives. At most one refresh runs at
+// a time; triggers that arrive while one is in flight coalesce into it.
+void CurrencyDataLoader::StartBackgroundRatiosRefresh()
+{
+    if (m_refreshInFlight)
+    {
+        return;
+    }
+
+    m_refreshInFlight = true;
+    m_refreshDeferred = false;
+    create_task([this]() { return TryLoadDataFromWebAsync(); }).then([this](bool didRefresh)
+    {
+        m_refreshInFlight = false;
+        if (didRefresh)
+        {
+            UpdateDisplayedTimestamp();
+            NotifyDataLoadFinished(true);
+        }
+        else
+        {
+            // Keep presenting the cached snapshot; the refresh can
+            // be retried from the UI or on a network change.
+            m_loadStatus = CurrencyLoadStatus::LoadedFromCache;
+        }
+    }, task_continuation_context::use_current());
+}
+
 vector<UCM::Category> CurrencyDataLoader::LoadOrderedCategories()
 {
     // This function should not be called
@@ -316,24 +402,26 @@ task<bool> CurrencyDataLoader::TryLoadDataFromCacheAsync()
     {
         ResetLoadStatus();
 
+        // Session fast path: a loader earlier in this process already parsed
+        // the cache, so re-entering Currency skips the disk reads entirely.
+        if (co_await TryLoadDataFromSessionCacheAsync())
+        {
+            co_return true;
+        }
+
         auto localSettings = ApplicationData::Current->LocalSettings;
         if (localSettings == nullptr || !localSettings->Values->HasKey(CacheTimestampKey))
         {
             co_return false;
         }
 
-        bool loadComplete = false;
         m_cacheTimestamp = static_cast<DateTime>(localSettings->Values->Lookup(CacheTimestampKey));
-        if (Utils::IsDateTimeOlderThan(m_cacheTimestamp, DAY_DURATION)
-            && m_networkAccessBehavior == NetworkAccessBehavior::Normal)
-        {
-            loadComplete = co_await TryLoadDataFromWebAsync();
-        }
 
-        if (!loadComplete)
-        {
-            loadComplete = co_await TryFinishLoadFromCacheAsync();
-        }
+        // Offline-first: serve the persisted snapshot even when it is older
+        // than a day, so the first conversion never waits on the network.
+        // LoadData refreshes a stale snapshot in the background once the
+        // cached data is on screen.
+        bool loadComplete = co_await TryFinishLoadFromCacheAsync();
 
         co_return loadComplete;
     }
@@ -353,6 +441,51 @@ task<bool> CurrencyDataLoader::TryLoadDataFromCacheAsync()
     }
 }
 
+// Serves the snapshot another load in this process already parsed. The
+// snapshot carries the persisted cache's timestamp, so LoadData's staleness
+// check and the background refresh behave exactly as after a disk load.
+task<bool> CurrencyDataLoader::TryLoadDataFromSessionCacheAsync()
+{
+    vector<UCM::CurrencyStaticData> staticData{};
+    CurrencyRatioMap ratioMap{};
+
+    {
+        lock_guard<mutex> lock(s_sessionCacheMutex);
+        if (!s_sessionCacheValid || m_responseLanguage == nullptr || s_sessionCacheLanguage != m_responseLanguage->Data())
+        {
+            co_return false;
+        }
+
+        staticData = s_sessionCacheStaticData;
+        ratioMap = s_sessionCacheRatioMap;
+        m_cacheTimestamp = s_sessionCacheTimestamp;
+    }
+
+    m_loadStatus = CurrencyLoadStatus::LoadedFromCache;
+    co_await FinalizeUnits(staticData, ratioMap);
+
+    co_return true;
+}
+
+void CurrencyDataLoader::InvalidateSessionCache()
+{
+    lock_guard<mutex> lock(s_sessionCacheMutex);
+    s_sessionCacheValid = false;
+    s_sessionCacheLanguage.clear();
+    s_sessionCacheStaticData.clear();
+    s_sessionCacheRatioMap.clear();
+}
+
+void CurrencyDataLoader::UpdateSessionCache(_In_ const vector<UCM::CurrencyStaticData>& staticData, _In_ const CurrencyRatioMap& ratioMap)
+{
+    lock_guard<mutex> lock(s_sessionCacheMutex);
+    s_sessionCacheStaticData = staticData;
+    s_sessionCacheRatioMap = ratioMap;
+    s_sessionCacheLanguage = m_responseLanguage != nullptr ? m_responseLanguage->Data() : L"";
+    s_sessionCacheTimestamp = m_cacheTimestamp;
+    s_sessionCacheValid = true;
+}
+
 task<bool> CurrencyDataLoader::TryFinishLoadFromCacheAsync()
 {
     auto localSettings = ApplicationData::Current->LocalSettings;
@@ -373,28 +506,78 @@ task<bool> CurrencyDataLoader::TryFinishLoadFromCacheAsync()
         co_return false;
     }
 
-    String^ staticDataResponse = co_await Utils::ReadFileFromFolder(localCacheFolder, StaticDataFilename);
-    String^ allRatiosResponse = co_await Utils::ReadFileFromFolder(localCacheFolder, AllRatiosDataFilename);
-
     vector<UCM::CurrencyStaticData> staticData{};
     CurrencyRatioMap ratioMap{};
 
-    bool didParse = TryParseWebResponses(
-        staticDataResponse,
-        allRatiosResponse,
-        staticData,
-        ratioMap);
+    // Fast path: the parsed result of the last load is persisted as a binary
+    // blob, so one read and a bulk deserialize replaces the JSON parse.
+    bool didParse = false;
+    try
+    {
+        IBuffer^ parsedDataBuffer = co_await Utils::ReadCompressedBufferFromFolder(localCacheFolder, StringReference(PARSED_DATA_FILENAME));
+        didParse = TryDeserializeParsedData(parsedDataBuffer, staticData, ratioMap);
+    }
+    catch (...)
+    {
+        // A missing blob just means the cache predates the binary format.
+    }
+
     if (!didParse)
     {
-        co_return false;
+        String^ staticDataResponse = co_await ReadCachedPayloadAsync(localCacheFolder, StaticDataFilename);
+        String^ allRatiosResponse = co_await ReadCachedPayloadAsync(localCacheFolder, AllRatiosDataFilename);
+
+        didParse = TryParseWebResponses(
+            staticDataResponse,
+            allRatiosResponse,
+            staticData,
+            ratioMap);
+        if (!didParse)
+        {
+            co_return false;
+        }
+
+        try
+        {
+            // Upgrade the cache in place so the next launch takes the fast path.
+            co_await Utils::WriteCompressedBufferToFolder(
+                localCacheFolder,
+                StringReference(PARSED_DATA_FILENAME),
+                SerializeParsedData(staticData, ratioMap),
+                CreationCollisionOption::ReplaceExisting);
+        }
+        catch (...)
+        {
+            // If we fail to save the blob it's okay, the JSON payloads remain.
+        }
     }
 
     m_loadStatus = CurrencyLoadStatus::LoadedFromCache;
+    UpdateSessionCache(staticData, ratioMap);
     co_await FinalizeUnits(staticData, ratioMap);
 
     co_return true;
 }
 
+task<String^> CurrencyDataLoader::ReadCachedPayloadAsync(IStorageFolder^ folder, String^ fileName)
+{
+    try
+    {
+        IBuffer^ compressed = co_await Utils::ReadCompressedBufferFromFolder(folder, fileName);
+        if (compressed != nullptr && compressed->Length > 0)
+        {
+            co_return CryptographicBuffer::ConvertBinaryToString(BinaryStringEncoding::Utf8, compressed);
+        }
+    }
+    catch (...)
+    {
+        // Fall through to the plain-text read below.
+    }
+
+    // Caches written before compression store the payload as plain text.
+    co_return co_await Utils::ReadFileFromFolder(folder, fileName);
+}
+
 task<bool> CurrencyDataLoader::TryLoadDataFromWebAsync()
 {
     try
@@ -412,8 +595,42 @@ task<bool> CurrencyDataLoader::TryLoadDataFromWebAsync()
             co_return false;
         }
 
-        String^ staticDataResponse = co_await m_client->GetCurrencyMetadata();
-        String^ allRatiosResponse = co_await m_client->GetCurrencyRatios();
+        String^ cachedMetadataETag = nullptr;
+        String^ cachedRatiosETag = nullptr;
+        auto localSettings = ApplicationData::Current->LocalSettings;
+        if (localSettings != nullptr)
+        {
+            if (localSettings->Values->HasKey(CacheMetadataETagKey))
+            {
+                cachedMetadataETag = static_cast<String^>(localSettings->Values->Lookup(CacheMetadataETagKey));
+            }
+            if (localSettings->Values->HasKey(CacheRatiosETagKey))
+            {
+                cachedRatiosETag = static_cast<String^>(localSettings->Values->Lookup(CacheRatiosETagKey));
+            }
+        }
+        m_client->SetCachedETags(cachedMetadataETag, cachedRatiosETag);
+
+        // Start both requests before awaiting either so the metadata and
+        // ratios downloads overlap instead of running back to back.
+        auto staticDataOperation = m_client->GetCurrencyMetadata();
+        auto allRatiosOperation = m_client->GetCurrencyRatios();
+
+        String^ staticDataResponse = co_await staticDataOperation;
+        String^ allRatiosResponse = co_await allRatiosOperation;
+
+        // A null response where we sent an ETag is a 304 Not Modified; the
+        // cached copy of that payload is still current, so reuse it.
+        StorageFolder^ cacheFolder = ApplicationData::Current->LocalCacheFolder;
+        if (staticDataResponse == nullptr && cachedMetadataETag != nullptr && cacheFolder != nullptr)
+        {
+            staticDataResponse = co_await ReadCachedPayloadAsync(cacheFolder, StaticDataFilename);
+        }
+        if (allRatiosResponse == nullptr && cachedRatiosETag != nullptr && cacheFolder != nullptr)
+        {
+            allRatiosResponse = co_await ReadCachedPayloadAsync(cacheFolder, AllRatiosDataFilename);
+        }
+
         if (staticDataResponse == nullptr || allRatiosResponse == nullptr)
         {
             co_return false;
@@ -445,13 +662,21 @@ task<bool> CurrencyDataLoader::TryLoadDataFromWebAsync()
             StorageFolder^ localCacheFolder = ApplicationData::Current->LocalCacheFolder;
             for (const auto& fileInfo : cachedFiles)
             {
-                co_await Utils::WriteFileToFolder(
+                // The JSON payloads compress well; storing them compressed
+                // keeps the cache folder small and cuts startup disk I/O.
+                co_await Utils::WriteCompressedBufferToFolder(
                     localCacheFolder,
                     fileInfo.first,
-                    fileInfo.second,
+                    CryptographicBuffer::ConvertStringToBinary(fileInfo.second, BinaryStringEncoding::Utf8),
                     CreationCollisionOption::ReplaceExisting);
             }
 
+            co_await Utils::WriteCompressedBufferToFolder(
+                localCacheFolder,
+                StringReference(PARSED_DATA_FILENAME),
+                SerializeParsedData(staticData, ratioMap),
+                CreationCollisionOption::ReplaceExisting);
+
             SaveLangCodeAndTimestamp();
         }
         catch (...)
@@ -460,6 +685,7 @@ task<bool> CurrencyDataLoader::TryLoadDataFromWebAsync()
         }
 
         m_loadStatus = CurrencyLoadStatus::LoadedFromWeb;
+        UpdateSessionCache(staticData, ratioMap);
         co_await FinalizeUnits(staticData, ratioMap);
 
         co_return true;
@@ -555,33 +781,431 @@ bool CurrencyDataLoader::TryParseStaticData(_In_ String^ rawJson, _Inout_ vector
     return true;
 }
 
+static const wchar_t* SkipJsonWhitespace(const wchar_t* cursor, const wchar_t* end)
+{
+    while (cursor < end && (*cursor == L' ' || *cursor == L'\t' || *cursor == L'\r' || *cursor == L'\n'))
+    {
+        ++cursor;
+    }
+
+    return cursor;
+}
+
+// Parses a JSON string literal at cursor into value and returns the position
+// past the closing quote, or nullptr if the input is malformed.
+static const wchar_t* ParseJsonString(const wchar_t* cursor, const wchar_t* end, _Inout_ wstring& value)
+{
+    if (cursor >= end || *cursor != L'"')
+    {
+        return nullptr;
+    }
+
+    value.clear();
+    for (++cursor; cursor < end; ++cursor)
+    {
+        if (*cursor == L'"')
+        {
+            return cursor + 1;
+        }
+
+        if (*cursor != L'\\')
+        {
+            value.push_back(*cursor);
+            continue;
+        }
+
+        if (++cursor >= end)
+        {
+            return nullptr;
+        }
+
+        switch (*cursor)
+        {
+        case L'"':
+        case L'\\':
+        case L'/':
+            value.push_back(*cursor);
+            break;
+        case L'b':
+            value.push_back(L'\b');
+            break;
+        case L'f':
+            value.push_back(L'\f');
+            break;
+        case L'n':
+            value.push_back(L'\n');
+            break;
+        case L'r':
+            value.push_back(L'\r');
+            break;
+        case L't':
+            value.push_back(L'\t');
+            break;
+        case L'u':
+        {
+            if (cursor + 4 >= end)
+            {
+                return nullptr;
+            }
+
+            wchar_t codeUnit = 0;
+            for (int i = 0; i < 4; i++)
+            {
+                wchar_t digit = *++cursor;
+                if (digit >= L'0' && digit <= L'9')
+                {
+                    codeUnit = codeUnit * 16 + (digit - L'0');
+                }
+                else if (digit >= L'a' && digit <= L'f')
+                {
+                    codeUnit = codeUnit * 16 + (digit - L'a' + 10);
+                }
+                else if (digit >= L'A' && digit <= L'F')
+                {
+                    codeUnit = codeUnit * 16 + (digit - L'A' + 10);
+                }
+                else
+                {
+                    return nullptr;
+                }
+            }
+
+            value.push_back(codeUnit);
+            break;
+        }
+        default:
+            return nullptr;
+        }
+    }
+
+    return nullptr;
+}
+
+// Skips a complete JSON value (scalar, object, or array) at cursor and
+// returns the position past it, or nullptr if the input is malformed.
+static const wchar_t* SkipJsonValue(const wchar_t* cursor, const wchar_t* end)
+{
+    cursor = SkipJsonWhitespace(cursor, end);
+    if (cursor >= end)
+    {
+        return nullptr;
+    }
+
+    if (*cursor == L'"')
+    {
+        wstring unused;
+        return ParseJsonString(cursor, end, unused);
+    }
+
+    if (*cursor == L'{' || *cursor == L'[')
+    {
+        int depth = 0;
+        while (cursor < end)
+        {
+            if (*cursor == L'"')
+            {
+                wstring unused;
+                cursor = ParseJsonString(cursor, end, unused);
+                if (cursor == nullptr)
+                {
+                    return nullptr;
+                }
+                continue;
+            }
+
+            if (*cursor == L'{' || *cursor == L'[')
+            {
+                ++depth;
+            }
+            else if (*cursor == L'}' || *cursor == L']')
+            {
+                if (--depth == 0)
+                {
+                    return cursor + 1;
+                }
+            }
+
+            ++cursor;
+        }
+
+        return nullptr;
+    }
+
+    // Number, true, false, or null.
+    const wchar_t* start = cursor;
+    while (cursor < end && *cursor != L',' && *cursor != L'}' && *cursor != L']'
+        && *cursor != L' ' && *cursor != L'\t' && *cursor != L'\r' && *cursor != L'\n')
+    {
+        ++cursor;
+    }
+
+    return cursor > start ? cursor : nullptr;
+}
+
 bool CurrencyDataLoader::TryParseAllRatiosData(_In_ String^ rawJson, _Inout_ CurrencyRatioMap& allRatios)
 {
-    JsonArray^ data = nullptr;
-    if (!JsonArray::TryParse(rawJson, &data))
+    if (rawJson == nullptr)
+    {
+        return false;
+    }
+
+    // The payload is a flat array of small objects, so stream over the raw
+    // text and pluck the two members we keep instead of materializing the
+    // whole response as a JsonArray DOM first.
+    const wchar_t* cursor = rawJson->Data();
+    const wchar_t* end = cursor + rawJson->Length();
+
+    cursor = SkipJsonWhitespace(cursor, end);
+    if (cursor >= end || *cursor != L'[')
     {
         return false;
     }
+    ++cursor;
+
+    // Preallocate from a cheap object count so the map never rehashes.
+    size_t entryEstimate = count(cursor, end, L'{');
 
     wstring sourceCurrencyCode{ DefaultCurrencyCode };
 
     allRatios.clear();
-    for (unsigned int i = 0; i < data->Size; i++)
+    allRatios.reserve(entryEstimate);
+
+    cursor = SkipJsonWhitespace(cursor, end);
+    if (cursor < end && *cursor == L']')
     {
-        JsonObject^ obj = data->GetAt(i)->GetObject();
+        return true;
+    }
+
+    wstring key;
+    wstring stringValue;
+    while (cursor < end)
+    {
+        cursor = SkipJsonWhitespace(cursor, end);
+        if (cursor >= end || *cursor != L'{')
+        {
+            return false;
+        }
+        ++cursor;
 
         // Rt is ratio, An is target currency ISO code.
-        double relativeRatio = obj->GetNamedNumber(StringReference(RATIO_KEY));
-        wstring targetCurrencyCode = obj->GetNamedString(StringReference(CURRENCY_CODE_KEY))->Data();
+        double relativeRatio = 0.0;
+        wstring targetCurrencyCode;
+        bool sawRatio = false;
+        bool sawCurrencyCode = false;
+
+        while (true)
+        {
+            cursor = SkipJsonWhitespace(cursor, end);
+            if (cursor >= end)
+            {
+                return false;
+            }
+
+            if (*cursor == L'}')
+            {
+                ++cursor;
+                break;
+            }
+
+            if (*cursor == L',')
+            {
+                ++cursor;
+                continue;
+            }
+
+            cursor = ParseJsonString(cursor, end, key);
+            if (cursor == nullptr)
+            {
+                return false;
+            }
+
+            cursor = SkipJsonWhitespace(cursor, end);
+            if (cursor >= end || *cursor != L':')
+            {
+                return false;
+            }
+            ++cursor;
+            cursor = SkipJsonWhitespace(cursor, end);
+
+            if (key == RATIO_KEY)
+            {
+                wchar_t* numberEnd = nullptr;
+                relativeRatio = wcstod(cursor, &numberEnd);
+                if (numberEnd == cursor)
+                {
+                    return false;
+                }
+
+                cursor = numberEnd;
+                sawRatio = true;
+            }
+            else if (key == CURRENCY_CODE_KEY)
+            {
+                cursor = ParseJsonString(cursor, end, stringValue);
+                if (cursor == nullptr)
+                {
+                    return false;
+                }
+
+                targetCurrencyCode = stringValue;
+                sawCurrencyCode = true;
+            }
+            else
+            {
+                cursor = SkipJsonValue(cursor, end);
+                if (cursor == nullptr)
+                {
+                    return false;
+                }
+            }
+        }
+
+        if (!sawRatio || !sawCurrencyCode)
+        {
+            return false;
+        }
 
         allRatios.emplace(targetCurrencyCode, CurrencyRatio{
             relativeRatio,
             sourceCurrencyCode,
             targetCurrencyCode
         });
+
+        cursor = SkipJsonWhitespace(cursor, end);
+        if (cursor < end && *cursor == L',')
+        {
+            ++cursor;
+            continue;
+        }
+
+        if (cursor < end && *cursor == L']')
+        {
+            return true;
+        }
+
+        return false;
     }
 
-    return true;
+    return false;
+}
+
+IBuffer^ CurrencyDataLoader::SerializeParsedData(
+    _In_ const vector<UCM::CurrencyStaticData>& staticData,
+    _In_ const CurrencyRatioMap& allRatiosData)
+{
+    DataWriter^ writer = ref new DataWriter();
+    writer->UnicodeEncoding = UnicodeEncoding::Utf16LE;
+
+    auto writeString = [writer](const wstring& value)
+    {
+        writer->WriteUInt32(static_cast<unsigned int>(value.size()));
+        if (!value.empty())
+        {
+            writer->WriteString(StringReference(value.c_str(), static_cast<unsigned int>(value.size())));
+        }
+    };
+
+    writer->WriteUInt32(PARSED_DATA_MAGIC);
+    writer->WriteUInt32(PARSED_DATA_VERSION);
+    writer->WriteInt64(m_cacheTimestamp.UniversalTime);
+
+    writer->WriteUInt32(static_cast<unsigned int>(staticData.size()));
+    for (const UCM::CurrencyStaticData& unit : staticData)
+    {
+        writeString(unit.countryCode);
+        writeString(unit.countryName);
+        writeString(unit.currencyCode);
+        writeString(unit.currencyName);
+        writeString(unit.currencySymbol);
+    }
+
+    writer->WriteUInt32(static_cast<unsigned int>(allRatiosData.size()));
+    for (const auto& ratio : allRatiosData)
+    {
+        writeString(ratio.first);
+        writer->WriteDouble(ratio.second.ratio);
+        writeString(ratio.second.sourceCurrencyCode);
+        writeString(ratio.second.targetCurrencyCode);
+    }
+
+    return writer->DetachBuffer();
+}
+
+bool CurrencyDataLoader::TryDeserializeParsedData(
+    _In_ IBuffer^ buffer,
+    _Inout_ vector<UCM::CurrencyStaticData>& staticData,
+    _Inout_ CurrencyRatioMap& allRatiosData)
+{
+    if (buffer == nullptr)
+    {
+        return false;
+    }
+
+    try
+    {
+        DataReader^ reader = DataReader::FromBuffer(buffer);
+        reader->UnicodeEncoding = UnicodeEncoding::Utf16LE;
+
+        auto readString = [reader]()
+        {
+            unsigned int length = reader->ReadUInt32();
+            return length == 0 ? wstring{} : wstring{ reader->ReadString(length)->Data() };
+        };
+
+        if (reader->ReadUInt32() != PARSED_DATA_MAGIC || reader->ReadUInt32() != PARSED_DATA_VERSION)
+        {
+            return false;
+        }
+
+        // The blob must describe the same download the cache bookkeeping does;
+        // a stale blob falls back to the JSON payloads.
+        if (reader->ReadInt64() != m_cacheTimestamp.UniversalTime)
+        {
+            return false;
+        }
+
+        unsigned int staticDataCount = reader->ReadUInt32();
+        staticData.resize(size_t{ staticDataCount });
+        for (unsigned int i = 0; i < staticDataCount; i++)
+        {
+            wstring countryCode = readString();
+            wstring countryName = readString();
+            wstring currencyCode = readString();
+            wstring currencyName = readString();
+            wstring currencySymbol = readString();
+
+            staticData[i] = CurrencyStaticData{
+                countryCode,
+                countryName,
+                currencyCode,
+                currencyName,
+                currencySymbol
+            };
+        }
+
+        allRatiosData.clear();
+        unsigned int ratioCount = reader->ReadUInt32();
+        for (unsigned int i = 0; i < ratioCount; i++)
+        {
+            wstring targetKey = readString();
+            double ratio = reader->ReadDouble();
+            wstring sourceCurrencyCode = readString();
+            wstring targetCurrencyCode = readString();
+
+            allRatiosData.emplace(targetKey, CurrencyRatio{
+                ratio,
+                sourceCurrencyCode,
+                targetCurrencyCode
+            });
+        }
+
+        return true;
+    }
+    catch (...)
+    {
+        // A truncated or corrupt blob falls back to the JSON payloads.
+        return false;
+    }
 }
 
 // FinalizeUnits
@@ -710,6 +1334,23 @@ void CurrencyDataLoader::SaveLangCodeAndTimestamp()
 
     localSettings->Values->Insert(CacheTimestampKey, m_cacheTimestamp);
     localSettings->Values->Insert(CacheLangcodeKey, m_responseLanguage);
+
+    if (m_client != nullptr)
+    {
+        // Persist the response validators so the next refresh can make
+        // conditional requests and skip re-downloading unchanged payloads.
+        String^ metadataETag = m_client->GetMetadataETag();
+        if (metadataETag != nullptr)
+        {
+            localSettings->Values->Insert(CacheMetadataETagKey, metadataETag);
+        }
+
+        String^ ratiosETag = m_client->GetRatiosETag();
+        if (ratiosETag != nullptr)
+        {
+            localSettings->Values->Insert(CacheRatiosETagKey, ratiosETag);
+        }
+    }
 }
 
 void CurrencyDataLoader::UpdateDisplayedTimestamp()
@@ -29,6 +29,8 @@ namespace CalculatorApp
         {
             extern Platform::StringReference CacheTimestampKey;
             extern Platform::StringReference CacheLangcodeKey;
+            extern Platform::StringReference CacheMetadataETagKey;
+            extern Platform::StringReference CacheRatiosETagKey;
             extern Platform::StringReference CacheDelimiter;
             extern Platform::StringReference StaticDataFilename;
             extern Platform::StringReference AllRatiosDataFilename;
@@ -79,11 +81,20 @@ namespace CalculatorApp
 
             void OnNetworkBehaviorChanged(CalculatorApp::NetworkAccessBehavior newBehavior);
 
+            // Drops the process-wide session snapshot so the next load goes
+            // back to the ApplicationData cache. Used by tests that exercise
+            // the disk path.
+            static void InvalidateSessionCache();
+
         private:
             void ResetLoadStatus();
             void NotifyDataLoadFinished(bool didLoad);
+            void StartBackgroundRatiosRefresh();
 
+            concurrency::task<bool> TryLoadDataFromSessionCacheAsync();
             concurrency::task<bool> TryFinishLoadFromCacheAsync();
+            void UpdateSessionCache(_In_ const std::vector<UCM::CurrencyStaticData>& staticData, _In_ const CurrencyRatioMap& ratioMap);
+            concurrency::task<Platform::String^> ReadCachedPayloadAsync(Windows::Storage::IStorageFolder^ folder, Platform::String^ fileName);
 
             bool TryParseWebResponses(
                 _In_ Platform::String^ staticDataJson,
@@ -92,6 +103,13 @@ namespace CalculatorApp
                 _Inout_ CurrencyRatioMap& allRatiosData);
             bool TryParseStaticData(_In_ Platform::String^ rawJson, _Inout_ std::vector<UCM::CurrencyStaticData>& staticData);
             bool TryParseAllRatiosData(_In_ Platform::String^ rawJson, _Inout_ CurrencyRatioMap& allRatiosData);
+            Windows::Storage::Streams::IBuffer^ SerializeParsedData(
+                _In_ const std::vector<UCM::CurrencyStaticData>& staticData,
+                _In_ const CurrencyRatioMap& allRatiosData);
+            bool TryDeserializeParsedData(
+                _In_ Windows::Storage::Streams::IBuffer^ buffer,
+                _Inout_ std::vector<UCM::CurrencyStaticData>& staticData,
+                _Inout_ CurrencyRatioMap& allRatiosData);
             concurrency::task<void> FinalizeUnits(_In_ const std::vector<UCM::CurrencyStaticData>& staticData, _In_ const CurrencyRatioMap& ratioMap);
             void GuaranteeSelectedUnits();
 
@@ -129,6 +147,13 @@ namespace CalculatorApp
             CalculatorApp::NetworkAccessBehavior m_networkAccessBehavior;
             Windows::Foundation::EventRegistrationToken m_networkBehaviorToken;
             bool m_meteredOverrideSet;
+
+            // Set when stale data was found while the network did not allow
+            // a refresh; the refresh runs when an unrestricted network comes
+            // back. m_refreshInFlight keeps concurrent triggers from
+            // stacking redundant downloads.
+            bool m_refreshDeferred;
+            bool m_refreshInFlight;
         };
     }
 }
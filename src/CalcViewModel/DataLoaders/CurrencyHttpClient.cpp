@@ -5,6 +5,7 @@
 #include "CurrencyHttpClient.h"
 
 using namespace CalculatorApp::DataLoaders;
+using namespace concurrency;
 using namespace Platform;
 using namespace std;
 using namespace Windows::Foundation;
@@ -14,11 +15,18 @@ static constexpr auto sc_MetadataUriLocalizeFor = L"https://go.microsoft.com/fwl
 static constexpr auto sc_RatiosUriRelativeTo = L"https://go.microsoft.com/fwlink/?linkid=2041339&localCurrency=";
 
 CurrencyHttpClient::CurrencyHttpClient() :
-    m_client(ref new HttpClient()),
     m_responseLanguage(L"en-US")
 {
 }
 
+HttpClient^ CurrencyHttpClient::SharedClient()
+{
+    // Magic-static initialization is thread-safe, and HttpClient is agile,
+    // so loaders on any thread can send through the same instance.
+    static HttpClient^ s_sharedClient = ref new HttpClient();
+    return s_sharedClient;
+}
+
 void CurrencyHttpClient::SetSourceCurrencyCode(String^ sourceCurrencyCode)
 {
     m_sourceCurrencyCode = sourceCurrencyCode;
@@ -34,7 +42,7 @@ IAsyncOperationWithProgress<String^, HttpProgress>^ CurrencyHttpClient::GetCurre
     wstring uri = wstring{ sc_MetadataUriLocalizeFor } + m_responseLanguage->Data();
     auto metadataUri = ref new Uri(StringReference(uri.c_str()));
 
-    return m_client->GetStringAsync(metadataUri);
+    return SendConditionalGetAsync(metadataUri, m_cachedMetadataETag, &m_metadataETag);
 }
 
 IAsyncOperationWithProgress<String^, HttpProgress>^ CurrencyHttpClient::GetCurrencyRatios()
@@ -42,5 +50,52 @@ IAsyncOperationWithProgress<String^, HttpProgress>^ CurrencyHttpClient::GetCurre
     wstring uri = wstring{ sc_RatiosUriRelativeTo } + m_sourceCurrencyCode->Data();
     auto ratiosUri = ref new Uri(StringReference(uri.c_str()));
 
-    return m_client->GetStringAsync(ratiosUri);
+    return SendConditionalGetAsync(ratiosUri, m_cachedRatiosETag, &m_ratiosETag);
+}
+
+void CurrencyHttpClient::SetCachedETags(String^ metadataETag, String^ ratiosETag)
+{
+    m_cachedMetadataETag = metadataETag;
+    m_cachedRatiosETag = ratiosETag;
+}
+
+String^ CurrencyHttpClient::GetMetadataETag()
+{
+    return m_metadataETag;
+}
+
+String^ CurrencyHttpClient::GetRatiosETag()
+{
+    return m_ratiosETag;
+}
+
+IAsyncOperationWithProgress<String^, HttpProgress>^ CurrencyHttpClient::SendConditionalGetAsync(
+    Uri^ uri,
+    String^ cachedETag,
+    String^* responseETag)
+{
+    auto request = ref new HttpRequestMessage(HttpMethod::Get, uri);
+    if (cachedETag != nullptr && !cachedETag->IsEmpty())
+    {
+        request->Headers->TryAppendWithoutValidation(StringReference(L"If-None-Match"), cachedETag);
+    }
+
+    return create_async([request, responseETag](progress_reporter<HttpProgress> /*reporter*/) {
+        return create_task(SharedClient()->SendRequestAsync(request)).then([responseETag](HttpResponseMessage^ response) {
+            if (response->Headers->HasKey(StringReference(L"ETag")))
+            {
+                *responseETag = response->Headers->Lookup(StringReference(L"ETag"));
+            }
+
+            if (response->StatusCode == HttpStatusCode::NotModified)
+            {
+                // The validator we sent still matches; the caller falls back to
+                // its cached copy of the payload.
+                return task_from_result(static_cast<String^>(nullptr));
+            }
+
+            response->EnsureSuccessStatusCode();
+            return create_task(response->Content->ReadAsStringAsync());
+        });
+    });
 }
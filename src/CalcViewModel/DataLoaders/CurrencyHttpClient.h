@@ -20,10 +20,28 @@ namespace CalculatorApp
             Windows::Foundation::IAsyncOperationWithProgress<Platform::String^, Windows::Web::Http::HttpProgress>^ GetCurrencyMetadata() override;
             Windows::Foundation::IAsyncOperationWithProgress<Platform::String^, Windows::Web::Http::HttpProgress>^ GetCurrencyRatios() override;
 
+            void SetCachedETags(Platform::String^ metadataETag, Platform::String^ ratiosETag) override;
+            Platform::String^ GetMetadataETag() override;
+            Platform::String^ GetRatiosETag() override;
+
         private:
-            Windows::Web::Http::HttpClient^ m_client;
+            Windows::Foundation::IAsyncOperationWithProgress<Platform::String^, Windows::Web::Http::HttpProgress>^ SendConditionalGetAsync(
+                Windows::Foundation::Uri^ uri,
+                Platform::String^ cachedETag,
+                Platform::String^* responseETag);
+
+            // One HttpClient per process: connection pooling is per client
+            // instance, so sharing it lets the ratio request of a refresh
+            // (and every scheduled refresh after it) reuse the keep-alive
+            // connection the metadata request opened.
+            static Windows::Web::Http::HttpClient^ SharedClient();
+
             Platform::String^ m_responseLanguage;
             Platform::String^ m_sourceCurrencyCode;
+            Platform::String^ m_cachedMetadataETag;
+            Platform::String^ m_cachedRatiosETag;
+            Platform::String^ m_metadataETag;
+            Platform::String^ m_ratiosETag;
         };
     }
 }
@@ -17,6 +17,14 @@ namespace CalculatorApp
 
             virtual Windows::Foundation::IAsyncOperationWithProgress<Platform::String^, Windows::Web::Http::HttpProgress>^ GetCurrencyMetadata() = 0;
             virtual Windows::Foundation::IAsyncOperationWithProgress<Platform::String^, Windows::Web::Http::HttpProgress>^ GetCurrencyRatios() = 0;
+
+            // ETag support for conditional requests. A client that honors these
+            // sends If-None-Match and completes the request with nullptr when the
+            // server responds 304 Not Modified; the caller then reuses its cached
+            // copy of the payload. The defaults make requests unconditional.
+            virtual void SetCachedETags(Platform::String^, Platform::String^) {}
+            virtual Platform::String^ GetMetadataETag() { return nullptr; }
+            virtual Platform::String^ GetRatiosETag() { return nullptr; }
         };
     }
 }
@@ -18,8 +18,294 @@ using namespace Windows::Globalization;
 
 static constexpr bool CONVERT_WITH_OFFSET_FIRST = true;
 
-UnitConverterDataLoader::UnitConverterDataLoader(GeographicRegion^ region) :
-    m_currentRegionCode(region->CodeTwoLetter)
+namespace
+{
+    // Regional convention, if any, that decides whether a unit is the
+    // default conversion source or target. The rules are resolved against
+    // the current region once per load rather than being recomputed for
+    // every table entry.
+    enum class RegionalDefault
+    {
+        Never,
+        Always,
+        SI,               // metric ('Système International') regions
+        USCustomary,      // US customary regions
+        Fahrenheit,       // regions measuring temperature in Fahrenheit
+        Celsius,          // all other regions
+        Watt,             // regions preferring watt over kilowatt
+        Kilowatt,         // all other regions
+        USCustomaryNotUK, // US customary regions excluding Great Britain
+        USCustomaryUK     // Great Britain, when it counts as US customary
+    };
+
+    struct RegionalConventions
+    {
+        bool useSI;
+        bool useUSCustomary;
+        bool useFahrenheit;
+        bool useWattInsteadOfKilowatt;
+        bool isUK;
+    };
+
+    bool IsRegionalDefault(RegionalDefault rule, const RegionalConventions& conventions)
+    {
+        switch (rule)
+        {
+        case RegionalDefault::Always:
+            return true;
+        case RegionalDefault::SI:
+            return conventions.useSI;
+        case RegionalDefault::USCustomary:
+            return conventions.useUSCustomary;
+        case RegionalDefault::Fahrenheit:
+            return conventions.useFahrenheit;
+        case RegionalDefault::Celsius:
+            return !conventions.useFahrenheit;
+        case RegionalDefault::Watt:
+            return conventions.useWattInsteadOfKilowatt;
+        case RegionalDefault::Kilowatt:
+            return !conventions.useWattInsteadOfKilowatt;
+        case RegionalDefault::USCustomaryNotUK:
+            return conventions.useUSCustomary && !conventions.isUK;
+        case RegionalDefault::USCustomaryUK:
+            return conventions.useUSCustomary && conventions.isUK;
+        case RegionalDefault::Never:
+        default:
+            return false;
+        }
+    }
+
+    // One row of the static unit graph: identity, resource keys for the
+    // localized strings, display order and default-selection rules. The
+    // tables live in the image; localized names are only resolved from
+    // the keys when the units are actually built.
+    struct OrderedUnitDescriptor
+    {
+        int id;
+        const wchar_t* nameKey;
+        const wchar_t* abbreviationKey;
+        int order;
+        RegionalDefault source = RegionalDefault::Never;
+        RegionalDefault target = RegionalDefault::Never;
+        bool isWhimsical = false;
+    };
+
+    /* Id, NameKey, AbbreviationKey, Order, IsConversionSource, IsConversionTarget, IsWhimsical */
+    constexpr OrderedUnitDescriptor areaUnitDescriptors[] = {
+        { UnitConverterUnits::Area_Acre, L"UnitName_Acre", L"UnitAbbreviation_Acre", 9 },
+        { UnitConverterUnits::Area_Hectare, L"UnitName_Hectare", L"UnitAbbreviation_Hectare", 4 },
+        { UnitConverterUnits::Area_SquareCentimeter, L"UnitName_SquareCentimeter", L"UnitAbbreviation_SquareCentimeter", 2 },
+        { UnitConverterUnits::Area_SquareFoot, L"UnitName_SquareFoot", L"UnitAbbreviation_SquareFoot", 7, RegionalDefault::SI, RegionalDefault::USCustomary },
+        { UnitConverterUnits::Area_SquareInch, L"UnitName_SquareInch", L"UnitAbbreviation_SquareInch", 6 },
+        { UnitConverterUnits::Area_SquareKilometer, L"UnitName_SquareKilometer", L"UnitAbbreviation_SquareKilometer", 5 },
+        { UnitConverterUnits::Area_SquareMeter, L"UnitName_SquareMeter", L"UnitAbbreviation_SquareMeter", 3, RegionalDefault::USCustomary, RegionalDefault::SI },
+        { UnitConverterUnits::Area_SquareMile, L"UnitName_SquareMile", L"UnitAbbreviation_SquareMile", 10 },
+        { UnitConverterUnits::Area_SquareMillimeter, L"UnitName_SquareMillimeter", L"UnitAbbreviation_SquareMillimeter", 1 },
+        { UnitConverterUnits::Area_SquareYard, L"UnitName_SquareYard", L"UnitAbbreviation_SquareYard", 8 },
+        { UnitConverterUnits::Area_Hand, L"UnitName_Hand", L"UnitAbbreviation_Hand", 11, RegionalDefault::Never, RegionalDefault::Never, true },
+        { UnitConverterUnits::Area_Paper, L"UnitName_Paper", L"UnitAbbreviation_Paper", 12, RegionalDefault::Never, RegionalDefault::Never, true },
+        { UnitConverterUnits::Area_SoccerField, L"UnitName_SoccerField", L"UnitAbbreviation_SoccerField", 13, RegionalDefault::Never, RegionalDefault::Never, true },
+        { UnitConverterUnits::Area_Castle, L"UnitName_Castle", L"UnitAbbreviation_Castle", 14, RegionalDefault::Never, RegionalDefault::Never, true },
+    };
+
+    constexpr OrderedUnitDescriptor dataUnitDescriptors[] = {
+        { UnitConverterUnits::Data_Bit, L"UnitName_Bit", L"UnitAbbreviation_Bit", 1 },
+        { UnitConverterUnits::Data_Byte, L"UnitName_Byte", L"UnitAbbreviation_Byte", 2 },
+        { UnitConverterUnits::Data_Exabits, L"UnitName_Exabits", L"UnitAbbreviation_Exabits", 23 },
+        { UnitConverterUnits::Data_Exabytes, L"UnitName_Exabytes", L"UnitAbbreviation_Exabytes", 25 },
+        { UnitConverterUnits::Data_Exbibits, L"UnitName_Exbibits", L"UnitAbbreviation_Exbibits", 24 },
+        { UnitConverterUnits::Data_Exbibytes, L"UnitName_Exbibytes", L"UnitAbbreviation_Exbibytes", 26 },
+        { UnitConverterUnits::Data_Gibibits, L"UnitName_Gibibits", L"UnitAbbreviation_Gibibits", 12 },
+        { UnitConverterUnits::Data_Gibibytes, L"UnitName_Gibibytes", L"UnitAbbreviation_Gibibytes", 14 },
+        { UnitConverterUnits::Data_Gigabit, L"UnitName_Gigabit", L"UnitAbbreviation_Gigabit", 11 },
+        { UnitConverterUnits::Data_Gigabyte, L"UnitName_Gigabyte", L"UnitAbbreviation_Gigabyte", 13, RegionalDefault::Always },
+        { UnitConverterUnits::Data_Kibibits, L"UnitName_Kibibits", L"UnitAbbreviation_Kibibits", 4 },
+        { UnitConverterUnits::Data_Kibibytes, L"UnitName_Kibibytes", L"UnitAbbreviation_Kibibytes", 6 },
+        { UnitConverterUnits::Data_Kilobit, L"UnitName_Kilobit", L"UnitAbbreviation_Kilobit", 3 },
+        { UnitConverterUnits::Data_Kilobyte, L"UnitName_Kilobyte", L"UnitAbbreviation_Kilobyte", 5 },
+        { UnitConverterUnits::Data_Mebibits, L"UnitName_Mebibits", L"UnitAbbreviation_Mebibits", 8 },
+        { UnitConverterUnits::Data_Mebibytes, L"UnitName_Mebibytes", L"UnitAbbreviation_Mebibytes", 10 },
+        { UnitConverterUnits::Data_Megabit, L"UnitName_Megabit", L"UnitAbbreviation_Megabit", 7 },
+        { UnitConverterUnits::Data_Megabyte, L"UnitName_Megabyte", L"UnitAbbreviation_Megabyte", 9, RegionalDefault::Never, RegionalDefault::Always },
+        { UnitConverterUnits::Data_Pebibits, L"UnitName_Pebibits", L"UnitAbbreviation_Pebibits", 20 },
+        { UnitConverterUnits::Data_Pebibytes, L"UnitName_Pebibytes", L"UnitAbbreviation_Pebibytes", 22 },
+        { UnitConverterUnits::Data_Petabit, L"UnitName_Petabit", L"UnitAbbreviation_Petabit", 19 },
+        { UnitConverterUnits::Data_Petabyte, L"UnitName_Petabyte", L"UnitAbbreviation_Petabyte", 21 },
+        { UnitConverterUnits::Data_Tebibits, L"UnitName_Tebibits", L"UnitAbbreviation_Tebibits", 16 },
+        { UnitConverterUnits::Data_Tebibytes, L"UnitName_Tebibytes", L"UnitAbbreviation_Tebibytes", 18 },
+        { UnitConverterUnits::Data_Terabit, L"UnitName_Terabit", L"UnitAbbreviation_Terabit", 15 },
+        { UnitConverterUnits::Data_Terabyte, L"UnitName_Terabyte", L"UnitAbbreviation_Terabyte", 17 },
+        { UnitConverterUnits::Data_Yobibits, L"UnitName_Yobibits", L"UnitAbbreviation_Yobibits", 32 },
+        { UnitConverterUnits::Data_Yobibytes, L"UnitName_Yobibytes", L"UnitAbbreviation_Yobibytes", 34 },
+        { UnitConverterUnits::Data_Yottabit, L"UnitName_Yottabit", L"UnitAbbreviation_Yottabit", 31 },
+        { UnitConverterUnits::Data_Yottabyte, L"UnitName_Yottabyte", L"UnitAbbreviation_Yottabyte", 33 },
+        { UnitConverterUnits::Data_Zebibits, L"UnitName_Zebibits", L"UnitAbbreviation_Zebibits", 28 },
+        { UnitConverterUnits::Data_Zebibytes, L"UnitName_Zebibytes", L"UnitAbbreviation_Zebibytes", 30 },
+        { UnitConverterUnits::Data_Zetabits, L"UnitName_Zetabits", L"UnitAbbreviation_Zetabits", 27 },
+        { UnitConverterUnits::Data_Zetabytes, L"UnitName_Zetabytes", L"UnitAbbreviation_Zetabytes", 29 },
+        { UnitConverterUnits::Data_FloppyDisk, L"UnitName_FloppyDisk", L"UnitAbbreviation_FloppyDisk", 13, RegionalDefault::Never, RegionalDefault::Never, true },
+        { UnitConverterUnits::Data_CD, L"UnitName_CD", L"UnitAbbreviation_CD", 14, RegionalDefault::Never, RegionalDefault::Never, true },
+        { UnitConverterUnits::Data_DVD, L"UnitName_DVD", L"UnitAbbreviation_DVD", 15, RegionalDefault::Never, RegionalDefault::Never, true },
+    };
+
+    constexpr OrderedUnitDescriptor energyUnitDescriptors[] = {
+        { UnitConverterUnits::Energy_BritishThermalUnit, L"UnitName_BritishThermalUnit", L"UnitAbbreviation_BritishThermalUnit", 7 },
+        { UnitConverterUnits::Energy_Calorie, L"UnitName_Calorie", L"UnitAbbreviation_Calorie", 4 },
+        { UnitConverterUnits::Energy_ElectronVolt, L"UnitName_Electron-Volt", L"UnitAbbreviation_Electron-Volt", 1 },
+        { UnitConverterUnits::Energy_FootPound, L"UnitName_Foot-Pound", L"UnitAbbreviation_Foot-Pound", 6 },
+        { UnitConverterUnits::Energy_Joule, L"UnitName_Joule", L"UnitAbbreviation_Joule", 2, RegionalDefault::Always },
+        { UnitConverterUnits::Energy_Kilocalorie, L"UnitName_Kilocalorie", L"UnitAbbreviation_Kilocalorie", 5, RegionalDefault::Never, RegionalDefault::Always },
+        { UnitConverterUnits::Energy_Kilojoule, L"UnitName_Kilojoule", L"UnitAbbreviation_Kilojoule", 3 },
+        { UnitConverterUnits::Energy_Battery, L"UnitName_Battery", L"UnitAbbreviation_Battery", 8, RegionalDefault::Never, RegionalDefault::Never, true },
+        { UnitConverterUnits::Energy_Banana, L"UnitName_Banana", L"UnitAbbreviation_Banana", 9, RegionalDefault::Never, RegionalDefault::Never, true },
+        { UnitConverterUnits::Energy_SliceOfCake, L"UnitName_SliceOfCake", L"UnitAbbreviation_SliceOfCake", 10, RegionalDefault::Never, RegionalDefault::Never, true },
+    };
+
+    constexpr OrderedUnitDescriptor lengthUnitDescriptors[] = {
+        { UnitConverterUnits::Length_Centimeter, L"UnitName_Centimeter", L"UnitAbbreviation_Centimeter", 4, RegionalDefault::USCustomary, RegionalDefault::SI },
+        { UnitConverterUnits::Length_Foot, L"UnitName_Foot", L"UnitAbbreviation_Foot", 8 },
+        { UnitConverterUnits::Length_Inch, L"UnitName_Inch", L"UnitAbbreviation_Inch", 7, RegionalDefault::SI, RegionalDefault::USCustomary },
+        { UnitConverterUnits::Length_Kilometer, L"UnitName_Kilometer", L"UnitAbbreviation_Kilometer", 6 },
+        { UnitConverterUnits::Length_Meter, L"UnitName_Meter", L"UnitAbbreviation_Meter", 5 },
+        { UnitConverterUnits::Length_Micron, L"UnitName_Micron", L"UnitAbbreviation_Micron", 2 },
+        { UnitConverterUnits::Length_Mile, L"UnitName_Mile", L"UnitAbbreviation_Mile", 10 },
+        { UnitConverterUnits::Length_Millimeter, L"UnitName_Millimeter", L"UnitAbbreviation_Millimeter", 3 },
+        { UnitConverterUnits::Length_Nanometer, L"UnitName_Nanometer", L"UnitAbbreviation_Nanometer", 1 },
+        { UnitConverterUnits::Length_NauticalMile, L"UnitName_NauticalMile", L"UnitAbbreviation_NauticalMile", 11 },
+        { UnitConverterUnits::Length_Yard, L"UnitName_Yard", L"UnitAbbreviation_Yard", 9 },
+        { UnitConverterUnits::Length_Paperclip, L"UnitName_Paperclip", L"UnitAbbreviation_Paperclip", 12, RegionalDefault::Never, RegionalDefault::Never, true },
+        { UnitConverterUnits::Length_Hand, L"UnitName_Hand", L"UnitAbbreviation_Hand", 13, RegionalDefault::Never, RegionalDefault::Never, true },
+        { UnitConverterUnits::Length_JumboJet, L"UnitName_JumboJet", L"UnitAbbreviation_JumboJet", 14, RegionalDefault::Never, RegionalDefault::Never, true },
+    };
+
+    constexpr OrderedUnitDescriptor powerUnitDescriptors[] = {
+        { UnitConverterUnits::Power_BritishThermalUnitPerMinute, L"UnitName_BTUPerMinute", L"UnitAbbreviation_BTUPerMinute", 5 },
+        { UnitConverterUnits::Power_FootPoundPerMinute, L"UnitName_Foot-PoundPerMinute", L"UnitAbbreviation_Foot-PoundPerMinute", 4 },
+        { UnitConverterUnits::Power_Horsepower, L"UnitName_Horsepower", L"UnitAbbreviation_Horsepower", 3, RegionalDefault::Never, RegionalDefault::Always },
+        { UnitConverterUnits::Power_Kilowatt, L"UnitName_Kilowatt", L"UnitAbbreviation_Kilowatt", 2, RegionalDefault::Kilowatt },
+        { UnitConverterUnits::Power_Watt, L"UnitName_Watt", L"UnitAbbreviation_Watt", 1, RegionalDefault::Watt },
+        { UnitConverterUnits::Power_LightBulb, L"UnitName_LightBulb", L"UnitAbbreviation_LightBulb", 6, RegionalDefault::Never, RegionalDefault::Never, true },
+        { UnitConverterUnits::Power_Horse, L"UnitName_Horse", L"UnitAbbreviation_Horse", 7, RegionalDefault::Never, RegionalDefault::Never, true },
+        { UnitConverterUnits::Power_TrainEngine, L"UnitName_TrainEngine", L"UnitAbbreviation_TrainEngine", 8, RegionalDefault::Never, RegionalDefault::Never, true },
+    };
+
+    constexpr OrderedUnitDescriptor temperatureUnitDescriptors[] = {
+        { UnitConverterUnits::Temperature_DegreesCelsius, L"UnitName_DegreesCelsius", L"UnitAbbreviation_DegreesCelsius", 1, RegionalDefault::Fahrenheit, RegionalDefault::Celsius },
+        { UnitConverterUnits::Temperature_DegreesFahrenheit, L"UnitName_DegreesFahrenheit", L"UnitAbbreviation_DegreesFahrenheit", 2, RegionalDefault::Celsius, RegionalDefault::Fahrenheit },
+        { UnitConverterUnits::Temperature_Kelvin, L"UnitName_Kelvin", L"UnitAbbreviation_Kelvin", 3 },
+    };
+
+    constexpr OrderedUnitDescriptor timeUnitDescriptors[] = {
+        { UnitConverterUnits::Time_Day, L"UnitName_Day", L"UnitAbbreviation_Day", 6 },
+        { UnitConverterUnits::Time_Hour, L"UnitName_Hour", L"UnitAbbreviation_Hour", 5, RegionalDefault::Always },
+        { UnitConverterUnits::Time_Microsecond, L"UnitName_Microsecond", L"UnitAbbreviation_Microsecond", 1 },
+        { UnitConverterUnits::Time_Millisecond, L"UnitName_Millisecond", L"UnitAbbreviation_Millisecond", 2 },
+        { UnitConverterUnits::Time_Minute, L"UnitName_Minute", L"UnitAbbreviation_Minute", 4, RegionalDefault::Never, RegionalDefault::Always },
+        { UnitConverterUnits::Time_Second, L"UnitName_Second", L"UnitAbbreviation_Second", 3 },
+        { UnitConverterUnits::Time_Week, L"UnitName_Week", L"UnitAbbreviation_Week", 7 },
+        { UnitConverterUnits::Time_Year, L"UnitName_Year", L"UnitAbbreviation_Year", 8 },
+    };
+
+    constexpr OrderedUnitDescriptor speedUnitDescriptors[] = {
+        { UnitConverterUnits::Speed_CentimetersPerSecond, L"UnitName_CentimetersPerSecond", L"UnitAbbreviation_CentimetersPerSecond", 1 },
+        { UnitConverterUnits::Speed_FeetPerSecond, L"UnitName_FeetPerSecond", L"UnitAbbreviation_FeetPerSecond", 4 },
+        { UnitConverterUnits::Speed_KilometersPerHour, L"UnitName_KilometersPerHour", L"UnitAbbreviation_KilometersPerHour", 3, RegionalDefault::USCustomary, RegionalDefault::SI },
+        { UnitConverterUnits::Speed_Knot, L"UnitName_Knot", L"UnitAbbreviation_Knot", 6 },
+        { UnitConverterUnits::Speed_Mach, L"UnitName_Mach", L"UnitAbbreviation_Mach", 7 },
+        { UnitConverterUnits::Speed_MetersPerSecond, L"UnitName_MetersPerSecond", L"UnitAbbreviation_MetersPerSecond", 2 },
+        { UnitConverterUnits::Speed_MilesPerHour, L"UnitName_MilesPerHour", L"UnitAbbreviation_MilesPerHour", 5, RegionalDefault::SI, RegionalDefault::USCustomary },
+        { UnitConverterUnits::Speed_Turtle, L"UnitName_Turtle", L"UnitAbbreviation_Turtle", 8, RegionalDefault::Never, RegionalDefault::Never, true },
+        { UnitConverterUnits::Speed_Horse, L"UnitName_Horse", L"UnitAbbreviation_Horse", 9, RegionalDefault::Never, RegionalDefault::Never, true },
+        { UnitConverterUnits::Speed_Jet, L"UnitName_Jet", L"UnitAbbreviation_Jet", 10, RegionalDefault::Never, RegionalDefault::Never, true },
+    };
+
+    constexpr OrderedUnitDescriptor volumeUnitDescriptors[] = {
+        { UnitConverterUnits::Volume_CubicCentimeter, L"UnitName_CubicCentimeter", L"UnitAbbreviation_CubicCentimeter", 2 },
+        { UnitConverterUnits::Volume_CubicFoot, L"UnitName_CubicFoot", L"UnitAbbreviation_CubicFoot", 13 },
+        { UnitConverterUnits::Volume_CubicInch, L"UnitName_CubicInch", L"UnitAbbreviation_CubicInch", 12 },
+        { UnitConverterUnits::Volume_CubicMeter, L"UnitName_CubicMeter", L"UnitAbbreviation_CubicMeter", 4 },
+        { UnitConverterUnits::Volume_CubicYard, L"UnitName_CubicYard", L"UnitAbbreviation_CubicYard", 14 },
+        { UnitConverterUnits::Volume_CupUS, L"UnitName_CupUS", L"UnitAbbreviation_CupUS", 8 },
+        { UnitConverterUnits::Volume_FluidOunceUK, L"UnitName_FluidOunceUK", L"UnitAbbreviation_FluidOunceUK", 17 },
+        { UnitConverterUnits::Volume_FluidOunceUS, L"UnitName_FluidOunceUS", L"UnitAbbreviation_FluidOunceUS", 7 },
+        { UnitConverterUnits::Volume_GallonUK, L"UnitName_GallonUK", L"UnitAbbreviation_GallonUK", 20 },
+        { UnitConverterUnits::Volume_GallonUS, L"UnitName_GallonUS", L"UnitAbbreviation_GallonUS", 11 },
+        { UnitConverterUnits::Volume_Liter, L"UnitName_Liter", L"UnitAbbreviation_Liter", 3 },
+        { UnitConverterUnits::Volume_Milliliter, L"UnitName_Milliliter", L"UnitAbbreviation_Milliliter", 1, RegionalDefault::USCustomary, RegionalDefault::SI },
+        { UnitConverterUnits::Volume_PintUK, L"UnitName_PintUK", L"UnitAbbreviation_PintUK", 18 },
+        { UnitConverterUnits::Volume_PintUS, L"UnitName_PintUS", L"UnitAbbreviation_PintUS", 9 },
+        { UnitConverterUnits::Volume_TablespoonUS, L"UnitName_TablespoonUS", L"UnitAbbreviation_TablespoonUS", 6 },
+        { UnitConverterUnits::Volume_TeaspoonUS, L"UnitName_TeaspoonUS", L"UnitAbbreviation_TeaspoonUS", 5, RegionalDefault::SI, RegionalDefault::USCustomaryNotUK },
+        { UnitConverterUnits::Volume_QuartUK, L"UnitName_QuartUK", L"UnitAbbreviation_QuartUK", 19 },
+        { UnitConverterUnits::Volume_QuartUS, L"UnitName_QuartUS", L"UnitAbbreviation_QuartUS", 10 },
+        { UnitConverterUnits::Volume_TeaspoonUK, L"UnitName_TeaspoonUK", L"UnitAbbreviation_TeaspoonUK", 15, RegionalDefault::Never, RegionalDefault::USCustomaryUK },
+        { UnitConverterUnits::Volume_TablespoonUK, L"UnitName_TablespoonUK", L"UnitAbbreviation_TablespoonUK", 16 },
+        { UnitConverterUnits::Volume_CoffeeCup, L"UnitName_CoffeeCup", L"UnitAbbreviation_CoffeeCup", 22, RegionalDefault::Never, RegionalDefault::Never, true },
+        { UnitConverterUnits::Volume_Bathtub, L"UnitName_Bathtub", L"UnitAbbreviation_Bathtub", 23, RegionalDefault::Never, RegionalDefault::Never, true },
+        { UnitConverterUnits::Volume_SwimmingPool, L"UnitName_SwimmingPool", L"UnitAbbreviation_SwimmingPool", 24, RegionalDefault::Never, RegionalDefault::Never, true },
+    };
+
+    constexpr OrderedUnitDescriptor weightUnitDescriptors[] = {
+        { UnitConverterUnits::Weight_Carat, L"UnitName_Carat", L"UnitAbbreviation_Carat", 1 },
+        { UnitConverterUnits::Weight_Centigram, L"UnitName_Centigram", L"UnitAbbreviation_Centigram", 3 },
+        { UnitConverterUnits::Weight_Decigram, L"UnitName_Decigram", L"UnitAbbreviation_Decigram", 4 },
+        { UnitConverterUnits::Weight_Decagram, L"UnitName_Decagram", L"UnitAbbreviation_Decagram", 6 },
+        { UnitConverterUnits::Weight_Gram, L"UnitName_Gram", L"UnitAbbreviation_Gram", 5 },
+        { UnitConverterUnits::Weight_Hectogram, L"UnitName_Hectogram", L"UnitAbbreviation_Hectogram", 7 },
+        { UnitConverterUnits::Weight_Kilogram, L"UnitName_Kilogram", L"UnitAbbreviation_Kilogram", 8, RegionalDefault::USCustomary, RegionalDefault::SI },
+        { UnitConverterUnits::Weight_LongTon, L"UnitName_LongTon", L"UnitAbbreviation_LongTon", 14 },
+        { UnitConverterUnits::Weight_Milligram, L"UnitName_Milligram", L"UnitAbbreviation_Milligram", 2 },
+        { UnitConverterUnits::Weight_Ounce, L"UnitName_Ounce", L"UnitAbbreviation_Ounce", 10 },
+        { UnitConverterUnits::Weight_Pound, L"UnitName_Pound", L"UnitAbbreviation_Pound", 11, RegionalDefault::SI, RegionalDefault::USCustomary },
+        { UnitConverterUnits::Weight_ShortTon, L"UnitName_ShortTon", L"UnitAbbreviation_ShortTon", 13 },
+        { UnitConverterUnits::Weight_Stone, L"UnitName_Stone", L"UnitAbbreviation_Stone", 12 },
+        { UnitConverterUnits::Weight_Tonne, L"UnitName_Tonne", L"UnitAbbreviation_Tonne", 9 },
+        { UnitConverterUnits::Weight_Snowflake, L"UnitName_Snowflake", L"UnitAbbreviation_Snowflake", 15, RegionalDefault::Never, RegionalDefault::Never, true },
+        { UnitConverterUnits::Weight_SoccerBall, L"UnitName_SoccerBall", L"UnitAbbreviation_SoccerBall", 16, RegionalDefault::Never, RegionalDefault::Never, true },
+        { UnitConverterUnits::Weight_Elephant, L"UnitName_Elephant", L"UnitAbbreviation_Elephant", 17, RegionalDefault::Never, RegionalDefault::Never, true },
+        { UnitConverterUnits::Weight_Whale, L"UnitName_Whale", L"UnitAbbreviation_Whale", 18, RegionalDefault::Never, RegionalDefault::Never, true },
+    };
+
+    constexpr OrderedUnitDescriptor pressureUnitDescriptors[] = {
+        { UnitConverterUnits::Pressure_Atmosphere, L"UnitName_Atmosphere", L"UnitAbbreviation_Atmosphere", 1, RegionalDefault::Always },
+        { UnitConverterUnits::Pressure_Bar, L"UnitName_Bar", L"UnitAbbreviation_Bar", 2, RegionalDefault::Never, RegionalDefault::Always },
+        { UnitConverterUnits::Pressure_KiloPascal, L"UnitName_KiloPascal", L"UnitAbbreviation_KiloPascal", 3 },
+        { UnitConverterUnits::Pressure_MillimeterOfMercury, L"UnitName_MillimeterOfMercury ", L"UnitAbbreviation_MillimeterOfMercury ", 4 },
+        { UnitConverterUnits::Pressure_Pascal, L"UnitName_Pascal", L"UnitAbbreviation_Pascal", 5 },
+        { UnitConverterUnits::Pressure_PSI, L"UnitName_PSI", L"UnitAbbreviation_PSI", 6 },
+    };
+
+    constexpr OrderedUnitDescriptor angleUnitDescriptors[] = {
+        { UnitConverterUnits::Angle_Degree, L"UnitName_Degree", L"UnitAbbreviation_Degree", 1, RegionalDefault::Always },
+        { UnitConverterUnits::Angle_Radian, L"UnitName_Radian", L"UnitAbbreviation_Radian", 2, RegionalDefault::Never, RegionalDefault::Always },
+        { UnitConverterUnits::Angle_Gradian, L"UnitName_Gradian", L"UnitAbbreviation_Gradian", 3 },
+    };
+
+    struct UnitDescriptorTable
+    {
+        CalculatorApp::Common::ViewMode viewMode;
+        const OrderedUnitDescriptor* units;
+        size_t count;
+    };
+
+    constexpr UnitDescriptorTable unitDescriptorTables[] = {
+        { CalculatorApp::Common::ViewMode::Area, areaUnitDescriptors, sizeof(areaUnitDescriptors) / sizeof(areaUnitDescriptors[0]) },
+        { CalculatorApp::Common::ViewMode::Data, dataUnitDescriptors, sizeof(dataUnitDescriptors) / sizeof(dataUnitDescriptors[0]) },
+        { CalculatorApp::Common::ViewMode::Energy, energyUnitDescriptors, sizeof(energyUnitDescriptors) / sizeof(energyUnitDescriptors[0]) },
+        { CalculatorApp::Common::ViewMode::Length, lengthUnitDescriptors, sizeof(lengthUnitDescriptors) / sizeof(lengthUnitDescriptors[0]) },
+        { CalculatorApp::Common::ViewMode::Power, powerUnitDescriptors, sizeof(powerUnitDescriptors) / sizeof(powerUnitDescriptors[0]) },
+        { CalculatorApp::Common::ViewMode::Temperature, temperatureUnitDescriptors, sizeof(temperatureUnitDescriptors) / sizeof(temperatureUnitDescriptors[0]) },
+        { CalculatorApp::Common::ViewMode::Time, timeUnitDescriptors, sizeof(timeUnitDescriptors) / sizeof(timeUnitDescriptors[0]) },
+        { CalculatorApp::Common::ViewMode::Speed, speedUnitDescriptors, sizeof(speedUnitDescriptors) / sizeof(speedUnitDescriptors[0]) },
+        { CalculatorApp::Common::ViewMode::Volume, volumeUnitDescriptors, sizeof(volumeUnitDescriptors) / sizeof(volumeUnitDescriptors[0]) },
+        { CalculatorApp::Common::ViewMode::Weight, weightUnitDescriptors, sizeof(weightUnitDescriptors) / sizeof(weightUnitDescriptors[0]) },
+        { CalculatorApp::Common::ViewMode::Pressure, pressureUnitDescriptors, sizeof(pressureUnitDescriptors) / sizeof(pressureUnitDescriptors[0]) },
+        { CalculatorApp::Common::ViewMode::Angle, angleUnitDescriptors, sizeof(angleUnitDescriptors) / sizeof(angleUnitDescriptors[0]) },
+    };
+}
+
+UnitConverterDataLoader::UnitConverterDataLoader(String^ regionCodeTwoLetter) :
+    m_currentRegionCode(regionCodeTwoLetter)
 {
     m_categoryList = make_shared<vector<UCM::Category>>();
     m_categoryToUnits = make_shared<UCM::CategoryToUnitVectorMap>();
@@ -65,6 +351,13 @@ bool UnitConverterDataLoader::SupportsCategory(const UCM::Category& target)
 
 void UnitConverterDataLoader::LoadData()
 {
+    // The unit graph is static data; once the maps have been populated
+    // for this region there is nothing new to load.
+    if (!m_categoryList->empty())
+    {
+        return;
+    }
+
     unordered_map<int, OrderedUnit> idToUnit;
 
     unordered_map<ViewMode, vector<OrderedUnit>> orderedUnitMap{};
@@ -175,201 +468,33 @@ void UnitConverterDataLoader::GetUnits(_In_ unordered_map<ViewMode, vector<Order
 
     bool useWattInsteadOfKilowatt = m_currentRegionCode == "GB";
 
-    vector<OrderedUnit> areaUnits;
-    areaUnits.push_back(OrderedUnit{ UnitConverterUnits::Area_Acre, GetLocalizedStringName(L"UnitName_Acre"), GetLocalizedStringName(L"UnitAbbreviation_Acre"), 9 });
-    areaUnits.push_back(OrderedUnit{ UnitConverterUnits::Area_Hectare, GetLocalizedStringName(L"UnitName_Hectare"), GetLocalizedStringName(L"UnitAbbreviation_Hectare"), 4 });
-    areaUnits.push_back(OrderedUnit{ UnitConverterUnits::Area_SquareCentimeter, GetLocalizedStringName(L"UnitName_SquareCentimeter"), GetLocalizedStringName(L"UnitAbbreviation_SquareCentimeter"), 2 });
-    areaUnits.push_back(OrderedUnit{ UnitConverterUnits::Area_SquareFoot, GetLocalizedStringName(L"UnitName_SquareFoot"), GetLocalizedStringName(L"UnitAbbreviation_SquareFoot"), 7, useSI, useUSCustomary, false });
-    areaUnits.push_back(OrderedUnit{ UnitConverterUnits::Area_SquareInch, GetLocalizedStringName(L"UnitName_SquareInch"), GetLocalizedStringName(L"UnitAbbreviation_SquareInch"), 6 });
-    areaUnits.push_back(OrderedUnit{ UnitConverterUnits::Area_SquareKilometer, GetLocalizedStringName(L"UnitName_SquareKilometer"), GetLocalizedStringName(L"UnitAbbreviation_SquareKilometer"), 5 });
-    areaUnits.push_back(OrderedUnit{ UnitConverterUnits::Area_SquareMeter, GetLocalizedStringName(L"UnitName_SquareMeter"), GetLocalizedStringName(L"UnitAbbreviation_SquareMeter"), 3, useUSCustomary, useSI, false});
-    areaUnits.push_back(OrderedUnit{ UnitConverterUnits::Area_SquareMile, GetLocalizedStringName(L"UnitName_SquareMile"), GetLocalizedStringName(L"UnitAbbreviation_SquareMile"), 10 });
-    areaUnits.push_back(OrderedUnit{ UnitConverterUnits::Area_SquareMillimeter, GetLocalizedStringName(L"UnitName_SquareMillimeter"), GetLocalizedStringName(L"UnitAbbreviation_SquareMillimeter"), 1 });
-    areaUnits.push_back(OrderedUnit{ UnitConverterUnits::Area_SquareYard, GetLocalizedStringName(L"UnitName_SquareYard"), GetLocalizedStringName(L"UnitAbbreviation_SquareYard"), 8 });
-    areaUnits.push_back(OrderedUnit{ UnitConverterUnits::Area_Hand, GetLocalizedStringName(L"UnitName_Hand"), GetLocalizedStringName(L"UnitAbbreviation_Hand"), 11, false, false, true});
-    areaUnits.push_back(OrderedUnit{ UnitConverterUnits::Area_Paper, GetLocalizedStringName(L"UnitName_Paper"), GetLocalizedStringName(L"UnitAbbreviation_Paper"), 12, false, false, true });
-    areaUnits.push_back(OrderedUnit{ UnitConverterUnits::Area_SoccerField, GetLocalizedStringName(L"UnitName_SoccerField"), GetLocalizedStringName(L"UnitAbbreviation_SoccerField"),13, false, false, true });
-    areaUnits.push_back(OrderedUnit{ UnitConverterUnits::Area_Castle, GetLocalizedStringName(L"UnitName_Castle"), GetLocalizedStringName(L"UnitAbbreviation_Castle"), 14, false, false, true });
-    unitMap.emplace(ViewMode::Area, areaUnits);
-
-    vector<OrderedUnit> dataUnits;
-    dataUnits.push_back(OrderedUnit{ UnitConverterUnits::Data_Bit, GetLocalizedStringName(L"UnitName_Bit"), GetLocalizedStringName(L"UnitAbbreviation_Bit"), 1 });
-    dataUnits.push_back(OrderedUnit{ UnitConverterUnits::Data_Byte, GetLocalizedStringName(L"UnitName_Byte"), GetLocalizedStringName(L"UnitAbbreviation_Byte"), 2 });
-    dataUnits.push_back(OrderedUnit{ UnitConverterUnits::Data_Exabits, GetLocalizedStringName(L"UnitName_Exabits"), GetLocalizedStringName(L"UnitAbbreviation_Exabits"), 23 });
-    dataUnits.push_back(OrderedUnit{ UnitConverterUnits::Data_Exabytes, GetLocalizedStringName(L"UnitName_Exabytes"), GetLocalizedStringName(L"UnitAbbreviation_Exabytes"), 25 });
-    dataUnits.push_back(OrderedUnit{ UnitConverterUnits::Data_Exbibits, GetLocalizedStringName(L"UnitName_Exbibits"), GetLocalizedStringName(L"UnitAbbreviation_Exbibits"), 24 });
-    dataUnits.push_back(OrderedUnit{ UnitConverterUnits::Data_Exbibytes, GetLocalizedStringName(L"UnitName_Exbibytes"), GetLocalizedStringName(L"UnitAbbreviation_Exbibytes"), 26 });
-    dataUnits.push_back(OrderedUnit{ UnitConverterUnits::Data_Gibibits, GetLocalizedStringName(L"UnitName_Gibibits"), GetLocalizedStringName(L"UnitAbbreviation_Gibibits"), 12 });
-    dataUnits.push_back(OrderedUnit{ UnitConverterUnits::Data_Gibibytes, GetLocalizedStringName(L"UnitName_Gibibytes"), GetLocalizedStringName(L"UnitAbbreviation_Gibibytes"), 14 });
-    dataUnits.push_back(OrderedUnit{ UnitConverterUnits::Data_Gigabit, GetLocalizedStringName(L"UnitName_Gigabit"), GetLocalizedStringName(L"UnitAbbreviation_Gigabit"), 11 });
-    dataUnits.push_back(OrderedUnit{ UnitConverterUnits::Data_Gigabyte, GetLocalizedStringName(L"UnitName_Gigabyte"), GetLocalizedStringName(L"UnitAbbreviation_Gigabyte"),13,  true, false, false});
-    dataUnits.push_back(OrderedUnit{ UnitConverterUnits::Data_Kibibits, GetLocalizedStringName(L"UnitName_Kibibits"), GetLocalizedStringName(L"UnitAbbreviation_Kibibits"), 4 });
-    dataUnits.push_back(OrderedUnit{ UnitConverterUnits::Data_Kibibytes, GetLocalizedStringName(L"UnitName_Kibibytes"), GetLocalizedStringName(L"UnitAbbreviation_Kibibytes"),6 });
-    dataUnits.push_back(OrderedUnit{ UnitConverterUnits::Data_Kilobit, GetLocalizedStringName(L"UnitName_Kilobit"), GetLocalizedStringName(L"UnitAbbreviation_Kilobit"), 3 });
-    dataUnits.push_back(OrderedUnit{ UnitConverterUnits::Data_Kilobyte, GetLocalizedStringName(L"UnitName_Kilobyte"), GetLocalizedStringName(L"UnitAbbreviation_Kilobyte"), 5 });
-    dataUnits.push_back(OrderedUnit{ UnitConverterUnits::Data_Mebibits, GetLocalizedStringName(L"UnitName_Mebibits"), GetLocalizedStringName(L"UnitAbbreviation_Mebibits"), 8 });
-    dataUnits.push_back(OrderedUnit{ UnitConverterUnits::Data_Mebibytes, GetLocalizedStringName(L"UnitName_Mebibytes"), GetLocalizedStringName(L"UnitAbbreviation_Mebibytes"), 10 });
-    dataUnits.push_back(OrderedUnit{ UnitConverterUnits::Data_Megabit, GetLocalizedStringName(L"UnitName_Megabit"), GetLocalizedStringName(L"UnitAbbreviation_Megabit"), 7 });
-    dataUnits.push_back(OrderedUnit{ UnitConverterUnits::Data_Megabyte, GetLocalizedStringName(L"UnitName_Megabyte"), GetLocalizedStringName(L"UnitAbbreviation_Megabyte"), 9, false, true, false});
-    dataUnits.push_back(OrderedUnit{ UnitConverterUnits::Data_Pebibits, GetLocalizedStringName(L"UnitName_Pebibits"), GetLocalizedStringName(L"UnitAbbreviation_Pebibits"), 20 });
-    dataUnits.push_back(OrderedUnit{ UnitConverterUnits::Data_Pebibytes, GetLocalizedStringName(L"UnitName_Pebibytes"), GetLocalizedStringName(L"UnitAbbreviation_Pebibytes"), 22 });
-    dataUnits.push_back(OrderedUnit{ UnitConverterUnits::Data_Petabit, GetLocalizedStringName(L"UnitName_Petabit"), GetLocalizedStringName(L"UnitAbbreviation_Petabit"), 19 });
-    dataUnits.push_back(OrderedUnit{ UnitConverterUnits::Data_Petabyte, GetLocalizedStringName(L"UnitName_Petabyte"), GetLocalizedStringName(L"UnitAbbreviation_Petabyte"), 21 });
-    dataUnits.push_back(OrderedUnit{ UnitConverterUnits::Data_Tebibits, GetLocalizedStringName(L"UnitName_Tebibits"), GetLocalizedStringName(L"UnitAbbreviation_Tebibits"), 16 });
-    dataUnits.push_back(OrderedUnit{ UnitConverterUnits::Data_Tebibytes, GetLocalizedStringName(L"UnitName_Tebibytes"), GetLocalizedStringName(L"UnitAbbreviation_Tebibytes"), 18 });
-    dataUnits.push_back(OrderedUnit{ UnitConverterUnits::Data_Terabit, GetLocalizedStringName(L"UnitName_Terabit"), GetLocalizedStringName(L"UnitAbbreviation_Terabit"), 15 });
-    dataUnits.push_back(OrderedUnit{ UnitConverterUnits::Data_Terabyte, GetLocalizedStringName(L"UnitName_Terabyte"), GetLocalizedStringName(L"UnitAbbreviation_Terabyte"), 17 });
-    dataUnits.push_back(OrderedUnit{ UnitConverterUnits::Data_Yobibits, GetLocalizedStringName(L"UnitName_Yobibits"), GetLocalizedStringName(L"UnitAbbreviation_Yobibits"), 32 });
-    dataUnits.push_back(OrderedUnit{ UnitConverterUnits::Data_Yobibytes, GetLocalizedStringName(L"UnitName_Yobibytes"), GetLocalizedStringName(L"UnitAbbreviation_Yobibytes"), 34 });
-    dataUnits.push_back(OrderedUnit{ UnitConverterUnits::Data_Yottabit, GetLocalizedStringName(L"UnitName_Yottabit"), GetLocalizedStringName(L"UnitAbbreviation_Yottabit"), 31 });
-    dataUnits.push_back(OrderedUnit{ UnitConverterUnits::Data_Yottabyte, GetLocalizedStringName(L"UnitName_Yottabyte"), GetLocalizedStringName(L"UnitAbbreviation_Yottabyte"), 33 });
-    dataUnits.push_back(OrderedUnit{ UnitConverterUnits::Data_Zebibits, GetLocalizedStringName(L"UnitName_Zebibits"), GetLocalizedStringName(L"UnitAbbreviation_Zebibits"), 28 });
-    dataUnits.push_back(OrderedUnit{ UnitConverterUnits::Data_Zebibytes, GetLocalizedStringName(L"UnitName_Zebibytes"), GetLocalizedStringName(L"UnitAbbreviation_Zebibytes"), 30 });
-    dataUnits.push_back(OrderedUnit{ UnitConverterUnits::Data_Zetabits, GetLocalizedStringName(L"UnitName_Zetabits"), GetLocalizedStringName(L"UnitAbbreviation_Zetabits"), 27 });
-    dataUnits.push_back(OrderedUnit{ UnitConverterUnits::Data_Zetabytes, GetLocalizedStringName(L"UnitName_Zetabytes"), GetLocalizedStringName(L"UnitAbbreviation_Zetabytes"),29 });
-    dataUnits.push_back(OrderedUnit{ UnitConverterUnits::Data_FloppyDisk, GetLocalizedStringName(L"UnitName_FloppyDisk"), GetLocalizedStringName(L"UnitAbbreviation_FloppyDisk"), 13, false, false, true });
-    dataUnits.push_back(OrderedUnit{ UnitConverterUnits::Data_CD, GetLocalizedStringName(L"UnitName_CD"), GetLocalizedStringName(L"UnitAbbreviation_CD"), 14, false, false, true });
-    dataUnits.push_back(OrderedUnit{ UnitConverterUnits::Data_DVD, GetLocalizedStringName(L"UnitName_DVD"), GetLocalizedStringName(L"UnitAbbreviation_DVD"), 15, false, false, true });
-    unitMap.emplace(ViewMode::Data, dataUnits);
-
-    vector<OrderedUnit> energyUnits;
-    energyUnits.push_back(OrderedUnit{ UnitConverterUnits::Energy_BritishThermalUnit, GetLocalizedStringName(L"UnitName_BritishThermalUnit"), GetLocalizedStringName(L"UnitAbbreviation_BritishThermalUnit"), 7 });
-    energyUnits.push_back(OrderedUnit{ UnitConverterUnits::Energy_Calorie, GetLocalizedStringName(L"UnitName_Calorie"), GetLocalizedStringName(L"UnitAbbreviation_Calorie"), 4 });
-    energyUnits.push_back(OrderedUnit{ UnitConverterUnits::Energy_ElectronVolt, GetLocalizedStringName(L"UnitName_Electron-Volt"), GetLocalizedStringName(L"UnitAbbreviation_Electron-Volt"), 1 });
-    energyUnits.push_back(OrderedUnit{ UnitConverterUnits::Energy_FootPound, GetLocalizedStringName(L"UnitName_Foot-Pound"), GetLocalizedStringName(L"UnitAbbreviation_Foot-Pound"), 6 });
-    energyUnits.push_back(OrderedUnit{ UnitConverterUnits::Energy_Joule, GetLocalizedStringName(L"UnitName_Joule"), GetLocalizedStringName(L"UnitAbbreviation_Joule"), 2, true, false, false});
-    energyUnits.push_back(OrderedUnit{ UnitConverterUnits::Energy_Kilocalorie, GetLocalizedStringName(L"UnitName_Kilocalorie"), GetLocalizedStringName(L"UnitAbbreviation_Kilocalorie"), 5, false, true, false });
-    energyUnits.push_back(OrderedUnit{ UnitConverterUnits::Energy_Kilojoule, GetLocalizedStringName(L"UnitName_Kilojoule"), GetLocalizedStringName(L"UnitAbbreviation_Kilojoule"), 3 });
-    energyUnits.push_back(OrderedUnit{ UnitConverterUnits::Energy_Battery, GetLocalizedStringName(L"UnitName_Battery"), GetLocalizedStringName(L"UnitAbbreviation_Battery"), 8, false, false, true });
-    energyUnits.push_back(OrderedUnit{ UnitConverterUnits::Energy_Banana, GetLocalizedStringName(L"UnitName_Banana"), GetLocalizedStringName(L"UnitAbbreviation_Banana"), 9, false, false, true });
-    energyUnits.push_back(OrderedUnit{ UnitConverterUnits::Energy_SliceOfCake, GetLocalizedStringName(L"UnitName_SliceOfCake"), GetLocalizedStringName(L"UnitAbbreviation_SliceOfCake"),10,  false, false, true });
-    unitMap.emplace(ViewMode::Energy, energyUnits);
-
-    vector<OrderedUnit> lengthUnits;
-    lengthUnits.push_back(OrderedUnit{ UnitConverterUnits::Length_Centimeter, GetLocalizedStringName(L"UnitName_Centimeter"), GetLocalizedStringName(L"UnitAbbreviation_Centimeter"), 4, useUSCustomary, useSI, false});
-    lengthUnits.push_back(OrderedUnit{ UnitConverterUnits::Length_Foot, GetLocalizedStringName(L"UnitName_Foot"), GetLocalizedStringName(L"UnitAbbreviation_Foot"), 8 });
-    lengthUnits.push_back(OrderedUnit{ UnitConverterUnits::Length_Inch, GetLocalizedStringName(L"UnitName_Inch"), GetLocalizedStringName(L"UnitAbbreviation_Inch"), 7 , useSI, useUSCustomary, false });
-    lengthUnits.push_back(OrderedUnit{ UnitConverterUnits::Length_Kilometer, GetLocalizedStringName(L"UnitName_Kilometer"), GetLocalizedStringName(L"UnitAbbreviation_Kilometer"), 6 });
-    lengthUnits.push_back(OrderedUnit{ UnitConverterUnits::Length_Meter, GetLocalizedStringName(L"UnitName_Meter"), GetLocalizedStringName(L"UnitAbbreviation_Meter"), 5 });
-    lengthUnits.push_back(OrderedUnit{ UnitConverterUnits::Length_Micron, GetLocalizedStringName(L"UnitName_Micron"), GetLocalizedStringName(L"UnitAbbreviation_Micron"), 2 });
-    lengthUnits.push_back(OrderedUnit{ UnitConverterUnits::Length_Mile, GetLocalizedStringName(L"UnitName_Mile"), GetLocalizedStringName(L"UnitAbbreviation_Mile"), 10 });
-    lengthUnits.push_back(OrderedUnit{ UnitConverterUnits::Length_Millimeter, GetLocalizedStringName(L"UnitName_Millimeter"), GetLocalizedStringName(L"UnitAbbreviation_Millimeter"), 3 });
-    lengthUnits.push_back(OrderedUnit{ UnitConverterUnits::Length_Nanometer, GetLocalizedStringName(L"UnitName_Nanometer"), GetLocalizedStringName(L"UnitAbbreviation_Nanometer"), 1 });
-    lengthUnits.push_back(OrderedUnit{ UnitConverterUnits::Length_NauticalMile, GetLocalizedStringName(L"UnitName_NauticalMile"), GetLocalizedStringName(L"UnitAbbreviation_NauticalMile"), 11 });
-    lengthUnits.push_back(OrderedUnit{ UnitConverterUnits::Length_Yard, GetLocalizedStringName(L"UnitName_Yard"), GetLocalizedStringName(L"UnitAbbreviation_Yard"), 9 });
-    lengthUnits.push_back(OrderedUnit{ UnitConverterUnits::Length_Paperclip, GetLocalizedStringName(L"UnitName_Paperclip"), GetLocalizedStringName(L"UnitAbbreviation_Paperclip"), 12 ,false, false, true });
-    lengthUnits.push_back(OrderedUnit{ UnitConverterUnits::Length_Hand, GetLocalizedStringName(L"UnitName_Hand"), GetLocalizedStringName(L"UnitAbbreviation_Hand"), 13 ,false, false, true });
-    lengthUnits.push_back(OrderedUnit{ UnitConverterUnits::Length_JumboJet, GetLocalizedStringName(L"UnitName_JumboJet"), GetLocalizedStringName(L"UnitAbbreviation_JumboJet"), 14 , false, false, true });
-    unitMap.emplace(ViewMode::Length, lengthUnits);
-
-    vector<OrderedUnit> powerUnits;
-    powerUnits.push_back(OrderedUnit{ UnitConverterUnits::Power_BritishThermalUnitPerMinute, GetLocalizedStringName(L"UnitName_BTUPerMinute"), GetLocalizedStringName(L"UnitAbbreviation_BTUPerMinute"), 5 });
-    powerUnits.push_back(OrderedUnit{ UnitConverterUnits::Power_FootPoundPerMinute, GetLocalizedStringName(L"UnitName_Foot-PoundPerMinute"), GetLocalizedStringName(L"UnitAbbreviation_Foot-PoundPerMinute"), 4 });
-    powerUnits.push_back(OrderedUnit{ UnitConverterUnits::Power_Horsepower, GetLocalizedStringName(L"UnitName_Horsepower"), GetLocalizedStringName(L"UnitAbbreviation_Horsepower") , 3 , false, true, false });
-    powerUnits.push_back(OrderedUnit{ UnitConverterUnits::Power_Kilowatt, GetLocalizedStringName(L"UnitName_Kilowatt"), GetLocalizedStringName(L"UnitAbbreviation_Kilowatt"), 2 , !useWattInsteadOfKilowatt});
-    powerUnits.push_back(OrderedUnit{ UnitConverterUnits::Power_Watt, GetLocalizedStringName(L"UnitName_Watt"), GetLocalizedStringName(L"UnitAbbreviation_Watt"), 1, useWattInsteadOfKilowatt});
-    powerUnits.push_back(OrderedUnit{ UnitConverterUnits::Power_LightBulb, GetLocalizedStringName(L"UnitName_LightBulb"), GetLocalizedStringName(L"UnitAbbreviation_LightBulb"), 6 ,false, false, true});
-    powerUnits.push_back(OrderedUnit{ UnitConverterUnits::Power_Horse, GetLocalizedStringName(L"UnitName_Horse"), GetLocalizedStringName(L"UnitAbbreviation_Horse"), 7 ,false, false, true});
-    powerUnits.push_back(OrderedUnit{ UnitConverterUnits::Power_TrainEngine, GetLocalizedStringName(L"UnitName_TrainEngine"), GetLocalizedStringName(L"UnitAbbreviation_TrainEngine"), 8 ,false, false, true });
-    unitMap.emplace(ViewMode::Power, powerUnits);
-
-    vector<OrderedUnit> tempUnits;
-    tempUnits.push_back(OrderedUnit{ UnitConverterUnits::Temperature_DegreesCelsius, GetLocalizedStringName(L"UnitName_DegreesCelsius"), GetLocalizedStringName(L"UnitAbbreviation_DegreesCelsius"), 1, useFahrenheit, !useFahrenheit, false });
-    tempUnits.push_back(OrderedUnit{ UnitConverterUnits::Temperature_DegreesFahrenheit, GetLocalizedStringName(L"UnitName_DegreesFahrenheit"), GetLocalizedStringName(L"UnitAbbreviation_DegreesFahrenheit"), 2 , !useFahrenheit, useFahrenheit, false });
-    tempUnits.push_back(OrderedUnit{ UnitConverterUnits::Temperature_Kelvin, GetLocalizedStringName(L"UnitName_Kelvin"), GetLocalizedStringName(L"UnitAbbreviation_Kelvin"), 3 });
-    unitMap.emplace(ViewMode::Temperature, tempUnits);
-
-    vector<OrderedUnit> timeUnits;
-    timeUnits.push_back(OrderedUnit{ UnitConverterUnits::Time_Day, GetLocalizedStringName(L"UnitName_Day"), GetLocalizedStringName(L"UnitAbbreviation_Day"), 6 });
-    timeUnits.push_back(OrderedUnit{ UnitConverterUnits::Time_Hour, GetLocalizedStringName(L"UnitName_Hour"), GetLocalizedStringName(L"UnitAbbreviation_Hour"), 5 ,true, false, false });
-    timeUnits.push_back(OrderedUnit{ UnitConverterUnits::Time_Microsecond, GetLocalizedStringName(L"UnitName_Microsecond"), GetLocalizedStringName(L"UnitAbbreviation_Microsecond"), 1 });
-    timeUnits.push_back(OrderedUnit{ UnitConverterUnits::Time_Millisecond, GetLocalizedStringName(L"UnitName_Millisecond"), GetLocalizedStringName(L"UnitAbbreviation_Millisecond"), 2 });
-    timeUnits.push_back(OrderedUnit{ UnitConverterUnits::Time_Minute, GetLocalizedStringName(L"UnitName_Minute"), GetLocalizedStringName(L"UnitAbbreviation_Minute"), 4 ,false, true, false });
-    timeUnits.push_back(OrderedUnit{ UnitConverterUnits::Time_Second, GetLocalizedStringName(L"UnitName_Second"), GetLocalizedStringName(L"UnitAbbreviation_Second"), 3 });
-    timeUnits.push_back(OrderedUnit{ UnitConverterUnits::Time_Week, GetLocalizedStringName(L"UnitName_Week"), GetLocalizedStringName(L"UnitAbbreviation_Week"), 7 });
-    timeUnits.push_back(OrderedUnit{ UnitConverterUnits::Time_Year, GetLocalizedStringName(L"UnitName_Year"), GetLocalizedStringName(L"UnitAbbreviation_Year"), 8 });
-    unitMap.emplace(ViewMode::Time, timeUnits);
-
-    vector<OrderedUnit> speedUnits;
-    speedUnits.push_back(OrderedUnit{ UnitConverterUnits::Speed_CentimetersPerSecond, GetLocalizedStringName(L"UnitName_CentimetersPerSecond"), GetLocalizedStringName(L"UnitAbbreviation_CentimetersPerSecond"), 1 });
-    speedUnits.push_back(OrderedUnit{ UnitConverterUnits::Speed_FeetPerSecond, GetLocalizedStringName(L"UnitName_FeetPerSecond"), GetLocalizedStringName(L"UnitAbbreviation_FeetPerSecond"), 4 });
-    speedUnits.push_back(OrderedUnit{ UnitConverterUnits::Speed_KilometersPerHour, GetLocalizedStringName(L"UnitName_KilometersPerHour"), GetLocalizedStringName(L"UnitAbbreviation_KilometersPerHour"), 3 , useUSCustomary, useSI, false });
-    speedUnits.push_back(OrderedUnit{ UnitConverterUnits::Speed_Knot, GetLocalizedStringName(L"UnitName_Knot"), GetLocalizedStringName(L"UnitAbbreviation_Knot"), 6 });
-    speedUnits.push_back(OrderedUnit{ UnitConverterUnits::Speed_Mach, GetLocalizedStringName(L"UnitName_Mach"), GetLocalizedStringName(L"UnitAbbreviation_Mach"), 7 });
-    speedUnits.push_back(OrderedUnit{ UnitConverterUnits::Speed_MetersPerSecond, GetLocalizedStringName(L"UnitName_MetersPerSecond"), GetLocalizedStringName(L"UnitAbbreviation_MetersPerSecond"), 2 });
-    speedUnits.push_back(OrderedUnit{ UnitConverterUnits::Speed_MilesPerHour, GetLocalizedStringName(L"UnitName_MilesPerHour"), GetLocalizedStringName(L"UnitAbbreviation_MilesPerHour"), 5, useSI, useUSCustomary, false });
-    speedUnits.push_back(OrderedUnit{ UnitConverterUnits::Speed_Turtle, GetLocalizedStringName(L"UnitName_Turtle"), GetLocalizedStringName(L"UnitAbbreviation_Turtle"), 8 ,false, false, true });
-    speedUnits.push_back(OrderedUnit{ UnitConverterUnits::Speed_Horse, GetLocalizedStringName(L"UnitName_Horse"), GetLocalizedStringName(L"UnitAbbreviation_Horse"),9 , false, false, true });
-    speedUnits.push_back(OrderedUnit{ UnitConverterUnits::Speed_Jet, GetLocalizedStringName(L"UnitName_Jet"), GetLocalizedStringName(L"UnitAbbreviation_Jet"), 10, false, false, true });
-    unitMap.emplace(ViewMode::Speed, speedUnits);
-
-    vector<OrderedUnit> volumeUnits;
-    volumeUnits.push_back(OrderedUnit{ UnitConverterUnits::Volume_CubicCentimeter, GetLocalizedStringName(L"UnitName_CubicCentimeter"), GetLocalizedStringName(L"UnitAbbreviation_CubicCentimeter"), 2 });
-    volumeUnits.push_back(OrderedUnit{ UnitConverterUnits::Volume_CubicFoot, GetLocalizedStringName(L"UnitName_CubicFoot"), GetLocalizedStringName(L"UnitAbbreviation_CubicFoot"), 13 });
-    volumeUnits.push_back(OrderedUnit{ UnitConverterUnits::Volume_CubicInch, GetLocalizedStringName(L"UnitName_CubicInch"), GetLocalizedStringName(L"UnitAbbreviation_CubicInch"),  12 });
-    volumeUnits.push_back(OrderedUnit{ UnitConverterUnits::Volume_CubicMeter, GetLocalizedStringName(L"UnitName_CubicMeter"), GetLocalizedStringName(L"UnitAbbreviation_CubicMeter"), 4 });
-    volumeUnits.push_back(OrderedUnit{ UnitConverterUnits::Volume_CubicYard, GetLocalizedStringName(L"UnitName_CubicYard"), GetLocalizedStringName(L"UnitAbbreviation_CubicYard"), 14 });
-    volumeUnits.push_back(OrderedUnit{ UnitConverterUnits::Volume_CupUS, GetLocalizedStringName(L"UnitName_CupUS"), GetLocalizedStringName(L"UnitAbbreviation_CupUS"), 8 });
-    volumeUnits.push_back(OrderedUnit{ UnitConverterUnits::Volume_FluidOunceUK, GetLocalizedStringName(L"UnitName_FluidOunceUK"), GetLocalizedStringName(L"UnitAbbreviation_FluidOunceUK"), 17 });
-    volumeUnits.push_back(OrderedUnit{ UnitConverterUnits::Volume_FluidOunceUS, GetLocalizedStringName(L"UnitName_FluidOunceUS"), GetLocalizedStringName(L"UnitAbbreviation_FluidOunceUS"), 7 });
-    volumeUnits.push_back(OrderedUnit{ UnitConverterUnits::Volume_GallonUK, GetLocalizedStringName(L"UnitName_GallonUK"), GetLocalizedStringName(L"UnitAbbreviation_GallonUK"), 20 });
-    volumeUnits.push_back(OrderedUnit{ UnitConverterUnits::Volume_GallonUS, GetLocalizedStringName(L"UnitName_GallonUS"), GetLocalizedStringName(L"UnitAbbreviation_GallonUS"), 11 });
-    volumeUnits.push_back(OrderedUnit{ UnitConverterUnits::Volume_Liter, GetLocalizedStringName(L"UnitName_Liter"), GetLocalizedStringName(L"UnitAbbreviation_Liter"), 3 });
-    volumeUnits.push_back(OrderedUnit{ UnitConverterUnits::Volume_Milliliter, GetLocalizedStringName(L"UnitName_Milliliter"), GetLocalizedStringName(L"UnitAbbreviation_Milliliter"), 1, useUSCustomary, useSI});
-    volumeUnits.push_back(OrderedUnit{ UnitConverterUnits::Volume_PintUK, GetLocalizedStringName(L"UnitName_PintUK"), GetLocalizedStringName(L"UnitAbbreviation_PintUK"), 18 });
-    volumeUnits.push_back(OrderedUnit{ UnitConverterUnits::Volume_PintUS, GetLocalizedStringName(L"UnitName_PintUS"), GetLocalizedStringName(L"UnitAbbreviation_PintUS"), 9 });
-    volumeUnits.push_back(OrderedUnit{ UnitConverterUnits::Volume_TablespoonUS, GetLocalizedStringName(L"UnitName_TablespoonUS"), GetLocalizedStringName(L"UnitAbbreviation_TablespoonUS"), 6 });
-    volumeUnits.push_back(OrderedUnit{ UnitConverterUnits::Volume_TeaspoonUS, GetLocalizedStringName(L"UnitName_TeaspoonUS"), GetLocalizedStringName(L"UnitAbbreviation_TeaspoonUS"), 5, useSI, useUSCustomary && m_currentRegionCode != "GB" });
-    volumeUnits.push_back(OrderedUnit{ UnitConverterUnits::Volume_QuartUK, GetLocalizedStringName(L"UnitName_QuartUK"), GetLocalizedStringName(L"UnitAbbreviation_QuartUK"), 19 });
-    volumeUnits.push_back(OrderedUnit{ UnitConverterUnits::Volume_QuartUS, GetLocalizedStringName(L"UnitName_QuartUS"), GetLocalizedStringName(L"UnitAbbreviation_QuartUS"), 10 });
-    volumeUnits.push_back(OrderedUnit{ UnitConverterUnits::Volume_TeaspoonUK, GetLocalizedStringName(L"UnitName_TeaspoonUK"), GetLocalizedStringName(L"UnitAbbreviation_TeaspoonUK"), 15, false, useUSCustomary && m_currentRegionCode == "GB"});
-    volumeUnits.push_back(OrderedUnit{ UnitConverterUnits::Volume_TablespoonUK, GetLocalizedStringName(L"UnitName_TablespoonUK"), GetLocalizedStringName(L"UnitAbbreviation_TablespoonUK"), 16 });
-    volumeUnits.push_back(OrderedUnit{ UnitConverterUnits::Volume_CoffeeCup, GetLocalizedStringName(L"UnitName_CoffeeCup"), GetLocalizedStringName(L"UnitAbbreviation_CoffeeCup"), 22 ,false, false, true });
-    volumeUnits.push_back(OrderedUnit{ UnitConverterUnits::Volume_Bathtub, GetLocalizedStringName(L"UnitName_Bathtub"), GetLocalizedStringName(L"UnitAbbreviation_Bathtub"), 23 ,false, false, true});
-    volumeUnits.push_back(OrderedUnit{ UnitConverterUnits::Volume_SwimmingPool, GetLocalizedStringName(L"UnitName_SwimmingPool"), GetLocalizedStringName(L"UnitAbbreviation_SwimmingPool"), 24 ,false, false, true });
-    unitMap.emplace(ViewMode::Volume, volumeUnits);
-
-    vector<OrderedUnit> weightUnits;
-    weightUnits.push_back(OrderedUnit{ UnitConverterUnits::Weight_Carat, GetLocalizedStringName(L"UnitName_Carat"), GetLocalizedStringName(L"UnitAbbreviation_Carat"), 1 });
-    weightUnits.push_back(OrderedUnit{ UnitConverterUnits::Weight_Centigram, GetLocalizedStringName(L"UnitName_Centigram"), GetLocalizedStringName(L"UnitAbbreviation_Centigram"), 3 });
-    weightUnits.push_back(OrderedUnit{ UnitConverterUnits::Weight_Decigram, GetLocalizedStringName(L"UnitName_Decigram"), GetLocalizedStringName(L"UnitAbbreviation_Decigram"), 4 });
-    weightUnits.push_back(OrderedUnit{ UnitConverterUnits::Weight_Decagram, GetLocalizedStringName(L"UnitName_Decagram"), GetLocalizedStringName(L"UnitAbbreviation_Decagram"), 6 });
-    weightUnits.push_back(OrderedUnit{ UnitConverterUnits::Weight_Gram, GetLocalizedStringName(L"UnitName_Gram"), GetLocalizedStringName(L"UnitAbbreviation_Gram"), 5 });
-    weightUnits.push_back(OrderedUnit{ UnitConverterUnits::Weight_Hectogram, GetLocalizedStringName(L"UnitName_Hectogram"), GetLocalizedStringName(L"UnitAbbreviation_Hectogram"), 7 });
-    weightUnits.push_back(OrderedUnit{ UnitConverterUnits::Weight_Kilogram, GetLocalizedStringName(L"UnitName_Kilogram"), GetLocalizedStringName(L"UnitAbbreviation_Kilogram"), 8 , useUSCustomary, useSI});
-    weightUnits.push_back(OrderedUnit{ UnitConverterUnits::Weight_LongTon, GetLocalizedStringName(L"UnitName_LongTon"), GetLocalizedStringName(L"UnitAbbreviation_LongTon"), 14 });
-    weightUnits.push_back(OrderedUnit{ UnitConverterUnits::Weight_Milligram, GetLocalizedStringName(L"UnitName_Milligram"), GetLocalizedStringName(L"UnitAbbreviation_Milligram"), 2 });
-    weightUnits.push_back(OrderedUnit{ UnitConverterUnits::Weight_Ounce, GetLocalizedStringName(L"UnitName_Ounce"), GetLocalizedStringName(L"UnitAbbreviation_Ounce"), 10 });
-    weightUnits.push_back(OrderedUnit{ UnitConverterUnits::Weight_Pound, GetLocalizedStringName(L"UnitName_Pound"), GetLocalizedStringName(L"UnitAbbreviation_Pound"), 11 , useSI, useUSCustomary });
-    weightUnits.push_back(OrderedUnit{ UnitConverterUnits::Weight_ShortTon, GetLocalizedStringName(L"UnitName_ShortTon"), GetLocalizedStringName(L"UnitAbbreviation_ShortTon"), 13 });
-    weightUnits.push_back(OrderedUnit{ UnitConverterUnits::Weight_Stone, GetLocalizedStringName(L"UnitName_Stone"), GetLocalizedStringName(L"UnitAbbreviation_Stone"), 12 });
-    weightUnits.push_back(OrderedUnit{ UnitConverterUnits::Weight_Tonne, GetLocalizedStringName(L"UnitName_Tonne"), GetLocalizedStringName(L"UnitAbbreviation_Tonne"), 9 });
-    weightUnits.push_back(OrderedUnit{ UnitConverterUnits::Weight_Snowflake, GetLocalizedStringName(L"UnitName_Snowflake"), GetLocalizedStringName(L"UnitAbbreviation_Snowflake"), 15 ,false, false, true });
-    weightUnits.push_back(OrderedUnit{ UnitConverterUnits::Weight_SoccerBall, GetLocalizedStringName(L"UnitName_SoccerBall"), GetLocalizedStringName(L"UnitAbbreviation_SoccerBall"), 16 , false, false, true });
-    weightUnits.push_back(OrderedUnit{ UnitConverterUnits::Weight_Elephant, GetLocalizedStringName(L"UnitName_Elephant"), GetLocalizedStringName(L"UnitAbbreviation_Elephant"), 17 ,false, false, true });
-    weightUnits.push_back(OrderedUnit{ UnitConverterUnits::Weight_Whale, GetLocalizedStringName(L"UnitName_Whale"), GetLocalizedStringName(L"UnitAbbreviation_Whale"), 18 ,false, false, true });
-    unitMap.emplace(ViewMode::Weight, weightUnits);
-
-    vector<OrderedUnit> pressureUnits;
-    pressureUnits.push_back(OrderedUnit{ UnitConverterUnits::Pressure_Atmosphere, GetLocalizedStringName(L"UnitName_Atmosphere"), GetLocalizedStringName(L"UnitAbbreviation_Atmosphere"), 1 , true, false, false });
-    pressureUnits.push_back(OrderedUnit{ UnitConverterUnits::Pressure_Bar, GetLocalizedStringName(L"UnitName_Bar"), GetLocalizedStringName(L"UnitAbbreviation_Bar"), 2, false, true, false});
-    pressureUnits.push_back(OrderedUnit{ UnitConverterUnits::Pressure_KiloPascal, GetLocalizedStringName(L"UnitName_KiloPascal"), GetLocalizedStringName(L"UnitAbbreviation_KiloPascal"), 3 });
-    pressureUnits.push_back(OrderedUnit{ UnitConverterUnits::Pressure_MillimeterOfMercury, GetLocalizedStringName(L"UnitName_MillimeterOfMercury "), GetLocalizedStringName(L"UnitAbbreviation_MillimeterOfMercury "), 4 });
-    pressureUnits.push_back(OrderedUnit{ UnitConverterUnits::Pressure_Pascal, GetLocalizedStringName(L"UnitName_Pascal"), GetLocalizedStringName(L"UnitAbbreviation_Pascal"), 5 });
-    pressureUnits.push_back(OrderedUnit{ UnitConverterUnits::Pressure_PSI, GetLocalizedStringName(L"UnitName_PSI"), GetLocalizedStringName(L"UnitAbbreviation_PSI"), 6, false, false, false });
-    unitMap.emplace(ViewMode::Pressure, pressureUnits);
-
-    vector<OrderedUnit> angleUnits;
-    angleUnits.push_back(OrderedUnit{ UnitConverterUnits::Angle_Degree, GetLocalizedStringName(L"UnitName_Degree"), GetLocalizedStringName(L"UnitAbbreviation_Degree"), 1, true, false, false });
-    angleUnits.push_back(OrderedUnit{ UnitConverterUnits::Angle_Radian, GetLocalizedStringName(L"UnitName_Radian"), GetLocalizedStringName(L"UnitAbbreviation_Radian"), 2, false, true, false });
-    angleUnits.push_back(OrderedUnit{ UnitConverterUnits::Angle_Gradian, GetLocalizedStringName(L"UnitName_Gradian"), GetLocalizedStringName(L"UnitAbbreviation_Gradian"), 3});
-    unitMap.emplace(ViewMode::Angle, angleUnits);
+    RegionalConventions conventions{ useSI, useUSCustomary, useFahrenheit, useWattInsteadOfKilowatt, m_currentRegionCode == "GB" };
+
+    // Materialize each category's units from the static descriptor tables,
+    // resolving the localized strings from the resource keys as we go.
+    for (const UnitDescriptorTable& table : unitDescriptorTables)
+    {
+        vector<OrderedUnit> units;
+        units.reserve(table.count);
+        for (size_t i = 0; i < table.count; i++)
+        {
+            const OrderedUnitDescriptor& descriptor = table.units[i];
+            units.push_back(OrderedUnit{ descriptor.id,
+                GetLocalizedStringName(ref new String(descriptor.nameKey)),
+                GetLocalizedStringName(ref new String(descriptor.abbreviationKey)),
+                descriptor.order,
+                IsRegionalDefault(descriptor.source, conventions),
+                IsRegionalDefault(descriptor.target, conventions),
+                descriptor.isWhimsical });
+        }
+        unitMap.emplace(table.viewMode, move(units));
+    }
 }
 
 void UnitConverterDataLoader::GetConversionData(_In_ unordered_map<ViewMode, unordered_map<int, double>>& categoryToUnitConversionMap)
 {
     /*categoryId, UnitId, factor*/
-    static const vector<UnitData> unitDataList = {
+    static constexpr UnitData unitDataList[] = {
             { ViewMode::Area, UnitConverterUnits::Area_Acre, 4046.8564224 },
             { ViewMode::Area, UnitConverterUnits::Area_SquareMeter, 1 },
             { ViewMode::Area, UnitConverterUnits::Area_SquareFoot, 0.09290304 },
@@ -534,7 +659,7 @@ void UnitConverterDataLoader::GetConversionData(_In_ unordered_map<ViewMode, uno
     };
 
     // Populate the hash map and return;
-    for (UnitData unitdata : unitDataList)
+    for (const UnitData& unitdata : unitDataList)
     {
         if (categoryToUnitConversionMap.find(unitdata.categoryId) == categoryToUnitConversionMap.end())
         {
@@ -557,7 +682,7 @@ void UnitConverterDataLoader::GetConversionData(_In_ unordered_map<ViewMode, uno
  void UnitConverterDataLoader::GetExplicitConversionData(_In_ unordered_map<int, unordered_map<int, UCM::ConversionData>>& unitToUnitConversionList)
  {
      /* categoryId, ParentUnitId, UnitId, ratio, offset, offsetfirst*/
-     ExplicitUnitConversionData conversionDataList[] = {
+     static const ExplicitUnitConversionData conversionDataList[] = {
          { ViewMode::Temperature, UnitConverterUnits::Temperature_DegreesCelsius, UnitConverterUnits::Temperature_DegreesCelsius , 1, 0 },
          { ViewMode::Temperature, UnitConverterUnits::Temperature_DegreesCelsius, UnitConverterUnits::Temperature_DegreesFahrenheit, 1.8, 32 },
          { ViewMode::Temperature, UnitConverterUnits::Temperature_DegreesCelsius, UnitConverterUnits::Temperature_Kelvin, 1, 273.15 },
@@ -570,7 +695,7 @@ void UnitConverterDataLoader::GetConversionData(_In_ unordered_map<ViewMode, uno
      };
 
      // Populate the hash map and return;
-     for (ExplicitUnitConversionData data : conversionDataList)
+     for (const ExplicitUnitConversionData& data : conversionDataList)
      {
          if (unitToUnitConversionList.find(data.parentUnitId) == unitToUnitConversionList.end())
          {
@@ -47,7 +47,7 @@ namespace CalculatorApp
             public std::enable_shared_from_this<UnitConverterDataLoader>
         {
         public:
-            UnitConverterDataLoader(Windows::Globalization::GeographicRegion^ region);
+            UnitConverterDataLoader(Platform::String^ regionCodeTwoLetter);
 
         private:
             // IConverterDataLoader
@@ -20,10 +20,15 @@ using namespace Windows::ApplicationModel::Resources;
 using namespace Windows::Foundation;
 using namespace Windows::Globalization;
 using namespace Windows::Globalization::DateTimeFormatting;
+using namespace concurrency;
 using namespace Windows::System::UserProfile;
 
 namespace
 {
+    // Time to wait before recalculating so that rapid input changes
+    // (e.g. scrolling a date picker) coalesce into a single calculation.
+    constexpr unsigned int CALCULATION_DELAY_IN_MS = 100;
+
     StringReference StrDateDiffResultPropertyName(L"StrDateDiffResult");
     StringReference StrDateDiffResultAutomationNamePropertyName(L"StrDateDiffResultAutomationName");
     StringReference StrDateDiffResultInDaysPropertyName(L"StrDateDiffResultInDays");
@@ -52,6 +57,7 @@ DateCalculatorViewModel::DateCalculatorViewModel() :
 
     // Initialize Date Calc engine
     m_dateCalcEngine = make_shared<DateCalculationEngine>(localizationSettings.GetCalendarIdentifier());
+    m_dateCalcEngineMutex = make_shared<mutex>();
     // Initialize dates of DatePicker controls to today's date
     auto calendar = ref new Calendar();
     // We force the timezone to UTC, in order to avoid being affected by Daylight Saving Time
@@ -116,43 +122,83 @@ void DateCalculatorViewModel::OnPropertyChanged(_In_ String^ prop)
 
 void DateCalculatorViewModel::OnInputsChanged()
 {
-    DateDifference dateDiff;
+    // Replacing the helper cancels any recalculation that is still pending,
+    // so a burst of input changes results in a single calculation.
+    m_recalculationTaskHelper = make_unique<ConversionResultTaskHelper>(CALCULATION_DELAY_IN_MS, [this]() {
+        StartRecalculation();
+    });
+}
+
+void DateCalculatorViewModel::StartRecalculation()
+{
+    // Runs on the UI thread once the debounce delay has elapsed. Snapshot the
+    // inputs here, calculate on a background continuation and deliver the
+    // results back on the UI thread, discarding them if a newer calculation
+    // has been started in the meantime.
+    const unsigned int calculationId = ++m_currentCalculationId;
+    auto dateCalcEngine = m_dateCalcEngine;
+    auto engineMutex = m_dateCalcEngineMutex;
 
     if (m_IsDateDiffMode)
     {
         DateTime clippedFromDate = ClipTime(FromDate);
         DateTime clippedToDate = ClipTime(ToDate);
-
-        // Calculate difference between two dates
-        m_dateCalcEngine->GetDateDifference(clippedFromDate, clippedToDate, m_allDateUnitsOutputFormat, &dateDiff);
-        DateDiffResult = dateDiff;
-
-        m_dateCalcEngine->GetDateDifference(clippedFromDate, clippedToDate, m_daysOutputFormat, &dateDiff);
-        DateDiffResultInDays = dateDiff;
+        DateUnit allDateUnitsOutputFormat = m_allDateUnitsOutputFormat;
+        DateUnit daysOutputFormat = m_daysOutputFormat;
+
+        create_task([dateCalcEngine, engineMutex, clippedFromDate, clippedToDate, allDateUnitsOutputFormat, daysOutputFormat]() {
+            lock_guard<mutex> lock(*engineMutex);
+            pair<DateDifference, DateDifference> dateDiffs;
+
+            // Calculate difference between two dates
+            dateCalcEngine->GetDateDifference(clippedFromDate, clippedToDate, allDateUnitsOutputFormat, &dateDiffs.first);
+            dateCalcEngine->GetDateDifference(clippedFromDate, clippedToDate, daysOutputFormat, &dateDiffs.second);
+            return dateDiffs;
+        }).then([this, calculationId](pair<DateDifference, DateDifference> dateDiffs) {
+            if (calculationId == m_currentCalculationId)
+            {
+                DateDiffResult = dateDiffs.first;
+                DateDiffResultInDays = dateDiffs.second;
+            }
+        }, task_continuation_context::use_current());
     }
     else
     {
+        DateDifference dateDiff;
         dateDiff.day = DaysOffset;
         dateDiff.month = MonthsOffset;
         dateDiff.year = YearsOffset;
 
-        DateTime dateTimeResult;
-
-        if (m_IsAddMode)
-        {
-            // Add number of Days, Months and Years to a Date
-            IsOutOfBound = !m_dateCalcEngine->AddDuration(StartDate, dateDiff, &dateTimeResult);
-        }
-        else
-        {
-            // Subtract number of Days, Months and Years from a Date
-            IsOutOfBound = !m_dateCalcEngine->SubtractDuration(StartDate, dateDiff, &dateTimeResult);
-        }
-
-        if (!m_isOutOfBound)
-        {
-            DateResult = dateTimeResult;
-        }
+        DateTime startDate = StartDate;
+        bool isAddMode = m_IsAddMode;
+
+        create_task([dateCalcEngine, engineMutex, startDate, dateDiff, isAddMode]() {
+            lock_guard<mutex> lock(*engineMutex);
+            pair<bool, DateTime> dateResult;
+
+            if (isAddMode)
+            {
+                // Add number of Days, Months and Years to a Date
+                dateResult.first = dateCalcEngine->AddDuration(startDate, dateDiff, &dateResult.second);
+            }
+            else
+            {
+                // Subtract number of Days, Months and Years from a Date
+                dateResult.first = dateCalcEngine->SubtractDuration(startDate, dateDiff, &dateResult.second);
+            }
+
+            return dateResult;
+        }).then([this, calculationId](pair<bool, DateTime> dateResult) {
+            if (calculationId == m_currentCalculationId)
+            {
+                IsOutOfBound = !dateResult.first;
+
+                if (!m_isOutOfBound)
+                {
+                    DateResult = dateResult.second;
+                }
+            }
+        }, task_continuation_context::use_current());
     }
 }
 
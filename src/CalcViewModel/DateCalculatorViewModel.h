@@ -5,6 +5,7 @@
 
 #include "Common/Utils.h"
 #include "Common/DateCalculator.h"
+#include "Common/ConversionResultTaskHelper.h"
 
 const int c_maxOffsetValue = 999;
 
@@ -95,6 +96,7 @@ namespace CalculatorApp
         private:
             void OnPropertyChanged(_In_ Platform::String^ prop);
             void OnInputsChanged();
+            void StartRecalculation();
             void UpdateDisplayResult();
             void UpdateStrDateDiffResultAutomationName();
             void UpdateStrDateResultAutomationName();
@@ -145,6 +147,17 @@ namespace CalculatorApp
             CalculatorApp::Common::DateCalculation::DateUnit m_allDateUnitsOutputFormat;
             Windows::Globalization::DateTimeFormatting::DateTimeFormatter^ m_dateTimeFormatter;
             std::wstring m_listSeparator;
+
+            // Debounces recalculation while the user scrolls the date pickers;
+            // re-creating the helper cancels the previously pending run.
+            std::unique_ptr<CalculatorApp::Common::ConversionResultTaskHelper> m_recalculationTaskHelper;
+
+            // Identifies the most recent recalculation; background results
+            // from superseded calculations are discarded on delivery.
+            unsigned int m_currentCalculationId = 0;
+
+            // Serializes access to m_dateCalcEngine from background calculations.
+            std::shared_ptr<std::mutex> m_dateCalcEngineMutex;
         };
     }
 }
@@ -15,9 +15,45 @@ HistoryItemViewModel::HistoryItemViewModel(String^ expression, String^ result,
     _In_ const shared_ptr<CalculatorVector <pair<wstring, int>>> &spTokens,
     _In_ const shared_ptr<CalculatorVector<shared_ptr<IExpressionCommand>>> &spCommands) :m_expression(expression), m_result(result), m_spTokens(spTokens), m_spCommands(spCommands)
 {
-    // updating accessibility names for expression and result
-    m_accExpression = HistoryItemViewModel::GetAccessibleExpressionFromTokens(spTokens, m_expression);
-    m_accResult = LocalizationService::GetNarratorReadableString(m_result);
+    // The accessibility names are built on first property access; most
+    // entries are never focused, so populating the list allocates only
+    // the display strings it was given.
+}
+
+HistoryItemViewModel::HistoryItemViewModel(String^ expression, String^ result,
+    _In_ const shared_ptr<CalculationManager::HISTORYITEM> &spHistoryItem) :
+    m_expression(expression), m_result(result), m_spHistoryItem(spHistoryItem)
+{
+    // The accessibility name walks the token vector, so it is built on
+    // first request instead of hydrating every listed item up front.
+}
+
+void HistoryItemViewModel::EnsureTokensAndCommands()
+{
+    if (m_spTokens == nullptr && m_spHistoryItem != nullptr)
+    {
+        CalculationManager::CalculatorHistory::HydrateItem(m_spHistoryItem->historyItemVector);
+        m_spTokens = m_spHistoryItem->historyItemVector.spTokens;
+        m_spCommands = m_spHistoryItem->historyItemVector.spCommands;
+    }
+}
+
+String^ HistoryItemViewModel::GetAccExpression()
+{
+    if (m_accExpression == nullptr)
+    {
+        m_accExpression = HistoryItemViewModel::GetAccessibleExpressionFromTokens(GetTokens(), m_expression);
+    }
+    return m_accExpression;
+}
+
+String^ HistoryItemViewModel::GetAccResult()
+{
+    if (m_accResult == nullptr)
+    {
+        m_accResult = LocalizationService::GetNarratorReadableString(m_result);
+    }
+    return m_accResult;
 }
 
 String^ HistoryItemViewModel::GetAccessibleExpressionFromTokens(_In_ shared_ptr< CalculatorVector< pair< wstring, int > > > const &spTokens, _In_ String^ fallbackExpression)
@@ -26,32 +62,16 @@ String^ HistoryItemViewModel::GetAccessibleExpressionFromTokens(_In_ shared_ptr<
     wstringstream accExpression{};
     accExpression << L"";
 
-    unsigned int nTokens;
-    HRESULT hr = spTokens->GetSize(&nTokens);
-    if (SUCCEEDED(hr))
+    for (auto const& tokenItem : *spTokens)
     {
-        pair<wstring, int> tokenItem;
-        for (unsigned int i = 0; i < nTokens; i++)
-        {
-            hr = spTokens->GetAt(i, &tokenItem);
-            if (FAILED(hr))
-            {
-                break;
-            }
-
-            wstring token = tokenItem.first;
-            accExpression << LocalizationService::GetNarratorReadableToken(StringReference(token.c_str()))->Data();
-        }
+        accExpression << LocalizationService::GetNarratorReadableToken(StringReference(tokenItem.first.c_str()))->Data();
     }
 
+    wstring expressionSuffix{};
+    HRESULT hr = spTokens->GetExpressionSuffix(&expressionSuffix);
     if (SUCCEEDED(hr))
     {
-        wstring expressionSuffix{};
-        hr = spTokens->GetExpressionSuffix(&expressionSuffix);
-        if (SUCCEEDED(hr))
-        {
-            accExpression << expressionSuffix;
-        }
+        accExpression << expressionSuffix;
     }
 
     if (FAILED(hr))
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "CalcManager/CalculatorVector.h"
+#include "CalcManager/CalculatorHistory.h"
 #include "CalcManager/ExpressionCommandInterface.h"
 
 namespace CalculatorApp
@@ -21,13 +22,22 @@ namespace CalculatorApp
                 _In_ std::shared_ptr<CalculatorVector <std::pair<std::wstring, int>>> const &spTokens,
                 _In_ std::shared_ptr<CalculatorVector<std::shared_ptr<IExpressionCommand>>> const &spCommands);
 
+            // Lazy form: tokens, commands and the accessibility name are
+            // produced from the packed history item only when first needed,
+            // so listing a deep history does not hydrate every entry.
+            HistoryItemViewModel(Platform::String^ expression,
+                Platform::String^ result,
+                _In_ std::shared_ptr<CalculationManager::HISTORYITEM> const &spHistoryItem);
+
             std::shared_ptr<CalculatorVector <std::pair<std::wstring, int>>> const& GetTokens()
             {
+                EnsureTokensAndCommands();
                 return m_spTokens;
             }
 
             std::shared_ptr<CalculatorVector<std::shared_ptr<IExpressionCommand>>> const& GetCommands()
             {
+                EnsureTokensAndCommands();
                 return m_spCommands;
             }
 
@@ -40,7 +50,7 @@ namespace CalculatorApp
 
             property Platform::String^ AccExpression
             {
-                Platform::String^ get() { return m_accExpression; }
+                Platform::String^ get() { return GetAccExpression(); }
             }
 
             property Platform::String^ Result
@@ -50,7 +60,7 @@ namespace CalculatorApp
 
             property Platform::String^ AccResult
             {
-                Platform::String^ get() { return m_accResult; }
+                Platform::String^ get() { return GetAccResult(); }
             }
 
             virtual Windows::UI::Xaml::Data::ICustomProperty^ GetCustomProperty(Platform::String^ name)
@@ -73,7 +83,7 @@ namespace CalculatorApp
 
             virtual Platform::String^ GetStringRepresentation()
             {
-                return m_accExpression + " " + m_accResult;
+                return GetAccExpression() + " " + GetAccResult();
             }
 
         private:
@@ -81,11 +91,16 @@ namespace CalculatorApp
                 _In_ std::shared_ptr<CalculatorVector <std::pair<std::wstring, int>>> const &spTokens,
                 _In_ Platform::String^ fallbackExpression);
 
+            void EnsureTokensAndCommands();
+            Platform::String^ GetAccExpression();
+            Platform::String^ GetAccResult();
+
         private:
             Platform::String^ m_expression;
             Platform::String^ m_accExpression;
             Platform::String^ m_accResult;
             Platform::String^ m_result;
+            std::shared_ptr<CalculationManager::HISTORYITEM> m_spHistoryItem;
             std::shared_ptr<CalculatorVector <std::pair<std::wstring, int>>> m_spTokens;
             std::shared_ptr<CalculatorVector<std::shared_ptr<IExpressionCommand>>> m_spCommands;
         };
@@ -3,6 +3,7 @@
 
 #include "pch.h"
 #include "HistoryViewModel.h"
+#include "CalcManager/HistoryJournal.h"
 #include "Common/TraceLogger.h"
 #include "Common/LocalizationStringUtil.h"
 #include "Common/LocalizationSettings.h"
@@ -21,18 +22,101 @@ using namespace Windows::Foundation::Collections;
 
 static StringReference HistoryVectorLengthKey{ L"HistoryVectorLength" };
 
+// Number of history entries hydrated into ViewModels up front; the rest are
+// realized page by page as the list scrolls.
+static constexpr unsigned int HISTORY_PAGE_SIZE = 50;
+
 namespace CalculatorApp::ViewModel::HistoryResourceKeys
 {
     StringReference HistoryCleared(L"HistoryList_Cleared");
 }
 
+HistoryItemsVector::HistoryItemsVector()
+{
+    auto items = ref new Platform::Collections::Vector<HistoryItemViewModel^>();
+    m_items = items;
+    m_items->VectorChanged += ref new Windows::UI::Xaml::Interop::BindableVectorChangedEventHandler(this, &HistoryItemsVector::OnInnerVectorChanged);
+}
+
+void HistoryItemsVector::OnInnerVectorChanged(Windows::UI::Xaml::Interop::IBindableObservableVector^ /*vector*/, Object^ e)
+{
+    // Re-raise with this vector as the sender, since this is the object the
+    // list is bound to.
+    m_vectorChanged(this, e);
+}
+
+IAsyncOperation<Windows::UI::Xaml::Data::LoadMoreItemsResult>^ HistoryItemsVector::LoadMoreItemsAsync(unsigned int count)
+{
+    // The ListView calls this on the UI thread, which is where the item
+    // ViewModels must be built anyway; realize synchronously and hand back
+    // an already-completed operation.
+    Windows::UI::Xaml::Data::LoadMoreItemsResult result;
+    result.Count = RealizeMoreItems(count);
+    return concurrency::create_async([result]() { return result; });
+}
+
+unsigned int HistoryItemsVector::RealizeMoreItems(unsigned int count)
+{
+    unsigned int realized = 0;
+    while (realized < count && !m_pendingModelItems.empty() && m_realizeItem)
+    {
+        auto item = m_realizeItem(m_pendingModelItems.front());
+        m_pendingModelItems.erase(m_pendingModelItems.begin());
+        if (item == nullptr)
+        {
+            break;
+        }
+
+        m_items->Append(item);
+        ++realized;
+    }
+    return realized;
+}
+
+void HistoryItemsVector::SetRealizeItemCallback(_In_ std::function<HistoryItemViewModel^(std::shared_ptr<CalculationManager::HISTORYITEM> const&)> const& callback)
+{
+    m_realizeItem = callback;
+}
+
+void HistoryItemsVector::SetPendingModelItems(_In_ std::vector<std::shared_ptr<CalculationManager::HISTORYITEM>>&& pendingItems)
+{
+    m_pendingModelItems = std::move(pendingItems);
+}
+
+std::vector<std::shared_ptr<CalculationManager::HISTORYITEM>> HistoryItemsVector::TakePendingModelItems()
+{
+    std::vector<std::shared_ptr<CalculationManager::HISTORYITEM>> pendingItems;
+    pendingItems.swap(m_pendingModelItems);
+    return pendingItems;
+}
+
+std::shared_ptr<CalculationManager::HISTORYITEM> HistoryItemsVector::PopOldestPending()
+{
+    auto item = m_pendingModelItems.back();
+    m_pendingModelItems.pop_back();
+    return item;
+}
+
+unsigned int HistoryItemsVector::PendingSize()
+{
+    return static_cast<unsigned int>(m_pendingModelItems.size());
+}
+
 HistoryViewModel::HistoryViewModel(_In_ CalculationManager::CalculatorManager* calculatorManager) :
     m_calculatorManager(calculatorManager),
     m_localizedHistoryCleared(nullptr)
 {
     AreHistoryShortcutsEnabled = true;
 
-    Items = ref new Platform::Collections::Vector<HistoryItemViewModel^>();
+    m_historyItems = ref new HistoryItemsVector();
+    WeakReference weakThis(this);
+    m_historyItems->SetRealizeItemCallback(
+        [weakThis](std::shared_ptr<CalculationManager::HISTORYITEM> const& item) -> HistoryItemViewModel^
+        {
+            auto that = weakThis.Resolve<HistoryViewModel>();
+            return (that != nullptr) ? that->GetOrCreateHistoryItemViewModel(item) : nullptr;
+        });
+    Items = m_historyItems;
     ItemSize = 0;
 }
 
@@ -58,52 +142,216 @@ void HistoryViewModel::ReloadHistory(_In_ ViewMode currentMode)
         return;
     }
 
-    auto historyListModel = m_calculatorManager->GetHistoryItems(m_currentMode);
-    auto historyListVM = ref new Platform::Collections::Vector<HistoryItemViewModel^>();
-    const auto& localizer = LocalizationSettings::GetInstance();
-    if (historyListModel.size() > 0)
+    // Fold in anything other windows have published since the last look.
+    // One atomic compare when this is the only window or nothing changed.
+    m_calculatorManager->SyncHistoryFromShared(m_currentMode);
+
+    // Until the pane has been opened once, keep only the badge count
+    // current; hydrating item ViewModels waits for EnsureHistoryLoaded,
+    // so mode switches and resume stay free of history-proportional work.
+    if (!m_historyHydrated)
+    {
+        ItemSize = static_cast<int>(m_calculatorManager->GetHistoryItems(m_currentMode).size());
+        return;
+    }
+
+    LoadHistoryItems();
+}
+
+// Hydrate on first pane open; afterwards ReloadHistory keeps the hydrated
+// list current directly. The XAML side already realizes the pane lazily,
+// so this is called exactly when the user first looks at history.
+void HistoryViewModel::EnsureHistoryLoaded()
+{
+    if (m_historyHydrated)
     {
-        for (auto ritr = historyListModel.rbegin(); ritr != historyListModel.rend(); ++ritr)
+        return;
+    }
+    m_historyHydrated = true;
+    LoadHistoryItems();
+}
+
+// Builds (or refreshes) the item ViewModels for the current mode's history.
+void HistoryViewModel::LoadHistoryItems()
+{
+    // Adopt cross-window additions before presenting, so the pane of any
+    // window shows the union of what every window computed.
+    m_calculatorManager->SyncHistoryFromShared(m_currentMode);
+
+    // Iterate the manager's history storage in place; GetHistoryItems hands
+    // out a reference, so a reload never copies the whole container.
+    auto const& historyListModel = m_calculatorManager->GetHistoryItems(m_currentMode);
+
+    // Hydrate the newest page eagerly (or as much as is already realized, so
+    // a reload never collapses a list the user has scrolled through); older
+    // entries stay as model items until incremental loading asks for them.
+    size_t realizeCount = max(static_cast<size_t>(HISTORY_PAGE_SIZE), static_cast<size_t>(Items->Size));
+    realizeCount = min(realizeCount, historyListModel.size());
+
+    std::vector<HistoryItemViewModel^> updatedItems;
+    updatedItems.reserve(realizeCount);
+    std::vector<std::shared_ptr<CalculationManager::HISTORYITEM>> pendingItems;
+    pendingItems.reserve(historyListModel.size() - realizeCount);
+    size_t itemIndex = 0;
+    for (auto ritr = historyListModel.rbegin(); ritr != historyListModel.rend(); ++ritr, ++itemIndex)
+    {
+        if (itemIndex < realizeCount)
+        {
+            updatedItems.push_back(GetOrCreateHistoryItemViewModel(*ritr));
+        }
+        else
         {
-            wstring expression = (*ritr)->historyItemVector.expression;
-            wstring result = (*ritr)->historyItemVector.result;
-            localizer.LocalizeDisplayValue(&expression);
-            localizer.LocalizeDisplayValue(&result);
-
-            auto item = ref new HistoryItemViewModel(ref new Platform::String( expression.c_str()),
-                ref new Platform::String(result.c_str()),
-                (*ritr)->historyItemVector.spTokens, (*ritr)->historyItemVector.spCommands);
-            historyListVM->Append(item);
+            pendingItems.push_back(*ritr);
         }
     }
 
-    Items = historyListVM;
+    SynchronizeItems(updatedItems);
+    m_historyItems->SetPendingModelItems(std::move(pendingItems));
     UpdateItemSize();
 }
 
-void HistoryViewModel::OnHistoryItemAdded(_In_ unsigned int addedItemIndex)
+// Answers a substring search over the current mode's history from the
+// manager's trigram index, newest match first to match the list's
+// presentation order. Matched entries reuse the pooled ViewModels, so
+// a search result row is the same object the full list shows.
+IVector<HistoryItemViewModel^>^ HistoryViewModel::FindItems(_In_ Platform::String^ query)
 {
-    auto newItem = m_calculatorManager->GetHistoryItem(addedItemIndex);
+    auto matchedIndices = m_calculatorManager->SearchHistory(query->Data());
+    auto const& historyListModel = m_calculatorManager->GetHistoryItems();
+
+    auto results = ref new Platform::Collections::Vector<HistoryItemViewModel^>();
+    for (auto ritr = matchedIndices.rbegin(); ritr != matchedIndices.rend(); ++ritr)
+    {
+        results->Append(GetOrCreateHistoryItemViewModel(historyListModel[*ritr]));
+    }
+
+    return results;
+}
+
+// Returns the pooled ViewModel for a history entry, creating and pooling
+// one the first time the entry is shown.
+HistoryItemViewModel^ HistoryViewModel::GetOrCreateHistoryItemViewModel(_In_ std::shared_ptr<CalculationManager::HISTORYITEM> const &item)
+{
+    auto pooledItem = m_itemViewModelPool.find(item);
+    if (pooledItem != m_itemViewModelPool.end())
+    {
+        return pooledItem->second;
+    }
+
     const auto& localizer = LocalizationSettings::GetInstance();
-    wstring expression = newItem->historyItemVector.expression;
-    wstring result = newItem->historyItemVector.result;
+    wstring expression = item->historyItemVector.expression;
+    wstring result = item->historyItemVector.result;
     localizer.LocalizeDisplayValue(&expression);
     localizer.LocalizeDisplayValue(&result);
-    auto item = ref new HistoryItemViewModel(ref new Platform::String(expression.c_str()),
-    ref new Platform::String(result.c_str()),
-    newItem->historyItemVector.spTokens, newItem->historyItemVector.spCommands );
+
+    auto itemVM = ref new HistoryItemViewModel(ref new Platform::String(expression.c_str()),
+        ref new Platform::String(result.c_str()),
+        item);
+    m_itemViewModelPool.emplace(item, itemVM);
+    return itemVM;
+}
+
+// Brings Items in line with updatedItems using single-item inserts and
+// removals, so entries that did not change raise no collection change.
+// History only ever changes by insertion and removal, never reordering,
+// which keeps this a single forward pass.
+void HistoryViewModel::SynchronizeItems(_In_ const std::vector<HistoryItemViewModel^>& updatedItems)
+{
+    unsigned int index = 0;
+    for (HistoryItemViewModel^ item : updatedItems)
+    {
+        unsigned int existingIndex;
+        if (Items->IndexOf(item, &existingIndex) && existingIndex >= index)
+        {
+            // Remove the entries this item has moved up past.
+            while (existingIndex > index)
+            {
+                Items->RemoveAt(index);
+                --existingIndex;
+            }
+        }
+        else
+        {
+            Items->InsertAt(index, item);
+        }
+
+        ++index;
+    }
+
+    // Remove the entries beyond the end of the updated list.
+    while (Items->Size > index)
+    {
+        Items->RemoveAt(Items->Size - 1);
+    }
+}
+
+void HistoryViewModel::RemoveItemFromPool(_In_ HistoryItemViewModel^ item)
+{
+    for (auto itr = m_itemViewModelPool.begin(); itr != m_itemViewModelPool.end(); ++itr)
+    {
+        if (itr->second == item)
+        {
+            m_itemViewModelPool.erase(itr);
+            break;
+        }
+    }
+}
+
+void HistoryViewModel::OnHistoryItemAdded(_In_ unsigned int addedItemIndex)
+{
+    auto newItem = m_calculatorManager->GetHistoryItem(addedItemIndex);
+
+    if (!m_historyHydrated)
+    {
+        // Pane never opened: maintain only the badge count and the journal.
+        // The manager already evicted the oldest entry in place when its
+        // ring was full, in which case the count does not grow.
+        bool rolledOver = static_cast<size_t>(ItemSize) >= m_calculatorManager->MaxHistorySize();
+        if (!rolledOver)
+        {
+            ItemSize = ItemSize + 1;
+            AppendHistoryJournal(newItem);
+        }
+        else
+        {
+            // The oldest entry fell off the ring, so the journal needs a rewrite.
+            SaveHistory();
+        }
+        return;
+    }
+
+    auto item = GetOrCreateHistoryItemViewModel(newItem);
 
     // check if we have not hit the max items
-    if (Items->Size >= m_calculatorManager->MaxHistorySize())
+    bool evictedOldest = (Items->Size + m_historyItems->PendingSize() >= m_calculatorManager->MaxHistorySize());
+    if (evictedOldest)
     {
-        // this means the item already exists
-        Items->RemoveAt(Items->Size -1);
+        // The oldest entry is the last pending one when any remain
+        // unrealized, otherwise the last realized item.
+        if (m_historyItems->PendingSize() > 0)
+        {
+            m_itemViewModelPool.erase(m_historyItems->PopOldestPending());
+        }
+        else
+        {
+            RemoveItemFromPool(safe_cast<HistoryItemViewModel^>(Items->GetAt(Items->Size - 1)));
+            Items->RemoveAt(Items->Size -1);
+        }
     }
 
     assert(addedItemIndex <= m_calculatorManager->MaxHistorySize() && addedItemIndex >= 0);
     Items->InsertAt(0, item);
     UpdateItemSize();
-    SaveHistory();
+
+    if (evictedOldest)
+    {
+        // The oldest entry fell off the ring, so the journal needs a rewrite.
+        SaveHistory();
+    }
+    else
+    {
+        AppendHistoryJournal(newItem);
+    }
 }
 
 void HistoryViewModel::SetCalculatorDisplay(CalculatorDisplay &calculatorDisplay)
@@ -131,6 +379,7 @@ void HistoryViewModel::DeleteItem(_In_ HistoryItemViewModel^ e)
             historyContainer->Values->Clear();
 
             Items->RemoveAt(itemIndex);
+            RemoveItemFromPool(e);
             UpdateItemSize();
             SaveHistory();
         }
@@ -150,10 +399,25 @@ void HistoryViewModel::OnClearCommand(_In_ Platform::Object^ e)
     {
         m_calculatorManager->ClearHistory();
 
-        if (Items->Size > 0)
+        // ItemSize covers the unhydrated case, where entries exist only in
+        // the manager and the stores below.
+        if (Items->Size > 0 || m_historyItems->PendingSize() > 0 || ItemSize > 0)
         {
             CalculationManager::CALCULATOR_MODE currentMode = m_currentMode;
             ClearHistoryContainer(currentMode);
+            DeleteHistoryJournal(currentMode);
+
+            // Only release the cleared mode's pooled ViewModels; the other
+            // mode's history is untouched.
+            for (unsigned int i = 0; i < Items->Size; ++i)
+            {
+                RemoveItemFromPool(safe_cast<HistoryItemViewModel^>(Items->GetAt(i)));
+            }
+            for (auto const& pendingItem : m_historyItems->TakePendingModelItems())
+            {
+                m_itemViewModelPool.erase(pendingItem);
+            }
+
             Items->Clear();
             UpdateItemSize();
         }
@@ -165,6 +429,13 @@ void HistoryViewModel::OnClearCommand(_In_ Platform::Object^ e)
 // this method restores history vector per mode
 void HistoryViewModel::RestoreHistory(_In_ CalculationManager::CALCULATOR_MODE cMode)
 {
+    // The mapped journal is the primary store; the container below is only
+    // read to migrate history saved by an earlier build.
+    if (RestoreHistoryFromJournal(cMode))
+    {
+        return;
+    }
+
     ApplicationDataContainer^ historyContainer = GetHistoryContainer(cMode);
     std::shared_ptr<std::vector<std::shared_ptr<CalculationManager::HISTORYITEM>>> historyVector = std::make_shared<std::vector<std::shared_ptr<CalculationManager::HISTORYITEM>>>();
     auto historyVectorLength = static_cast<int>(historyContainer->Values->Lookup(HistoryVectorLengthKey));
@@ -195,6 +466,9 @@ void HistoryViewModel::RestoreHistory(_In_ CalculationManager::CALCULATOR_MODE c
 
             // update length once again for consistency between stored number of items and length
             UpdateHistoryVectorLength(static_cast<int>(historyVector->size()), cMode);
+
+            // Migrate to the journal so the next launch maps it directly.
+            WriteHistoryJournal(cMode);
         }
         else
         {
@@ -251,65 +525,321 @@ void HistoryViewModel::ClearHistory()
 {
     ClearHistoryContainer(CalculationManager::CALCULATOR_MODE::CM_STD);
     ClearHistoryContainer(CalculationManager::CALCULATOR_MODE::CM_SCI);
+    DeleteHistoryJournal(CalculationManager::CALCULATOR_MODE::CM_STD);
+    DeleteHistoryJournal(CalculationManager::CALCULATOR_MODE::CM_SCI);
 }
 
 void HistoryViewModel::SaveHistory()
 {
-    ApplicationDataContainer^ historyContainer = GetHistoryContainer(m_currentMode);
-    auto currentHistoryVector = m_calculatorManager->GetHistoryItems(m_currentMode);
-    bool failure = false;
-    int index = 0;
-    Platform::String^ serializedHistoryItem;
+    WriteHistoryJournal(m_currentMode);
+}
 
-    for (auto iter = currentHistoryVector.begin(); iter != currentHistoryVector.end(); ++iter)
+std::wstring HistoryViewModel::GetHistoryJournalPath(_In_ CalculationManager::CALCULATOR_MODE cMode)
+{
+    std::wstring path{ ApplicationData::Current->LocalFolder->Path->Data() };
+    path += L'\\';
+    path += GetHistoryContainerKey(cMode)->Data();
+    path += L".bin";
+    return path;
+}
+
+bool HistoryViewModel::RestoreHistoryFromJournal(_In_ CalculationManager::CALCULATOR_MODE cMode)
+{
+    HANDLE hFile = CreateFile2(GetHistoryJournalPath(cMode).c_str(), GENERIC_READ, FILE_SHARE_READ, OPEN_EXISTING, nullptr);
+    if (hFile == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    bool restored = false;
+    LARGE_INTEGER fileSize;
+    if (GetFileSizeEx(hFile, &fileSize) && fileSize.HighPart == 0 && fileSize.LowPart >= sizeof(CalculationManager::JOURNALHEADER))
     {
-        try
+        HANDLE hMapping = CreateFileMappingFromApp(hFile, nullptr, PAGE_READONLY, 0, nullptr);
+        if (hMapping != nullptr)
         {
-            serializedHistoryItem = SerializeHistoryItem(*iter);
-            historyContainer->Values->Insert(index.ToString(), serializedHistoryItem);
+            void* pView = MapViewOfFileFromApp(hMapping, FILE_MAP_READ, 0, 0);
+            if (pView != nullptr)
+            {
+                std::vector<std::shared_ptr<CalculationManager::HISTORYITEM>> items;
+                if (CalculationManager::HistoryJournal::Deserialize(static_cast<unsigned char const*>(pView), fileSize.LowPart, items))
+                {
+                    m_calculatorManager->SetHistory(cMode, items);
+                    restored = true;
+                }
+                UnmapViewOfFile(pView);
+            }
+            CloseHandle(hMapping);
         }
-        catch (Platform::Exception^)
+    }
+
+    CloseHandle(hFile);
+    return restored;
+}
+
+void HistoryViewModel::WriteHistoryJournal(_In_ CalculationManager::CALCULATOR_MODE cMode)
+{
+    auto journal = CalculationManager::HistoryJournal::Serialize(m_calculatorManager->GetHistoryItems(cMode));
+
+    // Write beside the journal and swap it in, so a crash mid-write cannot
+    // leave a torn file behind.
+    std::wstring path = GetHistoryJournalPath(cMode);
+    std::wstring tempPath = path + L".tmp";
+    HANDLE hFile = CreateFile2(tempPath.c_str(), GENERIC_WRITE, 0, CREATE_ALWAYS, nullptr);
+    if (hFile == INVALID_HANDLE_VALUE)
+    {
+        return;
+    }
+
+    DWORD cbWritten = 0;
+    BOOL fWrote = WriteFile(hFile, journal.data(), static_cast<DWORD>(journal.size()), &cbWritten, nullptr);
+    CloseHandle(hFile);
+    if (fWrote && cbWritten == journal.size())
+    {
+        MoveFileExW(tempPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING);
+    }
+    else
+    {
+        DeleteFileW(tempPath.c_str());
+    }
+}
+
+void HistoryViewModel::AppendHistoryJournal(_In_ std::shared_ptr<CalculationManager::HISTORYITEM> const &item)
+{
+    HANDLE hFile = CreateFile2(GetHistoryJournalPath(m_currentMode).c_str(), GENERIC_READ | GENERIC_WRITE, 0, OPEN_EXISTING, nullptr);
+    if (hFile == INVALID_HANDLE_VALUE)
+    {
+        // No journal yet; write it whole.
+        WriteHistoryJournal(m_currentMode);
+        return;
+    }
+
+    DWORD cbIo = 0;
+    CalculationManager::JOURNALHEADER header;
+    bool fAppended = (ReadFile(hFile, &header, sizeof(header), &cbIo, nullptr) && cbIo == sizeof(header)
+        && header.magic == CalculationManager::HistoryJournal::JOURNAL_MAGIC
+        && header.version == CalculationManager::HistoryJournal::JOURNAL_VERSION);
+    if (fAppended)
+    {
+        auto block = CalculationManager::HistoryJournal::SerializeItem(item);
+        LARGE_INTEGER offset = {};
+        fAppended = (SetFilePointerEx(hFile, offset, nullptr, FILE_END)
+            && WriteFile(hFile, block.data(), static_cast<DWORD>(block.size()), &cbIo, nullptr) && cbIo == block.size());
+        if (fAppended)
         {
-            failure = true;
-            break;
+            // Patch the count last: a block past the counted range is
+            // ignored by the reader, so an interrupted append stays safe.
+            header.itemCount++;
+            fAppended = (SetFilePointerEx(hFile, offset, nullptr, FILE_BEGIN)
+                && WriteFile(hFile, &header, sizeof(header), &cbIo, nullptr) && cbIo == sizeof(header));
         }
+    }
 
-        ++index;
+    CloseHandle(hFile);
+    if (!fAppended)
+    {
+        WriteHistoryJournal(m_currentMode);
+    }
+}
+
+void HistoryViewModel::DeleteHistoryJournal(_In_ CalculationManager::CALCULATOR_MODE cMode)
+{
+    DeleteFileW(GetHistoryJournalPath(cMode).c_str());
+}
+
+// Fixed capacity of the export write buffer; records flush to disk as the
+// buffer fills, so an export of any length uses constant memory.
+static constexpr size_t EXPORT_BUFFER_CAPACITY = 64 * 1024;
+
+// Appends text to the export buffer as UTF-8, dropping the bidi control
+// marks the display strings are wrapped in; they only aid on-screen layout.
+static void AppendExportUtf8(_Inout_ std::vector<unsigned char>& buffer, _In_ const std::wstring& text)
+{
+    std::wstring cleaned;
+    cleaned.reserve(text.size());
+    for (wchar_t ch : text)
+    {
+        if (ch < 0x202A || ch > 0x202E)
+        {
+            cleaned.push_back(ch);
+        }
+    }
+    if (cleaned.empty())
+    {
+        return;
     }
 
-    if (!failure)
+    int cb = WideCharToMultiByte(CP_UTF8, 0, cleaned.data(), static_cast<int>(cleaned.size()), nullptr, 0, nullptr, nullptr);
+    if (cb <= 0)
     {
-        // insertion is successful
-        UpdateHistoryVectorLength(static_cast<int>(currentHistoryVector.size()), m_currentMode);
+        return;
     }
-    else
+    size_t offset = buffer.size();
+    buffer.resize(offset + cb);
+    WideCharToMultiByte(CP_UTF8, 0, cleaned.data(), static_cast<int>(cleaned.size()), reinterpret_cast<char*>(buffer.data() + offset), cb, nullptr, nullptr);
+}
+
+// Quotes a field when it contains the separator, a quote or a line break,
+// doubling embedded quotes, per the usual CSV rules.
+static std::wstring EscapeExportField(_In_ const std::wstring& field, wchar_t separator)
+{
+    wchar_t specials[] = { separator, L'"', L'\r', L'\n', L'\0' };
+    if (field.find_first_of(specials) == std::wstring::npos)
     {
-        UpdateHistoryVectorLength(0, m_currentMode);
+        return field;
     }
+
+    std::wstring escaped;
+    escaped.reserve(field.size() + 2);
+    escaped.push_back(L'"');
+    for (wchar_t ch : field)
+    {
+        escaped.push_back(ch);
+        if (ch == L'"')
+        {
+            escaped.push_back(L'"');
+        }
+    }
+    escaped.push_back(L'"');
+    return escaped;
 }
 
-// this serializes a history item into a base64 encoded string
-Platform::String^ HistoryViewModel::SerializeHistoryItem(_In_ std::shared_ptr<CalculationManager::HISTORYITEM> const &item)
+static bool FlushExportBuffer(_In_ HANDLE hFile, _Inout_ std::vector<unsigned char>& buffer)
 {
-    DataWriter^ writer = ref new DataWriter();
-    auto expr = item->historyItemVector.expression;
-    auto result = item->historyItemVector.result;
-    auto platformExpr = ref new Platform::String(expr.c_str());
-    writer->WriteUInt32(writer->MeasureString(platformExpr));
-    writer->WriteString(platformExpr);
-    auto platformResult = ref new Platform::String(result.c_str());
-    writer->WriteUInt32(writer->MeasureString(platformResult));
-    writer->WriteString(platformResult);
+    if (buffer.empty())
+    {
+        return true;
+    }
+    DWORD cbWritten = 0;
+    BOOL fWrote = WriteFile(hFile, buffer.data(), static_cast<DWORD>(buffer.size()), &cbWritten, nullptr);
+    bool ok = fWrote && cbWritten == buffer.size();
+    buffer.clear();
+    return ok;
+}
+
+// The background half of ExportHistoryAsync: stream the snapshotted items
+// through the fixed-size buffer, writing beside the target and swapping in
+// at the end so a failed export never leaves a torn file.
+static bool WriteHistoryExport(_In_ const std::wstring& path, _In_ const std::vector<std::shared_ptr<CalculationManager::HISTORYITEM>>& items, bool tabSeparated)
+{
+    std::wstring tempPath = path + L".tmp";
+    HANDLE hFile = CreateFile2(tempPath.c_str(), GENERIC_WRITE, 0, CREATE_ALWAYS, nullptr);
+    if (hFile == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    wchar_t separator = tabSeparated ? L'\t' : L',';
+    std::vector<unsigned char> buffer;
+    buffer.reserve(EXPORT_BUFFER_CAPACITY);
+
+    // Byte-order mark so spreadsheet tools pick up the UTF-8 encoding.
+    buffer.push_back(0xEF);
+    buffer.push_back(0xBB);
+    buffer.push_back(0xBF);
+
+    std::wstring line = L"Expression";
+    line += separator;
+    line += L"Result\r\n";
+    AppendExportUtf8(buffer, line);
+
+    bool ok = true;
+    for (auto const& item : items)
+    {
+        line = EscapeExportField(item->historyItemVector.expression, separator);
+        line += separator;
+        line += EscapeExportField(item->historyItemVector.result, separator);
+        line += L"\r\n";
+        AppendExportUtf8(buffer, line);
+
+        if (buffer.size() >= EXPORT_BUFFER_CAPACITY && !(ok = FlushExportBuffer(hFile, buffer)))
+        {
+            break;
+        }
+    }
 
-    Utils::SerializeCommandsAndTokens(item->historyItemVector.spTokens, item->historyItemVector.spCommands, writer);
+    ok = ok && FlushExportBuffer(hFile, buffer);
+    CloseHandle(hFile);
 
-    IBuffer^ buffer = writer->DetachBuffer();
-    if (buffer == nullptr)
+    if (ok)
     {
-        throw ref new Platform::Exception(E_POINTER, ref new Platform::String(L"History Item is NULL"));
+        ok = MoveFileExW(tempPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
     }
+    if (!ok)
+    {
+        DeleteFileW(tempPath.c_str());
+    }
+    return ok;
+}
 
-    return CryptographicBuffer::EncodeToBase64String(buffer);
+concurrency::task<bool> HistoryViewModel::ExportHistoryAsync(Platform::String^ filePath, bool tabSeparated)
+{
+    // Snapshot the shared items on the calling thread; entries are
+    // immutable once added, so the writer touches no live history state.
+    auto items = m_calculatorManager->GetHistoryItems(m_currentMode);
+    std::wstring path{ filePath->Data() };
+    return concurrency::create_task([items = std::move(items), path, tabSeparated]() {
+        return WriteHistoryExport(path, items, tabSeparated);
+    });
+}
+
+// Reads the stream the legacy container serializer produced back into the
+// packed image, leaving hydration for actual recall.
+static void DeserializePackedCommandsAndTokens(_In_ DataReader^ reader, _Inout_ CalculationManager::HISTORYITEMVECTOR &itemVector)
+{
+    auto& packed = itemVector.packedCommands;
+    auto commandVectorSize = reader->ReadUInt32();
+    for (unsigned int i = 0; i < commandVectorSize; ++i)
+    {
+        auto commandTypeInt = reader->ReadInt32();
+        packed.push_back(commandTypeInt);
+        switch (static_cast<CalculationManager::CommandType>(commandTypeInt))
+        {
+        case CalculationManager::CommandType::OperandCommand:
+        {
+            int flags = (reader->ReadBoolean() ? 1 : 0);
+            flags |= (reader->ReadBoolean() ? 2 : 0);
+            flags |= (reader->ReadBoolean() ? 4 : 0);
+            packed.push_back(flags);
+            auto opndCmdSize = reader->ReadUInt32();
+            packed.push_back(static_cast<int>(opndCmdSize));
+            for (unsigned int j = 0; j < opndCmdSize; ++j)
+            {
+                packed.push_back(reader->ReadInt32());
+            }
+            break;
+        }
+        case CalculationManager::CommandType::UnaryCommand:
+        {
+            auto cmdSize = reader->ReadUInt32();
+            packed.push_back(static_cast<int>(cmdSize));
+            for (unsigned int j = 0; j < cmdSize; ++j)
+            {
+                packed.push_back(reader->ReadInt32());
+            }
+            break;
+        }
+        case CalculationManager::CommandType::BinaryCommand:
+        case CalculationManager::CommandType::Parentheses:
+            packed.push_back(reader->ReadInt32());
+            break;
+        default:
+            throw ref new Platform::Exception(E_INVALIDARG, ref new Platform::String(L"Unknown command type"));
+        }
+    }
+
+    auto tokensSize = reader->ReadUInt32();
+    itemVector.packedTokens.reserve(static_cast<size_t>(tokensSize) * 3);
+    for (unsigned int i = 0; i < tokensSize; ++i)
+    {
+        auto stringDataLen = reader->ReadUInt32();
+        auto stringData = reader->ReadString(stringDataLen);
+        auto intData = reader->ReadInt32();
+        itemVector.packedTokens.push_back(static_cast<int>(itemVector.tokenChars.size()));
+        itemVector.packedTokens.push_back(static_cast<int>(stringData->Length()));
+        itemVector.packedTokens.push_back(intData);
+        itemVector.tokenChars += stringData->Data();
+    }
 }
 
 CalculationManager::HISTORYITEM HistoryViewModel::DeserializeHistoryItem(_In_ Platform::String^ historyItemKey, _In_ ApplicationDataContainer^ historyContainer)
@@ -341,8 +871,9 @@ CalculationManager::HISTORYITEM HistoryViewModel::DeserializeHistoryItem(_In_ Pl
         auto result = reader->ReadString(resultLen);
         historyItem.historyItemVector.result = result->Data();
 
-        historyItem.historyItemVector.spCommands = Utils::DeserializeCommands(reader);
-        historyItem.historyItemVector.spTokens = Utils::DeserializeTokens(reader);
+        // Keep the restored item in packed form; it is hydrated only if the
+        // user actually recalls it.
+        DeserializePackedCommandsAndTokens(reader, historyItem.historyItemVector);
     }
     else
     {
@@ -355,13 +886,14 @@ bool HistoryViewModel::IsValid(_In_ CalculationManager::HISTORYITEM item)
 {
     return (!item.historyItemVector.expression.empty() &&
         !item.historyItemVector.result.empty() &&
-        (bool)item.historyItemVector.spCommands &&
-        (bool)item.historyItemVector.spTokens);
+        (((bool)item.historyItemVector.spCommands && (bool)item.historyItemVector.spTokens) ||
+            !item.historyItemVector.packedTokens.empty()));
 }
 
 void HistoryViewModel::UpdateItemSize()
 {
-    ItemSize = Items->Size;
+    // Count the unrealized tail too; this drives the empty-history text.
+    ItemSize = Items->Size + m_historyItems->PendingSize();
 }
 
 void HistoryViewModel::MakeHistoryClearedNarratorAnnouncement(String^ resourceKey, String^& formatVariable)
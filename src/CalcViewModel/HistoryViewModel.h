@@ -18,6 +18,126 @@ namespace CalculatorApp
         public delegate void HideHistoryClickedHandler();
         public delegate void HistoryItemClickedHandler(CalculatorApp::ViewModel::HistoryItemViewModel^ e);
 
+        // Items source for the history list. The realized ViewModels live in
+        // an inner observable vector; entries beyond the eagerly hydrated page
+        // stay as model items and are realized on demand when the ListView
+        // asks for more through ISupportIncrementalLoading.
+        [Windows::UI::Xaml::Data::Bindable]
+        public ref class HistoryItemsVector sealed :
+            public Windows::UI::Xaml::Interop::IBindableObservableVector,
+            public Windows::UI::Xaml::Data::ISupportIncrementalLoading
+        {
+        public:
+            // IBindableIterable
+            virtual Windows::UI::Xaml::Interop::IBindableIterator^ First()
+            {
+                return m_items->First();
+            }
+
+            // IBindableVector
+            property unsigned int Size
+            {
+                virtual unsigned int get()
+                {
+                    return m_items->Size;
+                }
+            }
+
+            virtual Platform::Object^ GetAt(unsigned int index)
+            {
+                return m_items->GetAt(index);
+            }
+
+            virtual Windows::UI::Xaml::Interop::IBindableVectorView^ GetView()
+            {
+                return m_items->GetView();
+            }
+
+            virtual bool IndexOf(Platform::Object^ item, unsigned int* index)
+            {
+                return m_items->IndexOf(item, index);
+            }
+
+            virtual void Append(Platform::Object^ item)
+            {
+                m_items->Append(item);
+            }
+
+            virtual void Clear()
+            {
+                m_items->Clear();
+            }
+
+            virtual void InsertAt(unsigned int index, Platform::Object^ item)
+            {
+                m_items->InsertAt(index, item);
+            }
+
+            virtual void RemoveAt(unsigned int index)
+            {
+                m_items->RemoveAt(index);
+            }
+
+            virtual void RemoveAtEnd()
+            {
+                m_items->RemoveAtEnd();
+            }
+
+            virtual void SetAt(unsigned int index, Platform::Object^ item)
+            {
+                m_items->SetAt(index, item);
+            }
+
+            // IBindableObservableVector
+            virtual event Windows::UI::Xaml::Interop::BindableVectorChangedEventHandler^ VectorChanged
+            {
+                Windows::Foundation::EventRegistrationToken add(Windows::UI::Xaml::Interop::BindableVectorChangedEventHandler^ handler)
+                {
+                    return m_vectorChanged += handler;
+                }
+                void remove(Windows::Foundation::EventRegistrationToken token)
+                {
+                    m_vectorChanged -= token;
+                }
+                void raise(Windows::UI::Xaml::Interop::IBindableObservableVector^ vector, Platform::Object^ e)
+                {
+                    m_vectorChanged(vector, e);
+                }
+            }
+
+            // ISupportIncrementalLoading
+            property bool HasMoreItems
+            {
+                virtual bool get()
+                {
+                    return !m_pendingModelItems.empty();
+                }
+            }
+
+            virtual Windows::Foundation::IAsyncOperation<Windows::UI::Xaml::Data::LoadMoreItemsResult>^ LoadMoreItemsAsync(unsigned int count);
+
+        internal:
+            HistoryItemsVector();
+
+            void SetRealizeItemCallback(_In_ std::function<CalculatorApp::ViewModel::HistoryItemViewModel^(std::shared_ptr<CalculationManager::HISTORYITEM> const&)> const& callback);
+            void SetPendingModelItems(_In_ std::vector<std::shared_ptr<CalculationManager::HISTORYITEM>>&& pendingItems);
+            std::vector<std::shared_ptr<CalculationManager::HISTORYITEM>> TakePendingModelItems();
+            std::shared_ptr<CalculationManager::HISTORYITEM> PopOldestPending();
+            unsigned int PendingSize();
+
+        private:
+            unsigned int RealizeMoreItems(unsigned int count);
+            void OnInnerVectorChanged(Windows::UI::Xaml::Interop::IBindableObservableVector^ vector, Platform::Object^ e);
+
+            Windows::UI::Xaml::Interop::IBindableObservableVector^ m_items;
+
+            // Model entries older than the realized range, newest first, so
+            // the next page to realize is always at the front.
+            std::vector<std::shared_ptr<CalculationManager::HISTORYITEM>> m_pendingModelItems;
+            std::function<CalculatorApp::ViewModel::HistoryItemViewModel^(std::shared_ptr<CalculationManager::HISTORYITEM> const&)> m_realizeItem;
+            event Windows::UI::Xaml::Interop::BindableVectorChangedEventHandler^ m_vectorChanged;
+        };
+
         [Windows::UI::Xaml::Data::Bindable]
         public ref class HistoryViewModel sealed : public Windows::UI::Xaml::Data::INotifyPropertyChanged
         {
@@ -47,20 +167,59 @@ namespace CalculatorApp
             HistoryViewModel(_In_ CalculationManager::CalculatorManager* calculatorManager);
             void SetCalculatorDisplay(CalculatorDisplay &calculatorDisplay);
             void ReloadHistory(_In_ CalculatorApp::Common::ViewMode currentMode);
+            // Hydrates the item ViewModels on first pane open. Until then,
+            // only ItemSize (the button badge) is maintained, so mode
+            // switches and resume do no history-proportional work.
+            void EnsureHistoryLoaded();
+            Windows::Foundation::Collections::IVector<CalculatorApp::ViewModel::HistoryItemViewModel^>^ FindItems(_In_ Platform::String^ query);
 
             void DeleteItem(_In_ CalculatorApp::ViewModel::HistoryItemViewModel^ e);
 
-            // store history in app data functions
-            Platform::String^ SerializeHistoryItem(_In_ std::shared_ptr<CalculationManager::HISTORYITEM> const &item);
             void SaveHistory();
 
+            // Streams the current mode's history to a CSV or TSV file for
+            // audit export. Items are snapshotted on the calling thread and
+            // written on a background worker through a fixed-size buffer,
+            // so a thousand-item export never assembles one monolithic
+            // string or stalls the UI. Reads only the expression and result
+            // strings, so packed entries stay unhydrated.
+            concurrency::task<bool> ExportHistoryAsync(Platform::String^ filePath, bool tabSeparated);
+
         private:
             CalculationManager::CalculatorManager* const m_calculatorManager;
             CalculatorDisplay m_calculatorDisplay;
             CalculationManager::CALCULATOR_MODE m_currentMode;
             Platform::String^ m_localizedHistoryCleared;
 
+            // Items, typed so the paging internals are reachable without casts.
+            CalculatorApp::ViewModel::HistoryItemsVector^ m_historyItems;
+
+            // Item ViewModels pooled by the model entry they present, so that
+            // reloading history reuses them instead of constructing one per
+            // entry. Entries are removed as their model items leave history.
+            std::map<std::shared_ptr<CalculationManager::HISTORYITEM>, CalculatorApp::ViewModel::HistoryItemViewModel^> m_itemViewModelPool;
+
             void RestoreHistory(_In_ CalculationManager::CALCULATOR_MODE cMode);
+            void LoadHistoryItems();
+
+            // False until the history pane has been opened once; while
+            // false, history stays as model items in the manager and this
+            // ViewModel tracks only the count.
+            bool m_historyHydrated = false;
+
+            // Memory-mapped history journal: the primary store. The
+            // ApplicationDataContainer helpers below survive only to migrate
+            // history saved by earlier builds.
+            std::wstring GetHistoryJournalPath(_In_ CalculationManager::CALCULATOR_MODE cMode);
+            bool RestoreHistoryFromJournal(_In_ CalculationManager::CALCULATOR_MODE cMode);
+            void WriteHistoryJournal(_In_ CalculationManager::CALCULATOR_MODE cMode);
+            void AppendHistoryJournal(_In_ std::shared_ptr<CalculationManager::HISTORYITEM> const &item);
+            void DeleteHistoryJournal(_In_ CalculationManager::CALCULATOR_MODE cMode);
+
+            CalculatorApp::ViewModel::HistoryItemViewModel^ GetOrCreateHistoryItemViewModel(_In_ std::shared_ptr<CalculationManager::HISTORYITEM> const &item);
+            void SynchronizeItems(_In_ const std::vector<CalculatorApp::ViewModel::HistoryItemViewModel^>& updatedItems);
+            void RemoveItemFromPool(_In_ CalculatorApp::ViewModel::HistoryItemViewModel^ item);
+
             CalculationManager::HISTORYITEM DeserializeHistoryItem(_In_ Platform::String^ historyItemKey, _In_ Windows::Storage::ApplicationDataContainer^ historyContainer);
             Windows::Storage::ApplicationDataContainer^ GetHistoryContainer(_In_ CalculationManager::CALCULATOR_MODE cMode);
             Platform::String^ GetHistoryContainerKey(_In_ CalculationManager::CALCULATOR_MODE cMode);
@@ -2,11 +2,13 @@
 // Licensed under the MIT License.
 
 #include "pch.h"
+#include <chrono>
 #include "StandardCalculatorViewModel.h"
 #include "Common/CalculatorButtonPressedEventArgs.h"
 #include "Common/LocalizationStringUtil.h"
 #include "Common/LocalizationSettings.h"
 #include "Common/CopyPasteManager.h"
+#include "Common/LaunchTimeline.h"
 #include "Common/TraceLogger.h"
 
 using namespace CalculatorApp;
@@ -93,6 +95,10 @@ StandardCalculatorViewModel::StandardCalculatorViewModel() :
     m_localizedOpenParenthesisCountChangedAutomationFormat(nullptr),
     m_localizedNoRightParenthesisAddedFormat(nullptr)
 {
+    // The member init list above just constructed the manager (and with it
+    // the engines this window starts from).
+    LaunchTimeline::Record(L"CalculatorManagerConstructed");
+
     WeakReference calculatorViewModel(this);
     m_calculatorDisplay.SetCallback(calculatorViewModel);
     m_expressionAutomationNameFormat = AppResourceProvider::GetInstance().GetResourceString(CalculatorResourceKeys::CalculatorExpression);
@@ -131,6 +137,10 @@ StandardCalculatorViewModel::StandardCalculatorViewModel() :
 
     m_tokenPosition = -1;
     m_isLastOperationHistoryLoad = false;
+
+    // Memorized numbers persist across sessions in their own journal; one
+    // read here brings the slots back before any input arrives.
+    RestoreMemoryJournal();
 }
 
 String^ StandardCalculatorViewModel::LocalizeDisplayValue(_In_ wstring const &displayValue, _In_ bool isError)
@@ -193,15 +203,56 @@ String^ StandardCalculatorViewModel::GetNarratorStringReadRawNumbers(_In_ String
     return ref new String(wss.str().c_str());
 }
 
+String^ StandardCalculatorViewModel::CalculationResultAutomationName::get()
+{
+    if (!m_isCalcAutomationNameCurrent)
+    {
+        m_isCalcAutomationNameCurrent = true;
+        m_CalculationResultAutomationName = CalculateNarratorDisplayValue(m_rawPrimaryDisplayValue, DisplayValue, m_primaryDisplayIsError);
+    }
+
+    return m_CalculationResultAutomationName;
+}
+
+void StandardCalculatorViewModel::CalculationResultAutomationName::set(String^ value)
+{
+    m_isCalcAutomationNameCurrent = true;
+    if (m_CalculationResultAutomationName != value)
+    {
+        m_CalculationResultAutomationName = value;
+        RaisePropertyChanged(CalculationResultAutomationNamePropertyName);
+    }
+}
+
 void StandardCalculatorViewModel::SetPrimaryDisplay(_In_ wstring const &displayStringValue, _In_ bool isError)
 {
-    String^ localizedDisplayStringValue = LocalizeDisplayValue(displayStringValue, isError);
+    LaunchTimeline::Record(L"FirstPrimaryDisplay");
 
-    // Set this variable before the DisplayValue is modified, Otherwise the DisplayValue will
-    // not match what the narrator is saying
-    m_CalculationResultAutomationName = CalculateNarratorDisplayValue(displayStringValue, localizedDisplayStringValue, isError);
+    // Localize into the reusable buffer; the digit translation happens in
+    // place, and a Platform::String is only materialized when the localized
+    // text actually changed.
+    m_localizedDisplayBuffer.assign(displayStringValue);
+    LocalizationSettings::GetInstance().LocalizeDisplayValue(&m_localizedDisplayBuffer);
 
-    DisplayValue = localizedDisplayStringValue;
+    // WINBLUE: 440747 - In BiDi languages, error messages need to be wrapped in LRE/PDF
+    if (isError && m_isRtlLanguage)
+    {
+        m_localizedDisplayBuffer.insert(m_localizedDisplayBuffer.begin(), Utils::LRE);
+        m_localizedDisplayBuffer.push_back(Utils::PDF);
+    }
+
+    // Record the narrator inputs before the DisplayValue is modified,
+    // otherwise the DisplayValue will not match what the narrator is saying.
+    // The string itself is built when the automation peer reads it.
+    m_rawPrimaryDisplayValue = displayStringValue;
+    m_primaryDisplayIsError = isError;
+    m_isCalcAutomationNameCurrent = false;
+
+    if (m_DisplayValue == nullptr
+        || m_localizedDisplayBuffer.compare(0, wstring::npos, m_DisplayValue->Data(), m_DisplayValue->Length()) != 0)
+    {
+        DisplayValue = ref new String(m_localizedDisplayBuffer.c_str(), static_cast<unsigned int>(m_localizedDisplayBuffer.length()));
+    }
 
     IsInError = isError;
 
@@ -325,55 +376,74 @@ void StandardCalculatorViewModel::SetTokens(_Inout_ shared_ptr<CalculatorVector<
     {
         m_ExpressionTokens = ref new Vector<DisplayExpressionToken^>();
     }
-    else
-    {
-        m_ExpressionTokens->Clear();
-    }
 
-    unsigned int nTokens = 0;
-    tokens->GetSize(&nTokens);
-    pair <wstring, int> currentToken;
+    const pair<wstring, int>* tokenData = tokens->data();
+    unsigned int nTokens = static_cast<unsigned int>(tokens->size());
     const auto& localizer = LocalizationSettings::GetInstance();
 
+    // Edits mostly touch the tail of the expression, so update the
+    // observable collection in place: entries whose text and shape are
+    // unchanged are left alone, and changed positions mutate the existing
+    // token object, so its realized container re-renders without the
+    // expression bar re-realizing any items.
+    unsigned int existingSize = m_ExpressionTokens->Size;
+
     for (unsigned int i = 0; i < nTokens; ++i)
     {
-        if (SUCCEEDED(tokens->GetAt(i, &currentToken)))
-        {
-            Common::TokenType type;
-            const wstring separator = L" ";
-            bool isEditable = (currentToken.second == -1) ? false : true;
-            localizer.LocalizeDisplayValue(&(currentToken.first));
+        Common::TokenType type;
+        const wstring separator = L" ";
+        bool isEditable = (tokenData[i].second == -1) ? false : true;
+        wstring tokenString = tokenData[i].first;
+        localizer.LocalizeDisplayValue(&tokenString);
 
-            if (!isEditable)
+        if (!isEditable)
+        {
+            if (tokenString == separator)
             {
-                if (currentToken.first == separator)
-                {
-                    type = TokenType::Separator;
-                }
-                else
-                {
-                    type = TokenType::Operator;
-                }
+                type = TokenType::Separator;
             }
-
             else
             {
-                shared_ptr<IExpressionCommand> command;
-                IFTPlatformException(m_commands->GetAt(static_cast<unsigned int>(currentToken.second), &command));
+                type = TokenType::Operator;
+            }
+        }
 
-                if (command->GetCommandType() == CommandType::OperandCommand)
-                {
-                    type = TokenType::Operand;
-                }
-                else
-                {
-                    type = TokenType::Operator;
-                }
+        else
+        {
+            shared_ptr<IExpressionCommand> command;
+            IFTPlatformException(m_commands->GetAt(static_cast<unsigned int>(tokenData[i].second), &command));
+
+            if (command->GetCommandType() == CommandType::OperandCommand)
+            {
+                type = TokenType::Operand;
             }
-            DisplayExpressionToken^ expressionToken = ref new DisplayExpressionToken(ref new String(currentToken.first.c_str()), i, isEditable, type);
-            m_ExpressionTokens->Append(expressionToken);
+            else
+            {
+                type = TokenType::Operator;
+            }
+        }
+        String^ tokenText = ref new String(tokenString.c_str());
+        if (i < existingSize)
+        {
+            // The observable setters only raise a change when the value
+            // actually differs, so unchanged properties stay quiet.
+            DisplayExpressionToken^ existingToken = m_ExpressionTokens->GetAt(i);
+            existingToken->Token = tokenText;
+            existingToken->IsTokenEditable = isEditable;
+            existingToken->Type = type;
+            existingToken->TokenPosition = i;
+        }
+        else
+        {
+            m_ExpressionTokens->Append(ref new DisplayExpressionToken(tokenText, i, isEditable, type));
         }
     }
+
+    // Drop any stale entries past the end of the new expression.
+    while (m_ExpressionTokens->Size > nTokens)
+    {
+        m_ExpressionTokens->RemoveAtEnd();
+    }
 }
 
 String^ StandardCalculatorViewModel::GetCalculatorExpressionAutomationName()
@@ -387,11 +457,34 @@ String^ StandardCalculatorViewModel::GetCalculatorExpressionAutomationName()
     return GetLocalizedStringFormat(m_expressionAutomationNameFormat, expression);
 }
 
+// Returns a slot ViewModel for a newly stored value, drawing from the pool
+// of retired slots before constructing a fresh one.
+MemoryItemViewModel^ StandardCalculatorViewModel::GetOrCreateMemorySlot()
+{
+    if (!m_memorySlotPool.empty())
+    {
+        auto slot = m_memorySlotPool.back();
+        m_memorySlotPool.pop_back();
+        return slot;
+    }
+
+    return ref new MemoryItemViewModel(this);
+}
+
+void StandardCalculatorViewModel::RetireMemorySlot(_In_ MemoryItemViewModel^ slot)
+{
+    m_memorySlotPool.push_back(slot);
+}
+
 void StandardCalculatorViewModel::SetMemorizedNumbers(const vector<wstring>& newMemorizedNumbers)
 {
     const auto& localizer = LocalizationSettings::GetInstance();
     if (newMemorizedNumbers.size() == 0) // Memory has been cleared
     {
+        for (unsigned int i = 0; i < MemorizedNumbers->Size; i++)
+        {
+            RetireMemorySlot(MemorizedNumbers->GetAt(i));
+        }
         MemorizedNumbers->Clear();
         IsMemoryEmpty = true;
     }
@@ -403,7 +496,7 @@ void StandardCalculatorViewModel::SetMemorizedNumbers(const vector<wstring>& new
             size_t newValuePosition = newMemorizedNumbers.size() - MemorizedNumbers->Size - 1;
             auto stringValue = newMemorizedNumbers.at(newValuePosition);
 
-            MemoryItemViewModel^ memorySlot = ref new MemoryItemViewModel(this);
+            MemoryItemViewModel^ memorySlot = GetOrCreateMemorySlot();
             memorySlot->Position = 0;
             localizer.LocalizeDisplayValue(&stringValue);
             memorySlot->Value = Utils::LRO + ref new String(stringValue.c_str()) + Utils::PDF;
@@ -435,6 +528,23 @@ void StandardCalculatorViewModel::SetMemorizedNumbers(const vector<wstring>& new
     }
 }
 
+void StandardCalculatorViewModel::SetMemorizedNumber(unsigned int indexOfMemory, const wstring& memorizedNumber)
+{
+    if (indexOfMemory >= MemorizedNumbers->Size)
+    {
+        return;
+    }
+
+    const auto& localizer = LocalizationSettings::GetInstance();
+    auto newStringValue = memorizedNumber;
+    localizer.LocalizeDisplayValue(&newStringValue);
+
+    if (MemorizedNumbers->GetAt(indexOfMemory)->Value != StringReference(newStringValue.c_str()))
+    {
+        MemorizedNumbers->GetAt(indexOfMemory)->Value = Utils::LRO + ref new String(newStringValue.c_str()) + Utils::PDF;
+    }
+}
+
 void StandardCalculatorViewModel::FtoEButtonToggled()
 {
     OnButtonPressed(NumbersAndOperatorsEnum::FToE);
@@ -667,11 +777,102 @@ void StandardCalculatorViewModel::OnButtonPressed(Object^ parameter)
                 m_isLastOperationHistoryLoad = false;
             }
 
+            // Span the engine's synchronous work for this keystroke so a WPA
+            // trace attributes the latency to the command that caused it.
+            // The hidden diagnostics view takes the same measurement locally.
+            auto engineSpan = TraceLogger::GetInstance().BeginEngineCommandActivity(static_cast<int>(cmdenum));
+            const bool fLocalDiagnostics = TraceLogger::LocalDiagnosticsActive();
+            std::chrono::steady_clock::time_point commandStart;
+            if (fLocalDiagnostics)
+            {
+                commandStart = std::chrono::steady_clock::now();
+            }
             m_standardCalculatorManager.SendCommand(cmdenum);
+            engineSpan.reset();
+            if (fLocalDiagnostics)
+            {
+                auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - commandStart);
+                TraceLogger::GetInstance().RecordCommandLatency(static_cast<int>(cmdenum), static_cast<uint64_t>(elapsed.count()));
+            }
+
+            if (cmdenum == Command::CommandEQU)
+            {
+                LogEngineDiagnosticsSnapshot();
+            }
         }
     }
 }
 
+bool StandardCalculatorViewModel::TrySendRepeatBurst(NumbersAndOperatorsEnum operation, unsigned int count)
+{
+    Command cmdenum = ConvertToOperatorsEnum(operation);
+    bool isDigit = cmdenum >= Command::Command0 && cmdenum <= Command::CommandF;
+
+    // Only plain digit and backspace keystrokes have a batched engine run,
+    // and only in the ordinary typing state: error recovery and expression
+    // editing take per-keystroke paths through OnButtonPressed.
+    if ((!isDigit && cmdenum != Command::CommandBACK) || IsInError || IsEditingEnabled)
+    {
+        return false;
+    }
+
+    TraceLogger::GetInstance().UpdateFunctionUsage((int)operation);
+    IsOperatorCommand = false;
+
+    auto engineSpan = TraceLogger::GetInstance().BeginEngineCommandActivity(static_cast<int>(cmdenum));
+    const bool fLocalDiagnostics = TraceLogger::LocalDiagnosticsActive();
+    std::chrono::steady_clock::time_point commandStart;
+    if (fLocalDiagnostics)
+    {
+        commandStart = std::chrono::steady_clock::now();
+    }
+    m_standardCalculatorManager.SendCommandRun(cmdenum, count);
+    engineSpan.reset();
+    if (fLocalDiagnostics)
+    {
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - commandStart);
+        TraceLogger::GetInstance().RecordCommandLatency(static_cast<int>(cmdenum), static_cast<uint64_t>(elapsed.count()));
+    }
+
+    return true;
+}
+
+void StandardCalculatorViewModel::LogEngineDiagnosticsSnapshot()
+{
+    // Emit the ratpak counters accumulated since the previous equals as one
+    // EngineDiagnostics event. The counters stay disabled (a single predicted
+    // branch in the engine) unless a trace session is listening; the first
+    // equals after a session attaches only arms them, so every emitted
+    // snapshot covers exactly one calculation.
+    if (!TraceLogger::GetInstance().GetTraceLoggingProviderEnabled())
+    {
+        // Keep the counters armed while the local diagnostics view wants them.
+        if (CalculatorManager::DiagnosticsEnabled() && !TraceLogger::LocalDiagnosticsActive())
+        {
+            CalculatorManager::SetDiagnosticsEnabled(false);
+        }
+        return;
+    }
+
+    if (!CalculatorManager::DiagnosticsEnabled())
+    {
+        CalculatorManager::SetDiagnosticsEnabled(true);
+        CalculatorManager::ResetDiagnostics();
+        return;
+    }
+
+    auto stats = CalculatorManager::GetDiagnostics();
+    TraceLogger::GetInstance().LogEngineDiagnostics(
+        Utils::GetWindowId(),
+        stats.cCreateNum,
+        stats.cPoolHits,
+        stats.cHeapAllocs,
+        stats.cMulNumX,
+        stats.cLimbOps,
+        stats.cbHighWater);
+    CalculatorManager::ResetDiagnostics();
+}
+
 int StandardCalculatorViewModel::GetBitLengthType()
 {
     if (IsQwordEnabled)
@@ -746,11 +947,29 @@ void StandardCalculatorViewModel::OnPasteCommand(Object^ parameter)
         return;
     }
 
-    // Ensure that the paste happens on the UI thread
+    // Clipboard read, validation and command mapping all stay off the
+    // UI thread; only the error display and the single bulk hand-off to
+    // the engine come back here, so a large paste never stalls input.
     CopyPasteManager::GetStringToPaste(mode, NavCategory::GetGroupType(mode), NumberBase, bitLengthType).then(
-        [this, mode](String^ pastedString)
+        [this](String^ pastedString)
     {
-        OnPaste(pastedString, mode);
+        if (pastedString == StringReference(CopyPasteManager::PasteErrorString))
+        {
+            return make_pair(false, vector<Command>());
+        }
+
+        return make_pair(true, BuildPasteCommands(pastedString));
+    }, concurrency::task_continuation_context::use_arbitrary()).then(
+        [this, mode](pair<bool, vector<Command>> pasteResult)
+    {
+        if (!pasteResult.first)
+        {
+            this->DisplayPasteError();
+            return;
+        }
+
+        TraceLogger::GetInstance().LogValidInputPasted(mode);
+        m_standardCalculatorManager.SendCommands(pasteResult.second);
     }, concurrency::task_continuation_context::use_current());
 }
 
@@ -769,8 +988,20 @@ void StandardCalculatorViewModel::OnPaste(String^ pastedString, ViewMode mode)
     }
 
     TraceLogger::GetInstance().LogValidInputPasted(mode);
+    m_standardCalculatorManager.SendCommands(BuildPasteCommands(pastedString));
+}
+
+// Maps validated pasted text to the engine command stream.  Reads only
+// immutable or settings state, so the paste pipeline can run it on a
+// background thread before the one bulk SendCommands hand-off.
+vector<Command> StandardCalculatorViewModel::BuildPasteCommands(String^ pastedString)
+{
     bool isFirstLegalChar = true;
-    m_standardCalculatorManager.SendCommand(Command::CommandCENTR);
+
+    // Collect the whole expression and send it as one batch, so the manager
+    // coalesces the display updates instead of replaying every keystroke.
+    vector<Command> commands;
+    commands.push_back(Command::CommandCENTR);
     bool sendNegate = false;
     bool processedDigit = false;
     bool sentEquals = false;
@@ -859,7 +1090,7 @@ void StandardCalculatorViewModel::OnPaste(String^ pastedString, ViewMode mode)
             {
                 sentEquals = (mappedNumOp == NumbersAndOperatorsEnum::Equals);
                 Command cmdenum = ConvertToOperatorsEnum(mappedNumOp);
-                m_standardCalculatorManager.SendCommand(cmdenum);
+                commands.push_back(cmdenum);
 
                 // The CalcEngine state machine won't allow the negate command to be sent before any
                 // other digits, so instead a flag is set and the command is sent after the first appropriate
@@ -869,7 +1100,7 @@ void StandardCalculatorViewModel::OnPaste(String^ pastedString, ViewMode mode)
                     if (canSendNegate)
                     {
                         Command cmdNegate = ConvertToOperatorsEnum(NumbersAndOperatorsEnum::Negate);
-                        m_standardCalculatorManager.SendCommand(cmdNegate);
+                        commands.push_back(cmdNegate);
                     }
 
                     // Can't send negate on a leading zero, so wait until the appropriate time to send it.
@@ -888,18 +1119,22 @@ void StandardCalculatorViewModel::OnPaste(String^ pastedString, ViewMode mode)
             if (!(MapCharacterToButtonId(*it, canSendNegate) == NumbersAndOperatorsEnum::Add))
             {
                 Command cmdNegate = ConvertToOperatorsEnum(NumbersAndOperatorsEnum::Negate);
-                m_standardCalculatorManager.SendCommand(cmdNegate);
+                commands.push_back(cmdNegate);
             }
         }
 
         ++it;
     }
+
+    return commands;
 }
 
 void StandardCalculatorViewModel::OnClearMemoryCommand(
     Object^ parameter)
 {
+    InvalidateReplayCheckpoints();
     m_standardCalculatorManager.MemorizedNumberClearAll();
+    SaveMemoryJournal();
 
     int windowId = Utils::GetWindowId();
     TraceLogger::GetInstance().LogMemoryClearAll(windowId);
@@ -1036,7 +1271,9 @@ NumbersAndOperatorsEnum StandardCalculatorViewModel::MapCharacterToButtonId(
 
 void StandardCalculatorViewModel::OnMemoryButtonPressed()
 {
+    InvalidateReplayCheckpoints();
     m_standardCalculatorManager.MemorizeNumber();
+    SaveMemoryJournal();
 
     int windowId = Utils::GetWindowId();
     TraceLogger::GetInstance().InsertIntoMemoryMap(windowId, IsStandard, IsScientific, IsProgrammer);
@@ -1098,7 +1335,9 @@ void StandardCalculatorViewModel::OnMemoryAdd(Object^ memoryItemPosition)
         {
             TraceLogger::GetInstance().InsertIntoMemoryMap(windowId, IsStandard, IsScientific, IsProgrammer);
         }
+        InvalidateReplayCheckpoints();
         m_standardCalculatorManager.MemorizedNumberAdd(boxedPosition->Value);
+        SaveMemoryJournal();
     }
 }
 
@@ -1119,7 +1358,9 @@ void StandardCalculatorViewModel::OnMemorySubtract(Object^ memoryItemPosition)
         {
             TraceLogger::GetInstance().InsertIntoMemoryMap(windowId, IsStandard, IsScientific, IsProgrammer);
         }
+        InvalidateReplayCheckpoints();
         m_standardCalculatorManager.MemorizedNumberSubtract(boxedPosition->Value);
+        SaveMemoryJournal();
     }
 }
 
@@ -1133,8 +1374,11 @@ void StandardCalculatorViewModel::OnMemoryClear(_In_ Object^ memoryItemPosition)
         if (boxedPosition->Value >= 0)
         {
             unsigned int unsignedPosition = safe_cast<unsigned int>(boxedPosition->Value);
+            InvalidateReplayCheckpoints();
             m_standardCalculatorManager.MemorizedNumberClear(unsignedPosition);
+            SaveMemoryJournal();
 
+            RetireMemorySlot(MemorizedNumbers->GetAt(unsignedPosition));
             MemorizedNumbers->RemoveAt(unsignedPosition);
             for (unsigned int i = 0; i < MemorizedNumbers->Size; i++)
             {
@@ -1162,6 +1406,107 @@ void StandardCalculatorViewModel::OnMemoryClear(_In_ Object^ memoryItemPosition)
     }
 }
 
+namespace
+{
+    // On-disk layout of the memory journal: one header, then the varint
+    // packed image of the serialized memory Rationals.
+    struct MEMORYJOURNALHEADER
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t cbPayload;
+        uint32_t reserved;
+    };
+
+    constexpr uint32_t MEMORY_JOURNAL_MAGIC = 0x4A4D4C43; // "CLMJ"
+    constexpr uint32_t MEMORY_JOURNAL_VERSION = 1;
+
+    // Far beyond what a full set of memory slots can serialize to; anything
+    // larger is a corrupt header, not memory.
+    constexpr uint32_t MEMORY_JOURNAL_MAX_PAYLOAD = 1u << 20;
+}
+
+wstring StandardCalculatorViewModel::GetMemoryJournalPath()
+{
+    wstring path{ Windows::Storage::ApplicationData::Current->LocalFolder->Path->Data() };
+    path += L"\\Memory.bin";
+    return path;
+}
+
+// One read at startup; a file that does not validate end to end restores
+// nothing.
+bool StandardCalculatorViewModel::RestoreMemoryJournal()
+{
+    HANDLE hFile = CreateFile2(GetMemoryJournalPath().c_str(), GENERIC_READ, FILE_SHARE_READ, OPEN_EXISTING, nullptr);
+    if (hFile == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    bool restored = false;
+    DWORD cbRead = 0;
+    MEMORYJOURNALHEADER header;
+    if (ReadFile(hFile, &header, sizeof(header), &cbRead, nullptr) && cbRead == sizeof(header)
+        && header.magic == MEMORY_JOURNAL_MAGIC
+        && header.version == MEMORY_JOURNAL_VERSION
+        && header.cbPayload <= MEMORY_JOURNAL_MAX_PAYLOAD)
+    {
+        vector<unsigned char> packed(header.cbPayload);
+        if (header.cbPayload == 0
+            || (ReadFile(hFile, packed.data(), header.cbPayload, &cbRead, nullptr) && cbRead == header.cbPayload))
+        {
+            vector<long> serializedMemory;
+            if (CalculatorManager::TryUnpackLongs(packed, serializedMemory))
+            {
+                restored = m_standardCalculatorManager.TryDeSerializeMemory(serializedMemory);
+            }
+        }
+    }
+
+    CloseHandle(hFile);
+    return restored;
+}
+
+// Rewrites the whole journal in one write - the slot image is tiny - and
+// swaps it in beside the old file, mirroring the history journal's
+// write-and-rename so a crash mid-write cannot leave a torn file.
+void StandardCalculatorViewModel::SaveMemoryJournal()
+{
+    m_standardCalculatorManager.SerializeMemory();
+    vector<unsigned char> packed = CalculatorManager::PackLongs(m_standardCalculatorManager.GetSerializedMemory());
+
+    MEMORYJOURNALHEADER header = {};
+    header.magic = MEMORY_JOURNAL_MAGIC;
+    header.version = MEMORY_JOURNAL_VERSION;
+    header.cbPayload = static_cast<uint32_t>(packed.size());
+
+    vector<unsigned char> journal;
+    journal.reserve(sizeof(header) + packed.size());
+    auto pbHeader = reinterpret_cast<unsigned char const*>(&header);
+    journal.insert(journal.end(), pbHeader, pbHeader + sizeof(header));
+    journal.insert(journal.end(), packed.begin(), packed.end());
+
+    wstring path = GetMemoryJournalPath();
+    wstring tempPath = path + L".tmp";
+    HANDLE hFile = CreateFile2(tempPath.c_str(), GENERIC_WRITE, 0, CREATE_ALWAYS, nullptr);
+    if (hFile == INVALID_HANDLE_VALUE)
+    {
+        return;
+    }
+
+    DWORD cbWritten = 0;
+    BOOL fWrote = WriteFile(hFile, journal.data(), static_cast<DWORD>(journal.size()), &cbWritten, nullptr);
+    CloseHandle(hFile);
+    if (fWrote && cbWritten == journal.size())
+    {
+        MoveFileExW(tempPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING);
+    }
+    else
+    {
+        DeleteFileW(tempPath.c_str());
+    }
+}
+
 Array<unsigned char>^ StandardCalculatorViewModel::Serialize()
 {
     DataWriter^ writer = ref new DataWriter();
@@ -1170,23 +1515,17 @@ Array<unsigned char>^ StandardCalculatorViewModel::Serialize()
     writer->WriteBoolean(IsCurrentViewPinned);
     writer->WriteUInt32(static_cast<UINT32>(m_standardCalculatorManager.SerializeSavedDegreeMode()));
 
-    // Serialize Memory
-    vector<long> serializedMemory;
-    serializedMemory = m_standardCalculatorManager.GetSerializedMemory();
-    size_t lengthOfSerializedMemory = serializedMemory.size();
-    writer->WriteUInt32(static_cast<UINT32>(lengthOfSerializedMemory));
-    for (auto data : serializedMemory)
-    {
-        writer->WriteInt32(data);
-    }
+    // Serialize Memory. The long vectors are varint packed before they are
+    // written: mantissa limbs are mostly small, so whole 4-byte ints
+    // quadruple the suspend payload for nothing.
+    vector<unsigned char> packedMemory = CalculatorManager::PackLongs(m_standardCalculatorManager.GetSerializedMemory());
+    writer->WriteUInt32(static_cast<UINT32>(packedMemory.size()));
+    writer->WriteBytes(ref new Array<unsigned char>(packedMemory.data(), static_cast<unsigned int>(packedMemory.size())));
 
     // Serialize Primary Display
-    vector<long> serializedPrimaryDisplay = m_standardCalculatorManager.GetSerializedPrimaryDisplay();
-    writer->WriteUInt32(static_cast<UINT32>(serializedPrimaryDisplay.size()));
-    for (auto data : serializedPrimaryDisplay)
-    {
-        writer->WriteInt32(data);
-    }
+    vector<unsigned char> packedPrimaryDisplay = CalculatorManager::PackLongs(m_standardCalculatorManager.GetSerializedPrimaryDisplay());
+    writer->WriteUInt32(static_cast<UINT32>(packedPrimaryDisplay.size()));
+    writer->WriteBytes(ref new Array<unsigned char>(packedPrimaryDisplay.data(), static_cast<unsigned int>(packedPrimaryDisplay.size())));
 
     // For ProgrammerMode
     writer->WriteUInt32(static_cast<UINT32>(CurrentRadixType));
@@ -1196,6 +1535,14 @@ Array<unsigned char>^ StandardCalculatorViewModel::Serialize()
     writer->WriteUInt32(static_cast<UINT32>(serializedCommand.size()));
     writer->WriteBytes(ref new Array<unsigned char>(serializedCommand.data(), static_cast<unsigned int>(serializedCommand.size())));
 
+    // State snapshot: lets Deserialize rebuild the engine in one step
+    // instead of replaying the command journal above. Empty when the
+    // engine cannot be snapshotted (mid number entry or in error); the
+    // journal then remains the restore path.
+    vector<unsigned char> packedSnapshot = CalculatorManager::PackLongs(m_standardCalculatorManager.SerializeStateSnapshot());
+    writer->WriteUInt32(static_cast<UINT32>(packedSnapshot.size()));
+    writer->WriteBytes(ref new Array<unsigned char>(packedSnapshot.data(), static_cast<unsigned int>(packedSnapshot.size())));
+
     if (IsInError)
     {
         Utils::SerializeCommandsAndTokens(m_tokens, m_commands, writer);
@@ -1221,6 +1568,10 @@ void StandardCalculatorViewModel::Deserialize(Array<unsigned char>^ state)
     // Read view model data
     if (buffer->Length != 0)
     {
+        // The restored state replaces the memory slots and engine state the
+        // replay checkpoints were recorded against.
+        InvalidateReplayCheckpoints();
+
         DataReader^ reader = DataReader::FromBuffer(buffer);
         m_CurrentAngleType = ConvertIntegerToNumbersAndOperatorsEnum(reader->ReadUInt32());
 
@@ -1230,30 +1581,45 @@ void StandardCalculatorViewModel::Deserialize(Array<unsigned char>^ state)
 
         m_standardCalculatorManager.SendCommand(serializedDegreeMode);
 
-        // Deserialize Memory
-        UINT32 memoryDataLength = reader->ReadUInt32();
+        // Deserialize Memory. A stream that does not unpack restores
+        // nothing rather than garbage.
+        UINT32 packedMemoryLength = reader->ReadUInt32();
+        Array<unsigned char>^ packedMemory = ref new Array<unsigned char>(packedMemoryLength);
+        reader->ReadBytes(packedMemory);
         vector<long> serializedMemory;
-        for (unsigned int i = 0; i < memoryDataLength; i++)
-        {
-            serializedMemory.push_back(reader->ReadInt32());
-        }
+        CalculatorManager::TryUnpackLongs(vector<unsigned char>(packedMemory->begin(), packedMemory->end()), serializedMemory);
         m_standardCalculatorManager.DeSerializeMemory(serializedMemory);
 
-        // Serialize Primary Display
-        UINT32 serializedPrimaryDisplayLength = reader->ReadUInt32();
+        // Deserialize Primary Display
+        UINT32 packedPrimaryDisplayLength = reader->ReadUInt32();
+        Array<unsigned char>^ packedPrimaryDisplay = ref new Array<unsigned char>(packedPrimaryDisplayLength);
+        reader->ReadBytes(packedPrimaryDisplay);
         vector<long> serializedPrimaryDisplay;
-        for (unsigned int i = 0; i < serializedPrimaryDisplayLength; i++)
-        {
-            serializedPrimaryDisplay.push_back(reader->ReadInt32());
-        }
+        CalculatorManager::TryUnpackLongs(vector<unsigned char>(packedPrimaryDisplay->begin(), packedPrimaryDisplay->end()), serializedPrimaryDisplay);
         m_standardCalculatorManager.DeSerializePrimaryDisplay(serializedPrimaryDisplay);
 
         CurrentRadixType = reader->ReadUInt32();
-        // Read command data and Deserialize
+        // Read command data
         UINT32 modeldatalength = reader->ReadUInt32();
         Array<unsigned char>^ modelDataAsBytes = ref new Array<unsigned char>(modeldatalength);
         reader->ReadBytes(modelDataAsBytes);
-        m_standardCalculatorManager.DeSerializeCommands(vector<unsigned char>(modelDataAsBytes->begin(), modelDataAsBytes->end()));
+
+        // Prefer the state snapshot when one was saved; the command replay
+        // below is the fallback for states the snapshot does not cover and
+        // for data written before the snapshot existed.
+        vector<long> stateSnapshot;
+        if (reader->UnconsumedBufferLength >= sizeof(UINT32))
+        {
+            UINT32 packedSnapshotLength = reader->ReadUInt32();
+            Array<unsigned char>^ packedStateSnapshot = ref new Array<unsigned char>(packedSnapshotLength);
+            reader->ReadBytes(packedStateSnapshot);
+            CalculatorManager::TryUnpackLongs(vector<unsigned char>(packedStateSnapshot->begin(), packedStateSnapshot->end()), stateSnapshot);
+        }
+
+        if (stateSnapshot.empty() || !m_standardCalculatorManager.DeSerializeStateSnapshot(stateSnapshot))
+        {
+            m_standardCalculatorManager.DeSerializeCommands(vector<unsigned char>(modelDataAsBytes->begin(), modelDataAsBytes->end()));
+        }
 
         // After recalculation. If there is an error then
         // IsInError should be set synchronously.
@@ -1320,7 +1686,15 @@ void StandardCalculatorViewModel::SetCalculatorType(ViewMode targetState)
 
     case ViewMode::Programmer:
         IsProgrammer = true;
-        ResetDisplay();
+        // The programmer engine keeps its radix across mode switches;
+        // align the radix buttons with it rather than forcing the display
+        // back to DEC and losing the retained base.
+        {
+            RADIX_TYPE radixType = m_standardCalculatorManager.GetCurrentRadixType();
+            AreHEXButtonsEnabled = (radixType == RADIX_TYPE::HEX_RADIX);
+            CurrentRadixType = (int)radixType;
+            ProgModeRadixChange();
+        }
         SetPrecision(ProgrammerModePrecision);
         break;
     }
@@ -1578,24 +1952,97 @@ void StandardCalculatorViewModel::Recalculate(bool fromHistory)
         savedTokens->Append(currentToken);
     }
 
-    m_standardCalculatorManager.Reset(false);
-    if (IsScientific)
+    // Incremental replay: when the replay settings match the last
+    // recalculation and the new stream shares a prefix with the old one,
+    // restore the deepest checkpoint on that common prefix and replay only
+    // the commands after it. Editing a single operand then re-evaluates just
+    // the tail of the expression instead of replaying it from the start.
+    size_t settingsStamp = (static_cast<size_t>(currentDegreeMode) << 2)
+        | (IsScientific ? 1u : 0u)
+        | (IsFToEChecked ? 2u : 0u);
+
+    size_t replayStart = 0;
+    bool restoredCheckpoint = false;
+    if (settingsStamp == m_lastReplaySettingsStamp && !m_replayCheckpoints.empty())
     {
-        m_standardCalculatorManager.SendCommand(Command::ModeScientific);
+        size_t commonPrefix = 0;
+        size_t prefixLimit = min(currentCommands.size(), m_lastReplayCommands.size());
+        while (commonPrefix < prefixLimit && currentCommands[commonPrefix] == m_lastReplayCommands[commonPrefix])
+        {
+            commonPrefix++;
+        }
+
+        for (auto itr = m_replayCheckpoints.rbegin(); itr != m_replayCheckpoints.rend(); ++itr)
+        {
+            if (itr->first <= commonPrefix && m_standardCalculatorManager.DeSerializeStateSnapshot(itr->second))
+            {
+                replayStart = itr->first;
+                restoredCheckpoint = true;
+                break;
+            }
+        }
     }
 
-    if (IsFToEChecked)
+    if (restoredCheckpoint)
     {
-        m_standardCalculatorManager.SendCommand(Command::CommandFE);
+        // Checkpoints past the restore point describe the old stream; the
+        // tail replay below records fresh ones in their place. They are
+        // recorded in stream order, so this trims a suffix.
+        while (!m_replayCheckpoints.empty() && m_replayCheckpoints.back().first > replayStart)
+        {
+            m_replayCheckpoints.pop_back();
+        }
+    }
+    else
+    {
+        m_replayCheckpoints.clear();
+        m_standardCalculatorManager.Reset(false);
+        if (IsScientific)
+        {
+            m_standardCalculatorManager.SendCommand(Command::ModeScientific);
+        }
+
+        if (IsFToEChecked)
+        {
+            m_standardCalculatorManager.SendCommand(Command::CommandFE);
+        }
+
+        m_standardCalculatorManager.SendCommand(currentDegreeMode);
     }
 
-    m_standardCalculatorManager.SendCommand(currentDegreeMode);
+    // Checkpoints are taken where the engine has just folded a binary
+    // operator, spacing them out on long streams so short replays stay
+    // cheap and a long expression still gets coverage along its length.
+    static constexpr size_t maxReplayCheckpoints = 8;
     size_t currentCommandsSize = currentCommands.size();
-    for (size_t i = 0; i < currentCommandsSize; i++)
+    size_t binaryOpCount = 0;
+    for (size_t i = replayStart; i < currentCommandsSize; i++)
+    {
+        if (IsBinOp(currentCommands[i]))
+        {
+            binaryOpCount++;
+        }
+    }
+    size_t checkpointStride = max(static_cast<size_t>(1), binaryOpCount / maxReplayCheckpoints);
+
+    size_t binaryOpsSeen = 0;
+    for (size_t i = replayStart; i < currentCommandsSize; i++)
     {
         m_standardCalculatorManager.SendCommand(static_cast<CalculationManager::Command>(currentCommands[i]));
+
+        if (IsBinOp(currentCommands[i]) && (++binaryOpsSeen % checkpointStride) == 0)
+        {
+            vector<long> checkpoint = m_standardCalculatorManager.SerializeStateSnapshot();
+            if (!checkpoint.empty() && checkpoint[4] == 0)
+            {
+                m_replayCheckpoints.emplace_back(i + 1, move(checkpoint));
+            }
+        }
     }
 
+    m_lastReplayCommands = move(currentCommands);
+    m_lastReplaySettingsStamp = settingsStamp;
+
     if (fromHistory)   // This is for the cases where the expression is loaded from history
     {
         // To maintain F-E state of the engine, as the last operand hasn't reached engine by now
@@ -1611,6 +2058,16 @@ void StandardCalculatorViewModel::Recalculate(bool fromHistory)
     }
 }
 
+void StandardCalculatorViewModel::InvalidateReplayCheckpoints()
+{
+    // A checkpoint embeds the memory slots, so restoring one recorded before
+    // a memory change would resurrect the old slots. Dropped wholesale; the
+    // next Recalculate records a fresh set.
+    m_replayCheckpoints.clear();
+    m_lastReplayCommands.clear();
+    m_lastReplaySettingsStamp = 0;
+}
+
 CommandType StandardCalculatorViewModel::GetSelectedTokenType(_In_ unsigned int tokenPosition)
 {
     pair<wstring, int>token;
@@ -1807,7 +2264,8 @@ void StandardCalculatorViewModel::UpdateProgrammerPanelDisplay()
     {
         // we want the precision to be set to maximum value so that the autoconversions result as desired
         int32_t precision = 64;
-        if (m_standardCalculatorManager.GetResultForRadix(16, precision) == L"")
+        auto radixDisplays = m_standardCalculatorManager.GetAllRadixDisplays(precision);
+        if (radixDisplays.hexString == L"")
         {
             hexDisplayString = DisplayValue->Data();
             decimalDisplayString = DisplayValue->Data();
@@ -1816,10 +2274,10 @@ void StandardCalculatorViewModel::UpdateProgrammerPanelDisplay()
         }
         else
         {
-            hexDisplayString = m_standardCalculatorManager.GetResultForRadix(16, precision);
-            decimalDisplayString = m_standardCalculatorManager.GetResultForRadix(10, precision);
-            octalDisplayString = m_standardCalculatorManager.GetResultForRadix(8, precision);
-            binaryDisplayString = m_standardCalculatorManager.GetResultForRadix(2, precision);
+            hexDisplayString = radixDisplays.hexString;
+            decimalDisplayString = radixDisplays.decString;
+            octalDisplayString = radixDisplays.octString;
+            binaryDisplayString = radixDisplays.binString;
         }
     }
     const auto& localizer = LocalizationSettings::GetInstance();
@@ -2000,7 +2458,7 @@ void StandardCalculatorViewModel::OnMaxDigitsReached()
     String^ announcement = LocalizationStringUtil::GetLocalizedNarratorAnnouncement(
         CalculatorResourceKeys::MaxDigitsReachedFormat,
         m_localizedMaxDigitsReachedAutomationFormat,
-        m_CalculationResultAutomationName->Data());
+        CalculationResultAutomationName->Data());
 
     Announcement = CalculatorAnnouncement::GetMaxDigitsReachedAnnouncement(announcement);
 }
@@ -2015,14 +2473,14 @@ NarratorAnnouncement^ StandardCalculatorViewModel::GetDisplayUpdatedNarratorAnno
     String^ announcement;
     if (m_feedbackForButtonPress == nullptr || m_feedbackForButtonPress->IsEmpty())
     {
-        announcement = m_CalculationResultAutomationName;
+        announcement = CalculationResultAutomationName;
     }
     else
     {
         announcement = LocalizationStringUtil::GetLocalizedNarratorAnnouncement(
             CalculatorResourceKeys::ButtonPressFeedbackFormat,
             m_localizedButtonPressFeedbackAutomationFormat,
-            m_CalculationResultAutomationName->Data(),
+            CalculationResultAutomationName->Data(),
             m_feedbackForButtonPress->Data());
     }
 
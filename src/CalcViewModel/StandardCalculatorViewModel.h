@@ -68,7 +68,14 @@ namespace CalculatorApp
             OBSERVABLE_PROPERTY_RW(bool, IsFToEEnabled);
             OBSERVABLE_PROPERTY_RW(bool, IsHyperbolicChecked);
             OBSERVABLE_PROPERTY_RW(bool, AreHEXButtonsEnabled);
-            OBSERVABLE_PROPERTY_RW(Platform::String^, CalculationResultAutomationName);
+            // Built lazily: SetPrimaryDisplay only records its inputs, and the
+            // narrator string is produced when the automation peer reads it.
+            property Platform::String^ CalculationResultAutomationName
+            {
+                Platform::String^ get();
+                void set(Platform::String^ value);
+            }
+
             OBSERVABLE_PROPERTY_RW(Platform::String^, CalculationExpressionAutomationName);
             OBSERVABLE_PROPERTY_RW(bool, IsShiftProgrammerChecked);
             OBSERVABLE_PROPERTY_RW(bool, IsQwordEnabled);
@@ -101,7 +108,7 @@ namespace CalculatorApp
                     if (m_isShiftChecked != value)
                     {
                         m_isShiftChecked = value;
-                        RaisePropertyChanged(L"IsShiftChecked");
+                        RaisePropertyChanged(Platform::StringReference(L"IsShiftChecked"));
                     }
                 }
             }
@@ -115,7 +122,7 @@ namespace CalculatorApp
                         m_isBitFlipChecked = value;
                         IsBinaryBitFlippingEnabled = IsProgrammer && m_isBitFlipChecked;
                         AreProgrammerRadixOperatorsEnabled = IsProgrammer && !m_isBitFlipChecked;
-                        RaisePropertyChanged(L"IsBitFlipChecked");
+                        RaisePropertyChanged(Platform::StringReference(L"IsBitFlipChecked"));
                     }
                 }
             }
@@ -127,7 +134,7 @@ namespace CalculatorApp
                     if (m_isBinaryBitFlippingEnabled != value)
                     {
                         m_isBinaryBitFlippingEnabled = value;
-                        RaisePropertyChanged(L"IsBinaryBitFlippingEnabled");
+                        RaisePropertyChanged(Platform::StringReference(L"IsBinaryBitFlippingEnabled"));
                     }
                 }
             }
@@ -144,7 +151,7 @@ namespace CalculatorApp
                             IsScientific = false;
                             IsProgrammer = false;
                         }
-                        RaisePropertyChanged(L"IsStandard");
+                        RaisePropertyChanged(Platform::StringReference(L"IsStandard"));
                     }
                 }
             }
@@ -161,7 +168,7 @@ namespace CalculatorApp
                             IsStandard = false;
                             IsProgrammer = false;
                         }
-                        RaisePropertyChanged(L"IsScientific");
+                        RaisePropertyChanged(Platform::StringReference(L"IsScientific"));
                     }
                 }
             }
@@ -184,7 +191,7 @@ namespace CalculatorApp
                             IsStandard = false;
                             IsScientific = false;
                         }
-                        RaisePropertyChanged(L"IsProgrammer");
+                        RaisePropertyChanged(Platform::StringReference(L"IsProgrammer"));
                     }
                 }
             }
@@ -202,7 +209,7 @@ namespace CalculatorApp
                         IsOperandEnabled = currentEditToggleValue;
                         IsNegateEnabled = currentEditToggleValue;
                         IsDecimalEnabled = currentEditToggleValue;
-                        RaisePropertyChanged(L"IsEditingEnabled");
+                        RaisePropertyChanged(Platform::StringReference(L"IsEditingEnabled"));
                     }
                 }
             }
@@ -220,7 +227,7 @@ namespace CalculatorApp
                         IsDecimalEnabled = value;
                         AreHEXButtonsEnabled = IsProgrammer;
                         IsFToEEnabled = value;
-                        RaisePropertyChanged(L"IsOperandEnabled");
+                        RaisePropertyChanged(Platform::StringReference(L"IsOperandEnabled"));
                     }
                 }
             }
@@ -265,11 +272,18 @@ namespace CalculatorApp
 
         internal:
             void OnPaste(Platform::String^ pastedString, CalculatorApp::Common::ViewMode mode);
+            std::vector<CalculationManager::Command> BuildPasteCommands(Platform::String^ pastedString);
             void OnCopyCommand(Platform::Object^ parameter);
             void OnPasteCommand(Platform::Object^ parameter);
 
             NumbersAndOperatorsEnum MapCharacterToButtonId(const wchar_t ch, bool& canSendNegate);
 
+            // Sends a held-key repeat burst as one batched engine run with a
+            // single display update. Returns false when the operation or the
+            // current state has no batched form, in which case the caller
+            // replays the repeats through the per-keystroke path.
+            bool TrySendRepeatBurst(NumbersAndOperatorsEnum operation, unsigned int count);
+
             // Memory feature related methods. They are internal because they need to called from the MainPage code-behind
             void OnMemoryButtonPressed();
             void OnMemoryItemPressed(Platform::Object^ memoryItemPosition);
@@ -310,11 +324,42 @@ namespace CalculatorApp
             void SetPrecision(int32_t precision);
             void UpdateMaxIntDigits() { m_standardCalculatorManager.UpdateMaxIntDigits(); }
             NumbersAndOperatorsEnum GetCurrentAngleType() { return m_CurrentAngleType; }
+            // Releases the manager's performance caches and pools on a
+            // platform memory-pressure notification; no user-visible state
+            // is affected.
+            void TrimMemory() { m_standardCalculatorManager.TrimMemory(); }
 
         private:
             void SetMemorizedNumbers(const std::vector<std::wstring>& memorizedNumbers);
+            void SetMemorizedNumber(unsigned int indexOfMemory, const std::wstring& memorizedNumber);
+            MemoryItemViewModel^ GetOrCreateMemorySlot();
+            void RetireMemorySlot(_In_ MemoryItemViewModel^ slot);
+
+            // Slot ViewModels retired by memory clears, reused for the next
+            // values stored so the list rebinds rows instead of rebuilding
+            // them. Bounded by the most slots held at once.
+            std::vector<MemoryItemViewModel^> m_memorySlotPool;
+
+            // Memory journal: the memorized numbers persisted as a small
+            // versioned binary file of varint packed Rationals, rewritten
+            // whole after each change and read once at construction.
+            std::wstring GetMemoryJournalPath();
+            bool RestoreMemoryJournal();
+            void SaveMemoryJournal();
             void UpdateProgrammerPanelDisplay();
             void HandleUpdatedOperandData(CalculationManager::Command cmdenum);
+            void InvalidateReplayCheckpoints();
+            void LogEngineDiagnosticsSnapshot();
+
+            // Incremental recalculation: engine state checkpoints recorded at
+            // binary operator boundaries during the last replay, keyed by
+            // offset into the flattened command stream. Recalculate restores
+            // the deepest checkpoint still on the common prefix of the new
+            // stream and replays only the commands after it, so editing one
+            // operand re-evaluates just the tail of the expression.
+            std::vector<int> m_lastReplayCommands;
+            std::vector<std::pair<size_t, std::vector<long>>> m_replayCheckpoints;
+            size_t m_lastReplaySettingsStamp = 0;
             NumbersAndOperatorsEnum ConvertIntegerToNumbersAndOperatorsEnum(unsigned int parameter);
             NumbersAndOperatorsEnum m_CurrentAngleType;
             wchar_t m_decimalSeparator;
@@ -329,6 +374,14 @@ namespace CalculatorApp
             Platform::String^ m_localizedOctalAutomationFormat;
             Platform::String^ m_localizedBinaryAutomationFormat;
             Platform::String^ m_localizedMaxDigitsReachedAutomationFormat;
+            Platform::String^ m_CalculationResultAutomationName;
+            bool m_isCalcAutomationNameCurrent = true;
+
+            // Inputs SetPrimaryDisplay records for the lazy automation name,
+            // and the reusable buffer it localizes the display text into.
+            std::wstring m_rawPrimaryDisplayValue;
+            bool m_primaryDisplayIsError = false;
+            std::wstring m_localizedDisplayBuffer;
             Platform::String^ m_localizedButtonPressFeedbackAutomationFormat;
             Platform::String^ m_localizedMemorySavedAutomationFormat;
             Platform::String^ m_localizedMemoryItemChangedAutomationFormat;
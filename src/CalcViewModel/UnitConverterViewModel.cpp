@@ -177,6 +177,15 @@ void UnitConverterViewModel::OnCategoryChanged(Object^ parameter)
     IsCurrencyLoadingVisible = m_IsCurrencyCurrentCategory && !m_isCurrencyDataLoaded;
     IsDropDownEnabled = m_Units->GetAt(0) != EMPTY_UNIT;
 
+    // Week-old rates refresh only once the user can actually see them:
+    // entering the currency category with stale data on an unrestricted
+    // network triggers the same refresh the button would.
+    if (m_IsCurrencyCurrentCategory && m_isCurrencyDataLoaded && CurrencyDataIsWeekOld
+        && NetworkBehavior == NetworkAccessBehavior::Normal && !CurrencyDataLoadFailed)
+    {
+        RefreshCurrencyRatios();
+    }
+
     UnitChanged->Execute(nullptr);
 }
 
@@ -191,19 +200,80 @@ void UnitConverterViewModel::SetSelectedUnits()
 
 void UnitConverterViewModel::BuildUnitList(const vector<UCM::Unit>& modelUnitList)
 {
-    m_Units->Clear();
+    vector<Unit^> desiredUnits;
+    desiredUnits.reserve(modelUnitList.size());
     for (const UCM::Unit& modelUnit : modelUnitList)
     {
         if (!modelUnit.isWhimsical)
         {
-            m_Units->Append(ref new Unit(modelUnit));
+            desiredUnits.push_back(GetOrCreateUnit(modelUnit));
         }
     }
 
-    if (m_Units->Size == 0)
+    if (desiredUnits.empty())
+    {
+        desiredUnits.push_back(EMPTY_UNIT);
+    }
+
+    // Diff the displayed vector against the desired list instead of
+    // clearing and refilling it: slots that already hold the right
+    // wrapper are untouched, so the ComboBox only re-templates rows
+    // that actually changed.
+    unsigned int commonSize = min(m_Units->Size, static_cast<unsigned int>(desiredUnits.size()));
+    for (unsigned int i = 0; i < commonSize; i++)
+    {
+        if (m_Units->GetAt(i) != desiredUnits[i])
+        {
+            m_Units->SetAt(i, desiredUnits[i]);
+        }
+    }
+
+    while (m_Units->Size > desiredUnits.size())
+    {
+        m_Units->RemoveAtEnd();
+    }
+
+    for (unsigned int i = commonSize; i < desiredUnits.size(); i++)
+    {
+        m_Units->Append(desiredUnits[i]);
+    }
+}
+
+Unit^ UnitConverterViewModel::GetOrCreateUnit(const UCM::Unit& modelUnit)
+{
+    // Model equality is id-only, so compare the displayed fields
+    // explicitly: a pooled wrapper is reused only while it still renders
+    // identically (currency names and symbols can change on a refresh).
+    auto itr = m_unitPool.find(modelUnit.id);
+    if (itr != m_unitPool.end())
+    {
+        const UCM::Unit& pooledUnit = itr->second->GetModelUnit();
+        if (pooledUnit.name == modelUnit.name && pooledUnit.accessibleName == modelUnit.accessibleName
+            && pooledUnit.abbreviation == modelUnit.abbreviation
+            && pooledUnit.isConversionSource == modelUnit.isConversionSource
+            && pooledUnit.isConversionTarget == modelUnit.isConversionTarget)
+        {
+            return itr->second;
+        }
+    }
+
+    Unit^ unit = ref new Unit(modelUnit);
+    m_unitPool[modelUnit.id] = unit;
+
+    return unit;
+}
+
+Windows::Foundation::Collections::IVector<Unit^>^ UnitConverterViewModel::FindUnits(String^ query)
+{
+    auto results = ref new Vector<Unit^>();
+    for (const UCM::Unit& modelUnit : m_model->SearchUnits(query->Data()))
     {
-        m_Units->Append(EMPTY_UNIT);
+        if (!modelUnit.isWhimsical)
+        {
+            results->Append(GetOrCreateUnit(modelUnit));
+        }
     }
+    return results;
 }
 
 Unit^ UnitConverterViewModel::FindUnitInList(UCM::Unit target)
@@ -287,96 +357,97 @@ String^ UnitConverterViewModel::ConvertToLocalizedString(const std::wstring& str
         return result;
     }
 
-    m_decimalFormatter->IsDecimalPointAlwaysDisplayed = false;
-    m_decimalFormatter->FractionDigits = 0;
-    m_currencyFormatter->IsDecimalPointAlwaysDisplayed = false;
-    m_currencyFormatter->FractionDigits = 0;
-
-    wstring::size_type posOfE = stringToLocalize.find(L'e');
-    if (posOfE != wstring::npos)
+    if (!IsCurrencyCurrentCategory)
     {
-        wstring::size_type posOfSign = posOfE + 1;
-        wchar_t signOfE = stringToLocalize.at(posOfSign);
-        std::wstring significandStr(stringToLocalize.substr(0, posOfE));
-        std::wstring exponentStr(stringToLocalize.substr(posOfSign + 1, stringToLocalize.length() - posOfSign));
+        // The raw value is en-US - digits, at most one sign, one decimal point
+        // and an exponent marker - so localizing it is a single pass through
+        // the flat digit translation table plus the decimal separator. This
+        // replaces a round-trip through stod and the decimal formatter and
+        // runs on every keystroke, twice per update plus once per supplementary
+        // result. It also preserves in-progress input like "3." and trailing
+        // zeroes verbatim, which the formatter path needed FractionDigits
+        // workarounds for, and for locales whose mapping is identity the pass
+        // is skipped entirely.
+        const auto& localizationSettings = LocalizationSettings::GetInstance();
+        if (localizationSettings.IsRawNumberLocalizationIdentity())
+        {
+            result = ref new String(stringToLocalize.c_str());
+        }
+        else
+        {
+            m_localizedStringBuffer = stringToLocalize;
+            localizationSettings.LocalizeRawNumber(&m_localizedStringBuffer);
+            result = ref new String(m_localizedStringBuffer.c_str());
+        }
 
-        result += ConvertToLocalizedString(significandStr, allowPartialStrings) + "e" + signOfE + ConvertToLocalizedString(exponentStr, allowPartialStrings);
+        return Utils::LRE + result + Utils::PDF;
     }
-    else
-    {
-        // stringToLocalize is in en-US and has the default decimal separator, so this is safe to do.
-        wstring::size_type posOfDecimal = stringToLocalize.find(L'.');
-
-        bool hasDecimal = wstring::npos != posOfDecimal;
 
-        if (hasDecimal)
-        {
-            if (allowPartialStrings)
-            {
-                // allow "in progress" strings, like "3." that occur during the composition of
-                // a final number. Without this, when typing the three characters in "3.2"
-                // you don't see the decimal point when typing it, you only see it once you've finally
-                // typed a post-decimal digit.
+    m_currencyFormatter->IsDecimalPointAlwaysDisplayed = false;
+    m_currencyFormatter->FractionDigits = 0;
 
-                m_decimalFormatter->IsDecimalPointAlwaysDisplayed = true;
-                m_currencyFormatter->IsDecimalPointAlwaysDisplayed = true;
-            }
+    // stringToLocalize is in en-US and has the default decimal separator, so this is safe to do.
+    // Currency values never carry an exponent, so no exponent split is needed here.
+    wstring::size_type posOfDecimal = stringToLocalize.find(L'.');
 
-            // force post-decimal digits so that trailing zeroes entered by the user aren't suddenly cut off.
-            m_decimalFormatter->FractionDigits = static_cast<int>(stringToLocalize.length() - (posOfDecimal + 1));
-            m_currencyFormatter->FractionDigits = m_currencyMaxFractionDigits;
-        }
+    bool hasDecimal = wstring::npos != posOfDecimal;
 
-        if (IsCurrencyCurrentCategory)
+    if (hasDecimal)
+    {
+        if (allowPartialStrings)
         {
-            wstring currencyResult = m_currencyFormatter->Format(stod(stringToLocalize))->Data();
-            wstring currencyCode = m_currencyFormatter->Currency->Data();
+            // allow "in progress" strings, like "3." that occur during the composition of
+            // a final number. Without this, when typing the three characters in "3.2"
+            // you don't see the decimal point when typing it, you only see it once you've finally
+            // typed a post-decimal digit.
 
-            // CurrencyFormatter always includes LangCode or Symbol. Make it include LangCode
-            // because this includes a non-breaking space. Remove the LangCode.
-            auto pos = currencyResult.find(currencyCode);
-            if (pos != wstring::npos)
-            {
-                currencyResult.erase(pos, currencyCode.length());
-                std::wsmatch sm;
-                if (regex_search(currencyResult, sm, regexTrimSpacesStart))
-                {
-                    currencyResult.erase(sm.prefix().length(), sm.length());
-                }
+            m_currencyFormatter->IsDecimalPointAlwaysDisplayed = true;
+        }
 
-                if (regex_search(currencyResult, sm, regexTrimSpacesEnd))
-                {
-                    currencyResult.erase(sm.prefix().length(), sm.length());
-                }
-            }
+        // force post-decimal digits so that trailing zeroes entered by the user aren't suddenly cut off.
+        m_currencyFormatter->FractionDigits = m_currencyMaxFractionDigits;
+    }
 
-            result = ref new String(currencyResult.c_str());
-        }
-        else
+    wstring currencyResult = m_currencyFormatter->Format(stod(stringToLocalize))->Data();
+    wstring currencyCode = m_currencyFormatter->Currency->Data();
+
+    // CurrencyFormatter always includes LangCode or Symbol. Make it include LangCode
+    // because this includes a non-breaking space. Remove the LangCode.
+    auto posOfCode = currencyResult.find(currencyCode);
+    if (posOfCode != wstring::npos)
+    {
+        currencyResult.erase(posOfCode, currencyCode.length());
+        std::wsmatch sm;
+        if (regex_search(currencyResult, sm, regexTrimSpacesStart))
         {
-            // Convert the input string to double using stod
-            // Then use the decimalFormatter to reformat the double to Platform String
-            result = m_decimalFormatter->Format(stod(stringToLocalize));
+            currencyResult.erase(sm.prefix().length(), sm.length());
         }
 
-        if (hasDecimal)
+        if (regex_search(currencyResult, sm, regexTrimSpacesEnd))
         {
-            // Since the output from GetLocaleInfoEx() and DecimalFormatter are differing for decimal string
-            // we are adding the below work-around of editing the string returned by DecimalFormatter
-            // and replacing the decimal separator with the one returned by GetLocaleInfoEx()
-            String^ formattedSampleString = m_decimalFormatter->Format(stod("1.1"));
-            wstring formattedSampleWString = wstring(formattedSampleString->Data());
-
-            wstring resultWithDecimal = wstring(result->Data());
-            size_t pos = resultWithDecimal.find(formattedSampleWString[1], 0);
-            if (pos != wstring::npos)
-            {
-                resultWithDecimal.replace(pos, 1, &m_decimalSeparator);
-            }
+            currencyResult.erase(sm.prefix().length(), sm.length());
+        }
+    }
+
+    result = ref new String(currencyResult.c_str());
 
-            // Copy back the edited string to the result
-            result = ref new String(resultWithDecimal.c_str());
+    if (hasDecimal)
+    {
+        // Since the output from GetLocaleInfoEx() and the formatters are differing for decimal string
+        // we are adding the below work-around of editing the formatted string
+        // and replacing the decimal separator with the one returned by GetLocaleInfoEx()
+        String^ formattedSampleString = m_decimalFormatter->Format(stod("1.1"));
+        wstring formattedSampleWString = wstring(formattedSampleString->Data());
+
+        wstring resultWithDecimal = wstring(result->Data());
+        size_t pos = resultWithDecimal.find(formattedSampleWString[1], 0);
+        if (pos != wstring::npos)
+        {
+            resultWithDecimal.replace(pos, 1, &m_decimalSeparator);
         }
+
+        // Copy back the edited string to the result
+        result = ref new String(resultWithDecimal.c_str());
     }
 
     wstring resultHolder = wstring(result->Data());
@@ -506,6 +577,9 @@ void UnitConverterViewModel::OnButtonPressed(Platform::Object^ parameter)
         }
     }
 
+    // Span the converter's synchronous work (ratio lookup, conversion and
+    // suggestion sweep) for this keystroke.
+    auto converterSpan = TraceLogger::GetInstance().BeginConverterCommandActivity(static_cast<int>(command));
     m_model->SendCommand(command);
 }
 
@@ -537,14 +611,45 @@ void UnitConverterViewModel::OnPasteCommand(Platform::Object^ parameter)
 void UnitConverterViewModel::InitializeView()
 {
     vector<UCM::Category> categories = m_model->GetCategories();
-    for (UINT i = 0; i < categories.size(); i++)
+
+    // Patch the category list in place for the same reason BuildUnitList
+    // diffs the unit list: existing wrappers are kept by id, and a second
+    // initialization (deserialization) updates rather than appends.
+    unsigned int commonSize = min(m_Categories->Size, static_cast<unsigned int>(categories.size()));
+    for (unsigned int i = 0; i < commonSize; i++)
+    {
+        if (m_Categories->GetAt(i)->GetModelCategory().id != categories[i].id)
+        {
+            m_Categories->SetAt(i, ref new Category(categories[i]));
+        }
+    }
+
+    while (m_Categories->Size > categories.size())
     {
-        Category^ category = ref new Category(categories[i]);
-        m_Categories->Append(category);
+        m_Categories->RemoveAtEnd();
+    }
+
+    for (unsigned int i = commonSize; i < categories.size(); i++)
+    {
+        m_Categories->Append(ref new Category(categories[i]));
     }
 
     RestoreUserPreferences();
-    CurrentCategory = ref new Category(m_model->GetCurrentCategory());
+
+    // Select the wrapper already in the Categories list so the ComboBox
+    // restores selection by reference instead of through a duplicate.
+    UCM::Category currentCategory = m_model->GetCurrentCategory();
+    Category^ selectedCategory = nullptr;
+    for (Category^ category : m_Categories)
+    {
+        if (category->GetModelCategory().id == currentCategory.id)
+        {
+            selectedCategory = category;
+            break;
+        }
+    }
+
+    CurrentCategory = (selectedCategory != nullptr) ? selectedCategory : ref new Category(currentCategory);
 }
 
 void UnitConverterViewModel::OnPropertyChanged(Platform::String^ prop)
@@ -675,8 +780,15 @@ void UnitConverterViewModel::SaveUserPreferences()
         ApplicationDataContainer^ localSettings = ApplicationData::Current->LocalSettings;
         if (!m_IsCurrencyCurrentCategory)
         {
-            auto userPreferences = m_model->SaveUserPreferences();
-            localSettings->Values->Insert(ref new String(L"UnitConverterPreferences"), ref new String(userPreferences.c_str()));
+            // OnUnitChanged also fires for reselections that leave the unit pair
+            // intact, so skip the settings write when nothing changed since the
+            // last save.
+            wstring userPreferences = m_model->SaveUserPreferences();
+            if (userPreferences != m_lastSavedUserPreferences)
+            {
+                localSettings->Values->Insert(ref new String(L"UnitConverterPreferences"), ref new String(userPreferences.c_str()));
+                m_lastSavedUserPreferences = userPreferences;
+            }
         }
         else
         {
@@ -816,29 +928,53 @@ void UnitConverterViewModel::SupplementaryResultsTimerCancel(ThreadPoolTimer^ ti
 void UnitConverterViewModel::RefreshSupplementaryResults()
 {
     m_cacheMutex.lock();
-    m_SupplementaryResults->Clear();
 
-    vector<SupplementaryResult^> whimsicals;
+    vector<tuple<String^, Unit^>> desired;
+    desired.reserve(m_cachedSuggestedValues.size());
+    tuple<String^, Unit^> whimsical;
+    bool hasWhimsical = false;
 
     for (tuple<wstring, UCM::Unit> suggestedValue : m_cachedSuggestedValues)
     {
-        SupplementaryResult^ result =
-            ref new SupplementaryResult(
-            this->ConvertToLocalizedString(get<0>(suggestedValue), false),
-            ref new Unit(get<1>(suggestedValue)));
-        if (result->IsWhimsical())
+        String^ value = this->ConvertToLocalizedString(get<0>(suggestedValue), false);
+        Unit^ unit = GetOrCreateUnit(get<1>(suggestedValue));
+        if (unit->GetModelUnit().isWhimsical)
         {
-            whimsicals.push_back(result);
+            if (!hasWhimsical)
+            {
+                whimsical = make_tuple(value, unit);
+                hasWhimsical = true;
+            }
         }
         else
         {
-            m_SupplementaryResults->Append(result);
+            desired.emplace_back(value, unit);
         }
     }
 
-    if (whimsicals.size() > 0)
+    if (hasWhimsical)
+    {
+        desired.push_back(whimsical);
+    }
+
+    // Update existing entries in place and only add or remove at the
+    // end: with pooled Unit wrappers a keystroke's refresh becomes a
+    // handful of text property changes on recycled rows instead of a
+    // rebuild of the whole strip.
+    unsigned int commonSize = min(m_SupplementaryResults->Size, static_cast<unsigned int>(desired.size()));
+    for (unsigned int i = 0; i < commonSize; i++)
+    {
+        m_SupplementaryResults->GetAt(i)->Update(get<0>(desired[i]), get<1>(desired[i]));
+    }
+
+    while (m_SupplementaryResults->Size > desired.size())
+    {
+        m_SupplementaryResults->RemoveAtEnd();
+    }
+
+    for (unsigned int i = commonSize; i < desired.size(); i++)
     {
-        m_SupplementaryResults->Append(whimsicals[0]);
+        m_SupplementaryResults->Append(ref new SupplementaryResult(get<0>(desired[i]), get<1>(desired[i])));
     }
 
     m_cacheMutex.unlock();
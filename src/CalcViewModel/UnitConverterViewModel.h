@@ -101,6 +101,15 @@ namespace CalculatorApp
                 return m_Unit->GetModelUnit().isWhimsical;
             }
 
+            // Rewrites the entry in place; the bound text hears the
+            // property changes, so a refreshed suggestion updates its
+            // row instead of replacing it.
+            void Update(Platform::String^ value, CalculatorApp::ViewModel::Unit^ unit)
+            {
+                Value = value;
+                this->Unit = unit;
+            }
+
             Platform::String^ GetLocalizedAutomationName();
 
         public:
@@ -248,10 +257,15 @@ namespace CalculatorApp
             void OnMaxDigitsReached();
 
             void BuildUnitList(const std::vector<UnitConversionManager::Unit>& modelUnitList);
+            // Type-ahead search over the current category's units, best
+            // match first. Matches reuse the pooled wrappers, so a result
+            // row is the same object the full unit list shows.
+            Windows::Foundation::Collections::IVector<Unit^>^ FindUnits(Platform::String^ query);
             Unit^ FindUnitInList(UnitConversionManager::Unit target);
             void SetSelectedUnits();
 
         private:
+            Unit^ GetOrCreateUnit(const UnitConversionManager::Unit& modelUnit);
             void InitializeView();
             void OnPropertyChanged(Platform::String^ prop);
             void OnCategoryChanged(Platform::Object^ unused);
@@ -313,6 +327,10 @@ namespace CalculatorApp
             int m_currencyMaxFractionDigits;
             std::wstring m_valueFromUnlocalized;
             std::wstring m_valueToUnlocalized;
+            // Scratch buffer reused by ConvertToLocalizedString; the From and
+            // To values and every supplementary result pass through it on each
+            // update, so keeping the allocation avoids a churn per keystroke.
+            std::wstring m_localizedStringBuffer;
             bool m_relocalizeStringOnSwitch;
             // For Saving the User Preferences only if the Unit converter ViewModel is initialised for the first time
             bool m_IsFirstTime;
@@ -332,6 +350,16 @@ namespace CalculatorApp
 
             bool m_isCurrencyDataLoaded;
 
+            // Pooled Unit wrappers keyed by model id.  BuildUnitList
+            // reuses them and patches the displayed vector in place, so
+            // switching categories neither reallocates the row objects
+            // nor re-templates entries that did not change.
+            std::unordered_map<int, Unit^> m_unitPool;
+
+            // The preferences string last written to LocalSettings, used to
+            // elide redundant settings writes on unit reselection.
+            std::wstring m_lastSavedUserPreferences;
+
             std::unique_ptr<CalculatorApp::Common::ConversionResultTaskHelper> m_conversionResultTaskHelper;
         };
 
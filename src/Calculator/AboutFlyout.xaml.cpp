@@ -24,7 +24,14 @@ using namespace Windows::UI::Xaml::Data;
 #define BUILD_YEAR 2019
 #endif
 
-AboutFlyout::AboutFlyout()
+namespace
+{
+    // Taps on the version text before the hidden diagnostics panel opens.
+    constexpr int c_diagnosticsTapThreshold = 7;
+}
+
+AboutFlyout::AboutFlyout() :
+    m_diagnosticsTapCount(0)
 {
     auto locService = LocalizationService::GetInstance();
     auto resourceLoader = AppResourceProvider::GetInstance();
@@ -66,3 +73,30 @@ void CalculatorApp::AboutFlyout::UserControl_Loaded(Platform::Object^ sender, Wi
 {
     TraceLogger::GetInstance().LogAboutFlyoutOpened();
 }
+
+// Hidden diagnostics surface: repeated taps on the version text arm the
+// local performance counters and reveal them; once open, every further tap
+// refreshes the report. Nothing here leaves the machine, so field engineers
+// can read a slow device without attaching an ETW session.
+void AboutFlyout::AboutContentBody_Tapped(_In_ Object^ sender, _In_ Windows::UI::Xaml::Input::TappedRoutedEventArgs^ e)
+{
+    if (TraceLogger::LocalDiagnosticsActive())
+    {
+        RefreshDiagnostics();
+        return;
+    }
+
+    if (++m_diagnosticsTapCount < c_diagnosticsTapThreshold)
+    {
+        return;
+    }
+
+    TraceLogger::SetLocalDiagnosticsActive(true);
+    DiagnosticsPanel->Visibility = ::Visibility::Visible;
+    RefreshDiagnostics();
+}
+
+void AboutFlyout::RefreshDiagnostics()
+{
+    DiagnosticsText->Text = ref new String(TraceLogger::GetInstance().BuildDiagnosticsReport().c_str());
+}
@@ -18,5 +18,9 @@ namespace CalculatorApp
         void FeedbackButton_Click(_In_ Platform::Object^ sender, _In_ Windows::UI::Xaml::RoutedEventArgs^ e);
         void SetVersionString();
         void UserControl_Loaded(Platform::Object^ sender, Windows::UI::Xaml::RoutedEventArgs^ e);
+        void AboutContentBody_Tapped(_In_ Platform::Object^ sender, _In_ Windows::UI::Xaml::Input::TappedRoutedEventArgs^ e);
+        void RefreshDiagnostics();
+
+        int m_diagnosticsTapCount;
     };
 } /* namespace CalculatorApp */
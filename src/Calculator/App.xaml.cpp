@@ -8,11 +8,14 @@
 
 #include "pch.h"
 #include "App.xaml.h"
+#include "CalcViewModel/Common/LaunchTimeline.h"
 #include "CalcViewModel/Common/TraceLogger.h"
 #include "CalcViewModel/Common/Automation/NarratorNotifier.h"
 #include "CalcViewModel/Common/AppResourceProvider.h"
+#include "CalcViewModel/Common/EngineResourceProvider.h"
 #include "CalcViewModel/Common/LocalizationSettings.h"
 #include "CalcViewModel/ViewState.h"
+#include "CalcManager/CalculatorManager.h"
 #include "Views/MainPage.xaml.h"
 
 using namespace CalculatorApp;
@@ -61,7 +64,14 @@ namespace CalculatorApp
 App::App()
 {
     TraceLogger::GetInstance().LogAppLaunchStart();
+    LaunchTimeline::Record(L"AppConstruct");
+
+    // Start the thread-pool warmup before XAML inflation so the two overlap;
+    // OnAppLaunch joins the task before the window can take input.
+    m_startupWarmupTask = WarmupStartupCaches();
+
     InitializeComponent();
+    LaunchTimeline::Record(L"AppXamlLoaded");
 
     m_preLaunched = false;
 
@@ -209,6 +219,62 @@ Frame^ App::CreateFrame()
     return frame;
 }
 
+/// <summary>
+/// Runs the startup costs that do not need the UI thread concurrently on the
+/// thread pool, while the UI thread inflates XAML and navigates to the main
+/// page. Each piece is guarded by its own lock or magic static, so a first
+/// use that races the warmup blocks on that one piece instead of redoing it;
+/// the join in OnAppLaunch guarantees everything is resident before the
+/// window activates and can take input. Every piece is best-effort: a failure
+/// here is swallowed and the first real use retries and surfaces it.
+/// </summary>
+task<void> App::WarmupStartupCaches()
+{
+    // The engine keeps a pointer to the registered string provider, so the
+    // provider must outlive every engine; a function-local static does.
+    static EngineResourceProvider s_warmStringProvider;
+
+    auto engineWarmup = create_task([]()
+    {
+        try
+        {
+            // Registers the engine string provider and derives the shared
+            // ratpak constant pool, so every engine thread - including the
+            // UI thread - copies its constants instead of deriving them.
+            CCalcEngine::InitialOneTimeOnlySetup(s_warmStringProvider);
+        }
+        catch (...) {}
+    });
+
+    auto localizationWarmup = create_task([]()
+    {
+        try
+        {
+            // The localized digit tables, then the regional-settings-aware
+            // formatter cache and the language identifiers behind it.
+            LocalizationSettings::GetInstance();
+            LocalizationService::GetRegionalSettingsAwareDecimalFormatter();
+        }
+        catch (...) {}
+    });
+
+    auto resourceWarmup = create_task([]()
+    {
+        try
+        {
+            // The navigation metadata itself is compile-time, but building
+            // the menu groups resolves the header and mode name strings
+            // through the process-wide resource cache - the same lookups the
+            // main page and every mode change would otherwise pay on the UI
+            // thread.
+            NavCategoryGroup::CreateMenuOptions();
+        }
+        catch (...) {}
+    });
+
+    return engineWarmup && localizationWarmup && resourceWarmup;
+}
+
 /// <summary>
 /// Invoked when the application is launched normally by the end user. Other entry points
 /// will be used when the application is launched to open a specific file, to display
@@ -217,12 +283,24 @@ Frame^ App::CreateFrame()
 /// <param name="e">Details about the launch request and process.</param>
 void App::OnLaunched(LaunchActivatedEventArgs^ args)
 {
+    LaunchTimeline::Record(L"OnLaunched");
     TraceLogger::GetInstance().LogWindowLaunched();
+
+    // Build engines on a background thread so the first mode selection in
+    // this window - and in any window opened later - adopts a ready engine
+    // instead of constructing one on the UI thread.
+    CalculationManager::CalculatorManager::PrewarmEngines();
     if (args->PrelaunchActivated)
     {
         // If the app got pre-launch activated, then save that state in a flag
         m_preLaunched = true;
         TraceLogger::GetInstance().LogAppPrelaunchedBySystem();
+
+        // The warmup started in the constructor is already paying the
+        // first-keystroke costs - the engine string table and constants, the
+        // localized digit tables, the regional-settings-aware formatter
+        // cache - on the thread pool, well before the user activation that
+        // follows prelaunch.
     }
     OnAppLaunch(args, args->Arguments);
 }
@@ -289,6 +367,7 @@ void App::OnAppLaunch(IActivatedEventArgs^ args, String^ argument)
         // When the navigation stack isn't restored navigate to the first page,
         // configuring the new page by passing required information as a navigation
         // parameter
+        LaunchTimeline::Record(L"MainPageNavigationBegin");
         if (!rootFrame->Navigate(MainPage::typeid, argument))
         {
             // We couldn't navigate to the main page, kill the app so we have a good
@@ -296,9 +375,22 @@ void App::OnAppLaunch(IActivatedEventArgs^ args, String^ argument)
             throw std::bad_exception();
         }
 
-        SetMinWindowSizeAndActivate(rootFrame, minWindowSize);
-        m_mainViewId = ApplicationView::GetForCurrentView()->Id;
-        AddWindowToMap(WindowFrameService::CreateNewWindowFrameService(rootFrame, false, weak));
+        // Join the startup warmup before the window can take input by gating
+        // activation on it. Blocking the UI thread on a task is illegal in a
+        // Windows Runtime STA, so the join is a continuation back on this
+        // thread; by now the warmup has typically finished while XAML
+        // inflated and the main page navigated, so this adds no wait.
+        m_startupWarmupTask.then([rootFrame, minWindowSize, weak]()
+        {
+            LaunchTimeline::Record(L"StartupWarmupJoined");
+            SetMinWindowSizeAndActivate(rootFrame, minWindowSize);
+            auto that = weak.Resolve<App>();
+            if (that != nullptr)
+            {
+                that->m_mainViewId = ApplicationView::GetForCurrentView()->Id;
+                that->AddWindowToMap(WindowFrameService::CreateNewWindowFrameService(rootFrame, false, weak));
+            }
+        }, task_continuation_context::use_current());
     }
     else
     {
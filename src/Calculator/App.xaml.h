@@ -79,6 +79,7 @@ namespace CalculatorApp
         concurrency::reader_writer_lock m_windowsMapLock;
         std::unordered_map<int, WindowFrameService^> m_secondaryWindows;
 
+        static concurrency::task<void> WarmupStartupCaches();
         concurrency::task<void> SetupJumpList();
         concurrency::task<void> HandleViewReleaseAndRemoveWindowFromMap(_In_ WindowFrameService^ frameService);
         void AddWindowToMap(_In_ WindowFrameService^ frameService);
@@ -86,6 +87,7 @@ namespace CalculatorApp
         void RemoveWindowFromMap(int viewId);
         int m_mainViewId;
         bool m_preLaunched;
+        concurrency::task<void> m_startupWarmupTask;
 
         Windows::UI::Xaml::Controls::Primitives::Popup^ m_aboutPopup;
 
@@ -39,11 +39,6 @@ DEPENDENCY_PROPERTY_INITIALIZATION(CalculationResult, DisplayStringExpression);
 #define SCALEFACTOR 0.357143
 #define SMALLHEIGHTSCALEFACTOR 0
 #define HEIGHTCUTOFF 100
-#define INCREMENTOFFSET 1
-#define MAXFONTINCREMENT 5
-#define WIDTHTOFONTSCALAR 0.0556513
-#define WIDTHTOFONTOFFSET 3
-#define WIDTHCUTOFF 50
 #define FONTTOLERANCE 0.001
 
 StringReference CalculationResult::s_FocusedState(L"Focused");
@@ -51,8 +46,7 @@ StringReference CalculationResult::s_UnfocusedState(L"Unfocused");
 
 CalculationResult::CalculationResult():
     m_startingFontSize(0.0),
-    m_isScalingText(false),
-    m_haveCalculatedMax(false)
+    m_isScalingText(false)
 {
 }
 
@@ -96,6 +90,7 @@ void CalculationResult::OnApplyTemplate()
         {
             m_textBlock->Visibility = ::Visibility::Visible;
             m_startingFontSize = m_textBlock->FontSize;
+            m_startingMargin = m_textBlock->Margin;
         }
     }
     UpdateAllState();
@@ -112,9 +107,13 @@ void CalculationResult::OnPointerPressed(PointerRoutedEventArgs^ e)
 
 void CalculationResult::OnTextContainerLayoutUpdated(Object^ /*sender*/, Object^ /*e*/)
 {
+    // The fitting font size is computed off-tree in UpdateTextState; the one
+    // layout pass that follows it only needs to finalize scroll state once
+    // the new extents are real.
     if (m_isScalingText)
     {
-        UpdateTextState();
+        m_isScalingText = false;
+        FinalizeScrollPosition();
     }
 }
 
@@ -189,75 +188,121 @@ void CalculationResult::UpdateTextState()
     }
 
     auto containerSize = m_textContainer->ActualWidth;
-    String^ oldText = m_textBlock->Text;
-    String^ newText =  Utils::LRO + DisplayValue + Utils::PDF;
+    String^ newText = Utils::LRO + DisplayValue + Utils::PDF;
 
-    // Initiate the scaling operation
-    // UpdateLayout will keep calling us until we make it through the below 2 if-statements
-    if (!m_isScalingText || oldText != newText)
+    if (m_textBlock->Text != newText)
     {
         m_textBlock->Text = newText;
+    }
 
-        m_isScalingText = true;
-        m_haveCalculatedMax = false;
-        m_textBlock->InvalidateArrange();
+    if (containerSize <= 0)
+    {
         return;
     }
-    if (containerSize > 0)
+
+    // Measure the fitting font size off-tree and apply it exactly once, so
+    // the live TextBlock only takes a single layout pass per display update.
+    double newFontSize = ComputeFittingFontSize(newText, containerSize);
+    if (abs(m_textBlock->FontSize - newFontSize) > FONTTOLERANCE)
     {
-        double widthDiff = abs(m_textBlock->ActualWidth - containerSize);
-        double fontSizeChange = INCREMENTOFFSET;
+        ApplyFontAndMargin(newFontSize);
+    }
 
-        if (widthDiff > WIDTHCUTOFF)
-        {
-            fontSizeChange = min<double>(max<double>(floor(WIDTHTOFONTSCALAR * widthDiff) - WIDTHTOFONTOFFSET, INCREMENTOFFSET), MAXFONTINCREMENT);
-        }
-        if (m_textBlock->ActualWidth < containerSize && abs(m_textBlock->FontSize - m_startingFontSize) > FONTTOLERANCE && !m_haveCalculatedMax)
-        {
-            ModifyFontAndMargin(m_textBlock, fontSizeChange);
-            m_textBlock->InvalidateArrange();
-            return;
-        }
-        if (fontSizeChange < 5)
+    m_isScalingText = true;
+    m_textBlock->InvalidateArrange();
+}
+
+double CalculationResult::ComputeFittingFontSize(String^ text, double containerSize)
+{
+    if (m_measurementTextBlock == nullptr)
+    {
+        m_measurementTextBlock = ref new TextBlock();
+    }
+
+    // Mirror the font the live TextBlock is currently using; error display
+    // swaps FontFamily, so copy it on every measurement.
+    m_measurementTextBlock->FontFamily = m_textBlock->FontFamily;
+    m_measurementTextBlock->FontStyle = m_textBlock->FontStyle;
+    m_measurementTextBlock->FontWeight = m_textBlock->FontWeight;
+    m_measurementTextBlock->FontStretch = m_textBlock->FontStretch;
+    m_measurementTextBlock->Text = text;
+
+    if (MeasuredTextWidth(m_startingFontSize) < containerSize)
+    {
+        return m_startingFontSize;
+    }
+    if (MeasuredTextWidth(MinFontSize) >= containerSize)
+    {
+        return MinFontSize;
+    }
+
+    // Binary search for the largest size that still fits; text width is
+    // monotonic in font size.
+    double lo = MinFontSize;
+    double hi = m_startingFontSize;
+    while (hi - lo > FONTTOLERANCE)
+    {
+        double mid = (lo + hi) / 2;
+        if (MeasuredTextWidth(mid) < containerSize)
         {
-            m_haveCalculatedMax = true;
+            lo = mid;
         }
-        if (m_textBlock->ActualWidth >= containerSize && abs(m_textBlock->FontSize - MinFontSize) > FONTTOLERANCE)
+        else
         {
-            ModifyFontAndMargin(m_textBlock, -1 * fontSizeChange);
-            m_textBlock->InvalidateArrange();
-            return;
+            hi = mid;
         }
-        assert(m_textBlock->FontSize >= MinFontSize && m_textBlock->FontSize <= m_startingFontSize);
-        m_isScalingText = false;
-        if (IsOperatorCommand)
+    }
+    return lo;
+}
+
+double CalculationResult::MeasuredTextWidth(double fontSize)
+{
+    m_measurementTextBlock->FontSize = fontSize;
+    m_measurementTextBlock->Measure(Size(numeric_limits<float>::infinity(), numeric_limits<float>::infinity()));
+    return m_measurementTextBlock->DesiredSize.Width;
+}
+
+void CalculationResult::ApplyFontAndMargin(double newFontSize)
+{
+    double scaleFactor = SCALEFACTOR;
+    if (m_textContainer->ActualHeight <= HEIGHTCUTOFF)
+    {
+        scaleFactor = SMALLHEIGHTSCALEFACTOR;
+    }
+    Thickness t = m_startingMargin;
+    t.Bottom += scaleFactor * (m_startingFontSize - newFontSize);
+    m_textBlock->FontSize = newFontSize;
+    m_textBlock->Margin = t;
+}
+
+void CalculationResult::FinalizeScrollPosition()
+{
+    if (IsOperatorCommand)
+    {
+        m_textContainer->ChangeView(0.0,nullptr,nullptr);
+    }
+    else
+    {
+        m_textContainer->ChangeView(m_textContainer->ExtentWidth - m_textContainer->ViewportWidth,nullptr,nullptr);
+    }
+
+    if (m_scrollLeft && m_scrollRight)
+    {
+        if (m_textBlock->ActualWidth < m_textContainer->ActualWidth)
         {
-            m_textContainer->ChangeView(0.0,nullptr,nullptr);
+            ShowHideScrollButtons(::Visibility::Collapsed, ::Visibility::Collapsed);
         }
         else
         {
-            m_textContainer->ChangeView(m_textContainer->ExtentWidth - m_textContainer->ViewportWidth,nullptr,nullptr);
-        }
-
-        if (m_scrollLeft && m_scrollRight)
-        {
-            if (m_textBlock->ActualWidth < containerSize)
+            if (IsOperatorCommand)
             {
-                ShowHideScrollButtons(::Visibility::Collapsed, ::Visibility::Collapsed);
+                ShowHideScrollButtons(::Visibility::Collapsed, ::Visibility::Visible);
             }
             else
             {
-                if (IsOperatorCommand)
-                {
-                    ShowHideScrollButtons(::Visibility::Collapsed, ::Visibility::Visible);
-                }
-                else
-                {
-                    ShowHideScrollButtons(::Visibility::Visible, ::Visibility::Collapsed);
-                }
+                ShowHideScrollButtons(::Visibility::Visible, ::Visibility::Collapsed);
             }
         }
-        m_textBlock->InvalidateArrange();
     }
 }
 
@@ -357,30 +402,6 @@ void CalculationResult::OnPointerExited(Platform::Object^ sender, PointerRoutedE
     }
 }
 
-void CalculationResult::ModifyFontAndMargin(TextBlock^ textBox, double fontChange)
-{
-    double cur = textBox->FontSize;
-    double newFontSize = 0.0;
-    Thickness t = textBox->Margin;
-    double scaleFactor = SCALEFACTOR;
-    if (m_textContainer->ActualHeight <= HEIGHTCUTOFF)
-    {
-        scaleFactor = SMALLHEIGHTSCALEFACTOR;
-    }
-    if (fontChange < 0)
-    {
-        newFontSize = max(cur + fontChange, MinFontSize);
-        t.Bottom += scaleFactor * abs(cur - newFontSize);
-    }
-    else
-    {
-        newFontSize = min(cur + fontChange, m_startingFontSize);
-        t.Bottom -= scaleFactor * abs(cur - newFontSize);
-    }
-    textBox->FontSize = newFontSize;
-    textBox->Margin = t;
-}
-
 void CalculationResult::UpdateAllState()
 {
     UpdateVisualState();
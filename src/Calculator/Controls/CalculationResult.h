@@ -59,7 +59,10 @@ namespace CalculatorApp
             void OnScrollClick(Platform::Object^ sender, Windows::UI::Xaml::RoutedEventArgs^ e);
             void OnPointerEntered(Platform::Object^ sender, Windows::UI::Xaml::Input::PointerRoutedEventArgs^ e);
             void OnPointerExited(Platform::Object^ sender, Windows::UI::Xaml::Input::PointerRoutedEventArgs^ e);
-            void ModifyFontAndMargin(Windows::UI::Xaml::Controls::TextBlock^ textBlock, double fontChange);
+            double ComputeFittingFontSize(Platform::String^ text, double containerSize);
+            double MeasuredTextWidth(double fontSize);
+            void ApplyFontAndMargin(double newFontSize);
+            void FinalizeScrollPosition();
             void ShowHideScrollButtons(Windows::UI::Xaml::Visibility vLeft, Windows::UI::Xaml::Visibility vRight);
             void UpdateScrollButtons();
             void ScrollLeft();
@@ -74,10 +77,15 @@ namespace CalculatorApp
             Windows::UI::Xaml::Controls::TextBlock^ m_textBlock;
             Windows::UI::Xaml::Controls::HyperlinkButton^ m_scrollLeft;
             Windows::UI::Xaml::Controls::HyperlinkButton^ m_scrollRight;
+
+            // Detached TextBlock used to measure candidate font sizes without
+            // touching the live visual tree.
+            Windows::UI::Xaml::Controls::TextBlock^ m_measurementTextBlock;
+
             double m_startingFontSize;
+            Windows::UI::Xaml::Thickness m_startingMargin;
             double scrollRatio = 0.7;
             bool m_isScalingText;
-            bool m_haveCalculatedMax;
             Windows::Foundation::EventRegistrationToken m_textContainerLayoutChangedToken;
         };
     }
@@ -15,15 +15,42 @@ using namespace Windows::Foundation;
 
 Size HorizontalNoOverflowStackPanel::MeasureOverride(Size availableSize)
 {
-    float maxHeight = 0;
-    float width = 0;
-    for (auto child : Children)
+    unsigned int childCount = Children->Size;
+    bool childrenChanged = m_childDesiredSizes.size() != childCount;
+    m_childDesiredSizes.resize(childCount);
+
+    // The constraint is always unconstrained, so Measure is a no-op inside
+    // the framework for children that are still measure-valid; the cache
+    // only goes stale for children that actually changed.
+    for (unsigned int i = 0; i < childCount; i++)
     {
+        auto child = Children->GetAt(i);
         child->Measure(Size(numeric_limits<float>::infinity(), numeric_limits<float>::infinity()));
-        maxHeight = max(maxHeight, child->DesiredSize.Height);
-        width += child->DesiredSize.Width;
+        Size desiredSize = child->DesiredSize;
+
+        auto& entry = m_childDesiredSizes[i];
+        if (entry.first != child || entry.second.Width != desiredSize.Width || entry.second.Height != desiredSize.Height)
+        {
+            entry.first = child;
+            entry.second = desiredSize;
+            childrenChanged = true;
+        }
     }
-    return Size(min(width, availableSize.Width), min(availableSize.Height, maxHeight));
+
+    // Re-aggregate only when a child's desired size changed; resize-driven
+    // passes reuse the cached totals.
+    if (childrenChanged)
+    {
+        m_cachedTotalWidth = 0;
+        m_cachedMaxHeight = 0;
+        for (const auto& entry : m_childDesiredSizes)
+        {
+            m_cachedTotalWidth += entry.second.Width;
+            m_cachedMaxHeight = max(m_cachedMaxHeight, entry.second.Height);
+        }
+    }
+
+    return Size(min(m_cachedTotalWidth, availableSize.Width), min(availableSize.Height, m_cachedMaxHeight));
 }
 
 bool HorizontalNoOverflowStackPanel::ShouldPrioritizeLastItem()
@@ -38,21 +65,27 @@ Size HorizontalNoOverflowStackPanel::ArrangeOverride(Size finalSize)
         return finalSize;
     }
 
+    unsigned int childCount = Children->Size;
+
+    // The arrange decisions below only need desired widths, which the
+    // measure pass has already cached per child slot.
     float posX = 0;
-    auto lastChild = Children->GetAt(Children->Size - 1);
+    auto lastChild = Children->GetAt(childCount - 1);
     float lastChildWidth = 0;
-    if (Children->Size > 2 && ShouldPrioritizeLastItem())
+    if (childCount > 2 && ShouldPrioritizeLastItem())
     {
         lastChildWidth = lastChild->DesiredSize.Width;
     }
-    for (auto item : Children)
+    for (unsigned int i = 0; i < childCount; i++)
     {
+        auto item = Children->GetAt(i);
         auto widthAvailable = finalSize.Width - posX;
         if (item != lastChild)
         {
             widthAvailable -= lastChildWidth;
         }
-        float itemWidth = item->DesiredSize.Width;
+        float itemWidth = (i < m_childDesiredSizes.size() && m_childDesiredSizes[i].first == item) ? m_childDesiredSizes[i].second.Width
+                                                                                                  : item->DesiredSize.Width;
         if (widthAvailable > 0 && itemWidth <= widthAvailable)
         {
             //stack the items horizontally (left to right)
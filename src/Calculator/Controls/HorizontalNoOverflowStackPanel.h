@@ -7,6 +7,8 @@
 //
 
 #pragma once
+#include <vector>
+#include <utility>
 #include "CalcViewModel/Common/Utils.h"
 
 namespace CalculatorApp
@@ -23,6 +25,15 @@ namespace CalculatorApp
             virtual Windows::Foundation::Size MeasureOverride(Windows::Foundation::Size availableSize) override;
             virtual Windows::Foundation::Size ArrangeOverride(Windows::Foundation::Size finalSize) override;
             virtual bool ShouldPrioritizeLastItem();
+
+        private:
+            // Desired sizes from the last measure pass, indexed by child slot.
+            // Every child is measured against the same unconstrained size, so
+            // an entry stays valid until the child in that slot changes or
+            // reports a new desired size.
+            std::vector<std::pair<Windows::UI::Xaml::UIElement^, Windows::Foundation::Size>> m_childDesiredSizes;
+            float m_cachedTotalWidth = 0;
+            float m_cachedMaxHeight = 0;
         };
     }
 }
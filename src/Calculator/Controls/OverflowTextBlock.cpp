@@ -28,12 +28,33 @@ DEPENDENCY_PROPERTY_INITIALIZATION(OverflowTextBlock, IsActive);
 DEPENDENCY_PROPERTY_INITIALIZATION(OverflowTextBlock, TextStyle);
 DEPENDENCY_PROPERTY_INITIALIZATION(OverflowTextBlock, TokensUpdated);
 
+namespace
+{
+    ScrollViewer^ FindScrollViewer(DependencyObject^ root)
+    {
+        int childCount = VisualTreeHelper::GetChildrenCount(root);
+        for (int i = 0; i < childCount; i++)
+        {
+            auto child = VisualTreeHelper::GetChild(root, i);
+            auto viewer = dynamic_cast<ScrollViewer^>(child);
+            if (viewer == nullptr)
+            {
+                viewer = FindScrollViewer(child);
+            }
+            if (viewer != nullptr)
+            {
+                return viewer;
+            }
+        }
+        return nullptr;
+    }
+}
+
 void OverflowTextBlock::OnApplyTemplate()
 {
     assert(((m_scrollLeft == nullptr) && (m_scrollRight == nullptr)) || ((m_scrollLeft != nullptr) && (m_scrollRight != nullptr)));
 
-    m_expressionContainer = safe_cast<ScrollViewer^>(GetTemplateChild("expressionContainer"));
-    m_expressionContainer->ChangeView(m_expressionContainer->ExtentWidth - m_expressionContainer->ViewportWidth, nullptr, nullptr);
+    m_expressionContainer = nullptr;
 
     m_scrollLeft = safe_cast<Button^>(GetTemplateChild("scrollLeft"));
     m_scrollRight = safe_cast<Button^>(GetTemplateChild("scrollRight"));
@@ -50,9 +71,27 @@ void OverflowTextBlock::OnApplyTemplate()
 
     m_listView = safe_cast<ListView^>(GetTemplateChild("TokenList"));
 
+    // The ListView scrolls itself so its ItemsStackPanel can virtualize
+    // token containers. Its ScrollViewer is part of the ListView's own
+    // template, so it can only be resolved after the ListView has loaded.
+    m_tokenListLoadedToken = m_listView->Loaded += ref new RoutedEventHandler(this, &OverflowTextBlock::OnTokenListLoaded);
+
     UpdateAllState();
 }
 
+void OverflowTextBlock::OnTokenListLoaded(_In_ Object^, _In_ RoutedEventArgs^)
+{
+    if (m_expressionContainer == nullptr)
+    {
+        m_expressionContainer = FindScrollViewer(m_listView);
+    }
+
+    if (m_expressionContainer != nullptr)
+    {
+        m_expressionContainer->ChangeView(m_expressionContainer->ExtentWidth - m_expressionContainer->ViewportWidth, nullptr, nullptr);
+    }
+}
+
 AutomationPeer^ OverflowTextBlock::OnCreateAutomationPeer()
 {
     return ref new OverflowTextBlockAutomationPeer(this);
@@ -67,7 +106,10 @@ void OverflowTextBlock::OnTokensUpdatedPropertyChanged(bool /*oldValue*/, bool n
         {
             m_listView->UpdateLayout();
             m_listView->ScrollIntoView(m_listView->Items->GetAt(tokenCount - 1));
-            m_expressionContainer->ChangeView(m_expressionContainer->ExtentWidth - m_expressionContainer->ViewportWidth, nullptr, nullptr);
+            if (m_expressionContainer != nullptr)
+            {
+                m_expressionContainer->ChangeView(m_expressionContainer->ExtentWidth - m_expressionContainer->ViewportWidth, nullptr, nullptr);
+            }
         }
     }
     AutomationProperties::SetAccessibilityView(this,
@@ -93,7 +135,7 @@ void OverflowTextBlock::UpdateVisualState()
 
 void OverflowTextBlock::ScrollLeft()
 {
-    if (m_expressionContainer->HorizontalOffset > 0)
+    if (m_expressionContainer != nullptr && m_expressionContainer->HorizontalOffset > 0)
     {
         m_scrollingLeft = true;
         double offset = m_expressionContainer->HorizontalOffset - (scrollRatio * m_expressionContainer->ViewportWidth);
@@ -105,7 +147,8 @@ void OverflowTextBlock::ScrollLeft()
 
 void OverflowTextBlock::ScrollRight()
 {
-    if (m_expressionContainer->HorizontalOffset < m_expressionContainer->ExtentWidth - m_expressionContainer->ViewportWidth)
+    if (m_expressionContainer != nullptr
+        && m_expressionContainer->HorizontalOffset < m_expressionContainer->ExtentWidth - m_expressionContainer->ViewportWidth)
     {
         m_scrollingRight = true;
         double offset = m_expressionContainer->HorizontalOffset + (scrollRatio * m_expressionContainer->ViewportWidth);
@@ -146,18 +189,37 @@ void OverflowTextBlock::OnPointerExited(_In_ Object^, _In_ PointerRoutedEventArg
 
 void OverflowTextBlock::UpdateScrollButtons()
 {
-    // When the width is smaller than the container, don't show any
-    if (m_listView->ActualWidth <= m_expressionContainer->ActualWidth)
+    if (m_expressionContainer == nullptr)
+    {
+        return;
+    }
+
+    double horizontalOffset = m_expressionContainer->HorizontalOffset;
+    double extentWidth = m_expressionContainer->ExtentWidth;
+    double viewportWidth = m_expressionContainer->ViewportWidth;
+
+    // This runs on every layout pass; the button state only depends on the
+    // scroll metrics, so skip the work when nothing has moved.
+    if ((horizontalOffset == m_lastHorizontalOffset) && (extentWidth == m_lastExtentWidth) && (viewportWidth == m_lastViewportWidth))
+    {
+        return;
+    }
+    m_lastHorizontalOffset = horizontalOffset;
+    m_lastExtentWidth = extentWidth;
+    m_lastViewportWidth = viewportWidth;
+
+    // When the content is smaller than the viewport, don't show any
+    if (extentWidth <= viewportWidth)
     {
         ShowHideScrollButtons(::Visibility::Collapsed, ::Visibility::Collapsed);
     }
     // We have more number on both side. Show both arrows
-    else if ((m_expressionContainer->HorizontalOffset > 0) && (m_expressionContainer->HorizontalOffset < (m_expressionContainer->ExtentWidth - m_expressionContainer->ViewportWidth)))
+    else if ((horizontalOffset > 0) && (horizontalOffset < (extentWidth - viewportWidth)))
     {
         ShowHideScrollButtons(::Visibility::Visible, ::Visibility::Visible);
     }
     // Width is larger than the container and left most part of the number is shown. Should be able to scroll left.
-    else if (m_expressionContainer->HorizontalOffset == 0)
+    else if (horizontalOffset == 0)
     {
         ShowHideScrollButtons(::Visibility::Collapsed, ::Visibility::Visible);
         if (m_scrollingLeft)
@@ -199,6 +261,11 @@ void OverflowTextBlock::UnregisterEventHandlers()
         m_scrollRight->Click -= m_scrollRightClickEventToken;
     }
 
+    if (m_listView != nullptr)
+    {
+        m_listView->Loaded -= m_tokenListLoadedToken;
+    }
+
     auto borderContainer = safe_cast<Border^>(GetTemplateChild("expressionborder"));
 
     // Adding an extra check, in case the returned template is null
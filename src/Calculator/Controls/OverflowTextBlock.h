@@ -30,6 +30,7 @@ namespace CalculatorApp
 
         private:
             void OnScrollClick(_In_ Platform::Object^ sender, _In_ Windows::UI::Xaml::RoutedEventArgs^ e);
+            void OnTokenListLoaded(_In_ Platform::Object^ sender, _In_ Windows::UI::Xaml::RoutedEventArgs^ e);
             void OnPointerEntered(_In_ Platform::Object^ sender, _In_ Windows::UI::Xaml::Input::PointerRoutedEventArgs^ e);
             void OnPointerExited(_In_ Platform::Object^ sender, _In_ Windows::UI::Xaml::Input::PointerRoutedEventArgs^ e);
             void ShowHideScrollButtons(Windows::UI::Xaml::Visibility vLeft, Windows::UI::Xaml::Visibility vRight);
@@ -45,14 +46,24 @@ namespace CalculatorApp
             bool m_scrollingLeft;
             bool m_scrollingRight;
             Windows::UI::Xaml::Controls::ListView^ m_listView;
+
+            // The ListView's internal ScrollViewer; resolved once the ListView
+            // has loaded because it lives inside the ListView's template.
             Windows::UI::Xaml::Controls::ScrollViewer^ m_expressionContainer;
             Windows::UI::Xaml::Controls::Button^ m_scrollLeft;
             Windows::UI::Xaml::Controls::Button^ m_scrollRight;
 
+            // Scroll metrics as of the last UpdateScrollButtons call, so the
+            // per-layout-pass updates can skip the work when nothing moved.
+            double m_lastHorizontalOffset = -1.0;
+            double m_lastExtentWidth = -1.0;
+            double m_lastViewportWidth = -1.0;
+
             Windows::Foundation::EventRegistrationToken m_scrollLeftClickEventToken;
             Windows::Foundation::EventRegistrationToken m_scrollRightClickEventToken;
             Windows::Foundation::EventRegistrationToken m_pointerEnteredEventToken;
             Windows::Foundation::EventRegistrationToken m_pointerExitedEventToken;
+            Windows::Foundation::EventRegistrationToken m_tokenListLoadedToken;
         };
     }
 }
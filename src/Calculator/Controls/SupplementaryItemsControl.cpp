@@ -20,6 +20,13 @@ using namespace std;
 
 DependencyObject^ SupplementaryItemsControl::GetContainerForItemOverride()
 {
+    if (!m_recycledPresenters.empty())
+    {
+        auto presenter = m_recycledPresenters.back();
+        m_recycledPresenters.pop_back();
+        return presenter;
+    }
+
     return ref new SupplementaryContentPresenter();
 }
 
@@ -34,6 +41,19 @@ void SupplementaryItemsControl::PrepareContainerForItemOverride(DependencyObject
     }
 }
 
+void SupplementaryItemsControl::ClearContainerForItemOverride(DependencyObject^ element, Object^ item)
+{
+    ItemsControl::ClearContainerForItemOverride(element, item);
+
+    auto presenter = dynamic_cast<SupplementaryContentPresenter^>(element);
+    if (presenter != nullptr)
+    {
+        presenter->Content = nullptr;
+        presenter->ClearValue(AutomationProperties::NameProperty);
+        m_recycledPresenters.push_back(presenter);
+    }
+}
+
  AutomationPeer^ SupplementaryContentPresenter::OnCreateAutomationPeer()
  {
      return ref new SupplementaryContentPresenterAP(this);
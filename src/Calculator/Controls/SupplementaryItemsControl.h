@@ -3,8 +3,12 @@
 
 #pragma once
 
+#include <vector>
+
 namespace CalculatorApp { namespace Controls {
 
+    public ref class SupplementaryContentPresenter;
+
     public ref class SupplementaryItemsControl sealed: public Windows::UI::Xaml::Controls::ItemsControl
     {
     public:
@@ -14,6 +18,14 @@ namespace CalculatorApp { namespace Controls {
     protected:
         virtual Windows::UI::Xaml::DependencyObject^ GetContainerForItemOverride() override;
         virtual void PrepareContainerForItemOverride(Windows::UI::Xaml::DependencyObject^ element, Platform::Object^ item) override;
+        virtual void ClearContainerForItemOverride(Windows::UI::Xaml::DependencyObject^ element, Platform::Object^ item) override;
+
+    private:
+        // Presenters recovered from cleared items. The converter replaces the
+        // whole suggestion collection on every keystroke, so the containers it
+        // just dropped are reused for the refreshed results instead of
+        // rebuilding their visual subtrees.
+        std::vector<SupplementaryContentPresenter^> m_recycledPresenters;
     };
 
     public ref class SupplementaryContentPresenter sealed: public Windows::UI::Xaml::Controls::ContentPresenter
@@ -82,6 +82,10 @@ void Calculator::InitializeHistoryView(_In_ HistoryViewModel^ historyVM)
         historyVM->HideHistoryClicked += ref new ViewModel::HideHistoryClickedHandler(this, &Calculator::OnHideHistoryClicked);
         historyVM->HistoryItemClicked += ref new ViewModel::HistoryItemClickedHandler(this, &Calculator::OnHistoryItemClicked);
     }
+
+    // The pane is about to be shown; hydrate the item ViewModels now if
+    // this is the first time history is actually looked at.
+    historyVM->EnsureHistoryLoaded();
 }
 
 void Calculator::SetFontSizeResources()
@@ -131,7 +135,6 @@ void Calculator::OnLoaded(_In_ Object^, _In_ RoutedEventArgs^)
     Model->PropertyChanged += ref new PropertyChangedEventHandler(this, &Calculator::OnCalcPropertyChanged);
     Model->HideMemoryClicked += ref new HideMemoryClickedHandler(this, &Calculator::OnHideMemoryClicked);
 
-    InitializeHistoryView(Model->HistoryVM);
     String^ historyPaneName = AppResourceProvider::GetInstance().GetResourceString(L"HistoryPane");
     HistoryFlyout->FlyoutPresenterStyle->Setters->Append(ref new Setter(AutomationProperties::NameProperty, historyPaneName));
     String^ memoryPaneName = AppResourceProvider::GetInstance().GetResourceString(L"MemoryPane");
@@ -299,22 +302,37 @@ void Calculator::OnIsProgrammerPropertyChanged(bool /*oldValue*/, bool newValue)
     if (newValue)
     {
         EnsureProgrammer();
-        m_pivotItem = static_cast<Windows::UI::Xaml::Controls::PivotItem^>(DockPivot->Items->GetAt(0));
-        DockPivot->Items->RemoveAt(0);
     }
-    else
+
+    // The docked panel is loaded on demand; when it is not realized yet,
+    // EnsureDockPanel applies the pivot item layout once it loads.
+    if (DockPanel != nullptr)
     {
-        if (m_pivotItem != nullptr && DockPivot->Items->Size == 1)
-        {
-            DockPivot->Items->InsertAt(0, m_pivotItem);
-        }
+        UpdateDockPivotItems();
+        DockPivot->SelectedIndex = 0;
     }
 
-    DockPivot->SelectedIndex = 0;
     UpdateViewState();
     UpdatePanelViewState();
 }
 
+void Calculator::UpdateDockPivotItems()
+{
+    if (IsProgrammer)
+    {
+        // There is no history in programmer mode, so only the memory pivot item is shown.
+        if (DockPivot->Items->Size == 2)
+        {
+            m_pivotItem = static_cast<Windows::UI::Xaml::Controls::PivotItem^>(DockPivot->Items->GetAt(0));
+            DockPivot->Items->RemoveAt(0);
+        }
+    }
+    else if (m_pivotItem != nullptr && DockPivot->Items->Size == 1)
+    {
+        DockPivot->Items->InsertAt(0, m_pivotItem);
+    }
+}
+
 void Calculator::OnIsInErrorPropertyChanged()
 {
     bool isError = Model->IsInError;
@@ -386,6 +404,18 @@ void Calculator::EnsureProgrammer()
     ProgrammerOperators->SetRadixButton(Model->GetCurrentRadixType());
 }
 
+void Calculator::EnsureDockPanel()
+{
+    if (DockPanel == nullptr)
+    {
+        this->FindName(L"DockPanel");
+    }
+
+    // The panel may also have been realized by a visual state setter after the
+    // last mode change, so bring the pivot items up to date either way.
+    UpdateDockPivotItems();
+}
+
 void Calculator::OnCalcPropertyChanged(_In_ Object^ sender, _In_ PropertyChangedEventArgs^ e)
 {
     String^ prop = e->PropertyName;
@@ -412,6 +442,7 @@ void Calculator::UpdateHistoryState()
     {
         // docked view
         CloseHistoryFlyout();
+        EnsureDockPanel();
         SetChildAsHistory();
         HistoryButton->Visibility = ::Visibility::Collapsed;
 
@@ -422,7 +453,10 @@ void Calculator::UpdateHistoryState()
     }
     else
     {    // flyout view
-        DockHistoryHolder->Child = nullptr;
+        if (DockHistoryHolder != nullptr)
+        {
+            DockHistoryHolder->Child = nullptr;
+        }
         if (!IsProgrammer)
         {
             HistoryButton->Visibility = ::Visibility::Visible;
@@ -447,6 +481,7 @@ void Calculator::UpdateMemoryState()
     if (viewState == ViewState::DockedView)
     {
         CloseMemoryFlyout();
+        EnsureDockPanel();
         SetChildAsMemory();
         MemoryButton->Visibility = ::Visibility::Collapsed;
 
@@ -458,7 +493,10 @@ void Calculator::UpdateMemoryState()
     else
     {
         MemoryButton->Visibility = ::Visibility::Visible;
-        DockMemoryHolder->Child = nullptr;
+        if (DockMemoryHolder != nullptr)
+        {
+            DockMemoryHolder->Child = nullptr;
+        }
     }
 }
 
@@ -564,6 +602,7 @@ void Calculator::ToggleHistoryFlyout(Object^ /*parameter*/)
         else
         {
             TraceLogger::GetInstance().LogHistoryFlyoutOpenBegin(Model->HistoryVM->ItemSize);
+            InitializeHistoryView(Model->HistoryVM);
             HistoryFlyout->Content = m_historyList;
             m_historyList->RowHeight = NumpadPanel->ActualHeight;
             FlyoutBase::ShowAttachedFlyout(HistoryButton);
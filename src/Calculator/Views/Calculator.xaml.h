@@ -88,6 +88,8 @@ namespace CalculatorApp
         void OnLayoutStateChanged(_In_ Platform::Object^ sender, _In_ Platform::Object^ e);
         void EnsureScientific();
         void EnsureProgrammer();
+        void EnsureDockPanel();
+        void UpdateDockPivotItems();
         void SetFontSizeResources();
         std::wstring GetCurrentLayoutState();
 
@@ -174,6 +174,23 @@ void CalculatorProgrammerBitFlipPanel::OnBitToggled(_In_ Object^ sender, _In_ Ro
         auto flipButton = static_cast<FlipButtons^>(sender);
         Model->ButtonPressed->Execute(flipButton->ButtonId);
     }
+    else
+    {
+        // The toggle was ignored, so put the button back in the state the
+        // displayed value calls for; otherwise it would drift from the value
+        // the other buttons show.
+        auto flipButton = static_cast<FlipButtons^>(sender);
+        for (unsigned int bitIndex = 0; bitIndex < s_numBits; bitIndex++)
+        {
+            if (m_flipButtons[bitIndex] == flipButton)
+            {
+                m_updatingCheckedStates = true;
+                flipButton->IsChecked = ((m_currentValue >> bitIndex) & 1) != 0;
+                m_updatingCheckedStates = false;
+                break;
+            }
+        }
+    }
 }
 
 void CalculatorProgrammerBitFlipPanel::UpdateCheckedStates()
@@ -193,30 +210,35 @@ void CalculatorProgrammerBitFlipPanel::UpdateCheckedStates()
         Utils::LRO
     };
 
-    wstringstream stream;
-    wstring displayValue = Model->BinaryDisplayValue->Data();
-    for (const wchar_t& c : displayValue)
+    // Accumulate the displayed bits into a uint64 directly; the most
+    // significant bit comes first in the display string.
+    uint64_t newValue = 0;
+    String^ displayValue = Model->BinaryDisplayValue;
+    for (const wchar_t* c = displayValue->Begin(); c != displayValue->End(); ++c)
     {
-        if (find(begin(unwantedChars), end(unwantedChars), c) == unwantedChars.end())
+        if (find(begin(unwantedChars), end(unwantedChars), *c) == unwantedChars.end())
         {
-            stream << c;
+            newValue = (newValue << 1) | ((*c != ch0) ? 1 : 0);
         }
     }
 
-    wstring rawDisplay = stream.str();
-    size_t paddingCount = s_numBits - rawDisplay.length();
-    wstring setBits = wstring(paddingCount, ch0) + rawDisplay;
-    assert(setBits.length() == s_numBits);
+    // Only the flipped bits need their button state written; the rest of
+    // the 64 toggles keep their dependency properties untouched.
+    uint64_t changedBits = newValue ^ m_currentValue;
+    if (changedBits == 0)
+    {
+        return;
+    }
 
     m_updatingCheckedStates = true;
     for (unsigned int bitIndex = 0; bitIndex < s_numBits; bitIndex++)
     {
-        // Highest bit (64) is at index 0 in bit string.
-        // To get bit 0, grab from opposite end of string.
-        wchar_t bit = setBits[s_numBits - bitIndex - 1];
-
-        m_flipButtons[bitIndex]->IsChecked = (bit != ch0);
+        if ((changedBits >> bitIndex) & 1)
+        {
+            m_flipButtons[bitIndex]->IsChecked = ((newValue >> bitIndex) & 1) != 0;
+        }
     }
 
+    m_currentValue = newValue;
     m_updatingCheckedStates = false;
 }
@@ -48,5 +48,9 @@ namespace CalculatorApp
         static const unsigned int s_numBits = 64;
         std::array<CalculatorApp::Controls::FlipButtons^, s_numBits> m_flipButtons;
         bool m_updatingCheckedStates;
+
+        // The value the buttons currently show. New display values are
+        // XORed against it so only flipped bits write their button state.
+        uint64_t m_currentValue = 0;
     };
 }
@@ -3,6 +3,7 @@
 
 #include "pch.h"
 #include "MainPage.xaml.h"
+#include "CalcViewModel/Common/LaunchTimeline.h"
 #include "CalcViewModel/Common/TraceLogger.h"
 #include "CalcViewModel/Common/KeyboardShortcutManager.h"
 #include "CalcViewModel/Common/LocalizationService.h"
@@ -265,6 +266,8 @@ void MainPage::OnPageLoaded(_In_ Object^, _In_ RoutedEventArgs^ args)
             TraceLogger::GetInstance().LogAppLaunchComplete();
             AppLifecycleLogger::GetInstance().LaunchUIResponsive();
             AppLifecycleLogger::GetInstance().LaunchVisibleComplete();
+            LaunchTimeline::Record(L"UIResponsive");
+            LaunchTimeline::EmitOnce();
         }
     }));
 }
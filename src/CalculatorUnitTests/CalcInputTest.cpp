@@ -251,6 +251,18 @@ namespace CalculatorUnitTests
             m_calcInput.Backspace();
             VERIFY_ARE_EQUAL(L"1.2", m_calcInput.ToString(10), L"Verify input after backspace.");
         }
+        TEST_METHOD(BackspaceRun)
+        {
+            m_calcInput.TryAddDigit(1, 10, false, L"999", 64, 32);
+            m_calcInput.TryAddDecimalPt();
+            m_calcInput.TryAddDigit(2, 10, false, L"999", 64, 32);
+            m_calcInput.TryAddDigit(3, 10, false, L"999", 64, 32);
+            VERIFY_ARE_EQUAL(L"1.23", m_calcInput.ToString(10), L"Verify input before backspace run.");
+            m_calcInput.Backspace(3);
+            VERIFY_ARE_EQUAL(L"1", m_calcInput.ToString(10), L"Verify run deletes digits and decimal point.");
+            m_calcInput.Backspace(5);
+            VERIFY_ARE_EQUAL(L"0", m_calcInput.ToString(10), L"Verify run past the start of input stops at empty.");
+        }
 
         TEST_METHOD(SetDecimalSymbol)
         {
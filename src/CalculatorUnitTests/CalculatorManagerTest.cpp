@@ -57,6 +57,14 @@ namespace CalculatorManagerTest
             m_memorizedNumberStrings = numbers;
         }
 
+        void SetMemorizedNumber(unsigned int indexOfMemory, const wstring& memorizedNumber) override
+        {
+            if (indexOfMemory < m_memorizedNumberStrings.size())
+            {
+                m_memorizedNumberStrings[indexOfMemory] = memorizedNumber;
+            }
+        }
+
         void SetParenDisplayText(const std::wstring& parenthesisCount) override
         {
             m_parenDisplay = parenthesisCount;
@@ -186,11 +194,14 @@ namespace CalculatorManagerTest
         TEST_METHOD(CalculatorManagerTestSerializeMultiple);
         TEST_METHOD(CalculatorManagerTestSerializeDegreeMode);
         TEST_METHOD(CalculatorManagerTestSerializeMemory);
+        TEST_METHOD(CalculatorManagerTestCloneState);
 
         TEST_METHOD(CalculatorManagerTestMaxDigitsReached);
         TEST_METHOD(CalculatorManagerTestMaxDigitsReached_LeadingDecimal);
         TEST_METHOD(CalculatorManagerTestMaxDigitsReached_TrailingDecimal);
 
+        TEST_METHOD(CalculatorManagerTestSendCommandRun);
+
         // TODO re-enable when cause of failure is determined. Bug 20226670
         //TEST_METHOD(CalculatorManagerTestBinaryOperatorReceived);
         //TEST_METHOD(CalculatorManagerTestBinaryOperatorReceived_Multiple);
@@ -894,6 +905,34 @@ namespace CalculatorManagerTest
         VerifyPersistence();
     }
 
+    // Duplicate-window path: fork the full state into a fresh manager,
+    // verify the copy starts where the source is, then diverge both.
+    void CalculatorManagerTest::CalculatorManagerTestCloneState()
+    {
+        CalculatorManagerDisplayTester* pCalculatorDisplay = (CalculatorManagerDisplayTester*)m_calculatorDisplayTester.get();
+        Cleanup();
+
+        Command commands[] = { Command::Command1, Command::Command2, Command::CommandADD,
+            Command::Command3, Command::CommandEQU, Command::CommandNULL };
+        ExecuteCommands(commands);
+        m_calculatorManager->MemorizeNumber();
+
+        auto cloneDisplay = make_shared<CalculatorManagerDisplayTester>();
+        CalculatorManager clone(cloneDisplay.get(), m_resourceProvider.get());
+        VERIFY_IS_TRUE(clone.CloneStateFrom(*m_calculatorManager));
+
+        VERIFY_ARE_EQUAL(pCalculatorDisplay->GetPrimaryDisplay(), cloneDisplay->GetPrimaryDisplay());
+        VERIFY_ARE_EQUAL(pCalculatorDisplay->GetMemorizedNumbers().size(), cloneDisplay->GetMemorizedNumbers().size());
+        VERIFY_ARE_EQUAL(m_calculatorManager->GetHistoryItems().size(), clone.GetHistoryItems().size());
+
+        // The fork is independent: input into the clone leaves the source alone.
+        clone.SendCommand(Command::CommandMUL);
+        clone.SendCommand(Command::Command2);
+        clone.SendCommand(Command::CommandEQU);
+        VERIFY_ARE_EQUAL(wstring(L"30"), cloneDisplay->GetPrimaryDisplay());
+        VERIFY_ARE_EQUAL(wstring(L"15"), pCalculatorDisplay->GetPrimaryDisplay());
+    }
+
     // 1 + 2 then serialize and deserialize 3 times
     // Check if the values are persisted correctly
     void CalculatorManagerTest::CalculatorManagerTestSerializeMultiple()
@@ -1058,6 +1097,35 @@ namespace CalculatorManagerTest
         TestMaxDigitsReachedScenario(L"123,456,789,101,112.13");
     }
 
+    void CalculatorManagerTest::CalculatorManagerTestSendCommandRun()
+    {
+        CalculatorManagerDisplayTester* pCalculatorDisplay = (CalculatorManagerDisplayTester *)m_calculatorDisplayTester.get();
+
+        Cleanup();
+        m_calculatorManager->SetStandardMode();
+
+        // A digit run lands as one batched input edit.
+        m_calculatorManager->SendCommandRun(Command::Command7, 4);
+        VERIFY_ARE_EQUAL(wstring(L"7777"), pCalculatorDisplay->GetPrimaryDisplay());
+
+        // A backspace run deletes that many characters at once.
+        m_calculatorManager->SendCommandRun(Command::CommandBACK, 2);
+        VERIFY_ARE_EQUAL(wstring(L"77"), pCalculatorDisplay->GetPrimaryDisplay());
+
+        // Deleting past the start of the operand is a no-op, like holding
+        // Backspace on an empty display.
+        m_calculatorManager->SendCommandRun(Command::CommandBACK, 10);
+        VERIFY_ARE_EQUAL(wstring(L"0"), pCalculatorDisplay->GetPrimaryDisplay());
+
+        // Commands without a batched form repeat through the per-command
+        // pipeline: a repeated equals re-applies the last operation.
+        m_calculatorManager->SendCommand(Command::Command5);
+        m_calculatorManager->SendCommand(Command::CommandADD);
+        m_calculatorManager->SendCommand(Command::Command3);
+        m_calculatorManager->SendCommandRun(Command::CommandEQU, 2);
+        VERIFY_ARE_EQUAL(wstring(L"11"), pCalculatorDisplay->GetPrimaryDisplay());
+    }
+
     // TODO re-enable when cause of failure is determined. Bug 20226670
     // void CalculatorManagerTest::CalculatorManagerTestBinaryOperatorReceived()
     // {
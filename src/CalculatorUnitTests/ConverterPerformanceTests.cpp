@@ -0,0 +1,262 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "pch.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <CppUnitTest.h>
+
+using namespace std;
+using namespace UnitConversionManager;
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace ConverterPerformanceTests
+{
+    // Converter latency benchmarks behind the ratio-matrix and parallel
+    // suggestion-sweep work. The same scripts run against a small, a
+    // medium and a deliberately oversized synthetic category, so growth
+    // that is linear in the unit count shows up as a spread between the
+    // logged medians long before a budget trips. Budgets are an order of
+    // magnitude above cold lab numbers, tuned to catch algorithmic
+    // regressions rather than scheduler noise.
+    constexpr int ScriptRepetitions = 11;
+
+    constexpr size_t SmallCategoryUnits = 2;
+    constexpr size_t MediumCategoryUnits = 50;
+    constexpr size_t LargeCategoryUnits = 500;
+
+    constexpr long long ConversionKeystrokeBudgetMs = 500;
+    constexpr long long SuggestionDeliveryBudgetMs = 2000;
+    constexpr long long SerializationRoundTripBudgetMs = 500;
+
+    // Synthetic category with a configurable unit count. Unit i has
+    // "size" i relative to unit 1, which makes every pairwise ratio
+    // finite, distinct and cheap to hand out on demand.
+    class SyntheticConverterDataLoader : public IConverterDataLoader
+    {
+    public:
+        explicit SyntheticConverterDataLoader(size_t unitCount)
+        {
+            m_category.id = 1;
+            m_category.name = L"Synthetic";
+            m_category.supportsNegative = true;
+
+            m_units.reserve(unitCount);
+            for (size_t i = 0; i < unitCount; i++)
+            {
+                wstring name = L"Unit" + to_wstring(i + 1);
+                m_units.emplace_back(static_cast<int>(i + 1), name, name, i == 0, i == 1, false);
+            }
+        }
+
+        void LoadData() override {}
+
+        vector<Category> LoadOrderedCategories() override
+        {
+            return vector<Category>{ m_category };
+        }
+
+        vector<Unit> LoadOrderedUnits(const Category& /*category*/) override
+        {
+            return m_units;
+        }
+
+        unordered_map<Unit, ConversionData, UnitHash> LoadOrderedRatios(const Unit& unit) override
+        {
+            unordered_map<Unit, ConversionData, UnitHash> ratios;
+            ratios.reserve(m_units.size());
+            for (const Unit& target : m_units)
+            {
+                ConversionData data;
+                data.ratio = static_cast<double>(unit.id) / static_cast<double>(target.id);
+                data.offset = 0.0;
+                data.offsetFirst = false;
+                ratios[target] = data;
+            }
+            return ratios;
+        }
+
+        bool SupportsCategory(const Category& /*target*/) override
+        {
+            return true;
+        }
+
+    private:
+        Category m_category;
+        vector<Unit> m_units;
+    };
+
+    // The suggestion sweep is delivered from a background task, so the
+    // callback counts deliveries and lets the benchmark block until the
+    // sweep for its keystroke comes back.
+    class SignalingConverterCallback : public IUnitConverterVMCallback
+    {
+    public:
+        void DisplayCallback(const wstring& /*from*/, const wstring& /*to*/) override {}
+
+        void SuggestedValueCallback(const vector<tuple<wstring, Unit>>& /*suggestedValues*/) override
+        {
+            {
+                lock_guard<mutex> lock(m_mutex);
+                m_deliveries++;
+            }
+            m_delivered.notify_all();
+        }
+
+        void MaxDigitsReached() override {}
+
+        unsigned int Deliveries()
+        {
+            lock_guard<mutex> lock(m_mutex);
+            return m_deliveries;
+        }
+
+        // Blocks until a sweep newer than `previousDeliveries` has been
+        // delivered. The timeout only bounds a hang; a slow sweep still
+        // lands in the measured script time and trips the budget.
+        void WaitForDeliveryAfter(unsigned int previousDeliveries)
+        {
+            unique_lock<mutex> lock(m_mutex);
+            m_delivered.wait_for(lock, chrono::seconds(10), [&]() { return m_deliveries > previousDeliveries; });
+        }
+
+    private:
+        mutex m_mutex;
+        condition_variable m_delivered;
+        unsigned int m_deliveries = 0;
+    };
+
+    TEST_CLASS(ConverterPerformanceTests)
+    {
+    public:
+        TEST_METHOD(ConversionKeystrokesStayInBudgetAcrossCategorySizes);
+        TEST_METHOD(SuggestionDeliveryStaysInBudgetForLargeCategory);
+        TEST_METHOD(SerializationRoundTripStaysInBudgetForLargeCategory);
+
+    private:
+        static shared_ptr<UnitConverter> MakeConverter(size_t unitCount, const shared_ptr<IUnitConverterVMCallback>& vmCallback)
+        {
+            auto dataLoader = make_shared<SyntheticConverterDataLoader>(unitCount);
+            auto converter = make_shared<UnitConverter>(dataLoader);
+            converter->SetViewModelCallback(vmCallback);
+            converter->Initialize();
+            return converter;
+        }
+
+        // Median of ScriptRepetitions timed runs, after one untimed
+        // warm-up pass that absorbs lazy setup such as the ratio matrix.
+        template <typename TScript>
+        static long long MedianScriptMilliseconds(TScript&& script)
+        {
+            using namespace std::chrono;
+
+            script();
+
+            vector<long long> samples;
+            samples.reserve(ScriptRepetitions);
+            for (int i = 0; i < ScriptRepetitions; i++)
+            {
+                auto start = steady_clock::now();
+                script();
+                samples.push_back(duration_cast<milliseconds>(steady_clock::now() - start).count());
+            }
+
+            sort(samples.begin(), samples.end());
+            return samples[samples.size() / 2];
+        }
+
+        static void LogMedian(const wstring& scriptName, long long medianMs, long long budgetMs)
+        {
+            wstring message = scriptName + L": median " + to_wstring(medianMs)
+                + L" ms (budget " + to_wstring(budgetMs) + L" ms)";
+            Logger::WriteMessage(message.c_str());
+        }
+    };
+
+    // Every digit, decimal and backspace recomputes the paired value
+    // through Convert; the cost must not scale with the category size.
+    void ConverterPerformanceTests::ConversionKeystrokesStayInBudgetAcrossCategorySizes()
+    {
+        for (size_t unitCount : { SmallCategoryUnits, MediumCategoryUnits, LargeCategoryUnits })
+        {
+            auto vmCallback = make_shared<SignalingConverterCallback>();
+            auto converter = MakeConverter(unitCount, vmCallback);
+
+            long long medianMs = MedianScriptMilliseconds([&]() {
+                converter->SendCommand(Command::Clear);
+                for (int burst = 0; burst < 10; burst++)
+                {
+                    converter->SendCommand(Command::Two);
+                    converter->SendCommand(Command::Seven);
+                    converter->SendCommand(Command::One);
+                    converter->SendCommand(Command::Decimal);
+                    converter->SendCommand(Command::Eight);
+                    converter->SendCommand(Command::Two);
+                    converter->SendCommand(Command::Backspace);
+                    converter->SendCommand(Command::Backspace);
+                    converter->SendCommand(Command::Clear);
+                }
+            });
+
+            LogMedian(L"ConversionKeystrokes/" + to_wstring(unitCount) + L" units", medianMs, ConversionKeystrokeBudgetMs);
+            VERIFY_IS_LESS_THAN(medianMs, ConversionKeystrokeBudgetMs);
+        }
+    }
+
+    // Keystroke-to-suggestions: each digit starts a background sweep over
+    // all 500 units, and the script waits for that sweep's delivery
+    // before the next keystroke, so the medians track end-to-end latency
+    // rather than just enqueue time.
+    void ConverterPerformanceTests::SuggestionDeliveryStaysInBudgetForLargeCategory()
+    {
+        auto vmCallback = make_shared<SignalingConverterCallback>();
+        auto converter = MakeConverter(LargeCategoryUnits, vmCallback);
+
+        const Command digits[] = { Command::Three, Command::One, Command::Four, Command::One, Command::Five };
+
+        long long medianMs = MedianScriptMilliseconds([&]() {
+            unsigned int seen = vmCallback->Deliveries();
+            converter->SendCommand(Command::Clear);
+            vmCallback->WaitForDeliveryAfter(seen);
+
+            for (Command digit : digits)
+            {
+                seen = vmCallback->Deliveries();
+                converter->SendCommand(digit);
+                vmCallback->WaitForDeliveryAfter(seen);
+            }
+        });
+
+        LogMedian(L"SuggestionDelivery/" + to_wstring(LargeCategoryUnits) + L" units", medianMs, SuggestionDeliveryBudgetMs);
+        VERIFY_IS_LESS_THAN(medianMs, SuggestionDeliveryBudgetMs);
+    }
+
+    // Suspend/resume writes the compact state string and reads it back;
+    // neither direction may grow with the category.
+    void ConverterPerformanceTests::SerializationRoundTripStaysInBudgetForLargeCategory()
+    {
+        auto vmCallback = make_shared<SignalingConverterCallback>();
+        auto converter = MakeConverter(LargeCategoryUnits, vmCallback);
+
+        converter->SendCommand(Command::One);
+        converter->SendCommand(Command::Two);
+        converter->SendCommand(Command::Decimal);
+        converter->SendCommand(Command::Five);
+        wstring serialized = converter->Serialize();
+        VERIFY_IS_FALSE(serialized.empty());
+
+        long long medianMs = MedianScriptMilliseconds([&]() {
+            for (int roundTrip = 0; roundTrip < 20; roundTrip++)
+            {
+                converter->DeSerialize(serialized);
+                serialized = converter->Serialize();
+            }
+        });
+
+        LogMedian(L"SerializationRoundTrip/" + to_wstring(LargeCategoryUnits) + L" units", medianMs, SerializationRoundTripBudgetMs);
+        VERIFY_IS_LESS_THAN(medianMs, SerializationRoundTripBudgetMs);
+    }
+}
@@ -194,6 +194,10 @@ namespace CalculatorUnitTests
         TEST_METHOD_INITIALIZE(DeleteCacheFiles)
         {
             DeleteCurrencyCacheFiles();
+
+            // These tests exercise the disk path; drop the process-wide
+            // session snapshot a previous test may have populated.
+            CurrencyDataLoader::InvalidateSessionCache();
         }
 
         TEST_METHOD(LoadFromCache_Fail_NoCacheKey)
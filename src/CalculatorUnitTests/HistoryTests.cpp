@@ -31,6 +31,8 @@ namespace CalculatorFunctionalTests
         TEST_METHOD(TestReLoadHistory);
         TEST_METHOD(TestSaveAndReloadHistory);
         TEST_METHOD(TestSerializeDeSerializeHistoryItem);
+        TEST_METHOD(TestExportHistory);
+        TEST_METHOD(TestSharedHistoryAcrossWindows);
         TEST_METHOD(TestHistoryItemWithPrettyExpressions);
         TEST_METHOD(TestHistoryItemWithPrettyExpressionsMixedRadix);
         TEST_METHOD(TestHistoryItemLoadAndContinueCalculation);
@@ -260,6 +262,77 @@ namespace CalculatorFunctionalTests
             Cleanup();
         }
 
+        void ExportHistory()
+        {
+            Initialize();
+            m_standardViewModel->m_standardCalculatorManager.SendCommand(Command::Command1);
+            m_standardViewModel->m_standardCalculatorManager.SendCommand(Command::CommandADD);
+            m_standardViewModel->m_standardCalculatorManager.SendCommand(Command::Command8);
+            m_standardViewModel->m_standardCalculatorManager.SendCommand(Command::CommandEQU);
+            m_standardViewModel->m_standardCalculatorManager.SendCommand(Command::Command2);
+            m_standardViewModel->m_standardCalculatorManager.SendCommand(Command::CommandADD);
+            m_standardViewModel->m_standardCalculatorManager.SendCommand(Command::Command3);
+            m_standardViewModel->m_standardCalculatorManager.SendCommand(Command::CommandEQU);
+
+            wstring path{ ApplicationData::Current->LocalFolder->Path->Data() };
+            path += L"\\HistoryExportTest.csv";
+            VERIFY_IS_TRUE(m_historyViewModel->ExportHistoryAsync(ref new String(path.c_str()), false /*tabSeparated*/).get());
+
+            HANDLE hFile = CreateFile2(path.c_str(), GENERIC_READ, FILE_SHARE_READ, OPEN_EXISTING, nullptr);
+            VERIFY_IS_TRUE(hFile != INVALID_HANDLE_VALUE);
+            char contents[1024] = {};
+            DWORD cbRead = 0;
+            VERIFY_IS_TRUE(ReadFile(hFile, contents, sizeof(contents) - 1, &cbRead, nullptr) != 0);
+            CloseHandle(hFile);
+            string exported(contents, cbRead);
+
+            // Both records should appear with the display's bidi control
+            // marks stripped for the audit tooling.
+            VERIFY_IS_TRUE(exported.find("Expression,Result") != string::npos);
+            VERIFY_IS_TRUE(exported.find("1   +   8 =,9") != string::npos);
+            VERIFY_IS_TRUE(exported.find("2   +   3 =,5") != string::npos);
+
+            DeleteFileW(path.c_str());
+            Cleanup();
+        }
+
+        void SharedHistoryAcrossWindows()
+        {
+            Initialize();
+            // The shared store is process-wide, so start it from empty for
+            // this mode regardless of what earlier tests published.
+            m_standardViewModel->m_standardCalculatorManager.ClearHistory();
+
+            m_standardViewModel->m_standardCalculatorManager.SendCommand(Command::Command1);
+            m_standardViewModel->m_standardCalculatorManager.SendCommand(Command::CommandADD);
+            m_standardViewModel->m_standardCalculatorManager.SendCommand(Command::Command8);
+            m_standardViewModel->m_standardCalculatorManager.SendCommand(Command::CommandEQU);
+
+            // A second window has its own manager and an empty local history
+            // until it folds in what the first window published.
+            auto secondWindowViewModel = ref new StandardCalculatorViewModel();
+            secondWindowViewModel->IsStandard = true;
+            auto& secondManager = secondWindowViewModel->m_standardCalculatorManager;
+            VERIFY_ARE_EQUAL(size_t{ 0 }, secondManager.GetHistoryItems(CALCULATOR_MODE::CM_STD).size());
+
+            VERIFY_IS_TRUE(secondManager.SyncHistoryFromShared(CALCULATOR_MODE::CM_STD));
+            auto const& adoptedItems = secondManager.GetHistoryItems(CALCULATOR_MODE::CM_STD);
+            VERIFY_ARE_EQUAL(size_t{ 1 }, adoptedItems.size());
+            String^ result = StringReference(L"9");
+            VERIFY_ARE_EQUAL(result, StringReference(adoptedItems.back()->historyItemVector.result.c_str()));
+
+            // Nothing new published since: the sync is a generation compare
+            // and adopts nothing.
+            VERIFY_IS_FALSE(secondManager.SyncHistoryFromShared(CALCULATOR_MODE::CM_STD));
+
+            // A clear in the first window reaches the second on its next sync.
+            m_standardViewModel->m_standardCalculatorManager.ClearHistory();
+            VERIFY_IS_TRUE(secondManager.SyncHistoryFromShared(CALCULATOR_MODE::CM_STD));
+            VERIFY_ARE_EQUAL(size_t{ 0 }, secondManager.GetHistoryItems(CALCULATOR_MODE::CM_STD).size());
+
+            Cleanup();
+        }
+
         void HistoryItemWithPrettyExpressions()
         {
             Initialize();
@@ -488,6 +561,16 @@ namespace CalculatorFunctionalTests
         SaveAndReloadHistory();
     }
 
+    void HistoryTests::TestExportHistory()
+    {
+        ExportHistory();
+    }
+
+    void HistoryTests::TestSharedHistoryAcrossWindows()
+    {
+        SharedHistoryAcrossWindows();
+    }
+
     void HistoryTests::TestHistoryItemWithPrettyExpressions()
     {
         HistoryItemWithPrettyExpressions();
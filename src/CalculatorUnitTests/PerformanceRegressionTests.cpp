@@ -0,0 +1,248 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "pch.h"
+
+#include <algorithm>
+#include <chrono>
+#include <CppUnitTest.h>
+
+#include "CalcViewModel/Common/EngineResourceProvider.h"
+
+using namespace CalculatorApp;
+using namespace CalculationManager;
+using namespace std;
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace PerformanceRegressionTests
+{
+    // The budgets below are deliberately an order of magnitude above what
+    // the scripts take on a cold lab machine today, so they catch
+    // algorithmic regressions (a kernel going quadratic, a per-keystroke
+    // replay creeping in) without flaking on scheduler noise. Each script
+    // is repeated and judged on its median, which discards the occasional
+    // preempted run.
+    constexpr int ScriptRepetitions = 11;
+
+    constexpr long long LongExpressionBudgetMs = 250;
+    constexpr long long RadixToggleBudgetMs = 250;
+    constexpr long long ConverterStormBudgetMs = 500;
+
+    // Display stub: the scripts time computation, not callback handling.
+    class SilentCalcDisplay : public ICalcDisplay
+    {
+    public:
+        void SetPrimaryDisplay(const wstring& /*text*/, bool /*isError*/) override {}
+        void SetIsInError(bool /*isError*/) override {}
+        void SetExpressionDisplay(
+            _Inout_ shared_ptr<CalculatorVector<pair<wstring, int>>> const& /*tokens*/,
+            _Inout_ shared_ptr<CalculatorVector<shared_ptr<IExpressionCommand>>> const& /*commands*/) override {}
+        void SetParenDisplayText(const wstring& /*text*/) override {}
+        void OnNoRightParenAdded() override {}
+        void MaxDigitsReached() override {}
+        void BinaryOperatorReceived() override {}
+        void OnHistoryItemAdded(_In_ unsigned int /*addedItemIndex*/) override {}
+        void SetMemorizedNumbers(const vector<wstring>& /*memorizedNumbers*/) override {}
+        void MemoryItemChanged(unsigned int /*indexOfMemory*/) override {}
+    };
+
+    class SilentConverterCallback : public UnitConversionManager::IUnitConverterVMCallback
+    {
+    public:
+        void DisplayCallback(const wstring& /*from*/, const wstring& /*to*/) override {}
+        void SuggestedValueCallback(const vector<tuple<wstring, UnitConversionManager::Unit>>& /*suggestedValues*/) override {}
+        void MaxDigitsReached() override {}
+    };
+
+    // Two units with a plain ratio are enough to drive the converter's
+    // per-keystroke quantize/format path.
+    class PerfConverterDataLoader : public UnitConversionManager::IConverterDataLoader
+    {
+    public:
+        PerfConverterDataLoader()
+        {
+            m_category.id = 1;
+            m_category.name = L"Length";
+            m_category.supportsNegative = true;
+
+            m_from = UnitConversionManager::Unit(1, L"Inches", L"In", true, true, false);
+            m_to = UnitConversionManager::Unit(2, L"Feet", L"Ft", false, false, false);
+
+            UnitConversionManager::ConversionData identity;
+            identity.ratio = 1.0;
+            identity.offset = 0.0;
+            identity.offsetFirst = false;
+
+            UnitConversionManager::ConversionData toFeet;
+            toFeet.ratio = 1.0 / 12.0;
+            toFeet.offset = 0.0;
+            toFeet.offsetFirst = false;
+
+            UnitConversionManager::ConversionData toInches;
+            toInches.ratio = 12.0;
+            toInches.offset = 0.0;
+            toInches.offsetFirst = false;
+
+            m_ratios[m_from][m_from] = identity;
+            m_ratios[m_from][m_to] = toFeet;
+            m_ratios[m_to][m_to] = identity;
+            m_ratios[m_to][m_from] = toInches;
+        }
+
+        void LoadData() override {}
+
+        vector<UnitConversionManager::Category> LoadOrderedCategories() override
+        {
+            return vector<UnitConversionManager::Category>{ m_category };
+        }
+
+        vector<UnitConversionManager::Unit> LoadOrderedUnits(const UnitConversionManager::Category& /*category*/) override
+        {
+            return vector<UnitConversionManager::Unit>{ m_from, m_to };
+        }
+
+        unordered_map<UnitConversionManager::Unit, UnitConversionManager::ConversionData, UnitConversionManager::UnitHash>
+            LoadOrderedRatios(const UnitConversionManager::Unit& unit) override
+        {
+            return m_ratios[unit];
+        }
+
+        bool SupportsCategory(const UnitConversionManager::Category& /*target*/) override
+        {
+            return true;
+        }
+
+    private:
+        UnitConversionManager::Category m_category;
+        UnitConversionManager::Unit m_from;
+        UnitConversionManager::Unit m_to;
+        unordered_map<UnitConversionManager::Unit,
+            unordered_map<UnitConversionManager::Unit, UnitConversionManager::ConversionData, UnitConversionManager::UnitHash>,
+            UnitConversionManager::UnitHash> m_ratios;
+    };
+
+    TEST_CLASS(PerformanceRegressionTests)
+    {
+    public:
+        TEST_METHOD(LongExpressionEntryStaysInBudget);
+        TEST_METHOD(ProgrammerRadixTogglingStaysInBudget);
+        TEST_METHOD(ConverterKeystrokeStormStaysInBudget);
+
+    private:
+        // Runs the script ScriptRepetitions times after one warm-up pass
+        // and returns the median wall time in milliseconds.
+        template <typename TScript>
+        static long long MedianScriptMilliseconds(TScript&& script)
+        {
+            using namespace std::chrono;
+
+            script(); // warm-up: first run pays one-time setup costs
+
+            vector<long long> samples;
+            samples.reserve(ScriptRepetitions);
+            for (int i = 0; i < ScriptRepetitions; i++)
+            {
+                auto start = steady_clock::now();
+                script();
+                samples.push_back(duration_cast<milliseconds>(steady_clock::now() - start).count());
+            }
+
+            sort(samples.begin(), samples.end());
+            return samples[samples.size() / 2];
+        }
+
+        static void LogMedian(const wchar_t* scriptName, long long medianMs, long long budgetMs)
+        {
+            wstring message = wstring(scriptName) + L": median " + to_wstring(medianMs)
+                + L" ms (budget " + to_wstring(budgetMs) + L" ms)";
+            Logger::WriteMessage(message.c_str());
+        }
+    };
+
+    // 20 four-digit operands chained with alternating operators and
+    // evaluated - the canonical "user types a long expression" script.
+    void PerformanceRegressionTests::LongExpressionEntryStaysInBudget()
+    {
+        SilentCalcDisplay display;
+        auto resourceProvider = make_shared<EngineResourceProvider>();
+        CalculatorManager manager(&display, resourceProvider.get());
+        manager.SendCommand(Command::ModeScientific);
+
+        long long medianMs = MedianScriptMilliseconds([&]() {
+            manager.SendCommand(Command::CommandCLEAR);
+            for (int operand = 0; operand < 20; operand++)
+            {
+                manager.SendCommand(Command::Command1);
+                manager.SendCommand(Command::Command2);
+                manager.SendCommand(Command::Command7);
+                manager.SendCommand(Command::Command9);
+                manager.SendCommand((operand % 2 == 0) ? Command::CommandADD : Command::CommandMUL);
+            }
+            manager.SendCommand(Command::Command3);
+            manager.SendCommand(Command::CommandEQU);
+        });
+
+        LogMedian(L"LongExpressionEntry", medianMs, LongExpressionBudgetMs);
+        VERIFY_IS_LESS_THAN(medianMs, LongExpressionBudgetMs);
+    }
+
+    // Programmer mode re-renders the display and memory strings on every
+    // radix change; cycle through all four radixes with a wide value.
+    void PerformanceRegressionTests::ProgrammerRadixTogglingStaysInBudget()
+    {
+        SilentCalcDisplay display;
+        auto resourceProvider = make_shared<EngineResourceProvider>();
+        CalculatorManager manager(&display, resourceProvider.get());
+        manager.SendCommand(Command::ModeProgrammer);
+
+        manager.SendCommand(Command::CommandCLEAR);
+        for (int digit = 0; digit < 12; digit++)
+        {
+            manager.SendCommand(Command::Command7);
+        }
+
+        long long medianMs = MedianScriptMilliseconds([&]() {
+            for (int cycle = 0; cycle < 10; cycle++)
+            {
+                manager.SetRadix(HEX_RADIX);
+                manager.SetRadix(OCT_RADIX);
+                manager.SetRadix(BIN_RADIX);
+                manager.SetRadix(DEC_RADIX);
+            }
+        });
+
+        LogMedian(L"ProgrammerRadixToggling", medianMs, RadixToggleBudgetMs);
+        VERIFY_IS_LESS_THAN(medianMs, RadixToggleBudgetMs);
+    }
+
+    // Converter keystroke storm: a burst of digits, corrections and
+    // decimal input, each of which recomputes the paired value.
+    void PerformanceRegressionTests::ConverterKeystrokeStormStaysInBudget()
+    {
+        auto dataLoader = make_shared<PerfConverterDataLoader>();
+        auto vmCallback = make_shared<SilentConverterCallback>();
+        auto converter = make_shared<UnitConversionManager::UnitConverter>(dataLoader);
+        converter->SetViewModelCallback(vmCallback);
+        converter->Initialize();
+
+        long long medianMs = MedianScriptMilliseconds([&]() {
+            converter->SendCommand(UnitConversionManager::Command::Clear);
+            for (int burst = 0; burst < 10; burst++)
+            {
+                converter->SendCommand(UnitConversionManager::Command::Three);
+                converter->SendCommand(UnitConversionManager::Command::One);
+                converter->SendCommand(UnitConversionManager::Command::Four);
+                converter->SendCommand(UnitConversionManager::Command::Decimal);
+                converter->SendCommand(UnitConversionManager::Command::One);
+                converter->SendCommand(UnitConversionManager::Command::Five);
+                converter->SendCommand(UnitConversionManager::Command::Backspace);
+                converter->SendCommand(UnitConversionManager::Command::Backspace);
+                converter->SendCommand(UnitConversionManager::Command::Backspace);
+                converter->SendCommand(UnitConversionManager::Command::Clear);
+            }
+        });
+
+        LogMedian(L"ConverterKeystrokeStorm", medianMs, ConverterStormBudgetMs);
+        VERIFY_IS_LESS_THAN(medianMs, ConverterStormBudgetMs);
+    }
+}
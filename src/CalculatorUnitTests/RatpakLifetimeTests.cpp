@@ -0,0 +1,184 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "pch.h"
+
+#include <CppUnitTest.h>
+
+#include "CalcViewModel/Common/EngineResourceProvider.h"
+
+using namespace CalculatorApp;
+using namespace CalculationManager;
+using namespace std;
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace RatpakLifetimeTests
+{
+    // Display stub: lifetime accounting cares about the engine, not the
+    // callbacks.
+    class SilentCalcDisplay : public ICalcDisplay
+    {
+    public:
+        void SetPrimaryDisplay(const wstring& /*text*/, bool /*isError*/) override {}
+        void SetIsInError(bool /*isError*/) override {}
+        void SetExpressionDisplay(
+            _Inout_ shared_ptr<CalculatorVector<pair<wstring, int>>> const& /*tokens*/,
+            _Inout_ shared_ptr<CalculatorVector<shared_ptr<IExpressionCommand>>> const& /*commands*/) override {}
+        void SetParenDisplayText(const wstring& /*text*/) override {}
+        void OnNoRightParenAdded() override {}
+        void MaxDigitsReached() override {}
+        void BinaryOperatorReceived() override {}
+        void OnHistoryItemAdded(_In_ unsigned int /*addedItemIndex*/) override {}
+        void SetMemorizedNumbers(const vector<wstring>& /*memorizedNumbers*/) override {}
+        void MemoryItemChanged(unsigned int /*indexOfMemory*/) override {}
+    };
+
+    // Every number the engine touches lives in a ratpak block created by
+    // _createnum and released by _destroynum; the engine's own Rational
+    // values copy the digits out, so once a command returns and the
+    // manager is Reset, every block the scenario created must be gone.
+    // The only allocations that legitimately outlive a scenario are the
+    // cached constants (pi, logarithm tables, per-precision ratios) that
+    // ratpak builds on first use - which is why each scenario runs once
+    // unmeasured before the counted run.
+    TEST_CLASS(RatpakLifetimeTests)
+    {
+    public:
+        TEST_METHOD(ScientificExpressionBalancesAllocations);
+        TEST_METHOD(ErrorPathsBalanceAllocations);
+        TEST_METHOD(MemoryAndHistoryBalanceAllocations);
+        TEST_METHOD(WorkerThreadReleaseBalancesAllocations);
+
+    private:
+        // Runs the scenario once to populate ratpak's constant caches,
+        // then again under the allocation counters, Resetting the manager
+        // on both sides so the measured window starts and ends in the
+        // same engine state. Returns creates minus destroys.
+        template <typename TScenario>
+        static long long NetLiveAfter(CalculatorManager& manager, TScenario&& scenario)
+        {
+            scenario(); // warm-up: first use builds cached constants
+            manager.Reset();
+
+            CalculatorManager::SetDiagnosticsEnabled(true);
+            CalculatorManager::ResetDiagnostics();
+
+            scenario();
+            manager.Reset();
+
+            auto stats = CalculatorManager::GetDiagnostics();
+            CalculatorManager::SetDiagnosticsEnabled(false);
+
+            return static_cast<long long>(stats.cCreateNum) - static_cast<long long>(stats.cDestroyNum);
+        }
+    };
+
+    // A full scientific expression: chained binary operators, trig and
+    // logarithm unaries, a power, then equals.
+    void RatpakLifetimeTests::ScientificExpressionBalancesAllocations()
+    {
+        SilentCalcDisplay display;
+        auto resourceProvider = make_shared<EngineResourceProvider>();
+        CalculatorManager manager(&display, resourceProvider.get());
+        manager.SendCommand(Command::ModeScientific);
+
+        long long netLive = NetLiveAfter(manager, [&]() {
+            manager.SendCommand(Command::CommandCLEAR);
+            manager.SendCommand(Command::Command2);
+            manager.SendCommand(Command::CommandPNT);
+            manager.SendCommand(Command::Command5);
+            manager.SendCommand(Command::CommandSIN);
+            manager.SendCommand(Command::CommandADD);
+            manager.SendCommand(Command::Command3);
+            manager.SendCommand(Command::CommandLN);
+            manager.SendCommand(Command::CommandMUL);
+            manager.SendCommand(Command::Command2);
+            manager.SendCommand(Command::CommandPWR);
+            manager.SendCommand(Command::Command8);
+            manager.SendCommand(Command::CommandEQU);
+            manager.ClearHistory();
+        });
+
+        VERIFY_ARE_EQUAL(0ll, netLive);
+    }
+
+    // Error paths unwind through the thrown CALC_E codes in CalcErr.h;
+    // every partial result allocated before the throw must still be
+    // released. Divide by zero and the logarithm domain error cover the
+    // binary and unary unwind paths.
+    void RatpakLifetimeTests::ErrorPathsBalanceAllocations()
+    {
+        SilentCalcDisplay display;
+        auto resourceProvider = make_shared<EngineResourceProvider>();
+        CalculatorManager manager(&display, resourceProvider.get());
+        manager.SendCommand(Command::ModeScientific);
+
+        long long netLive = NetLiveAfter(manager, [&]() {
+            manager.SendCommand(Command::CommandCLEAR);
+            manager.SendCommand(Command::Command1);
+            manager.SendCommand(Command::CommandDIV);
+            manager.SendCommand(Command::Command0);
+            manager.SendCommand(Command::CommandEQU);
+
+            manager.SendCommand(Command::CommandCLEAR);
+            manager.SendCommand(Command::Command0);
+            manager.SendCommand(Command::CommandLN);
+
+            manager.SendCommand(Command::CommandCLEAR);
+            manager.ClearHistory();
+        });
+
+        VERIFY_ARE_EQUAL(0ll, netLive);
+    }
+
+    // Memory slots and history items hold engine Rationals, not ratpak
+    // blocks; storing, recalling and clearing them must leave nothing
+    // live either.
+    void RatpakLifetimeTests::MemoryAndHistoryBalanceAllocations()
+    {
+        SilentCalcDisplay display;
+        auto resourceProvider = make_shared<EngineResourceProvider>();
+        CalculatorManager manager(&display, resourceProvider.get());
+        manager.SendCommand(Command::ModeScientific);
+
+        long long netLive = NetLiveAfter(manager, [&]() {
+            manager.SendCommand(Command::CommandCLEAR);
+            manager.SendCommand(Command::Command7);
+            manager.SendCommand(Command::Command3);
+            manager.MemorizeNumber();
+            manager.SendCommand(Command::CommandADD);
+            manager.SendCommand(Command::Command9);
+            manager.SendCommand(Command::CommandEQU);
+            manager.MemorizedNumberAdd(0);
+            manager.MemorizedNumberLoad(0);
+            manager.MemorizedNumberClearAll();
+            manager.ClearHistory();
+        });
+
+        VERIFY_ARE_EQUAL(0ll, netLive);
+    }
+
+    // A worker thread that builds its ratpak constants and then calls
+    // ReleaseRatpakThreadState must hand every block back - this is the
+    // teardown path the engine thread, the warm-pool filler and the
+    // speculation workers run before a join. The unmeasured thread first
+    // seeds the process-wide shared constant pool, so the measured thread
+    // copies from it instead of publishing a set that outlives the window.
+    void RatpakLifetimeTests::WorkerThreadReleaseBalancesAllocations()
+    {
+        std::thread([]() { CCalcEngine::InitialPerThreadSetup(); }).join();
+
+        CalculatorManager::SetDiagnosticsEnabled(true);
+        CalculatorManager::ResetDiagnostics();
+
+        std::thread([]() {
+            CCalcEngine::InitialPerThreadSetup();
+            ReleaseRatpakThreadState();
+        }).join();
+
+        auto stats = CalculatorManager::GetDiagnostics();
+        CalculatorManager::SetDiagnosticsEnabled(false);
+
+        VERIFY_ARE_EQUAL(stats.cCreateNum, stats.cDestroyNum);
+    }
+}
@@ -214,6 +214,13 @@ namespace CalculatorUnitTests
         return m_curCategory;
     }
 
+    vector<UCM::Unit> UnitConverterMock::SearchUnits(const std::wstring& /*query*/)
+    {
+        // The ViewModel tests drive search through the real converter; the
+        // mock only needs to satisfy the interface.
+        return vector<UCM::Unit>();
+    }
+
     void UnitConverterMock::SetCurrentUnitTypes(const UCM::Unit& fromType, const UCM::Unit& toType)
     {
         m_setCurUnitTypesCallCount++;
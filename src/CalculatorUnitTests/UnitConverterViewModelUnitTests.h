@@ -33,6 +33,7 @@ namespace CalculatorUnitTests
             std::vector<UCM::Category> GetCategories() override;
             UCM::CategorySelectionInitializer SetCurrentCategory(const UCM::Category& input) override;
             UCM::Category GetCurrentCategory();
+            std::vector<UCM::Unit> SearchUnits(const std::wstring& query) override;
             void SetCurrentUnitTypes(const UCM::Unit& fromType, const UCM::Unit& toType) override;
             void SwitchActive(const std::wstring& newValue);
             std::wstring Serialize() override;